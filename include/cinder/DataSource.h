@@ -83,6 +83,31 @@ class CI_API DataSourcePath : public DataSource {
 };
 
 
+typedef std::shared_ptr<class DataSourceMapped>	DataSourceMappedRef;
+
+//! A DataSource whose Buffer and streams read directly from a memory mapping of a file, rather than from copies of it. isFilePath() returns \c false
+//! so that loaders consume the mapping instead of opening the file themselves, though getFilePath() and getFilePathHint() still return its path.
+class CI_API DataSourceMapped : public DataSource {
+  public:
+	//! Maps the file located at \a path, advising the OS it will be accessed as \a access. Throws StreamExc if the file can't be opened or mapped.
+	static DataSourceMappedRef	create( const fs::path &path, MappedFile::Access access = MappedFile::Access::SEQUENTIAL );
+
+	virtual bool	isFilePath() { return false; }
+	virtual bool	isUrl() { return false; }
+
+	virtual IStreamRef	createStream();
+
+	const MappedFileRef&	getMappedFile() const { return mMappedFile; }
+
+  protected:
+	explicit DataSourceMapped( const MappedFileRef &mappedFile );
+
+	virtual	void	createBuffer();
+
+	MappedFileRef	mMappedFile;
+};
+
+
 #if defined( CINDER_ANDROID )
 typedef std::shared_ptr<class DataSourceAndroidAsset>	DataSourceAndroidAssetRef;
 
@@ -107,6 +132,8 @@ class DataSourceAndroidAsset : public DataSource {
 
 
 CI_API DataSourceRef loadFile( const fs::path &path );
+//! Returns a DataSourceMapped for the file located at \a path, whose data is read from a memory mapping without being copied. Android assets are returned as by loadFile().
+CI_API DataSourceRef loadFileMapped( const fs::path &path, MappedFile::Access access = MappedFile::Access::SEQUENTIAL );
 
 #if ! defined( CINDER_UWP )
 typedef std::shared_ptr<class DataSourceUrl>	DataSourceUrlRef;
@@ -37,6 +37,7 @@
 #include <map>
 #include <algorithm>
 #include <array>
+#include <limits>
 
 // Forward declarations in cinder::
 namespace cinder {
@@ -78,6 +79,100 @@ CI_API void calculateTangents( size_t numIndices, const uint32_t *indices, size_
 //! Utility function for calculating tangents and bitangents from indexed geometry and 3D texture coordinates. \a resultBitangents may be NULL if not needed.
 CI_API void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec3 *texCoords, std::vector<vec3> *resultTangents, std::vector<vec3> *resultBitangents );
 
+//! Determines how the normals of the triangles sharing a vertex are combined by calculateNormals()
+enum class NormalWeighting { UNIFORM, AREA, ANGLE };
+
+//! Utility function for finding coincident vertices using a spatial hash. Sets \a resultRemap[i] to the index of the first vertex within \a epsilon of vertex \a i, which is \a i itself for the first of each group. Returns the number of unique vertices.
+CI_API size_t weldVertices( size_t numVertices, const vec3 *positions, float epsilon, std::vector<uint32_t> *resultRemap );
+//! Utility function for calculating normals from indexed triangles, in parallel for large meshes. Vertices with the same entry in \a remap (as produced by weldVertices()) share the same normal; \a remap may be NULL.
+CI_API void calculateNormals( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const uint32_t *remap, NormalWeighting weighting, std::vector<vec3> *resultNormals );
+
+//! Algorithm used by optimizeVertexCache(). TIPSIFY (Sander et al. 2007) is faster and targets a FIFO cache of a known size, FORSYTH (Forsyth 2006) targets an LRU cache and is less sensitive to its size.
+enum class VertexCacheMethod { TIPSIFY, FORSYTH };
+
+//! Post-transform vertex cache efficiency of indexed triangles, as reported by simulateVertexCache()
+struct CI_API VertexCacheStats {
+	VertexCacheStats( size_t numTransformedVertices = 0, float acmr = 0, float atvr = 0 )
+		: mNumTransformedVertices( numTransformedVertices ), mAcmr( acmr ), mAtvr( atvr )
+	{}
+
+	//! Returns the number of vertices transformed, which is the number of cache misses
+	size_t	getNumTransformedVertices() const { return mNumTransformedVertices; }
+	//! Returns the average cache miss ratio: vertices transformed per triangle. Ranges from about 0.5 for large regular meshes to 3.
+	float	getAcmr() const { return mAcmr; }
+	//! Returns the average transform to vertex ratio: vertices transformed per referenced vertex. 1 is optimal.
+	float	getAtvr() const { return mAtvr; }
+
+  private:
+	size_t	mNumTransformedVertices;
+	float	mAcmr, mAtvr;
+};
+
+//! Utility function for simulating a FIFO post-transform vertex cache of \a cacheSize entries, so that index orderings can be compared without a GPU.
+CI_API VertexCacheStats simulateVertexCache( size_t numIndices, const uint32_t *indices, size_t numVertices, size_t cacheSize = 16 );
+//! Utility function for reordering indexed triangles to reduce post-transform vertex cache misses. The vertices of each triangle keep their order. \a resultIndices may alias \a indices.
+CI_API void optimizeVertexCache( size_t numIndices, const uint32_t *indices, size_t numVertices, std::vector<uint32_t> *resultIndices, VertexCacheMethod method = VertexCacheMethod::TIPSIFY, size_t cacheSize = 16 );
+/*! Utility function for reordering indexed triangles to reduce overdraw, meant to run after optimizeVertexCache(). The triangles are split into clusters whose cache miss
+	ratio is at most \a threshold times that of the whole mesh, and outward facing clusters are drawn first. \a resultIndices may alias \a indices. */
+CI_API void optimizeOverdraw( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, std::vector<uint32_t> *resultIndices, float threshold = 1.05f, size_t cacheSize = 16 );
+/*! Utility function for renumbering vertices in the order \a indices first reference them, which improves locality of vertex fetches. \a indices is updated in place
+	and \a resultRemap[i] is set to the new index of vertex \a i; unreferenced vertices are moved to the end. Returns the number of referenced vertices.
+	Apply \a resultRemap to vertex data with remapVertexData(). */
+CI_API size_t optimizeVertexFetch( size_t numIndices, uint32_t *indices, size_t numVertices, std::vector<uint32_t> *resultRemap );
+//! Utility function for moving vertex \a i of \a data, which has \a dims floats per vertex, to \a remap[i]. \a remap must be a permutation, as produced by optimizeVertexFetch().
+CI_API void remapVertexData( size_t numVertices, uint8_t dims, const uint32_t *remap, float *data );
+
+//! Options for simplify() and simplifyLods(), and the geom::Simplify modifier
+class CI_API SimplifyOptions {
+  public:
+	SimplifyOptions()
+		: mMaxError( std::numeric_limits<float>::max() ), mLockBorders( false ), mClusterSize( 0 )
+	{}
+
+	//! Stops simplifying before the error, a distance in the units of the positions, would exceed \a error. Unlimited by default.
+	SimplifyOptions&	maxError( float error ) { mMaxError = error; return *this; }
+	//! Keeps the vertices on open boundaries in place rather than simplifying along the boundaries. Disabled by default.
+	SimplifyOptions&	lockBorders( bool lock = true ) { mLockBorders = lock; return *this; }
+	/*! Splits large meshes into spatially coherent clusters of about \a numTriangles triangles, which are simplified in parallel with the vertices between
+		them kept in place, before a final pass over the whole mesh. Trades some quality for speed on very large meshes. \c 0, the default, disables clustering. */
+	SimplifyOptions&	parallelClusters( size_t numTriangles ) { mClusterSize = numTriangles; return *this; }
+
+	float	getMaxError() const { return mMaxError; }
+	bool	getLockBorders() const { return mLockBorders; }
+	size_t	getParallelClusters() const { return mClusterSize; }
+
+  private:
+	float	mMaxError;
+	bool	mLockBorders;
+	size_t	mClusterSize;
+};
+
+//! A level of detail produced by simplifyLods(): triangles referring to the original vertices, and the geometric error introduced by simplification
+class CI_API SimplifiedLod {
+  public:
+	SimplifiedLod( std::vector<uint32_t> indices = std::vector<uint32_t>(), float error = 0 )
+		: mIndices( std::move( indices ) ), mError( error )
+	{}
+
+	const std::vector<uint32_t>&	getIndices() const { return mIndices; }
+	//! Returns the error as a distance in the units of the positions
+	float							getError() const { return mError; }
+	//! Returns the error in pixels when viewed from \a distance with a perspective projection of vertical field of view \a fovYRadians onto a viewport \a viewportHeight pixels tall
+	float							calcScreenSpaceError( float distance, float fovYRadians, float viewportHeight ) const;
+
+  private:
+	std::vector<uint32_t>	mIndices;
+	float					mError;
+};
+
+/*! Utility function for reducing indexed triangles to at most \a targetNumIndices indices by quadric error metric edge collapses. Vertices are collapsed onto
+	neighboring vertices, so the result refers to the original vertices and their attributes. Open boundaries and attribute seams (coincident vertices with different
+	attributes) are only simplified along themselves. Returns the error introduced as a distance in the units of \a positions. \a resultIndices may alias \a indices. */
+CI_API float simplify( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, size_t targetNumIndices, std::vector<uint32_t> *resultIndices, const SimplifyOptions &options = SimplifyOptions() );
+/*! Utility function for generating a chain of levels of detail in a single simplification pass, which is faster than calling simplify() for each level.
+	\a ratios lists the fraction of triangles to keep per level in decreasing order. Levels that can't be reduced further within SimplifyOptions::maxError() repeat the previous level. */
+CI_API void simplifyLods( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const std::vector<float> &ratios, std::vector<SimplifiedLod> *resultLods, const SimplifyOptions &options = SimplifyOptions() );
+
 struct CI_API AttribInfo {
 	AttribInfo( const Attrib &attrib, uint8_t dims, size_t stride, size_t offset, uint32_t instanceDivisor = 0 )
 		: mAttrib( attrib ), mDims( dims ), mDataType( DataType::FLOAT ), mStride( stride ), mOffset( offset ), mInstanceDivisor( instanceDivisor )
@@ -163,6 +258,9 @@ class CI_API Target {
 
 	virtual void	copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) = 0;
 	virtual void	copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) = 0;
+	//! Returns storage which a Source can write \a count vertices of \a attr with \a dims dimensions into directly, in place of calling copyAttrib(), and sets \a resultStrideBytes
+	//! to the distance between consecutive vertices. Returns \c nullptr if the Target can't provide storage for \a attr in that layout, in which case copyAttrib() must be used instead.
+	virtual float*	getAttribStorage( Attrib /*attr*/, uint8_t /*dims*/, size_t /*count*/, size_t * /*resultStrideBytes*/ ) { return nullptr; }
 
 	//! For non-indexed geometry, this generates appropriate indices and then calls the copyIndices() virtual method.
 	void	generateIndices( Primitive sourcePrimitive, size_t sourceNumIndices );
@@ -208,8 +306,24 @@ class CI_API Modifier {
 	virtual Primitive	getPrimitive( const Modifier::Params &upstreamParams ) const;
 	virtual uint8_t		getAttribDims( Attrib attr, uint8_t upstreamDims ) const;
 	virtual AttribSet	getAvailableAttribs( const Modifier::Params &upstreamParams ) const;
-	
+
 	virtual void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const = 0;
+
+	//! Returns whether the Modifier maps the attributes of each vertex independently of all other vertices by implementing prepareVertices() and processVertices().
+	//! Consecutive per-vertex Modifiers are fused by SourceModsContext into a single pass over the vertices, rather than calling process() on each.
+	virtual bool		isPerVertex() const { return false; }
+	//! Returns the attributes a per-vertex Modifier requires from upstream in order to supply \a requestedAttribs.
+	virtual AttribSet	getUpstreamAttribs( const AttribSet &requestedAttribs ) const { return requestedAttribs; }
+	//! Prepares the attributes of \a ctx for processVertices() of a per-vertex Modifier, for example allocating those it writes. When \a upstreamPending is \c true,
+	//! fused upstream Modifiers have not processed the vertices yet, so attribute values must not be read. Returning \c false skips processVertices(); if
+	//! \a upstreamPending was \c true, prepareVertices() is called again after the upstream Modifiers complete, allowing it to read or relayout the data.
+	virtual bool		prepareVertices( SourceModsContext * /*ctx*/, bool /*upstreamPending*/ ) const { return true; }
+	//! Processes the vertices in the range [\a beginVertex, \a endVertex) of \a ctx for a per-vertex Modifier.
+	virtual void		processVertices( SourceModsContext * /*ctx*/, size_t /*beginVertex*/, size_t /*endVertex*/ ) const {}
+
+  protected:
+	//! Implements process() for a per-vertex Modifier which isn't fused with others.
+	void				processPerVertex( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const;
 };
 
 class CI_API Rect : public Source {
@@ -542,7 +656,6 @@ class CI_API Torus : public Source {
 
   protected:
 	void		updateCounts();
-	void		calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
 
 	vec3		mCenter;
 	float		mRadiusMajor;
@@ -669,9 +782,6 @@ class CI_API Cylinder : public Source {
 
   protected:
 	void	updateCounts();
-	void	calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
-	void	calculateCap( bool flip, float height, float radius, std::vector<vec3> *positions, std::vector<vec3> *normals,
-								std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
 
 	vec3		mOrigin;
 	float		mHeight;
@@ -1189,6 +1299,9 @@ class CI_API Transform : public Modifier {
 	Modifier*			clone() const override { return new Transform( mTransform ); }
 	uint8_t				getAttribDims( Attrib attr, uint8_t upstreamDims ) const override;
 	void				process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool				isPerVertex() const override { return true; }
+	bool				prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void				processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 
   protected:
 	mat4		mTransform;
@@ -1235,6 +1348,9 @@ class CI_API Twist : public Modifier {
 
 	Modifier*	clone() const override { return new Twist( *this ); }
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool		isPerVertex() const override { return true; }
+	bool		prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void		processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 	
   protected:
 	vec3					mAxisStart, mAxisEnd;
@@ -1272,6 +1388,10 @@ class CI_API ColorFromAttrib : public Modifier {
 	AttribSet	getAvailableAttribs( const Modifier::Params &upstreamParams ) const override;
 	
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool		isPerVertex() const override { return true; }
+	AttribSet	getUpstreamAttribs( const AttribSet &requestedAttribs ) const override;
+	bool		prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void		processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 	
   protected:
 	ColorFromAttrib( Attrib attrib, const std::function<Colorf(vec2)> &fn2, const std::function<Colorf(vec3)> &fn3 )
@@ -1300,6 +1420,9 @@ class CI_API Constant : public Modifier {
 	AttribSet	getAvailableAttribs( const Modifier::Params &upstreamParams ) const override;
 
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool		isPerVertex() const override { return true; }
+	bool		prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void		processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 
   protected:
 	geom::Attrib	mAttrib;
@@ -1328,6 +1451,10 @@ class AttribFn : public Modifier {
 	AttribSet	getAvailableAttribs( const Modifier::Params &upstreamParams ) const override;
 	
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool		isPerVertex() const override { return true; }
+	AttribSet	getUpstreamAttribs( const AttribSet &requestedAttribs ) const override;
+	bool		prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void		processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 	
   protected:
 	geom::Attrib		mSrcAttrib, mDstAttrib;
@@ -1376,6 +1503,9 @@ class CI_API Invert : public Modifier {
 
 	Modifier*	clone() const override { return new Invert( mAttrib ); }
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+	bool		isPerVertex() const override { return true; }
+	bool		prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const override;
+	void		processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const override;
 
   protected:
 	Attrib		mAttrib;
@@ -1428,15 +1558,73 @@ class CI_API Subdivide : public Modifier {
 	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
 };
 
+/*! Reorders triangles and vertices for rendering efficiency, without changing the geometry: triangles are reordered for the post-transform vertex cache
+	(see optimizeVertexCache()) and then in clusters to reduce overdraw (see optimizeOverdraw()), and vertices are renumbered in the order they are first
+	used (see optimizeVertexFetch()). Requires indexed TRIANGLES; overdraw optimization also requires 3D POSITION. */
+class CI_API Optimize : public Modifier {
+  public:
+	Optimize()
+		: mVertexCacheMethod( VertexCacheMethod::TIPSIFY ), mCacheSize( 16 ), mOverdraw( true ), mOverdrawThreshold( 1.05f ), mVertexFetch( true )
+	{}
+
+	//! Sets the algorithm used for vertex cache optimization. Default is VertexCacheMethod::TIPSIFY.
+	Optimize&	vertexCacheMethod( VertexCacheMethod method ) { mVertexCacheMethod = method; return *this; }
+	//! Sets the number of entries of the vertex cache optimized for. Default is \c 16.
+	Optimize&	cacheSize( size_t size ) { mCacheSize = size; return *this; }
+	//! Enables or disables overdraw optimization, which may increase the cache miss ratio by up to \a threshold times. Enabled by default with a threshold of \c 1.05.
+	Optimize&	overdraw( bool enable, float threshold = 1.05f ) { mOverdraw = enable; mOverdrawThreshold = threshold; return *this; }
+	//! Enables or disables vertex fetch optimization. Enabled by default.
+	Optimize&	vertexFetch( bool enable ) { mVertexFetch = enable; return *this; }
+
+	Modifier*	clone() const override { return new Optimize( *this ); }
+	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+
+  protected:
+	VertexCacheMethod	mVertexCacheMethod;
+	size_t				mCacheSize;
+	bool				mOverdraw;
+	float				mOverdrawThreshold;
+	bool				mVertexFetch;
+};
+
+/*! Reduces the number of triangles to about \a ratio times the input using quadric error metric edge collapses (see simplify()). The vertices are kept as is,
+	so all attributes are preserved, and getNumIndices() reports the input's count as an upper bound. Requires TRIANGLES and 3D POSITION. */
+class CI_API Simplify : public Modifier {
+  public:
+	Simplify( float ratio = 0.5f, float *errorResult = nullptr )
+		: mRatio( ratio ), mErrorResult( errorResult )
+	{}
+
+	//! Sets the fraction of triangles to keep.
+	Simplify&	ratio( float ratio ) { mRatio = ratio; return *this; }
+	//! Stops simplifying before the error, a distance in the units of POSITION, would exceed \a error. Unlimited by default.
+	Simplify&	maxError( float error ) { mOptions.maxError( error ); return *this; }
+	//! Keeps the vertices on open boundaries in place. Disabled by default.
+	Simplify&	lockBorders( bool lock = true ) { mOptions.lockBorders( lock ); return *this; }
+	//! Simplifies clusters of about \a numTriangles triangles in parallel before a final pass. See SimplifyOptions::parallelClusters().
+	Simplify&	parallelClusters( size_t numTriangles ) { mOptions.parallelClusters( numTriangles ); return *this; }
+	//! Sets a location the error introduced by simplification is written to during processing.
+	Simplify&	errorResult( float *result ) { mErrorResult = result; return *this; }
+
+	Modifier*	clone() const override { return new Simplify( *this ); }
+	void		process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const override;
+
+  protected:
+	float				mRatio;
+	SimplifyOptions		mOptions;
+	float				*mErrorResult;
+};
+
 
 ////////////////////////////////////////////////////////////////////////////////
-//! Base class for SourceMods<> and SourceModsPtr<>
-//! Used by Modifiers to process Source -> Target
+//! Holds the vertex and index data while the Modifiers of a SourceMods process its Source into a Target. Attributes are stored in a table indexed by Attrib,
+//! and up to 4 MB of storage released by a SourceModsContext is recycled by later ones on the same thread, so that repeatedly loading small SourceMods doesn't allocate.
 class CI_API SourceModsContext : public Target {
   public:
 	SourceModsContext( const SourceMods *sourceMods );
 	//! Can be used to capture a Source. Calling loadInto() in this case is an error.
 	SourceModsContext();
+	~SourceModsContext();
 
 	// called by SourceMods::loadInto()
 	void			loadInto( Target *target, const AttribSet &requestedAttribs );
@@ -1445,9 +1633,15 @@ class CI_API SourceModsContext : public Target {
 	uint8_t			getAttribDims( Attrib attr ) const override;
 	void			copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void			copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float*			getAttribStorage( Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
 	//! Appends vertex data to existing data for \a attr. \a dims must match existing data.
 	void			appendAttrib( Attrib attr, uint8_t dims, const float *srcData, size_t count );
+	//! Returns storage for \a count vertices of \a attr with \a dims dimensions, for a Modifier to write in place. Existing storage is reused when large enough,
+	//! so the contents are only preserved if \a attr already had \a dims dimensions and \a count vertices.
+	float*			allocAttrib( Attrib attr, uint8_t dims, size_t count );
+	//! Grows \a attr by \a count vertices, preserving its existing data, and returns a pointer to the first new vertex. Pointers to \a attr's data are invalidated.
+	float*			extendAttrib( Attrib attr, size_t count );
 	void			clearAttrib( Attrib attr );
 	//! Appends index data to existing index data. \a primitive must match existing data.
 	void			appendIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytes );
@@ -1468,19 +1662,37 @@ class CI_API SourceModsContext : public Target {
 	void			preload( const AttribSet &requestedAttribs );
 	void			combine( const SourceModsContext &rhs );
 	void			complete( Target *target, const AttribSet &requestedAttribs );
+
+	//! Frees the storage recycled between SourceModsContexts on the calling thread.
+	static void		releaseCachedStorage();
 	
   private:
+	struct AttribStorage {
+		AttribStorage() : mCapacity( 0 ), mCount( 0 ), mDims( 0 ) {}
+
+		std::unique_ptr<float[]>	mData;
+		size_t						mCapacity; // in floats
+		size_t						mCount;
+		uint8_t						mDims; // 0 when the attribute is absent
+	};
+
+	// pops the next Modifier from the stack and processes it, fusing it with the following Modifiers if they're all per-vertex
+	void			processNextModifier( const AttribSet &requestedAttribs );
+	void			processVertexModifiers( const std::vector<const Modifier*> &modifiers );
+	void			copyToTarget( Target *target, const AttribSet &requestedAttribs );
+	void			reserveAttrib( Attrib attr, size_t capacity, bool preserve );
+	void			reserveIndices( size_t capacity, bool preserve );
+
 	const Source					*mSource;
 	std::vector<Modifier*>			mModiferStack;
 	
 	const AttribSet					*mAttribMask;
 	
 	size_t										mNumVertices;
-	std::map<Attrib,AttribInfo>					mAttribInfo;
-	std::map<Attrib,std::unique_ptr<float[]>>	mAttribData;
-	std::map<Attrib,size_t>						mAttribCount;
+	std::array<AttribStorage,NUM_ATTRIBS>		mAttribs;
 	
 	std::unique_ptr<uint32_t[]>				mIndices;
+	size_t									mIndicesCapacity;
 	size_t									mNumIndices;
 	uint8_t									mIndicesRequiredBytes;
 	geom::Primitive							mPrimitive;
@@ -0,0 +1,206 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Buffer.h"
+#include "cinder/Filesystem.h"
+#include "cinder/Noncopyable.h"
+#include "cinder/Url.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void CURL;
+typedef void CURLM;
+
+namespace cinder {
+
+typedef std::shared_ptr<class HttpTransfer>		HttpTransferRef;
+
+//! A single fetch made through an HttpClient. Its methods may be called from any thread.
+class CI_API HttpTransfer : private Noncopyable {
+  public:
+	//! Receives each chunk of the body as it arrives, on the HttpClient's thread. Returning false cancels the transfer, while calling pause() stops the chunks after this one until resume() is called.
+	typedef std::function<bool ( const void *data, size_t size )>	DataFn;
+	//! Called on the HttpClient's thread once the transfer has completed, failed or been cancelled.
+	typedef std::function<void ( const HttpTransfer &transfer )>	CompletionFn;
+
+	~HttpTransfer();
+
+	//! Returns the Url being fetched
+	const Url&			getUrl() const				{ return mUrl; }
+	//! Returns the UrlOptions the transfer was made with
+	const UrlOptions&	getOptions() const			{ return mOptions; }
+
+	//! Returns whether the transfer has finished, successfully or not
+	bool		isComplete() const;
+	//! Blocks until the transfer has finished and its CompletionFn has returned
+	void		wait() const;
+	//! Blocks until the transfer has finished or \a timeoutSeconds have elapsed. Returns whether the transfer finished.
+	bool		wait( double timeoutSeconds ) const;
+	//! Aborts the transfer. Its CompletionFn is still called, with isCancelled() returning \c true.
+	void		cancel();
+	//! Returns whether cancel() has been called
+	bool		isCancelled() const			{ return mCancelled; }
+	//! Stops receiving the body until resume() is called, leaving the rest of it with the server, so that a slow DataFn doesn't have to buffer it. Has no effect on responses loaded from the cache.
+	void		pause()						{ mPauseRequested = true; }
+	//! Continues receiving the body after pause()
+	void		resume();
+
+	//! Returns whether the transfer failed to complete, for example due to a connection error or cancellation. An HTTP error status is not a failure.
+	bool		hasError() const;
+	//! Returns a description of the failure, or an empty string if there was none
+	std::string	getError() const;
+	//! Returns the HTTP status code of the response, or 0 if no response has been received yet
+	long		getStatusCode() const		{ return mStatusCode; }
+	//! Returns the length of the body announced by the server, or -1 if it's unknown
+	int64_t		getContentLength() const	{ return mContentLength; }
+	//! Returns the number of bytes of the body received so far
+	size_t		getBytesReceived() const	{ return mBytesReceived; }
+	//! Returns whether the response was loaded from the HttpClient's disk cache
+	bool		isFromCache() const			{ return mFromCache; }
+	//! Returns the body of a completed transfer. Returns \c nullptr if the transfer was made with a DataFn, which receives the body instead.
+	BufferRef	getBody() const;
+
+  private:
+	HttpTransfer( class HttpClient *client, const Url &url, const std::string &user, const std::string &password, const UrlOptions &options,
+					const DataFn &dataFn, const CompletionFn &completionFn );
+
+	void		receive( const void *data, size_t size );
+	void		finish( const std::string &error );
+
+	static size_t	writeCallback( char *buffer, size_t size, size_t nitems, void *userp );
+
+	const Url				mUrl;
+	const std::string		mUser, mPassword;
+	const UrlOptions		mOptions;
+	DataFn					mDataFn;
+	CompletionFn			mCompletionFn;
+
+	CURL					*mCurl;
+	std::string				mUserColonPassword;
+	fs::path				mCachePath, mCachePartPath;
+	std::FILE				*mCacheFile;
+	BufferRef				mBody;
+
+	std::atomic<long>		mStatusCode;
+	std::atomic<int64_t>	mContentLength;
+	std::atomic<size_t>		mBytesReceived;
+	std::atomic<bool>		mCancelled, mFromCache, mPauseRequested;
+	bool					mPaused; // only accessed from the HttpClient's thread
+
+	mutable std::mutex				mMutex;
+	mutable std::condition_variable	mCompleteCondition;
+	class HttpClient		*mClient; // cleared once the transfer has finished
+	bool					mComplete, mCompletionCalled;
+	std::string				mError;
+
+	friend class HttpClient;
+};
+
+//! Process-wide HTTP client which performs all of its transfers on a single background thread, implemented with libcurl.
+//!
+//! Transfers share a connection and DNS cache, so repeated requests to the same host reuse the connection rather than paying for
+//! its setup again. At most Options::maxTransfers() run concurrently, the rest wait in a queue. Successful responses may optionally
+//! be cached on disk, in which case fetches made without UrlOptions::ignoreCache() are answered from the cache.
+//! \note DataFn and CompletionFn callbacks run on the client's thread and should return quickly, as they hold up every other transfer.
+class CI_API HttpClient : private Noncopyable {
+  public:
+	struct Options {
+		Options()
+			: mMaxTransfers( 8 ), mMaxConnectionsPerHost( 4 )
+		{}
+
+		//! Sets the maximum number of transfers in flight at once. Additional transfers are queued. \default 8.
+		Options& maxTransfers( size_t max )					{ mMaxTransfers = max; return *this; }
+		//! Sets the maximum number of simultaneous connections to a single host, where 0 is unlimited. \default 4.
+		Options& maxConnectionsPerHost( size_t max )		{ mMaxConnectionsPerHost = max; return *this; }
+		//! Sets the directory successful responses are cached in. An empty path (the default) disables the cache.
+		Options& cacheDirectory( const fs::path &directory )	{ mCacheDirectory = directory; return *this; }
+
+		size_t			getMaxTransfers() const				{ return mMaxTransfers; }
+		size_t			getMaxConnectionsPerHost() const	{ return mMaxConnectionsPerHost; }
+		const fs::path&	getCacheDirectory() const			{ return mCacheDirectory; }
+
+	  private:
+		size_t		mMaxTransfers;
+		size_t		mMaxConnectionsPerHost;
+		fs::path	mCacheDirectory;
+	};
+
+	explicit HttpClient( const Options &options = Options() );
+	~HttpClient();
+
+	//! Returns the process-wide instance of HttpClient, which is used by loadUrl()
+	static HttpClient&	instance();
+
+	//! Replaces the client's Options. Affects transfers started afterwards.
+	void			setOptions( const Options &options );
+	//! Returns the client's Options
+	Options			getOptions() const;
+
+	//! Starts fetching \a url, calling \a completionFn once it finishes. The body is accumulated and available from HttpTransfer::getBody().
+	HttpTransferRef	fetch( const Url &url, const HttpTransfer::CompletionFn &completionFn = HttpTransfer::CompletionFn(), const UrlOptions &options = UrlOptions() );
+	//! Starts fetching \a url with an optional login and password, streaming the body to \a dataFn as it arrives, and calling \a completionFn once it finishes.
+	HttpTransferRef	fetch( const Url &url, const std::string &user, const std::string &password, const UrlOptions &options,
+							const HttpTransfer::DataFn &dataFn, const HttpTransfer::CompletionFn &completionFn = HttpTransfer::CompletionFn() );
+
+	//! Returns the path a successful response to \a url, fetched with \a user and \a password, would be cached at, or an empty path if the cache is disabled
+	fs::path		getCachePath( const Url &url, const std::string &user = "", const std::string &password = "" ) const;
+	//! Returns the number of transfers currently in flight
+	size_t			getNumActiveTransfers() const	{ return mNumActive; }
+	//! Returns the number of transfers waiting for a free slot
+	size_t			getNumQueuedTransfers() const;
+
+  private:
+	void	threadEntry();
+	void	startQueuedTransfers();
+	void	startTransfer( const HttpTransferRef &transfer );
+	void	resumeTransfers();
+	void	loadFromCache( const HttpTransferRef &transfer );
+	void	finishTransfer( const HttpTransferRef &transfer, const std::string &error );
+	void	wakeup();
+
+	CURLM							*mMulti;
+	Options							mOptions;
+	std::deque<HttpTransferRef>		mQueued;
+	std::vector<HttpTransferRef>	mActive; // only accessed from mThread
+	std::atomic<size_t>				mNumActive;
+	bool							mOptionsChanged;
+
+	mutable std::mutex				mMutex;
+	std::thread						mThread;
+	std::atomic<bool>				mThreadShouldQuit;
+
+	friend class HttpTransfer;
+};
+
+} // namespace cinder
@@ -38,6 +38,11 @@ namespace Json {
 
 namespace cinder {
 
+namespace json {
+	class Document;
+	class Value;
+}
+
 class CI_API JsonTree {
   public:
 	
@@ -102,6 +107,8 @@ class CI_API JsonTree {
 	explicit JsonTree( DataSourceRef dataSource, ParseOptions parseOptions = ParseOptions() );
 	//! Parses the JSON contained in the string \a jsonString .
 	explicit JsonTree( const std::string &jsonString, ParseOptions parseOptions = ParseOptions() );
+	//! Creates a JsonTree from the already parsed json::Document \a document. Object members keep their document order.
+	explicit JsonTree( const json::Document &document );
 	//! Creates a JsonTree with key \a key and boolean \a value .
 	explicit JsonTree( const std::string &key, bool value );
 	//! Creates a JsonTree with key \a key and double \a value .
@@ -262,6 +269,7 @@ private:
    
 	void							init( const std::string &key, const Json::Value &value, bool setType = false, 
 		NodeType nodeType = NODE_VALUE, ValueType valueType = VALUE_STRING );
+	void							init( const std::string &key, const json::Value &value, NodeType nodeType );
 	
 	JsonTree*						getNodePtr( const std::string &relativePath, bool caseSensitive, char separator ) const;
 	static bool						isIndex( const std::string &key );
@@ -0,0 +1,311 @@
+/*
+ Copyright (c) 2018, The Cinder Project
+ All rights reserved.
+
+ This code is designed for use with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+	* Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/DataSource.h"
+#include "cinder/Exception.h"
+#include "cinder/Noncopyable.h"
+#include "cinder/Stream.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace cinder { namespace json {
+
+//! \brief Receives the events of a Reader as it parses a JSON stream (SAX style).
+//!
+//! Strings are passed as a pointer and length. Unless the Reader is parsing in place (see Reader::parseInSitu()), they are only valid
+//! for the duration of the callback. Returning \c false from any callback stops parsing.
+class CI_API Handler {
+  public:
+	virtual ~Handler()	{}
+
+	virtual bool onNull()									{ return true; }
+	virtual bool onBool( bool /*value*/ )					{ return true; }
+	//! Called for integral numbers that are negative and fit into an int64_t.
+	virtual bool onInt( int64_t /*value*/ )					{ return true; }
+	//! Called for integral numbers that are positive and fit into a uint64_t.
+	virtual bool onUint( uint64_t /*value*/ )				{ return true; }
+	//! Called for numbers with a fraction or exponent, or that are too large to be represented as integers.
+	virtual bool onDouble( double /*value*/ )				{ return true; }
+	virtual bool onString( const char * /*str*/, size_t /*length*/ )	{ return true; }
+	//! Called for each member of an object, before the member's value.
+	virtual bool onKey( const char * /*str*/, size_t /*length*/ )		{ return true; }
+	virtual bool onStartObject()							{ return true; }
+	virtual bool onEndObject( size_t /*numMembers*/ )		{ return true; }
+	virtual bool onStartArray()								{ return true; }
+	virtual bool onEndArray( size_t /*numElements*/ )		{ return true; }
+};
+
+//! \brief Streaming JSON parser that reports its input to a Handler, without building any intermediate representation.
+//!
+//! Nesting is tracked with an explicit stack, so deeply nested documents cannot overflow the call stack. Strings that contain no escape
+//! sequences are passed to the Handler directly from the input without copying.
+class CI_API Reader {
+  public:
+	//! Options for JSON parsing, passed to the Reader constructor.
+	class CI_API Options {
+	  public:
+		Options() : mAllowComments( true ), mChunkSize( 64 * 1024 ), mMaxDepth( 1024 )	{}
+
+		//! Sets if C and C++ style comments are allowed. Default \c true.
+		Options& allowComments( bool allow = true )		{ mAllowComments = allow; return *this; }
+		//! Sets the number of bytes read from an IStream at a time by parse( const IStreamRef& ). Default 64kb.
+		Options& chunkSize( size_t bytes )				{ mChunkSize = bytes; return *this; }
+		//! Sets the maximum nesting depth of arrays and objects. Default 1024.
+		Options& maxDepth( size_t depth )				{ mMaxDepth = depth; return *this; }
+
+		bool	getAllowComments() const	{ return mAllowComments; }
+		size_t	getChunkSize() const		{ return mChunkSize; }
+		size_t	getMaxDepth() const			{ return mMaxDepth; }
+
+	  private:
+		bool	mAllowComments;
+		size_t	mChunkSize, mMaxDepth;
+	};
+
+	Reader( const Options &options = Options() );
+	~Reader();
+
+	//! Parses \a size bytes of JSON at \a data. Returns \c false if \a handler stopped parsing. Throws ExcParseError on malformed input.
+	bool parse( const char *data, size_t size, Handler *handler );
+	//! Parses the JSON string \a jsonString. Returns \c false if \a handler stopped parsing. Throws ExcParseError on malformed input.
+	bool parse( const std::string &jsonString, Handler *handler )	{ return parse( jsonString.data(), jsonString.size(), handler ); }
+	//! Parses \a stream incrementally in chunks of Options::getChunkSize() bytes, so that the whole input never needs to be in memory.
+	bool parse( const IStreamRef &stream, Handler *handler );
+	//! Parses the contents of \a dataSource incrementally, see parse( const IStreamRef& ).
+	bool parse( const DataSourceRef &dataSource, Handler *handler );
+	/** \brief Parses \a size bytes of JSON at \a data in place, decoding escape sequences into \a data itself.
+		All strings passed to \a handler point into \a data, are null-terminated and remain valid for the lifetime of \a data. **/
+	bool parseInSitu( char *data, size_t size, Handler *handler );
+
+	const Options&	getOptions() const	{ return mOptions; }
+
+  private:
+	class Impl;
+
+	Options					mOptions;
+	std::unique_ptr<Impl>	mImpl;
+};
+
+class Member;
+
+//! \brief A read-only JSON value within a Document.
+//!
+//! Values are small (16 bytes) and refer to strings, elements and members that are owned by the Document's arena, so they are only valid
+//! as long as their Document is alive. Members of large objects are indexed by a hash table, making key lookups O(1).
+class CI_API Value {
+  public:
+	enum Type : uint8_t { TYPE_NULL, TYPE_BOOL, TYPE_INT, TYPE_UINT, TYPE_DOUBLE, TYPE_STRING, TYPE_ARRAY, TYPE_OBJECT };
+
+	//! Creates a null Value.
+	Value() : mUint( 0 ), mSize( 0 ), mType( TYPE_NULL )	{}
+
+	Type	getType() const		{ return mType; }
+
+	bool	isNull() const		{ return mType == TYPE_NULL; }
+	bool	isBool() const		{ return mType == TYPE_BOOL; }
+	//! Returns whether the value is a number of any kind (TYPE_INT, TYPE_UINT or TYPE_DOUBLE).
+	bool	isNumber() const	{ return mType == TYPE_INT || mType == TYPE_UINT || mType == TYPE_DOUBLE; }
+	bool	isString() const	{ return mType == TYPE_STRING; }
+	bool	isArray() const		{ return mType == TYPE_ARRAY; }
+	bool	isObject() const	{ return mType == TYPE_OBJECT; }
+
+	//! Returns the value as a bool. Throws ExcTypeMismatch if the value is not TYPE_BOOL.
+	bool		getBool() const;
+	//! Returns the value as an int64_t, converting from any number type. Throws ExcTypeMismatch if the value is not a number.
+	int64_t		getInt() const;
+	//! Returns the value as a uint64_t, converting from any number type. Throws ExcTypeMismatch if the value is not a number.
+	uint64_t	getUint() const;
+	//! Returns the value as a double, converting from any number type. Throws ExcTypeMismatch if the value is not a number.
+	double		getDouble() const;
+	//! Returns the null-terminated string value. Throws ExcTypeMismatch if the value is not TYPE_STRING.
+	const char*	getString() const;
+	//! Returns the length in bytes of the string value, or 0 if the value is not TYPE_STRING.
+	size_t		getStringLength() const	{ return isString() ? mSize : 0; }
+
+	//! Returns the number of elements of an array or members of an object, otherwise 0.
+	size_t			getSize() const		{ return ( isArray() || isObject() ) ? mSize : 0; }
+
+	//! Returns the element of an array or the value of the member of an object at \a index. Throws ExcChildNotFound if out of range.
+	const Value&	operator[]( size_t index ) const;
+	//! Returns the value of the member with key \a key. Throws ExcChildNotFound if the value is not an object or has no such member.
+	const Value&	operator[]( const std::string &key ) const;
+
+	//! Returns the value of the member with key \a key, or \c nullptr if there is none. Keys are compared case-sensitively.
+	const Value*	find( const char *key, size_t keyLength ) const;
+	//! Returns the value of the member with key \a key, or \c nullptr if there is none. Keys are compared case-sensitively.
+	const Value*	find( const std::string &key ) const		{ return find( key.data(), key.size() ); }
+	//! Returns the value at \a relativePath (ex. "path.to.child"), or \c nullptr if there is none. Numeric path components index into arrays.
+	const Value*	findPath( const std::string &relativePath, char separator = '.' ) const;
+	//! Returns the value at \a relativePath (ex. "path.to.child"). Throws ExcChildNotFound if there is none.
+	const Value&	getChild( const std::string &relativePath, char separator = '.' ) const;
+	//! Returns whether a value exists at \a relativePath.
+	bool			hasChild( const std::string &relativePath, char separator = '.' ) const	{ return findPath( relativePath, separator ) != nullptr; }
+
+	//! Returns a pointer to the first element of an array, or \c nullptr.
+	const Value*	beginElements() const	{ return isArray() ? mElements : nullptr; }
+	//! Returns a pointer one past the last element of an array, or \c nullptr.
+	const Value*	endElements() const		{ return isArray() ? mElements + mSize : nullptr; }
+	//! Returns a pointer to the first member of an object, or \c nullptr. Members are in document order.
+	const Member*	beginMembers() const;
+	//! Returns a pointer one past the last member of an object, or \c nullptr.
+	const Member*	endMembers() const;
+
+  private:
+	const uint32_t*	getHashTable() const;
+
+	union {
+		bool			mBool;
+		int64_t			mInt;
+		uint64_t		mUint;
+		double			mDouble;
+		const char		*mString;
+		const Value		*mElements;
+		const Member	*mMembers;
+	};
+	uint32_t	mSize;
+	Type		mType;
+
+	friend class Document;
+	friend class DocumentBuilder;
+};
+
+//! An object member within a Document, pairing a key with a Value.
+class CI_API Member {
+  public:
+	//! Returns the member's key, which is null-terminated.
+	const char*		getKey() const			{ return mKey; }
+	//! Returns the length in bytes of the member's key.
+	size_t			getKeyLength() const	{ return mKeyLength; }
+	//! Returns the member's value.
+	const Value&	getValue() const		{ return mValue; }
+
+  private:
+	const char		*mKey;
+	uint32_t		mKeyLength;
+	uint32_t		mKeyHash;
+	Value			mValue;
+
+	friend class Value;
+	friend class DocumentBuilder;
+};
+
+inline const Member* Value::beginMembers() const
+{
+	return isObject() ? mMembers : nullptr;
+}
+
+inline const Member* Value::endMembers() const
+{
+	return isObject() ? mMembers + mSize : nullptr;
+}
+
+//! \brief An arena-backed, read-only JSON DOM built directly from a Reader.
+//!
+//! The input is copied once into a buffer owned by the Document and parsed in place, so string values and keys point into it without
+//! further allocations. All Values are allocated contiguously from a block arena, and objects with many members get a hash index for lookups.
+class CI_API Document : private Noncopyable {
+  public:
+	//! Creates an empty Document whose root is null.
+	Document();
+	//! Parses the contents of \a dataSource. Throws ExcParseError on malformed input.
+	explicit Document( const DataSourceRef &dataSource, const Reader::Options &options = Reader::Options() );
+	//! Parses the JSON string \a jsonString. Throws ExcParseError on malformed input.
+	explicit Document( const std::string &jsonString, const Reader::Options &options = Reader::Options() );
+	//! Parses \a buffer in place, taking ownership of it so that the input is never copied. Throws ExcParseError on malformed input.
+	explicit Document( BufferRef buffer, const Reader::Options &options = Reader::Options() );
+
+	Document( Document &&rhs );
+	Document& operator=( Document &&rhs );
+
+	//! Returns the root Value of the document.
+	const Value&	getRoot() const		{ return mRoot; }
+	//! Convenience for getRoot()[key].
+	const Value&	operator[]( const std::string &key ) const		{ return mRoot[key]; }
+	//! Convenience for getRoot().getChild( relativePath, separator ).
+	const Value&	getChild( const std::string &relativePath, char separator = '.' ) const	{ return mRoot.getChild( relativePath, separator ); }
+
+	//! Returns the number of bytes allocated by the Document, including the copy of its input.
+	size_t			getMemoryUsage() const;
+
+  private:
+	void	parse( const Reader::Options &options );
+
+	//! Bump allocator for Values, Members and hash tables, freed all at once with the Document.
+	class Arena {
+	  public:
+		Arena() : mCurrent( nullptr ), mRemaining( 0 ), mAllocatedSize( 0 )	{}
+
+		void*	allocate( size_t size );
+		size_t	getAllocatedSize() const	{ return mAllocatedSize; }
+
+	  private:
+		std::vector<std::unique_ptr<char[]>>	mBlocks;
+		char									*mCurrent;
+		size_t									mRemaining, mAllocatedSize;
+	};
+
+	BufferRef	mSource;
+	Arena		mArena;
+	Value		mRoot;
+
+	friend class DocumentBuilder;
+};
+
+//! Base class for exceptions thrown by Reader and Document.
+class CI_API Exception : public cinder::Exception {
+  public:
+	Exception( const std::string &description ) : cinder::Exception( description )	{}
+};
+
+//! Exception expressing malformed JSON input.
+class CI_API ExcParseError : public Exception {
+  public:
+	ExcParseError( const std::string &message, size_t line, size_t column );
+
+	//! Returns the 1-based line at which the error occurred.
+	size_t	getLine() const		{ return mLine; }
+	//! Returns the 1-based column at which the error occurred.
+	size_t	getColumn() const	{ return mColumn; }
+
+  private:
+	size_t	mLine, mColumn;
+};
+
+//! Exception expressing that a Value was accessed as a type it does not have.
+class CI_API ExcTypeMismatch : public Exception {
+  public:
+	ExcTypeMismatch( const std::string &description ) : Exception( description )	{}
+};
+
+//! Exception expressing the absence of an expected child value.
+class CI_API ExcChildNotFound : public Exception {
+  public:
+	ExcChildNotFound( const std::string &description ) : Exception( description )	{}
+};
+
+} } // namespace cinder::json
@@ -188,15 +188,47 @@ protected:
 #endif
 };
 
+//! Determines what happens to a log entry when the calling thread's asynchronous queue is full.
+enum class OverflowPolicy {
+	DROP,	//!< The entry is discarded and counted, see LogManager::getNumDroppedEntries()
+	BLOCK	//!< The calling thread waits until the background thread has made room for the entry
+};
+
+//! Options used when enabling asynchronous logging with LogManager::enableAsync().
+struct CI_API AsyncOptions {
+	AsyncOptions()
+		: mQueueSize( 64 * 1024 ), mOverflowPolicy( OverflowPolicy::DROP ), mFlushInterval( 0.005 )
+	{}
+
+	//! Sets the size in bytes of the ring buffer preallocated for each thread that logs. Default is 64kb.
+	AsyncOptions& queueSize( size_t bytes )					{ mQueueSize = bytes; return *this; }
+	//! Sets the policy applied when a thread's ring buffer is full. Default is OverflowPolicy::DROP.
+	AsyncOptions& overflowPolicy( OverflowPolicy policy )	{ mOverflowPolicy = policy; return *this; }
+	//! Sets the maximum time in seconds that the background thread sleeps between draining the ring buffers. Default is 0.005 (5 ms).
+	AsyncOptions& flushInterval( double seconds )			{ mFlushInterval = seconds; return *this; }
+
+	size_t			getQueueSize() const		{ return mQueueSize; }
+	OverflowPolicy	getOverflowPolicy() const	{ return mOverflowPolicy; }
+	double			getFlushInterval() const	{ return mFlushInterval; }
+
+  private:
+	size_t			mQueueSize;
+	OverflowPolicy	mOverflowPolicy;
+	double			mFlushInterval;
+};
+
 //! \brief LogManager manages a stack of all active Loggers.
 //!
 //! LogManager's default state contains a single LoggerConsole.  LogManager allows for adding and removing Loggers via their pointer values.
+//!
+//! By default Loggers are run synchronously on the thread that issued the log entry. When asynchronous logging is enabled with enableAsync(),
+//! entries are instead copied into a preallocated, lock-free ring buffer owned by the calling thread and a background thread drains them to the Loggers.
 class CI_API LogManager {
 public:
 	// Returns a pointer to the shared instance. To enable logging during shutdown, this instance is leaked at shutdown.
 	static LogManager* instance()	{ return sInstance; }
 	//! Destroys the shared instance. Useful to remove false positives with leak detectors like valgrind.
-	static void destroyInstance()	{ delete sInstance; }
+	static void destroyInstance()	{ delete sInstance; sInstance = nullptr; }
 	//! Restores LogManager to its default state - a single LoggerConsole.
 	void restoreToDefault();
 
@@ -217,6 +249,18 @@ public:
 	std::mutex& getMutex() const			{ return mMutex; }
 	
 	void write( const Metadata &meta, const std::string &text );
+
+	//! Enables asynchronous logging: Loggers are run on a background thread, which drains per-thread ring buffers described by \a options.
+	//! If asynchronous logging is already enabled, it is first disabled (flushing all pending entries) and restarted with the new \a options.
+	void enableAsync( const AsyncOptions &options = AsyncOptions() );
+	//! Disables asynchronous logging, flushing all pending entries and stopping the background thread. Subsequent entries are logged synchronously.
+	void disableAsync();
+	//! Returns whether asynchronous logging is currently enabled.
+	bool isAsyncEnabled() const;
+	//! Blocks until all entries pending in the asynchronous ring buffers have been written to the Loggers. Does nothing when logging synchronously.
+	void flush();
+	//! Returns the number of entries discarded because of OverflowPolicy::DROP since asynchronous logging was last enabled.
+	size_t getNumDroppedEntries() const;
 	
 	template<typename LoggerT, typename... Args>
 	std::shared_ptr<LoggerT> makeLogger( Args&&... args );
@@ -226,8 +270,12 @@ public:
 	
 protected:
 	LogManager();
+	~LogManager();
+
+	class AsyncImpl;
 
 	std::vector<LoggerRef>			mLoggers;
+	std::unique_ptr<AsyncImpl>		mAsync;
 	
 	mutable std::mutex				mMutex;
 	
@@ -203,12 +203,37 @@ CI_API inline std::ostream& operator<<( std::ostream &out, const Path2d &p )
 }
 
 //! Accelerates the calculation of various operations on Path2d. Useful if doing repeated calculations, otherwise just use Path2d member functions.
+//! Caches segment lengths and a flattened copy of the path, whose per-segment bounding boxes let point queries skip most segments.
 class CI_API Path2dCalcCache {
   public:
-	Path2dCalcCache( const Path2d &path );
+	//! Constructs a cache for \a path. \a approximationScale has the same meaning as in Path2d::subdivide() and controls the flattening.
+	Path2dCalcCache( const Path2d &path, float approximationScale = 1.0f );
 	
 	const Path2d&	getPath2d() const { return mPath; }
 	float			getLength() const { return mLength; }
+	//! Returns the flattened path, with a maximum deviation of <tt>0.5 / approximationScale</tt> from the curves. Consecutive segments share their end points.
+	const std::vector<vec2>&	getPositions() const { return mPositions; }
+	//! Returns a conservative bounding box of segment \a segment
+	const Rectf&	getSegmentBounds( size_t segment ) const { return mSegmentBounds[segment]; }
+	//! Returns a conservative bounding box of the path, including its implicit closing line
+	const Rectf&	getBounds() const { return mBounds; }
+
+	//! Returns whether the path contains \a pt. Equivalent to Path2d::contains().
+	bool			contains( const vec2 &pt, bool evenOddFill = true ) const;
+	//! Sets \a result[i] to whether the path contains \a points[i], for \a numPoints points. Large batches are distributed across threads.
+	void			contains( const vec2 *points, size_t numPoints, bool *result, bool evenOddFill = true ) const;
+	//! Returns the minimum distance from \a pt to the path. Equivalent to Path2d::calcDistance().
+	float			calcDistance( const vec2 &pt ) const;
+	//! Sets \a result[i] to the minimum distance from \a points[i] to the path, for \a numPoints points. Large batches are distributed across threads.
+	void			calcDistances( const vec2 *points, size_t numPoints, float *result ) const;
+	//! Returns the minimum distances from each of \a points to the path.
+	std::vector<float>	calcDistances( const std::vector<vec2> &points ) const;
+	//! Returns the point on the path closest to \a pt. Equivalent to Path2d::calcClosestPoint().
+	vec2			calcClosestPoint( const vec2 &pt ) const;
+	//! Sets \a result[i] to the point on the path closest to \a points[i], for \a numPoints points. Large batches are distributed across threads.
+	void			calcClosestPoints( const vec2 *points, size_t numPoints, vec2 *result ) const;
+	//! Returns the points on the path closest to each of \a points.
+	std::vector<vec2>	calcClosestPoints( const std::vector<vec2> &points ) const;
 
 	//! Calculates the t-value corresponding to \a relativeTime in the range [0,1) within epsilon of \a tolerance. For example, \a relativeTime of 0.5f returns the t-value corresponding to half the length. \a maxIterations dictates the number of refinement loop iterations allowed, setting an upper bound for worst-case performance.
 	float			calcNormalizedTime( float relativeTime, bool wrap = false, float tolerance = 1.0e-03f, int maxIterations = 16 ) const;
@@ -218,9 +243,16 @@ class CI_API Path2dCalcCache {
 	vec2			getPosition( float t ) const { return mPath.getPosition( t ); }
 
   private:
+	// returns the squared distance from \a pt to the path and its closest point in \a result
+	float	calcClosestPoint( const vec2 &pt, vec2 *result ) const;
+
 	Path2d				mPath;
 	float				mLength;
 	std::vector<float>	mSegmentLengths;
+	std::vector<size_t>	mSegmentFirstPoints;
+	std::vector<Rectf>	mSegmentBounds;
+	Rectf				mClosingLineBounds, mBounds;
+	std::vector<vec2>	mPositions;
 };
 
 class CI_API Path2dExc : public Exception {
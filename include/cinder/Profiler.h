@@ -0,0 +1,138 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/DataTarget.h"
+#include "cinder/Noncopyable.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Setting CI_PROFILER_ENABLED to 0 compiles the CI_PROFILE_* macros and cinder's built-in zones to nothing. The Profiler class remains available.
+#if ! defined( CI_PROFILER_ENABLED )
+	#define CI_PROFILER_ENABLED 1
+#endif
+
+namespace cinder { namespace profile {
+
+//! Returns the time in nanoseconds on the profiler's monotonic clock, which starts at zero when the process first uses the profiler
+CI_API uint64_t now();
+
+//! Low-overhead CPU profiler which records zones, counters and frame markers into a lock-free ring buffer per thread, exportable as a
+//! Chrome trace (viewable in chrome://tracing or ui.perfetto.dev). Recording is disabled until setEnabled( true ) is called.
+//! \note Names passed to the recording functions aren't copied, and must outlive the profiler. String literals are the intended use.
+class CI_API Profiler : private Noncopyable {
+  public:
+	//! Called by recordFrame() with the name of the frame marker and the duration in seconds of a frame exceeding the spike threshold
+	typedef std::function<void ( const char *name, double frameSeconds )>	FrameSpikeFn;
+
+	//! Returns the process-wide Profiler
+	static Profiler&	instance();
+
+	//! Returns whether events are being recorded
+	static bool		isEnabled()		{ return sEnabled.load( std::memory_order_relaxed ); }
+	//! Enables or disables recording of events. \default false.
+	static void		setEnabled( bool enabled = true )	{ sEnabled.store( enabled, std::memory_order_relaxed ); }
+
+	//! Records a zone \a name on the calling thread which ran from \a beginNs to \a endNs, as returned by now()
+	void	recordZone( const char *name, uint64_t beginNs, uint64_t endNs );
+	//! Records the value of counter \a name at the current time
+	void	recordCounter( const char *name, double value );
+	//! Records a frame marker \a name at the current time, calling the FrameSpikeFn if the time since the previous marker of the same thread exceeds the threshold
+	void	recordFrame( const char *name = "Frame" );
+
+	//! Sets the name used for the calling thread in exported traces. Also called by ci::setThreadName().
+	void	setThreadName( const std::string &name );
+	//! Sets the number of events kept per thread, rounded up to a power of two. Applies to threads which haven't recorded any events yet. \default 32768.
+	void	setEventsPerThread( size_t numEvents );
+	//! Sets \a fn to be called on the recording thread whenever a frame takes longer than \a thresholdSeconds. Pass an empty function to disable.
+	void	setFrameSpikeFn( double thresholdSeconds, const FrameSpikeFn &fn );
+
+	//! Returns the events currently held by every thread's buffer in the Chrome trace event JSON format
+	std::string		getChromeTrace() const;
+	//! Writes the events currently held by every thread's buffer to \a target in the Chrome trace event JSON format
+	void			writeChromeTrace( const DataTargetRef &target ) const;
+	//! Discards all recorded events
+	void			clear();
+
+	struct ThreadBuffer;
+
+  private:
+	Profiler();
+
+	ThreadBuffer*	getThreadBuffer();
+
+	static std::atomic<bool>	sEnabled;
+
+	mutable std::mutex							mMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>>	mThreadBuffers;
+	size_t										mEventsPerThread;
+	uint32_t									mNextThreadId;
+	std::shared_ptr<const std::pair<double, FrameSpikeFn>>	mFrameSpike;
+};
+
+//! Records a zone on the calling thread covering the lifetime of the object, if the Profiler is enabled on construction. Usually used via CI_PROFILE_ZONE().
+class CI_API ScopedZone : private Noncopyable {
+  public:
+	explicit ScopedZone( const char *name )
+		: mName( name ), mEnabled( Profiler::isEnabled() ), mBeginNs( mEnabled ? now() : 0 )
+	{}
+	~ScopedZone()
+	{
+		if( mEnabled )
+			Profiler::instance().recordZone( mName, mBeginNs, now() );
+	}
+
+  private:
+	const char	*mName;
+	bool		mEnabled;
+	uint64_t	mBeginNs;
+};
+
+} } // namespace cinder::profile
+
+#define CINDER_PROFILE_CONCAT_IMPL( a, b )	a ## b
+#define CINDER_PROFILE_CONCAT( a, b )		CINDER_PROFILE_CONCAT_IMPL( a, b )
+
+#if CI_PROFILER_ENABLED
+	//! Records a zone named \a name covering the rest of the enclosing scope
+	#define CI_PROFILE_ZONE( name )				::cinder::profile::ScopedZone CINDER_PROFILE_CONCAT( ciProfileZone, __COUNTER__ )( name )
+	//! Records a zone named after the enclosing function covering the rest of its scope
+	#define CI_PROFILE_FUNCTION()				CI_PROFILE_ZONE( __FUNCTION__ )
+	//! Records the value of the counter \a name
+	#define CI_PROFILE_COUNTER( name, value )	( ::cinder::profile::Profiler::isEnabled() ? ::cinder::profile::Profiler::instance().recordCounter( name, value ) : (void)0 )
+	//! Records a frame marker named \a name
+	#define CI_PROFILE_FRAME( name )			( ::cinder::profile::Profiler::isEnabled() ? ::cinder::profile::Profiler::instance().recordFrame( name ) : (void)0 )
+#else
+	#define CI_PROFILE_ZONE( name )				((void)0)
+	#define CI_PROFILE_FUNCTION()				((void)0)
+	#define CI_PROFILE_COUNTER( name, value )	((void)0)
+	#define CI_PROFILE_FRAME( name )			((void)0)
+#endif
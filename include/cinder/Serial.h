@@ -26,12 +26,100 @@
 #include "cinder/Exception.h"
 #include "cinder/Noncopyable.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
 namespace cinder {
 
 typedef std::shared_ptr<class Serial>		SerialRef;
+typedef std::shared_ptr<class SerialFramer>	SerialFramerRef;
+
+//! Splits the bytes received by a Serial port into packets, and frames packets for sending. Used with Serial::startAsync().
+class CI_API SerialFramer {
+  public:
+	typedef std::function<void ( const uint8_t *data, size_t size )>	PacketFn;
+
+	virtual ~SerialFramer() {}
+
+	//! Parses \a size bytes received from the port, calling \a packetFn with the payload of each complete packet
+	virtual void					process( const uint8_t *data, size_t size, const PacketFn &packetFn ) = 0;
+	//! Returns the payload \a data framed for sending
+	virtual std::vector<uint8_t>	frame( const void *data, size_t size ) const = 0;
+	//! Discards any partially received packet
+	virtual void					reset() = 0;
+
+	//! Returns the number of malformed or oversized packets which were discarded
+	size_t	getNumErrors() const	{ return mNumErrors; }
+
+  protected:
+	SerialFramer() : mNumErrors( 0 ) {}
+
+	size_t	mNumErrors;
+};
+
+//! Packets terminated by a delimiter, such as lines of text. The delimiter isn't part of the payload.
+class CI_API SerialDelimiterFramer : public SerialFramer {
+  public:
+	SerialDelimiterFramer( uint8_t delimiter = '\n', size_t maxPacketSize = 4096 );
+
+	void					process( const uint8_t *data, size_t size, const PacketFn &packetFn ) override;
+	std::vector<uint8_t>	frame( const void *data, size_t size ) const override;
+	void					reset() override;
+
+  private:
+	uint8_t					mDelimiter;
+	size_t					mMaxPacketSize;
+	std::vector<uint8_t>	mPacket;
+	bool					mOverflowed;
+};
+
+//! Packets preceded by their size in bytes as an unsigned integer of 1, 2 or 4 bytes
+class CI_API SerialLengthPrefixFramer : public SerialFramer {
+  public:
+	SerialLengthPrefixFramer( size_t numLengthBytes = 2, bool bigEndian = true, size_t maxPacketSize = 65535 );
+
+	void					process( const uint8_t *data, size_t size, const PacketFn &packetFn ) override;
+	std::vector<uint8_t>	frame( const void *data, size_t size ) const override;
+	void					reset() override;
+
+  private:
+	size_t					mNumLengthBytes;
+	bool					mBigEndian;
+	size_t					mMaxPacketSize;
+	size_t					mNumHeaderBytes, mPacketSize;
+	std::vector<uint8_t>	mPacket;
+};
+
+//! Packets encoded with Consistent Overhead Byte Stuffing, which contain no zero bytes, each terminated by a zero byte
+class CI_API SerialCobsFramer : public SerialFramer {
+  public:
+	SerialCobsFramer( size_t maxPacketSize = 4096 );
+
+	void					process( const uint8_t *data, size_t size, const PacketFn &packetFn ) override;
+	std::vector<uint8_t>	frame( const void *data, size_t size ) const override;
+	void					reset() override;
+
+  private:
+	size_t					mMaxPacketSize;
+	std::vector<uint8_t>	mEncoded, mPacket;
+	bool					mOverflowed;
+};
+
+//! Packets encoded with SLIP (RFC 1055), each surrounded by END bytes
+class CI_API SerialSlipFramer : public SerialFramer {
+  public:
+	SerialSlipFramer( size_t maxPacketSize = 4096 );
+
+	void					process( const uint8_t *data, size_t size, const PacketFn &packetFn ) override;
+	std::vector<uint8_t>	frame( const void *data, size_t size ) const override;
+	void					reset() override;
+
+  private:
+	size_t					mMaxPacketSize;
+	std::vector<uint8_t>	mPacket;
+	bool					mEscaped, mInvalid;
+};
 
 class CI_API Serial : private Noncopyable {
   public:
@@ -49,6 +137,32 @@ class CI_API Serial : private Noncopyable {
 		std::string		mPath;
 	};
 	
+	//! Options for reading from a Serial port on a background thread with startAsync()
+	struct CI_API AsyncOptions {
+		AsyncOptions()
+			: mBufferSize( 64 * 1024 ), mMaxQueuedPackets( 1024 )
+		{}
+
+		//! Sets the size of the ring buffer received bytes are stored in until they're read. Bytes received while it's full are dropped. \default 64KB.
+		AsyncOptions&	bufferSize( size_t bufferSize )			{ mBufferSize = bufferSize; return *this; }
+		//! Sets the SerialFramer which splits received bytes into packets. Without one, bytes are read with readBytes() and the other read methods.
+		AsyncOptions&	framer( const SerialFramerRef &framer )	{ mFramer = framer; return *this; }
+		//! Sets a function called on the background thread with each packet as it arrives. Otherwise packets are queued for readPacket().
+		AsyncOptions&	packetFn( const SerialFramer::PacketFn &packetFn )	{ mPacketFn = packetFn; return *this; }
+		//! Sets the number of packets queued for readPacket() before the oldest are dropped. \default 1024.
+		AsyncOptions&	maxQueuedPackets( size_t maxQueuedPackets )	{ mMaxQueuedPackets = maxQueuedPackets; return *this; }
+
+		size_t						getBufferSize() const		{ return mBufferSize; }
+		const SerialFramerRef&		getFramer() const			{ return mFramer; }
+		const SerialFramer::PacketFn&	getPacketFn() const		{ return mPacketFn; }
+		size_t						getMaxQueuedPackets() const	{ return mMaxQueuedPackets; }
+
+	  private:
+		size_t					mBufferSize, mMaxQueuedPackets;
+		SerialFramerRef			mFramer;
+		SerialFramer::PacketFn	mPacketFn;
+	};
+
 	//! Returns a vector of all serial devices available on the machine. Uses a cached list unless \a forceRefresh
 	static const std::vector<Serial::Device>& getDevices( bool forceRefresh = false );
 	//! Returns the first Serial::Device whose name is \a name. Returns a null Serial::Device if none are found. Uses a cached list of the serial devices unless \a forceRefresh.
@@ -76,7 +190,7 @@ class CI_API Serial : private Noncopyable {
 	//! Returns a single character read from the serial port
 	char	readChar() { return static_cast<char>( readByte() ); }
 
-	//! Returns a string composed of bytes read until a character \a token is found, or up to \a maxLength bytes have been read and \a maxLength > 0. Throws a SerialTimeoutExc() if timeoutSeconds > 0 and \a timeoutSeconds seconds pass before \a token is found.
+	//! Returns a string composed of bytes read until a character \a token is found, or up to \a maxLength bytes have been read and \a maxLength > 0. Throws a SerialTimeoutExc() if timeoutSeconds > 0 and \a timeoutSeconds seconds pass before \a token is found. After startAsync(), waits for bytes to arrive rather than polling the device.
 	std::string	readStringUntil( char token, size_t maxLength = 0, double timeoutSeconds = -1.0 );
 	//! Writes a string \a str to the serial port, excluding the null terminator
 	void		writeString( const std::string &str );
@@ -85,6 +199,27 @@ class CI_API Serial : private Noncopyable {
 	void	flush( bool input = true, bool output = true );
 	//! Returns the number of bytes available for reading from the device
 	size_t	getNumBytesAvailable() const;
+
+	//! Starts reading from the port on a background thread woken by epoll as data arrives, so that reads no longer poll the device.
+	//! Received bytes are either stored for the read methods, which block until enough have arrived, or split into packets by a SerialFramer.
+	//! Writes are queued and written by the background thread, batching writes made while the port is busy. Only supported on Linux.
+	void	startAsync( const AsyncOptions &options = AsyncOptions() );
+	//! Stops the background thread, after writing any queued bytes or waiting up to a second for the port to accept them. Bytes received but not yet read are returned by the reads that follow.
+	void	stopAsync();
+	//! Returns whether a background thread is reading from the port
+	bool	isAsync() const;
+
+	//! Moves the oldest queued packet into \a packet, waiting up to \a timeoutSeconds for one to arrive, or until one does when \a timeoutSeconds is negative, like readStringUntil(). Returns \c false if there was none or the port closed. Requires a SerialFramer.
+	bool	readPacket( std::vector<uint8_t> *packet, double timeoutSeconds = 0 );
+	//! Writes \a size bytes of \a data framed by the SerialFramer passed to startAsync()
+	void	writePacket( const void *data, size_t size );
+	//! Returns the number of packets waiting to be read with readPacket()
+	size_t	getNumQueuedPackets() const;
+	//! Returns the number of bytes which haven't been written to the port yet
+	size_t	getNumBytesQueuedForWrite() const;
+	//! Returns the number of bytes and packets dropped since startAsync() because the ring buffer or packet queue was full
+	size_t	getNumBytesDropped() const;
+	size_t	getNumPacketsDropped() const;
 	
   protected:
 	Serial( const Serial::Device &device, int baudRate );
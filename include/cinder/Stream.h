@@ -122,7 +122,8 @@ class CI_API IStreamCinder : public virtual StreamBase {
 	void		read( fs::path *p );
 	void		readFixedString( char *t, size_t maxSize, bool nullTerminate );
 	void		readFixedString( std::string *t, size_t size );
-	std::string	readLine();
+	//! Reads characters until a line feed, carriage return or both, which are consumed but not returned
+	virtual std::string	readLine();
 	
 	void			readData( void *dest, size_t size );
 	virtual size_t	readDataAvailable( void *dest, size_t maxSize ) = 0;
@@ -295,6 +296,8 @@ class CI_API IStreamMem : public IStreamCinder {
 	void		seekRelative( off_t relativeOffset );
 	//! Returns the current offset into the stream in bytes
 	off_t		tell() const;
+	//! Scans the data for the end of the line directly rather than reading a character at a time
+	std::string	readLine() override;
 	//! Returns the total length of stream in bytes
 	off_t		size() const { return static_cast<off_t>( mDataSize ); }
 
@@ -315,6 +318,65 @@ class CI_API IStreamMem : public IStreamCinder {
 };
 
 
+typedef std::shared_ptr<class MappedFile>	MappedFileRef;
+
+//! A read-only memory mapping of a file. Its pages are read by the OS as they're first accessed rather than copied into memory up front, and are shared with the OS file cache.
+class CI_API MappedFile : public std::enable_shared_from_this<MappedFile>, private Noncopyable {
+ public:
+	//! Describes how the mapped data will be accessed, which determines how far ahead the OS reads
+	enum class Access { NORMAL, SEQUENTIAL, RANDOM, WILL_NEED };
+
+	//! Maps the file located at \a path, advising the OS it will be accessed as \a access. Throws StreamExc if the file can't be opened or mapped.
+	static MappedFileRef	create( const fs::path &path, Access access = Access::NORMAL );
+	~MappedFile();
+
+	//! Returns a pointer to the mapped contents of the file, or \c nullptr if it's empty
+	const void*		getData() const { return mData; }
+	//! Returns the size of the file in bytes
+	size_t			getSize() const { return mSize; }
+	//! Returns the path of the mapped file
+	const fs::path&	getFilePath() const { return mFilePath; }
+
+	//! Advises the OS that the \a length bytes at \a offset will be accessed as \a access. A \a length of \c 0 extends to the end of the file. Ignored where unsupported.
+	void			advise( Access access, size_t offset = 0, size_t length = 0 );
+	//! Returns a Buffer which views the \a size bytes at \a offset of the mapping without copying them, and keeps the mapping alive. A \a size of \c 0 extends to the end of the file.
+	//! The pages are mapped copy-on-write, so writes to the Buffer are private and never reach the file.
+	BufferRef		createBuffer( size_t offset = 0, size_t size = 0 );
+
+ protected:
+	MappedFile( const fs::path &path, Access access );
+
+	fs::path	mFilePath;
+	uint8_t		*mData;
+	size_t		mSize;
+#if defined( CINDER_MSW )
+	void		*mFileHandle, *mMappingHandle;
+#endif
+};
+
+
+typedef std::shared_ptr<class IStreamMapped>	IStreamMappedRef;
+
+//! An IStreamMem which reads from a MappedFile and keeps it alive. readBuffer() returns views of the data rather than copies.
+class CI_API IStreamMapped : public IStreamMem {
+ public:
+	//! Creates a new IStreamMappedRef reading from \a mappedFile
+	static IStreamMappedRef		create( const MappedFileRef &mappedFile );
+
+	//! Returns a Buffer which views the next \a size bytes of the stream without copying them, and advances past them. Throws StreamExc if fewer than \a size bytes remain.
+	BufferRef		readBuffer( size_t size );
+	//! Returns a pointer to the data at the current offset of the stream, which remains valid for the lifetime of the MappedFile
+	const void*		getCurrentData() const { return mData + mOffset; }
+
+	const MappedFileRef&	getMappedFile() const { return mMappedFile; }
+
+ protected:
+	IStreamMapped( const MappedFileRef &mappedFile );
+
+	MappedFileRef	mMappedFile;
+};
+
+
 typedef std::shared_ptr<class OStreamMem>		OStreamMemRef;
 
 class CI_API OStreamMem : public OStream {
@@ -356,6 +418,8 @@ class CI_API IStreamStateRestore {
 
 //! Opens the file lcoated at \a path for read access as a stream.
 CI_API IStreamFileRef	loadFileStream( const fs::path &path );
+//! Maps the file located at \a path into memory and opens it for read access as a stream, advising the OS it will be accessed as \a access. Throws StreamExc on failure.
+CI_API IStreamMappedRef	loadFileStreamMapped( const fs::path &path, MappedFile::Access access = MappedFile::Access::SEQUENTIAL );
 //! Opens the file located at \a path for write access as a stream, and creates it if it does not exist. Optionally creates any intermediate directories when \a createParents is true.
 CI_API OStreamFileRef	writeFileStream( const fs::path &path, bool createParents = true );
 //! Opens a path for read-write access as a stream.
@@ -0,0 +1,200 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Exception.h"
+#include "cinder/Noncopyable.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cinder {
+
+typedef std::shared_ptr<class Task>		TaskRef;
+
+//! A unit of work run by a TaskScheduler once all of the tasks it depends on have completed. Created by TaskScheduler::run().
+class CI_API Task : private Noncopyable {
+  public:
+	//! Returns whether the task has finished running
+	bool		isComplete() const	{ return mComplete; }
+	//! Returns the name the task was created with, which may be \c nullptr
+	const char*	getName() const		{ return mName; }
+	//! Blocks until the task has completed, running other tasks in the meantime. Rethrows any exception the task threw.
+	void		wait() const;
+
+  private:
+	Task( class TaskScheduler *scheduler, const std::function<void ()> &fn, const char *name );
+
+	class TaskScheduler		*mScheduler;
+	std::function<void ()>	mFn;
+	std::function<void ( const std::function<void ()> &fn )>	mDispatchFn;
+	const char				*mName;
+
+	std::atomic<size_t>		mNumDependencies; // incomplete dependencies, plus one until the task has been fully set up
+	std::mutex				mSuccessorsMutex;
+	std::vector<TaskRef>	mSuccessors;
+	std::atomic<bool>		mComplete;
+	std::exception_ptr		mException;
+
+	friend class TaskScheduler;
+};
+
+//! Work-stealing scheduler which runs Tasks on a fixed pool of threads.
+//!
+//! Each thread keeps its own queue of tasks, running the most recently added first, and steals the oldest tasks from the other
+//! threads' queues when its own is empty. Tasks may depend on other tasks, forming a graph which is run as its dependencies complete.
+//! Threads waiting for a task run other tasks in the meantime, so it's safe to wait from within a task.
+class CI_API TaskScheduler : private Noncopyable {
+  public:
+	struct Options {
+		Options()
+			: mNumThreads( std::max<size_t>( std::thread::hardware_concurrency(), 1 ) )
+		{}
+
+		//! Sets the number of threads which run tasks, including the thread waiting for them. \default std::thread::hardware_concurrency().
+		Options& numThreads( size_t numThreads )	{ mNumThreads = std::max<size_t>( numThreads, 1 ); return *this; }
+		size_t	getNumThreads() const				{ return mNumThreads; }
+
+	  private:
+		size_t	mNumThreads;
+	};
+
+	//! Called with the name of a task and the index of the thread it runs on, where 0 is any thread outside the scheduler
+	typedef std::function<void ( const char *taskName, size_t threadIndex )>	TraceFn;
+	//! Used by dispatch() to run a function on another thread
+	typedef std::function<void ( const std::function<void ()> &fn )>			DispatchFn;
+
+	explicit TaskScheduler( const Options &options = Options() );
+	//! Waits for any queued tasks to run before returning
+	~TaskScheduler();
+
+	//! Returns the process-wide instance of TaskScheduler, which is used by parallelFor()
+	static TaskScheduler&	instance();
+
+	//! Returns the number of threads which run tasks, including the thread waiting for them. With a single thread, tasks run on the thread which makes them ready.
+	size_t		getNumThreads() const	{ return mWorkers.size() + 1; }
+
+	//! Runs \a fn once every task in \a dependencies has completed. \a name is used for tracing and should outlive the task.
+	TaskRef		run( const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies = std::vector<TaskRef>(), const char *name = nullptr );
+	//! Passes \a fn to \a dispatchFn once every task in \a dependencies has completed, to run on whichever thread \a dispatchFn chooses.
+	TaskRef		dispatch( const DispatchFn &dispatchFn, const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies = std::vector<TaskRef>(), const char *name = nullptr );
+	//! Runs \a fn on the App's main thread via AppBase::dispatchAsync() once every task in \a dependencies has completed.
+	//! \note Waiting on the returned task from the main thread will never return.
+	TaskRef		runOnMainThread( const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies = std::vector<TaskRef>(), const char *name = nullptr );
+
+	//! Blocks until \a task has completed, running other tasks in the meantime. Rethrows any exception the task threw.
+	void		wait( const TaskRef &task );
+	//! Blocks until every task in \a tasks has completed. Rethrows the first exception thrown by any of them.
+	void		wait( const std::vector<TaskRef> &tasks );
+
+	//! Calls \a fn( begin, end ) for consecutive ranges covering <tt>[0, count)</tt> of at least \a minItemsPerTask items, and returns once all have completed.
+	//! Small counts run entirely on the calling thread.
+	template<typename FnT>
+	void		parallelFor( size_t count, size_t minItemsPerTask, const FnT &fn );
+	//! Returns the result of combining \a identity with \a mapFn( begin, end ) for consecutive ranges covering <tt>[0, count)</tt> using \a reduceFn.
+	//! The results of the ranges are combined in order, so \a reduceFn needs to be associative but not commutative.
+	template<typename T, typename MapFnT, typename ReduceFnT>
+	T			parallelReduce( size_t count, size_t minItemsPerTask, const T &identity, const MapFnT &mapFn, const ReduceFnT &reduceFn );
+
+	//! Sets functions called before and after every task runs, on the thread running it. Pass empty functions to disable tracing.
+	void		setTraceFns( const TraceFn &beginFn, const TraceFn &endFn );
+
+  private:
+	struct Worker;
+	struct TraceFns {
+		TraceFn		mBeginFn, mEndFn;
+	};
+
+	void		schedule( const TaskRef &task );
+	void		submit( const TaskRef &task, const std::vector<TaskRef> &dependencies );
+	void		execute( const TaskRef &task );
+	void		complete( Task *task );
+	TaskRef		findTask();
+	void		workerEntry( Worker *worker );
+	size_t		calcNumTasks( size_t count, size_t minItemsPerTask ) const;
+	void		runRanges( size_t count, size_t numTasks, const std::function<void ( size_t task, size_t begin, size_t end )> &fn );
+	//! Returns the Worker of this scheduler running on the calling thread, if any
+	Worker*		getCurrentWorker() const;
+
+	std::vector<std::unique_ptr<Worker>>	mWorkers;
+	std::mutex								mQueueMutex; // tasks submitted from outside the scheduler's threads
+	std::deque<TaskRef>						mQueue;
+	std::atomic<std::ptrdiff_t>				mNumQueued;
+	std::atomic<size_t>						mNumWaiting;
+	std::mutex								mSleepMutex;
+	std::condition_variable					mSleepCondition;
+	std::atomic<bool>						mQuit;
+	std::shared_ptr<const TraceFns>			mTraceFns;
+
+	friend class Task;
+};
+
+//! Exception type thrown by TaskScheduler
+class CI_API TaskSchedulerExc : public Exception {
+  public:
+	TaskSchedulerExc( const std::string &description )
+		: Exception( description )
+	{}
+};
+
+template<typename FnT>
+void TaskScheduler::parallelFor( size_t count, size_t minItemsPerTask, const FnT &fn )
+{
+	const size_t numTasks = calcNumTasks( count, minItemsPerTask );
+	if( numTasks <= 1 ) {
+		fn( size_t( 0 ), count );
+		return;
+	}
+
+	runRanges( count, numTasks, [&fn]( size_t, size_t begin, size_t end ) { fn( begin, end ); } );
+}
+
+template<typename T, typename MapFnT, typename ReduceFnT>
+T TaskScheduler::parallelReduce( size_t count, size_t minItemsPerTask, const T &identity, const MapFnT &mapFn, const ReduceFnT &reduceFn )
+{
+	static_assert( ! std::is_same<T, bool>::value, "std::vector<bool> can't be written concurrently" );
+
+	const size_t numTasks = calcNumTasks( count, minItemsPerTask );
+	if( numTasks <= 1 )
+		return reduceFn( identity, mapFn( size_t( 0 ), count ) );
+
+	std::vector<T> results( numTasks, identity );
+	runRanges( count, numTasks, [&results, &mapFn]( size_t task, size_t begin, size_t end ) { results[task] = mapFn( begin, end ); } );
+
+	T result = identity;
+	for( const T &taskResult : results )
+		result = reduceFn( result, taskResult );
+	return result;
+}
+
+} // namespace cinder
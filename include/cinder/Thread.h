@@ -23,6 +23,7 @@
 #pragma once
 
 #include "cinder/Cinder.h"
+#include "cinder/TaskScheduler.h"
 #if defined( CINDER_COCOA )
 	#include "cinder/cocoa/CinderCocoa.h"
 #endif
@@ -51,4 +52,19 @@ class CI_API ThreadSetup {
 #endif
 };
 
+//! Calls \a fn( begin, end ) for consecutive ranges covering <tt>[0, count)</tt>, run as tasks of TaskScheduler::instance() including on the calling thread.
+//! Each range contains at least \a minItemsPerThread items, so small counts run entirely on the calling thread. Rethrows the first exception thrown by \a fn.
+template<typename FnT>
+void parallelFor( size_t count, size_t minItemsPerThread, const FnT &fn )
+{
+	TaskScheduler::instance().parallelFor( count, minItemsPerThread, fn );
+}
+
+//! Returns the result of combining \a identity with \a mapFn( begin, end ) for consecutive ranges covering <tt>[0, count)</tt> using \a reduceFn, run as tasks of TaskScheduler::instance().
+template<typename T, typename MapFnT, typename ReduceFnT>
+T parallelReduce( size_t count, size_t minItemsPerThread, const T &identity, const MapFnT &mapFn, const ReduceFnT &reduceFn )
+{
+	return TaskScheduler::instance().parallelReduce( count, minItemsPerThread, identity, mapFn, reduceFn );
+}
+
 } // namespace cinder
@@ -26,6 +26,8 @@
 #pragma once
 
 #include <vector>
+#include <cfloat>
+#include <cmath>
 #include "cinder/Vector.h"
 #include "cinder/AxisAlignedBox.h"
 #include "cinder/DataSource.h"
@@ -312,7 +314,12 @@ class CI_API TriMesh : public geom::Source {
 		nor will it affect texture mapping. If \a weighted is TRUE, larger polygons contribute more to
 		the calculated normal. Renormalization requires 3D vertices. */
 	bool		recalculateNormals( bool smooth = false, bool weighted = false );
-	//! Adds or replaces tangents by calculating them from the normals and texture coordinates. Requires 3D normals and 2D texture coordinates.
+	/*! Adds or replaces normals by calculating them from the vertices and faces. If \a smooth is TRUE, vertices closer
+		than \a weldEpsilon are grouped together to calculate their average, using a spatial hash (see geom::weldVertices()).
+		\a weighting controls how the normals of adjacent triangles are combined. Large meshes are processed in parallel.
+		Renormalization requires 3D vertices. */
+	bool		recalculateNormals( bool smooth, geom::NormalWeighting weighting, float weldEpsilon = std::sqrt( FLT_EPSILON ) );
+	//! Adds or replaces tangents by calculating them from the normals and texture coordinates. Requires 3D normals and 2D texture coordinates. Large meshes are processed in parallel.
 	bool		recalculateTangents();
 	//! Adds or replaces bitangents by calculating them from the normals and tangents. Requires 3D normals and tangents.
 	bool		recalculateBitangents();
@@ -321,6 +328,20 @@ class CI_API TriMesh : public geom::Source {
 		Optionally, vertices are normalized if \a normalize is TRUE. */
 	void		subdivide( int division = 2, bool normalize = false );
 
+	//! Reorders the triangles to reduce post-transform vertex cache misses for a cache of \a cacheSize entries. See geom::optimizeVertexCache().
+	void		optimizeVertexCache( geom::VertexCacheMethod method = geom::VertexCacheMethod::TIPSIFY, size_t cacheSize = 16 );
+	//! Reorders clusters of triangles to reduce overdraw, allowing the cache miss ratio to grow by up to \a threshold times. Call after optimizeVertexCache(). Requires 3D positions. See geom::optimizeOverdraw().
+	bool		optimizeOverdraw( float threshold = 1.05f, size_t cacheSize = 16 );
+	//! Renumbers the vertices in the order the triangles first use them, reordering all vertex attributes. Call last. See geom::optimizeVertexFetch().
+	void		optimizeVertexFetch();
+	/*! Reduces the number of triangles to about \a ratio times the current number, see geom::simplify(). Vertices are left in place, so call optimizeVertexFetch()
+		to move the unused ones to the end. Writes the error introduced to \a resultError when non-NULL. Requires 3D positions. */
+	bool		simplify( float ratio, const geom::SimplifyOptions &options = geom::SimplifyOptions(), float *resultError = nullptr );
+	//! Returns levels of detail keeping \a ratios of the triangles each, generated in a single pass by geom::simplifyLods(). Requires 3D positions.
+	std::vector<geom::SimplifiedLod>	calcLods( const std::vector<float> &ratios, const geom::SimplifyOptions &options = geom::SimplifyOptions() ) const;
+	//! Simulates a FIFO post-transform vertex cache of \a cacheSize entries rendering the TriMesh. See geom::simulateVertexCache().
+	geom::VertexCacheStats	calcVertexCacheStats( size_t cacheSize = 16 ) const;
+
 	//! Create TriMesh from vectors of vertex data.
 /*	static TriMesh		create( std::vector<uint32_t> &indices, const std::vector<ColorAf> &colors,
 							   const std::vector<vec3> &normals, const std::vector<vec3> &positions,
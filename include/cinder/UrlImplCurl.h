@@ -23,12 +23,15 @@
 #pragma once
 
 #include "cinder/Url.h"
+#include "cinder/HttpClient.h"
 
-typedef void CURL;
-typedef void CURLM;
+#include <condition_variable>
+#include <mutex>
+#include <vector>
 
 namespace cinder {
 
+//! Streams the body of a transfer made by the shared HttpClient, blocking reads until enough of it has arrived
 class IStreamUrlImplCurl : public IStreamUrlImpl {
   public:
 	IStreamUrlImplCurl( const std::string &url, const std::string &user, const std::string &password, const UrlOptions &options );
@@ -44,29 +47,24 @@ class IStreamUrlImplCurl : public IStreamUrlImpl {
 	virtual void		IORead( void *t, size_t size );
 
   private:
-	int					bufferRemaining() const { return mBufferedBytes - mBufferOffset; }
-	void				fillBuffer( int wantBytes ) const;
-	
-	static size_t		writeCallback( char *buffer, size_t size, size_t nitems, void *userp );   
-  
- 	CURL					*mCurl;
-	CURLM					*mMulti;
-	
-	std::string				mUserColonPassword;
-	
-	mutable int still_running;				// Is background url fetch still in progress
-	mutable bool			mStartedRead;
+	size_t				bufferRemaining() const { return mBuffer.size() - mBufferOffset; }
+	//! Blocks until \a wantBytes are buffered or the transfer has finished. Expects \a lock to hold mMutex.
+	void				waitForData( std::unique_lock<std::mutex> &lock, size_t wantBytes ) const;
+	//! Resumes a paused transfer once fewer than MAX_BUFFERED_SIZE, or \a wantBytes, are left to read. Expects mMutex to be held.
+	void				resumeIfDrained( size_t wantBytes ) const;
+	bool				receive( const void *data, size_t size );
 
-	mutable off_t			mSize;
-	mutable bool			mSizeCached;
-	mutable long			mResponseCode;
-	mutable char			*mEffectiveUrl;
-	
-	mutable uint8_t		*mBuffer;
-	mutable int			mBufferSize;
-	mutable int			mBufferOffset, mBufferedBytes;
-	mutable off_t		mBufferFileOffset;	// where in the file the buffer starts
-	static const int	DEFAULT_BUFFER_SIZE = 4096;
+	HttpTransferRef						mTransfer;
+
+	mutable std::mutex					mMutex;
+	mutable std::condition_variable		mDataCondition;
+	bool								mComplete;
+	std::vector<uint8_t>				mBuffer;
+	size_t								mBufferOffset;
+	off_t								mBufferFileOffset;	// where in the file the buffer starts
+	mutable size_t						mWantBytes;			// what a blocked read is waiting for, which mustn't pause the transfer
+	static const size_t					DEFAULT_BUFFER_SIZE = 4096;
+	static const size_t					MAX_BUFFERED_SIZE = 1024 * 1024;	// unread bytes beyond which the transfer is paused
 };
 
 } // namespace cinder
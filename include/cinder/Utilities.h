@@ -97,7 +97,7 @@ CI_API std::string trim( const std::string &str );
 //! Returns a stack trace (aka backtrace) where \c stackTrace()[0] == caller, \c stackTrace()[1] == caller's parent, etc
 CI_API std::vector<std::string> stackTrace();
 
-//! Sets the name of the current thread to \a name
+//! Sets the name of the current thread to \a name, which is also used for it in profile::Profiler traces
 CI_API void setThreadName( const std::string &name );
 
 // ENDIANNESS
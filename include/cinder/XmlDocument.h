@@ -0,0 +1,337 @@
+/*
+ Copyright (c) 2018, The Cinder Project
+ All rights reserved.
+
+ This code is designed for use with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+	* Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Xml.h"
+#include "cinder/Noncopyable.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace cinder {
+
+//! \brief Read-only XML document which references the parsed input rather than copying it.
+//!
+//! The input is parsed in place by RapidXML, so tags, values and attributes point directly into the source buffer. Nodes and attributes
+//! are stored in two flat arrays, with the children of each node laid out contiguously, and elements with many children carry a sorted
+//! index of their children's tags. Uses XmlTree::ParseOptions and XmlTree::NodeType, so code can move between the two with few changes.
+class CI_API XmlDocument : private Noncopyable {
+	struct TagIndexEntry;
+
+  public:
+	class Node;
+
+	//! An attribute of a Node. The name and value are null-terminated and remain valid for the lifetime of the XmlDocument.
+	class CI_API Attr {
+	  public:
+		const char*		getName() const			{ return mName; }
+		size_t			getNameLength() const	{ return mNameLength; }
+		const char*		getValue() const		{ return mValue; }
+		size_t			getValueLength() const	{ return mValueLength; }
+		//! Returns the value of the attribute parsed as a T using ci::fromString().
+		template<typename T>
+		T				getValue() const		{ return fromString<T>( mValue ); }
+
+	  private:
+		const char		*mName = "", *mValue = "";
+		uint32_t		mNameLength = 0, mValueLength = 0;
+
+		friend class XmlDocument;
+	};
+
+	//! A node of an XmlDocument, which owns it. Nodes are only valid for the lifetime of their XmlDocument.
+	class CI_API Node {
+	  public:
+		XmlTree::NodeType	getNodeType() const		{ return mNodeType; }
+		bool				isDocument() const		{ return mNodeType == XmlTree::NODE_DOCUMENT; }
+		bool				isElement() const		{ return mNodeType == XmlTree::NODE_ELEMENT; }
+		bool				isCData() const			{ return mNodeType == XmlTree::NODE_CDATA; }
+		bool				isComment() const		{ return mNodeType == XmlTree::NODE_COMMENT; }
+		bool				isData() const			{ return mNodeType == XmlTree::NODE_DATA; }
+
+		//! Returns the null-terminated tag of the node. Data nodes and the document node have an empty tag.
+		const char*			getTag() const			{ return mTag; }
+		size_t				getTagLength() const	{ return mTagLength; }
+		//! Returns whether the node's tag is \a tag. Unlike comparing getTag() with \c ==, compares the characters rather than the pointers.
+		bool				isTag( const char *tag, bool caseSensitive = true ) const;
+
+		//! Returns the null-terminated value of the node. For elements this is the text of the first data child, as with XmlTree.
+		const char*			getValue() const		{ return mValue; }
+		size_t				getValueLength() const	{ return mValueLength; }
+		//! Returns the value of the node parsed as a T using ci::fromString().
+		template<typename T>
+		T					getValue() const		{ return fromString<T>( mValue ); }
+		//! Returns the value of the node parsed as a T. If the value is empty or fails to parse \a defaultValue is returned.
+		template<typename T>
+		T					getValue( const T &defaultValue ) const	{ try { return fromString<T>( mValue ); } catch( ... ) { return defaultValue; } }
+
+		bool				hasParent() const		{ return mParent != nullptr; }
+		const Node&			getParent() const		{ return *mParent; }
+
+		//! Returns the number of children, including data, CDATA and comment nodes depending on the XmlTree::ParseOptions.
+		size_t				getNumChildren() const	{ return mNumChildren; }
+		//! Returns the child at \a index, which must be less than getNumChildren().
+		const Node&			getChild( size_t index ) const	{ return mChildren[index]; }
+		//! Returns an iterator to the first child. Children are contiguous, so a \c Node pointer is a random access iterator.
+		const Node*			begin() const			{ return mChildren; }
+		//! Returns an iterator past the last child.
+		const Node*			end() const				{ return mChildren + mNumChildren; }
+
+		//! Returns the first child element with the tag \a tag, or \c nullptr if there is none.
+		const Node*			findChild( const char *tag, bool caseSensitive = false ) const;
+		//! Returns the next sibling with exactly the same tag as this node, or \c nullptr. Together with findChild() iterates all children with a given tag.
+		const Node*			getNextSameTag() const	{ return mNextSameTag; }
+		//! Returns whether the child element at \a relativePath exists.
+		bool				hasChild( const std::string &relativePath, bool caseSensitive = false, char separator = '/' ) const;
+		//! Returns the child element at \a relativePath. Throws XmlDocument::ExcChildNotFound if none matches.
+		const Node&			getChild( const std::string &relativePath, bool caseSensitive = false, char separator = '/' ) const;
+		//! Returns the first child element that matches \a childName. Throws XmlDocument::ExcChildNotFound if none matches.
+		const Node&			operator/( const std::string &childName ) const	{ return getChild( childName ); }
+
+		size_t				getNumAttributes() const	{ return mNumAttributes; }
+		const Attr*			beginAttributes() const		{ return mAttributes; }
+		const Attr*			endAttributes() const		{ return mAttributes + mNumAttributes; }
+		//! Returns the attribute named \a attrName, or \c nullptr if there is none.
+		const Attr*			findAttribute( const char *attrName ) const;
+		bool				hasAttribute( const char *attrName ) const	{ return findAttribute( attrName ) != nullptr; }
+		//! Returns the attribute named \a attrName. Throws XmlDocument::ExcAttrNotFound if no attribute exists with that name.
+		const Attr&			getAttribute( const char *attrName ) const;
+		//! Returns the value of the attribute \a attrName, or an empty string if there is no such attribute.
+		const char*			operator[]( const char *attrName ) const	{ const Attr *attr = findAttribute( attrName ); return attr ? attr->getValue() : ""; }
+		//! Returns the value of the attribute \a attrName parsed as a T. Throws XmlDocument::ExcAttrNotFound if no attribute exists with that name.
+		template<typename T>
+		T					getAttributeValue( const char *attrName ) const	{ return getAttribute( attrName ).getValue<T>(); }
+		//! Returns the value of the attribute \a attrName parsed as a T, or \a defaultValue if there is no such attribute or it fails to parse.
+		template<typename T>
+		T					getAttributeValue( const char *attrName, const T &defaultValue ) const;
+
+		//! Returns a path to this node, separated by the character \a separator.
+		std::string			getPath( char separator = '/' ) const;
+
+	  private:
+		const char				*mTag = "", *mValue = "";
+		uint32_t				mTagLength = 0, mValueLength = 0;
+		uint32_t				mTagHash = 0;
+		XmlTree::NodeType		mNodeType = XmlTree::NODE_UNKNOWN;
+		uint32_t				mNumChildren = 0, mNumAttributes = 0, mNumTagIndexEntries = 0;
+
+		const Node				*mParent = nullptr, *mChildren = nullptr, *mNextSameTag = nullptr;
+		const Attr				*mAttributes = nullptr;
+		//! Sorted by hash, only present for elements with many children.
+		const TagIndexEntry		*mTagIndex = nullptr;
+
+		friend class XmlDocument;
+	};
+
+	//! Parses the XML contained in \a dataSource. The data is copied once into a buffer owned by the XmlDocument, which is then parsed in place.
+	explicit XmlDocument( const DataSourceRef &dataSource, const XmlTree::ParseOptions &parseOptions = XmlTree::ParseOptions() );
+	//! Parses the XML contained in the string \a xmlString.
+	explicit XmlDocument( const std::string &xmlString, const XmlTree::ParseOptions &parseOptions = XmlTree::ParseOptions() );
+	//! Parses \a buffer in place without copying it. The XmlDocument keeps a reference to \a buffer, whose contents are modified by parsing.
+	explicit XmlDocument( const BufferRef &buffer, const XmlTree::ParseOptions &parseOptions = XmlTree::ParseOptions() );
+
+	//! Returns the document node, whose children are the top-level nodes of the document.
+	const Node&			getRoot() const		{ return mNodes.front(); }
+	//! Convenience for getRoot().getChild( relativePath ).
+	const Node&			getChild( const std::string &relativePath, bool caseSensitive = false, char separator = '/' ) const	{ return getRoot().getChild( relativePath, caseSensitive, separator ); }
+	//! Convenience for getRoot().hasChild( relativePath ).
+	bool				hasChild( const std::string &relativePath, bool caseSensitive = false, char separator = '/' ) const	{ return getRoot().hasChild( relativePath, caseSensitive, separator ); }
+	//! Returns the document's DOCTYPE string, if any.
+	const std::string&	getDocType() const	{ return mDocType; }
+	//! Returns the total number of nodes, including the document node.
+	size_t				getNumNodes() const	{ return mNodes.size(); }
+
+	//! Returns the number of bytes used by the document, including the source buffer.
+	size_t				getMemoryUsage() const;
+
+	//! Base class for XmlDocument and XmlPullParser exceptions.
+	class CI_API Exception : public cinder::Exception {
+	  public:
+		Exception( const std::string &description ) : cinder::Exception( description )	{}
+	};
+
+	//! Exception thrown when the input is not well-formed XML.
+	class CI_API ExcParseError : public XmlDocument::Exception {
+	  public:
+		ExcParseError( const std::string &message, size_t offset );
+
+		//! Returns the byte offset into the input at which the error was detected.
+		size_t	getOffset() const	{ return mOffset; }
+
+	  private:
+		size_t	mOffset;
+	};
+
+	//! Exception expressing the absence of an expected child node.
+	class CI_API ExcChildNotFound : public XmlDocument::Exception {
+	  public:
+		ExcChildNotFound( const Node &node, const std::string &childPath );
+	};
+
+	//! Exception expressing the absence of an expected attribute.
+	class CI_API ExcAttrNotFound : public XmlDocument::Exception {
+	  public:
+		ExcAttrNotFound( const std::string &nodePath, const std::string &attrName );
+	};
+
+  private:
+	struct TagIndexEntry {
+		uint32_t	mHash;
+		const Node	*mNode;
+	};
+
+	void	parse( char *text, const XmlTree::ParseOptions &parseOptions );
+	void	buildChildren( const rapidxml::xml_node<char> &xmlNode, Node *node, const XmlTree::ParseOptions &parseOptions, std::vector<Node*> *scratch );
+
+	BufferRef					mSource;
+	std::vector<Node>			mNodes;
+	std::vector<Attr>			mAttributes;
+	std::vector<TagIndexEntry>	mTagIndex;
+	//! Element values that had to be assembled from several CDATA sections, which therefore can't point into mSource.
+	std::deque<std::string>		mCollapsedValues;
+	std::string					mDocType;
+};
+
+template<typename T>
+T XmlDocument::Node::getAttributeValue( const char *attrName, const T &defaultValue ) const
+{
+	const Attr *attr = findAttribute( attrName );
+	if( ! attr )
+		return defaultValue;
+
+	try {
+		return attr->getValue<T>();
+	}
+	catch( ... ) {
+		return defaultValue;
+	}
+}
+
+//! \brief Incremental XML parser which reads its input in chunks and reports it one event at a time.
+//!
+//! Suited to documents too large to hold in memory at once, or when only a small part of a document is of interest (see skipElement()).
+//! Entities are decoded, processing instructions and the DOCTYPE are skipped. The strings returned by the accessors are only valid until
+//! the next call to next().
+class CI_API XmlPullParser : private Noncopyable {
+  public:
+	//! Options for XmlPullParser, passed to its constructor.
+	class CI_API Options {
+	  public:
+		Options() : mChunkSize( 64 * 1024 ), mParseComments( false ), mIgnoreWhitespace( true )	{}
+
+		//! Sets the number of bytes read from the stream at a time. Default 64kb.
+		Options& chunkSize( size_t bytes )					{ mChunkSize = bytes; return *this; }
+		//! Sets whether COMMENT events are reported. Default \c false.
+		Options& parseComments( bool parse = true )			{ mParseComments = parse; return *this; }
+		//! Sets whether TEXT events consisting only of whitespace are skipped. Default \c true.
+		Options& ignoreWhitespace( bool ignore = true )		{ mIgnoreWhitespace = ignore; return *this; }
+
+		size_t	getChunkSize() const			{ return mChunkSize; }
+		bool	getParseComments() const		{ return mParseComments; }
+		bool	getIgnoreWhitespace() const		{ return mIgnoreWhitespace; }
+
+	  private:
+		size_t	mChunkSize;
+		bool	mParseComments, mIgnoreWhitespace;
+	};
+
+	enum Event { START_ELEMENT, END_ELEMENT, TEXT, CDATA, COMMENT, END_DOCUMENT };
+
+	explicit XmlPullParser( const IStreamRef &stream, const Options &options = Options() );
+	explicit XmlPullParser( const DataSourceRef &dataSource, const Options &options = Options() );
+
+	//! Advances to the next event and returns it. Self-closing elements produce a START_ELEMENT followed by an END_ELEMENT. Throws XmlDocument::ExcParseError if the input is malformed.
+	Event				next();
+	//! Returns the current event.
+	Event				getEvent() const		{ return mEvent; }
+	//! When positioned on a START_ELEMENT, skips all of its contents. The next call to next() returns the event following its END_ELEMENT.
+	void				skipElement();
+
+	//! Returns the tag of the current START_ELEMENT or END_ELEMENT, or an empty string outside of any element.
+	const std::string&	getTag() const;
+	//! Returns the text of the current TEXT, CDATA or COMMENT.
+	const std::string&	getText() const			{ return mText; }
+	//! Returns the number of open elements. START_ELEMENT and END_ELEMENT events count their own element.
+	size_t				getDepth() const		{ return mDepth; }
+
+	//! Returns the number of attributes of the current START_ELEMENT.
+	size_t				getNumAttributes() const					{ return mNumAttributes; }
+	const std::string&	getAttributeName( size_t index ) const		{ return mAttributes[index].first; }
+	const std::string&	getAttributeValue( size_t index ) const		{ return mAttributes[index].second; }
+	bool				hasAttribute( const std::string &attrName ) const;
+	//! Returns the value of the attribute \a attrName of the current START_ELEMENT. Throws XmlDocument::ExcAttrNotFound if there is no such attribute.
+	const std::string&	getAttributeValue( const std::string &attrName ) const;
+	//! Returns the value of the attribute \a attrName parsed as a T, or \a defaultValue if there is no such attribute or it fails to parse.
+	template<typename T>
+	T					getAttributeValue( const std::string &attrName, const T &defaultValue ) const;
+
+	//! Returns the number of bytes consumed from the input so far.
+	size_t				getOffset() const		{ return mConsumed + mPos; }
+
+  private:
+	int		peek()		{ return ( mPos < mEnd || fill() ) ? (unsigned char)mBuffer[mPos] : -1; }
+	int		get()		{ return ( mPos < mEnd || fill() ) ? (unsigned char)mBuffer[mPos++] : -1; }
+	bool	fill();
+	void	expect( char c );
+	bool	skipString( const char *str );
+	void	skipWhitespace();
+	void	readName( std::string *result );
+	void	readUntil( const char *terminator, std::string *result );
+	void	readText();
+	void	readStartTag();
+	void	readEndTag();
+	void	skipDocType();
+	void	throwParseError( const std::string &message ) const;
+
+	IStreamRef			mStream;
+	Options				mOptions;
+	std::vector<char>	mBuffer;
+	size_t				mPos, mEnd, mConsumed;
+
+	Event				mEvent;
+	bool				mPendingEnd;
+	size_t				mDepth;
+	std::vector<std::string>	mOpenTags;
+	std::string			mText;
+	std::vector<std::pair<std::string, std::string>>	mAttributes;
+	size_t				mNumAttributes;
+};
+
+template<typename T>
+T XmlPullParser::getAttributeValue( const std::string &attrName, const T &defaultValue ) const
+{
+	if( ! hasAttribute( attrName ) )
+		return defaultValue;
+
+	try {
+		return fromString<T>( getAttributeValue( attrName ) );
+	}
+	catch( ... ) {
+		return defaultValue;
+	}
+}
+
+} // namespace cinder
@@ -84,7 +84,7 @@ private:
 	bool						mSetupHasBeenCalled = false;
 	bool						mQuitOnLastWindowClosed;
 
-	double						mNextFrameTime;
+	FramePacer					mFramePacer;
 
 	void						sleepUntilNextFrame();
 	void						run();
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "cinder/app/AppBase.h"
+#include "cinder/app/linux/FramePacer.h"
 
 namespace cinder { namespace app {
 
@@ -43,6 +44,8 @@ class AppLinux : public AppBase {
 	void		setFrameRate( float frameRate ) override;
 	void		disableFrameRate() override;
 	bool		isFrameRateEnabled() const override;
+	//! Returns the FramePacer which waits for each frame's deadline, for choosing how it waits and reading frame time statistics
+	FramePacer&	getFramePacer();
 
 	WindowRef	getWindow() const override;
 	WindowRef	getWindowIndex( size_t index ) const override;
@@ -0,0 +1,130 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cinder { namespace app {
+
+//! Histogram of frame times with fixed-width bins, plus running statistics
+class CI_API FrameTimeHistogram {
+  public:
+	//! Creates a histogram of \a numBins bins of \a binSeconds each. Longer frame times are counted in the last bin.
+	FrameTimeHistogram( double binSeconds = 0.0001, size_t numBins = 1000 );
+
+	void	addSample( double seconds );
+	void	clear();
+
+	size_t	getNumSamples() const		{ return mNumSamples; }
+	//! Returns the mean frame time in seconds, or 0 without samples
+	double	getMean() const				{ return mNumSamples ? mSum / mNumSamples : 0; }
+	//! Returns the standard deviation of the frame times in seconds, which measures jitter
+	double	getStdDev() const;
+	double	getMin() const				{ return mNumSamples ? mMin : 0; }
+	double	getMax() const				{ return mNumSamples ? mMax : 0; }
+	//! Returns the frame time in seconds below which \a percentile (0 - 100) of the samples fall, with the resolution of a bin
+	double	getPercentile( double percentile ) const;
+
+	double						getBinSeconds() const	{ return mBinSeconds; }
+	const std::vector<size_t>&	getBinCounts() const	{ return mBinCounts; }
+
+  private:
+	double				mBinSeconds;
+	std::vector<size_t>	mBinCounts;
+	size_t				mNumSamples;
+	double				mSum, mSumSquares, mMin, mMax;
+};
+
+//! Paces frames to deadlines on the monotonic clock. Sleeps with clock_nanosleep( TIMER_ABSTIME ), so the sleep isn't extended by time
+//! spent computing it, and optionally spins for the last part of the wait to avoid the scheduler's wake-up latency. Used by AppLinux.
+class CI_API FramePacer {
+  public:
+	enum class Mode {
+		SLEEP,			//!< Sleep until the deadline
+		SLEEP_SPIN,		//!< Sleep until Options::spinSeconds before the deadline, then spin
+		ADAPTIVE		//!< Like SLEEP_SPIN, with the spin time adjusted to the oversleep measured on recent frames
+	};
+
+	struct Options {
+		Options()
+			: mMode( Mode::ADAPTIVE ), mSpinSeconds( 0.0005 ), mMaxSpinSeconds( 0.002 )
+		{}
+
+		//! Sets how the pacer waits for deadlines. \default Mode::ADAPTIVE.
+		Options&	mode( Mode mode )					{ mMode = mode; return *this; }
+		//! Sets the time spent spinning before each deadline, which is the initial value in Mode::ADAPTIVE. \default 0.5ms.
+		Options&	spinSeconds( double seconds )		{ mSpinSeconds = seconds; return *this; }
+		//! Sets the limit on the time spent spinning in Mode::ADAPTIVE. \default 2ms.
+		Options&	maxSpinSeconds( double seconds )	{ mMaxSpinSeconds = seconds; return *this; }
+
+		Mode	getMode() const				{ return mMode; }
+		double	getSpinSeconds() const		{ return mSpinSeconds; }
+		double	getMaxSpinSeconds() const	{ return mMaxSpinSeconds; }
+
+	  private:
+		Mode	mMode;
+		double	mSpinSeconds, mMaxSpinSeconds;
+	};
+
+	explicit FramePacer( double frameRate = 60, const Options &options = Options() );
+
+	//! Sets the frame rate and starts pacing from the current time
+	void	setFrameRate( double frameRate );
+	double	getFrameRate() const			{ return mFrameRate; }
+	void	setOptions( const Options &options );
+	const Options&	getOptions() const		{ return mOptions; }
+
+	//! Waits until the next frame's deadline. Returns \c false without waiting if the deadline has already passed. After falling behind by
+	//! more than a second, missed frames are skipped rather than run back to back.
+	bool	waitForNextFrame();
+	//! Records the end of a frame without waiting, for when the frame rate is disabled
+	void	markFrame();
+
+	//! Returns the histogram of times between consecutive frames
+	const FrameTimeHistogram&	getFrameTimes() const			{ return mFrameTimes; }
+	//! Returns the histogram of how late the pacer woke from sleeping, before spinning
+	const FrameTimeHistogram&	getOversleepTimes() const		{ return mOversleepTimes; }
+	//! Returns the number of deadlines which had already passed when waitForNextFrame() was called
+	size_t						getNumMissedDeadlines() const	{ return mNumMissedDeadlines; }
+	//! Returns the time currently spent spinning before each deadline
+	double						getSpinSeconds() const			{ return mSpinNs / 1e9; }
+	//! Clears the frame time and oversleep histograms and the count of missed deadlines
+	void						clearStats();
+
+	//! Returns the time of the monotonic clock the pacer uses, in nanoseconds
+	static int64_t	now();
+
+  private:
+	Options				mOptions;
+	double				mFrameRate;
+	int64_t				mNextDeadlineNs, mLastFrameNs;
+	int64_t				mSpinNs;
+	size_t				mNumMissedDeadlines;
+	FrameTimeHistogram	mFrameTimes, mOversleepTimes;
+};
+
+} } // namespace cinder::app
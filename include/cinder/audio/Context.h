@@ -169,6 +169,7 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	std::list<ScheduledEvent>	mScheduledEvents;
 	ci::Timer					mProcessTimer;
 	std::atomic<double>			mTimeDuringLastProcessLoop;
+	uint64_t					mProcessBeginNs; // profile::now() at the start of the current process loop, when profiling
 
 	// other nodes that don't have any outputs and need to be explicitly pulled
 	std::set<NodeRef>		mAutoPulledNodes;
@@ -0,0 +1,58 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Surface.h"
+
+namespace cinder { namespace ip {
+
+//! Color spaces converted between by convertColorSpace(). Each is stored in the red, green and blue channels of a Surface, scaled to fit <tt>[0, 1]</tt> (or the full range of an integer type).
+enum class ColorSpace {
+	SRGB,		//!< Gamma-encoded sRGB, as loaded from most images
+	LINEAR_RGB,	//!< sRGB primaries with a linear transfer function, for blending and lighting
+	HSV,		//!< Hue, saturation and value of the encoded sRGB values, matching rgbToHsv()
+	YCBCR,		//!< Full range BT.601 YCbCr of the encoded sRGB values, as used by JPEG. Cb and Cr are offset by 0.5
+	LAB			//!< CIE L*a*b* relative to the D65 white point. L is divided by 100, while a and b are offset by 128 and divided by 255
+};
+
+//! Converts the pixels of \a srcSurface from color space \a from to \a to and stores the result in \a dstSurface. Alpha is copied, or set to opaque when \a srcSurface has none.
+//! When \a parallel is \c true, large Surfaces are converted in bands of rows by ci::parallelFor().
+template<typename T>
+CI_API void convertColorSpace( const SurfaceT<T> &srcSurface, ColorSpace from, ColorSpace to, SurfaceT<T> *dstSurface, bool parallel = true );
+//! Converts the pixels of \a surface from color space \a from to \a to in place.
+//! When \a parallel is \c true, large Surfaces are converted in bands of rows by ci::parallelFor().
+template<typename T>
+CI_API void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, bool parallel = true );
+//! Converts the pixels of \a surface inside \a area from color space \a from to \a to in place.
+//! When \a parallel is \c true, large areas are converted in bands of rows by ci::parallelFor().
+template<typename T>
+CI_API void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, const Area &area, bool parallel = true );
+
+//! Returns the linear value of the sRGB-encoded value \a v, using a lookup table for values in <tt>[0, 1]</tt>
+CI_API float srgbToLinear( float v );
+//! Returns the sRGB-encoded value of the linear value \a v, using a lookup table for values in <tt>[0, 1]</tt>
+CI_API float linearToSrgb( float v );
+
+} } // namespace cinder::ip
@@ -0,0 +1,93 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Area.h"
+#include "cinder/Channel.h"
+
+#include <vector>
+
+namespace cinder { namespace ip {
+
+//! Determines which neighbors of a pixel findConnectedComponents() connects it to
+enum class Connectivity {
+	FOUR,	//!< The pixels above, below, left and right
+	EIGHT	//!< The pixels above, below, left and right and the 4 diagonals
+};
+
+//! A connected region of foreground pixels found by findConnectedComponents()
+class ConnectedComponent {
+  public:
+	ConnectedComponent()
+		: mLabel( 0 ), mArea( 0 )
+	{}
+	ConnectedComponent( uint32_t label, uint32_t area, const Area &bounds, const vec2 &centroid )
+		: mLabel( label ), mArea( area ), mBounds( bounds ), mCentroid( centroid )
+	{}
+
+	//! Returns the label of the component's pixels, starting at 1
+	uint32_t		getLabel() const		{ return mLabel; }
+	//! Returns the number of pixels in the component
+	uint32_t		getArea() const			{ return mArea; }
+	//! Returns the smallest Area containing every pixel of the component
+	const Area&		getBounds() const		{ return mBounds; }
+	//! Returns the mean position of the component's pixels
+	const vec2&		getCentroid() const		{ return mCentroid; }
+
+  private:
+	uint32_t	mLabel;
+	uint32_t	mArea;
+	Area		mBounds;
+	vec2		mCentroid;
+};
+
+//! Options for findConnectedComponents()
+struct ConnectedComponentsOptions {
+	ConnectedComponentsOptions()
+		: mConnectivity( Connectivity::EIGHT ), mThreshold( 0 ), mParallel( true )
+	{}
+
+	//! Sets which neighbors of a pixel are connected to it. \default Connectivity::EIGHT
+	ConnectedComponentsOptions&	connectivity( Connectivity connectivity )	{ mConnectivity = connectivity; return *this; }
+	//! Sets the value which pixels must be greater than to be part of a component. \default 0
+	ConnectedComponentsOptions&	threshold( uint8_t threshold )				{ mThreshold = threshold; return *this; }
+	//! Sets whether bands of rows are labeled in parallel by ci::parallelFor() and then merged. \default true
+	ConnectedComponentsOptions&	parallel( bool parallel = true )			{ mParallel = parallel; return *this; }
+
+	Connectivity	getConnectivity() const		{ return mConnectivity; }
+	uint8_t			getThreshold() const		{ return mThreshold; }
+	bool			isParallel() const			{ return mParallel; }
+
+  private:
+	Connectivity	mConnectivity;
+	uint8_t			mThreshold;
+	bool			mParallel;
+};
+
+//! Returns the connected components of the pixels of \a channel greater than ConnectedComponentsOptions::threshold(), ordered by their first pixel from the top left.
+//! Each component's label is its index in the result plus 1. If \a labels is non-null it is resized to the pixels of \a channel row by row and filled with the label of each pixel's component, or 0 for the background.
+CI_API std::vector<ConnectedComponent> findConnectedComponents( const Channel8u &channel, std::vector<uint32_t> *labels = nullptr, const ConnectedComponentsOptions &options = ConnectedComponentsOptions() );
+
+} } // namespace cinder::ip
@@ -0,0 +1,140 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Exception.h"
+#include "cinder/Surface.h"
+
+#include <vector>
+
+namespace cinder { namespace ip {
+
+//! Determines the values of pixels outside of the source read by convolve()
+enum class BorderMode {
+	CLAMP,		//!< Repeats the edge pixel: aaa|abcd|ddd
+	MIRROR,		//!< Reflects about the edge pixel: dcb|abcd|cba
+	WRAP,		//!< Wraps around to the opposite edge: bcd|abcd|abc
+	CONSTANT	//!< Uses ConvolveOptions::borderValue()
+};
+
+//! The weights convolved with an image by convolve(), either a 2D grid or a separable pair of horizontal and vertical 1D kernels. The weights are centered on <tt>(width / 2, height / 2)</tt>.
+class CI_API Kernel {
+  public:
+	Kernel() : mWidth( 0 ), mHeight( 0 ), mSeparable( false ) {}
+	//! Constructs a 2D kernel of \a width x \a height \a weights, stored row by row
+	Kernel( int32_t width, int32_t height, const std::vector<float> &weights );
+
+	//! Returns a kernel which convolves rows with \a horizontal and then columns with \a vertical, which is equivalent to their outer product but costs <tt>width + height</tt> rather than <tt>width * height</tt> operations per pixel
+	static Kernel	separable( const std::vector<float> &horizontal, const std::vector<float> &vertical );
+	//! Returns a separable Gaussian kernel of standard deviation \a sigma, extending \a radius pixels each side of the center. A negative \a radius uses <tt>ceil( 3 * sigma )</tt>
+	static Kernel	gaussian( float sigma, int32_t radius = -1 );
+	//! Returns a separable kernel averaging the <tt>( 2 * radius + 1 )^2</tt> pixels around the center
+	static Kernel	box( int32_t radius );
+	//! Returns the horizontal 3x3 Sobel kernel, whose result is positive where values increase to the right
+	static Kernel	sobelX();
+	//! Returns the vertical 3x3 Sobel kernel, whose result is positive where values increase downwards
+	static Kernel	sobelY();
+	//! Returns the horizontal 3x3 Scharr kernel, which is more rotationally symmetric than sobelX()
+	static Kernel	scharrX();
+	//! Returns the vertical 3x3 Scharr kernel, which is more rotationally symmetric than sobelY()
+	static Kernel	scharrY();
+	//! Returns the 3x3 Laplacian kernel, which sums the second derivatives across the 4 neighbors of the center
+	static Kernel	laplacian();
+	//! Returns a 3x3 kernel which sharpens by subtracting \a amount times the laplacian() from the center
+	static Kernel	sharpen( float amount = 1 );
+
+	int32_t		getWidth() const		{ return mWidth; }
+	int32_t		getHeight() const		{ return mHeight; }
+	//! Returns the position of the center of the kernel
+	ivec2		getAnchor() const		{ return ivec2( mWidth / 2, mHeight / 2 ); }
+	bool		isSeparable() const		{ return mSeparable; }
+	//! Returns the horizontal weights of a separable kernel
+	const std::vector<float>&	getHorizontal() const	{ return mHorizontal; }
+	//! Returns the vertical weights of a separable kernel
+	const std::vector<float>&	getVertical() const		{ return mVertical; }
+	//! Returns all of the weights row by row, which for a separable kernel are the products of the horizontal and vertical weights
+	const std::vector<float>&	getWeights() const		{ return mWeights; }
+
+  private:
+	int32_t				mWidth, mHeight;
+	bool				mSeparable;
+	std::vector<float>	mHorizontal, mVertical, mWeights;
+};
+
+//! Options for convolve()
+struct ConvolveOptions {
+	ConvolveOptions()
+		: mBorderMode( BorderMode::CLAMP ), mBorderValue( 0 ), mScale( 1 ), mOffset( 0 ), mParallel( true )
+	{}
+
+	//! Sets how pixels outside of the source are read. \default BorderMode::CLAMP
+	ConvolveOptions&	borderMode( BorderMode mode )	{ mBorderMode = mode; return *this; }
+	//! Sets the value of pixels outside of the source with BorderMode::CONSTANT, in the units of the channel type (0 - 255 for uint8_t). \default 0
+	ConvolveOptions&	borderValue( float value )		{ mBorderValue = value; return *this; }
+	//! Sets a factor the result is multiplied by, for example to normalize integer weights. \default 1
+	ConvolveOptions&	scale( float scale )			{ mScale = scale; return *this; }
+	//! Sets a value added to the result after scaling, in the units of the channel type, for example to center signed results of an unsigned type. \default 0
+	ConvolveOptions&	offset( float offset )			{ mOffset = offset; return *this; }
+	//! Sets whether large images are split into tiles which are convolved in parallel by ci::parallelFor(). \default true
+	ConvolveOptions&	parallel( bool parallel = true )	{ mParallel = parallel; return *this; }
+
+	BorderMode	getBorderMode() const	{ return mBorderMode; }
+	float		getBorderValue() const	{ return mBorderValue; }
+	float		getScale() const		{ return mScale; }
+	float		getOffset() const		{ return mOffset; }
+	bool		isParallel() const		{ return mParallel; }
+
+  private:
+	BorderMode	mBorderMode;
+	float		mBorderValue, mScale, mOffset;
+	bool		mParallel;
+};
+
+//! Convolves \a srcArea of \a srcChannel with \a kernel and stores the result in \a dstChannel at \a dstLT. Pixels of \a srcChannel around \a srcArea are read as neighbors, and \a options determines those outside of \a srcChannel.
+//! Results are clamped to the range of integer types. uint8_t uses 16-bit fixed point arithmetic unless the weights are too large to fit, and other types use float.
+template<typename T>
+CI_API void convolve( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options = ConvolveOptions() );
+//! Convolves \a srcChannel with \a kernel and stores the result in \a dstChannel, which may be \a srcChannel
+template<typename T>
+CI_API void convolve( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options = ConvolveOptions() );
+//! Convolves the color channels of \a srcArea of \a srcSurface with \a kernel and stores the result in \a dstSurface at \a dstLT. Alpha is convolved when both Surfaces have it.
+template<typename T>
+CI_API void convolve( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options = ConvolveOptions() );
+//! Convolves the color channels of \a srcSurface with \a kernel and stores the result in \a dstSurface, which may be \a srcSurface. Alpha is convolved when both Surfaces have it.
+template<typename T>
+CI_API void convolve( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options = ConvolveOptions() );
+//! Convolves \a srcArea of \a srcChannel with \a kernel and stores the unclamped result in \a dstChannel at \a dstLT, in the units of \a T. Used for kernels with negative results such as Kernel::sobelX().
+template<typename T>
+CI_API void convolveSigned( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, Channel32f *dstChannel, const Kernel &kernel, const ConvolveOptions &options = ConvolveOptions() );
+
+//! Exception type thrown by Kernel and convolve()
+class CI_API ConvolveExc : public Exception {
+  public:
+	ConvolveExc( const std::string &description )
+		: Exception( description )
+	{}
+};
+
+} } // namespace cinder::ip
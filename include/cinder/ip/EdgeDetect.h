@@ -26,6 +26,7 @@
 
 namespace cinder { namespace ip {
 
+//! Stores the gradient magnitude of \a srcArea of \a srcChannel, calculated with the 3x3 Sobel kernels, in \a dstChannel at \a dstLT. Results are clamped to the range of \a T, and edge pixels are repeated beyond the borders.
 template<typename T>
 CI_API void edgeDetectSobel( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstOffset, ChannelT<T> *dstChannel );
 template<typename T>
@@ -35,4 +36,31 @@ CI_API void edgeDetectSobel( const ChannelT<T> &srcChannel, ChannelT<T> *dstChan
 template<typename T>
 CI_API void edgeDetectSobel( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface );
 
+//! Stores the gradient magnitude of \a srcArea of \a srcChannel, calculated with the 3x3 Scharr kernels, in \a dstChannel at \a dstLT. Results are clamped to the range of \a T, and edge pixels are repeated beyond the borders.
+template<typename T>
+CI_API void edgeDetectScharr( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstOffset, ChannelT<T> *dstChannel );
+template<typename T>
+CI_API void edgeDetectScharr( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstOffset, SurfaceT<T> *dstSuface );
+template<typename T>
+CI_API void edgeDetectScharr( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );
+template<typename T>
+CI_API void edgeDetectScharr( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface );
+
+//! Stores the absolute value of the 3x3 Laplacian of \a srcArea of \a srcChannel in \a dstChannel at \a dstLT. Results are clamped to the range of \a T, and edge pixels are repeated beyond the borders.
+template<typename T>
+CI_API void edgeDetectLaplacian( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstOffset, ChannelT<T> *dstChannel );
+template<typename T>
+CI_API void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstOffset, SurfaceT<T> *dstSuface );
+template<typename T>
+CI_API void edgeDetectLaplacian( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );
+template<typename T>
+CI_API void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface );
+
+//! Sharpens \a srcChannel by subtracting \a amount times its Laplacian and stores the result in \a dstChannel, which may be \a srcChannel
+template<typename T>
+CI_API void sharpen( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, float amount = 1 );
+//! Sharpens the color channels of \a srcSurface by subtracting \a amount times their Laplacian and stores the result in \a dstSurface, which may be \a srcSurface
+template<typename T>
+CI_API void sharpen( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, float amount = 1 );
+
 } } // namespace cinder::ip
@@ -0,0 +1,50 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Channel.h"
+
+namespace cinder { namespace ip {
+
+//! Sets each pixel of \a dstChannel to the minimum of \a srcChannel in the \a elementSize rectangle centered on <tt>( elementSize.x / 2, elementSize.y / 2 )</tt>, shrinking bright regions.
+//! Pixels outside of \a srcChannel are ignored. Costs a constant number of operations per pixel regardless of \a elementSize. Rows and columns are split across threads by ci::parallelFor() when \a parallel is \c true.
+CI_API void erode( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel = true );
+//! Erodes \a channel in place. \sa erode( const Channel8u&, Channel8u*, const ivec2&, bool )
+CI_API void erode( Channel8u *channel, const ivec2 &elementSize, bool parallel = true );
+//! Sets each pixel of \a dstChannel to the maximum of \a srcChannel in the \a elementSize rectangle centered on <tt>( elementSize.x / 2, elementSize.y / 2 )</tt>, growing bright regions.
+//! Pixels outside of \a srcChannel are ignored. Costs a constant number of operations per pixel regardless of \a elementSize. Rows and columns are split across threads by ci::parallelFor() when \a parallel is \c true.
+CI_API void dilate( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel = true );
+//! Dilates \a channel in place. \sa dilate( const Channel8u&, Channel8u*, const ivec2&, bool )
+CI_API void dilate( Channel8u *channel, const ivec2 &elementSize, bool parallel = true );
+//! Erodes and then dilates \a srcChannel into \a dstChannel, removing bright regions smaller than \a elementSize. The dilation reflects the element, so even sizes never brighten a pixel.
+CI_API void open( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel = true );
+//! Opens \a channel in place, removing bright regions smaller than \a elementSize
+CI_API void open( Channel8u *channel, const ivec2 &elementSize, bool parallel = true );
+//! Dilates and then erodes \a srcChannel into \a dstChannel, filling dark gaps smaller than \a elementSize. The erosion reflects the element, so even sizes never darken a pixel.
+CI_API void close( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel = true );
+//! Closes \a channel in place, filling dark gaps smaller than \a elementSize
+CI_API void close( Channel8u *channel, const ivec2 &elementSize, bool parallel = true );
+
+} } // namespace cinder::ip
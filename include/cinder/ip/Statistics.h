@@ -0,0 +1,153 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Area.h"
+#include "cinder/Surface.h"
+
+#include <cmath>
+#include <vector>
+
+namespace cinder { namespace ip {
+
+//! The minimum, maximum, mean and variance of the values of a channel, in the units of its type (0 - 255 for uint8_t)
+class Statistics {
+  public:
+	Statistics()
+		: mMin( 0 ), mMax( 0 ), mMean( 0 ), mVariance( 0 ), mCount( 0 )
+	{}
+	Statistics( float min, float max, double mean, double variance, uint64_t count )
+		: mMin( min ), mMax( max ), mMean( mean ), mVariance( variance ), mCount( count )
+	{}
+
+	float		getMin() const			{ return mMin; }
+	float		getMax() const			{ return mMax; }
+	double		getMean() const			{ return mMean; }
+	//! Returns the population variance
+	double		getVariance() const		{ return mVariance; }
+	double		getStdDev() const		{ return std::sqrt( mVariance ); }
+	//! Returns the number of values, which is 0 for an empty Area
+	uint64_t	getCount() const		{ return mCount; }
+
+  private:
+	float		mMin, mMax;
+	double		mMean, mVariance;
+	uint64_t	mCount;
+};
+
+//! Counts of the values of a channel in bins evenly dividing the range <tt>[getMinValue(), getMaxValue())</tt>
+class CI_API Histogram {
+  public:
+	Histogram()
+		: mMinValue( 0 ), mMaxValue( 1 ), mTotal( 0 )
+	{}
+	//! Creates a Histogram of \a numBins empty bins dividing <tt>[minValue, maxValue)</tt>
+	Histogram( size_t numBins, float minValue, float maxValue );
+
+	size_t		getNumBins() const				{ return mBins.size(); }
+	float		getMinValue() const				{ return mMinValue; }
+	float		getMaxValue() const				{ return mMaxValue; }
+	const std::vector<uint32_t>&	getBins() const		{ return mBins; }
+	uint32_t	getBin( size_t bin ) const		{ return mBins.at( bin ); }
+	//! Returns the sum of all bins
+	uint64_t	getTotal() const				{ return mTotal; }
+
+	//! Returns the bin counting \a value. Values outside of the range are counted by the first or last bin.
+	size_t		getBinIndex( float value ) const;
+	//! Returns the lowest value counted by \a bin. \a bin may be getNumBins(), which returns getMaxValue().
+	float		getBinValue( size_t bin ) const;
+	//! Adds \a count to \a bin
+	void		add( size_t bin, uint32_t count = 1 );
+	//! Adds the bins of \a other, which must have the same number of bins
+	void		merge( const Histogram &other );
+
+	//! Returns the mean of the values, assuming each bin's values are at its center
+	float		calcMean() const;
+	//! Returns the value below which \a fraction of the values lie, interpolating within bins. For example 0.5 returns the median.
+	float		calcPercentile( float fraction ) const;
+
+  private:
+	float					mMinValue, mMaxValue;
+	std::vector<uint32_t>	mBins;
+	uint64_t				mTotal;
+};
+
+//! Options for calcHistogram() and calcHistograms()
+struct HistogramOptions {
+	HistogramOptions()
+		: mNumBins( 256 ), mHasRange( false ), mMinValue( 0 ), mMaxValue( 0 ), mParallel( true )
+	{}
+
+	//! Sets the number of bins. \default 256
+	HistogramOptions&	numBins( size_t numBins )						{ mNumBins = numBins; return *this; }
+	//! Sets the range of values divided by the bins. \default <tt>[0, 256)</tt> for uint8_t, <tt>[0, 65536)</tt> for uint16_t and <tt>[0, 1)</tt> for float, so that every 8-bit value has its own bin
+	HistogramOptions&	range( float minValue, float maxValue )			{ mHasRange = true; mMinValue = minValue; mMaxValue = maxValue; return *this; }
+	//! Sets whether large Areas are split into bands of rows counted into private histograms in parallel by ci::parallelReduce(). \default true
+	HistogramOptions&	parallel( bool parallel = true )				{ mParallel = parallel; return *this; }
+
+	size_t	getNumBins() const		{ return mNumBins; }
+	//! Returns whether range() has been set, rather than using the range of the channel type
+	bool	hasRange() const		{ return mHasRange; }
+	float	getMinValue() const		{ return mMinValue; }
+	float	getMaxValue() const		{ return mMaxValue; }
+	bool	isParallel() const		{ return mParallel; }
+
+  private:
+	size_t	mNumBins;
+	bool	mHasRange;
+	float	mMinValue, mMaxValue;
+	bool	mParallel;
+};
+
+//! Returns the histogram of the values of \a channel inside \a area
+template<typename T>
+CI_API Histogram calcHistogram( const ChannelT<T> &channel, const Area &area, const HistogramOptions &options = HistogramOptions() );
+//! Returns the histogram of the values of \a channel
+template<typename T>
+CI_API Histogram calcHistogram( const ChannelT<T> &channel, const HistogramOptions &options = HistogramOptions() );
+//! Returns the histograms of the red, green, blue and, if \a surface has it, alpha channels inside \a area, counted in a single pass
+template<typename T>
+CI_API std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const Area &area, const HistogramOptions &options = HistogramOptions() );
+//! Returns the histograms of the red, green, blue and, if \a surface has it, alpha channels, counted in a single pass
+template<typename T>
+CI_API std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const HistogramOptions &options = HistogramOptions() );
+
+//! Returns the Statistics of the values of \a channel inside \a area, calculated in parallel bands of rows when \a parallel is \c true
+template<typename T>
+CI_API Statistics calcStatistics( const ChannelT<T> &channel, const Area &area, bool parallel = true );
+//! Returns the Statistics of the values of \a channel, calculated in parallel bands of rows when \a parallel is \c true
+template<typename T>
+CI_API Statistics calcStatistics( const ChannelT<T> &channel, bool parallel = true );
+//! Returns the Statistics of the red, green, blue and, if \a surface has it, alpha channels inside \a area, calculated in a single pass
+template<typename T>
+CI_API std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, const Area &area, bool parallel = true );
+//! Returns the Statistics of the red, green, blue and, if \a surface has it, alpha channels, calculated in a single pass
+template<typename T>
+CI_API std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, bool parallel = true );
+
+//! Returns the value which best separates the values counted by \a histogram into a lower and an upper class using Otsu's method, as the upper edge of the lower class' last bin
+CI_API float calcOtsuThreshold( const Histogram &histogram );
+
+} } // namespace cinder::ip
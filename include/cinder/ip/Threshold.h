@@ -41,6 +41,9 @@ CI_API void threshold( const SurfaceT<T> &srcSurface, T value, SurfaceT<T> *dstS
 //! Thresholds \a srcChannel setting any values below \a value to zero and any values above to unity and storing the result in \a dstChannel
 template<typename T>
 CI_API void threshold( const ChannelT<T> &srcSurface, T value, ChannelT<T> *dstSurface );
+//! Thresholds \a srcChannel at the value calculated by calcOtsuThreshold() from its histogram, storing the result in \a dstChannel. Returns the threshold value.
+template<typename T>
+CI_API T thresholdOtsu( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );
 //! Thresholds \a srcChannel using an adaptive thresholding algorithm which considers a window of size \a windowSize pixels and stores the result in \a dstChannel.
 /** Implements the algorithm described in "Adaptive Thresholding Using the Integral Image" by Bradley & Roth. The srcSurface.getWidth() / 8 is a good default for \a windowSize and 0.15 is for \a percentageDelta **/
 template<typename T>
@@ -0,0 +1,142 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Exception.h"
+#include "cinder/Filter.h"
+#include "cinder/Matrix.h"
+#include "cinder/Surface.h"
+#include "cinder/ip/Convolve.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cinder { namespace ip {
+
+//! Determines how warpAffine(), warpPerspective() and remap() sample between source pixels
+enum class Interpolation {
+	NEAREST,	//!< The nearest pixel
+	BILINEAR,	//!< Linear interpolation of the 2x2 nearest pixels
+	BICUBIC		//!< WarpOptions::cubicFilter() weights of the 4x4 nearest pixels
+};
+
+//! Options for warpAffine(), warpPerspective() and remap()
+struct WarpOptions {
+	WarpOptions()
+		: mInterpolation( Interpolation::BILINEAR ), mBorderMode( BorderMode::CONSTANT ), mBorderValue( 0 ), mCubicFilter( std::make_shared<FilterCatmullRom>() ), mParallel( true )
+	{}
+
+	//! Sets how values between source pixels are sampled. \default Interpolation::BILINEAR
+	WarpOptions&	interpolation( Interpolation interpolation )	{ mInterpolation = interpolation; return *this; }
+	//! Sets how pixels outside of the source are read. \default BorderMode::CONSTANT
+	WarpOptions&	borderMode( BorderMode mode )					{ mBorderMode = mode; return *this; }
+	//! Sets the value of every channel outside of the source with BorderMode::CONSTANT, in the units of the channel type (0 - 255 for uint8_t). \default 0
+	WarpOptions&	borderValue( float value )						{ mBorderValue = value; return *this; }
+	//! Sets the filter which weights the 4 nearest pixels in each direction with Interpolation::BICUBIC. Its weights are normalized to sum to 1. \default FilterCatmullRom
+	WarpOptions&	cubicFilter( const std::shared_ptr<const FilterBase> &filter )	{ mCubicFilter = filter; return *this; }
+	//! Sets whether large destinations are split into bands of rows which are sampled in parallel by ci::parallelFor(). \default true
+	WarpOptions&	parallel( bool parallel = true )				{ mParallel = parallel; return *this; }
+
+	Interpolation	getInterpolation() const	{ return mInterpolation; }
+	BorderMode		getBorderMode() const		{ return mBorderMode; }
+	float			getBorderValue() const		{ return mBorderValue; }
+	const std::shared_ptr<const FilterBase>&	getCubicFilter() const	{ return mCubicFilter; }
+	bool			isParallel() const			{ return mParallel; }
+
+  private:
+	Interpolation	mInterpolation;
+	BorderMode		mBorderMode;
+	float			mBorderValue;
+	std::shared_ptr<const FilterBase>	mCubicFilter;
+	bool			mParallel;
+};
+
+//! The source position sampled for each pixel of a destination by remap(), stored in 24.8 fixed point.
+//! Calculating a WarpMap once and remapping with it each frame avoids recalculating positions, for example for lens undistortion.
+class CI_API WarpMap {
+  public:
+	WarpMap() : mSize( 0 ) {}
+	//! Creates a map of \a size positions, all sampling the origin
+	explicit WarpMap( const ivec2 &size );
+
+	//! Returns a map of \a dstSize positions which undoes the affine \a transform from source to destination positions. The bottom row of \a transform is ignored.
+	static WarpMap	affine( const mat3 &transform, const ivec2 &dstSize );
+	//! Returns a map of \a dstSize positions which undoes the perspective \a transform from source to destination positions
+	static WarpMap	perspective( const mat3 &transform, const ivec2 &dstSize );
+	//! Returns a map sampling the source at <tt>( mapX, mapY )</tt> for each pixel
+	static WarpMap	positions( const Channel32f &mapX, const Channel32f &mapY );
+	//! Returns a map of \a dstSize positions sampling the source at \a fn( dstPosition ). \a fn is called in parallel.
+	static WarpMap	function( const ivec2 &dstSize, const std::function<vec2 ( const ivec2 &dstPosition )> &fn );
+
+	ivec2		getSize() const				{ return mSize; }
+	//! Returns the source position sampled for \a dstPosition
+	vec2		getPosition( const ivec2 &dstPosition ) const;
+	//! Sets the source position sampled for \a dstPosition
+	void		setPosition( const ivec2 &dstPosition, const vec2 &srcPosition );
+	//! Returns the positions row by row in 24.8 fixed point, so that <tt>position >> 8</tt> is the pixel and <tt>position & 255</tt> the fraction between it and the next
+	const std::vector<ivec2>&	getFixedPositions() const	{ return mPositions; }
+
+  private:
+	ivec2				mSize;
+	std::vector<ivec2>	mPositions;
+};
+
+//! Samples \a srcSurface at the source position of each pixel of \a dstSurface in \a map. Alpha is sampled when both Surfaces have it.
+template<typename T>
+CI_API void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const WarpMap &map, const WarpOptions &options = WarpOptions() );
+//! Samples \a srcChannel at the source position of each pixel of \a dstChannel in \a map
+template<typename T>
+CI_API void remap( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const WarpMap &map, const WarpOptions &options = WarpOptions() );
+//! Samples \a srcSurface at <tt>( mapX, mapY )</tt> for each pixel of \a dstSurface. Alpha is sampled when both Surfaces have it.
+template<typename T>
+CI_API void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Channel32f &mapX, const Channel32f &mapY, const WarpOptions &options = WarpOptions() );
+
+//! Fills \a dstSurface with \a srcSurface transformed by the affine \a transform, which maps source to destination positions. The bottom row of \a transform is ignored.
+template<typename T>
+CI_API void warpAffine( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options = WarpOptions() );
+//! Fills \a dstChannel with \a srcChannel transformed by the affine \a transform, which maps source to destination positions. The bottom row of \a transform is ignored.
+template<typename T>
+CI_API void warpAffine( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options = WarpOptions() );
+//! Fills \a dstSurface with \a srcSurface transformed by the perspective \a transform, which maps source to destination positions
+template<typename T>
+CI_API void warpPerspective( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options = WarpOptions() );
+//! Fills \a dstChannel with \a srcChannel transformed by the perspective \a transform, which maps source to destination positions
+template<typename T>
+CI_API void warpPerspective( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options = WarpOptions() );
+
+//! Returns the perspective transform which maps each corner of \a srcQuad to the same corner of \a dstQuad, for use with warpPerspective(). Throws WarpExc if three of the corners of either quad are collinear.
+CI_API mat3 calcPerspectiveTransform( const std::array<vec2, 4> &srcQuad, const std::array<vec2, 4> &dstQuad );
+
+//! Exception type thrown by calcPerspectiveTransform() and WarpMap
+class CI_API WarpExc : public Exception {
+  public:
+	WarpExc( const std::string &description )
+		: Exception( description )
+	{}
+};
+
+} } // namespace cinder::ip
@@ -26,6 +26,7 @@
 #include "cinder/Rect.h"
 #include "cinder/Surface.h"
 #include "cinder/Unicode.h"
+#include "cinder/linux/GlyphCache.h"
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
@@ -75,20 +76,17 @@ inline Measure MeasureString( const std::string& utf8, FT_Face face, bool tightF
 
 	std::u32string utf32 = ci::toUtf32( utf8 );
 	for( const auto ch : utf32 ) {
-		FT_Set_Transform( face, nullptr, &pen );
-
 		FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-		FT_Error error = FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
-		if( error ) {
+		CachedGlyphRef glyph = GlyphCache::instance().getGlyph( face, glyphIndex, pen );
+		if( ! glyph ) {
 			ci::app::console() << "Failed loading glyph: " << (uint8_t)ch << std::endl;
 		 	continue;  
 		} 
 
-		FT_GlyphSlot slot = face->glyph;
-		int glyphPixWidth  = (int)((slot->metrics.width / 64.0f) + 0.5f);
-		int glyphPixHeight = (int)((slot->metrics.height / 64.0f) + 0.5f);
-		int glyphLeft   =  slot->bitmap_left;
-		int glyphTop    = -slot->bitmap_top;
+		int glyphPixWidth  = (int)((glyph->mMetrics.width / 64.0f) + 0.5f);
+		int glyphPixHeight = (int)((glyph->mMetrics.height / 64.0f) + 0.5f);
+		int glyphLeft   =  ( pen.x >> 6 ) + glyph->mBitmapLeft;
+		int glyphTop    = -( ( pen.y >> 6 ) + glyph->mBitmapTop );
 		int glyphRight  = glyphLeft + glyphPixWidth;
 		int glyphBottom = glyphTop + glyphPixHeight;
 
@@ -108,8 +106,8 @@ inline Measure MeasureString( const std::string& utf8, FT_Face face, bool tightF
 			yMax = std::max( yMax, glyphBottom );
 		}
 
-		pen.x += slot->advance.x;
-		pen.y += slot->advance.y;
+		pen.x += glyph->mAdvance.x;
+		pen.y += glyph->mAdvance.y;
 	}
 
 	int width  = (xMax - xMin) + 1;
@@ -191,18 +189,17 @@ inline ci::SurfaceRef RenderString( const std::string& utf8, FT_Face face, bool
 
 		std::u32string utf32 = ci::toUtf32( utf8 );
 		for( const auto& ch : utf32 ) {
-			FT_Set_Transform( face, nullptr, &pen );
-
 			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
+			CachedGlyphRef glyph = GlyphCache::instance().getGlyph( face, glyphIndex, pen );
+			if( ! glyph )
+				continue;
 
-			FT_GlyphSlot slot = face->glyph;
-			ivec2 offset = ivec2( slot->bitmap_left, surfaceSize.y - slot->bitmap_top );
+			ivec2 offset = ivec2( ( pen.x >> 6 ) + glyph->mBitmapLeft, surfaceSize.y - ( ( pen.y >> 6 ) + glyph->mBitmapTop ) );
 
-			DrawBitmap( offset, &(slot->bitmap), color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
+			DrawBitmap( offset, const_cast<FT_Bitmap*>( glyph->getBitmap() ), color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
 
-			pen.x += slot->advance.x;
-			pen.y += slot->advance.y;
+			pen.x += glyph->mAdvance.x;
+			pen.y += glyph->mAdvance.y;
 		}
 	}
 
@@ -0,0 +1,125 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Noncopyable.h"
+
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cinder { namespace linux { namespace ftutil {
+
+//! A glyph rendered by FreeType along with its metrics, as stored by GlyphCache
+struct CachedGlyph {
+	//! Returns the glyph's coverage as an 8-bit FT_Bitmap whose pitch is its width
+	FT_Bitmap*			getBitmap() { return &mBitmap; }
+	const FT_Bitmap*	getBitmap() const { return &mBitmap; }
+
+	FT_Glyph_Metrics	mMetrics;
+	//! Advance in 26.6 fixed point
+	FT_Vector			mAdvance;
+	//! Position of the bitmap relative to the integer part of the pen it was rendered at, with y pointing up
+	int					mBitmapLeft, mBitmapTop;
+
+	FT_Bitmap				mBitmap; // points into mCoverage
+	std::vector<uint8_t>	mCoverage;
+};
+
+typedef std::shared_ptr<const CachedGlyph>	CachedGlyphRef;
+
+//! Process-wide cache of FreeType glyph metrics, coverage bitmaps and kerning, keyed by face, size and glyph. Thread-safe.
+//! Glyphs are rendered at the subpixel offset of the pen they're drawn at, so cached glyphs draw exactly like freshly rendered ones.
+//! The least recently used glyphs are evicted once the cache exceeds its memory limit.
+class GlyphCache : private Noncopyable {
+  public:
+	//! Returns the process-wide cache. It's never destroyed, so fonts released during static destruction can still remove their faces from it.
+	static GlyphCache&	instance();
+
+	//! Returns glyph \a glyphIndex of \a face at its current size, rendered at the subpixel offset of \a pen in 26.6 fixed point. Returns \c nullptr if FreeType can't render it.
+	CachedGlyphRef	getGlyph( FT_Face face, FT_UInt glyphIndex, const FT_Vector &pen );
+	//! Returns the advance of glyph \a glyphIndex of \a face at its current size in 26.6 fixed point. Only loads the glyph's metrics, so prefer this to getGlyph() when measuring text.
+	FT_Vector		getAdvance( FT_Face face, FT_UInt glyphIndex );
+	//! Returns the kerning between \a leftGlyph and \a rightGlyph of \a face at its current size in 26.6 fixed point
+	FT_Vector		getKerning( FT_Face face, FT_UInt leftGlyph, FT_UInt rightGlyph );
+
+	//! Discards every glyph of \a face. Called when a face is destroyed, as a new face may reuse its address.
+	void			removeFace( FT_Face face );
+	//! Discards every glyph, advance and kerning pair
+	void			clear();
+
+	//! Sets the memory the cache may use before evicting glyphs. A limit of 0 disables caching. \default 16MB.
+	void			setMaxBytes( size_t maxBytes );
+	size_t			getMaxBytes() const;
+	//! Returns the memory used by the cached glyphs, advances and kerning pairs
+	size_t			getNumBytes() const;
+	size_t			getNumGlyphs() const;
+	//! Returns the number of lookups which were and weren't already cached
+	size_t			getNumHits() const;
+	size_t			getNumMisses() const;
+
+  private:
+	GlyphCache();
+
+	struct GlyphKey {
+		FT_Face		mFace;
+		FT_Fixed	mScaleX, mScaleY; // identifies the face's size
+		FT_UInt		mGlyphIndex;
+		uint8_t		mSubpixelX, mSubpixelY;
+
+		bool operator==( const GlyphKey &rhs ) const;
+	};
+	struct KerningKey {
+		FT_Face		mFace;
+		FT_Fixed	mScaleX;
+		FT_UInt		mLeftGlyph, mRightGlyph;
+
+		bool operator==( const KerningKey &rhs ) const;
+	};
+	struct KeyHash {
+		size_t operator()( const GlyphKey &key ) const;
+		size_t operator()( const KerningKey &key ) const;
+	};
+
+	typedef std::list<std::pair<GlyphKey, CachedGlyphRef>>	GlyphList;
+
+	static CachedGlyphRef	renderGlyph( FT_Face face, FT_UInt glyphIndex, const FT_Vector &subpixel );
+	static size_t			calcNumBytes( const CachedGlyph &glyph );
+	void					evict();
+
+	mutable std::mutex		mMutex;
+	size_t					mMaxBytes, mNumBytes;
+	size_t					mNumHits, mNumMisses;
+	GlyphList				mGlyphs; // most recently used first
+	std::unordered_map<GlyphKey, GlyphList::iterator, KeyHash>	mGlyphMap;
+	std::unordered_map<GlyphKey, FT_Vector, KeyHash>			mAdvances; // keyed without a subpixel offset, cleared rather than evicted once it grows too large
+	std::unordered_map<KerningKey, FT_Vector, KeyHash>			mKerning; // cleared rather than evicted once it grows too large
+};
+
+}}} // namespace cinder::linux::ftutil
@@ -16,9 +16,11 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 
 #include "cinder/gl/Texture.h"
 #include "cinder/gl/Context.h"
+#include "cinder/Surface.h"
 
 #if GST_CHECK_VERSION(1, 4, 5)
 	#include <gst/gl/gstglconfig.h>
@@ -101,6 +103,8 @@ struct GstData {
 	std::atomic<int> fpsNom;
 	std::atomic<int> fpsDenom;
 	std::atomic<float> pixelAspectRatio;
+	std::atomic<guint64> sinkFramesDropped; // As last reported by QoS messages from the appsink.
+	std::atomic<guint64> decoderFramesDropped; // As last reported by QoS messages from the decoder.
 
 	GstMapInfo memoryMapInfo; // Memory map that holds the incoming frame.
 	GstVideoInfo videoInfo; // For retrieving video info.
@@ -176,13 +180,42 @@ class GstPlayer {
 
 		ci::gl::Texture2dRef getVideoTexture();
 
+		//! Delivers frames in system memory through getVideoSurface() and pullVideoSurface() instead of as textures, without using GL. Call before load() or setCustomPipeline().
+		//! When \a realtime is false the appsink doesn't sync to the clock and queues up to \a numBuffers frames, so decoding runs as fast as pullVideoSurface() consumes them.
+		void setSurfaceOutput( bool realtime, size_t numBuffers );
+		//! Returns the most recent frame as a Surface which shares the memory of its GstBuffer, or nullptr. Sets \a timeNanos to the frame's timestamp when not null.
+		ci::Surface8uRef getVideoSurface( gint64 *timeNanos = nullptr );
+		//! Waits up to \a timeoutNanos for the next frame queued by the appsink and returns it like getVideoSurface(). Returns nullptr on timeout or at the end of the stream.
+		ci::Surface8uRef pullVideoSurface( gint64 timeoutNanos, gint64 *timeNanos = nullptr );
+		//! Waits up to \a timeoutNanos for a new frame to arrive, such as after stepForward() or seekToFrame(). Returns whether one did.
+		bool waitForNewFrame( gint64 timeoutNanos );
+		//! Returns whether the appsink has received the end of the stream and has no frames left to pull
+		bool isEos() const;
+
+		//! Returns the number of frames which have reached the appsink since loading
+		size_t getNumFramesDecoded() const;
+		//! Returns the number of frames dropped by the appsink or the decoder for being late, as reported by their QoS messages
+		size_t getNumFramesDropped() const;
+		//! Returns the recent average and the longest time in seconds that a frame has spent in the decoder
+		double getDecodeLatency() const;
+		double getMaxDecodeLatency() const;
+
+		//! Returns the size in bytes of a decoded frame, or 0 before the first frame
+		size_t getFrameBytes() const;
+		//! Returns the number of frames the appsink may queue
+		size_t getMaxQueuedFrames() const;
+		//! Limits the number of frames the appsink may queue when not in realtime. Set by MovieManager to divide its memory budget between streams.
+		void setMaxQueuedFrames( size_t maxFrames );
+
 	private:
 		bool initializeGStreamer();
 
 		void constructPipeline();
 
+#if ! defined( CINDER_LINUX )
 		void startGMainLoopThread();
 		void startGMainLoop( GMainLoop* loop );
+#endif
 
 		static void onGstEos( GstAppSink* sink, gpointer userData );
 		static GstFlowReturn onGstSample( GstAppSink* sink, gpointer userData );
@@ -212,15 +245,47 @@ class GstPlayer {
 		void createTextureFromMemory();
 		void createTextureFromID();
 
+		void configureSurfaceAppSink();
+		static GstPadProbeReturn onAppSinkQuery( GstPad* pad, GstPadProbeInfo* info, gpointer userData );
+		std::shared_ptr<GstSample> setCurrentSample( GstSample* sample );
+		void applyMaxQueuedFrames();
+
+		void addStatsProbes();
+		void resetStats();
+		static void onDeepElementAdded( GstBin* bin, GstBin* subBin, GstElement* element, gpointer userData );
+		void configureDecoder( GstElement* element );
+		static GstPadProbeReturn onDecoderInput( GstPad* pad, GstPadProbeInfo* info, gpointer userData );
+		static GstPadProbeReturn onDecoderOutput( GstPad* pad, GstPadProbeInfo* info, gpointer userData );
+		static GstPadProbeReturn onAppSinkBuffer( GstPad* pad, GstPadProbeInfo* info, gpointer userData );
+
 	private:
-		GMainLoop* mGMainLoop; // Needed for message activation since we are not using signals.
-		GstBus* mGstBus; // Delivers the messages.
+		GstBus* mGstBus; // Delivers the messages, which on Linux are handled on the main loop thread shared by MovieManager.
 		int mBusId; // Save the id of the bus for releasing when not needed.
+		bool mRegistered; // Whether MovieManager knows about this player, which is only used on Linux.
+#if ! defined( CINDER_LINUX )
+		GMainLoop* mGMainLoop; // Needed for message activation since we are not using signals.
 		std::thread mGMainLoopThread; // Seperate thread for GMainLoop.
+#endif
 
 		std::mutex mMutex; // Protect	since the appsink callbacks are executed from the streaming thread internally from GStreamer.
 
 		bool mUsingCustomPipeline;
+		bool mUseGl; // Whether frames are delivered as GL memory.
+
+		bool mSurfaceOutput; // Whether frames are delivered as Surfaces, see setSurfaceOutput().
+		bool mSurfaceRealtime;
+		size_t mNumSurfaceBuffers;
+		std::shared_ptr<GstSample> mCurrentSample; // The frame returned by getVideoSurface(), guarded by mMutex.
+		std::condition_variable mNewFrameCondition;
+		std::atomic<size_t> mFrameBytes;
+		std::atomic<size_t> mMaxQueuedFrames; // The limit from MovieManager's budget.
+		size_t mAppliedMaxQueuedFrames; // The limit last set on the appsink, only touched by the thread pulling frames.
+
+		std::atomic<size_t> mNumFramesDecoded;
+		mutable std::mutex mStatsMutex; // Guards the decode latency, which is measured on the streaming threads.
+		std::deque<std::pair<GstClockTime, gint64>> mDecodeStartTimes; // Timestamps of the frames in the decoder and when they entered it.
+		double mDecodeLatency;
+		double mMaxDecodeLatency;
 		GstData mGstData; // Data that describe the current state of the pipeline.
 
 		ci::gl::Texture2dRef mVideoTexture;
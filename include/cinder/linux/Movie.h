@@ -44,6 +44,22 @@ namespace cinder { namespace linux {
 //!
 class MovieBase {
   public:
+	//! Decoding statistics of a single movie, returned by getStats()
+	struct Stats {
+		Stats() : mNumFramesDecoded( 0 ), mNumFramesDropped( 0 ), mDecodeLatency( 0 ), mMaxDecodeLatency( 0 ), mMaxQueuedFrames( 0 ) {}
+
+		//! Number of frames which have reached the sink since the movie was loaded
+		size_t	mNumFramesDecoded;
+		//! Number of frames dropped by the decoder or the sink for being late
+		size_t	mNumFramesDropped;
+		//! Recent average of the seconds a frame spends in the decoder, or 0 for sources which aren't decoded
+		double	mDecodeLatency;
+		//! Longest seconds a frame has spent in the decoder
+		double	mMaxDecodeLatency;
+		//! Number of decoded frames the sink may queue, as limited by MovieManager's memory budget
+		size_t	mMaxQueuedFrames;
+	};
+
 	virtual		~MovieBase();
 	
 	//! Returns the width of the movie in pixels
@@ -125,6 +141,9 @@ class MovieBase {
 	void		play( bool toggle = false );
 	//! Stops playback
 	void		stop();
+
+	//! Returns the movie's decoding statistics
+	Stats		getStats() const;
 	
 	signals::Signal<void()>&	getNewFrameSignal() { return mSignalNewFrame; }
 	signals::Signal<void()>&	getReadySignal() { return mSignalReady; }
@@ -177,11 +196,67 @@ class MovieGl : public MovieBase {
 	gl::TextureRef	mTexture;
 };
 
+typedef std::shared_ptr<class MovieSurface> MovieSurfaceRef;
+//! \class MovieSurface
+//! Decodes frames into system memory without using GL. Each frame is returned as a Surface8u sharing the memory of the decoded GstBuffer,
+//! which returns to its pool once the last reference to the Surface is released. The Surfaces are mapped for reading and must not be modified.
+class MovieSurface : public MovieBase {
+  public:
+	struct Options {
+		Options() : mRealtime( true ), mNumBuffers( 4 ) {}
+
+		//! Sets whether frames are decoded in step with the clock, dropping late ones. When \c false, frames are decoded as fast as pullSurface() consumes them. \default true.
+		Options&	realtime( bool realtime = true )	{ mRealtime = realtime; return *this; }
+		//! Sets the number of decoded frames queued ahead of pullSurface() when not in realtime. \default 4.
+		Options&	numBuffers( size_t numBuffers )		{ mNumBuffers = numBuffers; return *this; }
+
+		bool	isRealtime() const		{ return mRealtime; }
+		size_t	getNumBuffers() const	{ return mNumBuffers; }
+
+	  private:
+		bool	mRealtime;
+		size_t	mNumBuffers;
+	};
+
+	virtual ~MovieSurface();
+
+	static MovieSurfaceRef create( const Url& url, const Options &options = Options() ) { return MovieSurfaceRef( new MovieSurface( url, options ) ); }
+	static MovieSurfaceRef create( const fs::path& path, const Options &options = Options() ) { return MovieSurfaceRef( new MovieSurface( path, options ) ); }
+	//! Creates a MovieSurface from the GStreamer pipeline description \a pipeline, such as <tt>"videotestsrc num-buffers=100"</tt>, which is followed by a conversion to RGBA and the appsink.
+	static MovieSurfaceRef createFromPipeline( const std::string &pipeline, const Options &options = Options() );
+
+	//! Returns the Surface8u representing the Movie's current frame, or \c nullptr before the first frame has been decoded
+	Surface8uRef	getSurface();
+	//! Returns the next decoded frame, waiting up to \a timeoutSeconds for it. Returns \c nullptr on timeout or at the end of the movie. Intended for Options::realtime( false ) while playing.
+	Surface8uRef	pullSurface( double timeoutSeconds = 1.0 );
+	//! Advances by exactly one frame while paused and returns it, waiting up to \a timeoutSeconds. Returns \c nullptr if no frame arrived in time.
+	Surface8uRef	stepToNextFrame( double timeoutSeconds = 1.0 );
+	//! Seeks accurately to the start of frame \a frame while paused and returns it, waiting up to \a timeoutSeconds. Returns \c nullptr if no frame arrived in time.
+	Surface8uRef	seekToFrameAndWait( int frame, double timeoutSeconds = 1.0 );
+	//! Waits up to \a timeoutSeconds for a frame newer than the one last returned by getSurface(). Returns whether one arrived.
+	bool			waitForNewFrame( double timeoutSeconds );
+	//! Returns the presentation time in seconds of the frame last returned by getSurface(), pullSurface(), stepToNextFrame() or seekToFrameAndWait(), or -1 if unknown
+	double			getSurfaceTime() const { return mSurfaceTime; }
+	//! Returns whether every frame has been pulled
+	bool			isEndOfStream() const;
+
+  protected:
+	MovieSurface( const Url& url, const Options &options );
+	MovieSurface( const fs::path& path, const Options &options );
+	MovieSurface( const Options &options );
+
+	Surface8uRef	updateSurfaceTime( const Surface8uRef &surface, int64_t timeNanos );
+
+	double			mSurfaceTime;
+};
+
 }} // namespace cinder::linux
 
 namespace cinder { namespace qtime {
 
 using cinder::linux::MovieGl;
 using cinder::linux::MovieGlRef;
+using cinder::linux::MovieSurface;
+using cinder::linux::MovieSurfaceRef;
 
 }} // namespace cinder::qtime
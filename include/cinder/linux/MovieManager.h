@@ -0,0 +1,159 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/linux/Movie.h"
+#include "cinder/Noncopyable.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef struct _GMainLoop GMainLoop;
+
+namespace cinder { namespace linux {
+
+//! \class MovieManager
+//! Shares resources between all of the movies playing at once, such as on a video wall. Every movie's bus messages are handled
+//! by a single thread, decoder threads are divided between the streams, and the decoded frames the streams may queue are held
+//! within a global memory budget. Movies can also be pre-rolled ahead of being played.
+class MovieManager : private Noncopyable {
+  public:
+	struct Options {
+		Options()
+			: mMaxDecodeThreads( std::max<size_t>( std::thread::hardware_concurrency(), 1 ) ), mMaxQueuedBytes( 256 * 1024 * 1024 ), mMaxQueuedFrames( 8 ), mMaxPrerolled( 4 )
+		{}
+
+		//! Sets the number of decoder threads divided between all streams, applied to decoders as they're created. \default std::thread::hardware_concurrency().
+		Options&	maxDecodeThreads( size_t threads )	{ mMaxDecodeThreads = std::max<size_t>( threads, 1 ); return *this; }
+		//! Sets the memory budget for decoded frames queued by all streams, divided equally between them. \default 256MB.
+		Options&	maxQueuedBytes( size_t bytes )		{ mMaxQueuedBytes = bytes; return *this; }
+		//! Sets the most frames any one stream may queue, regardless of the budget. \default 8.
+		Options&	maxQueuedFrames( size_t frames )	{ mMaxQueuedFrames = std::max<size_t>( frames, 1 ); return *this; }
+		//! Sets the number of pre-rolled movies kept by preroll() before the oldest is discarded. \default 4.
+		Options&	maxPrerolled( size_t movies )		{ mMaxPrerolled = movies; return *this; }
+
+		size_t	getMaxDecodeThreads() const	{ return mMaxDecodeThreads; }
+		size_t	getMaxQueuedBytes() const	{ return mMaxQueuedBytes; }
+		size_t	getMaxQueuedFrames() const	{ return mMaxQueuedFrames; }
+		size_t	getMaxPrerolled() const		{ return mMaxPrerolled; }
+
+	  private:
+		size_t	mMaxDecodeThreads, mMaxQueuedBytes, mMaxQueuedFrames, mMaxPrerolled;
+	};
+
+	//! Returns the process-wide MovieManager, which every movie uses. It's never destroyed.
+	static MovieManager&	instance();
+
+	//! Sets the Options and redistributes the queued frame budget between the current streams
+	void			setOptions( const Options &options );
+	Options			getOptions() const;
+
+	//! Returns the number of movies currently loaded
+	size_t			getNumStreams() const;
+	//! Returns the number of threads given to each decoder created now
+	size_t			getNumDecodeThreadsPerStream() const;
+	//! Returns the memory that the frames all streams may queue can occupy, which is within Options::maxQueuedBytes() unless a stream's single frame exceeds its share
+	size_t			getQueuedBytesLimit() const;
+
+	//! Loads \a path and decodes its first frame, keeping the movie for take(). The oldest pre-rolled movie is discarded beyond Options::maxPrerolled().
+	template<typename MovieT>
+	std::shared_ptr<MovieT>	preroll( const fs::path &path );
+	//! Returns the movie pre-rolled for \a path by preroll(), or loads it if there isn't one
+	template<typename MovieT>
+	std::shared_ptr<MovieT>	take( const fs::path &path );
+	//! Discards every pre-rolled movie
+	void			clearPrerolled();
+
+  private:
+	MovieManager();
+
+	void			addPlayer( gst::video::GstPlayer *player );
+	void			removePlayer( gst::video::GstPlayer *player );
+	//! Recalculates the number of frames each stream may queue, such as when one learns the size of its frames
+	void			updateQueueLimits();
+	void			updateQueueLimitsLocked();
+	//! Blocks until any bus message being handled on the main loop thread has been handled
+	void			waitForMainLoop();
+
+	mutable std::mutex							mMutex;
+	Options										mOptions;
+	std::vector<gst::video::GstPlayer*>			mPlayers;
+	std::mutex									mMainLoopMutex; // serializes starting and stopping the main loop
+	GMainLoop									*mMainLoop;
+	std::thread									mMainLoopThread;
+
+	std::mutex									mPrerolledMutex;
+	std::deque<std::pair<fs::path, std::shared_ptr<MovieBase>>>	mPrerolled;
+
+	friend class gst::video::GstPlayer;
+};
+
+template<typename MovieT>
+std::shared_ptr<MovieT> MovieManager::preroll( const fs::path &path )
+{
+	// movies start paused, so loading decodes the first frame
+	std::shared_ptr<MovieT> movie = MovieT::create( path );
+	const size_t maxPrerolled = getOptions().getMaxPrerolled();
+
+	// discarded movies are destroyed after unlocking, as tearing down their pipelines takes a while
+	std::vector<std::shared_ptr<MovieBase>> discarded;
+	{
+		std::lock_guard<std::mutex> lock( mPrerolledMutex );
+		mPrerolled.emplace_back( path, movie );
+		while( mPrerolled.size() > maxPrerolled ) {
+			discarded.push_back( mPrerolled.front().second );
+			mPrerolled.pop_front();
+		}
+	}
+
+	return movie;
+}
+
+template<typename MovieT>
+std::shared_ptr<MovieT> MovieManager::take( const fs::path &path )
+{
+	{
+		std::lock_guard<std::mutex> lock( mPrerolledMutex );
+		for( auto prerolledIt = mPrerolled.begin(); prerolledIt != mPrerolled.end(); ++prerolledIt ) {
+			std::shared_ptr<MovieT> movie = std::dynamic_pointer_cast<MovieT>( prerolledIt->second );
+			if( prerolledIt->first == path && movie ) {
+				mPrerolled.erase( prerolledIt );
+				return movie;
+			}
+		}
+	}
+
+	return MovieT::create( path );
+}
+
+}} // namespace cinder::linux
+
+namespace cinder { namespace qtime {
+
+using cinder::linux::MovieManager;
+
+}} // namespace cinder::qtime
@@ -0,0 +1,128 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Area.h"
+#include "cinder/Font.h"
+#include "cinder/Surface.h"
+#include "cinder/Text.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cinder { namespace linux {
+
+namespace ftutil {
+struct CachedGlyph;
+} // namespace ftutil
+
+//! Retained layout of a block of text, for text which is measured and drawn repeatedly or edited a little at a time.
+//!
+//! Each paragraph (separated by '\n') keeps its glyphs, their advances and its line breaks, so changing the text only lays out
+//! the paragraphs which changed, and changing the alignment or color doesn't lay out anything. Glyphs come from the GlyphCache.
+//! Many blocks can be drawn into a single Surface with renderTextBlocks(). Breaks lines like TextBox.
+class TextBlock {
+  public:
+	TextBlock();
+	//! Copies the layout along with the text, so the copy can be changed without laying out the original again
+	TextBlock( const TextBlock &other );
+	TextBlock&	operator=( const TextBlock &other );
+
+	//! Sets the text, laying out only the paragraphs which differ from the current text. Assumes UTF-8 encoding.
+	TextBlock&			text( const std::string &text )	{ setText( text ); return *this; }
+	void				setText( const std::string &text );
+	const std::string&	getText() const					{ return mText; }
+
+	TextBlock&			font( const Font &font )		{ setFont( font ); return *this; }
+	void				setFont( const Font &font );
+	const Font&			getFont() const					{ return mFont; }
+
+	//! Sets the width lines are broken at, or TextBox::GROW to never break lines. Only breaks lines again, without looking up glyphs. \default TextBox::GROW.
+	TextBlock&			width( int width )				{ setWidth( width ); return *this; }
+	void				setWidth( int width );
+	int					getWidth() const				{ return mWidth; }
+
+	TextBlock&			alignment( TextBox::Alignment align )	{ setAlignment( align ); return *this; }
+	void				setAlignment( TextBox::Alignment align )	{ mAlign = align; }
+	TextBox::Alignment	getAlignment() const			{ return mAlign; }
+
+	TextBlock&			color( const ColorA &color )	{ setColor( color ); return *this; }
+	void				setColor( const ColorA &color )	{ mColor = color; }
+	const ColorA&		getColor() const				{ return mColor; }
+
+	//! Returns the size of the laid out text, which is the width it's broken at unless that's TextBox::GROW
+	ivec2				getSize() const;
+	size_t				getNumLines() const;
+	size_t				getNumParagraphs() const;
+	//! Returns the number of paragraphs whose glyphs have been looked up since the block was created, which measures how much work edits caused
+	size_t				getNumParagraphsShaped() const	{ return mNumParagraphsShaped; }
+
+	//! Draws the text into \a surface with its upper-left corner at \a offset, blending over what's already there. Glyphs are clipped to \a clip if it isn't empty.
+	void				render( Surface *surface, const ivec2 &offset, const Area &clip = Area::zero() ) const;
+	//! Returns a Surface containing the text on a transparent background. If \a premultiplied the alpha will be premultiplied.
+	Surface				render( bool premultiplied = false ) const;
+
+  private:
+	struct Line {
+		size_t		mBeginGlyph, mEndGlyph;
+		int32_t		mWidth; // in 26.6 fixed point, without trailing spaces
+		//! Glyphs rendered at their subpixel offset relative to the start of the line, when that differs from the start of the paragraph
+		std::vector<std::shared_ptr<const ftutil::CachedGlyph>>	mGlyphs;
+	};
+	struct Paragraph {
+		Paragraph( const std::string &text ) : mText( text ), mShaped( false ), mBroken( false ) {}
+
+		std::string				mText;
+		std::vector<size_t>		mByteOffsets; // of each glyph in mText, plus the end of mText
+		std::vector<std::shared_ptr<const ftutil::CachedGlyph>>	mGlyphs;
+		std::vector<int32_t>	mPenX; // 26.6 pen position before each glyph, plus the end of the paragraph
+		std::vector<Line>		mLines;
+		bool					mShaped, mBroken; // whether mGlyphs and mLines are up to date
+	};
+
+	void		layout() const;
+	void		shapeParagraph( Paragraph *paragraph ) const;
+	void		breakParagraph( Paragraph *paragraph ) const;
+
+	std::string			mText;
+	Font				mFont;
+	int					mWidth;
+	TextBox::Alignment	mAlign;
+	ColorA				mColor;
+
+	mutable std::vector<std::shared_ptr<Paragraph>>	mParagraphs;
+	mutable bool		mInvalid;
+	mutable size_t		mNumParagraphsShaped;
+	mutable ivec2		mSize;
+	mutable int			mLineHeight, mAscent;
+};
+
+//! Draws \a blocks into a single Surface \a width pixels wide, packing them into rows in order with \a padding pixels between them.
+//! The area each block was drawn to is returned in \a areas. If \a premultiplied the alpha will be premultiplied.
+Surface renderTextBlocks( const std::vector<const TextBlock*> &blocks, int width, std::vector<Area> *areas, bool premultiplied = false, int padding = 1 );
+//! Draws \a blocks into a single Surface \a width pixels wide, packing them into rows in order with \a padding pixels between them.
+Surface renderTextBlocks( const std::vector<TextBlock> &blocks, int width, std::vector<Area> *areas, bool premultiplied = false, int padding = 1 );
+
+}} // namespace cinder::linux
@@ -25,7 +25,7 @@
 #pragma once
 
 #include "cinder/Cinder.h"
-#include "cinder/Xml.h"
+#include "cinder/XmlDocument.h"
 #include "cinder/Vector.h"
 #include "cinder/Matrix.h"
 #include "cinder/Color.h"
@@ -38,6 +38,7 @@
 
 #include <functional>
 #include <map>
+#include <unordered_map>
 
 namespace cinder { namespace svg {
 
@@ -69,6 +70,15 @@ class CI_API Renderer {
 
 	void	setVisitor( const std::function<bool(const Node&, svg::Style *)> &visitor );
 
+	//! Restricts rendering to Nodes whose world bounds intersect \a rect, expressed in document coordinates. Nodes without known bounds are always rendered.
+	void			setCullRect( const Rectf &rect ) { mCullRect = rect; mHasCullRect = true; }
+	//! Disables culling, rendering all Nodes.
+	void			clearCullRect() { mHasCullRect = false; }
+	//! Returns whether rendering is restricted to a cull rectangle.
+	bool			hasCullRect() const { return mHasCullRect; }
+	//! Returns the cull rectangle in document coordinates. Only meaningful when hasCullRect() returns \c true.
+	const Rectf&	getCullRect() const { return mCullRect; }
+
 	virtual	void	pushGroup( const Group & /*group*/, float /*opacity*/ ) {}
 	virtual void	popGroup() {}
 	virtual void	drawPath( const svg::Path & /*path*/ ) {}
@@ -116,6 +126,8 @@ class CI_API Renderer {
   protected:
 	// this is a shared_ptr to work around a bug in Clang 4.0
 	std::shared_ptr<std::function<bool(const Node&, svg::Style *)> >		mVisitor;
+	bool		mHasCullRect = false;
+	Rectf		mCullRect;
 
 	friend class svg::Node;
 };
@@ -181,7 +193,7 @@ class CI_API Paint {
 class CI_API Style {
   public:
 	Style();
-	Style( const XmlTree &xml, const Node *parent );
+	Style( const XmlDocument::Node &xml, const Node *parent );
 
 	//! Returns a Style set appropriately for global defaults
 	static Style	makeGlobalDefaults();
@@ -307,7 +319,7 @@ class CI_API Style {
 //! Base class for an element of an SVG Document
 class CI_API Node {
   public:
-	Node( Node *parent ) : mParent( parent ),  mSpecifiesTransform( false ), mBoundingBoxCached( false ) {}
+	Node( Node *parent ) : mParent( parent ),  mSpecifiesTransform( false ), mBoundingBoxCached( false ), mWorldBoundsCached( false ), mWorldBoundsKnown( false ) {}
 	virtual ~Node() {}
 	
 	//! Returns the svg::Doc this Node is an element of
@@ -341,9 +353,9 @@ class CI_API Node {
 	//! Returns the local transformation of this node. Returns identity if the Node's transform isn't specified.
 	mat3				getTransform() const { return mTransform; }
 	//! Sets the local transformation of this node.
-	void				setTransform( const mat3 &transform ) { mTransform = transform; mSpecifiesTransform = true; }
+	void				setTransform( const mat3 &transform );
 	//! Removes the local transformation of this node, effectively making it the identity matrix.
-	void				unspecifyTransform() { mSpecifiesTransform = false; }
+	void				unspecifyTransform();
 	//! Returns the inverse of the local transformation of this node. Returns identity if the Node's transform isn't specified.
 	mat3				getTransformInverse() const { return ( mSpecifiesTransform ) ? inverse( mTransform ) : mat3(); }
 	//! Returns the absolute transformation of this node, which includes inherited transformations.
@@ -355,6 +367,10 @@ class CI_API Node {
 	Rectf			getBoundingBox() const { if( ! mBoundingBoxCached ) { mBoundingBox = calcBoundingBox(); mBoundingBoxCached = true; } return mBoundingBox;  }
 	//! Returns the absolute bounding box of the Node. Calculated and cached the first time it is requested.
 	Rectf			getBoundingBoxAbsolute() const { return getBoundingBox().transformed( getTransformAbsolute() ); }
+	//! Returns the axis-aligned bounds of the Node in document coordinates, including its stroke. Cached, and recalculated after the transform of the Node or one of its ancestors changes. Empty when hasWorldBounds() is \c false.
+	const Rectf&	getWorldBounds() const;
+	//! Returns whether the world bounds of the Node are known. They are not for Text and Use nodes, nor for Groups which contain them.
+	bool			hasWorldBounds() const { getWorldBounds(); return mWorldBoundsKnown; }
 
 	//! Returns a Shape2d representing the node in local coordinates. Not supported for Text.
 	virtual Shape2d	getShape() const { return Shape2d(); }
@@ -390,7 +406,7 @@ class CI_API Node {
 
 
   protected:
-	Node( Node *parent, const XmlTree &xml );
+	Node( Node *parent, const XmlDocument::Node &xml );
 	// returns whether this type of node directly renders anything. Everything but groups.
 	virtual bool	isDrawable() const { return true; }
 
@@ -399,6 +415,12 @@ class CI_API Node {
 	virtual void	renderSelf( Renderer &renderer ) const = 0;
 	
 	virtual Rectf	calcBoundingBox() const { return Rectf( 0, 0, 0, 0 ); }
+	// calculates the world bounds into \a result, returning whether they are known
+	virtual bool	calcWorldBounds( Rectf *result ) const;
+	// marks the world bounds of this node and its descendants as stale
+	virtual void	invalidateWorldBounds() const { mWorldBoundsCached = false; }
+	// called whenever the local transform changes, to update cached bounds and the Doc's spatial index
+	void			transformChanged();
 
 	static Paint		parsePaint( const char *value, bool *specified, const Node *parentNode );
 	static mat3			parseTransform( const std::string &value );
@@ -415,6 +437,8 @@ class CI_API Node {
 	mat3			mTransform;
 	mutable bool	mBoundingBoxCached;
 	mutable Rectf	mBoundingBox;
+	mutable bool	mWorldBoundsCached, mWorldBoundsKnown;
+	mutable Rectf	mWorldBounds;
 	
   private:
   	void			firstStartRender( Renderer &renderer ) const;
@@ -426,11 +450,11 @@ class CI_API Node {
 //! Base class for SVG Gradients. See SVG Gradients: http://www.w3.org/TR/SVG/pservers.html#Gradients
 class CI_API Gradient : public Node {
   public:
-  	Gradient( Node *parent, const XmlTree &xml );
+  	Gradient( Node *parent, const XmlDocument::Node &xml );
 	
 	class CI_API Stop {
 	  public:
-	  	Stop( const Node *parent, const XmlTree &xml );
+	  	Stop( const Node *parent, const XmlDocument::Node &xml );
 		
 		float		mOffset; // normalized 0-1
 		ColorA8u	mColor;
@@ -444,7 +468,7 @@ class CI_API Gradient : public Node {
   protected:
 	virtual void	renderSelf( Renderer & /*renderer*/ ) const {}
 
-	void 		parse( const Node *parent, const XmlTree &xml );
+	void 		parse( const Node *parent, const XmlDocument::Node &xml );
 	void		copyAttributesFrom( const Gradient &rhs );
 	Paint		asPaint() const;
 
@@ -458,12 +482,12 @@ class CI_API Gradient : public Node {
 //! SVG Linear gradient
 class CI_API LinearGradient : public Gradient {
   public:
-	LinearGradient( Node *parent, const XmlTree &xml );
+	LinearGradient( Node *parent, const XmlDocument::Node &xml );
 	
 	Paint		asPaint() const;
 	
   protected:
-	void 		parse( const XmlTree &xml );
+	void 		parse( const XmlDocument::Node &xml );
 	
   	virtual bool	isDrawable() const { return false; }
 };
@@ -471,12 +495,12 @@ class CI_API LinearGradient : public Gradient {
 //! SVG Radial gradient
 class CI_API RadialGradient : public Gradient {
   public:
-	RadialGradient( Node *parent, const XmlTree &xml );
+	RadialGradient( Node *parent, const XmlDocument::Node &xml );
 	
 	Paint		asPaint() const;
 	
   protected:
-	void 		parse( const XmlTree &xml );
+	void 		parse( const XmlDocument::Node &xml );
 
 	virtual bool	isDrawable() const { return false; }
 	float			mRadius;
@@ -486,7 +510,7 @@ class CI_API RadialGradient : public Gradient {
 class CI_API Circle : public Node {
   public:
 	Circle( Node *parent ) : Node( parent ) {}
-	Circle( Node *parent, const XmlTree &xml );
+	Circle( Node *parent, const XmlDocument::Node &xml );
 	
 	vec2		getCenter() const { return mCenter; }
 	void		setCenter( const vec2 &center ) { mCenter = center; }
@@ -509,7 +533,7 @@ class CI_API Circle : public Node {
 class CI_API Ellipse : public Node {
   public:
 	Ellipse( Node *parent ) : Node( parent ) {}
-	Ellipse( Node *parent, const XmlTree &xml );
+	Ellipse( Node *parent, const XmlDocument::Node &xml );
 	
 	vec2		getCenter() const { return mCenter; }
 	void		setCenter( const vec2 &center ) { mCenter = center; }
@@ -534,7 +558,7 @@ class CI_API Ellipse : public Node {
 class CI_API Path : public Node {
   public:
 	Path( Node *parent ) : Node( parent ) {}
-	Path( Node *parent, const XmlTree &xml );
+	Path( Node *parent, const XmlDocument::Node &xml );
 	
 	const Shape2d&		getShape2d() const { return mPath; }
 	void				appendShape2d( Shape2d *appendTo ) const;
@@ -555,7 +579,7 @@ class CI_API Path : public Node {
 class CI_API Line : public Node {
   public:
 	Line( Node *parent ) : Node( parent ) {}
-	Line( Node *parent, const XmlTree &xml );
+	Line( Node *parent, const XmlDocument::Node &xml );
 	
 	const vec2&	getPoint1() const { return mPoint1; }
 	const vec2&	getPoint2() const { return mPoint2; }
@@ -573,7 +597,7 @@ class CI_API Line : public Node {
 class CI_API Rect : public Node {
   public:
 	Rect( Node *parent ) : Node( parent ) {}
-	Rect( Node *parent, const XmlTree &xml );
+	Rect( Node *parent, const XmlDocument::Node &xml );
 	
 	const Rectf&	getRect() const { return mRect; }
 	void			setRect( const Rectf &rect ) { mRect = rect; }
@@ -595,7 +619,7 @@ class CI_API Rect : public Node {
 class CI_API Polygon : public Node {
   public:
 	Polygon( Node *parent ) : Node( parent ) {}
-	Polygon( Node *parent, const XmlTree &xml );
+	Polygon( Node *parent, const XmlDocument::Node &xml );
 
 	const PolyLine2f&	getPolyLine() const { return mPolyLine; }
 	PolyLine2f&			getPolyLine() { return mPolyLine; }
@@ -615,7 +639,7 @@ class CI_API Polygon : public Node {
 class CI_API Polyline : public Node {
   public:
 	Polyline( Node *parent ) : Node( parent ) {}
-	Polyline( Node *parent, const XmlTree &xml );
+	Polyline( Node *parent, const XmlDocument::Node &xml );
 
 	const PolyLine2f&	getPolyLine() const { return mPolyLine; }
 	PolyLine2f&			getPolyLine() { return mPolyLine; }
@@ -634,7 +658,7 @@ class CI_API Polyline : public Node {
 //! SVG Use Element, which instantiates a different element: http://www.w3.org/TR/SVG/struct.html#UseElement
 class CI_API Use : public Node {
   public:
-	Use( Node *parent, const XmlTree &xml );
+	Use( Node *parent, const XmlDocument::Node &xml );
 	
 	virtual bool	isDrawable() const { return false; }
 	
@@ -643,8 +667,10 @@ class CI_API Use : public Node {
   protected:
 	virtual void	renderSelf( Renderer &renderer ) const;  
 	virtual Rectf	calcBoundingBox() const { if( mReferenced ) return mReferenced->getBoundingBox(); else return Rectf(0,0,0,0); }
+	// the referenced node is rendered with its own transform, so the bounds are not known without rendering it
+	bool			calcWorldBounds( Rectf * /*result*/ ) const override { return false; }
 	
-	void parse( const XmlTree &xml );
+	void parse( const XmlDocument::Node &xml );
 	
 	const Node		*mReferenced;
 };
@@ -652,7 +678,7 @@ class CI_API Use : public Node {
 //! SVG Image Element. Represents an unpremultiplied bitmap. http://www.w3.org/TR/SVG/struct.html#ImageElement
 class CI_API Image : public Node {
   public:
-	Image( Node *parent, const XmlTree &xml );
+	Image( Node *parent, const XmlDocument::Node &xml );
 
 	const Rectf&						getRect() const { return mRect; }
 	const std::shared_ptr<Surface8u>	getSurface() const { return mImage; }
@@ -678,7 +704,7 @@ class CI_API TextSpan : public Node {
 	class CI_API Attributes {
 	  public:
 		Attributes() {}
-		Attributes( const XmlTree &xml );
+		Attributes( const XmlDocument::Node &xml );
 
 		void 	startRender( Renderer &renderer ) const;
 		void 	finishRender( Renderer &renderer ) const;
@@ -693,7 +719,7 @@ class CI_API TextSpan : public Node {
 		std::vector<Value>	mLetterSpacing;
 	};
 
-	TextSpan( Node *parent, const XmlTree &xml );
+	TextSpan( Node *parent, const XmlDocument::Node &xml );
 	TextSpan( Node *parent, const std::string &spanString );
 	
 	const std::string&						getString() const { return mString; }
@@ -727,7 +753,7 @@ class CI_API TextSpan : public Node {
 //! SVG Text element. http://www.w3.org/TR/SVG/text.html#TextElement
 class CI_API Text : public Node {
   public:
-  	Text( Node *parent, const XmlTree &xml );
+  	Text( Node *parent, const XmlDocument::Node &xml );
 
 	vec2 	getTextPen() const;
 	void	setTextPen( const vec2 &textPen ) { mAttributes.setTextPen( textPen ); }  
@@ -749,7 +775,7 @@ class CI_API Text : public Node {
 class CI_API Group : public Node, private Noncopyable {
   public:
 	Group( Node *parent ) : Node( parent ) {}
-	Group( Node *parent, const XmlTree &xml );
+	Group( Node *parent, const XmlDocument::Node &xml );
 	~Group();
 
 	//! Recursively searches for a child element of type <tt>svg::T</tt> named \a id. Returns NULL on failure to find the object or if it is not of type T.
@@ -759,7 +785,7 @@ class CI_API Group : public Node, private Noncopyable {
     template<typename T>
 	T*						find( const std::string &id ) { return dynamic_cast<T*>( findNode( id ) ); }
 	//! Recursively searches for a child element named \a id. Returns NULL on failure.
-	const Node*				findNode( const std::string &id, bool recurse = true ) const;
+	virtual const Node*		findNode( const std::string &id, bool recurse = true ) const;
 	//! Recursively searches for a child element named \a id. Returns NULL on failure.
 	Node*					findNode( const std::string &id, bool recurse = true ) { return const_cast<Node*>( const_cast<const Group*>( this )->findNode( id, recurse ) ); }
 	//! Recursively searches for a child element of type <tt>svg::T</tt> whose name contains \a idPartial. Returns NULL on failure to find the object or if it is not of type T.
@@ -799,12 +825,16 @@ class CI_API Group : public Node, private Noncopyable {
 
 	virtual void	renderSelf( Renderer &renderer ) const;
 	virtual Rectf	calcBoundingBox() const;
+	bool			calcWorldBounds( Rectf *result ) const override;
+	void			invalidateWorldBounds() const override;
 
 	virtual bool	isDrawable() const { return false; }
-	void 			parse( const XmlTree &xml );
+	void 			parse( const XmlDocument::Node &xml );
 
 	std::list<Node*>		mChildren;
 	std::shared_ptr<Group>	mDefs;
+
+	friend class Doc;
 };
 
 
@@ -812,9 +842,10 @@ typedef std::shared_ptr<Doc>	DocRef;
 //! Represents an SVG Document. See SVG Document Structure http://www.w3.org/TR/SVG/struct.html
 class CI_API Doc : public Group {
   public:
-	Doc() : Group( 0 ), mWidth( 0 ), mHeight( 0 ) {}
+	Doc();
 	Doc( const fs::path &filePath );
 	Doc( DataSourceRef dataSource, const fs::path &filePath = fs::path() );
+	~Doc();
 
 	static DocRef	create( const fs::path &filePath );
 	static DocRef	create( DataSourceRef dataSource, const fs::path &filePath = fs::path() );
@@ -834,22 +865,39 @@ class CI_API Doc : public Group {
 	//! Returns the document's dots-per-inch. Currently hardcoded to 72.
 	float		getDpi() const { return 72.0f; }
 	
-	//! Returns the top-most Node which contains \a pt. Returns NULL if no Node contains the point.
+	//! Returns the top-most Node which contains \a pt. Returns NULL if no Node contains the point. Uses the spatial index, which is built on first use.
 	Node*		nodeUnderPoint( const vec2 &pt );
-	
+	//! Returns the Nodes whose world bounds intersect \a rect, in document order. Groups are descended rather than returned, and Nodes without known bounds are omitted.
+	std::vector<Node*>	findNodesInRect( const Rectf &rect );
+	//! Discards the spatial and ID indices, which are rebuilt on next use. Necessary after adding or removing Nodes or changing stroke widths; transform changes are tracked automatically.
+	void		invalidateIndices();
+
+	using Group::findNode;
+	//! Recursively searches for a child element named \a id. Recursive searches use an index built on first use.
+	const Node*	findNode( const std::string &id, bool recurse = true ) const override;
+
 	//! Utility function to load an image relative to the document. Caches results.
 	std::shared_ptr<Surface8u>	loadImage( fs::path relativePath );
   private:
+	class SpatialIndex;
+
   	void 	loadDoc( DataSourceRef source, fs::path filePath );
+	void	buildIdIndex( const Group *group ) const;
+	// called by Node::transformChanged()
+	void	nodeTransformChanged( const Node *node );
 
 	virtual void		renderSelf( Renderer &renderer ) const;
   
-	std::shared_ptr<XmlTree>	mXmlTree;
 	std::map<fs::path,std::shared_ptr<Surface8u> >	mImageCache;
+	std::unique_ptr<SpatialIndex>							mSpatialIndex;
+	mutable std::unordered_map<std::string,const Node*>	mIdIndex;
+	mutable bool											mIdIndexBuilt;
 	
 	fs::path		mFilePath;
 	Area			mViewBox;
 	int32_t			mWidth, mHeight;
+
+	friend class Node;
 };
 
 //! SVG Exception base-class
@@ -7,6 +7,7 @@ option( CINDER_DISABLE_AUDIO "Build Cinder without audio support. " OFF )
 option( CINDER_DISABLE_VIDEO "Build Cinder without video support. " OFF )
 option( CINDER_DISABLE_ANTTWEAKBAR "Build Cinder without AntTweakBar support. " OFF )
 option( CINDER_DISABLE_IMGUI "Build Cinder without imgui support. " OFF )
+option( CINDER_DISABLE_PROFILER "Compile out Cinder's profiler zones and the CI_PROFILE_* macros. " OFF )
 
 include( ${CMAKE_CURRENT_LIST_DIR}/utilities.cmake )
 
@@ -79,3 +79,7 @@ if( CINDER_DISABLE_IMGUI )
 else()
 	set( CINDER_IMGUI_ENABLED TRUE )
 endif()
+
+if( CINDER_DISABLE_PROFILER )
+	list( APPEND CINDER_DEFINES "-DCI_PROFILER_ENABLED=0" )
+endif()
@@ -28,18 +28,21 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Font.cpp
 	${CINDER_SRC_DIR}/cinder/Frustum.cpp
 	${CINDER_SRC_DIR}/cinder/GeomIo.cpp
+	${CINDER_SRC_DIR}/cinder/GeomSimplify.cpp
 	${CINDER_SRC_DIR}/cinder/ImageFileTinyExr.cpp
 	${CINDER_SRC_DIR}/cinder/ImageIo.cpp
 	${CINDER_SRC_DIR}/cinder/ImageSourceFileRadiance.cpp
 	${CINDER_SRC_DIR}/cinder/ImageSourceFileStbImage.cpp
 	${CINDER_SRC_DIR}/cinder/ImageTargetFileStbImage.cpp
 	${CINDER_SRC_DIR}/cinder/Json.cpp
+	${CINDER_SRC_DIR}/cinder/JsonDocument.cpp
 	${CINDER_SRC_DIR}/cinder/Log.cpp
 	${CINDER_SRC_DIR}/cinder/Matrix.cpp
 	${CINDER_SRC_DIR}/cinder/MediaTime.cpp
 	${CINDER_SRC_DIR}/cinder/ObjLoader.cpp
 	${CINDER_SRC_DIR}/cinder/Path2d.cpp
 	${CINDER_SRC_DIR}/cinder/Perlin.cpp
+	${CINDER_SRC_DIR}/cinder/Profiler.cpp
 	${CINDER_SRC_DIR}/cinder/Plane.cpp
 	${CINDER_SRC_DIR}/cinder/PolyLine.cpp
 	${CINDER_SRC_DIR}/cinder/Rand.cpp
@@ -51,6 +54,7 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Stream.cpp
 	${CINDER_SRC_DIR}/cinder/Surface.cpp
 	${CINDER_SRC_DIR}/cinder/System.cpp
+	${CINDER_SRC_DIR}/cinder/TaskScheduler.cpp
 	${CINDER_SRC_DIR}/cinder/Text.cpp
 	${CINDER_SRC_DIR}/cinder/Timeline.cpp
 	${CINDER_SRC_DIR}/cinder/TimelineItem.cpp
@@ -62,6 +66,7 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Url.cpp
 	${CINDER_SRC_DIR}/cinder/Utilities.cpp
 	${CINDER_SRC_DIR}/cinder/Xml.cpp
+	${CINDER_SRC_DIR}/cinder/XmlDocument.cpp
 )
 
 if( ( NOT CINDER_LINUX ) AND ( NOT CINDER_ANDROID ) )
@@ -186,15 +191,21 @@ list( APPEND SRC_SET_CINDER_IP
 	${CINDER_SRC_DIR}/cinder/ip/Blend.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Blur.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Checkerboard.cpp
+	${CINDER_SRC_DIR}/cinder/ip/ColorSpace.cpp
+	${CINDER_SRC_DIR}/cinder/ip/ConnectedComponents.cpp
+	${CINDER_SRC_DIR}/cinder/ip/Convolve.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Fill.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Grayscale.cpp
+	${CINDER_SRC_DIR}/cinder/ip/Morphology.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Premultiply.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Threshold.cpp
 	${CINDER_SRC_DIR}/cinder/ip/EdgeDetect.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Flip.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Hdr.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Resize.cpp
+	${CINDER_SRC_DIR}/cinder/ip/Statistics.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Trim.cpp
+	${CINDER_SRC_DIR}/cinder/ip/Warp.cpp
 )
 
 list( APPEND CINDER_SRC_FILES       ${SRC_SET_CINDER_IP} )
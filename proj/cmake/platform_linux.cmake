@@ -25,6 +25,7 @@ list( APPEND SRC_SET_GLFW
 
 list( APPEND SRC_SET_CINDER_APP_LINUX
 	${CINDER_SRC_DIR}/cinder/app/linux/AppLinux.cpp
+	${CINDER_SRC_DIR}/cinder/app/linux/FramePacer.cpp
 	${CINDER_SRC_DIR}/cinder/app/linux/PlatformLinux.cpp
 )
 
@@ -47,11 +48,21 @@ if( NOT CINDER_DISABLE_VIDEO )
 	list( APPEND SRC_SET_CINDER_VIDEO_LINUX
 		${CINDER_SRC_DIR}/cinder/linux/GstPlayer.cpp
 		${CINDER_SRC_DIR}/cinder/linux/Movie.cpp
+		${CINDER_SRC_DIR}/cinder/linux/MovieManager.cpp
 	)
 endif()
 
+# FreeType
+list( APPEND SRC_SET_CINDER_LINUX
+	${CINDER_SRC_DIR}/cinder/linux/GlyphCache.cpp
+	${CINDER_SRC_DIR}/cinder/linux/TextBlock.cpp
+)
+
 # Curl
-list( APPEND SRC_SET_CINDER_LINUX ${CINDER_SRC_DIR}/cinder/UrlImplCurl.cpp )
+list( APPEND SRC_SET_CINDER_LINUX
+	${CINDER_SRC_DIR}/cinder/HttpClient.cpp
+	${CINDER_SRC_DIR}/cinder/UrlImplCurl.cpp
+)
 
 # Relevant source files depending on target GL and if we running headless.
 if( NOT CINDER_HEADLESS ) # Desktop ogl, es2, es3, RPi
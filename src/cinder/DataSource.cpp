@@ -88,6 +88,30 @@ IStreamRef DataSourcePath::createStream()
 	return loadFileStream( mFilePath );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// DataSourceMapped
+DataSourceMappedRef DataSourceMapped::create( const fs::path &path, MappedFile::Access access )
+{
+	return DataSourceMappedRef( new DataSourceMapped( MappedFile::create( path, access ) ) );
+}
+
+DataSourceMapped::DataSourceMapped( const MappedFileRef &mappedFile )
+	: DataSource( mappedFile->getFilePath(), Url() ), mMappedFile( mappedFile )
+{
+	setFilePathHint( mappedFile->getFilePath() );
+}
+
+void DataSourceMapped::createBuffer()
+{
+	// a view of the mapping rather than a copy
+	mBuffer = mMappedFile->createBuffer();
+}
+
+IStreamRef DataSourceMapped::createStream()
+{
+	return IStreamMapped::create( mMappedFile );
+}
+
 
 #if defined( CINDER_ANDROID )
 /////////////////////////////////////////////////////////////////////////////
@@ -136,6 +160,15 @@ DataSourceRef loadFile( const fs::path &path )
 #endif	
 }
 
+DataSourceRef loadFileMapped( const fs::path &path, MappedFile::Access access )
+{
+#if defined( CINDER_ANDROID )
+	if( ci::app::PlatformAndroid::isAssetPath( path ) )
+		return DataSourceAndroidAsset::create( path );
+#endif
+	return DataSourceMapped::create( path, access );
+}
+
 
 #if ! defined( CINDER_UWP )
 /////////////////////////////////////////////////////////////////////////////
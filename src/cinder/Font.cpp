@@ -1196,6 +1196,7 @@ FontObj::~FontObj()
 void FontObj::releaseFreeTypeFace()
 {
 	if( nullptr != mFace ) {
+		linux::ftutil::GlyphCache::instance().removeFace( mFace );
 		FT_Done_Face( mFace );
 		mFace = nullptr;
 	}
@@ -31,7 +31,9 @@
 #include "cinder/BSpline.h"
 #include "cinder/Matrix.h"
 #include "cinder/Sphere.h"
+#include "cinder/Thread.h"
 #include <algorithm>
+#include <unordered_map>
 
 #if defined( CINDER_ANDROID )
   #include "cinder/app/App.h"
@@ -96,6 +98,13 @@ AttribSet Modifier::getAvailableAttribs( const Modifier::Params &upstreamParams
 	return upstreamParams.getAvailableAttribs();
 }
 
+void Modifier::processPerVertex( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
+{
+	ctx->processUpstream( getUpstreamAttribs( requestedAttribs ) );
+	if( prepareVertices( ctx, false ) )
+		processVertices( ctx, 0, ctx->getNumVertices() );
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////////////
 // BufferLayout
@@ -390,78 +399,542 @@ void copyIndexDataForceTrianglesImpl( Primitive primitive, const uint32_t *sourc
 	}
 }
 
+// Work below which splitting mesh calculations across threads isn't worthwhile
+const size_t sMinElementsPerThread = 16384;
+
+// Lists the triangle corners around each vertex: the corners of vertex v are corners[offsets[v]] through corners[offsets[v+1] - 1], and corner c belongs to
+// triangle c / 3. When \a remap is non-NULL corners are listed under remap[index] instead. Gathering per vertex lets accumulation run in parallel without
+// atomics, and sums the triangles of each vertex in the same order as a sequential loop over triangles would.
+void buildVertexCorners( size_t numIndices, const uint32_t *indices, size_t numVertices, const uint32_t *remap, vector<uint32_t> *offsets, vector<uint32_t> *corners )
+{
+	offsets->assign( numVertices + 1, 0 );
+	for( size_t i = 0; i < numIndices; ++i )
+		(*offsets)[( remap ? remap[indices[i]] : indices[i] ) + 1]++;
+	for( size_t v = 0; v < numVertices; ++v )
+		(*offsets)[v + 1] += (*offsets)[v];
+
+	corners->resize( numIndices );
+	vector<uint32_t> next( offsets->begin(), offsets->end() - 1 );
+	for( size_t i = 0; i < numIndices; ++i )
+		(*corners)[next[remap ? remap[indices[i]] : indices[i]]++] = (uint32_t)i;
+}
+
 // Lengyel, Eric. "Computing Tangent Space Basis Vectors for an Arbitrary Mesh". 
 // Terathon Software 3D Graphics Library, 2001.
 // http://www.terathon.com/code/tangent.html
 template<typename TEXTYPE>
 void calculateTangentsImpl( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const TEXTYPE *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
 {
-	if( resultTangents )
-		resultTangents->assign( numVertices, vec3( 0 ) );
+	size_t numTriangles = numIndices / 3;
+	vector<vec3> triangleTangents( numTriangles );
+	parallelFor( numTriangles, sMinElementsPerThread, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			uint32_t index0 = indices[i * 3];
+			uint32_t index1 = indices[i * 3 + 1];
+			uint32_t index2 = indices[i * 3 + 2];
+
+			const vec3 &v0 = positions[index0];
+			const vec3 &v1 = positions[index1];
+			const vec3 &v2 = positions[index2];
+
+			const vec2 &w0 = vec2( texCoords[index0] );
+			const vec2 &w1 = vec2( texCoords[index1] );
+			const vec2 &w2 = vec2( texCoords[index2] );
+
+			float x1 = v1.x - v0.x;
+			float x2 = v2.x - v0.x;
+			float y1 = v1.y - v0.y;
+			float y2 = v2.y - v0.y;
+			float z1 = v1.z - v0.z;
+			float z2 = v2.z - v0.z;
+
+			float s1 = w1.x - w0.x;
+			float s2 = w2.x - w0.x;
+			float t1 = w1.y - w0.y;
+			float t2 = w2.y - w0.y;
+
+			float r = (s1 * t2 - s2 * t1);
+			if( r != 0.0f ) r = 1.0f / r;
+
+			triangleTangents[i] = vec3( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
+		}
+	} );
+
+	vector<uint32_t> offsets, corners;
+	buildVertexCorners( numTriangles * 3, indices, numVertices, nullptr, &offsets, &corners );
+
+	resultTangents->resize( numVertices );
+	size_t firstBitangent = 0;
+	if( resultBitangents ) {
+		firstBitangent = resultBitangents->size();
+		resultBitangents->resize( firstBitangent + numVertices );
+	}
+
+	parallelFor( numVertices, sMinElementsPerThread, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			vec3 tangent( 0 );
+			for( uint32_t c = offsets[i]; c < offsets[i + 1]; ++c )
+				tangent += triangleTangents[corners[c] / 3];
+
+			const vec3 &normal = normals[i];
+			tangent -= normal * dot( normal, tangent );
+			float len = length2( tangent );
+			if( len > 0.0f )
+				tangent /= sqrt( len );
+
+			(*resultTangents)[i] = tangent;
+			if( resultBitangents )
+				(*resultBitangents)[firstBitangent + i] = normalize( cross( normal, tangent ) );
+		}
+	} );
+}
+
+} // anonymous namespace
+
+void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec2 *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
+{
+	calculateTangentsImpl( numIndices, indices, numVertices, positions, normals, texCoords, resultTangents, resultBitangents );
+}
+
+void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec3 *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
+{
+	calculateTangentsImpl( numIndices, indices, numVertices, positions, normals, texCoords, resultTangents, resultBitangents );
+}
+
+size_t weldVertices( size_t numVertices, const vec3 *positions, float epsilon, vector<uint32_t> *resultRemap )
+{
+	resultRemap->resize( numVertices );
+
+	// With cells twice as large as epsilon, the vertices within epsilon of a position lie in the 2x2x2 cells nearest to it.
+	// Each cell chains the unique vertices inside it through 'nextInCell'.
+	const bool exact = epsilon <= 0;
+	const float cellSize = exact ? 1.0f : 2 * epsilon;
+	const float epsilon2 = epsilon * epsilon;
+	const uint32_t endOfChain = 0xFFFFFFFF;
+	unordered_map<uint64_t, uint32_t> cellHeads;
+	cellHeads.reserve( numVertices );
+	vector<uint32_t> nextInCell( numVertices, endOfChain );
+
+	auto cellKey = []( int64_t x, int64_t y, int64_t z ) {
+		const uint64_t mask = ( 1 << 21 ) - 1;
+		return ( (uint64_t)x & mask ) | ( ( (uint64_t)y & mask ) << 21 ) | ( ( (uint64_t)z & mask ) << 42 );
+	};
+
+	size_t numUnique = 0;
+	for( size_t i = 0; i < numVertices; ++i ) {
+		const vec3 &p = positions[i];
+		const vec3 cellPos = p / cellSize;
+		const vec3 cellFloor = glm::floor( cellPos );
+		const int64_t cell[3] = { (int64_t)cellFloor.x, (int64_t)cellFloor.y, (int64_t)cellFloor.z };
+		// the neighbor on the side of the cell nearer to 'p' along each axis
+		int64_t neighbor[3];
+		for( int axis = 0; axis < 3; ++axis )
+			neighbor[axis] = ( cellPos[axis] - cellFloor[axis] < 0.5f ) ? -1 : 1;
+
+		uint32_t match = endOfChain;
+		const int numCells = exact ? 1 : 8;
+		for( int c = 0; c < numCells; ++c ) {
+			auto headIt = cellHeads.find( cellKey( cell[0] + ( c & 1 ) * neighbor[0], cell[1] + ( ( c >> 1 ) & 1 ) * neighbor[1], cell[2] + ( c >> 2 ) * neighbor[2] ) );
+			if( headIt == cellHeads.end() )
+				continue;
+			for( uint32_t j = headIt->second; j != endOfChain; j = nextInCell[j] ) {
+				if( j < match && ( exact ? positions[j] == p : length2( positions[j] - p ) < epsilon2 ) )
+					match = j;
+			}
+		}
+
+		if( match != endOfChain )
+			(*resultRemap)[i] = match;
+		else {
+			(*resultRemap)[i] = (uint32_t)i;
+			auto inserted = cellHeads.insert( make_pair( cellKey( cell[0], cell[1], cell[2] ), (uint32_t)i ) );
+			if( ! inserted.second ) {
+				nextInCell[i] = inserted.first->second;
+				inserted.first->second = (uint32_t)i;
+			}
+			numUnique++;
+		}
+	}
+
+	return numUnique;
+}
 
+void calculateNormals( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const uint32_t *remap, NormalWeighting weighting, vector<vec3> *resultNormals )
+{
 	size_t numTriangles = numIndices / 3;
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		uint32_t index0 = indices[i * 3];
-		uint32_t index1 = indices[i * 3 + 1];
-		uint32_t index2 = indices[i * 3 + 2];
 
-		const vec3 &v0 = positions[index0];
-		const vec3 &v1 = positions[index1];
-		const vec3 &v2 = positions[index2];
+	// normals of degenerate triangles are left at zero so that they don't contribute
+	vector<vec3> triangleNormals( numTriangles );
+	parallelFor( numTriangles, sMinElementsPerThread, [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			const vec3 &v0 = positions[indices[i * 3 + 0]];
+			const vec3 &v1 = positions[indices[i * 3 + 1]];
+			const vec3 &v2 = positions[indices[i * 3 + 2]];
+
+			vec3 e0 = v1 - v0;
+			vec3 e1 = v2 - v0;
+			vec3 e2 = v2 - v1;
+			if( length2( e0 ) < FLT_EPSILON || length2( e1 ) < FLT_EPSILON || length2( e2 ) < FLT_EPSILON )
+				triangleNormals[i] = vec3( 0 );
+			else if( weighting == NormalWeighting::AREA )
+				triangleNormals[i] = cross( e0, e1 );
+			else
+				triangleNormals[i] = normalize( cross( e0, e1 ) );
+		}
+	} );
+
+	vector<uint32_t> offsets, corners;
+	buildVertexCorners( numTriangles * 3, indices, numVertices, remap, &offsets, &corners );
+
+	resultNormals->resize( numVertices );
+	parallelFor( numVertices, sMinElementsPerThread, [&]( size_t begin, size_t end ) {
+		for( size_t v = begin; v < end; ++v ) {
+			if( remap && remap[v] != v )
+				continue;
+
+			vec3 normal( 0 );
+			for( uint32_t c = offsets[v]; c < offsets[v + 1]; ++c ) {
+				const size_t triangle = corners[c] / 3;
+				if( weighting == NormalWeighting::ANGLE ) {
+					const size_t corner = corners[c] % 3;
+					const vec3 &p = positions[indices[corners[c]]];
+					vec3 a = positions[indices[triangle * 3 + ( corner + 1 ) % 3]] - p;
+					vec3 b = positions[indices[triangle * 3 + ( corner + 2 ) % 3]] - p;
+					float lengths = sqrt( length2( a ) * length2( b ) );
+					if( lengths > 0 )
+						normal += triangleNormals[triangle] * acos( glm::clamp( dot( a, b ) / lengths, -1.0f, 1.0f ) );
+				}
+				else
+					normal += triangleNormals[triangle];
+			}
+
+			float len = length2( normal );
+			(*resultNormals)[v] = ( len > 0 ) ? normal / sqrt( len ) : vec3( 0 );
+		}
+	} );
+
+	// welded vertices share the normal of the vertex they were welded to. Those vertices are only read, as other threads may be reading them too.
+	if( remap ) {
+		parallelFor( numVertices, sMinElementsPerThread, [&]( size_t begin, size_t end ) {
+			for( size_t v = begin; v < end; ++v ) {
+				if( remap[v] != v )
+					(*resultNormals)[v] = (*resultNormals)[remap[v]];
+			}
+		} );
+	}
+}
 
-		const vec2 &w0 = vec2( texCoords[index0] );
-		const vec2 &w1 = vec2( texCoords[index1] );
-		const vec2 &w2 = vec2( texCoords[index2] );
+///////////////////////////////////////////////////////////////////////////////////////
+// Mesh optimization
+namespace {
 
-		float x1 = v1.x - v0.x;
-		float x2 = v2.x - v0.x;
-		float y1 = v1.y - v0.y;
-		float y2 = v2.y - v0.y;
-		float z1 = v1.z - v0.z;
-		float z2 = v2.z - v0.z;
+// Models a FIFO cache: vertex v is cached when it was inserted fewer than cacheSize misses ago. Returns the number of misses caused by triangle \a tri.
+inline uint32_t updateFifoCache( const uint32_t *tri, size_t cacheSize, vector<size_t> &timestamps, size_t &time )
+{
+	uint32_t misses = 0;
+	for( int i = 0; i < 3; ++i ) {
+		if( time - timestamps[tri[i]] > cacheSize ) {
+			timestamps[tri[i]] = time++;
+			++misses;
+		}
+	}
+	return misses;
+}
 
-		float s1 = w1.x - w0.x;
-		float s2 = w2.x - w0.x;
-		float t1 = w1.y - w0.y;
-		float t2 = w2.y - w0.y;
+// Sander, Pedro V., Diego Nehab and Joshua Barczak. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw". SIGGRAPH 2007.
+void optimizeVertexCacheTipsify( size_t numIndices, const uint32_t *indices, size_t numVertices, size_t cacheSize, vector<uint32_t> *result )
+{
+	vector<uint32_t> offsets, corners;
+	buildVertexCorners( numIndices, indices, numVertices, nullptr, &offsets, &corners );
 
-		float r = (s1 * t2 - s2 * t1);
-		if( r != 0.0f ) r = 1.0f / r;
+	vector<uint32_t> liveTriangles( numVertices );
+	for( size_t v = 0; v < numVertices; ++v )
+		liveTriangles[v] = offsets[v + 1] - offsets[v];
+
+	vector<size_t> timestamps( numVertices, 0 );
+	size_t time = cacheSize + 1;
+	vector<bool> emitted( numIndices / 3, false );
+	vector<uint32_t> deadEndStack, candidates;
+	uint32_t cursor = 0;
+
+	result->clear();
+	result->reserve( numIndices );
+	int64_t fanningVertex = numVertices ? 0 : -1;
+	while( fanningVertex >= 0 ) {
+		// emit all remaining triangles around the fanning vertex
+		candidates.clear();
+		for( uint32_t c = offsets[fanningVertex]; c < offsets[fanningVertex + 1]; ++c ) {
+			const uint32_t triangle = corners[c] / 3;
+			if( emitted[triangle] )
+				continue;
+			emitted[triangle] = true;
+
+			const uint32_t *tri = &indices[triangle * 3];
+			result->insert( result->end(), tri, tri + 3 );
+			for( int i = 0; i < 3; ++i ) {
+				deadEndStack.push_back( tri[i] );
+				candidates.push_back( tri[i] );
+				liveTriangles[tri[i]]--;
+			}
+			updateFifoCache( tri, cacheSize, timestamps, time );
+		}
 
-		vec3 tangent( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
+		// continue with the candidate that is oldest in the cache but still won't be evicted while its remaining triangles are emitted
+		fanningVertex = -1;
+		int64_t bestPriority = -1;
+		for( uint32_t v : candidates ) {
+			if( liveTriangles[v] == 0 )
+				continue;
+			int64_t priority = 0;
+			if( time - timestamps[v] + 2 * liveTriangles[v] <= cacheSize )
+				priority = time - timestamps[v];
+			if( priority > bestPriority ) {
+				bestPriority = priority;
+				fanningVertex = v;
+			}
+		}
 
-		(*resultTangents)[index0] += tangent;
-		(*resultTangents)[index1] += tangent;
-		(*resultTangents)[index2] += tangent;
+		// at a dead end, fall back to recently used vertices and then to input order
+		while( fanningVertex < 0 && ! deadEndStack.empty() ) {
+			uint32_t v = deadEndStack.back();
+			deadEndStack.pop_back();
+			if( liveTriangles[v] > 0 )
+				fanningVertex = v;
+		}
+		while( fanningVertex < 0 && cursor < numVertices ) {
+			if( liveTriangles[cursor] > 0 )
+				fanningVertex = cursor;
+			++cursor;
+		}
 	}
+}
 
-	for( size_t i = 0; i < numVertices; ++i ) {
-		vec3 normal = normals[i];
-		vec3 tangent = (*resultTangents)[i];
-		(*resultTangents)[i] = ( tangent - normal * dot( normal, tangent ) );
+// Forsyth, Tom. "Linear-Speed Vertex Cache Optimisation". 2006. https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+void optimizeVertexCacheForsyth( size_t numIndices, const uint32_t *indices, size_t numVertices, size_t cacheSize, vector<uint32_t> *result )
+{
+	const size_t numTriangles = numIndices / 3;
+	cacheSize = std::max<size_t>( cacheSize, 4 );
 
-		float len = length2( (*resultTangents)[i] );
-		if( len > 0.0f )
-			(*resultTangents)[i] /= sqrt( len );
+	// scores for a vertex's position in the LRU cache, where the vertices of the last triangle are deliberately not preferred over the next few,
+	// and for the number of triangles still using it, which favors finishing off vertices
+	vector<float> cacheScores( cacheSize );
+	for( size_t i = 0; i < cacheSize; ++i )
+		cacheScores[i] = ( i < 3 ) ? 0.75f : pow( 1.0f - float( i - 3 ) / float( cacheSize - 3 ), 1.5f );
+	auto vertexScore = [&]( int cachePosition, uint32_t liveTriangles ) -> float {
+		if( liveTriangles == 0 )
+			return -1;
+		float score = ( cachePosition >= 0 ) ? cacheScores[cachePosition] : 0;
+		return score + 2.0f / sqrt( (float)liveTriangles );
+	};
+
+	// the live triangles of vertex v are kept in triangles[offsets[v]] through triangles[offsets[v] + liveTriangles[v] - 1]
+	vector<uint32_t> offsets, triangles;
+	buildVertexCorners( numIndices, indices, numVertices, nullptr, &offsets, &triangles );
+	for( auto &t : triangles )
+		t /= 3;
+	vector<uint32_t> liveTriangles( numVertices );
+	vector<float> vertexScores( numVertices );
+	for( size_t v = 0; v < numVertices; ++v ) {
+		liveTriangles[v] = offsets[v + 1] - offsets[v];
+		vertexScores[v] = vertexScore( -1, liveTriangles[v] );
+	}
+
+	vector<float> triangleScores( numTriangles );
+	vector<bool> emitted( numTriangles, false );
+	int64_t bestTriangle = -1;
+	float bestScore = -1;
+	for( size_t t = 0; t < numTriangles; ++t ) {
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+		if( triangleScores[t] > bestScore ) {
+			bestScore = triangleScores[t];
+			bestTriangle = (int64_t)t;
+		}
 	}
 
-	if( resultBitangents ) {
-		resultBitangents->reserve( numVertices );
-		for( size_t i = 0; i < numVertices; ++i )
-			resultBitangents->emplace_back( normalize( cross( normals[i], (*resultTangents)[i] ) ) );
+	vector<uint32_t> cache, nextCache;
+	size_t cursor = 0;
+	result->clear();
+	result->reserve( numIndices );
+	for( size_t numEmitted = 0; numEmitted < numTriangles; ++numEmitted ) {
+		// none of the cached vertices has live triangles; continue in input order
+		if( bestTriangle < 0 ) {
+			while( emitted[cursor] )
+				++cursor;
+			bestTriangle = (int64_t)cursor;
+		}
+
+		const uint32_t *tri = &indices[bestTriangle * 3];
+		result->insert( result->end(), tri, tri + 3 );
+		emitted[bestTriangle] = true;
+
+		// remove the triangle from its vertices and move them to the front of the cache
+		nextCache.assign( tri, tri + 3 );
+		for( int i = 0; i < 3; ++i ) {
+			uint32_t *live = &triangles[offsets[tri[i]]];
+			uint32_t &numLive = liveTriangles[tri[i]];
+			*std::find( live, live + numLive, (uint32_t)bestTriangle ) = live[numLive - 1];
+			--numLive;
+		}
+		for( uint32_t v : cache ) {
+			if( v != tri[0] && v != tri[1] && v != tri[2] )
+				nextCache.push_back( v );
+		}
+
+		// rescore the vertices that entered, moved within or left the cache, and the triangles using them
+		for( size_t i = 0; i < nextCache.size(); ++i )
+			vertexScores[nextCache[i]] = vertexScore( ( i < cacheSize ) ? (int)i : -1, liveTriangles[nextCache[i]] );
+		bestTriangle = -1;
+		bestScore = -1;
+		for( uint32_t v : nextCache ) {
+			for( uint32_t c = offsets[v]; c < offsets[v] + liveTriangles[v]; ++c ) {
+				const uint32_t t = triangles[c];
+				triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				if( triangleScores[t] > bestScore ) {
+					bestScore = triangleScores[t];
+					bestTriangle = t;
+				}
+			}
+		}
+
+		if( nextCache.size() > cacheSize )
+			nextCache.resize( cacheSize );
+		cache.swap( nextCache );
 	}
 }
 
 } // anonymous namespace
 
-void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec2 *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
+VertexCacheStats simulateVertexCache( size_t numIndices, const uint32_t *indices, size_t numVertices, size_t cacheSize )
 {
-	calculateTangentsImpl( numIndices, indices, numVertices, positions, normals, texCoords, resultTangents, resultBitangents );
+	const size_t numTriangles = numIndices / 3;
+	vector<size_t> timestamps( numVertices, 0 );
+	size_t time = cacheSize + 1;
+	size_t misses = 0;
+	for( size_t t = 0; t < numTriangles; ++t )
+		misses += updateFifoCache( &indices[t * 3], cacheSize, timestamps, time );
+
+	size_t numReferenced = 0;
+	for( size_t v = 0; v < numVertices; ++v )
+		numReferenced += timestamps[v] != 0;
+
+	return VertexCacheStats( misses, numTriangles ? misses / (float)numTriangles : 0, numReferenced ? misses / (float)numReferenced : 0 );
 }
 
-void calculateTangents( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vec3 *normals, const vec3 *texCoords, vector<vec3> *resultTangents, vector<vec3> *resultBitangents )
+void optimizeVertexCache( size_t numIndices, const uint32_t *indices, size_t numVertices, vector<uint32_t> *resultIndices, VertexCacheMethod method, size_t cacheSize )
 {
-	calculateTangentsImpl( numIndices, indices, numVertices, positions, normals, texCoords, resultTangents, resultBitangents );
+	vector<uint32_t> result;
+	if( method == VertexCacheMethod::FORSYTH )
+		optimizeVertexCacheForsyth( numIndices - numIndices % 3, indices, numVertices, cacheSize, &result );
+	else
+		optimizeVertexCacheTipsify( numIndices - numIndices % 3, indices, numVertices, cacheSize, &result );
+
+	resultIndices->swap( result );
+}
+
+void optimizeOverdraw( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, vector<uint32_t> *resultIndices, float threshold, size_t cacheSize )
+{
+	const size_t numTriangles = numIndices / 3;
+	if( numTriangles == 0 ) {
+		resultIndices->clear();
+		return;
+	}
+
+	// split into clusters where the cache would have been cold anyway, which is where every vertex of a triangle misses
+	vector<size_t> timestamps( numVertices, 0 );
+	size_t time = cacheSize + 1;
+	vector<uint32_t> hardBoundaries( 1, 0 );
+	size_t meshMisses = 0;
+	for( size_t t = 0; t < numTriangles; ++t ) {
+		uint32_t misses = updateFifoCache( &indices[t * 3], cacheSize, timestamps, time );
+		if( misses == 3 && t > 0 )
+			hardBoundaries.push_back( (uint32_t)t );
+		meshMisses += misses;
+	}
+	hardBoundaries.push_back( (uint32_t)numTriangles );
+
+	// further split as soon as a cluster, starting with a cold cache, is within threshold of the mesh's cache miss ratio
+	const float clusterThreshold = threshold * meshMisses / (float)numTriangles;
+	vector<uint32_t> clusters; // start triangle of each cluster
+	for( size_t h = 0; h + 1 < hardBoundaries.size(); ++h ) {
+		clusters.push_back( hardBoundaries[h] );
+		time += cacheSize + 1;
+		size_t clusterStart = hardBoundaries[h], clusterMisses = 0;
+		for( size_t t = hardBoundaries[h]; t < hardBoundaries[h + 1]; ++t ) {
+			clusterMisses += updateFifoCache( &indices[t * 3], cacheSize, timestamps, time );
+			if( t + 1 < hardBoundaries[h + 1] && clusterMisses <= clusterThreshold * ( t + 1 - clusterStart ) ) {
+				clusters.push_back( (uint32_t)( t + 1 ) );
+				time += cacheSize + 1;
+				clusterStart = t + 1;
+				clusterMisses = 0;
+			}
+		}
+	}
+	clusters.push_back( (uint32_t)numTriangles );
+
+	// sort clusters by how far out along their normal they lie from the center of the mesh, so that outer surfaces are drawn first and occlude the rest
+	vec3 meshCentroid( 0 );
+	for( size_t i = 0; i < numTriangles * 3; ++i )
+		meshCentroid += positions[indices[i]];
+	meshCentroid /= (float)( numTriangles * 3 );
+
+	const size_t numClusters = clusters.size() - 1;
+	vector<float> sortKeys( numClusters );
+	parallelFor( numClusters, sMinElementsPerThread / 64, [&]( size_t begin, size_t end ) {
+		for( size_t c = begin; c < end; ++c ) {
+			vec3 centroid( 0 ), normal( 0 );
+			float area = 0;
+			for( size_t t = clusters[c]; t < clusters[c + 1]; ++t ) {
+				const vec3 &p0 = positions[indices[t * 3 + 0]];
+				const vec3 &p1 = positions[indices[t * 3 + 1]];
+				const vec3 &p2 = positions[indices[t * 3 + 2]];
+				vec3 n = cross( p1 - p0, p2 - p0 );
+				float a = length( n );
+				centroid += ( p0 + p1 + p2 ) * ( a / 3 );
+				normal += n;
+				area += a;
+			}
+			float normalLength = length( normal );
+			sortKeys[c] = ( area > 0 && normalLength > 0 ) ? dot( centroid / area - meshCentroid, normal / normalLength ) : 0;
+		}
+	} );
+
+	vector<uint32_t> order( numClusters );
+	for( size_t c = 0; c < numClusters; ++c )
+		order[c] = (uint32_t)c;
+	std::stable_sort( order.begin(), order.end(), [&sortKeys]( uint32_t a, uint32_t b ) { return sortKeys[a] > sortKeys[b]; } );
+
+	vector<uint32_t> result;
+	result.reserve( numTriangles * 3 );
+	for( uint32_t c : order )
+		result.insert( result.end(), indices + clusters[c] * 3, indices + clusters[c + 1] * 3 );
+	resultIndices->swap( result );
+}
+
+size_t optimizeVertexFetch( size_t numIndices, uint32_t *indices, size_t numVertices, vector<uint32_t> *resultRemap )
+{
+	resultRemap->assign( numVertices, ~0u );
+	uint32_t next = 0;
+	for( size_t i = 0; i < numIndices; ++i ) {
+		uint32_t &newIndex = (*resultRemap)[indices[i]];
+		if( newIndex == ~0u )
+			newIndex = next++;
+		indices[i] = newIndex;
+	}
+
+	const size_t numReferenced = next;
+	for( size_t v = 0; v < numVertices; ++v ) {
+		if( (*resultRemap)[v] == ~0u )
+			(*resultRemap)[v] = next++;
+	}
+
+	return numReferenced;
+}
+
+void remapVertexData( size_t numVertices, uint8_t dims, const uint32_t *remap, float *data )
+{
+	vector<float> source( data, data + numVertices * dims );
+	for( size_t v = 0; v < numVertices; ++v )
+		std::copy_n( &source[v * dims], dims, &data[remap[v] * dims] );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -603,6 +1076,94 @@ Primitive Target::determineCombinedPrimitive( Primitive a, Primitive b )
 		return Primitive::NUM_PRIMITIVES;
 }
 
+namespace {
+
+// Receives an attribute generated by a Source, writing it directly into the storage of the Target when it provides some via getAttribStorage(),
+// and otherwise into temporary storage that commit() copies into the Target. A disabled AttribWriter has no storage and commit() does nothing.
+class AttribWriter {
+  public:
+	AttribWriter( Target *target, Attrib attr, uint8_t dims, size_t count, bool enabled = true, bool direct = true )
+		: mTarget( target ), mAttr( attr ), mDims( dims ), mCount( count ), mData( nullptr ), mStrideBytes( 0 )
+	{
+		if( ! enabled )
+			return;
+
+		if( direct )
+			mData = reinterpret_cast<uint8_t*>( target->getAttribStorage( attr, dims, count, &mStrideBytes ) );
+		if( ! mData ) {
+			mTemporary.reset( new float[dims * count] );
+			mData = reinterpret_cast<uint8_t*>( mTemporary.get() );
+			mStrideBytes = dims * sizeof(float);
+		}
+	}
+
+	bool	isEnabled() const { return mData != nullptr; }
+
+	//! Returns the value of \a vertex as a T, which must have the AttribWriter's dimensions
+	template<typename T>
+	T&		at( size_t vertex ) { return *reinterpret_cast<T*>( mData + vertex * mStrideBytes ); }
+
+	//! Returns the tightly packed values when they're written to temporary storage rather than the Target, otherwise \c nullptr
+	template<typename T>
+	const T*	getTemporaryData() const { return reinterpret_cast<const T*>( mTemporary.get() ); }
+
+	void	commit()
+	{
+		if( mTemporary )
+			mTarget->copyAttrib( mAttr, mDims, 0, mTemporary.get(), mCount );
+	}
+
+  private:
+	Target						*mTarget;
+	Attrib						mAttr;
+	uint8_t						mDims;
+	size_t						mCount;
+	uint8_t						*mData;
+	size_t						mStrideBytes;
+	std::unique_ptr<float[]>	mTemporary;
+};
+
+// The attributes of a parametric primitive such as Sphere, and its tangents when requested. calculateTangents() requires tightly packed positions,
+// normals and tex coords, so those are only written directly into the Target when tangents aren't requested.
+struct PrimitiveAttribWriters {
+	PrimitiveAttribWriters( Target *target, const AttribSet &requestedAttribs, size_t numVertices, bool hasColors = true )
+		: mTarget( target ), mNumVertices( numVertices ), mTangents( requestedAttribs.count( Attrib::TANGENT ) > 0 ),
+		mPositions( target, Attrib::POSITION, 3, numVertices, true, ! mTangents ),
+		mNormals( target, Attrib::NORMAL, 3, numVertices, mTangents || requestedAttribs.count( Attrib::NORMAL ), ! mTangents ),
+		mTexCoords( target, Attrib::TEX_COORD_0, 2, numVertices, mTangents || requestedAttribs.count( Attrib::TEX_COORD_0 ), ! mTangents ),
+		mColors( target, Attrib::COLOR, 3, numVertices, hasColors && requestedAttribs.count( Attrib::COLOR ) )
+	{}
+
+	//! Copies any attributes written to temporary storage into the Target, followed by the tangents calculated from \a indices if they were requested
+	void commit( const vector<uint32_t> &indices )
+	{
+		mPositions.commit();
+		mNormals.commit();
+		mTexCoords.commit();
+		mColors.commit();
+
+		if( mTangents ) {
+			vector<vec3> tangents;
+			calculateTangents( indices.size(), indices.data(), mNumVertices, mPositions.getTemporaryData<vec3>(), mNormals.getTemporaryData<vec3>(),
+								mTexCoords.getTemporaryData<vec2>(), &tangents, nullptr );
+			mTarget->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		}
+	}
+
+	Target			*mTarget;
+	size_t			mNumVertices;
+	bool			mTangents;
+	AttribWriter	mPositions, mNormals, mTexCoords, mColors;
+};
+
+// Returns the number of rows of \a rowSize vertices to give each thread generating a primitive
+size_t minRowsPerThread( size_t rowSize )
+{
+	return std::max<size_t>( sMinElementsPerThread / std::max<size_t>( rowSize, 1 ), 1 );
+}
+
+} // anonymous namespace
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // Rect
 
@@ -1233,20 +1794,18 @@ void Icosphere::calculate() const
 	// subdivide all triangles
 	subdivide();
 
-	// spherize
-	for( auto &pos : mPositions )
-		pos = normalize( pos );
-	for( auto &normal : mNormals )
-		normal = normalize( normal );
-
-	// add color if necessary
+	// spherize and add color if necessary
 	size_t numPositions = mPositions.size();
 	mColors.resize( numPositions );
-	for( size_t i = 0; i < numPositions; ++i ) {
-		mColors[i].x = mPositions[i].x * 0.5f + 0.5f;
-		mColors[i].y = mPositions[i].y * 0.5f + 0.5f;
-		mColors[i].z = mPositions[i].z * 0.5f + 0.5f;
-	}
+	parallelFor( numPositions, sMinElementsPerThread, [this]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			mPositions[i] = normalize( mPositions[i] );
+			mNormals[i] = normalize( mNormals[i] );
+			mColors[i].x = mPositions[i].x * 0.5f + 0.5f;
+			mColors[i].y = mPositions[i].y * 0.5f + 0.5f;
+			mColors[i].z = mPositions[i].z * 0.5f + 0.5f;
+		}
+	} );
 
 	// calculate texture coords based on equirectangular texture map
 	calculateImplUV();
@@ -1258,11 +1817,13 @@ void Icosphere::calculateImplUV() const
 {
 	// calculate texture coords
 	mTexCoords.resize( mNormals.size(), vec2() );
-	for( size_t i = 0; i < mNormals.size(); ++i ) {
-		const vec3 &normal = mNormals[i];
-		mTexCoords[i].x = 0.5f - 0.5f * glm::atan( normal.x, -normal.z ) / float( M_PI );
-		mTexCoords[i].y = 1.0f - glm::acos( normal.y ) / float( M_PI );
-	}
+	parallelFor( mNormals.size(), sMinElementsPerThread, [this]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			const vec3 &normal = mNormals[i];
+			mTexCoords[i].x = 0.5f - 0.5f * glm::atan( normal.x, -normal.z ) / float( M_PI );
+			mTexCoords[i].y = 1.0f - glm::acos( normal.y ) / float( M_PI );
+		}
+	} );
 
 	// lambda closure to easily add a vertex with unique texture coordinate to our mesh
 	auto addVertex = [&] ( size_t i, const vec2 &uv ) {
@@ -1296,46 +1857,52 @@ void Icosphere::calculateImplUV() const
 void Icosphere::subdivide() const
 {
 	for( int j = 0; j < mSubdivision; ++j ) {
-		mPositions.reserve( mPositions.size() + mIndices.size() );
-		mNormals.reserve( mNormals.size() + mIndices.size() );
-		mIndices.reserve( mIndices.size() * 4 );
-
+		// every triangle is split into four, and adds three vertices at the midpoints of its edges. Triangle i is replaced by its first quarter,
+		// and its new vertices and the other three quarters are written at offsets determined by i, so the triangles are split in parallel
 		const size_t numTriangles = mIndices.size() / 3;
-		for( uint32_t i = 0; i < numTriangles; ++i ) {
-			uint32_t index0 = mIndices[i * 3 + 0];
-			uint32_t index1 = mIndices[i * 3 + 1];
-			uint32_t index2 = mIndices[i * 3 + 2];
-
-			uint32_t index3 = (uint32_t)mPositions.size();
-			uint32_t index4 = index3 + 1;
-			uint32_t index5 = index4 + 1;
-
-			// add new triangles
-			mIndices[i * 3 + 1] = index3;
-			mIndices[i * 3 + 2] = index5;
-
-			mIndices.push_back( index3 );
-			mIndices.push_back( index1 );
-			mIndices.push_back( index4 );
-
-			mIndices.push_back( index5 );
-			mIndices.push_back( index3 );
-			mIndices.push_back( index4 );
-
-			mIndices.push_back( index5 );
-			mIndices.push_back( index4 );
-			mIndices.push_back( index2 );
-
-			// add new positions
-			mPositions.push_back( 0.5f * (mPositions[index0] + mPositions[index1]) );
-			mPositions.push_back( 0.5f * (mPositions[index1] + mPositions[index2]) );
-			mPositions.push_back( 0.5f * (mPositions[index2] + mPositions[index0]) );
-
-			// add new normals
-			mNormals.push_back( 0.5f * (mNormals[index0] + mNormals[index1]) );
-			mNormals.push_back( 0.5f * (mNormals[index1] + mNormals[index2]) );
-			mNormals.push_back( 0.5f * (mNormals[index2] + mNormals[index0]) );
-		}
+		const size_t numPositions = mPositions.size();
+		mPositions.resize( numPositions + numTriangles * 3 );
+		mNormals.resize( numPositions + numTriangles * 3 );
+		mIndices.resize( numTriangles * 12 );
+
+		parallelFor( numTriangles, sMinElementsPerThread / 4, [&]( size_t beginTriangle, size_t endTriangle ) {
+			for( size_t i = beginTriangle; i < endTriangle; ++i ) {
+				uint32_t index0 = mIndices[i * 3 + 0];
+				uint32_t index1 = mIndices[i * 3 + 1];
+				uint32_t index2 = mIndices[i * 3 + 2];
+
+				uint32_t index3 = (uint32_t)( numPositions + i * 3 );
+				uint32_t index4 = index3 + 1;
+				uint32_t index5 = index4 + 1;
+
+				// add new triangles
+				mIndices[i * 3 + 1] = index3;
+				mIndices[i * 3 + 2] = index5;
+
+				uint32_t *indices = &mIndices[numTriangles * 3 + i * 9];
+				indices[0] = index3;
+				indices[1] = index1;
+				indices[2] = index4;
+
+				indices[3] = index5;
+				indices[4] = index3;
+				indices[5] = index4;
+
+				indices[6] = index5;
+				indices[7] = index4;
+				indices[8] = index2;
+
+				// add new positions
+				mPositions[index3] = 0.5f * (mPositions[index0] + mPositions[index1]);
+				mPositions[index4] = 0.5f * (mPositions[index1] + mPositions[index2]);
+				mPositions[index5] = 0.5f * (mPositions[index2] + mPositions[index0]);
+
+				// add new normals
+				mNormals[index3] = 0.5f * (mNormals[index0] + mNormals[index1]);
+				mNormals[index4] = 0.5f * (mNormals[index1] + mNormals[index2]);
+				mNormals[index5] = 0.5f * (mNormals[index2] + mNormals[index0]);
+			}
+		} );
 	}
 }
 
@@ -1907,68 +2474,61 @@ void Sphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 	int numRings, numSegments;
 	numRingsAndSegments( &numRings, &numSegments );
 
-	std::vector<vec3> positions;
-	std::vector<vec2> texCoords;
-	std::vector<vec3> normals;
-	std::vector<vec3> colors;
-	std::vector<uint32_t> indices;
-
-	positions.resize( numSegments * numRings );
-	normals.resize( numSegments * numRings );
-	texCoords.resize( numSegments * numRings );
-	colors.resize( numSegments * numRings );
-	indices.resize( (numSegments - 1) * (numRings - 1) * 6 );
+	PrimitiveAttribWriters attribs( target, requestedAttribs, numSegments * numRings );
+	std::vector<uint32_t> indices( (numSegments - 1) * (numRings - 1) * 6 );
 
 	float ringIncr = 1.0f / (float)( numRings - 1 );
 	float segIncr = 1.0f / (float)( numSegments - 1 );
 	float radius = mRadius;
 
-	auto vertIt = positions.begin();
-	auto normIt = normals.begin();
-	auto texIt = texCoords.begin();
-	auto colorIt = colors.begin();
-	for( int r = 0; r < numRings; r++ ) {
-		float v = r * ringIncr;
-		for( int s = 0; s < numSegments; s++ ) {
-			float u = 1.0f - s * segIncr;
-			float x = math<float>::sin( float(M_PI * 2) * u ) * math<float>::sin( float(M_PI) * v );
-			float y = math<float>::sin( float(M_PI) * (v - 0.5f) );
-			float z = math<float>::cos( float(M_PI * 2) * u ) * math<float>::sin( float(M_PI) * v );
-
-			*vertIt++ = vec3( x * radius + mCenter.x, y * radius + mCenter.y, z * radius + mCenter.z );
-
-			*normIt++ = vec3( x, y, z );
-			*texIt++ = vec2( u, v );
-			*colorIt++ = vec3( x * 0.5f + 0.5f, y * 0.5f + 0.5f, z * 0.5f + 0.5f );
+	// the angles of the segments are the same for every ring, so their sines and cosines are only calculated once
+	vector<float> segmentSin( numSegments ), segmentCos( numSegments );
+	for( int s = 0; s < numSegments; s++ ) {
+		float u = 1.0f - s * segIncr;
+		segmentSin[s] = math<float>::sin( float(M_PI * 2) * u );
+		segmentCos[s] = math<float>::cos( float(M_PI * 2) * u );
+	}
+
+	parallelFor( numRings, minRowsPerThread( numSegments ), [&]( size_t beginRing, size_t endRing ) {
+		for( size_t r = beginRing; r < endRing; r++ ) {
+			const float v = r * ringIncr;
+			const float ringSin = math<float>::sin( float(M_PI) * v );
+			const float y = math<float>::sin( float(M_PI) * (v - 0.5f) );
+			const size_t first = r * numSegments;
+
+			for( int s = 0; s < numSegments; s++ )
+				attribs.mPositions.at<vec3>( first + s ) = vec3( segmentSin[s] * ringSin * radius + mCenter.x, y * radius + mCenter.y, segmentCos[s] * ringSin * radius + mCenter.z );
+			if( attribs.mNormals.isEnabled() ) {
+				for( int s = 0; s < numSegments; s++ )
+					attribs.mNormals.at<vec3>( first + s ) = vec3( segmentSin[s] * ringSin, y, segmentCos[s] * ringSin );
+			}
+			if( attribs.mTexCoords.isEnabled() ) {
+				for( int s = 0; s < numSegments; s++ )
+					attribs.mTexCoords.at<vec2>( first + s ) = vec2( 1.0f - s * segIncr, v );
+			}
+			if( attribs.mColors.isEnabled() ) {
+				for( int s = 0; s < numSegments; s++ )
+					attribs.mColors.at<vec3>( first + s ) = vec3( segmentSin[s] * ringSin * 0.5f + 0.5f, y * 0.5f + 0.5f, segmentCos[s] * ringSin * 0.5f + 0.5f );
+			}
 		}
-	}
-
-	auto indexIt = indices.begin();
-	for( int r = 0; r < numRings - 1; r++ ) {
-		for( int s = 0; s < numSegments - 1 ; s++ ) {
-			*indexIt++ = (uint32_t)(r * numSegments + ( s + 1 ));
-			*indexIt++ = (uint32_t)(r * numSegments + s);
-			*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + ( s + 1 ));
-
-			*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + s);
-			*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + ( s + 1 ));
-			*indexIt++ = (uint32_t)(r * numSegments + s);
+	} );
+
+	parallelFor( numRings - 1, minRowsPerThread( numSegments ), [&]( size_t beginRing, size_t endRing ) {
+		auto indexIt = indices.begin() + beginRing * (numSegments - 1) * 6;
+		for( size_t r = beginRing; r < endRing; r++ ) {
+			for( int s = 0; s < numSegments - 1 ; s++ ) {
+				*indexIt++ = (uint32_t)(r * numSegments + ( s + 1 ));
+				*indexIt++ = (uint32_t)(r * numSegments + s);
+				*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + ( s + 1 ));
+
+				*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + s);
+				*indexIt++ = (uint32_t)(( r + 1 ) * numSegments + ( s + 1 ));
+				*indexIt++ = (uint32_t)(r * numSegments + s);
+			}
 		}
-	}
-	
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
-
-	if( requestedAttribs.count( geom::TANGENT ) ) {
-		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
-	}
+	} );
 
+	attribs.commit( indices );
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
 }
 
@@ -2158,61 +2718,6 @@ size_t Torus::getNumIndices() const
 	return (mNumAxis - 1) * (mNumRings - 1) * 6;
 }
 
-void Torus::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
-{
-	positions->reserve( mNumAxis * mNumRings );
-	normals->reserve( mNumAxis * mNumRings );
-	texCoords->reserve( mNumAxis * mNumRings );
-	if( colors )
-		colors->reserve( mNumAxis * mNumRings );
-	indices->reserve( (mNumAxis - 1) * (mNumRings - 1) * 6 );
-
-	float majorIncr = 1.0f / (mNumAxis - 1);
-	float minorIncr = 1.0f / (mNumRings - 1);
-	float radiusDiff = mRadiusMajor - mRadiusMinor;
-	float angle = float(M_PI * 2) * mCoils;
-	float twist = angle * mTwist * minorIncr * majorIncr;
-
-	// vertex, normal, tex coord and color buffers
-	for( int i = 0; i < mNumAxis; ++i ) {
-		float phi = i * majorIncr * angle;
-		float cosPhi = -math<float>::cos( phi );
-		float sinPhi =  math<float>::sin( phi );
-
-		for( int j = 0; j < mNumRings; ++j ) {
-			float theta = j * minorIncr * float(M_PI * 2) + i * twist + mTwistOffset;
-			float cosTheta = -math<float>::cos( theta );
-			float sinTheta =  math<float>::sin( theta );
-
-			float r = mRadiusMinor + cosTheta * radiusDiff;
-			float x = r * cosPhi;
-			float y = i * majorIncr * mHeight + sinTheta * radiusDiff;
-			float z = r * sinPhi;
-
-			positions->emplace_back( mCenter + vec3( x, y, z ) );
-			texCoords->emplace_back( i * majorIncr, j * minorIncr );
-			normals->emplace_back( cosPhi * cosTheta, sinTheta, sinPhi * cosTheta );
-
-			const vec3 &n = normals->back();
-			if( colors )
-				colors->emplace_back( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
-		}
-	}
-
-	// index buffer
-	for( int i = 0; i < mNumAxis - 1; ++i ) {
-		for ( int j = 0; j < mNumRings - 1; ++j ) {
-			indices->push_back( (uint32_t)((i + 0) * mNumRings + (j + 0)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumRings + (j + 1)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumRings + (j + 0)) );
-
-			indices->push_back( (uint32_t)((i + 0) * mNumRings + (j + 0)) );
-			indices->push_back( (uint32_t)((i + 0) * mNumRings + (j + 1)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumRings + (j + 1)) );
-		}
-	}
-}
-
 uint8_t Torus::getAttribDims( Attrib attr ) const
 {
 	switch( attr ) {
@@ -2233,29 +2738,80 @@ AttribSet Torus::getAvailableAttribs() const
 
 void Torus::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec3> positions, normals;
-	std::vector<vec2> texCoords;
-	std::vector<vec3> colors;
-	std::vector<uint32_t> indices;
+	PrimitiveAttribWriters attribs( target, requestedAttribs, mNumAxis * mNumRings );
+	std::vector<uint32_t> indices( (mNumAxis - 1) * (mNumRings - 1) * 6 );
 
-	vector<vec3> *colorsPtr = ( requestedAttribs.count( Attrib::COLOR ) ) ? &colors : nullptr;
+	const float majorIncr = 1.0f / (mNumAxis - 1);
+	const float minorIncr = 1.0f / (mNumRings - 1);
+	const float radiusDiff = mRadiusMajor - mRadiusMinor;
+	const float angle = float(M_PI * 2) * mCoils;
+	const float twist = angle * mTwist * minorIncr * majorIncr;
 
-	calculate( &positions, &normals, &texCoords, colorsPtr, &indices );
+	// sines and cosines of the ring angles; without twist these are the same for every axis subdivision and are only calculated once
+	auto calcRingAngles = [&]( size_t i, vector<float> *cosTheta, vector<float> *sinTheta ) {
+		cosTheta->resize( mNumRings );
+		sinTheta->resize( mNumRings );
+		for( int j = 0; j < mNumRings; ++j ) {
+			float theta = j * minorIncr * float(M_PI * 2) + i * twist + mTwistOffset;
+			(*cosTheta)[j] = -math<float>::cos( theta );
+			(*sinTheta)[j] =  math<float>::sin( theta );
+		}
+	};
+	vector<float> untwistedCos, untwistedSin;
+	if( mTwist == 0 )
+		calcRingAngles( 0, &untwistedCos, &untwistedSin );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	if( requestedAttribs.count( Attrib::COLOR ) )
-		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	// vertex, normal, tex coord and color buffers
+	parallelFor( mNumAxis, minRowsPerThread( mNumRings ), [&]( size_t beginAxis, size_t endAxis ) {
+		vector<float> twistedCos, twistedSin;
+		for( size_t i = beginAxis; i < endAxis; ++i ) {
+			if( mTwist != 0 )
+				calcRingAngles( i, &twistedCos, &twistedSin );
+			const float *cosTheta = ( mTwist != 0 ) ? twistedCos.data() : untwistedCos.data();
+			const float *sinTheta = ( mTwist != 0 ) ? twistedSin.data() : untwistedSin.data();
+
+			const float phi = i * majorIncr * angle;
+			const float cosPhi = -math<float>::cos( phi );
+			const float sinPhi =  math<float>::sin( phi );
+			const float height = i * majorIncr * mHeight;
+			const size_t first = i * mNumRings;
+
+			for( int j = 0; j < mNumRings; ++j ) {
+				float r = mRadiusMinor + cosTheta[j] * radiusDiff;
+				attribs.mPositions.at<vec3>( first + j ) = mCenter + vec3( r * cosPhi, height + sinTheta[j] * radiusDiff, r * sinPhi );
+			}
+			if( attribs.mNormals.isEnabled() ) {
+				for( int j = 0; j < mNumRings; ++j )
+					attribs.mNormals.at<vec3>( first + j ) = vec3( cosPhi * cosTheta[j], sinTheta[j], sinPhi * cosTheta[j] );
+			}
+			if( attribs.mTexCoords.isEnabled() ) {
+				for( int j = 0; j < mNumRings; ++j )
+					attribs.mTexCoords.at<vec2>( first + j ) = vec2( i * majorIncr, j * minorIncr );
+			}
+			if( attribs.mColors.isEnabled() ) {
+				for( int j = 0; j < mNumRings; ++j )
+					attribs.mColors.at<vec3>( first + j ) = vec3( cosPhi * cosTheta[j] * 0.5f + 0.5f, sinTheta[j] * 0.5f + 0.5f, sinPhi * cosTheta[j] * 0.5f + 0.5f );
+			}
+		}
+	} );
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
-		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
-	}
+	// index buffer
+	parallelFor( mNumAxis - 1, minRowsPerThread( mNumRings ), [&]( size_t beginAxis, size_t endAxis ) {
+		auto indexIt = indices.begin() + beginAxis * (mNumRings - 1) * 6;
+		for( size_t i = beginAxis; i < endAxis; ++i ) {
+			for ( int j = 0; j < mNumRings - 1; ++j ) {
+				*indexIt++ = (uint32_t)((i + 0) * mNumRings + (j + 0));
+				*indexIt++ = (uint32_t)((i + 1) * mNumRings + (j + 1));
+				*indexIt++ = (uint32_t)((i + 1) * mNumRings + (j + 0));
+
+				*indexIt++ = (uint32_t)((i + 0) * mNumRings + (j + 0));
+				*indexIt++ = (uint32_t)((i + 0) * mNumRings + (j + 1));
+				*indexIt++ = (uint32_t)((i + 1) * mNumRings + (j + 1));
+			}
+		}
+	} );
 
+	attribs.commit( indices );
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
 }
 
@@ -2428,121 +2984,6 @@ size_t Cylinder::getNumIndices() const
 	return result;
 }
 
-void Cylinder::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
-{
-	positions->reserve( mNumSegments * mNumSlices );
-	normals->reserve( mNumSegments * mNumSlices );
-	texCoords->reserve( mNumSegments * mNumSlices );
-	indices->reserve( (mNumSegments - 1) * (mNumSlices - 1) * 6 );
-
-	colors->reserve( mNumSegments * mNumSlices );
-
-	const float segmentIncr = 1.0f / (mNumSegments - 1);
-	const float ringIncr = 1.0f / (mNumSlices - 1);
-	const quat axis = glm::rotation( vec3( 0, 1, 0 ), mDirection );
-
-	// vertex, normal, tex coord and color buffers
-	for( int i = 0; i < mNumSegments; ++i ) {
-		for( int j = 0; j < mNumSlices; ++j ) {
-			float cosPhi = -math<float>::cos( i * segmentIncr * float(M_PI * 2) );
-			float sinPhi =  math<float>::sin( i * segmentIncr * float(M_PI * 2) );
-
-			float r = lerp<float>( mRadiusBase, mRadiusApex, j * ringIncr );
-			float x = r * cosPhi;
-			float y = mHeight * j * ringIncr;
-			float z = r * sinPhi;
-			const vec3 n = normalize( vec3( mHeight * cosPhi, mRadiusBase - mRadiusApex, mHeight * sinPhi ) );
-
-			positions->emplace_back( mOrigin + axis * vec3( x, y, z ) );
-			texCoords->emplace_back( i * segmentIncr, 1.0f - j * ringIncr );
-			normals->emplace_back( axis * n );
-			colors->emplace_back( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
-		}
-	}
-
-	// index buffer
-	for ( int j = 0; j < mNumSlices - 1; ++j ) {
-		for( int i = 0; i < mNumSegments - 1; ++i ) {
-			indices->push_back( (uint32_t)((i + 0) * mNumSlices + (j + 0)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumSlices + (j + 0)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumSlices + (j + 1)) );
-
-			indices->push_back( (uint32_t)((i + 0) * mNumSlices + (j + 0)) );
-			indices->push_back( (uint32_t)((i + 1) * mNumSlices + (j + 1)) );
-			indices->push_back( (uint32_t)((i + 0) * mNumSlices + (j + 1)) );
-		}
-	}
-
-	// caps
-	if( mRadiusBase > 0.0f )
-		calculateCap( true, 0.0f, mRadiusBase, positions, normals, texCoords, colors, indices );
-
-	if( mRadiusApex > 0.0f )
-		calculateCap( false, mHeight, mRadiusApex, positions, normals, texCoords, colors, indices );
-}
-
-void Cylinder::calculateCap( bool flip, float height, float radius, vector<vec3> *positions, vector<vec3> *normals,
-								vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
-{
-	const size_t index = positions->size();
-	const vec3 n = flip ? -mDirection : mDirection;
-	normals->resize( index + mSubdivisionsCap * mNumSegments * 2, n );
-	colors->resize( index + mSubdivisionsCap *mNumSegments * 2, vec3( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f ) );
-
-	const quat axis = glm::rotation( vec3( 0, 1, 0 ), mDirection );
-
-	// vertices
-	const float segmentIncr = 1.0f / ( mNumSegments - 1 );
-	for( int r = 0; r < mSubdivisionsCap; ++r ) {
-		for( int i = 0; i < mNumSegments; ++i ) {
-			float cosPhi = -math<float>::cos( i * segmentIncr * float( M_PI * 2 ) );
-			float sinPhi = math<float>::sin( i * segmentIncr * float( M_PI * 2 ) );
-
-			// inner point
-			float x = ( radius * cosPhi * float( r ) ) / mSubdivisionsCap;
-			float y = height;
-			float z = ( radius * sinPhi * float( r ) ) / mSubdivisionsCap;
-
-			positions->emplace_back( mOrigin + axis * vec3( x, y, z ) );
-			texCoords->emplace_back( i * segmentIncr, 1.0f - height / mHeight );
-
-			// outer point
-			x = ( radius * cosPhi * float( r + 1 ) ) / mSubdivisionsCap;
-			y = height;
-			z = ( radius * sinPhi * float( r + 1 ) ) / mSubdivisionsCap;
-
-			positions->emplace_back( mOrigin + axis * vec3( x, y, z ) );
-			texCoords->emplace_back( i * segmentIncr, 1.0f - height / mHeight );
-		}
-	}
-
-	// index buffer
-	indices->reserve( indices->size() + 6 * mNumSegments * mSubdivisionsCap );
-
-	for( int r = 0; r < mSubdivisionsCap; ++r ) {
-		for( int i = 0; i < ( mNumSegments - 1 ); ++i ) {
-			if( flip ) {
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 0 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 2 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 3 ) );
-
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 0 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 3 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 1 ) );
-			}
-			else {
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 0 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 3 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 2 ) );
-
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 0 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 1 ) );
-				indices->push_back( (uint32_t)( index + r * mNumSegments * 2 + i * 2 + 3 ) );
-			}
-		}
-	}
-}
-
 uint8_t Cylinder::getAttribDims( Attrib attr ) const
 {
 	switch( attr ) {
@@ -2563,25 +3004,136 @@ AttribSet Cylinder::getAvailableAttribs() const
 
 void Cylinder::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	vector<vec3> positions, normals, colors;
-	vector<vec2> texCoords;
-	vector<uint32_t> indices;
-
-	calculate( &positions, &normals, &texCoords, &colors, &indices );
+	const size_t numVertices = getNumVertices();
+	PrimitiveAttribWriters attribs( target, requestedAttribs, numVertices );
+	std::vector<uint32_t> indices( getNumIndices() );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	const float segmentIncr = 1.0f / (mNumSegments - 1);
+	const float ringIncr = 1.0f / (mNumSlices - 1);
+	const quat axis = glm::rotation( vec3( 0, 1, 0 ), mDirection );
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
-		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+	// the angles of the segments are shared by the body and the caps, so their sines and cosines are only calculated once
+	vector<float> segmentCos( mNumSegments ), segmentSin( mNumSegments );
+	for( int i = 0; i < mNumSegments; ++i ) {
+		segmentCos[i] = -math<float>::cos( i * segmentIncr * float(M_PI * 2) );
+		segmentSin[i] =  math<float>::sin( i * segmentIncr * float(M_PI * 2) );
 	}
 
+	// vertex, normal, tex coord and color buffers
+	parallelFor( mNumSegments, minRowsPerThread( mNumSlices ), [&]( size_t beginSegment, size_t endSegment ) {
+		for( size_t i = beginSegment; i < endSegment; ++i ) {
+			const float cosPhi = segmentCos[i];
+			const float sinPhi = segmentSin[i];
+			const vec3 n = normalize( vec3( mHeight * cosPhi, mRadiusBase - mRadiusApex, mHeight * sinPhi ) );
+			const size_t first = i * mNumSlices;
+
+			for( int j = 0; j < mNumSlices; ++j ) {
+				float r = lerp<float>( mRadiusBase, mRadiusApex, j * ringIncr );
+				attribs.mPositions.at<vec3>( first + j ) = mOrigin + axis * vec3( r * cosPhi, mHeight * j * ringIncr, r * sinPhi );
+			}
+			if( attribs.mNormals.isEnabled() ) {
+				const vec3 normal = axis * n;
+				for( int j = 0; j < mNumSlices; ++j )
+					attribs.mNormals.at<vec3>( first + j ) = normal;
+			}
+			if( attribs.mTexCoords.isEnabled() ) {
+				for( int j = 0; j < mNumSlices; ++j )
+					attribs.mTexCoords.at<vec2>( first + j ) = vec2( i * segmentIncr, 1.0f - j * ringIncr );
+			}
+			if( attribs.mColors.isEnabled() ) {
+				const vec3 color( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
+				for( int j = 0; j < mNumSlices; ++j )
+					attribs.mColors.at<vec3>( first + j ) = color;
+			}
+		}
+	} );
+
+	// index buffer
+	parallelFor( mNumSlices - 1, minRowsPerThread( mNumSegments ), [&]( size_t beginSlice, size_t endSlice ) {
+		auto indexIt = indices.begin() + beginSlice * (mNumSegments - 1) * 6;
+		for( size_t j = beginSlice; j < endSlice; ++j ) {
+			for( int i = 0; i < mNumSegments - 1; ++i ) {
+				*indexIt++ = (uint32_t)((i + 0) * mNumSlices + (j + 0));
+				*indexIt++ = (uint32_t)((i + 1) * mNumSlices + (j + 0));
+				*indexIt++ = (uint32_t)((i + 1) * mNumSlices + (j + 1));
+
+				*indexIt++ = (uint32_t)((i + 0) * mNumSlices + (j + 0));
+				*indexIt++ = (uint32_t)((i + 1) * mNumSlices + (j + 1));
+				*indexIt++ = (uint32_t)((i + 0) * mNumSlices + (j + 1));
+			}
+		}
+	} );
+
+	// caps, each a ring of quads for every cap subdivision, with an inner and outer vertex per segment
+	size_t firstVertex = mNumSegments * mNumSlices;
+	size_t firstIndex = ( mNumSegments - 1 ) * ( mNumSlices - 1 ) * 6;
+	auto calculateCap = [&]( bool flip, float height, float radius ) {
+		const vec3 n = flip ? -mDirection : mDirection;
+		const vec3 color( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
+		const float v = 1.0f - height / mHeight;
+		const size_t index = firstVertex;
+
+		parallelFor( mSubdivisionsCap, minRowsPerThread( mNumSegments * 2 ), [&]( size_t beginRing, size_t endRing ) {
+			for( size_t r = beginRing; r < endRing; ++r ) {
+				const size_t first = index + r * mNumSegments * 2;
+				for( int i = 0; i < mNumSegments; ++i ) {
+					// inner and outer point
+					float x = ( radius * segmentCos[i] * float( r ) ) / mSubdivisionsCap;
+					float z = ( radius * segmentSin[i] * float( r ) ) / mSubdivisionsCap;
+					attribs.mPositions.at<vec3>( first + i * 2 + 0 ) = mOrigin + axis * vec3( x, height, z );
+					x = ( radius * segmentCos[i] * float( r + 1 ) ) / mSubdivisionsCap;
+					z = ( radius * segmentSin[i] * float( r + 1 ) ) / mSubdivisionsCap;
+					attribs.mPositions.at<vec3>( first + i * 2 + 1 ) = mOrigin + axis * vec3( x, height, z );
+				}
+				if( attribs.mNormals.isEnabled() ) {
+					for( int i = 0; i < mNumSegments * 2; ++i )
+						attribs.mNormals.at<vec3>( first + i ) = n;
+				}
+				if( attribs.mTexCoords.isEnabled() ) {
+					for( int i = 0; i < mNumSegments * 2; ++i )
+						attribs.mTexCoords.at<vec2>( first + i ) = vec2( ( i / 2 ) * segmentIncr, v );
+				}
+				if( attribs.mColors.isEnabled() ) {
+					for( int i = 0; i < mNumSegments * 2; ++i )
+						attribs.mColors.at<vec3>( first + i ) = color;
+				}
+
+				auto indexIt = indices.begin() + firstIndex + r * ( mNumSegments - 1 ) * 6;
+				for( int i = 0; i < ( mNumSegments - 1 ); ++i ) {
+					const uint32_t quad = (uint32_t)( first + i * 2 );
+					if( flip ) {
+						*indexIt++ = quad + 0;
+						*indexIt++ = quad + 2;
+						*indexIt++ = quad + 3;
+
+						*indexIt++ = quad + 0;
+						*indexIt++ = quad + 3;
+						*indexIt++ = quad + 1;
+					}
+					else {
+						*indexIt++ = quad + 0;
+						*indexIt++ = quad + 3;
+						*indexIt++ = quad + 2;
+
+						*indexIt++ = quad + 0;
+						*indexIt++ = quad + 1;
+						*indexIt++ = quad + 3;
+					}
+				}
+			}
+		} );
+
+		firstVertex += mNumSegments * mSubdivisionsCap * 2;
+		firstIndex += ( mNumSegments - 1 ) * mSubdivisionsCap * 6;
+	};
+
+	if( mRadiusBase > 0.0f )
+		calculateCap( true, 0.0f, mRadiusBase );
+
+	if( mRadiusApex > 0.0f )
+		calculateCap( false, mHeight, mRadiusApex );
+
+	attribs.commit( indices );
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
 }
 
@@ -2643,58 +3195,52 @@ AttribSet Plane::getAvailableAttribs() const
 
 void Plane::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec3> positions, normals;
-	std::vector<vec2> texCoords;
-	std::vector<uint32_t> indices;
-
-	const size_t numVerts = ( mSubdivisions.x + 1 ) * ( mSubdivisions.y + 1 );
-	positions.reserve( numVerts );
-	normals.reserve( numVerts );
-	texCoords.reserve( numVerts );
+	const size_t rowSize = mSubdivisions.y + 1;
+	PrimitiveAttribWriters attribs( target, requestedAttribs, ( mSubdivisions.x + 1 ) * rowSize, false );
+	std::vector<uint32_t> indices( getNumIndices() );
 
 	const vec2 stepIncr = vec2( 1, 1 ) / vec2( mSubdivisions );
 	const vec3 normal = cross( mAxisV, mAxisU );
 
 	// fill vertex data
-	for( int x = 0; x <= mSubdivisions.x; x++ ) {
-		for( int y = 0; y <= mSubdivisions.y; y++ ) {
-			float u = x * stepIncr.x;
-			float v = y * stepIncr.y;
-			positions.emplace_back( mOrigin + ( mSize.x * ( u - 0.5f ) ) * mAxisU + ( mSize.y * ( v - 0.5f ) ) * mAxisV );
-			normals.emplace_back( normal );
-			texCoords.emplace_back( u, v );
+	parallelFor( mSubdivisions.x + 1, minRowsPerThread( rowSize ), [&]( size_t beginRow, size_t endRow ) {
+		for( size_t x = beginRow; x < endRow; x++ ) {
+			const float u = x * stepIncr.x;
+			const vec3 rowOrigin = mOrigin + ( mSize.x * ( u - 0.5f ) ) * mAxisU;
+			const size_t first = x * rowSize;
+
+			for( int y = 0; y <= mSubdivisions.y; y++ )
+				attribs.mPositions.at<vec3>( first + y ) = rowOrigin + ( mSize.y * ( y * stepIncr.y - 0.5f ) ) * mAxisV;
+			if( attribs.mNormals.isEnabled() ) {
+				for( int y = 0; y <= mSubdivisions.y; y++ )
+					attribs.mNormals.at<vec3>( first + y ) = normal;
+			}
+			if( attribs.mTexCoords.isEnabled() ) {
+				for( int y = 0; y <= mSubdivisions.y; y++ )
+					attribs.mTexCoords.at<vec2>( first + y ) = vec2( u, y * stepIncr.y );
+			}
 		}
-	}
+	} );
 
 	// fill indices
-	for( int x = 0; x < mSubdivisions.x; x++ ) {
-		for( int y = 0; y < mSubdivisions.y; y++ ) {
-			const uint32_t i = x * ( mSubdivisions.y + 1 ) + y;
-
-			indices.push_back( i );
-			indices.push_back( i + 1 );
-			indices.push_back( i + mSubdivisions.y + 1 );
-
-			indices.push_back( i + mSubdivisions.y + 1 );
-			indices.push_back( i + 1 );
-			indices.push_back( i + mSubdivisions.y + 2 );
+	parallelFor( mSubdivisions.x, minRowsPerThread( rowSize ), [&]( size_t beginRow, size_t endRow ) {
+		auto indexIt = indices.begin() + beginRow * mSubdivisions.y * 6;
+		for( size_t x = beginRow; x < endRow; x++ ) {
+			for( int y = 0; y < mSubdivisions.y; y++ ) {
+				const uint32_t i = (uint32_t)( x * rowSize + y );
+
+				*indexIt++ = i;
+				*indexIt++ = i + 1;
+				*indexIt++ = i + mSubdivisions.y + 1;
+
+				*indexIt++ = i + mSubdivisions.y + 1;
+				*indexIt++ = i + 1;
+				*indexIt++ = i + mSubdivisions.y + 2;
+			}
 		}
-	}
-
-
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
+	} );
 
-	// generate tangents
-	if( requestedAttribs.count( geom::TANGENT ) ) {
-		vector<vec3> tangents;
-		calculateTangents( getNumIndices(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
-	}
-	
+	attribs.commit( indices );
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
 }
 
@@ -2710,94 +3256,116 @@ uint8_t	Transform::getAttribDims( Attrib attr, uint8_t upstreamDims ) const
 
 void Transform::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
 {
-	ctx->processUpstream( requestedAttribs );
-	
-	const size_t numVertices = ctx->getNumVertices();
+	processPerVertex( ctx, requestedAttribs );
+}
 
-	if( ctx->getAttribDims( POSITION ) == 2 ) {
+bool Transform::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
+	const uint8_t positionDims = ctx->getAttribDims( POSITION );
+	if( positionDims == 2 ) {
+		// promoting to 3D requires the final 2D positions
+		if( upstreamPending )
+			return false;
+
+		const size_t numVertices = ctx->getNumVertices();
 		const vec2* inPositions = reinterpret_cast<vec2*>( ctx->getAttribData( POSITION ) );
 		vector<vec3> outPositions;
 		outPositions.reserve( numVertices );
 		for( size_t v = 0; v < numVertices; ++v )
-			outPositions.push_back( vec3( mTransform * vec4( inPositions[v], 0, 1 ) ) );
+			outPositions.push_back( vec3( inPositions[v], 0 ) );
 		ctx->copyAttrib( POSITION, 3, 0, (const float*)outPositions.data(), numVertices );
 	}
-	else if( ctx->getAttribDims( POSITION ) == 3 ) {
+	else if( positionDims != 0 && positionDims != 3 && positionDims != 4 )
+		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Transform" );
+
+	if( ctx->getAttribDims( NORMAL ) != 0 && ctx->getAttribDims( NORMAL ) != 3 )
+		CI_LOG_W( "Unsupported dimension for geom::NORMAL passed to geom::Transform" );
+	if( ctx->getAttribDims( TANGENT ) != 0 && ctx->getAttribDims( TANGENT ) != 3 )
+		CI_LOG_W( "Unsupported dimension for geom::TANGENT passed to geom::Transform" );
+
+	return true;
+}
+
+void Transform::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	if( ctx->getAttribDims( POSITION ) == 3 ) {
 		vec3* positions = reinterpret_cast<vec3*>( ctx->getAttribData( POSITION ) );
-		for( size_t v = 0; v < numVertices; ++v )
+		for( size_t v = beginVertex; v < endVertex; ++v )
 			positions[v] = vec3( mTransform * vec4( positions[v], 1 ) );
 	}
 	else if( ctx->getAttribDims( POSITION ) == 4 ) {
 		vec4* positions = reinterpret_cast<vec4*>( ctx->getAttribData( POSITION ) );
-		for( size_t v = 0; v < numVertices; ++v )
+		for( size_t v = beginVertex; v < endVertex; ++v )
 			positions[v] = mTransform * positions[v];
 	}
-	else if( ctx->getAttribDims( POSITION ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Transform" );
 	
-	// we'll make the sort of modification to our normals (if they're present)
+	// we'll make the sort of modification to our normals and tangents (if they're present)
 	// using the inverse transpose of 'mTransform'
-	if( ctx->getAttribDims( NORMAL ) == 3 ) {
-		vec3* normals = reinterpret_cast<vec3*>( ctx->getAttribData( NORMAL ) );
-		mat3 normalsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			normals[v] = normalize( normalsTransform * normals[v] );
-	}
-	else if( ctx->getAttribDims( NORMAL ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::NORMAL passed to geom::Transform" );
-
-	// and finally, we'll make the sort of modification to our tangents (if they're present)
-	// using the inverse transpose of 'mTransform'
-	if( ctx->getAttribDims( TANGENT ) == 3 ) {
-		vec3* tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
-		mat3 tangentsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
-		for( size_t v = 0; v < numVertices; ++v )
-			tangents[v] = normalize( tangentsTransform * tangents[v] );
+	if( ctx->getAttribDims( NORMAL ) == 3 || ctx->getAttribDims( TANGENT ) == 3 ) {
+		const mat3 normalsTransform = glm::transpose( inverse( mat3( mTransform ) ) );
+		if( ctx->getAttribDims( NORMAL ) == 3 ) {
+			vec3* normals = reinterpret_cast<vec3*>( ctx->getAttribData( NORMAL ) );
+			for( size_t v = beginVertex; v < endVertex; ++v )
+				normals[v] = normalize( normalsTransform * normals[v] );
+		}
+		if( ctx->getAttribDims( TANGENT ) == 3 ) {
+			vec3* tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
+			for( size_t v = beginVertex; v < endVertex; ++v )
+				tangents[v] = normalize( normalsTransform * tangents[v] );
+		}
 	}
-	else if( ctx->getAttribDims( TANGENT ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::TANGENT passed to geom::Transform" );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
 // Twist
 void Twist::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
 {
-	ctx->processUpstream( requestedAttribs );
-	
-	const size_t numVertices = ctx->getNumVertices();
+	processPerVertex( ctx, requestedAttribs );
+}
+
+bool Twist::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
+	const uint8_t positionDims = ctx->getAttribDims( POSITION );
+	if( positionDims != 0 && positionDims != 3 && ! upstreamPending )
+		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Twist" );
+
+	return positionDims == 3;
+}
+
+void Twist::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	if( ctx->getAttribDims( POSITION ) != 3 )
+		return;
+
 	const float invAxisLength = 1.0f / distance( mAxisStart, mAxisEnd );
 	const vec3 axisDir = ( mAxisEnd - mAxisStart ) * vec3( invAxisLength );
 
-	if( ctx->getAttribDims( POSITION ) == 3 ) {
-		vec3* positions = reinterpret_cast<vec3*>( ctx->getAttribData( POSITION ) );
-		vec3* normals = nullptr, *tangents = nullptr;
-		if( ctx->getAttribDims( NORMAL ) == 3 )
-			normals = reinterpret_cast<vec3*>( ctx->getAttribData( NORMAL ) );
-		if( ctx->getAttribDims( TANGENT ) == 3 )
-			tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
-		
-		for( size_t v = 0; v < numVertices; ++v ) {
-			// find the 't' value of the point on the axis that inPosition is closest to
-			float closestDist = dot( positions[v] - mAxisStart, axisDir );
-			float tVal = glm::clamp<float>( closestDist * invAxisLength, 0, 1 );
-			// 'pointOnAxis' is the actual point on the axis inPosition is closest to
-			vec3 pointOnAxis = mAxisStart + axisDir * closestDist;
-			// our rotation is around the axis, and the angle is a lerp between 'mStartAngle' and 'mEndAngle' based on 't'
-			mat4 rotation = rotate( glm::mix( mStartAngle, mEndAngle, tVal ), axisDir );
-			// now transform the point by rotating around 'pointOnAxis'
-			mat4 transform = translate( pointOnAxis ) * rotation * translate( -pointOnAxis );
-			vec3 outPos = vec3( transform * vec4( positions[v], 1 ) );
-			positions[v] = outPos;
-			// we need to transform the normal by rotating it by the same angle (but not around the point) we did the position
-			if( normals )
-				normals[v] = vec3( rotation * vec4( normals[v], 0 ) );
-			// we need to transform the tangent by rotating it by the same angle (but not around the point) we did the position
-			if( tangents )
-				tangents[v] = vec3( rotation * vec4( tangents[v], 0 ) );
-		}
+	vec3* positions = reinterpret_cast<vec3*>( ctx->getAttribData( POSITION ) );
+	vec3* normals = nullptr, *tangents = nullptr;
+	if( ctx->getAttribDims( NORMAL ) == 3 )
+		normals = reinterpret_cast<vec3*>( ctx->getAttribData( NORMAL ) );
+	if( ctx->getAttribDims( TANGENT ) == 3 )
+		tangents = reinterpret_cast<vec3*>( ctx->getAttribData( TANGENT ) );
+	
+	for( size_t v = beginVertex; v < endVertex; ++v ) {
+		// find the 't' value of the point on the axis that inPosition is closest to
+		float closestDist = dot( positions[v] - mAxisStart, axisDir );
+		float tVal = glm::clamp<float>( closestDist * invAxisLength, 0, 1 );
+		// 'pointOnAxis' is the actual point on the axis inPosition is closest to
+		vec3 pointOnAxis = mAxisStart + axisDir * closestDist;
+		// our rotation is around the axis, and the angle is a lerp between 'mStartAngle' and 'mEndAngle' based on 't'
+		mat4 rotation = rotate( glm::mix( mStartAngle, mEndAngle, tVal ), axisDir );
+		// now transform the point by rotating around 'pointOnAxis'
+		mat4 transform = translate( pointOnAxis ) * rotation * translate( -pointOnAxis );
+		vec3 outPos = vec3( transform * vec4( positions[v], 1 ) );
+		positions[v] = outPos;
+		// we need to transform the normal by rotating it by the same angle (but not around the point) we did the position
+		if( normals )
+			normals[v] = vec3( rotation * vec4( normals[v], 0 ) );
+		// we need to transform the tangent by rotating it by the same angle (but not around the point) we did the position
+		if( tangents )
+			tangents[v] = vec3( rotation * vec4( tangents[v], 0 ) );
 	}
-	else if( ctx->getAttribDims( POSITION ) != 0 )
-		CI_LOG_W( "Unsupported dimension for geom::POSITION passed to geom::Twist" );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -2977,43 +3545,87 @@ void processColorAttrib2d( const vec2* inputData, O *outputData, const std::func
 } // anonymous namespace
 
 void ColorFromAttrib::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
+{
+	processPerVertex( ctx, requestedAttribs );
+}
+
+AttribSet ColorFromAttrib::getUpstreamAttribs( const AttribSet &requestedAttribs ) const
 {
 	AttribSet request = requestedAttribs;
 	request.insert( mAttrib );
-	ctx->processUpstream( request );
+	return request;
+}
 
+bool ColorFromAttrib::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
 	// if we have no function to apply just continue
 	if( ( ! mFnColor2 ) && ( ! mFnColor3 ) )
-		return;
+		return false;
 
-	if( ctx->getAttribDims( mAttrib ) == 0 ) {
-		CI_LOG_W( "ColorFromAttrib called on geom::Source missing requested " << attribToString( mAttrib ) );
-		return;
+	const uint8_t inputAttribDims = ctx->getAttribDims( mAttrib );
+	if( inputAttribDims < 2 || inputAttribDims > 4 ) {
+		if( ! upstreamPending )
+			CI_LOG_W( "ColorFromAttrib called on geom::Source missing requested " << attribToString( mAttrib ) );
+		return false;
+	}
+
+	const size_t numVertices = ctx->getNumVertices();
+	const uint8_t colorDims = ctx->getAttribDims( Attrib::COLOR );
+	if( colorDims != 0 && colorDims != 3 ) {
+		// replacing COLOR with a different dimension changes its layout under any pending upstream Modifiers
+		if( upstreamPending )
+			return false;
+		// and deriving the color from COLOR itself can't happen in place
+		if( mAttrib == Attrib::COLOR ) {
+			unique_ptr<float[]> colorData( new float[numVertices * 3] );
+			const float* inputAttribData = ctx->getAttribData( mAttrib );
+			if( mFnColor2 ) {
+				if( inputAttribDims == 4 )
+					processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), reinterpret_cast<Colorf*>( colorData.get() ), mFnColor2, numVertices );
+				else
+					processColorAttrib( reinterpret_cast<const vec2*>( inputAttribData ), reinterpret_cast<Colorf*>( colorData.get() ), mFnColor2, numVertices );
+			}
+			else {
+				if( inputAttribDims == 4 )
+					processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), reinterpret_cast<Colorf*>( colorData.get() ), mFnColor3, numVertices );
+				else
+					processColorAttrib2d( reinterpret_cast<const vec2*>( inputAttribData ), reinterpret_cast<Colorf*>( colorData.get() ), mFnColor3, numVertices );
+			}
+			ctx->copyAttrib( Attrib::COLOR, 3, 0, colorData.get(), numVertices );
+			return false;
+		}
 	}
 
-	const auto numVertices = ctx->getNumVertices();
-	unique_ptr<float[]> mColorData( new float[numVertices * 3] );
-	uint8_t inputAttribDims = ctx->getAttribDims( mAttrib );
-	const float* inputAttribData = ctx->getAttribData( mAttrib );
+	ctx->allocAttrib( Attrib::COLOR, 3, numVertices );
+	return true;
+}
+
+void ColorFromAttrib::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	const uint8_t inputAttribDims = ctx->getAttribDims( mAttrib );
+	if( ctx->getAttribDims( Attrib::COLOR ) != 3 )
+		return;
+
+	const size_t numVertices = endVertex - beginVertex;
+	const float* inputAttribData = ctx->getAttribData( mAttrib ) + beginVertex * inputAttribDims;
+	Colorf* colorData = reinterpret_cast<Colorf*>( ctx->getAttribData( Attrib::COLOR ) ) + beginVertex;
 	
 	if( mFnColor2 ) {
 		if( inputAttribDims == 2 )
-			processColorAttrib( reinterpret_cast<const vec2*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor2, numVertices );
+			processColorAttrib( reinterpret_cast<const vec2*>( inputAttribData ), colorData, mFnColor2, numVertices );
 		else if( inputAttribDims == 3 )
-			processColorAttrib( reinterpret_cast<const vec3*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor2, numVertices );
+			processColorAttrib( reinterpret_cast<const vec3*>( inputAttribData ), colorData, mFnColor2, numVertices );
 		else if( inputAttribDims == 4 )
-			processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor2, numVertices );
+			processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), colorData, mFnColor2, numVertices );
 	}
 	else if( mFnColor3 ) {
 		if( inputAttribDims == 2 )
-			processColorAttrib2d( reinterpret_cast<const vec2*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor3, numVertices );
-		if( inputAttribDims == 3 )
-			processColorAttrib( reinterpret_cast<const vec3*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor3, numVertices );
+			processColorAttrib2d( reinterpret_cast<const vec2*>( inputAttribData ), colorData, mFnColor3, numVertices );
+		else if( inputAttribDims == 3 )
+			processColorAttrib( reinterpret_cast<const vec3*>( inputAttribData ), colorData, mFnColor3, numVertices );
 		else if( inputAttribDims == 4 )
-			processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), reinterpret_cast<Colorf*>( mColorData.get() ), mFnColor3, numVertices );
+			processColorAttrib( reinterpret_cast<const vec4*>( inputAttribData ), colorData, mFnColor3, numVertices );
 	}
-
-	ctx->copyAttrib( Attrib::COLOR, 3, 0, mColorData.get(), numVertices );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -3035,41 +3647,34 @@ AttribSet Constant::getAvailableAttribs( const Modifier::Params &upstreamParams
 
 void Constant::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
 {
-	ctx->processUpstream( requestedAttribs );
+	processPerVertex( ctx, requestedAttribs );
+}
 
-	const size_t numVertices = ctx->getNumVertices();
-	
-	switch( mDims ) {
-		case 1: {
-			unique_ptr<float[]> mColorData( new float[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = mValue.x;
-			ctx->copyAttrib( mAttrib, 1, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 2: {
-			unique_ptr<vec2[]> mColorData( new vec2[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = vec2( mValue.x, mValue.y );
-			ctx->copyAttrib( mAttrib, 2, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 3: {
-			unique_ptr<vec3[]> mColorData( new vec3[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = vec3( mValue.x, mValue.y, mValue.z );
-			ctx->copyAttrib( mAttrib, 3, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		case 4: {
-			unique_ptr<vec4[]> mColorData( new vec4[numVertices] );
-			for( size_t v = 0; v < numVertices; ++v )
-				mColorData[v] = mValue;
-			ctx->copyAttrib( mAttrib, 4, 0, (const float*)mColorData.get(), numVertices );
-		}
-		break;
-		default:
-			CI_LOG_E( "Illegal dimensions." );
+bool Constant::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
+	if( mDims < 1 || mDims > 4 ) {
+		CI_LOG_E( "Illegal dimensions." );
+		return false;
+	}
+
+	// replacing an attribute with a different dimension changes its layout under any pending upstream Modifiers
+	const uint8_t dims = ctx->getAttribDims( mAttrib );
+	if( upstreamPending && dims != 0 && dims != mDims )
+		return false;
+
+	ctx->allocAttrib( mAttrib, mDims, ctx->getNumVertices() );
+	return true;
+}
+
+void Constant::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	if( ctx->getAttribDims( mAttrib ) != mDims )
+		return;
+
+	float *data = ctx->getAttribData( mAttrib );
+	for( size_t v = beginVertex; v < endVertex; ++v ) {
+		for( uint8_t d = 0; d < mDims; ++d )
+			data[v * mDims + d] = mValue[d];
 	}
 }
 
@@ -3106,21 +3711,46 @@ void processAttrib( const float *inputDataFloat, float *outputDataFloat, const s
 
 template<typename S, typename D>
 void geom::AttribFn<S,D>::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
+{
+	processPerVertex( ctx, requestedAttribs );
+}
+
+template<typename S, typename D>
+AttribSet geom::AttribFn<S,D>::getUpstreamAttribs( const AttribSet &requestedAttribs ) const
 {
 	AttribSet request = requestedAttribs;
 	request.insert( mSrcAttrib );
-	ctx->processUpstream( request );
+	return request;
+}
 
-	if( ctx->getAttribDims( mSrcAttrib ) == 0 ) {
-		CI_LOG_W( "AttribFn called on geom::Source missing requested " << attribToString( mSrcAttrib ) );
-		return;
+template<typename S, typename D>
+bool geom::AttribFn<S,D>::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
+	const uint8_t inputAttribDims = ctx->getAttribDims( mSrcAttrib );
+	if( inputAttribDims == 0 ) {
+		if( ! upstreamPending )
+			CI_LOG_W( "AttribFn called on geom::Source missing requested " << attribToString( mSrcAttrib ) );
+		return false;
+	}
+
+	const size_t numVertices = ctx->getNumVertices();
+	const uint8_t outputAttribDims = ctx->getAttribDims( mDstAttrib );
+	const bool inPlace = ( mSrcAttrib == mDstAttrib ) && ( SRCDIM == DSTDIM );
+	if( inputAttribDims == SRCDIM && ( inPlace || mSrcAttrib != mDstAttrib ) ) {
+		// replacing the destination with a different dimension changes its layout under any pending upstream Modifiers
+		if( upstreamPending && outputAttribDims != 0 && outputAttribDims != DSTDIM )
+			return false;
+		ctx->allocAttrib( mDstAttrib, DSTDIM, numVertices );
+		return true;
 	}
+	
+	// the source needs converting, or is replaced by a destination of a different dimension; either requires the final values
+	if( upstreamPending )
+		return false;
 
-	const auto numVertices = ctx->getNumVertices();
 	std::unique_ptr<float[]> outData( new float[numVertices * DSTDIM] );
 	std::unique_ptr<float[]> tempInData;
 	const float *inputAttribData;
-	const uint8_t inputAttribDims = ctx->getAttribDims( mSrcAttrib );
 	// if the actual input dims of the attribute don't equal SRCDIMS, we'll need to temporarily copy it to a buffer
 	if( inputAttribDims != SRCDIM ) {
 		CI_LOG_W( "AttribFn source dimensions don't match for attrib " << attribToString( mSrcAttrib ) );
@@ -3134,6 +3764,17 @@ void geom::AttribFn<S,D>::process( SourceModsContext *ctx, const AttribSet &requ
 	
 	processAttrib<S,D>( inputAttribData, outData.get(), mFn, numVertices );
 	ctx->copyAttrib( mDstAttrib, DSTDIM, 0, outData.get(), numVertices );
+	return false;
+}
+
+template<typename S, typename D>
+void geom::AttribFn<S,D>::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	if( ctx->getAttribDims( mSrcAttrib ) != SRCDIM || ctx->getAttribDims( mDstAttrib ) != DSTDIM )
+		return;
+
+	// when the source and destination are the same attribute each vertex is read before it's written
+	processAttrib<S,D>( ctx->getAttribData( mSrcAttrib ) + beginVertex * SRCDIM, ctx->getAttribData( mDstAttrib ) + beginVertex * DSTDIM, mFn, endVertex - beginVertex );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -4404,16 +5045,25 @@ void Tangents::process( SourceModsContext *ctx, const AttribSet &requestedAttrib
 // Invert
 void Invert::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
 {
-	ctx->processUpstream( requestedAttribs );
+	processPerVertex( ctx, requestedAttribs );
+}
 
+bool Invert::prepareVertices( SourceModsContext *ctx, bool upstreamPending ) const
+{
 	if( ctx->getAttribDims( mAttrib ) == 0 ) {
-		CI_LOG_W( "geom::Invert missing attrib: " << attribToString( mAttrib ) );
-		return;
+		if( ! upstreamPending )
+			CI_LOG_W( "geom::Invert missing attrib: " << attribToString( mAttrib ) );
+		return false;
 	}
-	
+
+	return true;
+}
+
+void Invert::processVertices( SourceModsContext *ctx, size_t beginVertex, size_t endVertex ) const
+{
+	const uint8_t dims = ctx->getAttribDims( mAttrib );
 	float *d = ctx->getAttribData( mAttrib );
-	size_t maxIdx = ctx->getAttribDims( mAttrib ) * ctx->getNumVertices();
-	for( size_t i = 0; i < maxIdx; ++i )
+	for( size_t i = beginVertex * dims; i < endVertex * dims; ++i )
 		d[i] = -d[i];
 	
 	// we don't need to copyAttrib() because we processed in place
@@ -4567,19 +5217,14 @@ void Subdivide::process( SourceModsContext *ctx, const AttribSet &requestedAttri
 	
 	const size_t numInVertices = ctx->getNumVertices();
 	const size_t numInIndices = ctx->getNumIndices();
-	
+	const size_t numTriangles = numInIndices / 3;
 	const uint32_t *inIndices = ctx->getIndicesData();
-	const vec3 *inPositions = reinterpret_cast<const vec3*>( ctx->getAttribData( POSITION ) );
 	
-	vector<vec3> outPositions;
+	// we add a vertex at the centroid of every triangle, which is split into 3 around it
 	vector<uint32_t> outIndices;
-	
-	for( size_t idx = 0; idx < numInIndices; idx += 3 ) {
-		vec3 sumPos = inPositions[inIndices[idx+0]] + inPositions[inIndices[idx+1]] +
-						inPositions[inIndices[idx+2]];
-		outPositions.push_back( sumPos / 3.0f );
-		
-		uint32_t newIdx = (uint32_t)(outPositions.size() + numInVertices - 1);
+	outIndices.reserve( numTriangles * 9 );
+	for( size_t idx = 0; idx < numTriangles * 3; idx += 3 ) {
+		uint32_t newIdx = (uint32_t)( numInVertices + idx / 3 );
 		// 0-new-2
 		outIndices.push_back( inIndices[idx+0] ); outIndices.push_back( newIdx ); outIndices.push_back( inIndices[idx+2] );
 		// 0-1-new
@@ -4588,39 +5233,95 @@ void Subdivide::process( SourceModsContext *ctx, const AttribSet &requestedAttri
 		outIndices.push_back( newIdx ); outIndices.push_back( inIndices[idx+1] ); outIndices.push_back( inIndices[idx+2] );
 	}
 	
-	// iterate the attributes and lerp
+	// iterate the attributes and lerp, appending the new vertices in place
 	for( const auto &attr : ctx->getAvailableAttribs() ) {
-		// we processed POSITION in the previous loop
-		if( attr == POSITION )
-			continue;
-	
-		vector<float> outData;
+		const uint8_t dims = ctx->getAttribDims( attr );
+		float *outData = ctx->extendAttrib( attr, numTriangles );
 		const float *inData = ctx->getAttribData( attr );
-		uint8_t dims = ctx->getAttribDims( attr );
-		outData.reserve( numInIndices / 3 * dims );
-		for( size_t idx = 0; idx < numInIndices; idx += 3 ) {
+		for( size_t idx = 0; idx < numTriangles * 3; idx += 3 ) {
 			for( uint8_t dim = 0; dim < dims; ++dim )
-				outData.push_back( (inData[inIndices[idx+0]*dims + dim] +
-									inData[inIndices[idx+1]*dims + dim] +
-									inData[inIndices[idx+2]*dims + dim]) / 3.0f );
+				*outData++ = (inData[inIndices[idx+0]*dims + dim] +
+								inData[inIndices[idx+1]*dims + dim] +
+								inData[inIndices[idx+2]*dims + dim]) / 3.0f;
 		}
 		
 		// normalize 3D NORMAL, TANGENT or BITANGENT
 		if( ( (attr == NORMAL) || (attr == TANGENT) || (attr == BITANGENT) ) && ( dims == 3 ) ) {
-			size_t numVerts = outData.size() / 3;
-			for( size_t v = 0; v < numVerts; ++v ) {
-				vec3 *d = reinterpret_cast<vec3*>( &outData[v * 3] );
-				*d = normalize( *d );
-			}
+			vec3 *d = reinterpret_cast<vec3*>( outData ) - numTriangles;
+			for( size_t v = 0; v < numTriangles; ++v )
+				d[v] = normalize( d[v] );
 		}
-
-		ctx->appendAttrib( attr, dims, outData.data(), outData.size() / dims );
 	}
 	
-	ctx->appendAttrib( POSITION, 3, (const float*)outPositions.data(), outPositions.size() );
 	ctx->copyIndices( ctx->getPrimitive(), outIndices.data(), outIndices.size(), 4 );
 }
 
+//////////////////////////////////////////////////////////////////////////////////////
+// Optimize
+void Optimize::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
+{
+	AttribSet request = requestedAttribs;
+	if( mOverdraw )
+		request.insert( POSITION );
+	ctx->processUpstream( request );
+
+	if( ctx->getPrimitive() != Primitive::TRIANGLES || ctx->getNumIndices() == 0 ) {
+		CI_LOG_W( "geom::Optimize requires indexed TRIANGLES" );
+		return;
+	}
+	if( mOverdraw && ctx->getAttribDims( POSITION ) != 3 ) {
+		CI_LOG_W( "geom::Optimize requires 3D POSITION for overdraw optimization" );
+		return;
+	}
+
+	const size_t numIndices = ctx->getNumIndices();
+	const size_t numVertices = ctx->getNumVertices();
+	uint32_t *indices = ctx->getIndicesData();
+
+	// the number of indices is unchanged, so the results are written in place
+	vector<uint32_t> optimized;
+	optimizeVertexCache( numIndices, indices, numVertices, &optimized, mVertexCacheMethod, mCacheSize );
+	if( mOverdraw )
+		optimizeOverdraw( optimized.size(), optimized.data(), numVertices, reinterpret_cast<const vec3*>( ctx->getAttribData( POSITION ) ), &optimized, mOverdrawThreshold, mCacheSize );
+	std::copy( optimized.begin(), optimized.end(), indices );
+
+	if( mVertexFetch ) {
+		vector<uint32_t> remap;
+		optimizeVertexFetch( numIndices, indices, numVertices, &remap );
+		for( const auto &attr : ctx->getAvailableAttribs() ) {
+			if( ctx->getAttribData( attr ) )
+				remapVertexData( numVertices, ctx->getAttribDims( attr ), remap.data(), ctx->getAttribData( attr ) );
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Simplify
+void Simplify::process( SourceModsContext *ctx, const AttribSet &requestedAttribs ) const
+{
+	AttribSet request = requestedAttribs;
+	request.insert( POSITION );
+	ctx->processUpstream( request );
+
+	if( ctx->getPrimitive() != Primitive::TRIANGLES || ctx->getNumIndices() == 0 ) {
+		CI_LOG_W( "geom::Simplify requires indexed TRIANGLES" );
+		return;
+	}
+	if( ctx->getAttribDims( POSITION ) != 3 ) {
+		CI_LOG_W( "geom::Simplify requires 3D POSITION" );
+		return;
+	}
+
+	const size_t numIndices = ctx->getNumIndices();
+	const size_t targetNumIndices = size_t( numIndices / 3 * glm::clamp( mRatio, 0.0f, 1.0f ) ) * 3;
+	vector<uint32_t> indices;
+	float error = simplify( numIndices, ctx->getIndicesData(), ctx->getNumVertices(), reinterpret_cast<const vec3*>( ctx->getAttribData( POSITION ) ), targetNumIndices, &indices, mOptions );
+	ctx->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), calcIndicesRequiredBytes( ctx->getNumVertices() ) );
+
+	if( mErrorResult )
+		*mErrorResult = error;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////
 // SourceMods
 void SourceMods::copyImpl( const SourceMods &rhs )
@@ -4809,8 +5510,74 @@ void SourceMods::append( const SourceMods &sourceMods )
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // SourceModsContext
+namespace {
+// Vertices processed by each fused Modifier before moving on to the next, small enough for the block to remain in cache between them
+const size_t sVertexBlockSize = 1024;
+// Limit on the attribute and on the index storage kept for reuse by each thread. Enough for typical meshes while bounding what
+// threads which only occasionally process a SourceMods, such as TaskScheduler workers, keep alive. Larger storage is freed.
+const size_t sMaxCachedStorageBytes = 4 * 1024 * 1024;
+
+// Storage released by the SourceModsContexts of a thread, which is reused by the following ones
+template<typename T>
+class StorageCache {
+  public:
+	StorageCache()
+		: mCachedBytes( 0 )
+	{}
+
+	//! Returns the smallest cached storage with room for \a minCapacity elements, or allocates it
+	unique_ptr<T[]> acquire( size_t minCapacity, size_t *resultCapacity )
+	{
+		auto best = mStorage.end();
+		for( auto it = mStorage.begin(); it != mStorage.end(); ++it ) {
+			if( it->first >= minCapacity && ( best == mStorage.end() || it->first < best->first ) )
+				best = it;
+		}
+
+		if( best == mStorage.end() ) {
+			*resultCapacity = minCapacity;
+			return unique_ptr<T[]>( new T[minCapacity] );
+		}
+
+		*resultCapacity = best->first;
+		unique_ptr<T[]> result = std::move( best->second );
+		mCachedBytes -= best->first * sizeof(T);
+		mStorage.erase( best );
+		return result;
+	}
+
+	void release( unique_ptr<T[]> &&storage, size_t capacity )
+	{
+		const size_t bytes = capacity * sizeof(T);
+		if( ! storage || bytes > sMaxCachedStorageBytes )
+			return;
+
+		// evict the least recently released storage to stay within the limit
+		while( mCachedBytes + bytes > sMaxCachedStorageBytes ) {
+			mCachedBytes -= mStorage.front().first * sizeof(T);
+			mStorage.erase( mStorage.begin() );
+		}
+		mStorage.emplace_back( capacity, std::move( storage ) );
+		mCachedBytes += bytes;
+	}
+
+	void clear()
+	{
+		mStorage.clear();
+		mCachedBytes = 0;
+	}
+
+  private:
+	vector<pair<size_t,unique_ptr<T[]>>>	mStorage;
+	size_t									mCachedBytes;
+};
+
+thread_local StorageCache<float>	sAttribStorageCache;
+thread_local StorageCache<uint32_t>	sIndexStorageCache;
+} // anonymous namespace
+
 SourceModsContext::SourceModsContext( const SourceMods *sourceMods )
-	: mNumIndices( 0 ), mNumVertices( 0 ), mAttribMask( nullptr ), mPrimitive( NUM_PRIMITIVES )
+	: mNumIndices( 0 ), mNumVertices( 0 ), mAttribMask( nullptr ), mPrimitive( NUM_PRIMITIVES ), mIndicesCapacity( 0 ), mIndicesRequiredBytes( 0 )
 {
 	mSource = sourceMods->getSource();
 	
@@ -4822,8 +5589,21 @@ SourceModsContext::SourceModsContext( const SourceMods *sourceMods )
 }
 
 SourceModsContext::SourceModsContext()
-	: mNumIndices( 0 ), mNumVertices( 0 ), mSource( nullptr ), mAttribMask( nullptr ), mPrimitive( NUM_PRIMITIVES )
+	: mNumIndices( 0 ), mNumVertices( 0 ), mSource( nullptr ), mAttribMask( nullptr ), mPrimitive( NUM_PRIMITIVES ), mIndicesCapacity( 0 ), mIndicesRequiredBytes( 0 )
+{
+}
+
+SourceModsContext::~SourceModsContext()
+{
+	for( auto &attrib : mAttribs )
+		sAttribStorageCache.release( std::move( attrib.mData ), attrib.mCapacity );
+	sIndexStorageCache.release( std::move( mIndices ), mIndicesCapacity );
+}
+
+void SourceModsContext::releaseCachedStorage()
 {
+	sAttribStorageCache.clear();
+	sIndexStorageCache.clear();
 }
 
 void SourceModsContext::preload( const AttribSet &requestedAttribs )
@@ -4837,9 +5617,7 @@ void SourceModsContext::preload( const AttribSet &requestedAttribs )
 	// This in turn will call processUpstream(), which will call the next modifier's process(), until there
 	// are no remaining modifiers. Finally processUpstream() will call loadInto() on the Source
 	if( ! mModiferStack.empty() ) {
-		auto modifier = mModiferStack.back();
-		mModiferStack.pop_back();
-		modifier->process( this, requestedAttribs );
+		processNextModifier( requestedAttribs );
 	}
 	else { // no modifiers; just loadInto on the soucre directly
 		mSource->loadInto( this, requestedAttribs );
@@ -4853,10 +5631,10 @@ void SourceModsContext::combine( const SourceModsContext &rhs )
 	if( mPrimitive == NUM_PRIMITIVES ) {
 		mPrimitive = rhs.getPrimitive();
 		this->copyIndices( rhs.getPrimitive(), rhs.getIndicesData(), rhs.getNumIndices(), 4 );
-		for( auto &attribInfo : rhs.mAttribInfo ) {
-			const auto &data = rhs.mAttribData.find( attribInfo.first )->second;
-			const auto &count = rhs.mAttribCount.find( attribInfo.first )->second;
-			this->copyAttrib( attribInfo.first, attribInfo.second.getDims(), attribInfo.second.getStride(), data.get(), count );
+		for( size_t a = 0; a < NUM_ATTRIBS; ++a ) {
+			const AttribStorage &attrib = rhs.mAttribs[a];
+			if( attrib.mDims > 0 )
+				this->copyAttrib( (Attrib)a, attrib.mDims, 0, attrib.mData.get(), attrib.mCount );
 		}
 			
 		return;
@@ -4913,13 +5691,10 @@ void SourceModsContext::combine( const SourceModsContext &rhs )
 	this->copyIndices( combinedPrimitive, outIndices.data(), outIndices.size(), 4 );
 	
 	// Handle Attributes
-	for( const auto &attribInfo : mAttribInfo ) {
-		uint8_t dims = getAttribDims( attribInfo.first );
-		if( dims > 0 ) {
-			uint8_t rhsDims = rhs.getAttribDims( attribInfo.first );
+	for( size_t a = 0; a < NUM_ATTRIBS; ++a ) {
+		if( mAttribs[a].mDims > 0 ) {
 			// if 'rhs' has data for the attribute, copy that
-			const float *rhsAttribData = rhs.getAttribData( attribInfo.first );
-			this->appendAttrib( attribInfo.first, rhsDims, rhsAttribData, rhsNumVertices );
+			this->appendAttrib( (Attrib)a, rhs.getAttribDims( (Attrib)a ), rhs.getAttribData( (Attrib)a ), rhsNumVertices );
 		}
 	}
 }
@@ -4931,23 +5706,10 @@ void SourceModsContext::complete( Target *target, const AttribSet &requestedAttr
 		// If we have modifiers, initiate the chain by calling the last modifier's process() method.
 		// This in turn will call processUpstream(), which will call the next modifier's process(), until there
 		// are no remaining modifiers. Finally processUpstream() will call loadInto() on the Source
-		auto modifier = mModiferStack.back();
-		mModiferStack.pop_back();
-		modifier->process( this, requestedAttribs );
-	}
-
-	// first let's verify that all counts on our requested attributes are the same. If not, we'll continue to process but with an error
-	for( const auto &attribCount : mAttribCount )
-		if( attribCount.second != mNumVertices && ( requestedAttribs.count( attribCount.first ) > 0 ) )
-			CI_LOG_E( "Attribute " << attribToString( attribCount.first ) << " count is " << attribCount.first << " instead of " << mNumVertices );
-	
-	for( const auto &attribInfoPair : mAttribInfo ) {
-		Attrib attrib = attribInfoPair.first;
-		const AttribInfo &attribInfo = attribInfoPair.second;
-		target->copyAttrib( attrib, attribInfo.getDims(), attribInfo.getStride(), mAttribData[attrib].get(), mAttribCount[attrib] );
+		processNextModifier( requestedAttribs );
 	}
 
-	target->copyIndices( mPrimitive, mIndices.get(), mNumIndices, calcIndicesRequiredBytes( mNumIndices ) );	
+	copyToTarget( target, requestedAttribs );
 }
 
 void SourceModsContext::loadInto( Target *target, const AttribSet &requestedAttribs )
@@ -4961,25 +5723,11 @@ void SourceModsContext::loadInto( Target *target, const AttribSet &requestedAttr
 	// This in turn will call processUpstream(), which will call the next modifier's process(), until there
 	// are no remaining modifiers. Finally processUpstream() will call loadInto() on the Source
 	if( ! mModiferStack.empty() ) {
-		auto modifier = mModiferStack.back();
-		mModiferStack.pop_back();
-		modifier->process( this, requestedAttribs );
+		processNextModifier( requestedAttribs );
 
 		// We've finished processing all Modifiers and the Source. Now iterate all the attribute data and the indices
 		// and copy them to the target.
-		
-		// first let's verify that all counts on our requested attributes are the same. If not, we'll continue to process but with an error
-		for( const auto &attribCount : mAttribCount )
-			if( attribCount.second != mNumVertices && ( requestedAttribs.count( attribCount.first ) > 0 ) )
-				CI_LOG_E( "Attribute " << attribToString( attribCount.first ) << " count is " << attribCount.first << " instead of " << mNumVertices );
-		
-		for( const auto &attribInfoPair : mAttribInfo ) {
-			Attrib attrib = attribInfoPair.first;
-			const AttribInfo &attribInfo = attribInfoPair.second;
-			target->copyAttrib( attrib, attribInfo.getDims(), attribInfo.getStride(), mAttribData[attrib].get(), mAttribCount[attrib] );
-		}
-
-		target->copyIndices( mPrimitive, mIndices.get(), mNumIndices, calcIndicesRequiredBytes( mNumIndices ) );
+		copyToTarget( target, requestedAttribs );
 	}
 	else {
 		// no modifiers; in this case just call loadInto()
@@ -4987,6 +5735,24 @@ void SourceModsContext::loadInto( Target *target, const AttribSet &requestedAttr
 	}
 }
 
+void SourceModsContext::copyToTarget( Target *target, const AttribSet &requestedAttribs )
+{
+	// first let's verify that all counts on our requested attributes are the same. If not, we'll continue to process but with an error
+	for( size_t a = 0; a < NUM_ATTRIBS; ++a ) {
+		const AttribStorage &attrib = mAttribs[a];
+		if( attrib.mDims > 0 && attrib.mCount != mNumVertices && ( requestedAttribs.count( (Attrib)a ) > 0 ) )
+			CI_LOG_E( "Attribute " << attribToString( (Attrib)a ) << " count is " << attrib.mCount << " instead of " << mNumVertices );
+	}
+	
+	for( size_t a = 0; a < NUM_ATTRIBS; ++a ) {
+		const AttribStorage &attrib = mAttribs[a];
+		if( attrib.mDims > 0 )
+			target->copyAttrib( (Attrib)a, attrib.mDims, attrib.mDims * sizeof(float), attrib.mData.get(), attrib.mCount );
+	}
+
+	target->copyIndices( mPrimitive, getIndicesData(), mNumIndices, calcIndicesRequiredBytes( mNumIndices ) );
+}
+
 void SourceModsContext::processUpstream( const AttribSet &requestedAttribs )
 {
 	// next 'modifier' is actually the Source, because we're at the end of the stack of modifiers
@@ -4998,19 +5764,62 @@ void SourceModsContext::processUpstream( const AttribSet &requestedAttribs )
 	}
 	else {
 		// we want the Params to reflect upstream from the current Modifier
-		auto modifier = mModiferStack.back();
-		mModiferStack.pop_back();
+		processNextModifier( requestedAttribs );
+	}
+}
+
+void SourceModsContext::processNextModifier( const AttribSet &requestedAttribs )
+{
+	const Modifier *modifier = mModiferStack.back();
+	mModiferStack.pop_back();
+	if( ! modifier->isPerVertex() ) {
 		modifier->process( this, requestedAttribs );
+		return;
+	}
+
+	// gather the run of per-vertex Modifiers upstream of this one, along with the attributes they require
+	vector<const Modifier*> modifiers( 1, modifier );
+	AttribSet request = modifier->getUpstreamAttribs( requestedAttribs );
+	while( ! mModiferStack.empty() && mModiferStack.back()->isPerVertex() ) {
+		modifiers.push_back( mModiferStack.back() );
+		request = mModiferStack.back()->getUpstreamAttribs( request );
+		mModiferStack.pop_back();
+	}
+	std::reverse( modifiers.begin(), modifiers.end() );
+
+	processUpstream( request );
+	processVertexModifiers( modifiers );
+}
+
+void SourceModsContext::processVertexModifiers( const vector<const Modifier*> &modifiers )
+{
+	// Modifiers prepared but waiting for their vertices to be processed, in upstream order
+	vector<const Modifier*> pending;
+	auto processPending = [&] {
+		for( size_t beginVertex = 0; beginVertex < mNumVertices; beginVertex += sVertexBlockSize ) {
+			const size_t endVertex = std::min( beginVertex + sVertexBlockSize, mNumVertices );
+			for( const Modifier *modifier : pending )
+				modifier->processVertices( this, beginVertex, endVertex );
+		}
+		pending.clear();
+	};
+
+	for( const Modifier *modifier : modifiers ) {
+		if( modifier->prepareVertices( this, ! pending.empty() ) )
+			pending.push_back( modifier );
+		else if( ! pending.empty() ) {
+			processPending();
+			if( modifier->prepareVertices( this, false ) )
+				pending.push_back( modifier );
+		}
 	}
+
+	processPending();
 }
-	
+
 uint8_t	SourceModsContext::getAttribDims( Attrib attr ) const
 {
-	auto attrInfoIt = mAttribInfo.find( attr );
-	if( attrInfoIt != mAttribInfo.end() )
-		return attrInfoIt->second.getDims();
-	else
-		return 0;
+	return ( attr < NUM_ATTRIBS ) ? mAttribs[attr].mDims : 0;
 }
 
 size_t SourceModsContext::getNumVertices() const
@@ -5030,10 +5839,8 @@ Primitive SourceModsContext::getPrimitive() const
 
 float* SourceModsContext::getAttribData( Attrib attr )
 {
-	auto attrDataIt = mAttribData.find( attr );
-	if( attrDataIt != mAttribData.end() ) {
-		return attrDataIt->second.get();
-	}
+	if( attr < NUM_ATTRIBS && mAttribs[attr].mDims > 0 )
+		return mAttribs[attr].mData.get();
 	else
 		return nullptr;
 }
@@ -5041,14 +5848,45 @@ float* SourceModsContext::getAttribData( Attrib attr )
 AttribSet SourceModsContext::getAvailableAttribs() const
 {
 	AttribSet result;
-	for( const auto &attribInfo : mAttribInfo )
-		result.insert( attribInfo.first );
+	for( size_t a = 0; a < NUM_ATTRIBS; ++a ) {
+		if( mAttribs[a].mDims > 0 )
+			result.insert( (Attrib)a );
+	}
 	return result;
 }
 
 uint32_t* SourceModsContext::getIndicesData()
 {
-	return mIndices.get();
+	return mNumIndices ? mIndices.get() : nullptr;
+}
+
+void SourceModsContext::reserveAttrib( Attrib attr, size_t capacity, bool preserve )
+{
+	AttribStorage &attrib = mAttribs[attr];
+	if( attrib.mCapacity >= capacity )
+		return;
+
+	size_t newCapacity;
+	unique_ptr<float[]> newData = sAttribStorageCache.acquire( capacity, &newCapacity );
+	if( preserve && attrib.mDims > 0 )
+		memcpy( newData.get(), attrib.mData.get(), sizeof(float) * attrib.mDims * attrib.mCount );
+	sAttribStorageCache.release( std::move( attrib.mData ), attrib.mCapacity );
+	attrib.mData = std::move( newData );
+	attrib.mCapacity = newCapacity;
+}
+
+void SourceModsContext::reserveIndices( size_t capacity, bool preserve )
+{
+	if( mIndicesCapacity >= capacity )
+		return;
+
+	size_t newCapacity;
+	unique_ptr<uint32_t[]> newIndices = sIndexStorageCache.acquire( capacity, &newCapacity );
+	if( preserve && mNumIndices )
+		memcpy( newIndices.get(), mIndices.get(), sizeof(uint32_t) * mNumIndices );
+	sIndexStorageCache.release( std::move( mIndices ), mIndicesCapacity );
+	mIndices = std::move( newIndices );
+	mIndicesCapacity = newCapacity;
 }
 
 void SourceModsContext::copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count )
@@ -5059,64 +5897,113 @@ void SourceModsContext::copyAttrib( Attrib attr, uint8_t dims, size_t strideByte
 	// can crash, because geom::Translate could be processing residual attributes from further up the chain
 	if( mAttribMask && mAttribMask->count( attr ) == 0 )
 		return;
+	if( attr >= NUM_ATTRIBS ) {
+		CI_LOG_E( "Unsupported attribute: " << attr );
+		return;
+	}
 
 	// theoretically this should be the same for all calls to copyAttrib from a given modifier. If it's not at loadInto(), we'll log an error
 	mNumVertices = count;
 
-	// we definitely need allocation if we haven't encountered this attrib before
-	bool needsAllocation = ( mAttribCount.count( attr ) == 0 ) || ( mAttribData.count( attr ) == 0 ) || ( mAttribInfo.count( attr ) == 0 );
-	// we need allocation if we have this attrib but with different parameters
-	if( ! needsAllocation ) {
-		const AttribInfo &attribInfo = mAttribInfo.at( attr );
-		needsAllocation = ( attribInfo.getStride() != strideBytes ) || ( attribInfo.getDims() != dims ) || ( count != mAttribCount[attr] );
+	AttribStorage &attrib = mAttribs[attr];
+	// a Modifier which processed the data in place has nothing left to copy
+	if( srcData == attrib.mData.get() && dims == attrib.mDims && count == attrib.mCount && ( strideBytes == 0 || strideBytes == dims * sizeof(float) ) )
+		return;
+
+	// data within our own storage in another layout needs to be copied to new storage
+	const bool aliased = srcData >= attrib.mData.get() && srcData < attrib.mData.get() + attrib.mCapacity;
+	if( aliased ) {
+		size_t newCapacity;
+		unique_ptr<float[]> newData = sAttribStorageCache.acquire( dims * count, &newCapacity );
+		copyData( dims, strideBytes, srcData, count, dims, 0, newData.get() );
+		sAttribStorageCache.release( std::move( attrib.mData ), attrib.mCapacity );
+		attrib.mData = std::move( newData );
+		attrib.mCapacity = newCapacity;
 	}
-	
-	if( needsAllocation ) {
-		mAttribData[attr] = unique_ptr<float[]>( new float[dims * count] );
-		mAttribCount[attr] = count;
-		// oddly elaborate logic necessary to replace set contents w/o a default-constructible type
-		// equivalent to mAttribInfo[attr] = AttribInfo( ... )
-		auto it = mAttribInfo.insert( make_pair( attr, AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 ) ) ).first;
-		it->second = AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 ); // only necessary if the key already exists
+	else {
+		reserveAttrib( attr, dims * count, false );
+		copyData( dims, strideBytes, srcData, count, dims, 0, attrib.mData.get() );
 	}
-	
-	copyData( dims, strideBytes, srcData, count, dims, 0, mAttribData.at( attr ).get() );
+
+	attrib.mDims = dims;
+	attrib.mCount = count;
+}
+
+float* SourceModsContext::allocAttrib( Attrib attr, uint8_t dims, size_t count )
+{
+	if( attr >= NUM_ATTRIBS ) {
+		CI_LOG_E( "Unsupported attribute: " << attr );
+		return nullptr;
+	}
+
+	AttribStorage &attrib = mAttribs[attr];
+	reserveAttrib( attr, dims * count, false );
+	attrib.mDims = dims;
+	attrib.mCount = count;
+	mNumVertices = count;
+	return attrib.mData.get();
+}
+
+float* SourceModsContext::getAttribStorage( Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	// attributes which weren't requested would be ignored by copyAttrib()
+	if( ( mAttribMask && mAttribMask->count( attr ) == 0 ) || attr >= NUM_ATTRIBS )
+		return nullptr;
+
+	*resultStrideBytes = dims * sizeof(float);
+	return allocAttrib( attr, dims, count );
+}
+
+float* SourceModsContext::extendAttrib( Attrib attr, size_t count )
+{
+	if( getAttribDims( attr ) == 0 ) {
+		CI_LOG_E( "Can't extend missing attribute: " << attribToString( attr ) );
+		return nullptr;
+	}
+
+	AttribStorage &attrib = mAttribs[attr];
+	const size_t newCount = attrib.mCount + count;
+	// grow geometrically so that repeated appends take amortized constant time
+	if( attrib.mCapacity < attrib.mDims * newCount )
+		reserveAttrib( attr, std::max<size_t>( attrib.mDims * newCount, attrib.mCapacity * 3 / 2 ), true );
+
+	float *result = attrib.mData.get() + attrib.mDims * attrib.mCount;
+	attrib.mCount = newCount;
+	mNumVertices = newCount;
+	return result;
 }
 
 void SourceModsContext::appendAttrib( Attrib attr, uint8_t dims, const float *srcData, size_t count )
 {
 	// if we don't have any data for this attribute, just call copyAttrib
-	if( mAttribInfo.count( attr ) == 0 ) {
+	if( getAttribDims( attr ) == 0 ) {
 		copyAttrib( attr, dims, 0, srcData, count );
 		return;
 	}
-	auto attribInfoIt = mAttribInfo.at( attr );
-	uint8_t existingDims = attribInfoIt.getDims();
-	size_t existingCount = mAttribCount[attr];
-	const float *existingData = mAttribData[attr].get();
 
-	auto newData = unique_ptr<float[]>( new float[(existingCount + count) * existingDims] );
-	// copy old data
-	memcpy( newData.get(), existingData, sizeof(float) * existingCount * existingDims );
+	const uint8_t existingDims = mAttribs[attr].mDims;
 	// append new data
-	copyData( dims, 0, srcData, count, existingDims, 0, newData.get() + existingCount * existingDims );
-	// reassign data
-	mAttribData[attr] = std::move( newData );
-	mAttribCount[attr] = existingCount + count;
-
-	mNumVertices = existingCount + count;
+	float *newData = extendAttrib( attr, count );
+	copyData( dims, 0, srcData, count, existingDims, 0, newData );
 }
 
 void SourceModsContext::copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytes )
 {
 	mPrimitive = primitive;
 	mIndicesRequiredBytes = requiredBytes;
-	// need to reallocate storage only if this is a different number of indices
-	if( mNumIndices != numIndices ) {
+	// indices within our own storage, such as those processed in place by a Modifier, only need moving to its start
+	if( source >= mIndices.get() && source < mIndices.get() + mIndicesCapacity ) {
+		memmove( mIndices.get(), source, sizeof(uint32_t) * numIndices );
 		mNumIndices = numIndices;
-		mIndices = unique_ptr<uint32_t[]>( new uint32_t[numIndices] );
+		return;
 	}
-	memcpy( mIndices.get(), source, sizeof(uint32_t) * numIndices );
+
+	// need to reallocate storage only if there isn't room for this number of indices
+	mNumIndices = 0;
+	reserveIndices( numIndices, false );
+	mNumIndices = numIndices;
+	if( numIndices )
+		memcpy( mIndices.get(), source, sizeof(uint32_t) * numIndices );
 }
 
 void SourceModsContext::appendIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytes )
@@ -5124,31 +6011,32 @@ void SourceModsContext::appendIndices( Primitive primitive, const uint32_t *sour
 	if( mPrimitive != primitive )
 		CI_LOG_E( "Primitive types don't match" );
 	
-	auto newIndices = unique_ptr<uint32_t[]>( new uint32_t[numIndices + mNumIndices] );
 	mIndicesRequiredBytes = std::max( mIndicesRequiredBytes, requiredBytes );
 
-	// copy old index data
-	if( mNumIndices && mIndices.get() )
-		memcpy( newIndices.get(), mIndices.get(), sizeof(uint32_t) * mNumIndices );
+	// grow geometrically so that repeated appends take amortized constant time
+	if( mIndicesCapacity < mNumIndices + numIndices )
+		reserveIndices( std::max<size_t>( mNumIndices + numIndices, mIndicesCapacity * 3 / 2 ), true );
 	// and append new index data
-	memcpy( newIndices.get() + mNumIndices, source, sizeof(uint32_t) * numIndices );
+	if( numIndices )
+		memcpy( mIndices.get() + mNumIndices, source, sizeof(uint32_t) * numIndices );
 	// total indices += new number of indices
 	mNumIndices = mNumIndices + numIndices;
-	
-	mIndices = std::move( newIndices );
 }
 
 void SourceModsContext::clearAttrib( Attrib attr )
 {
-	mAttribInfo.erase( attr );
-	mAttribData.erase( attr );
-	mAttribCount.erase( attr );
+	if( attr >= NUM_ATTRIBS )
+		return;
+
+	AttribStorage &attrib = mAttribs[attr];
+	sAttribStorageCache.release( std::move( attrib.mData ), attrib.mCapacity );
+	attrib = AttribStorage();
 }
 
 void SourceModsContext::clearIndices()
 {
+	// the storage is kept for reuse
 	mNumIndices = 0;
-	mIndices.reset();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,649 @@
+/*
+ Copyright (c) 2024, The Cinder Project
+ All rights reserved.
+
+ This code is designed for use with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+	* Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Quadric error metric simplification after Garland, Michael and Paul S. Heckbert. "Surface Simplification Using Quadric Error Metrics". SIGGRAPH 1997.
+// Vertices collapse onto neighboring vertices rather than optimal positions, so that the result can keep referring to the original vertex data.
+
+#include "cinder/GeomIo.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+using namespace std;
+
+namespace cinder { namespace geom {
+
+namespace {
+
+// Planes along open boundaries keep them from shrinking; seams only need to stay roughly straight
+const double sBorderWeight = 10;
+const double sSeamWeight = 1;
+
+// Sum of weighted squared distances to a set of planes, as the symmetric matrix Q such that the sum at p is (p,1)^T Q (p,1)
+struct Quadric {
+	Quadric()
+		: a00( 0 ), a11( 0 ), a22( 0 ), a01( 0 ), a02( 0 ), a12( 0 ), b0( 0 ), b1( 0 ), b2( 0 ), c( 0 ), weight( 0 )
+	{}
+
+	void addPlane( const dvec3 &n, double d, double w )
+	{
+		a00 += w * n.x * n.x;	a11 += w * n.y * n.y;	a22 += w * n.z * n.z;
+		a01 += w * n.x * n.y;	a02 += w * n.x * n.z;	a12 += w * n.y * n.z;
+		b0 += w * n.x * d;		b1 += w * n.y * d;		b2 += w * n.z * d;
+		c += w * d * d;
+		weight += w;
+	}
+
+	Quadric& operator+=( const Quadric &rhs )
+	{
+		a00 += rhs.a00; a11 += rhs.a11; a22 += rhs.a22; a01 += rhs.a01; a02 += rhs.a02; a12 += rhs.a12;
+		b0 += rhs.b0; b1 += rhs.b1; b2 += rhs.b2; c += rhs.c; weight += rhs.weight;
+		return *this;
+	}
+
+	Quadric& operator-=( const Quadric &rhs )
+	{
+		a00 -= rhs.a00; a11 -= rhs.a11; a22 -= rhs.a22; a01 -= rhs.a01; a02 -= rhs.a02; a12 -= rhs.a12;
+		b0 -= rhs.b0; b1 -= rhs.b1; b2 -= rhs.b2; c -= rhs.c; weight -= rhs.weight;
+		return *this;
+	}
+
+	// Returns the weighted mean squared distance of \a p to the planes
+	double eval( const vec3 &p ) const
+	{
+		if( weight <= 0 )
+			return 0;
+		const double x = p.x, y = p.y, z = p.z;
+		double result = a00 * x * x + a11 * y * y + a22 * z * z + 2 * ( a01 * x * y + a02 * x * z + a12 * y * z ) + 2 * ( b0 * x + b1 * y + b2 * z ) + c;
+		return std::max( result, 0.0 ) / weight;
+	}
+
+	double	a00, a11, a22, a01, a02, a12, b0, b1, b2, c;
+	double	weight;
+};
+
+// MANIFOLD vertices may collapse onto any neighbor. BORDER vertices lie on an open boundary and SEAM vertices on an attribute seam, where a position is shared by two
+// vertices; both may only collapse along their boundary or seam, and both vertices of a seam move together. LOCKED vertices, such as corners, stay in place.
+enum VertexKind : uint8_t { MANIFOLD, BORDER, SEAM, LOCKED };
+
+// Finds the vertices sharing a position, allowing for the rounding errors of generated geometry whose seam vertices were computed separately
+vector<uint32_t> weldPositions( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions )
+{
+	vec3 minimum( numeric_limits<float>::max() ), maximum( -numeric_limits<float>::max() );
+	for( size_t i = 0; i < numIndices; ++i ) {
+		minimum = glm::min( minimum, positions[indices[i]] );
+		maximum = glm::max( maximum, positions[indices[i]] );
+	}
+	const vec3 size = glm::max( maximum - minimum, vec3( 0 ) );
+	const float epsilon = std::max( size.x, std::max( size.y, size.z ) ) * 1e-6f;
+
+	vector<uint32_t> result;
+	weldVertices( numVertices, positions, epsilon, &result );
+	return result;
+}
+
+class Simplifier {
+  public:
+	// \a lockedVertices marks vertices that must stay in place, and \a positionRemap maps each vertex to the first one at the same position. Both may be NULL.
+	Simplifier( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const SimplifyOptions &options,
+				const vector<uint8_t> *lockedVertices, const vector<uint32_t> *positionRemap );
+
+	// Collapses edges until at most \a targetNumIndices remain or until a collapse would exceed the maximum error or \a maxCost, a squared error. Can be called again
+	// with a lower target or a higher \a maxCost to continue.
+	void	simplify( size_t targetNumIndices, double maxCost = numeric_limits<double>::max() );
+
+	const vector<uint32_t>&	getIndices() const	{ return mIndices; }
+	float					getError() const	{ return (float)sqrt( mMaxCost ); }
+	double					getMaxCost() const	{ return mMaxCost; }
+
+	// Used to continue from the results of simplifying parts of the mesh separately
+	const Quadric&	getQuadric( uint32_t v ) const					{ return mQuadrics[mPositionRemap[v]]; }
+	void			setQuadric( uint32_t v, const Quadric &quadric )	{ mQuadrics[mPositionRemap[v]] = quadric; }
+	void			setIndices( vector<uint32_t> indices, double maxCost )	{ mIndices = std::move( indices ); mMaxCost = maxCost; }
+	bool			isFirstAtPosition( uint32_t v ) const				{ return mPositionRemap[v] == v; }
+
+  private:
+	struct Collapse {
+		uint32_t	v, u; // v moves onto u
+		float		cost;
+	};
+
+	void	buildAdjacency();
+	void	classifyVertices();
+	void	buildQuadrics();
+	bool	collapsePass( size_t targetNumIndices, double maxCost );
+	bool	hasEdge( uint32_t a, uint32_t b ) const;
+	bool	hasPositionEdge( uint32_t a, uint32_t b ) const;
+	bool	canCollapse( uint32_t v, uint32_t u ) const;
+	// Returns true if moving \a v onto \a u would flip one of the triangles around \a v, and otherwise adds the number of triangles that collapse to \a numDegenerate
+	bool	hasFlips( uint32_t v, uint32_t u, size_t *numDegenerate ) const;
+
+	size_t				mNumVertices;
+	const vec3			*mPositions;
+	double				mMaxCostLimit;
+	bool				mLockBorders;
+	vector<uint8_t>		mLockedVertices;
+
+	vector<uint32_t>	mIndices;
+	vector<uint32_t>	mPositionRemap; // first vertex with the same position
+	vector<uint32_t>	mWedges; // circular lists of the vertices with the same position
+	vector<Quadric>		mQuadrics; // per mPositionRemap entry
+	double				mMaxCost;
+	double				mNextCost; // cheapest collapse over the limit when the last pass found none under it
+
+	// rebuilt for every pass: outgoing half-edges per vertex, and the open half-edge into and out of each vertex
+	vector<uint32_t>	mEdgeOffsets, mEdgeTargets, mEdgeTriangles;
+	vector<uint32_t>	mOpenOut, mOpenIn;
+	vector<uint8_t>		mNumOpenOut, mNumOpenIn, mKinds;
+	vector<uint32_t>	mCollapseRemap;
+};
+
+Simplifier::Simplifier( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const SimplifyOptions &options,
+						const vector<uint8_t> *lockedVertices, const vector<uint32_t> *positionRemap )
+	: mNumVertices( numVertices ), mPositions( positions ), mLockBorders( options.getLockBorders() ), mIndices( indices, indices + numIndices - numIndices % 3 ), mMaxCost( 0 ), mNextCost( 0 )
+{
+	const double maxError = options.getMaxError();
+	mMaxCostLimit = ( maxError < sqrt( numeric_limits<double>::max() ) ) ? maxError * maxError : numeric_limits<double>::max();
+	if( lockedVertices )
+		mLockedVertices = *lockedVertices;
+	else
+		mLockedVertices.assign( numVertices, 0 );
+
+	mPositionRemap = positionRemap ? *positionRemap : weldPositions( numIndices, indices, numVertices, positions );
+	mWedges.resize( numVertices );
+	for( uint32_t v = 0; v < numVertices; ++v ) {
+		const uint32_t first = mPositionRemap[v];
+		if( first == v )
+			mWedges[v] = v;
+		else {
+			mWedges[v] = mWedges[first];
+			mWedges[first] = v;
+		}
+	}
+
+	buildAdjacency();
+	classifyVertices();
+	buildQuadrics();
+}
+
+void Simplifier::buildAdjacency()
+{
+	const size_t numIndices = mIndices.size();
+	mEdgeOffsets.assign( mNumVertices + 1, 0 );
+	for( size_t i = 0; i < numIndices; ++i )
+		mEdgeOffsets[mIndices[i] + 1]++;
+	for( size_t v = 0; v < mNumVertices; ++v )
+		mEdgeOffsets[v + 1] += mEdgeOffsets[v];
+
+	mEdgeTargets.resize( numIndices );
+	mEdgeTriangles.resize( numIndices );
+	vector<uint32_t> next( mEdgeOffsets.begin(), mEdgeOffsets.end() - 1 );
+	for( size_t i = 0; i < numIndices; ++i ) {
+		const size_t triangle = i / 3;
+		const uint32_t e = next[mIndices[i]]++;
+		mEdgeTargets[e] = mIndices[triangle * 3 + ( i + 1 ) % 3];
+		mEdgeTriangles[e] = (uint32_t)triangle;
+	}
+}
+
+bool Simplifier::hasEdge( uint32_t a, uint32_t b ) const
+{
+	for( uint32_t e = mEdgeOffsets[a]; e < mEdgeOffsets[a + 1]; ++e ) {
+		if( mEdgeTargets[e] == b )
+			return true;
+	}
+	return false;
+}
+
+bool Simplifier::hasPositionEdge( uint32_t a, uint32_t b ) const
+{
+	uint32_t wedge = a;
+	do {
+		for( uint32_t e = mEdgeOffsets[wedge]; e < mEdgeOffsets[wedge + 1]; ++e ) {
+			if( mPositionRemap[mEdgeTargets[e]] == mPositionRemap[b] )
+				return true;
+		}
+		wedge = mWedges[wedge];
+	} while( wedge != a );
+	return false;
+}
+
+void Simplifier::classifyVertices()
+{
+	mOpenOut.assign( mNumVertices, ~0u );
+	mOpenIn.assign( mNumVertices, ~0u );
+	mNumOpenOut.assign( mNumVertices, 0 );
+	mNumOpenIn.assign( mNumVertices, 0 );
+	for( uint32_t v = 0; v < mNumVertices; ++v ) {
+		for( uint32_t e = mEdgeOffsets[v]; e < mEdgeOffsets[v + 1]; ++e ) {
+			const uint32_t target = mEdgeTargets[e];
+			if( ! hasEdge( target, v ) ) {
+				mOpenOut[v] = target;
+				mNumOpenOut[v] = (uint8_t)std::min( mNumOpenOut[v] + 1, 2 );
+				mOpenIn[target] = v;
+				mNumOpenIn[target] = (uint8_t)std::min( mNumOpenIn[target] + 1, 2 );
+			}
+		}
+	}
+
+	mKinds.resize( mNumVertices );
+	for( uint32_t v = 0; v < mNumVertices; ++v ) {
+		if( mPositionRemap[v] != v )
+			continue;
+
+		VertexKind kind = LOCKED;
+		const uint32_t w = mWedges[v];
+		auto hasOneOpenEdge = [this]( uint32_t x ) { return mNumOpenOut[x] == 1 && mNumOpenIn[x] == 1; };
+		if( w == v ) {
+			if( mNumOpenOut[v] == 0 && mNumOpenIn[v] == 0 )
+				kind = MANIFOLD;
+			else if( hasOneOpenEdge( v ) && ! hasPositionEdge( mOpenOut[v], v ) && ! hasPositionEdge( v, mOpenIn[v] ) )
+				kind = mLockBorders ? LOCKED : BORDER;
+		}
+		else if( mWedges[w] == v && hasOneOpenEdge( v ) && hasOneOpenEdge( w ) ) {
+			// the open edges of both vertices must be the two sides of the same seam, which is closed when positions are compared
+			if( mPositionRemap[mOpenOut[v]] == mPositionRemap[mOpenIn[w]] && mPositionRemap[mOpenIn[v]] == mPositionRemap[mOpenOut[w]]
+				&& hasPositionEdge( mOpenOut[v], v ) && hasPositionEdge( v, mOpenIn[v] ) )
+				kind = SEAM;
+		}
+
+		uint32_t wedge = v;
+		do {
+			if( mLockedVertices[wedge] )
+				kind = LOCKED;
+			wedge = mWedges[wedge];
+		} while( wedge != v );
+		do {
+			mKinds[wedge] = kind;
+			wedge = mWedges[wedge];
+		} while( wedge != v );
+	}
+}
+
+void Simplifier::buildQuadrics()
+{
+	mQuadrics.assign( mNumVertices, Quadric() );
+	const size_t numTriangles = mIndices.size() / 3;
+	for( size_t t = 0; t < numTriangles; ++t ) {
+		const uint32_t *tri = &mIndices[t * 3];
+		const dvec3 p0( mPositions[tri[0]] ), p1( mPositions[tri[1]] ), p2( mPositions[tri[2]] );
+		dvec3 normal = cross( p1 - p0, p2 - p0 );
+		const double length = glm::length( normal );
+		if( length == 0 )
+			continue;
+		normal /= length;
+
+		// weighting by area makes the quadrics independent of tessellation
+		for( int i = 0; i < 3; ++i )
+			mQuadrics[mPositionRemap[tri[i]]].addPlane( normal, -dot( normal, p0 ), length * 0.5 );
+
+		// planes perpendicular to the triangle through its open edges
+		for( int i = 0; i < 3; ++i ) {
+			const uint32_t a = tri[i], b = tri[( i + 1 ) % 3];
+			if( hasEdge( b, a ) )
+				continue;
+			const dvec3 pa( mPositions[a] ), pb( mPositions[b] );
+			dvec3 edgeNormal = cross( pb - pa, normal );
+			const double edgeLength = glm::length( edgeNormal );
+			if( edgeLength == 0 )
+				continue;
+			edgeNormal /= edgeLength;
+			const double weight = edgeLength * edgeLength * ( hasPositionEdge( b, a ) ? sSeamWeight : sBorderWeight );
+			mQuadrics[mPositionRemap[a]].addPlane( edgeNormal, -dot( edgeNormal, pa ), weight );
+			mQuadrics[mPositionRemap[b]].addPlane( edgeNormal, -dot( edgeNormal, pa ), weight );
+		}
+	}
+}
+
+bool Simplifier::canCollapse( uint32_t v, uint32_t u ) const
+{
+	// the triangles of v would take on the attributes of one of u's vertices, which is only right for all of them when u has at most one on each side of a seam
+	if( mWedges[mWedges[u]] != u )
+		return false;
+
+	switch( mKinds[v] ) {
+		case MANIFOLD:
+			return true;
+		case BORDER:
+		case SEAM:
+			return u == mOpenOut[v] || u == mOpenIn[v];
+		default:
+			return false;
+	}
+}
+
+bool Simplifier::hasFlips( uint32_t v, uint32_t u, size_t *numDegenerate ) const
+{
+	const vec3 &pu = mPositions[u];
+	for( uint32_t e = mEdgeOffsets[v]; e < mEdgeOffsets[v + 1]; ++e ) {
+		const uint32_t *tri = &mIndices[mEdgeTriangles[e] * 3];
+		uint32_t corners[3] = { mCollapseRemap[tri[0]], mCollapseRemap[tri[1]], mCollapseRemap[tri[2]] };
+		const int vCorner = ( tri[0] == v ) ? 0 : ( tri[1] == v ) ? 1 : 2;
+		const uint32_t b = corners[( vCorner + 1 ) % 3], c = corners[( vCorner + 2 ) % 3];
+		if( mPositionRemap[b] == mPositionRemap[u] || mPositionRemap[c] == mPositionRemap[u] ) {
+			(*numDegenerate)++;
+			continue;
+		}
+
+		const vec3 &pv = mPositions[v], &pb = mPositions[b], &pc = mPositions[c];
+		const vec3 before = cross( pb - pv, pc - pv );
+		const vec3 after = cross( pb - pu, pc - pu );
+		if( dot( before, after ) <= 0.25f * sqrt( length2( before ) * length2( after ) ) )
+			return true;
+	}
+	return false;
+}
+
+bool Simplifier::collapsePass( size_t targetNumIndices, double maxCost )
+{
+	buildAdjacency();
+	classifyVertices();
+
+	// consider every edge once, in its cheapest allowed direction
+	vector<Collapse> collapses;
+	const size_t numIndices = mIndices.size();
+	double nextCost = numeric_limits<double>::max();
+	for( size_t i = 0; i < numIndices; ++i ) {
+		const uint32_t a = mIndices[i], b = mIndices[( i / 3 ) * 3 + ( i + 1 ) % 3];
+		if( a > b && hasEdge( b, a ) )
+			continue;
+
+		Collapse collapse = { 0, 0, numeric_limits<float>::max() };
+		if( canCollapse( a, b ) ) {
+			collapse.v = a; collapse.u = b;
+			collapse.cost = (float)mQuadrics[mPositionRemap[a]].eval( mPositions[b] );
+		}
+		if( canCollapse( b, a ) ) {
+			float cost = (float)mQuadrics[mPositionRemap[b]].eval( mPositions[a] );
+			if( cost < collapse.cost ) {
+				collapse.v = b; collapse.u = a;
+				collapse.cost = cost;
+			}
+		}
+		if( collapse.cost < numeric_limits<float>::max() ) {
+			if( collapse.cost <= maxCost )
+				collapses.push_back( collapse );
+			else
+				nextCost = std::min<double>( nextCost, collapse.cost );
+		}
+	}
+	std::sort( collapses.begin(), collapses.end(), []( const Collapse &a, const Collapse &b ) { return a.cost < b.cost; } );
+
+	// each collapse typically removes two triangles; vertices moved in this pass are not collapsed again until the next one
+	const size_t goal = std::max<size_t>( ( numIndices - targetNumIndices ) / 6, 1 );
+	mCollapseRemap.resize( mNumVertices );
+	for( uint32_t v = 0; v < mNumVertices; ++v )
+		mCollapseRemap[v] = v;
+	vector<uint8_t> collapsedThisPass( mNumVertices, 0 );
+	size_t numCollapses = 0, numRemovedIndices = 0;
+	for( const Collapse &collapse : collapses ) {
+		if( numCollapses >= goal || numIndices - numRemovedIndices <= targetNumIndices )
+			break;
+
+		const uint32_t v = collapse.v, u = collapse.u;
+		if( collapsedThisPass[mPositionRemap[v]] || collapsedThisPass[mPositionRemap[u]] )
+			continue;
+
+		// the other vertex of a seam moves onto the matching vertex on the other side
+		uint32_t w = ~0u, wu = ~0u;
+		if( mKinds[v] == SEAM ) {
+			w = mWedges[v];
+			wu = ( u == mOpenOut[v] ) ? mOpenIn[w] : mOpenOut[w];
+		}
+
+		size_t numDegenerate = 0;
+		if( hasFlips( v, u, &numDegenerate ) || ( w != ~0u && hasFlips( w, wu, &numDegenerate ) ) )
+			continue;
+
+		mCollapseRemap[v] = u;
+		if( w != ~0u )
+			mCollapseRemap[w] = wu;
+		mQuadrics[mPositionRemap[u]] += mQuadrics[mPositionRemap[v]];
+		collapsedThisPass[mPositionRemap[v]] = collapsedThisPass[mPositionRemap[u]] = 1;
+		mMaxCost = std::max<double>( mMaxCost, collapse.cost );
+		numRemovedIndices += numDegenerate * 3;
+		++numCollapses;
+	}
+
+	if( numCollapses == 0 ) {
+		mNextCost = collapses.empty() ? nextCost : 0;
+		return false;
+	}
+	mNextCost = 0;
+
+	// remove the triangles that collapsed
+	size_t numResultIndices = 0;
+	for( size_t i = 0; i < numIndices; i += 3 ) {
+		const uint32_t a = mCollapseRemap[mIndices[i]], b = mCollapseRemap[mIndices[i + 1]], c = mCollapseRemap[mIndices[i + 2]];
+		if( mPositionRemap[a] == mPositionRemap[b] || mPositionRemap[b] == mPositionRemap[c] || mPositionRemap[a] == mPositionRemap[c] )
+			continue;
+		mIndices[numResultIndices++] = a;
+		mIndices[numResultIndices++] = b;
+		mIndices[numResultIndices++] = c;
+	}
+	mIndices.resize( numResultIndices );
+
+	return true;
+}
+
+void Simplifier::simplify( size_t targetNumIndices, double maxCost )
+{
+	maxCost = std::min( maxCost, mMaxCostLimit );
+	if( maxCost < mNextCost )
+		return;
+
+	while( mIndices.size() > targetNumIndices ) {
+		if( ! collapsePass( targetNumIndices, maxCost ) )
+			break;
+	}
+}
+
+// Spreads the low 10 bits of \a x out to every third bit
+uint32_t spreadBits( uint32_t x )
+{
+	x &= 0x3ff;
+	x = ( x | ( x << 16 ) ) & 0x30000ff;
+	x = ( x | ( x << 8 ) ) & 0x300f00f;
+	x = ( x | ( x << 4 ) ) & 0x30c30c3;
+	x = ( x | ( x << 2 ) ) & 0x9249249;
+	return x;
+}
+
+// Simplifies spatially coherent clusters of triangles in parallel with the positions they share kept in place. For each level, the merged clusters are then
+// simplified as a whole, mostly along the boundaries between clusters, continuing from the quadrics the clusters accumulated.
+void simplifyClustered( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vector<size_t> &targets, const SimplifyOptions &options, vector<SimplifiedLod> *result )
+{
+	const size_t numTriangles = numIndices / 3;
+	const size_t clusterSize = options.getParallelClusters();
+
+	// order triangles along a Morton curve through their centroids
+	vec3 minimum( numeric_limits<float>::max() ), maximum( -numeric_limits<float>::max() );
+	for( size_t i = 0; i < numTriangles * 3; ++i ) {
+		minimum = glm::min( minimum, positions[indices[i]] );
+		maximum = glm::max( maximum, positions[indices[i]] );
+	}
+	const vec3 scale = 1023.0f / glm::max( maximum - minimum, vec3( numeric_limits<float>::min() ) );
+	vector<pair<uint32_t, uint32_t>> order( numTriangles );
+	for( size_t t = 0; t < numTriangles; ++t ) {
+		const vec3 centroid = ( positions[indices[t * 3]] + positions[indices[t * 3 + 1]] + positions[indices[t * 3 + 2]] ) / 3.0f;
+		const uvec3 cell( ( centroid - minimum ) * scale );
+		order[t] = make_pair( spreadBits( cell.x ) | ( spreadBits( cell.y ) << 1 ) | ( spreadBits( cell.z ) << 2 ), (uint32_t)t );
+	}
+	std::sort( order.begin(), order.end() );
+
+	// the whole mesh provides the quadrics of the shared positions, with boundaries between clusters correctly treated as closed
+	const vector<uint32_t> positionRemap = weldPositions( numIndices, indices, numVertices, positions );
+	Simplifier whole( numIndices, indices, numVertices, positions, options, nullptr, &positionRemap );
+
+	const size_t numClusters = ( numTriangles + clusterSize - 1 ) / clusterSize;
+	const uint32_t shared = ~0u - 1;
+	vector<uint32_t> positionCluster( numVertices, ~0u );
+	for( size_t t = 0; t < numTriangles; ++t ) {
+		const uint32_t cluster = uint32_t( t / clusterSize );
+		for( int i = 0; i < 3; ++i ) {
+			uint32_t &owner = positionCluster[positionRemap[indices[order[t].second * 3 + i]]];
+			owner = ( owner == ~0u || owner == cluster ) ? cluster : shared;
+		}
+	}
+
+	// each cluster is simplified with its own compacted vertices; clusterVertices maps them back
+	vector<unique_ptr<Simplifier>> clusters( numClusters );
+	vector<vector<uint32_t>> clusterVertices( numClusters );
+	vector<vector<vec3>> clusterPositions( numClusters );
+	vector<vector<uint8_t>> clusterLocked( numClusters );
+	vector<vector<Quadric>> clusterLockedQuadrics( numClusters ); // initial quadrics of the shared positions, to find what collapses added to them
+	parallelFor( numClusters, 1, [&]( size_t begin, size_t end ) {
+		for( size_t cluster = begin; cluster < end; ++cluster ) {
+			const size_t firstTriangle = cluster * clusterSize, lastTriangle = std::min( firstTriangle + clusterSize, numTriangles );
+			vector<uint32_t> globalIndices;
+			for( size_t t = firstTriangle; t < lastTriangle; ++t )
+				globalIndices.insert( globalIndices.end(), indices + order[t].second * 3, indices + order[t].second * 3 + 3 );
+
+			vector<uint32_t> &vertices = clusterVertices[cluster];
+			vertices = globalIndices;
+			std::sort( vertices.begin(), vertices.end() );
+			vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+			vector<uint32_t> localIndices( globalIndices.size() );
+			for( size_t i = 0; i < globalIndices.size(); ++i )
+				localIndices[i] = uint32_t( std::lower_bound( vertices.begin(), vertices.end(), globalIndices[i] ) - vertices.begin() );
+
+			// vertices at the same position map to the first one within the cluster
+			vector<uint32_t> localRemap( vertices.size() );
+			unordered_map<uint32_t, uint32_t> firstAtPosition;
+			clusterPositions[cluster].resize( vertices.size() );
+			clusterLocked[cluster].resize( vertices.size() );
+			for( uint32_t v = 0; v < vertices.size(); ++v ) {
+				localRemap[v] = firstAtPosition.insert( make_pair( positionRemap[vertices[v]], v ) ).first->second;
+				clusterPositions[cluster][v] = positions[vertices[v]];
+				clusterLocked[cluster][v] = positionCluster[positionRemap[vertices[v]]] == shared;
+			}
+
+			clusters[cluster].reset( new Simplifier( localIndices.size(), localIndices.data(), vertices.size(), clusterPositions[cluster].data(), options, &clusterLocked[cluster], &localRemap ) );
+			clusterLockedQuadrics[cluster].resize( vertices.size() );
+			for( uint32_t v = 0; v < vertices.size(); ++v ) {
+				if( clusterLocked[cluster][v] )
+					clusterLockedQuadrics[cluster][v] = clusters[cluster]->getQuadric( v );
+			}
+		}
+	} );
+
+	// clusters collapse edges up to a common error threshold that rises until the target is reached, which approximates collapsing the cheapest edges of the
+	// whole mesh first. Each cluster keeps at least its share of the target, leaving the rest to the final pass.
+	const float extent = std::max( maximum.x - minimum.x, std::max( maximum.y - minimum.y, maximum.z - minimum.z ) );
+	double threshold = extent * extent * 1e-10;
+	size_t numClusterIndices = numTriangles * 3;
+	for( size_t target : targets ) {
+		const size_t levelNumIndices = numClusterIndices;
+		while( numClusterIndices > target && threshold < extent * extent ) {
+			parallelFor( numClusters, 1, [&]( size_t begin, size_t end ) {
+				for( size_t cluster = begin; cluster < end; ++cluster ) {
+					const size_t clusterNumTriangles = std::min( clusterSize, numTriangles - cluster * clusterSize );
+					clusters[cluster]->simplify( size_t( clusterNumTriangles * ( target / (double)numIndices ) ) * 3, threshold );
+				}
+			} );
+
+			const size_t previousNumIndices = numClusterIndices;
+			numClusterIndices = 0;
+			for( const auto &cluster : clusters )
+				numClusterIndices += cluster->getIndices().size();
+			// once the locked cluster boundaries stall progress, raising the threshold mostly adds error and the final pass is the better place to finish
+			const size_t numRemoved = levelNumIndices - numClusterIndices;
+			if( numRemoved * 4 >= levelNumIndices - target && ( previousNumIndices - numClusterIndices ) * 8 < numRemoved )
+				break;
+			if( numClusterIndices > target )
+				threshold *= 4;
+		}
+
+		Simplifier level( whole );
+		vector<uint32_t> merged;
+		double maxCost = 0;
+		for( size_t cluster = 0; cluster < numClusters; ++cluster ) {
+			const Simplifier &simplifier = *clusters[cluster];
+			const vector<uint32_t> &vertices = clusterVertices[cluster];
+			for( uint32_t index : simplifier.getIndices() )
+				merged.push_back( vertices[index] );
+			for( uint32_t v = 0; v < vertices.size(); ++v ) {
+				if( ! simplifier.isFirstAtPosition( v ) )
+					continue;
+				if( clusterLocked[cluster][v] ) {
+					Quadric quadric = level.getQuadric( vertices[v] );
+					quadric += simplifier.getQuadric( v );
+					quadric -= clusterLockedQuadrics[cluster][v];
+					level.setQuadric( vertices[v], quadric );
+				}
+				else
+					level.setQuadric( vertices[v], simplifier.getQuadric( v ) );
+			}
+			maxCost = std::max( maxCost, simplifier.getMaxCost() );
+		}
+		level.setIndices( std::move( merged ), maxCost );
+		level.simplify( target );
+		result->emplace_back( level.getIndices(), level.getError() );
+	}
+}
+
+void simplifyImpl( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vector<size_t> &targets, const SimplifyOptions &options, vector<SimplifiedLod> *result )
+{
+	result->clear();
+	const size_t numTriangles = numIndices / 3;
+	if( options.getParallelClusters() > 0 && numTriangles > options.getParallelClusters() * 2 ) {
+		simplifyClustered( numIndices, indices, numVertices, positions, targets, options, result );
+		return;
+	}
+
+	Simplifier simplifier( numIndices, indices, numVertices, positions, options, nullptr, nullptr );
+	for( size_t target : targets ) {
+		simplifier.simplify( target );
+		result->emplace_back( simplifier.getIndices(), simplifier.getError() );
+	}
+}
+
+} // anonymous namespace
+
+float SimplifiedLod::calcScreenSpaceError( float distance, float fovYRadians, float viewportHeight ) const
+{
+	return mError * viewportHeight / ( 2 * distance * tan( fovYRadians / 2 ) );
+}
+
+float simplify( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, size_t targetNumIndices, vector<uint32_t> *resultIndices, const SimplifyOptions &options )
+{
+	vector<SimplifiedLod> lods;
+	simplifyImpl( numIndices, indices, numVertices, positions, vector<size_t>( 1, targetNumIndices ), options, &lods );
+	*resultIndices = lods[0].getIndices();
+	return lods[0].getError();
+}
+
+void simplifyLods( size_t numIndices, const uint32_t *indices, size_t numVertices, const vec3 *positions, const vector<float> &ratios, vector<SimplifiedLod> *resultLods, const SimplifyOptions &options )
+{
+	vector<size_t> targets;
+	for( float ratio : ratios )
+		targets.push_back( size_t( numIndices / 3 * glm::clamp( ratio, 0.0f, 1.0f ) ) * 3 );
+	simplifyImpl( numIndices, indices, numVertices, positions, targets, options, resultLods );
+}
+
+} } // namespace cinder::geom
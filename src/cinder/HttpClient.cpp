@@ -0,0 +1,557 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/HttpClient.h"
+#include "cinder/Stream.h"
+#include "cinder/Utilities.h"
+#include "cinder/Log.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+// curl_multi_poll() and curl_multi_wakeup() were added in 7.66.0 and 7.68.0
+#if LIBCURL_VERSION_NUM >= 0x074400
+	#define CINDER_CURL_MULTI_POLL
+#endif
+
+namespace cinder {
+
+namespace {
+
+const size_t sCacheChunkSize = 65536;
+
+//! Initializes libcurl the first time it's called, and cleans it up at exit
+void initCurl()
+{
+	struct CurlLib {
+		CurlLib()	{ curl_global_init( CURL_GLOBAL_NOTHING ); }
+		~CurlLib()	{ curl_global_cleanup(); }
+	};
+
+	static CurlLib sCurlLib;
+}
+
+//! 64-bit FNV-1a, which unlike std::hash is stable across builds, as the names of cache files need to be
+uint64_t hashString( const std::string &str )
+{
+	uint64_t result = 14695981039346656037ULL;
+	for( char c : str ) {
+		result ^= (uint8_t)c;
+		result *= 1099511628211ULL;
+	}
+
+	return result;
+}
+
+//! Returns the path a transfer writes its response to until it's complete, unique so that concurrent fetches of the same url, including by other processes, don't share it
+fs::path makeCachePartPath( const fs::path &cachePath )
+{
+	static const unsigned long long sProcessId = std::random_device()();
+	static std::atomic<unsigned long long> sNumParts( 0 );
+
+	char suffix[48];
+	std::snprintf( suffix, sizeof( suffix ), ".%08llx-%llx.part", sProcessId, sNumParts++ );
+	return cachePath.string() + suffix;
+}
+
+} // anonymous namespace
+
+// -------------------------------------------------------------------------------------------------
+// HttpTransfer
+// -------------------------------------------------------------------------------------------------
+HttpTransfer::HttpTransfer( HttpClient *client, const Url &url, const std::string &user, const std::string &password, const UrlOptions &options,
+							const DataFn &dataFn, const CompletionFn &completionFn )
+	: mUrl( url ), mUser( user ), mPassword( password ), mOptions( options ), mDataFn( dataFn ), mCompletionFn( completionFn ),
+	mCurl( nullptr ), mCacheFile( nullptr ), mStatusCode( 0 ), mContentLength( -1 ), mBytesReceived( 0 ), mCancelled( false ), mFromCache( false ),
+	mPauseRequested( false ), mPaused( false ), mClient( client ), mComplete( false ), mCompletionCalled( false )
+{
+}
+
+HttpTransfer::~HttpTransfer()
+{
+	if( mCacheFile )
+		std::fclose( mCacheFile );
+	if( mCurl )
+		curl_easy_cleanup( mCurl );
+}
+
+bool HttpTransfer::isComplete() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mComplete;
+}
+
+void HttpTransfer::wait() const
+{
+	std::unique_lock<std::mutex> lock( mMutex );
+	mCompleteCondition.wait( lock, [this] { return mCompletionCalled; } );
+}
+
+bool HttpTransfer::wait( double timeoutSeconds ) const
+{
+	std::unique_lock<std::mutex> lock( mMutex );
+	return mCompleteCondition.wait_for( lock, std::chrono::duration<double>( timeoutSeconds ), [this] { return mCompletionCalled; } );
+}
+
+void HttpTransfer::cancel()
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	if( mComplete )
+		return;
+
+	mCancelled = true;
+	// the client clears mClient under mMutex before it can be destroyed
+	if( mClient )
+		mClient->wakeup();
+}
+
+void HttpTransfer::resume()
+{
+	if( ! mPauseRequested.exchange( false ) )
+		return;
+
+	std::lock_guard<std::mutex> lock( mMutex );
+	if( mClient )
+		mClient->wakeup();
+}
+
+bool HttpTransfer::hasError() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return ! mError.empty();
+}
+
+std::string HttpTransfer::getError() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mError;
+}
+
+BufferRef HttpTransfer::getBody() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mComplete ? mBody : nullptr;
+}
+
+extern "C" {
+
+size_t HttpTransfer::writeCallback( char *buffer, size_t size, size_t nitems, void *userp )
+{
+	HttpTransfer *transfer = static_cast<HttpTransfer*>( userp );
+	size *= nitems;
+	if( transfer->mCancelled )
+		return 0;
+
+	// curl delivers this chunk again once HttpClient::resumeTransfers() unpauses the transfer
+	if( transfer->mPauseRequested ) {
+		transfer->mPaused = true;
+		return CURL_WRITEFUNC_PAUSE;
+	}
+
+	if( ! transfer->mStatusCode ) {
+		long statusCode = 0;
+		curl_easy_getinfo( transfer->mCurl, CURLINFO_RESPONSE_CODE, &statusCode );
+		transfer->mStatusCode = statusCode;
+		curl_off_t contentLength = -1;
+		if( curl_easy_getinfo( transfer->mCurl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength ) == CURLE_OK )
+			transfer->mContentLength = contentLength;
+	}
+
+	// failing to write the cache isn't fatal to the transfer, the response just won't be cached
+	if( transfer->mCacheFile && ( std::fwrite( buffer, 1, size, transfer->mCacheFile ) != size ) ) {
+		std::fclose( transfer->mCacheFile );
+		transfer->mCacheFile = nullptr;
+		std::error_code errorCode;
+		fs::remove( transfer->mCachePartPath, errorCode );
+	}
+
+	transfer->receive( buffer, size );
+	return transfer->mCancelled ? 0 : size;
+}
+
+} // extern "C"
+
+void HttpTransfer::receive( const void *data, size_t size )
+{
+	if( mDataFn ) {
+		if( ! mDataFn( data, size ) )
+			mCancelled = true;
+	}
+	else {
+		// grow geometrically, as Buffer::resize() reallocates to exactly the size requested
+		const size_t offset = mBody->getSize();
+		if( offset + size > mBody->getAllocatedSize() )
+			mBody->resize( std::max( offset + size, mBody->getAllocatedSize() * 2 ) );
+		mBody->setSize( offset + size );
+		std::memcpy( static_cast<uint8_t*>( mBody->getData() ) + offset, data, size );
+	}
+
+	mBytesReceived += size;
+}
+
+void HttpTransfer::finish( const std::string &error )
+{
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mComplete = true;
+		mClient = nullptr;
+		mError = mCancelled ? "Transfer cancelled" : error;
+	}
+
+	if( mCompletionFn ) {
+		try {
+			mCompletionFn( *this );
+		}
+		catch( std::exception &exc ) {
+			CI_LOG_EXCEPTION( "HttpTransfer CompletionFn threw for " << mUrl, exc );
+		}
+	}
+
+	// release anything captured by the callbacks
+	mDataFn = DataFn();
+	mCompletionFn = CompletionFn();
+
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mCompletionCalled = true;
+	}
+	mCompleteCondition.notify_all();
+}
+
+// -------------------------------------------------------------------------------------------------
+// HttpClient
+// -------------------------------------------------------------------------------------------------
+HttpClient::HttpClient( const Options &options )
+	: mOptions( options ), mNumActive( 0 ), mOptionsChanged( true ), mThreadShouldQuit( false )
+{
+	initCurl();
+
+	mMulti = curl_multi_init();
+	if( ! mMulti )
+		throw StreamExc( "Failed to create curl multi handle" );
+
+	mThread = std::thread( &HttpClient::threadEntry, this );
+}
+
+HttpClient::~HttpClient()
+{
+	mThreadShouldQuit = true;
+	wakeup();
+	mThread.join();
+
+	curl_multi_cleanup( mMulti );
+}
+
+HttpClient& HttpClient::instance()
+{
+	static HttpClient sInstance;
+	return sInstance;
+}
+
+void HttpClient::setOptions( const Options &options )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	mOptions = options;
+	mOptionsChanged = true;
+}
+
+HttpClient::Options HttpClient::getOptions() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mOptions;
+}
+
+HttpTransferRef HttpClient::fetch( const Url &url, const HttpTransfer::CompletionFn &completionFn, const UrlOptions &options )
+{
+	return fetch( url, "", "", options, HttpTransfer::DataFn(), completionFn );
+}
+
+HttpTransferRef HttpClient::fetch( const Url &url, const std::string &user, const std::string &password, const UrlOptions &options,
+									const HttpTransfer::DataFn &dataFn, const HttpTransfer::CompletionFn &completionFn )
+{
+	HttpTransferRef transfer( new HttpTransfer( this, url, user, password, options, dataFn, completionFn ) );
+	if( ! dataFn )
+		transfer->mBody = std::make_shared<Buffer>();
+	transfer->mCachePath = getCachePath( url, user, password );
+
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mQueued.push_back( transfer );
+	}
+
+	wakeup();
+	return transfer;
+}
+
+fs::path HttpClient::getCachePath( const Url &url, const std::string &user, const std::string &password ) const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	if( mOptions.getCacheDirectory().empty() )
+		return fs::path();
+
+	// the credentials decide what the server responds with, while neither UrlOptions::getTimeout() nor getIgnoreCache() change the response
+	char name[32];
+	std::snprintf( name, sizeof( name ), "%016llx.cache", (unsigned long long)hashString( user + ':' + password + '@' + url.str() ) );
+	return mOptions.getCacheDirectory() / name;
+}
+
+size_t HttpClient::getNumQueuedTransfers() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mQueued.size();
+}
+
+void HttpClient::wakeup()
+{
+#if defined( CINDER_CURL_MULTI_POLL )
+	curl_multi_wakeup( mMulti );
+#endif
+}
+
+void HttpClient::threadEntry()
+{
+	setThreadName( "cinder::HttpClient" );
+
+	while( ! mThreadShouldQuit ) {
+		startQueuedTransfers();
+		resumeTransfers();
+
+		int stillRunning = 0;
+		curl_multi_perform( mMulti, &stillRunning );
+
+		// the messages don't survive curl_multi_remove_handle(), so collect them before finishing any transfers
+		std::vector<std::pair<CURL*, CURLcode>> done;
+		int messagesLeft = 0;
+		while( CURLMsg *message = curl_multi_info_read( mMulti, &messagesLeft ) ) {
+			if( message->msg == CURLMSG_DONE )
+				done.push_back( std::make_pair( message->easy_handle, message->data.result ) );
+		}
+
+		for( const auto &result : done ) {
+			auto activeIt = std::find_if( mActive.begin(), mActive.end(), [&result]( const HttpTransferRef &transfer ) { return transfer->mCurl == result.first; } );
+			if( activeIt == mActive.end() )
+				continue;
+
+			HttpTransferRef transfer = *activeIt;
+			mActive.erase( activeIt );
+			mNumActive = mActive.size();
+			finishTransfer( transfer, result.second == CURLE_OK ? "" : curl_easy_strerror( result.second ) );
+		}
+
+		// transfers cancelled while in flight, which may not be receiving anything that would notice
+		for( auto activeIt = mActive.begin(); activeIt != mActive.end(); ) {
+			if( (*activeIt)->mCancelled ) {
+				HttpTransferRef transfer = *activeIt;
+				activeIt = mActive.erase( activeIt );
+				mNumActive = mActive.size();
+				finishTransfer( transfer, "" );
+			}
+			else
+				++activeIt;
+		}
+
+#if defined( CINDER_CURL_MULTI_POLL )
+		curl_multi_poll( mMulti, nullptr, 0, 1000, nullptr );
+#else
+		curl_multi_wait( mMulti, nullptr, 0, 20, nullptr );
+#endif
+	}
+
+	std::deque<HttpTransferRef> queued;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		queued.swap( mQueued );
+	}
+
+	for( const HttpTransferRef &transfer : mActive )
+		finishTransfer( transfer, "HttpClient destroyed" );
+	for( const HttpTransferRef &transfer : queued )
+		finishTransfer( transfer, "HttpClient destroyed" );
+	mActive.clear();
+	mNumActive = 0;
+}
+
+void HttpClient::startQueuedTransfers()
+{
+	std::vector<HttpTransferRef> cancelled, toStart;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		if( mOptionsChanged ) {
+			curl_multi_setopt( mMulti, CURLMOPT_MAX_HOST_CONNECTIONS, (long)mOptions.getMaxConnectionsPerHost() );
+			mOptionsChanged = false;
+		}
+
+		for( auto queuedIt = mQueued.begin(); queuedIt != mQueued.end(); ) {
+			if( (*queuedIt)->mCancelled ) {
+				cancelled.push_back( *queuedIt );
+				queuedIt = mQueued.erase( queuedIt );
+			}
+			else
+				++queuedIt;
+		}
+
+		const size_t maxTransfers = std::max<size_t>( mOptions.getMaxTransfers(), 1 );
+		while( ( ! mQueued.empty() ) && ( mActive.size() + toStart.size() < maxTransfers ) ) {
+			toStart.push_back( mQueued.front() );
+			mQueued.pop_front();
+		}
+	}
+
+	for( const HttpTransferRef &transfer : cancelled )
+		finishTransfer( transfer, "" );
+
+	for( const HttpTransferRef &transfer : toStart ) {
+		if( ( ! transfer->mCachePath.empty() ) && ( ! transfer->mOptions.getIgnoreCache() ) && fs::exists( transfer->mCachePath ) )
+			loadFromCache( transfer );
+		else
+			startTransfer( transfer );
+	}
+
+	mNumActive = mActive.size();
+}
+
+void HttpClient::resumeTransfers()
+{
+	for( const HttpTransferRef &transfer : mActive ) {
+		if( transfer->mPaused && ( ! transfer->mPauseRequested ) ) {
+			transfer->mPaused = false;
+			curl_easy_pause( transfer->mCurl, CURLPAUSE_CONT );
+		}
+	}
+}
+
+void HttpClient::startTransfer( const HttpTransferRef &transfer )
+{
+	CURL *curl = curl_easy_init();
+	if( ! curl ) {
+		finishTransfer( transfer, "Failed to create curl handle" );
+		return;
+	}
+
+	transfer->mCurl = curl;
+	curl_easy_setopt( curl, CURLOPT_URL, transfer->mUrl.c_str() );
+	curl_easy_setopt( curl, CURLOPT_PRIVATE, transfer.get() );
+	curl_easy_setopt( curl, CURLOPT_WRITEDATA, transfer.get() );
+	curl_easy_setopt( curl, CURLOPT_WRITEFUNCTION, HttpTransfer::writeCallback );
+	curl_easy_setopt( curl, CURLOPT_VERBOSE, 0L );
+	curl_easy_setopt( curl, CURLOPT_FOLLOWLOCATION, 1L );
+	// signals can't be used for DNS timeouts off the main thread
+	curl_easy_setopt( curl, CURLOPT_NOSIGNAL, 1L );
+
+	// UrlOptions::getTimeout() applies to connecting, and to a stalled transfer, rather than to the whole body
+	const float timeout = transfer->mOptions.getTimeout();
+	if( timeout > 0 ) {
+		curl_easy_setopt( curl, CURLOPT_CONNECTTIMEOUT_MS, (long)( timeout * 1000 ) );
+		curl_easy_setopt( curl, CURLOPT_LOW_SPEED_LIMIT, 1L );
+		curl_easy_setopt( curl, CURLOPT_LOW_SPEED_TIME, (long)std::ceil( timeout ) );
+	}
+
+	if( ( ! transfer->mUser.empty() ) || ( ! transfer->mPassword.empty() ) ) {
+		transfer->mUserColonPassword = transfer->mUser + ":" + transfer->mPassword;
+		curl_easy_setopt( curl, CURLOPT_USERPWD, transfer->mUserColonPassword.c_str() );
+		curl_easy_setopt( curl, CURLOPT_HTTPAUTH, CURLAUTH_ANY );
+	}
+
+	// the response is written beside its final path, and only moved there once it's known to be complete
+	if( ! transfer->mCachePath.empty() ) {
+		std::error_code errorCode;
+		fs::create_directories( transfer->mCachePath.parent_path(), errorCode );
+		transfer->mCachePartPath = makeCachePartPath( transfer->mCachePath );
+		transfer->mCacheFile = std::fopen( transfer->mCachePartPath.string().c_str(), "wb" );
+	}
+
+	if( curl_multi_add_handle( mMulti, curl ) != CURLM_OK ) {
+		finishTransfer( transfer, "Failed to start transfer" );
+		return;
+	}
+
+	mActive.push_back( transfer );
+}
+
+void HttpClient::loadFromCache( const HttpTransferRef &transfer )
+{
+	MappedFileRef mappedFile;
+	try {
+		mappedFile = MappedFile::create( transfer->mCachePath, MappedFile::Access::SEQUENTIAL );
+	}
+	catch( StreamExc & ) {
+		// the cache entry was removed in the meantime
+		startTransfer( transfer );
+		return;
+	}
+
+	transfer->mFromCache = true;
+	transfer->mStatusCode = 200;
+	transfer->mContentLength = (int64_t)mappedFile->getSize();
+	if( transfer->mDataFn ) {
+		const uint8_t *data = static_cast<const uint8_t*>( mappedFile->getData() );
+		for( size_t offset = 0; ( offset < mappedFile->getSize() ) && ( ! transfer->mCancelled ); offset += sCacheChunkSize )
+			transfer->receive( data + offset, std::min( sCacheChunkSize, mappedFile->getSize() - offset ) );
+	}
+	else {
+		// the body views the mapping rather than copying it
+		transfer->mBody = mappedFile->createBuffer();
+		transfer->mBytesReceived = mappedFile->getSize();
+	}
+
+	finishTransfer( transfer, "" );
+}
+
+void HttpClient::finishTransfer( const HttpTransferRef &transfer, const std::string &error )
+{
+	bool succeeded = error.empty() && ( ! transfer->mCancelled );
+	if( transfer->mCurl ) {
+		long statusCode = 0;
+		curl_easy_getinfo( transfer->mCurl, CURLINFO_RESPONSE_CODE, &statusCode );
+		transfer->mStatusCode = statusCode;
+		if( transfer->mContentLength < 0 ) {
+			curl_off_t contentLength = -1;
+			if( curl_easy_getinfo( transfer->mCurl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength ) == CURLE_OK )
+				transfer->mContentLength = contentLength;
+		}
+
+		curl_multi_remove_handle( mMulti, transfer->mCurl );
+		curl_easy_cleanup( transfer->mCurl );
+		transfer->mCurl = nullptr;
+	}
+
+	if( transfer->mCacheFile ) {
+		succeeded = ( std::fclose( transfer->mCacheFile ) == 0 ) && succeeded;
+		transfer->mCacheFile = nullptr;
+
+		std::error_code errorCode;
+		if( succeeded && ( transfer->mStatusCode == 200 ) )
+			fs::rename( transfer->mCachePartPath, transfer->mCachePath, errorCode );
+		else
+			fs::remove( transfer->mCachePartPath, errorCode );
+	}
+
+	transfer->finish( error );
+}
+
+} // namespace cinder
@@ -28,10 +28,13 @@
 #include "jsoncpp/json.h"
 
 #include "cinder/Json.h"
+#include "cinder/JsonDocument.h"
 #include "cinder/Stream.h"
 #include "cinder/Utilities.h"
 
 #include <cstdlib>
+#include <cmath>
+#include <limits>
 
 using namespace std;
 
@@ -151,6 +154,17 @@ JsonTree::JsonTree( const std::string &key, const Json::Value &value )
 {
 	init( key, value, true, NODE_VALUE );
 }
+
+JsonTree::JsonTree( const json::Document &document )
+{
+	const json::Value &root = document.getRoot();
+	if( root.isArray() )
+		init( "", root, NODE_ARRAY );
+	else if( root.isObject() )
+		init( "", root, NODE_OBJECT );
+	else
+		init( "", root, NODE_NULL );
+}
     
 JsonTree::JsonTree( const string &key, bool value )
 {
@@ -273,6 +287,64 @@ void JsonTree::init( const string &key, const Json::Value &value, bool setType,
 	}
 }
 
+// Mirrors the typing of the Json::Value overload above, where numbers representable as a 32-bit int or uint are integral regardless of how they were written
+void JsonTree::init( const string &key, const json::Value &value, NodeType nodeType )
+{
+	mKey = key;
+	mNodeType = nodeType;
+	mParent = 0;
+	mValue = "";
+	mValueType = VALUE_STRING;
+
+	// children are constructed in place rather than through pushBack(), which would copy each subtree
+	switch( value.getType() ) {
+		case json::Value::TYPE_ARRAY:
+			mNodeType = NODE_ARRAY;
+			for( const json::Value *it = value.beginElements(); it != value.endElements(); ++it ) {
+				mChildren.emplace_back();
+				mChildren.back().init( "", *it, NODE_VALUE );
+				mChildren.back().mParent = this;
+			}
+		break;
+		case json::Value::TYPE_OBJECT:
+			mNodeType = NODE_OBJECT;
+			for( const json::Member *it = value.beginMembers(); it != value.endMembers(); ++it ) {
+				mChildren.emplace_back();
+				mChildren.back().init( string( it->getKey(), it->getKeyLength() ), it->getValue(), NODE_VALUE );
+				mChildren.back().mParent = this;
+			}
+		break;
+		case json::Value::TYPE_BOOL:
+			mValue = toString( value.getBool() );
+			mValueType = VALUE_BOOL;
+		break;
+		case json::Value::TYPE_STRING:
+			mValue.assign( value.getString(), value.getStringLength() );
+		break;
+		case json::Value::TYPE_INT:
+		case json::Value::TYPE_UINT:
+		case json::Value::TYPE_DOUBLE: {
+			const double d = value.getDouble();
+			const bool integral = value.getType() != json::Value::TYPE_DOUBLE || d == std::floor( d );
+			if( integral && d >= numeric_limits<int32_t>::min() && d <= numeric_limits<int32_t>::max() ) {
+				mValue = toString( (int64_t)d );
+				mValueType = VALUE_INT;
+			}
+			else if( integral && d >= 0 && d <= numeric_limits<uint32_t>::max() ) {
+				mValue = toString( (uint64_t)d );
+				mValueType = VALUE_UINT;
+			}
+			else {
+				mValue = toString( d );
+				mValueType = VALUE_DOUBLE;
+			}
+		}
+		break;
+		default:
+		break;
+	}
+}
+
 //! Converts a JSON string into a JsonCpp object
 Json::Value JsonTree::deserializeNative( const string &jsonString, ParseOptions parseOptions )
 {
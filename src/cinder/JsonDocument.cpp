@@ -0,0 +1,1103 @@
+/*
+ Copyright (c) 2018, The Cinder Project
+ All rights reserved.
+
+ This code is designed for use with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+	* Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/JsonDocument.h"
+
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+using namespace std;
+
+namespace cinder { namespace json {
+
+namespace {
+
+const size_t	NUM_MEMBERS_HASH_THRESHOLD = 8;		// objects with more members than this get a hash index
+const size_t	ARENA_BLOCK_SIZE = 64 * 1024;
+
+// FNV-1a
+uint32_t hashKey( const char *key, size_t length )
+{
+	uint32_t hash = 2166136261u;
+	for( size_t i = 0; i < length; i++ ) {
+		hash ^= static_cast<uint8_t>( key[i] );
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+size_t getHashTableCapacity( size_t numMembers )
+{
+	size_t capacity = 16;
+	while( capacity < numMembers * 2 )
+		capacity *= 2;
+	return capacity;
+}
+
+inline bool isWhitespace( char c )
+{
+	return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
+
+inline bool isNumberChar( char c )
+{
+	return isDigit( c ) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+int hexDigitValue( char c )
+{
+	if( c >= '0' && c <= '9' )
+		return c - '0';
+	if( c >= 'a' && c <= 'f' )
+		return c - 'a' + 10;
+	if( c >= 'A' && c <= 'F' )
+		return c - 'A' + 10;
+	return -1;
+}
+
+// Writes the UTF-8 encoding of \a codepoint to \a dst, returns the number of bytes written (at most 4).
+size_t encodeUtf8( uint32_t codepoint, char *dst )
+{
+	if( codepoint < 0x80 ) {
+		dst[0] = static_cast<char>( codepoint );
+		return 1;
+	}
+	else if( codepoint < 0x800 ) {
+		dst[0] = static_cast<char>( 0xC0 | ( codepoint >> 6 ) );
+		dst[1] = static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+		return 2;
+	}
+	else if( codepoint < 0x10000 ) {
+		dst[0] = static_cast<char>( 0xE0 | ( codepoint >> 12 ) );
+		dst[1] = static_cast<char>( 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+		dst[2] = static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+		return 3;
+	}
+	else {
+		dst[0] = static_cast<char>( 0xF0 | ( codepoint >> 18 ) );
+		dst[1] = static_cast<char>( 0x80 | ( ( codepoint >> 12 ) & 0x3F ) );
+		dst[2] = static_cast<char>( 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+		dst[3] = static_cast<char>( 0x80 | ( codepoint & 0x3F ) );
+		return 4;
+	}
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------------------------------
+// Reader::Impl
+// ----------------------------------------------------------------------------------------------------
+
+class Reader::Impl {
+  public:
+	Impl( const Reader::Options &options )
+		: mOptions( options )
+	{}
+
+	//! Parses [begin, end). If \a stream is non-null, the range is a window onto it that is refilled as needed.
+	bool run( char *begin, char *end, bool isMutable, IStreamCinder *stream, Handler *handler )
+	{
+		mBegin = begin;
+		mCur = begin;
+		mEnd = end;
+		mMutable = isMutable;
+		mStream = stream;
+		mHandler = handler;
+		mNumDiscardedLines = 0;
+		mNumDiscardedColumns = 0;
+		mFrames.clear();
+
+		if( mStream ) {
+			mChunk.resize( std::max<size_t>( mOptions.getChunkSize(), 16 ) );
+			mBegin = mCur = mEnd = mChunk.data();
+			fill( 0 );
+		}
+
+		// skip UTF-8 byte order mark
+		if( ensure( 3 ) && memcmp( mCur, "\xEF\xBB\xBF", 3 ) == 0 )
+			mCur += 3;
+
+		skipWhitespace();
+		if( mCur == mEnd )
+			throwError( "Unexpected end of input, expected a value" );
+
+		return parseDocument();
+	}
+
+  private:
+	bool parseDocument()
+	{
+		while( true ) {
+			// parse a single value, descending into arrays and objects
+			bool valueComplete = true;
+			switch( *mCur ) {
+				case '{':
+					mCur++;
+					if( ! mHandler->onStartObject() )
+						return false;
+					skipWhitespace();
+					if( peek() == '}' ) {
+						mCur++;
+						if( ! mHandler->onEndObject( 0 ) )
+							return false;
+					}
+					else {
+						pushFrame( true );
+						if( ! parseKey() )
+							return false;
+						valueComplete = false;
+					}
+				break;
+				case '[':
+					mCur++;
+					if( ! mHandler->onStartArray() )
+						return false;
+					skipWhitespace();
+					if( peek() == ']' ) {
+						mCur++;
+						if( ! mHandler->onEndArray( 0 ) )
+							return false;
+					}
+					else {
+						pushFrame( false );
+						valueComplete = false;
+					}
+				break;
+				case '"':
+					if( ! parseString( false ) )
+						return false;
+				break;
+				case 't':
+					if( ! parseLiteral( "true", 4 ) || ! mHandler->onBool( true ) )
+						return false;
+				break;
+				case 'f':
+					if( ! parseLiteral( "false", 5 ) || ! mHandler->onBool( false ) )
+						return false;
+				break;
+				case 'n':
+					if( ! parseLiteral( "null", 4 ) || ! mHandler->onNull() )
+						return false;
+				break;
+				default:
+					if( *mCur == '-' || isDigit( *mCur ) ) {
+						if( ! parseNumber() )
+							return false;
+					}
+					else
+						throwError( "Unexpected character, expected a value" );
+			}
+
+			if( ! valueComplete ) {
+				skipWhitespace();
+				if( mCur == mEnd )
+					throwError( "Unexpected end of input, expected a value" );
+				continue;
+			}
+
+			// the value is complete, close as many containers as necessary
+			while( true ) {
+				skipWhitespace();
+				if( mFrames.empty() ) {
+					if( mCur != mEnd )
+						throwError( "Unexpected characters after the root value" );
+					return true;
+				}
+
+				Frame &frame = mFrames.back();
+				frame.mCount++;
+
+				const char c = peek();
+				if( c == ',' ) {
+					mCur++;
+					skipWhitespace();
+					if( frame.mIsObject && ! parseKey() )
+						return false;
+					skipWhitespace();
+					if( mCur == mEnd )
+						throwError( "Unexpected end of input, expected a value" );
+					break;
+				}
+				else if( frame.mIsObject && c == '}' ) {
+					mCur++;
+					const size_t count = frame.mCount;
+					mFrames.pop_back();
+					if( ! mHandler->onEndObject( count ) )
+						return false;
+				}
+				else if( ! frame.mIsObject && c == ']' ) {
+					mCur++;
+					const size_t count = frame.mCount;
+					mFrames.pop_back();
+					if( ! mHandler->onEndArray( count ) )
+						return false;
+				}
+				else
+					throwError( frame.mIsObject ? "Expected ',' or '}'" : "Expected ',' or ']'" );
+			}
+		}
+	}
+
+	void pushFrame( bool isObject )
+	{
+		if( mFrames.size() >= mOptions.getMaxDepth() )
+			throwError( "Maximum nesting depth exceeded" );
+
+		mFrames.push_back( { isObject, 0 } );
+	}
+
+	//! Parses a member key and the following ':', leaving mCur at the member value.
+	bool parseKey()
+	{
+		if( peek() != '"' )
+			throwError( "Expected a string as object key" );
+		if( ! parseString( true ) )
+			return false;
+
+		skipWhitespace();
+		if( peek() != ':' )
+			throwError( "Expected ':' after object key" );
+		mCur++;
+		skipWhitespace();
+		return true;
+	}
+
+	bool parseLiteral( const char *literal, size_t length )
+	{
+		if( ! ensure( length ) || memcmp( mCur, literal, length ) != 0 )
+			throwError( "Invalid literal" );
+
+		mCur += length;
+		return true;
+	}
+
+	bool parseString( bool isKey )
+	{
+		mCur++; // opening quote
+		size_t start = mCur - mBegin;
+		size_t write = start;
+		bool hasEscapes = false;
+
+		while( true ) {
+			if( mCur == mEnd ) {
+				size_t shift;
+				const bool filled = fill( start, &shift );
+				start -= shift;
+				write -= shift;
+				if( ! filled )
+					throwError( "Unexpected end of input within string" );
+			}
+
+			const char c = *mCur;
+			if( c == '"' )
+				break;
+
+			if( c != '\\' ) {
+				if( hasEscapes ) {
+					if( mMutable )
+						mBegin[write++] = c;
+					else
+						mScratch.push_back( c );
+				}
+				mCur++;
+				continue;
+			}
+
+			// escape sequence, make sure the longest possible one (a surrogate pair) is within the buffer
+			if( mEnd - mCur < 12 ) {
+				size_t shift;
+				fill( start, &shift );
+				start -= shift;
+				write -= shift;
+			}
+
+			if( ! hasEscapes ) {
+				hasEscapes = true;
+				write = mCur - mBegin;
+				if( ! mMutable )
+					mScratch.assign( mBegin + start, mCur );
+			}
+
+			char decoded[4];
+			size_t decodedLength = decodeEscape( decoded );
+			if( mMutable ) {
+				memcpy( mBegin + write, decoded, decodedLength );
+				write += decodedLength;
+			}
+			else
+				mScratch.append( decoded, decodedLength );
+		}
+
+		const char *str;
+		size_t length;
+		if( ! hasEscapes ) {
+			str = mBegin + start;
+			length = ( mCur - mBegin ) - start;
+			if( mMutable )
+				*mCur = 0; // null-terminate in place of the closing quote
+		}
+		else if( mMutable ) {
+			str = mBegin + start;
+			length = write - start;
+			mBegin[write] = 0;
+		}
+		else {
+			str = mScratch.data();
+			length = mScratch.size();
+		}
+
+		mCur++; // closing quote
+		return isKey ? mHandler->onKey( str, length ) : mHandler->onString( str, length );
+	}
+
+	//! Decodes the escape sequence at mCur into \a dst, returning the number of bytes written.
+	size_t decodeEscape( char *dst )
+	{
+		if( mEnd - mCur < 2 )
+			throwError( "Unexpected end of input within string" );
+
+		const char c = mCur[1];
+		mCur += 2;
+		switch( c ) {
+			case '"':	dst[0] = '"'; return 1;
+			case '\\':	dst[0] = '\\'; return 1;
+			case '/':	dst[0] = '/'; return 1;
+			case 'b':	dst[0] = '\b'; return 1;
+			case 'f':	dst[0] = '\f'; return 1;
+			case 'n':	dst[0] = '\n'; return 1;
+			case 'r':	dst[0] = '\r'; return 1;
+			case 't':	dst[0] = '\t'; return 1;
+			case 'u': {
+				uint32_t codepoint = parseHex4();
+				if( codepoint >= 0xD800 && codepoint <= 0xDBFF ) {
+					// high surrogate, must be followed by a low surrogate
+					if( mEnd - mCur < 6 || mCur[0] != '\\' || mCur[1] != 'u' )
+						throwError( "Invalid unicode surrogate pair" );
+					mCur += 2;
+					const uint32_t low = parseHex4();
+					if( low < 0xDC00 || low > 0xDFFF )
+						throwError( "Invalid unicode surrogate pair" );
+					codepoint = 0x10000 + ( ( codepoint - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+				}
+				return encodeUtf8( codepoint, dst );
+			}
+			default:
+				mCur -= 2;
+				throwError( "Invalid escape sequence" );
+		}
+		return 0;
+	}
+
+	uint32_t parseHex4()
+	{
+		if( mEnd - mCur < 4 )
+			throwError( "Unexpected end of input within unicode escape" );
+
+		uint32_t result = 0;
+		for( int i = 0; i < 4; i++ ) {
+			const int digit = hexDigitValue( mCur[i] );
+			if( digit < 0 )
+				throwError( "Invalid unicode escape" );
+			result = ( result << 4 ) | digit;
+		}
+		mCur += 4;
+		return result;
+	}
+
+	bool parseNumber()
+	{
+		// gather the whole token first, so that it is contiguous when reading from a stream
+		size_t start = mCur - mBegin;
+		while( true ) {
+			while( mCur < mEnd && isNumberChar( *mCur ) )
+				mCur++;
+
+			if( mCur != mEnd )
+				break;
+
+			size_t shift;
+			const bool filled = fill( start, &shift );
+			start -= shift;
+			if( ! filled )
+				break;
+		}
+
+		const char *p = mBegin + start;
+		const char *end = mCur;
+
+		const bool negative = *p == '-';
+		if( negative )
+			p++;
+
+		// integer part
+		if( p == end || ! isDigit( *p ) )
+			throwNumberError( start );
+		if( *p == '0' && p + 1 < end && isDigit( p[1] ) )
+			throwNumberError( start );
+
+		// digits that no longer fit into the mantissa are only accounted for in the exponent, and force the slow path below
+		const uint64_t maxMantissa = numeric_limits<uint64_t>::max();
+		uint64_t mantissa = 0;
+		int exponent = 0;
+		bool mantissaOverflow = false;
+		for( ; p < end && isDigit( *p ); p++ ) {
+			const uint64_t digit = *p - '0';
+			if( ! mantissaOverflow && mantissa <= ( maxMantissa - digit ) / 10 )
+				mantissa = mantissa * 10 + digit;
+			else {
+				mantissaOverflow = true;
+				exponent++;
+			}
+		}
+
+		bool isIntegral = true;
+		if( p < end && *p == '.' ) {
+			isIntegral = false;
+			p++;
+			if( p == end || ! isDigit( *p ) )
+				throwNumberError( start );
+			for( ; p < end && isDigit( *p ); p++ ) {
+				const uint64_t digit = *p - '0';
+				if( ! mantissaOverflow && mantissa <= ( maxMantissa - digit ) / 10 ) {
+					mantissa = mantissa * 10 + digit;
+					exponent--;
+				}
+				else
+					mantissaOverflow = true;
+			}
+		}
+
+		if( p < end && ( *p == 'e' || *p == 'E' ) ) {
+			isIntegral = false;
+			p++;
+			bool negativeExponent = false;
+			if( p < end && ( *p == '+' || *p == '-' ) )
+				negativeExponent = *p++ == '-';
+			if( p == end || ! isDigit( *p ) )
+				throwNumberError( start );
+
+			int exponentValue = 0;
+			for( ; p < end && isDigit( *p ); p++ ) {
+				if( exponentValue < 100000 )
+					exponentValue = exponentValue * 10 + ( *p - '0' );
+			}
+			exponent += negativeExponent ? -exponentValue : exponentValue;
+		}
+
+		if( p != end )
+			throwNumberError( start );
+
+		if( isIntegral && ! mantissaOverflow ) {
+			if( ! negative )
+				return mHandler->onUint( mantissa );
+			else if( mantissa <= uint64_t( numeric_limits<int64_t>::max() ) + 1 )
+				return mHandler->onInt( static_cast<int64_t>( 0 - mantissa ) );
+		}
+
+		// fast path for doubles that can be computed exactly, otherwise fall back on the standard library
+		static const double sPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+												1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		double result;
+		if( ! mantissaOverflow && mantissa <= ( uint64_t( 1 ) << 53 ) && exponent >= -22 && exponent <= 22 ) {
+			result = static_cast<double>( mantissa );
+			result = exponent < 0 ? result / sPowersOf10[-exponent] : result * sPowersOf10[exponent];
+			if( negative )
+				result = -result;
+		}
+		else {
+			istringstream stream( string( static_cast<const char *>( mBegin + start ), end ) );
+			stream.imbue( locale::classic() );
+			stream >> result;
+		}
+
+		return mHandler->onDouble( result );
+	}
+
+	void skipWhitespace()
+	{
+		while( true ) {
+			while( mCur < mEnd && isWhitespace( *mCur ) )
+				mCur++;
+
+			if( mCur == mEnd ) {
+				if( ! fill( mCur - mBegin ) )
+					return;
+				continue;
+			}
+
+			if( *mCur != '/' || ! mOptions.getAllowComments() )
+				return;
+
+			if( ! ensure( 2 ) )
+				throwError( "Unexpected character" );
+
+			if( mCur[1] == '/' ) {
+				mCur += 2;
+				while( true ) {
+					while( mCur < mEnd && *mCur != '\n' )
+						mCur++;
+					if( mCur != mEnd || ! fill( mCur - mBegin ) )
+						break;
+				}
+			}
+			else if( mCur[1] == '*' ) {
+				mCur += 2;
+				while( true ) {
+					if( ! ensure( 2 ) )
+						throwError( "Unterminated comment" );
+					if( mCur[0] == '*' && mCur[1] == '/' ) {
+						mCur += 2;
+						break;
+					}
+					mCur++;
+				}
+			}
+			else
+				throwError( "Unexpected character" );
+		}
+	}
+
+	char peek()
+	{
+		if( mCur == mEnd )
+			fill( mCur - mBegin );
+		return mCur < mEnd ? *mCur : 0;
+	}
+
+	//! Makes sure at least \a size bytes are available at mCur, returns false if the input ends before that.
+	bool ensure( size_t size )
+	{
+		while( size_t( mEnd - mCur ) < size ) {
+			if( ! fill( mCur - mBegin ) )
+				return false;
+		}
+		return true;
+	}
+
+	bool fill( size_t keepOffset )
+	{
+		size_t shift;
+		return fill( keepOffset, &shift );
+	}
+
+	//! Discards the input before \a keepOffset and reads the next chunk of the stream. \a shift is set to the number of bytes
+	//! that remaining input moved towards the beginning of the buffer. Returns false when there is no more input.
+	bool fill( size_t keepOffset, size_t *shift )
+	{
+		*shift = 0;
+		if( ! mStream || mStream->isEof() )
+			return false;
+
+		// keep track of the discarded input for error reporting
+		for( const char *p = mBegin; p < mBegin + keepOffset; p++ ) {
+			if( *p == '\n' ) {
+				mNumDiscardedLines++;
+				mNumDiscardedColumns = 0;
+			}
+			else
+				mNumDiscardedColumns++;
+		}
+
+		const size_t curOffset = mCur - mBegin;
+		const size_t numKept = ( mEnd - mBegin ) - keepOffset;
+		memmove( mChunk.data(), mChunk.data() + keepOffset, numKept );
+
+		// grow when a single token occupies most of the buffer
+		if( numKept > mChunk.size() / 2 )
+			mChunk.resize( mChunk.size() * 2 );
+
+		const size_t numRead = mStream->readDataAvailable( mChunk.data() + numKept, mChunk.size() - numKept );
+
+		mBegin = mChunk.data();
+		mCur = mBegin + curOffset - keepOffset;
+		mEnd = mBegin + numKept + numRead;
+		*shift = keepOffset;
+		return numRead > 0;
+	}
+
+	void throwNumberError( size_t start )
+	{
+		mCur = mBegin + start;
+		throwError( "Invalid number" );
+	}
+
+	[[noreturn]] void throwError( const char *message )
+	{
+		size_t line = mNumDiscardedLines + 1;
+		size_t column = mNumDiscardedColumns + 1;
+		for( const char *p = mBegin; p < mCur; p++ ) {
+			if( *p == '\n' ) {
+				line++;
+				column = 1;
+			}
+			else
+				column++;
+		}
+
+		throw ExcParseError( message, line, column );
+	}
+
+	struct Frame {
+		bool	mIsObject;
+		size_t	mCount;
+	};
+
+	Reader::Options		mOptions;
+
+	char				*mBegin, *mCur, *mEnd;
+	bool				mMutable;
+	IStreamCinder		*mStream;
+	Handler				*mHandler;
+	size_t				mNumDiscardedLines, mNumDiscardedColumns;
+
+	std::vector<Frame>	mFrames;
+	std::vector<char>	mChunk;
+	std::string			mScratch;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// Reader
+// ----------------------------------------------------------------------------------------------------
+
+Reader::Reader( const Options &options )
+	: mOptions( options ), mImpl( new Impl( options ) )
+{
+}
+
+Reader::~Reader()
+{
+}
+
+bool Reader::parse( const char *data, size_t size, Handler *handler )
+{
+	// the input is never written to when parsing isn't mutable
+	char *begin = const_cast<char *>( data );
+	return mImpl->run( begin, begin + size, false, nullptr, handler );
+}
+
+bool Reader::parse( const IStreamRef &stream, Handler *handler )
+{
+	return mImpl->run( nullptr, nullptr, true, stream.get(), handler );
+}
+
+bool Reader::parse( const DataSourceRef &dataSource, Handler *handler )
+{
+	return parse( dataSource->createStream(), handler );
+}
+
+bool Reader::parseInSitu( char *data, size_t size, Handler *handler )
+{
+	return mImpl->run( data, data + size, true, nullptr, handler );
+}
+
+// ----------------------------------------------------------------------------------------------------
+// Value
+// ----------------------------------------------------------------------------------------------------
+
+bool Value::getBool() const
+{
+	if( ! isBool() )
+		throw ExcTypeMismatch( "Value is not a bool" );
+
+	return mBool;
+}
+
+int64_t Value::getInt() const
+{
+	switch( mType ) {
+		case TYPE_INT:		return mInt;
+		case TYPE_UINT:		return static_cast<int64_t>( mUint );
+		case TYPE_DOUBLE:	return static_cast<int64_t>( mDouble );
+		default:			throw ExcTypeMismatch( "Value is not a number" );
+	}
+}
+
+uint64_t Value::getUint() const
+{
+	switch( mType ) {
+		case TYPE_INT:		return static_cast<uint64_t>( mInt );
+		case TYPE_UINT:		return mUint;
+		case TYPE_DOUBLE:	return static_cast<uint64_t>( mDouble );
+		default:			throw ExcTypeMismatch( "Value is not a number" );
+	}
+}
+
+double Value::getDouble() const
+{
+	switch( mType ) {
+		case TYPE_INT:		return static_cast<double>( mInt );
+		case TYPE_UINT:		return static_cast<double>( mUint );
+		case TYPE_DOUBLE:	return mDouble;
+		default:			throw ExcTypeMismatch( "Value is not a number" );
+	}
+}
+
+const char* Value::getString() const
+{
+	if( ! isString() )
+		throw ExcTypeMismatch( "Value is not a string" );
+
+	return mString;
+}
+
+const Value& Value::operator[]( size_t index ) const
+{
+	if( index >= getSize() )
+		throw ExcChildNotFound( "Index " + to_string( index ) + " out of range" );
+
+	return isArray() ? mElements[index] : mMembers[index].mValue;
+}
+
+const Value& Value::operator[]( const std::string &key ) const
+{
+	const Value *result = find( key );
+	if( ! result )
+		throw ExcChildNotFound( "Key '" + key + "' not found" );
+
+	return *result;
+}
+
+const uint32_t* Value::getHashTable() const
+{
+	if( ! isObject() || mSize <= NUM_MEMBERS_HASH_THRESHOLD )
+		return nullptr;
+
+	return reinterpret_cast<const uint32_t *>( mMembers + mSize );
+}
+
+const Value* Value::find( const char *key, size_t keyLength ) const
+{
+	if( ! isObject() )
+		return nullptr;
+
+	const uint32_t hash = hashKey( key, keyLength );
+	const uint32_t *table = getHashTable();
+	if( table ) {
+		const size_t mask = getHashTableCapacity( mSize ) - 1;
+		for( size_t slot = hash & mask; table[slot] != 0; slot = ( slot + 1 ) & mask ) {
+			const Member &member = mMembers[table[slot] - 1];
+			if( member.mKeyHash == hash && member.mKeyLength == keyLength && memcmp( member.mKey, key, keyLength ) == 0 )
+				return &member.mValue;
+		}
+	}
+	else {
+		for( const Member *member = mMembers; member < mMembers + mSize; ++member ) {
+			if( member->mKeyHash == hash && member->mKeyLength == keyLength && memcmp( member->mKey, key, keyLength ) == 0 )
+				return &member->mValue;
+		}
+	}
+
+	return nullptr;
+}
+
+const Value* Value::findPath( const std::string &relativePath, char separator ) const
+{
+	const Value *result = this;
+	size_t start = 0;
+	while( result && start <= relativePath.size() ) {
+		size_t end = relativePath.find( separator, start );
+		if( end == string::npos )
+			end = relativePath.size();
+
+		const char *component = relativePath.data() + start;
+		const size_t componentLength = end - start;
+		if( result->isArray() ) {
+			size_t index = 0;
+			bool isIndex = componentLength > 0;
+			for( size_t i = 0; i < componentLength && isIndex; i++ ) {
+				isIndex = isDigit( component[i] );
+				index = index * 10 + ( component[i] - '0' );
+			}
+			result = ( isIndex && index < result->mSize ) ? &result->mElements[index] : nullptr;
+		}
+		else
+			result = result->find( component, componentLength );
+
+		start = end + 1;
+	}
+
+	return result;
+}
+
+const Value& Value::getChild( const std::string &relativePath, char separator ) const
+{
+	const Value *result = findPath( relativePath, separator );
+	if( ! result )
+		throw ExcChildNotFound( "Child '" + relativePath + "' not found" );
+
+	return *result;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// DocumentBuilder
+// ----------------------------------------------------------------------------------------------------
+
+//! Builds a Document from the events of an in-situ Reader. Values are gathered on a stack and moved into contiguous arena
+//! storage once their parent array or object is complete.
+class DocumentBuilder : public Handler {
+  public:
+	DocumentBuilder( Document::Arena *arena )
+		: mArena( arena ), mPendingKey( nullptr ), mPendingKeyLength( 0 ), mPendingKeyHash( 0 )
+	{
+		mStack.reserve( 256 );
+	}
+
+	bool onNull() override
+	{
+		push();
+		return true;
+	}
+
+	bool onBool( bool value ) override
+	{
+		Value &v = push();
+		v.mType = Value::TYPE_BOOL;
+		v.mBool = value;
+		return true;
+	}
+
+	bool onInt( int64_t value ) override
+	{
+		Value &v = push();
+		v.mType = Value::TYPE_INT;
+		v.mInt = value;
+		return true;
+	}
+
+	bool onUint( uint64_t value ) override
+	{
+		Value &v = push();
+		v.mType = Value::TYPE_UINT;
+		v.mUint = value;
+		return true;
+	}
+
+	bool onDouble( double value ) override
+	{
+		Value &v = push();
+		v.mType = Value::TYPE_DOUBLE;
+		v.mDouble = value;
+		return true;
+	}
+
+	bool onString( const char *str, size_t length ) override
+	{
+		Value &v = push();
+		v.mType = Value::TYPE_STRING;
+		v.mString = str;
+		v.mSize = static_cast<uint32_t>( length );
+		return true;
+	}
+
+	bool onKey( const char *str, size_t length ) override
+	{
+		mPendingKey = str;
+		mPendingKeyLength = static_cast<uint32_t>( length );
+		mPendingKeyHash = hashKey( str, length );
+		return true;
+	}
+
+	bool onStartObject() override
+	{
+		mContainers.push_back( mStack.size() );
+		push().mType = Value::TYPE_OBJECT;
+		return true;
+	}
+
+	bool onEndObject( size_t numMembers ) override
+	{
+		const size_t containerIndex = mContainers.back();
+		mContainers.pop_back();
+
+		const size_t tableCapacity = numMembers > NUM_MEMBERS_HASH_THRESHOLD ? getHashTableCapacity( numMembers ) : 0;
+		auto members = static_cast<Member *>( mArena->allocate( numMembers * sizeof( Member ) + tableCapacity * sizeof( uint32_t ) ) );
+		memcpy( members, mStack.data() + containerIndex + 1, numMembers * sizeof( Member ) );
+
+		if( tableCapacity ) {
+			auto table = reinterpret_cast<uint32_t *>( members + numMembers );
+			memset( table, 0, tableCapacity * sizeof( uint32_t ) );
+			const size_t mask = tableCapacity - 1;
+			for( size_t i = 0; i < numMembers; i++ ) {
+				size_t slot = members[i].mKeyHash & mask;
+				while( table[slot] != 0 )
+					slot = ( slot + 1 ) & mask;
+				table[slot] = static_cast<uint32_t>( i + 1 );
+			}
+		}
+
+		mStack.resize( containerIndex + 1 );
+		Value &object = mStack.back().mValue;
+		object.mMembers = members;
+		object.mSize = static_cast<uint32_t>( numMembers );
+		return true;
+	}
+
+	bool onStartArray() override
+	{
+		mContainers.push_back( mStack.size() );
+		push().mType = Value::TYPE_ARRAY;
+		return true;
+	}
+
+	bool onEndArray( size_t numElements ) override
+	{
+		const size_t containerIndex = mContainers.back();
+		mContainers.pop_back();
+
+		auto elements = static_cast<Value *>( mArena->allocate( numElements * sizeof( Value ) ) );
+		for( size_t i = 0; i < numElements; i++ )
+			elements[i] = mStack[containerIndex + 1 + i].mValue;
+
+		mStack.resize( containerIndex + 1 );
+		Value &array = mStack.back().mValue;
+		array.mElements = elements;
+		array.mSize = static_cast<uint32_t>( numElements );
+		return true;
+	}
+
+	const Value& getRoot() const	{ return mStack.front().mValue; }
+
+  private:
+	//! Pushes a null value, keyed with the pending key if it is an object member.
+	Value& push()
+	{
+		mStack.emplace_back();
+		Member &member = mStack.back();
+		member.mKey = mPendingKey;
+		member.mKeyLength = mPendingKeyLength;
+		member.mKeyHash = mPendingKeyHash;
+		mPendingKey = nullptr;
+		mPendingKeyLength = 0;
+		mPendingKeyHash = 0;
+		return member.mValue;
+	}
+
+	Document::Arena		*mArena;
+	std::vector<Member>	mStack;
+	std::vector<size_t>	mContainers;
+
+	const char			*mPendingKey;
+	uint32_t			mPendingKeyLength, mPendingKeyHash;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// Document
+// ----------------------------------------------------------------------------------------------------
+
+void* Document::Arena::allocate( size_t size )
+{
+	size = ( size + 7 ) & ~size_t( 7 );
+	if( size > mRemaining ) {
+		const size_t blockSize = std::max( size, ARENA_BLOCK_SIZE );
+		mBlocks.emplace_back( new char[blockSize] );
+		mCurrent = mBlocks.back().get();
+		mRemaining = blockSize;
+		mAllocatedSize += blockSize;
+	}
+
+	void *result = mCurrent;
+	mCurrent += size;
+	mRemaining -= size;
+	return result;
+}
+
+Document::Document()
+{
+}
+
+Document::Document( const DataSourceRef &dataSource, const Reader::Options &options )
+{
+	BufferRef buffer = dataSource->getBuffer();
+	mSource = Buffer::create( buffer->getSize() + 1 );
+	mSource->copyFrom( buffer->getData(), buffer->getSize() );
+	mSource->setSize( buffer->getSize() );
+
+	parse( options );
+}
+
+Document::Document( const std::string &jsonString, const Reader::Options &options )
+{
+	mSource = Buffer::create( jsonString.size() + 1 );
+	mSource->copyFrom( jsonString.data(), jsonString.size() );
+	mSource->setSize( jsonString.size() );
+
+	parse( options );
+}
+
+Document::Document( BufferRef buffer, const Reader::Options &options )
+	: mSource( buffer )
+{
+	parse( options );
+}
+
+Document::Document( Document &&rhs )
+	: mSource( std::move( rhs.mSource ) ), mArena( std::move( rhs.mArena ) ), mRoot( rhs.mRoot )
+{
+	rhs.mArena = Arena();
+	rhs.mRoot = Value();
+}
+
+Document& Document::operator=( Document &&rhs )
+{
+	if( this != &rhs ) {
+		mSource = std::move( rhs.mSource );
+		mArena = std::move( rhs.mArena );
+		mRoot = rhs.mRoot;
+		rhs.mArena = Arena();
+		rhs.mRoot = Value();
+	}
+
+	return *this;
+}
+
+void Document::parse( const Reader::Options &options )
+{
+	DocumentBuilder builder( &mArena );
+	Reader reader( options );
+	reader.parseInSitu( static_cast<char *>( mSource->getData() ), mSource->getSize(), &builder );
+	mRoot = builder.getRoot();
+}
+
+size_t Document::getMemoryUsage() const
+{
+	return mArena.getAllocatedSize() + ( mSource ? mSource->getAllocatedSize() : 0 );
+}
+
+// ----------------------------------------------------------------------------------------------------
+// Exceptions
+// ----------------------------------------------------------------------------------------------------
+
+ExcParseError::ExcParseError( const std::string &message, size_t line, size_t column )
+	: Exception( message + " (line " + to_string( line ) + ", column " + to_string( column ) + ")" ), mLine( line ), mColumn( column )
+{
+}
+
+} } // namespace cinder::json
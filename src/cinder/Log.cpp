@@ -48,6 +48,11 @@
 #endif
 
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <limits>
 #include <algorithm>
 #include <time.h>
 #include <cstring>
@@ -91,6 +96,351 @@ const std::string getDailyLogString( const std::string& format )
 
 } // anonymous namespace
 
+// ----------------------------------------------------------------------------------------------------
+// AsyncQueue
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+//! Fixed size header preceding each record in an AsyncQueue. The strings follow it in the order function name, file name, text.
+struct RecordHeader {
+	uint64_t	mSequence;
+	uint32_t	mTextLength;
+	uint32_t	mLineNumber;
+	uint16_t	mFunctionNameLength;
+	uint16_t	mFileNameLength;
+	uint8_t		mLevel;
+};
+
+//! Single producer, single consumer byte ring buffer holding serialized log entries. Written to only by the thread that owns it,
+//! read only by whichever thread is currently draining (guarded by AsyncImpl::mDrainMutex).
+class AsyncQueue {
+  public:
+	AsyncQueue( size_t capacity )
+		: mOrphaned( false ), mData( new char[capacity] ), mCapacity( capacity ), mReadIndex( 0 ), mWriteIndex( 0 )
+	{}
+
+	//! Serializes an entry, returns false without writing anything if there isn't enough space. Expects a capacity of at least sizeof( RecordHeader ).
+	bool tryPush( const Metadata &meta, const std::string &text, uint64_t sequence )
+	{
+		const auto &functionName = meta.mLocation.getFunctionName();
+		const auto &fileName = meta.mLocation.getFileName();
+
+		RecordHeader header;
+		header.mSequence = sequence;
+		header.mLevel = static_cast<uint8_t>( meta.mLevel );
+		header.mLineNumber = static_cast<uint32_t>( meta.mLocation.getLineNumber() );
+
+		// entries that could never fit are truncated rather than dropped, the names to a quarter of the queue each and the text to the rest
+		const size_t maxNameLength = std::min<size_t>( ( mCapacity - sizeof( RecordHeader ) ) / 4, numeric_limits<uint16_t>::max() );
+		header.mFunctionNameLength = static_cast<uint16_t>( std::min( functionName.size(), maxNameLength ) );
+		header.mFileNameLength = static_cast<uint16_t>( std::min( fileName.size(), maxNameLength ) );
+		const size_t fixedSize = sizeof( RecordHeader ) + header.mFunctionNameLength + header.mFileNameLength;
+		header.mTextLength = static_cast<uint32_t>( std::min<size_t>( text.size(), mCapacity - fixedSize ) );
+
+		const size_t recordSize = fixedSize + header.mTextLength;
+		const size_t writeIndex = mWriteIndex.load( memory_order_relaxed );
+		const size_t readIndex = mReadIndex.load( memory_order_acquire );
+		if( mCapacity - ( writeIndex - readIndex ) < recordSize )
+			return false;
+
+		size_t index = writeIndex;
+		index = copyIn( index, &header, sizeof( header ) );
+		index = copyIn( index, functionName.data(), header.mFunctionNameLength );
+		index = copyIn( index, fileName.data(), header.mFileNameLength );
+		index = copyIn( index, text.data(), header.mTextLength );
+
+		mWriteIndex.store( index, memory_order_release );
+		return true;
+	}
+
+	//! Returns false if the queue is empty, otherwise fills \\a sequence with the sequence number of the next record.
+	bool peekSequence( uint64_t *sequence ) const
+	{
+		const size_t readIndex = mReadIndex.load( memory_order_relaxed );
+		if( readIndex == mWriteIndex.load( memory_order_acquire ) )
+			return false;
+
+		RecordHeader header;
+		copyOut( readIndex, &header, sizeof( header ) );
+		*sequence = header.mSequence;
+		return true;
+	}
+
+	//! Deserializes the next record, which must exist (check with peekSequence() first).
+	void pop( Metadata *meta, std::string *text )
+	{
+		size_t index = mReadIndex.load( memory_order_relaxed );
+
+		RecordHeader header;
+		index = copyOut( index, &header, sizeof( header ) );
+
+		std::string functionName( header.mFunctionNameLength, 0 );
+		std::string fileName( header.mFileNameLength, 0 );
+		text->resize( header.mTextLength );
+		index = copyOut( index, &functionName[0], header.mFunctionNameLength );
+		index = copyOut( index, &fileName[0], header.mFileNameLength );
+		index = copyOut( index, &(*text)[0], header.mTextLength );
+
+		meta->mLevel = static_cast<Level>( header.mLevel );
+		meta->mLocation = Location( functionName, fileName, header.mLineNumber );
+
+		mReadIndex.store( index, memory_order_release );
+	}
+
+	bool isEmpty() const	{ return mReadIndex.load( memory_order_acquire ) == mWriteIndex.load( memory_order_acquire ); }
+
+	//! Returns true when more than half of the queue is in use, which is used as a hint to wake the background thread early.
+	bool isAboveHalfFull() const	{ return ( mWriteIndex.load( memory_order_relaxed ) - mReadIndex.load( memory_order_relaxed ) ) > mCapacity / 2; }
+
+	//! Set when the owning thread exits, after which the queue is removed once drained.
+	std::atomic<bool>	mOrphaned;
+
+  private:
+	// mReadIndex and mWriteIndex increase monotonically and are wrapped to the buffer when copying
+	size_t copyIn( size_t index, const void *src, size_t size )
+	{
+		const size_t offset = index % mCapacity;
+		const size_t firstPart = std::min( size, mCapacity - offset );
+		memcpy( mData.get() + offset, src, firstPart );
+		memcpy( mData.get(), static_cast<const char *>( src ) + firstPart, size - firstPart );
+		return index + size;
+	}
+
+	size_t copyOut( size_t index, void *dst, size_t size ) const
+	{
+		const size_t offset = index % mCapacity;
+		const size_t firstPart = std::min( size, mCapacity - offset );
+		memcpy( dst, mData.get() + offset, firstPart );
+		memcpy( static_cast<char *>( dst ) + firstPart, mData.get(), size - firstPart );
+		return index + size;
+	}
+
+	std::unique_ptr<char[]>		mData;
+	size_t						mCapacity;
+	std::atomic<size_t>			mReadIndex, mWriteIndex;
+};
+
+//! Owned by each thread that logs while asynchronous logging is enabled.
+struct ThreadQueueHandle {
+	~ThreadQueueHandle()
+	{
+		if( mQueue )
+			mQueue->mOrphaned = true;
+	}
+
+	std::shared_ptr<AsyncQueue>	mQueue;
+	uint64_t					mGeneration = 0;
+};
+
+thread_local ThreadQueueHandle sThreadQueue;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------------------------------
+// LogManager::AsyncImpl
+// ----------------------------------------------------------------------------------------------------
+
+class LogManager::AsyncImpl {
+  public:
+	AsyncImpl( LogManager *owner )
+		: mOwner( owner ), mEnabled( false ), mNumActiveWriters( 0 ), mGeneration( 0 ), mSequence( 0 ),
+			mNumDropped( 0 ), mShouldQuit( false ), mWakeRequested( false )
+	{}
+
+	~AsyncImpl()
+	{
+		stop();
+	}
+
+	void start( const AsyncOptions &options )
+	{
+		stop();
+
+		mOptions = options;
+		mNumDropped = 0;
+		mShouldQuit = false;
+		mGeneration++;
+		mThread = std::thread( &AsyncImpl::threadEntry, this );
+		mEnabled = true;
+	}
+
+	void stop()
+	{
+		if( ! mThread.joinable() )
+			return;
+
+		// wait for any writers that saw mEnabled as true before stopping the background thread
+		mEnabled = false;
+		while( mNumActiveWriters.load() > 0 )
+			std::this_thread::yield();
+
+		{
+			lock_guard<mutex> lock( mWakeMutex );
+			mShouldQuit = true;
+		}
+		mWakeCond.notify_one();
+		mThread.join();
+
+		drain();
+
+		lock_guard<mutex> lock( mQueuesMutex );
+		mQueues.clear();
+	}
+
+	bool isEnabled() const	{ return mEnabled; }
+
+	//! Returns false if the entry should be written synchronously instead.
+	bool write( const Metadata &meta, const std::string &text )
+	{
+		if( ! mEnabled.load( memory_order_acquire ) )
+			return false;
+
+		mNumActiveWriters++;
+		if( ! mEnabled.load() ) {
+			mNumActiveWriters--;
+			return false;
+		}
+
+		// a logger that logs while being drained must not wait on itself
+		const bool isDrainThread = std::this_thread::get_id() == mThread.get_id();
+		const uint64_t sequence = mSequence++;
+
+		AsyncQueue *queue = getThreadQueue();
+		bool pushed = queue->tryPush( meta, text, sequence );
+		if( ! pushed ) {
+			if( mOptions.getOverflowPolicy() == OverflowPolicy::BLOCK && ! isDrainThread ) {
+				while( ! pushed ) {
+					wake();
+					std::this_thread::yield();
+					pushed = queue->tryPush( meta, text, sequence );
+				}
+			}
+			else
+				mNumDropped++;
+		}
+
+		if( queue->isAboveHalfFull() )
+			wake();
+
+		mNumActiveWriters--;
+
+		// the application may be about to terminate, so make sure fatal entries reach the loggers
+		if( meta.mLevel == LEVEL_FATAL && ! isDrainThread )
+			drain();
+
+		return true;
+	}
+
+	void drain()
+	{
+		lock_guard<mutex> drainLock( mDrainMutex );
+
+		{
+			lock_guard<mutex> lock( mQueuesMutex );
+			mDrainQueues = mQueues;
+		}
+
+		Metadata meta;
+		{
+			lock_guard<mutex> lock( mOwner->mMutex );
+			while( true ) {
+				// pick the oldest entry amongst all threads so that ordering is preserved as much as possible
+				AsyncQueue *next = nullptr;
+				uint64_t nextSequence = numeric_limits<uint64_t>::max();
+				for( const auto &queue : mDrainQueues ) {
+					uint64_t sequence;
+					if( queue->peekSequence( &sequence ) && sequence <= nextSequence ) {
+						next = queue.get();
+						nextSequence = sequence;
+					}
+				}
+
+				if( ! next )
+					break;
+
+				next->pop( &meta, &mDrainText );
+				for( auto &logger : mOwner->mLoggers )
+					logger->write( meta, mDrainText );
+			}
+		}
+
+		// release queues whose threads have exited
+		lock_guard<mutex> lock( mQueuesMutex );
+		mQueues.erase( remove_if( mQueues.begin(), mQueues.end(),
+								[]( const shared_ptr<AsyncQueue> &queue ) {
+									return queue->mOrphaned && queue->isEmpty();
+								} ),
+					  mQueues.end() );
+		mDrainQueues.clear();
+	}
+
+	size_t getNumDroppedEntries() const		{ return mNumDropped; }
+
+  private:
+	AsyncQueue* getThreadQueue()
+	{
+		const uint64_t generation = mGeneration.load( memory_order_relaxed );
+		if( ! sThreadQueue.mQueue || sThreadQueue.mGeneration != generation ) {
+			auto queue = make_shared<AsyncQueue>( std::max<size_t>( mOptions.getQueueSize(), sizeof( RecordHeader ) ) );
+			{
+				lock_guard<mutex> lock( mQueuesMutex );
+				mQueues.push_back( queue );
+			}
+			sThreadQueue.mQueue = queue;
+			sThreadQueue.mGeneration = generation;
+		}
+
+		return sThreadQueue.mQueue.get();
+	}
+
+	void wake()
+	{
+		{
+			lock_guard<mutex> lock( mWakeMutex );
+			mWakeRequested = true;
+		}
+		mWakeCond.notify_one();
+	}
+
+	void threadEntry()
+	{
+		const auto interval = chrono::duration<double>( mOptions.getFlushInterval() );
+
+		while( true ) {
+			bool shouldQuit;
+			{
+				unique_lock<mutex> lock( mWakeMutex );
+				mWakeCond.wait_for( lock, interval, [this] { return mWakeRequested || mShouldQuit; } );
+				mWakeRequested = false;
+				shouldQuit = mShouldQuit;
+			}
+
+			drain();
+
+			if( shouldQuit )
+				break;
+		}
+	}
+
+	LogManager*			mOwner;
+	AsyncOptions		mOptions;
+
+	std::atomic<bool>		mEnabled;
+	std::atomic<int>		mNumActiveWriters;
+	std::atomic<uint64_t>	mGeneration, mSequence;
+	std::atomic<size_t>		mNumDropped;
+
+	std::vector<std::shared_ptr<AsyncQueue>>	mQueues, mDrainQueues;
+	std::mutex									mQueuesMutex, mDrainMutex;
+	std::string									mDrainText;
+
+	std::thread					mThread;
+	std::mutex					mWakeMutex;
+	std::condition_variable		mWakeCond;
+	bool						mShouldQuit, mWakeRequested;
+};
+
 // ----------------------------------------------------------------------------------------------------
 // LogManager
 // ----------------------------------------------------------------------------------------------------
@@ -103,10 +453,17 @@ LogManager* manager()
 }
 
 LogManager::LogManager()
+	: mAsync( new AsyncImpl( this ) )
 {
 	restoreToDefault();
 }
 
+LogManager::~LogManager()
+{
+	// flushes any pending entries before the loggers are destroyed
+	mAsync.reset();
+}
+
 void LogManager::clearLoggers()
 {
 	lock_guard<mutex> lock( mMutex );
@@ -156,6 +513,9 @@ void LogManager::restoreToDefault()
 	
 void LogManager::write( const Metadata &meta, const std::string &text )
 {
+	if( mAsync->write( meta, text ) )
+		return;
+
 	// TODO move this to a shared_lock_timed with c++14 support
 	lock_guard<mutex> lock( mMutex );
 
@@ -164,6 +524,41 @@ void LogManager::write( const Metadata &meta, const std::string &text )
 	}
 }
 
+void LogManager::enableAsync( const AsyncOptions &options )
+{
+	// make sure pending entries are written when the application exits normally, since the shared instance is leaked
+	static once_flag sRegisterExitHandler;
+	call_once( sRegisterExitHandler, [] {
+		atexit( [] {
+			if( LogManager::instance() )
+				LogManager::instance()->disableAsync();
+		} );
+	} );
+
+	mAsync->start( options );
+}
+
+void LogManager::disableAsync()
+{
+	mAsync->stop();
+}
+
+bool LogManager::isAsyncEnabled() const
+{
+	return mAsync->isEnabled();
+}
+
+void LogManager::flush()
+{
+	if( mAsync->isEnabled() )
+		mAsync->drain();
+}
+
+size_t LogManager::getNumDroppedEntries() const
+{
+	return mAsync->getNumDroppedEntries();
+}
+
 // ----------------------------------------------------------------------------------------------------
 // Entry
 // ----------------------------------------------------------------------------------------------------
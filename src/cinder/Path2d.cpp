@@ -30,6 +30,7 @@
 
 #include "cinder/CinderMath.h"
 #include "cinder/Path2d.h"
+#include "cinder/Thread.h"
 
 #include <algorithm>
 #include <iterator>
@@ -1793,11 +1794,123 @@ float Path2d::segmentSolveTimeForDistance( size_t segment, float segmentLength,
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Path2dCalcCache
-Path2dCalcCache::Path2dCalcCache( const Path2d &path )
-	: mPath( path ), mLength( path.calcLength() )
+namespace { // Path2dCalcCache helpers
+// Number of uniform steps which keep a Bezier of \a degree within \a tolerance of its control polygon's chords (Wang's formula)
+int calcFlatteningSteps( const vec2 *p, int degree, float tolerance )
+{
+	float maxSecondDifference = 0;
+	for( int i = 0; i + 2 <= degree; ++i )
+		maxSecondDifference = std::max( maxSecondDifference, length( p[i] - 2.0f * p[i+1] + p[i+2] ) );
+
+	float steps = math<float>::sqrt( degree * ( degree - 1 ) * maxSecondDifference / ( 8 * tolerance ) );
+	return math<int>::clamp( (int)math<float>::ceil( steps ), 1, 1024 );
+}
+
+// Appends the points at t = 1/steps .. 1 of the Bezier with power basis coefficients \a coeffs (highest degree first),
+// evaluating four parameters at a time so that the compiler can vectorize the Horner steps
+void appendPowerBasis( const vec2 *coeffs, int degree, int steps, vector<vec2> *result )
+{
+	const float invSteps = 1.0f / steps;
+	const vec4 offsets( 1, 2, 3, 4 );
+	for( int i = 0; i < steps; i += 4 ) {
+		vec4 t = ( vec4( (float)i ) + offsets ) * invSteps;
+		vec4 x( coeffs[0].x ), y( coeffs[0].y );
+		for( int c = 1; c <= degree; ++c ) {
+			x = x * t + vec4( coeffs[c].x );
+			y = y * t + vec4( coeffs[c].y );
+		}
+
+		for( int lane = 0; lane < 4 && i + lane < steps; ++lane )
+			result->emplace_back( x[lane], y[lane] );
+	}
+	// land exactly on the end point
+	result->back() = coeffs[degree];
+	for( int c = 0; c < degree; ++c )
+		result->back() += coeffs[c];
+}
+
+void flattenQuadratic( const vec2 p[3], float tolerance, vector<vec2> *result )
+{
+	const vec2 coeffs[3] = { p[0] - 2.0f * p[1] + p[2], 2.0f * ( p[1] - p[0] ), p[0] };
+	appendPowerBasis( coeffs, 2, calcFlatteningSteps( p, 2, tolerance ), result );
+}
+
+void flattenCubic( const vec2 p[4], float tolerance, vector<vec2> *result )
+{
+	const vec2 coeffs[4] = { -p[0] + 3.0f * p[1] - 3.0f * p[2] + p[3], 3.0f * p[0] - 6.0f * p[1] + 3.0f * p[2], 3.0f * ( p[1] - p[0] ), p[0] };
+	appendPowerBasis( coeffs, 3, calcFlatteningSteps( p, 3, tolerance ), result );
+}
+
+Rectf calcBounds( const vec2 *points, size_t numPoints )
+{
+	Rectf result( points[0], points[0] );
+	for( size_t i = 1; i < numPoints; ++i )
+		result.include( points[i] );
+	return result;
+}
+
+float calcDistanceSquared( const Rectf &rect, const vec2 &pt )
+{
+	float dx = std::max( std::max( rect.x1 - pt.x, pt.x - rect.x2 ), 0.0f );
+	float dy = std::max( std::max( rect.y1 - pt.y, pt.y - rect.y2 ), 0.0f );
+	return dx * dx + dy * dy;
+}
+
+// the minimum number of queries worth starting a thread for
+const size_t sMinQueriesPerThread = 256;
+} // anonymous namespace Path2dCalcCache helpers
+
+Path2dCalcCache::Path2dCalcCache( const Path2d &path, float approximationScale )
+	: mPath( path ), mLength( path.calcLength() ), mBounds( 0, 0, 0, 0 )
 {
 	for( size_t i = 0; i < mPath.getNumSegments(); ++i )
 		mSegmentLengths.push_back( mPath.calcSegmentLength( i ) );
+
+	if( mPath.mPoints.empty() )
+		return;
+
+	// the curves lie within 'tolerance' of the flattened points, so their bounds inflated by it are conservative. Intersecting
+	// those with the bounds of the control points, which contain the curve as well, gives tight boxes for curves of any size.
+	const float tolerance = 0.5f / approximationScale;
+	const vec2 inflation( tolerance * 1.001f );
+	const vector<vec2> &points = mPath.mPoints;
+	size_t firstPoint = 0;
+	mPositions.push_back( points[0] );
+	for( size_t s = 0; s < mPath.mSegments.size(); ++s ) {
+		const size_t firstPosition = mPositions.size() - 1;
+		size_t numControlPoints = Path2d::sSegmentTypePointCounts[mPath.mSegments[s]] + 1;
+		switch( mPath.mSegments[s] ) {
+			case Path2d::CUBICTO:
+				flattenCubic( &points[firstPoint], tolerance, &mPositions );
+			break;
+			case Path2d::QUADTO:
+				flattenQuadratic( &points[firstPoint], tolerance, &mPositions );
+			break;
+			case Path2d::LINETO:
+				mPositions.push_back( points[firstPoint + 1] );
+			break;
+			case Path2d::CLOSE:
+				mPositions.push_back( points[0] );
+				numControlPoints = 1;
+			break;
+			default:
+				throw Path2dExc();
+		}
+
+		Rectf bounds = calcBounds( &mPositions[firstPosition], mPositions.size() - firstPosition );
+		if( numControlPoints > 2 ) {
+			bounds.inflate( inflation );
+			bounds.clipBy( calcBounds( &points[firstPoint], numControlPoints ) );
+		}
+		mSegmentBounds.push_back( bounds );
+		mSegmentFirstPoints.push_back( firstPoint );
+		firstPoint += Path2d::sSegmentTypePointCounts[mPath.mSegments[s]];
+	}
+
+	mClosingLineBounds = Rectf( points.back(), points.front() ).canonicalized();
+	mBounds = mClosingLineBounds;
+	for( const Rectf &bounds : mSegmentBounds )
+		mBounds.include( bounds );
 }
 
 float Path2dCalcCache::calcNormalizedTime( float relativeTime, bool wrap, float tolerance, int maxIterations ) const
@@ -1856,5 +1969,136 @@ float Path2dCalcCache::calcTimeForDistance( float distance, bool wrap, float tol
 	return mPath.segmentSolveTimeForDistance( currentSegment, currentSegmentLength, distance, tolerance, maxIterations );
 }
 
+bool Path2dCalcCache::contains( const vec2 &pt, bool evenOddFill ) const
+{
+	if( mPath.mPoints.empty() || ! mBounds.contains( pt ) )
+		return false;
+
+	// same as Path2d::calcWinding(), but skipping segments which can't cross the horizontal line through 'pt'
+	int w = 0;
+	int onCurveCount = 0;
+	const vec2 *points = mPath.mPoints.data();
+	for( size_t s = 0; s < mSegmentBounds.size(); ++s ) {
+		if( pt.y < mSegmentBounds[s].y1 || pt.y > mSegmentBounds[s].y2 )
+			continue;
+
+		switch( mPath.mSegments[s] ) {
+			case Path2d::LINETO:
+				w += windingLine( &points[mSegmentFirstPoints[s]], pt, &onCurveCount );
+			break;
+			case Path2d::QUADTO:
+				w += windingQuad( &points[mSegmentFirstPoints[s]], pt, &onCurveCount );
+			break;
+			case Path2d::CUBICTO:
+				w += windingCubic( &points[mSegmentFirstPoints[s]], pt, &onCurveCount );
+			break;
+			default: // closed is always assumed and is handled below
+			break;
+		}
+	}
+
+	if( pt.y >= mClosingLineBounds.y1 && pt.y <= mClosingLineBounds.y2 ) {
+		vec2 temp[2] = { mPath.mPoints.back(), mPath.mPoints.front() };
+		w += windingLine( temp, pt, &onCurveCount );
+	}
+
+	// same as Path2d::contains()
+	if( evenOddFill )
+		w &= 1;
+	if( w )
+		return true;
+
+	if( onCurveCount <= 1 )
+		return onCurveCount > 0;
+	if( (onCurveCount & 1) || evenOddFill )
+		return (onCurveCount & 1) > 0;
+
+	return false;
+}
+
+void Path2dCalcCache::contains( const vec2 *points, size_t numPoints, bool *result, bool evenOddFill ) const
+{
+	parallelFor( numPoints, sMinQueriesPerThread, [=]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			result[i] = contains( points[i], evenOddFill );
+	} );
+}
+
+float Path2dCalcCache::calcClosestPoint( const vec2 &pt, vec2 *result ) const
+{
+	// evaluate the segment with the nearest bounds first, then only those segments whose bounds are nearer than the best result so far
+	size_t nearestSegment = 0;
+	float nearestBoundsDistance2 = FLT_MAX;
+	for( size_t s = 0; s < mSegmentBounds.size(); ++s ) {
+		float d = calcDistanceSquared( mSegmentBounds[s], pt );
+		if( d < nearestBoundsDistance2 ) {
+			nearestBoundsDistance2 = d;
+			nearestSegment = s;
+		}
+	}
+
+	if( mSegmentBounds.empty() )
+		return FLT_MAX;
+
+	*result = mPath.calcClosestPoint( pt, nearestSegment, mSegmentFirstPoints[nearestSegment] );
+	float distance2 = glm::distance2( pt, *result );
+	for( size_t s = 0; s < mSegmentBounds.size(); ++s ) {
+		if( s == nearestSegment || calcDistanceSquared( mSegmentBounds[s], pt ) >= distance2 )
+			continue;
+
+		vec2 p = mPath.calcClosestPoint( pt, s, mSegmentFirstPoints[s] );
+		float d = glm::distance2( pt, p );
+		if( d < distance2 ) {
+			*result = p;
+			distance2 = d;
+		}
+	}
+
+	return distance2;
+}
+
+float Path2dCalcCache::calcDistance( const vec2 &pt ) const
+{
+	vec2 closest;
+	float distance2 = calcClosestPoint( pt, &closest );
+	return ( distance2 == FLT_MAX ) ? FLT_MAX : math<float>::sqrt( distance2 );
+}
+
+vec2 Path2dCalcCache::calcClosestPoint( const vec2 &pt ) const
+{
+	vec2 result;
+	calcClosestPoint( pt, &result );
+	return result;
+}
+
+void Path2dCalcCache::calcDistances( const vec2 *points, size_t numPoints, float *result ) const
+{
+	parallelFor( numPoints, sMinQueriesPerThread, [=]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			result[i] = calcDistance( points[i] );
+	} );
+}
+
+std::vector<float> Path2dCalcCache::calcDistances( const std::vector<vec2> &points ) const
+{
+	vector<float> result( points.size() );
+	calcDistances( points.data(), points.size(), result.data() );
+	return result;
+}
+
+void Path2dCalcCache::calcClosestPoints( const vec2 *points, size_t numPoints, vec2 *result ) const
+{
+	parallelFor( numPoints, sMinQueriesPerThread, [=]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			calcClosestPoint( points[i], &result[i] );
+	} );
+}
+
+std::vector<vec2> Path2dCalcCache::calcClosestPoints( const std::vector<vec2> &points ) const
+{
+	vector<vec2> result( points.size() );
+	calcClosestPoints( points.data(), points.size(), result.data() );
+	return result;
+}
 
 } // namespace cinder
@@ -0,0 +1,329 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/Profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+namespace cinder { namespace profile {
+
+namespace {
+
+enum EventType : uint8_t { EVENT_ZONE, EVENT_COUNTER, EVENT_FRAME };
+
+struct Event {
+	uint64_t	mTimeNs;
+	const char	*mName;
+	union {
+		uint64_t	mDurationNs;
+		double		mValue;
+	};
+	EventType	mType;
+};
+
+void appendEscaped( string *json, const char *s )
+{
+	for( ; *s; ++s ) {
+		const unsigned char c = *s;
+		if( c == '"' || c == '\\' ) {
+			json->push_back( '\\' );
+			json->push_back( c );
+		}
+		else if( c < 0x20 ) {
+			char escaped[8];
+			snprintf( escaped, sizeof( escaped ), "\\u%04x", c );
+			json->append( escaped );
+		}
+		else
+			json->push_back( c );
+	}
+}
+
+// Appends the fields shared by every event: its name, phase, thread and time in microseconds
+void appendEventHeader( string *json, const char *name, const char *phase, uint32_t threadId, uint64_t timeNs )
+{
+	json->append( "{\"name\":\"" );
+	appendEscaped( json, name );
+	char fields[96];
+	snprintf( fields, sizeof( fields ), "\",\"ph\":\"%s\",\"pid\":1,\"tid\":%u,\"ts\":%.3f", phase, threadId, timeNs / 1000.0 );
+	json->append( fields );
+}
+
+} // anonymous namespace
+
+//! Ring buffer of events, written only by its thread and read by any thread under Profiler::mMutex
+struct Profiler::ThreadBuffer {
+	ThreadBuffer( size_t capacity, uint32_t threadId, const string &name )
+		: mEvents( new Event[capacity] ), mCapacity( capacity ), mWriteIndex( 0 ), mFirstIndex( 0 ), mRetired( false ),
+			mThreadId( threadId ), mName( name ), mLastFrameNs( 0 )
+	{}
+
+	void push( const Event &event )
+	{
+		const uint64_t index = mWriteIndex.load( memory_order_relaxed );
+		mEvents[index & ( mCapacity - 1 )] = event;
+		mWriteIndex.store( index + 1, memory_order_release );
+	}
+
+	// Copies the events which are still intact into \a result
+	void read( vector<Event> *result ) const
+	{
+		const uint64_t end = mWriteIndex.load( memory_order_acquire );
+		uint64_t begin = std::max<uint64_t>( mFirstIndex.load( memory_order_relaxed ), end > mCapacity ? end - mCapacity : 0 );
+		vector<Event> events;
+		events.reserve( size_t( end - begin ) );
+		for( uint64_t index = begin; index < end; ++index )
+			events.push_back( mEvents[index & ( mCapacity - 1 )] );
+
+		// discard any events which may have been overwritten while copying, including one being written now by a live thread
+		atomic_thread_fence( memory_order_acquire );
+		const uint64_t written = mWriteIndex.load( memory_order_relaxed ) + ( mRetired.load( memory_order_relaxed ) ? 0 : 1 );
+		const uint64_t intact = std::max<uint64_t>( begin, written > mCapacity ? written - mCapacity : 0 );
+		if( intact < end )
+			result->insert( result->end(), events.begin() + size_t( intact - begin ), events.end() );
+	}
+
+	unique_ptr<Event[]>		mEvents;
+	size_t					mCapacity;
+	atomic<uint64_t>		mWriteIndex;
+	atomic<uint64_t>		mFirstIndex; // events before this index have been cleared
+	atomic<bool>			mRetired; // set when the thread exits, allowing the buffer to be reused by a new thread
+
+	// guarded by Profiler::mMutex
+	uint32_t				mThreadId;
+	string					mName;
+
+	// only accessed by the thread
+	uint64_t				mLastFrameNs;
+};
+
+namespace {
+
+// The calling thread's buffer, which is retired when the thread exits
+struct ThreadState {
+	~ThreadState()
+	{
+		if( mBuffer )
+			mBuffer->mRetired = true;
+	}
+
+	Profiler::ThreadBuffer	*mBuffer = nullptr;
+	string					mName;
+};
+
+ThreadState& getThreadState()
+{
+	static thread_local ThreadState sThreadState;
+	return sThreadState;
+}
+
+} // anonymous namespace
+
+uint64_t now()
+{
+	static const chrono::steady_clock::time_point sEpoch = chrono::steady_clock::now();
+	return (uint64_t)chrono::duration_cast<chrono::nanoseconds>( chrono::steady_clock::now() - sEpoch ).count();
+}
+
+atomic<bool> Profiler::sEnabled( false );
+
+Profiler::Profiler()
+	: mEventsPerThread( 1 << 15 ), mNextThreadId( 1 )
+{
+}
+
+Profiler& Profiler::instance()
+{
+	// never destroyed, as threads may still record events during static destruction
+	static Profiler *sInstance = new Profiler;
+	return *sInstance;
+}
+
+Profiler::ThreadBuffer* Profiler::getThreadBuffer()
+{
+	ThreadState &state = getThreadState();
+	if( state.mBuffer )
+		return state.mBuffer;
+
+	lock_guard<mutex> lock( mMutex );
+	for( auto &buffer : mThreadBuffers ) {
+		if( buffer->mRetired && buffer->mCapacity == mEventsPerThread ) {
+			buffer->mFirstIndex = buffer->mWriteIndex.load();
+			buffer->mThreadId = mNextThreadId++;
+			buffer->mName = state.mName;
+			buffer->mLastFrameNs = 0;
+			buffer->mRetired = false;
+			state.mBuffer = buffer.get();
+			return state.mBuffer;
+		}
+	}
+
+	mThreadBuffers.emplace_back( new ThreadBuffer( mEventsPerThread, mNextThreadId++, state.mName ) );
+	state.mBuffer = mThreadBuffers.back().get();
+	return state.mBuffer;
+}
+
+void Profiler::recordZone( const char *name, uint64_t beginNs, uint64_t endNs )
+{
+	if( ! isEnabled() )
+		return;
+
+	Event event;
+	event.mTimeNs = beginNs;
+	event.mName = name;
+	event.mDurationNs = endNs > beginNs ? endNs - beginNs : 0;
+	event.mType = EVENT_ZONE;
+	getThreadBuffer()->push( event );
+}
+
+void Profiler::recordCounter( const char *name, double value )
+{
+	if( ! isEnabled() )
+		return;
+
+	Event event;
+	event.mTimeNs = now();
+	event.mName = name;
+	event.mValue = value;
+	event.mType = EVENT_COUNTER;
+	getThreadBuffer()->push( event );
+}
+
+void Profiler::recordFrame( const char *name )
+{
+	if( ! isEnabled() )
+		return;
+
+	ThreadBuffer *buffer = getThreadBuffer();
+	Event event;
+	event.mTimeNs = now();
+	event.mName = name;
+	event.mDurationNs = 0;
+	event.mType = EVENT_FRAME;
+	buffer->push( event );
+
+	const uint64_t lastFrameNs = buffer->mLastFrameNs;
+	buffer->mLastFrameNs = event.mTimeNs;
+	auto frameSpike = atomic_load( &mFrameSpike );
+	if( frameSpike && lastFrameNs ) {
+		const double frameSeconds = ( event.mTimeNs - lastFrameNs ) / 1e9;
+		if( frameSeconds > frameSpike->first )
+			frameSpike->second( name, frameSeconds );
+	}
+}
+
+void Profiler::setThreadName( const string &name )
+{
+	ThreadState &state = getThreadState();
+	state.mName = name;
+	if( state.mBuffer ) {
+		lock_guard<mutex> lock( mMutex );
+		state.mBuffer->mName = name;
+	}
+}
+
+void Profiler::setEventsPerThread( size_t numEvents )
+{
+	size_t capacity = 2;
+	while( capacity < numEvents )
+		capacity *= 2;
+
+	lock_guard<mutex> lock( mMutex );
+	mEventsPerThread = capacity;
+}
+
+void Profiler::setFrameSpikeFn( double thresholdSeconds, const FrameSpikeFn &fn )
+{
+	shared_ptr<const pair<double, FrameSpikeFn>> frameSpike;
+	if( fn )
+		frameSpike = make_shared<const pair<double, FrameSpikeFn>>( thresholdSeconds, fn );
+	atomic_store( &mFrameSpike, frameSpike );
+}
+
+string Profiler::getChromeTrace() const
+{
+	string json = "{\"traceEvents\":[";
+	bool first = true;
+	auto beginEvent = [&] {
+		if( ! first )
+			json.append( ",\n" );
+		first = false;
+	};
+
+	lock_guard<mutex> lock( mMutex );
+	vector<Event> events;
+	for( const auto &buffer : mThreadBuffers ) {
+		events.clear();
+		buffer->read( &events );
+
+		if( ! buffer->mName.empty() ) {
+			beginEvent();
+			json.append( "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + to_string( buffer->mThreadId ) + ",\"args\":{\"name\":\"" );
+			appendEscaped( &json, buffer->mName.c_str() );
+			json.append( "\"}}" );
+		}
+
+		char fields[64];
+		for( const auto &event : events ) {
+			beginEvent();
+			switch( event.mType ) {
+				case EVENT_ZONE:
+					appendEventHeader( &json, event.mName, "X", buffer->mThreadId, event.mTimeNs );
+					snprintf( fields, sizeof( fields ), ",\"dur\":%.3f}", event.mDurationNs / 1000.0 );
+				break;
+				case EVENT_COUNTER:
+					appendEventHeader( &json, event.mName, "C", buffer->mThreadId, event.mTimeNs );
+					snprintf( fields, sizeof( fields ), ",\"args\":{\"value\":%.17g}}", std::isfinite( event.mValue ) ? event.mValue : 0.0 );
+				break;
+				case EVENT_FRAME:
+					appendEventHeader( &json, event.mName, "i", buffer->mThreadId, event.mTimeNs );
+					snprintf( fields, sizeof( fields ), ",\"s\":\"g\"}" );
+				break;
+			}
+			json.append( fields );
+		}
+	}
+
+	json.append( "],\n\"displayTimeUnit\":\"ms\"}\n" );
+	return json;
+}
+
+void Profiler::writeChromeTrace( const DataTargetRef &target ) const
+{
+	const string json = getChromeTrace();
+	target->getStream()->writeData( json.data(), json.size() );
+}
+
+void Profiler::clear()
+{
+	lock_guard<mutex> lock( mMutex );
+	for( auto &buffer : mThreadBuffers )
+		buffer->mFirstIndex = buffer->mWriteIndex.load();
+}
+
+} } // namespace cinder::profile
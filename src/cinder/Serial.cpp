@@ -28,6 +28,7 @@
 
 #include <string>
 #include <iostream>
+#include <cstring>
 #include <fcntl.h>
 
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
@@ -42,6 +43,17 @@
 	#pragma comment(lib, "setupapi.lib")
 #endif
 
+#if defined( CINDER_LINUX )
+	#include "cinder/audio/dsp/RingBuffer.h"
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+	#include <poll.h>
+	#include <chrono>
+	#include <condition_variable>
+	#include <deque>
+	#include <mutex>
+#endif
+
 #include <map>
 using namespace std;
 
@@ -50,6 +62,349 @@ namespace cinder {
 bool							Serial::sDevicesInited = false;
 std::vector<Serial::Device>		Serial::sDevices;
 
+#if defined( CINDER_LINUX )
+
+namespace {
+
+//! Reads a serial port on a background thread woken by epoll, and writes the bytes other threads have queued
+class AsyncReader : private Noncopyable {
+  public:
+	//! Starts reading \a fd on a background thread, receiving \a unread first as if it had just been read from the port
+	AsyncReader( int fd, const Serial::AsyncOptions &options, const std::vector<uint8_t> &unread );
+	~AsyncReader();
+
+	//! Writes any queued bytes, waiting up to a second for the port to become writable, and stops the background thread
+	void	stop();
+
+	//! Reads up to \a size bytes, waiting up to \a timeoutSeconds for at least one byte (forever when negative). Returns 0 on timeout.
+	size_t	read( uint8_t *data, size_t size, double timeoutSeconds );
+	size_t	getNumBytesAvailable() const	{ return mRingBuffer.getAvailableRead(); }
+	bool	readPacket( std::vector<uint8_t> *packet, double timeoutSeconds );
+	size_t	getNumQueuedPackets() const;
+	void	write( const void *data, size_t size );
+
+	const Serial::AsyncOptions&	getOptions() const	{ return mOptions; }
+
+	std::atomic<size_t>		mNumQueuedForWrite, mNumBytesDropped, mNumPacketsDropped;
+
+  private:
+	void	threadEntry();
+	void	readPort();
+	void	receive( const uint8_t *data, size_t size );
+	void	writePort();
+	void	drainWrites();
+	void	setWantWritable( bool wantWritable );
+	void	close();
+	void	wake();
+
+	int						mFd, mEpollFd, mEventFd;
+	Serial::AsyncOptions	mOptions;
+	std::thread				mThread;
+	std::atomic<bool>		mQuit, mClosed;
+
+	audio::dsp::RingBufferT<uint8_t>	mRingBuffer;
+	std::mutex				mDataMutex;
+	std::condition_variable	mDataCondition;
+	std::atomic<int>		mNumWaiting;
+
+	mutable std::mutex		mPacketMutex;
+	std::condition_variable	mPacketCondition;
+	std::deque<std::vector<uint8_t>>	mPackets;
+
+	std::mutex				mWriteMutex;
+	std::vector<uint8_t>	mQueuedWrites;
+	// only used by the background thread
+	std::vector<uint8_t>	mWriting;
+	size_t					mWriteOffset;
+	bool					mWantWritable;
+};
+
+AsyncReader::AsyncReader( int fd, const Serial::AsyncOptions &options, const std::vector<uint8_t> &unread )
+	: mNumQueuedForWrite( 0 ), mNumBytesDropped( 0 ), mNumPacketsDropped( 0 ), mFd( fd ), mOptions( options ), mQuit( false ), mClosed( false ),
+		mRingBuffer( std::max<size_t>( options.getBufferSize(), 1 ) ), mNumWaiting( 0 ), mWriteOffset( 0 ), mWantWritable( false )
+{
+	mEpollFd = ::epoll_create1( EPOLL_CLOEXEC );
+	mEventFd = ::eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+	if( mEpollFd == -1 || mEventFd == -1 ) {
+		if( mEpollFd != -1 )
+			::close( mEpollFd );
+		if( mEventFd != -1 )
+			::close( mEventFd );
+		throw SerialExc( "Serial failed to create the epoll instance for reading asynchronously." );
+	}
+
+	::epoll_event event = {};
+	event.events = EPOLLIN;
+	event.data.fd = mEventFd;
+	::epoll_ctl( mEpollFd, EPOLL_CTL_ADD, mEventFd, &event );
+	event.data.fd = mFd;
+	::epoll_ctl( mEpollFd, EPOLL_CTL_ADD, mFd, &event );
+
+	if( mOptions.getFramer() )
+		mOptions.getFramer()->reset();
+	if( ! unread.empty() )
+		receive( unread.data(), unread.size() );
+
+	mThread = std::thread( [this] { threadEntry(); } );
+}
+
+AsyncReader::~AsyncReader()
+{
+	stop();
+
+	::close( mEventFd );
+	::close( mEpollFd );
+}
+
+void AsyncReader::stop()
+{
+	if( ! mThread.joinable() )
+		return;
+
+	mQuit = true;
+	wake();
+	mThread.join();
+}
+
+void AsyncReader::wake()
+{
+	const uint64_t value = 1;
+	ssize_t result = ::write( mEventFd, &value, sizeof( value ) );
+	(void)result;
+}
+
+void AsyncReader::threadEntry()
+{
+	setThreadName( "cinder::Serial" );
+
+	::epoll_event events[2];
+	while( true ) {
+		int numEvents = ::epoll_wait( mEpollFd, events, 2, -1 );
+		if( numEvents == -1 ) {
+			if( errno == EINTR )
+				continue;
+			break;
+		}
+
+		for( int i = 0; i < numEvents; ++i ) {
+			if( events[i].data.fd == mEventFd ) {
+				uint64_t value;
+				ssize_t result = ::read( mEventFd, &value, sizeof( value ) );
+				(void)result;
+			}
+			else if( events[i].events & ( EPOLLIN | EPOLLHUP | EPOLLERR ) )
+				readPort();
+		}
+
+		// writes queued by other threads, and the rest of a write once the port is writable again
+		writePort();
+
+		if( mQuit ) {
+			drainWrites();
+			break;
+		}
+	}
+}
+
+void AsyncReader::readPort()
+{
+	uint8_t buffer[4096];
+	while( ! mClosed ) {
+		ssize_t bytesRead = ::read( mFd, buffer, sizeof( buffer ) );
+		if( bytesRead > 0 )
+			receive( buffer, (size_t)bytesRead );
+		else if( bytesRead == -1 && errno == EINTR )
+			continue;
+		else if( bytesRead == -1 && ( errno == EAGAIN || errno == EWOULDBLOCK ) )
+			break;
+		else
+			close(); // hung up, or the device went away
+
+		if( bytesRead < (ssize_t)sizeof( buffer ) )
+			break;
+	}
+}
+
+void AsyncReader::receive( const uint8_t *data, size_t size )
+{
+	const auto &framer = mOptions.getFramer();
+	if( framer ) {
+		framer->process( data, size, [this]( const uint8_t *packet, size_t packetSize ) {
+			if( mOptions.getPacketFn() ) {
+				mOptions.getPacketFn()( packet, packetSize );
+				return;
+			}
+
+			std::lock_guard<std::mutex> lock( mPacketMutex );
+			if( mPackets.size() >= std::max<size_t>( mOptions.getMaxQueuedPackets(), 1 ) ) {
+				mPackets.pop_front();
+				++mNumPacketsDropped;
+			}
+			mPackets.emplace_back( packet, packet + packetSize );
+			mPacketCondition.notify_one();
+		} );
+		return;
+	}
+
+	const size_t numWritten = std::min( size, mRingBuffer.getAvailableWrite() );
+	mRingBuffer.write( data, numWritten );
+	mNumBytesDropped += size - numWritten;
+
+	// only take the lock when a reader is waiting, pairs with the fence in read()
+	std::atomic_thread_fence( std::memory_order_seq_cst );
+	if( mNumWaiting > 0 ) {
+		{ std::lock_guard<std::mutex> lock( mDataMutex ); }
+		mDataCondition.notify_all();
+	}
+}
+
+void AsyncReader::writePort()
+{
+	while( ! mClosed ) {
+		if( mWriteOffset == mWriting.size() ) {
+			mWriting.clear();
+			mWriteOffset = 0;
+			{
+				std::lock_guard<std::mutex> lock( mWriteMutex );
+				mWriting.swap( mQueuedWrites );
+			}
+			if( mWriting.empty() ) {
+				setWantWritable( false );
+				return;
+			}
+		}
+
+		// everything queued since the last write goes out in a single call
+		ssize_t bytesWritten = ::write( mFd, mWriting.data() + mWriteOffset, mWriting.size() - mWriteOffset );
+		if( bytesWritten > 0 ) {
+			mWriteOffset += bytesWritten;
+			mNumQueuedForWrite -= bytesWritten;
+		}
+		else if( bytesWritten == -1 && errno == EINTR )
+			continue;
+		else if( bytesWritten == -1 && ( errno == EAGAIN || errno == EWOULDBLOCK ) ) {
+			setWantWritable( true );
+			return;
+		}
+		else {
+			close();
+			return;
+		}
+	}
+}
+
+void AsyncReader::drainWrites()
+{
+	// picks up writes queued after the last writePort() but before stop()
+	writePort();
+
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 1 );
+	while( mWantWritable && ! mClosed ) {
+		const auto remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>( deadline - std::chrono::steady_clock::now() ).count();
+		if( remainingMs <= 0 )
+			break;
+
+		::pollfd pollFd = { mFd, POLLOUT, 0 };
+		if( ::poll( &pollFd, 1, (int)remainingMs ) == -1 && errno != EINTR )
+			break;
+		writePort();
+	}
+}
+
+void AsyncReader::setWantWritable( bool wantWritable )
+{
+	if( wantWritable == mWantWritable || mClosed )
+		return;
+
+	mWantWritable = wantWritable;
+	::epoll_event event = {};
+	event.events = EPOLLIN | ( wantWritable ? (uint32_t)EPOLLOUT : 0u );
+	event.data.fd = mFd;
+	::epoll_ctl( mEpollFd, EPOLL_CTL_MOD, mFd, &event );
+}
+
+void AsyncReader::close()
+{
+	if( mClosed )
+		return;
+
+	::epoll_ctl( mEpollFd, EPOLL_CTL_DEL, mFd, nullptr );
+	mClosed = true;
+	{ std::lock_guard<std::mutex> lock( mDataMutex ); }
+	mDataCondition.notify_all();
+	{ std::lock_guard<std::mutex> lock( mPacketMutex ); }
+	mPacketCondition.notify_all();
+}
+
+size_t AsyncReader::read( uint8_t *data, size_t size, double timeoutSeconds )
+{
+	if( size == 0 )
+		return 0;
+
+	if( mRingBuffer.getAvailableRead() == 0 ) {
+		if( timeoutSeconds == 0 && ! mClosed )
+			return 0;
+
+		++mNumWaiting;
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		std::unique_lock<std::mutex> lock( mDataMutex );
+		auto ready = [this] { return mRingBuffer.getAvailableRead() > 0 || mClosed; };
+		if( timeoutSeconds < 0 )
+			mDataCondition.wait( lock, ready );
+		else
+			mDataCondition.wait_for( lock, std::chrono::duration<double>( timeoutSeconds ), ready );
+		--mNumWaiting;
+	}
+
+	const size_t numRead = std::min( size, mRingBuffer.getAvailableRead() );
+	if( numRead == 0 && mClosed )
+		throw SerialExcReadFailure();
+
+	mRingBuffer.read( data, numRead );
+	return numRead;
+}
+
+bool AsyncReader::readPacket( std::vector<uint8_t> *packet, double timeoutSeconds )
+{
+	std::unique_lock<std::mutex> lock( mPacketMutex );
+	auto ready = [this] { return ! mPackets.empty() || mClosed; };
+	if( timeoutSeconds < 0 )
+		mPacketCondition.wait( lock, ready );
+	else if( timeoutSeconds > 0 )
+		mPacketCondition.wait_for( lock, std::chrono::duration<double>( timeoutSeconds ), ready );
+
+	if( mPackets.empty() )
+		return false;
+
+	packet->swap( mPackets.front() );
+	mPackets.pop_front();
+	return true;
+}
+
+size_t AsyncReader::getNumQueuedPackets() const
+{
+	std::lock_guard<std::mutex> lock( mPacketMutex );
+	return mPackets.size();
+}
+
+void AsyncReader::write( const void *data, size_t size )
+{
+	if( mClosed )
+		throw SerialExcWriteFailure();
+
+	{
+		std::lock_guard<std::mutex> lock( mWriteMutex );
+		const uint8_t *bytes = static_cast<const uint8_t*>( data );
+		mQueuedWrites.insert( mQueuedWrites.end(), bytes, bytes + size );
+		mNumQueuedForWrite += size;
+	}
+	wake();
+}
+
+} // anonymous namespace
+
+#endif // defined( CINDER_LINUX )
+
 struct Serial::Impl {
 	Impl( const Serial::Device &device, int baudRate );
 	~Impl();
@@ -61,6 +416,14 @@ struct Serial::Impl {
 	int				mFd;
 	::termios		mSavedOptions;
 #endif
+#if defined( CINDER_LINUX )
+	//! Moves up to \a size of the bytes left unread by stopAsync() into \a data, returning how many were moved
+	size_t	readUnread( void *data, size_t size );
+
+	std::unique_ptr<AsyncReader>	mAsync;
+	// bytes the background thread received but weren't read before stopAsync(), read before the device
+	std::vector<uint8_t>			mUnread;
+#endif
 };
 
 Serial::Serial( const Serial::Device &device, int baudRate )
@@ -102,6 +465,10 @@ Serial::Impl::Impl( const Serial::Device &device, int baudRate )
 	if( baudToConstant.find( baudRate ) != baudToConstant.end() )
 		rateConstant = baudToConstant[baudRate];
 	
+#if defined( CINDER_LINUX )
+	// raw mode, so that bytes arrive as they're received and binary data isn't translated
+	::cfmakeraw( &options );
+#endif
 	::cfsetispeed( &options, rateConstant );
 	::cfsetospeed( &options, rateConstant );
 	
@@ -142,6 +509,9 @@ Serial::Impl::Impl( const Serial::Device &device, int baudRate )
 
 Serial::Impl::~Impl()
 {
+#if defined( CINDER_LINUX )
+	mAsync.reset();
+#endif
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
 	// restore the termios from before we opened the port
 	::tcsetattr( mFd, TCSANOW, &mSavedOptions );
@@ -152,6 +522,18 @@ Serial::Impl::~Impl()
 #endif
 }
 
+#if defined( CINDER_LINUX )
+size_t Serial::Impl::readUnread( void *data, size_t size )
+{
+	const size_t numRead = std::min( size, mUnread.size() );
+	if( numRead > 0 ) {
+		std::memcpy( data, mUnread.data(), numRead );
+		mUnread.erase( mUnread.begin(), mUnread.begin() + numRead );
+	}
+	return numRead;
+}
+#endif
+
 Serial::Device Serial::findDeviceByName( const std::string &name, bool forceRefresh )
 {
 	for( const auto& device : getDevices( forceRefresh ) ) {
@@ -252,11 +634,18 @@ const Serial::Device& Serial::getDevice() const
 
 void Serial::writeBytes( const void *data, size_t numBytes )
 {
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync ) {
+		mImpl->mAsync->write( data, numBytes );
+		return;
+	}
+#endif
+
 	size_t totalBytesWritten = 0;
 	
 	while( totalBytesWritten < numBytes ) {
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
-		long bytesWritten = ::write( mImpl->mFd, data, numBytes - totalBytesWritten );
+		long bytesWritten = ::write( mImpl->mFd, static_cast<const uint8_t*>( data ) + totalBytesWritten, numBytes - totalBytesWritten );
 		if( ( bytesWritten == -1 ) && ( errno != EAGAIN ) )
 			throw SerialExcWriteFailure();
 #elif defined( CINDER_MSW )
@@ -271,10 +660,20 @@ void Serial::writeBytes( const void *data, size_t numBytes )
 
 void Serial::readBytes( void *data, size_t numBytes )
 {
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync ) {
+		for( size_t totalBytesRead = 0; totalBytesRead < numBytes; )
+			totalBytesRead += mImpl->mAsync->read( static_cast<uint8_t*>( data ) + totalBytesRead, numBytes - totalBytesRead, -1 );
+		return;
+	}
+
+	size_t totalBytesRead = mImpl->readUnread( data, numBytes );
+#else
 	size_t totalBytesRead = 0;
+#endif
 	while( totalBytesRead < numBytes ) {
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
-		long bytesRead = ::read( mImpl->mFd, data, numBytes - totalBytesRead );
+		long bytesRead = ::read( mImpl->mFd, static_cast<uint8_t*>( data ) + totalBytesRead, numBytes - totalBytesRead );
 		if( ( bytesRead == -1 ) && ( errno != EAGAIN ) )
 			throw SerialExcReadFailure();
 #elif defined( CINDER_MSW )
@@ -292,6 +691,13 @@ void Serial::readBytes( void *data, size_t numBytes )
 
 size_t Serial::readAvailableBytes( void *data, size_t maximumBytes )
 {
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->read( static_cast<uint8_t*>( data ), maximumBytes, 0 );
+	if( ! mImpl->mUnread.empty() )
+		return mImpl->readUnread( data, maximumBytes );
+#endif
+
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
 	long bytesRead = ::read( mImpl->mFd, data, maximumBytes );
 #elif defined( CINDER_MSW )
@@ -329,7 +735,17 @@ std::string Serial::readStringUntil( char token, size_t maxLength, double timeou
 
 	bool done = false;
 	while( ! done ) {
-		char v = readChar();
+		char v;
+#if defined( CINDER_LINUX )
+		// waits for the background thread rather than polling the device
+		if( mImpl->mAsync ) {
+			const double remainingSeconds = useTimer ? std::max( timeoutSeconds - timer.getSeconds(), 0.0 ) : -1;
+			if( mImpl->mAsync->read( reinterpret_cast<uint8_t*>( &v ), 1, remainingSeconds ) == 0 )
+				throw SerialTimeoutExc();
+		}
+		else
+#endif
+		v = readChar();
 		buffer.push_back( v );
 		if( v == token ) {
 			done = true;
@@ -351,6 +767,11 @@ void Serial::writeString( const std::string &str )
 
 size_t Serial::getNumBytesAvailable() const
 {
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->getNumBytesAvailable();
+#endif
+
 	int result;
 	
 #if defined( CINDER_MAC ) || defined( CINDER_LINUX )
@@ -363,8 +784,12 @@ size_t Serial::getNumBytesAvailable() const
 	else
 		result = status.cbInQue;
 #endif
-	
+
+#if defined( CINDER_LINUX )
+	return result + mImpl->mUnread.size();
+#else
 	return result;
+#endif
 }
 	
 void Serial::flush( bool input, bool output )
@@ -381,6 +806,10 @@ void Serial::flush( bool input, bool output )
 		return;
 	
 	::tcflush( mImpl->mFd, queue );
+#if defined( CINDER_LINUX )
+	if( input )
+		mImpl->mUnread.clear();
+#endif
 #elif defined( CINDER_MSW )
 	::DWORD flags = 0;
 	flags |= ( input ) ? PURGE_RXCLEAR : 0;
@@ -391,4 +820,383 @@ void Serial::flush( bool input, bool output )
 #endif
 }
 
+void Serial::startAsync( const AsyncOptions &options )
+{
+#if defined( CINDER_LINUX )
+	stopAsync();
+	mImpl->mAsync.reset( new AsyncReader( mImpl->mFd, options, mImpl->mUnread ) );
+	mImpl->mUnread.clear();
+#else
+	throw SerialExc( "Serial::startAsync() is only supported on Linux." );
+#endif
+}
+
+void Serial::stopAsync()
+{
+#if defined( CINDER_LINUX )
+	if( ! mImpl->mAsync )
+		return;
+
+	// keep the bytes that weren't read yet for the reads that follow
+	mImpl->mAsync->stop();
+	const size_t numUnread = mImpl->mAsync->getNumBytesAvailable();
+	if( numUnread > 0 ) {
+		const size_t offset = mImpl->mUnread.size();
+		mImpl->mUnread.resize( offset + numUnread );
+		mImpl->mAsync->read( mImpl->mUnread.data() + offset, numUnread, 0 );
+	}
+	mImpl->mAsync.reset();
+#endif
+}
+
+bool Serial::isAsync() const
+{
+#if defined( CINDER_LINUX )
+	return mImpl->mAsync != nullptr;
+#else
+	return false;
+#endif
+}
+
+bool Serial::readPacket( std::vector<uint8_t> *packet, double timeoutSeconds )
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync && mImpl->mAsync->getOptions().getFramer() )
+		return mImpl->mAsync->readPacket( packet, timeoutSeconds );
+#endif
+
+	throw SerialExc( "Serial::readPacket() requires startAsync() with a SerialFramer." );
+}
+
+void Serial::writePacket( const void *data, size_t size )
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync && mImpl->mAsync->getOptions().getFramer() ) {
+		const auto framed = mImpl->mAsync->getOptions().getFramer()->frame( data, size );
+		writeBytes( framed.data(), framed.size() );
+		return;
+	}
+#endif
+
+	throw SerialExc( "Serial::writePacket() requires startAsync() with a SerialFramer." );
+}
+
+size_t Serial::getNumQueuedPackets() const
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->getNumQueuedPackets();
+#endif
+	return 0;
+}
+
+size_t Serial::getNumBytesQueuedForWrite() const
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->mNumQueuedForWrite;
+#endif
+	return 0;
+}
+
+size_t Serial::getNumBytesDropped() const
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->mNumBytesDropped;
+#endif
+	return 0;
+}
+
+size_t Serial::getNumPacketsDropped() const
+{
+#if defined( CINDER_LINUX )
+	if( mImpl->mAsync )
+		return mImpl->mAsync->mNumPacketsDropped;
+#endif
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SerialDelimiterFramer
+
+SerialDelimiterFramer::SerialDelimiterFramer( uint8_t delimiter, size_t maxPacketSize )
+	: mDelimiter( delimiter ), mMaxPacketSize( maxPacketSize ), mOverflowed( false )
+{
+}
+
+void SerialDelimiterFramer::process( const uint8_t *data, size_t size, const PacketFn &packetFn )
+{
+	const uint8_t *end = data + size;
+	while( data < end ) {
+		const uint8_t *delimiter = static_cast<const uint8_t*>( memchr( data, mDelimiter, end - data ) );
+		const uint8_t *runEnd = delimiter ? delimiter : end;
+		if( mPacket.size() + ( runEnd - data ) > mMaxPacketSize )
+			mOverflowed = true;
+		else
+			mPacket.insert( mPacket.end(), data, runEnd );
+
+		if( delimiter ) {
+			if( mOverflowed )
+				++mNumErrors;
+			else
+				packetFn( mPacket.data(), mPacket.size() );
+			reset();
+			data = delimiter + 1;
+		}
+		else
+			data = end;
+	}
+}
+
+std::vector<uint8_t> SerialDelimiterFramer::frame( const void *data, size_t size ) const
+{
+	const uint8_t *bytes = static_cast<const uint8_t*>( data );
+	if( memchr( bytes, mDelimiter, size ) )
+		throw SerialExc( "Packet contains the delimiter." );
+
+	std::vector<uint8_t> result( bytes, bytes + size );
+	result.push_back( mDelimiter );
+	return result;
+}
+
+void SerialDelimiterFramer::reset()
+{
+	mPacket.clear();
+	mOverflowed = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SerialLengthPrefixFramer
+
+SerialLengthPrefixFramer::SerialLengthPrefixFramer( size_t numLengthBytes, bool bigEndian, size_t maxPacketSize )
+	: mNumLengthBytes( numLengthBytes ), mBigEndian( bigEndian ), mMaxPacketSize( maxPacketSize ), mNumHeaderBytes( 0 ), mPacketSize( 0 )
+{
+	if( numLengthBytes != 1 && numLengthBytes != 2 && numLengthBytes != 4 )
+		throw SerialExc( "The length prefix must be 1, 2 or 4 bytes." );
+}
+
+void SerialLengthPrefixFramer::process( const uint8_t *data, size_t size, const PacketFn &packetFn )
+{
+	const uint8_t *end = data + size;
+	while( data < end ) {
+		if( mNumHeaderBytes < mNumLengthBytes ) {
+			if( mBigEndian )
+				mPacketSize = ( mPacketSize << 8 ) | *data;
+			else
+				mPacketSize |= size_t( *data ) << ( 8 * mNumHeaderBytes );
+			++data;
+
+			if( ++mNumHeaderBytes == mNumLengthBytes ) {
+				if( mPacketSize > mMaxPacketSize ) {
+					++mNumErrors;
+					reset();
+				}
+				else
+					mPacket.reserve( mPacketSize );
+			}
+		}
+		else {
+			const size_t numBytes = std::min<size_t>( mPacketSize - mPacket.size(), end - data );
+			mPacket.insert( mPacket.end(), data, data + numBytes );
+			data += numBytes;
+		}
+
+		if( mNumHeaderBytes == mNumLengthBytes && mPacket.size() == mPacketSize ) {
+			packetFn( mPacket.data(), mPacket.size() );
+			reset();
+		}
+	}
+}
+
+std::vector<uint8_t> SerialLengthPrefixFramer::frame( const void *data, size_t size ) const
+{
+	if( size > mMaxPacketSize || ( mNumLengthBytes < 4 && size >> ( 8 * mNumLengthBytes ) ) )
+		throw SerialExc( "Packet is too large for its length prefix." );
+
+	std::vector<uint8_t> result;
+	result.reserve( mNumLengthBytes + size );
+	for( size_t i = 0; i < mNumLengthBytes; ++i ) {
+		const size_t shift = 8 * ( mBigEndian ? mNumLengthBytes - 1 - i : i );
+		result.push_back( uint8_t( size >> shift ) );
+	}
+	const uint8_t *bytes = static_cast<const uint8_t*>( data );
+	result.insert( result.end(), bytes, bytes + size );
+	return result;
+}
+
+void SerialLengthPrefixFramer::reset()
+{
+	mPacket.clear();
+	mNumHeaderBytes = 0;
+	mPacketSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SerialCobsFramer
+
+SerialCobsFramer::SerialCobsFramer( size_t maxPacketSize )
+	: mMaxPacketSize( maxPacketSize ), mOverflowed( false )
+{
+}
+
+void SerialCobsFramer::process( const uint8_t *data, size_t size, const PacketFn &packetFn )
+{
+	// one code byte per 254 bytes, plus the first
+	const size_t maxEncodedSize = mMaxPacketSize + mMaxPacketSize / 254 + 1;
+
+	const uint8_t *end = data + size;
+	while( data < end ) {
+		const uint8_t *delimiter = static_cast<const uint8_t*>( memchr( data, 0, end - data ) );
+		const uint8_t *runEnd = delimiter ? delimiter : end;
+		if( mEncoded.size() + ( runEnd - data ) > maxEncodedSize )
+			mOverflowed = true;
+		else
+			mEncoded.insert( mEncoded.end(), data, runEnd );
+
+		if( ! delimiter )
+			break;
+		data = delimiter + 1;
+
+		if( mOverflowed ) {
+			++mNumErrors;
+			reset();
+			continue;
+		}
+		if( mEncoded.empty() )
+			continue;
+
+		mPacket.clear();
+		bool valid = true;
+		for( size_t i = 0; i < mEncoded.size(); ) {
+			const size_t code = mEncoded[i++];
+			if( code == 0 || i + code - 1 > mEncoded.size() ) {
+				valid = false;
+				break;
+			}
+			mPacket.insert( mPacket.end(), mEncoded.begin() + i, mEncoded.begin() + i + code - 1 );
+			i += code - 1;
+			if( code < 0xFF && i < mEncoded.size() )
+				mPacket.push_back( 0 );
+		}
+
+		if( valid && mPacket.size() <= mMaxPacketSize )
+			packetFn( mPacket.data(), mPacket.size() );
+		else
+			++mNumErrors;
+		reset();
+	}
+}
+
+std::vector<uint8_t> SerialCobsFramer::frame( const void *data, size_t size ) const
+{
+	const uint8_t *bytes = static_cast<const uint8_t*>( data );
+	std::vector<uint8_t> result;
+	result.reserve( size + size / 254 + 2 );
+
+	size_t codeIndex = 0;
+	uint8_t code = 1;
+	result.push_back( 0 );
+	for( size_t i = 0; i < size; ++i ) {
+		if( bytes[i] != 0 ) {
+			result.push_back( bytes[i] );
+			++code;
+		}
+		if( bytes[i] == 0 || code == 0xFF ) {
+			result[codeIndex] = code;
+			codeIndex = result.size();
+			result.push_back( 0 );
+			code = 1;
+		}
+	}
+	result[codeIndex] = code;
+	result.push_back( 0 );
+	return result;
+}
+
+void SerialCobsFramer::reset()
+{
+	mEncoded.clear();
+	mOverflowed = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SerialSlipFramer
+
+namespace {
+
+const uint8_t kSlipEnd = 0xC0, kSlipEsc = 0xDB, kSlipEscEnd = 0xDC, kSlipEscEsc = 0xDD;
+
+} // anonymous namespace
+
+SerialSlipFramer::SerialSlipFramer( size_t maxPacketSize )
+	: mMaxPacketSize( maxPacketSize ), mEscaped( false ), mInvalid( false )
+{
+}
+
+void SerialSlipFramer::process( const uint8_t *data, size_t size, const PacketFn &packetFn )
+{
+	for( const uint8_t *end = data + size; data < end; ++data ) {
+		const uint8_t byte = *data;
+		if( byte == kSlipEnd ) {
+			// empty packets are only END bytes used to flush line noise
+			if( mInvalid || mEscaped )
+				++mNumErrors;
+			else if( ! mPacket.empty() )
+				packetFn( mPacket.data(), mPacket.size() );
+			reset();
+			continue;
+		}
+
+		uint8_t decoded = byte;
+		if( mEscaped ) {
+			mEscaped = false;
+			if( byte == kSlipEscEnd )
+				decoded = kSlipEnd;
+			else if( byte == kSlipEscEsc )
+				decoded = kSlipEsc;
+			else
+				mInvalid = true;
+		}
+		else if( byte == kSlipEsc ) {
+			mEscaped = true;
+			continue;
+		}
+
+		if( mPacket.size() < mMaxPacketSize )
+			mPacket.push_back( decoded );
+		else
+			mInvalid = true;
+	}
+}
+
+std::vector<uint8_t> SerialSlipFramer::frame( const void *data, size_t size ) const
+{
+	const uint8_t *bytes = static_cast<const uint8_t*>( data );
+	std::vector<uint8_t> result;
+	result.reserve( size + size / 8 + 2 );
+	result.push_back( kSlipEnd );
+	for( size_t i = 0; i < size; ++i ) {
+		if( bytes[i] == kSlipEnd ) {
+			result.push_back( kSlipEsc );
+			result.push_back( kSlipEscEnd );
+		}
+		else if( bytes[i] == kSlipEsc ) {
+			result.push_back( kSlipEsc );
+			result.push_back( kSlipEscEsc );
+		}
+		else
+			result.push_back( bytes[i] );
+	}
+	result.push_back( kSlipEnd );
+	return result;
+}
+
+void SerialSlipFramer::reset()
+{
+	mPacket.clear();
+	mEscaped = false;
+	mInvalid = false;
+}
+
 } // namespace cinder
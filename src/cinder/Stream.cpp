@@ -26,6 +26,15 @@
 #include "cinder/Stream.h"
 #include "cinder/Utilities.h"
 
+#if defined( CINDER_MSW_DESKTOP )
+	#include <windows.h>
+#elif defined( CINDER_POSIX )
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
 #include <stdio.h>
 #include <limits>
 #include <iostream>
@@ -608,6 +617,25 @@ bool IStreamMem::isEof() const
 	return mOffset >= mDataSize;
 }
 
+std::string IStreamMem::readLine()
+{
+	const uint8_t *begin = mData + std::min( mOffset, mDataSize );
+	const uint8_t *end = mData + mDataSize;
+	const uint8_t *lineEnd = begin;
+	while( lineEnd < end && *lineEnd != 0x0A && *lineEnd != 0x0D )
+		++lineEnd;
+
+	string result( reinterpret_cast<const char*>( begin ), lineEnd - begin );
+	if( lineEnd < end ) {
+		// consume a CR LF pair as a single line ending
+		if( *lineEnd == 0x0D && lineEnd + 1 < end && lineEnd[1] == 0x0A )
+			++lineEnd;
+		++lineEnd;
+	}
+	mOffset = lineEnd - mData;
+	return result;
+}
+
 void IStreamMem::IORead( void *t, size_t size )
 {
 	if ( mOffset + size > mDataSize )
@@ -616,6 +644,159 @@ void IStreamMem::IORead( void *t, size_t size )
 	mOffset += size;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile
+#if defined( CINDER_POSIX )
+namespace {
+
+int accessToAdvice( MappedFile::Access access )
+{
+	switch( access ) {
+		case MappedFile::Access::SEQUENTIAL: return MADV_SEQUENTIAL;
+		case MappedFile::Access::RANDOM: return MADV_RANDOM;
+		case MappedFile::Access::WILL_NEED: return MADV_WILLNEED;
+		default: return MADV_NORMAL;
+	}
+}
+
+} // anonymous namespace
+#endif
+
+MappedFileRef MappedFile::create( const fs::path &path, Access access )
+{
+	return MappedFileRef( new MappedFile( path, access ) );
+}
+
+MappedFile::MappedFile( const fs::path &path, Access access )
+	: mFilePath( path ), mData( nullptr ), mSize( 0 )
+{
+#if defined( CINDER_MSW_DESKTOP )
+	// Windows has no madvise() equivalent for mapped views, but the hint still steers the file cache's read-ahead
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if( access == Access::SEQUENTIAL )
+		flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	else if( access == Access::RANDOM )
+		flags |= FILE_FLAG_RANDOM_ACCESS;
+	mFileHandle = ::CreateFileW( expandPath( path ).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL );
+	mMappingHandle = NULL;
+	if( mFileHandle == INVALID_HANDLE_VALUE )
+		throw StreamExc( "(MappedFile) couldn't open: " + path.string() );
+
+	LARGE_INTEGER size;
+	if( ! ::GetFileSizeEx( mFileHandle, &size ) ) {
+		::CloseHandle( mFileHandle );
+		throw StreamExc( "(MappedFile) couldn't determine the size of: " + path.string() );
+	}
+	mSize = static_cast<size_t>( size.QuadPart );
+
+	// an empty file can't be mapped; it's left with no data
+	if( mSize > 0 ) {
+		mMappingHandle = ::CreateFileMappingW( mFileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+		if( mMappingHandle )
+			mData = static_cast<uint8_t*>( ::MapViewOfFile( mMappingHandle, FILE_MAP_COPY, 0, 0, 0 ) );
+		if( ! mData ) {
+			if( mMappingHandle )
+				::CloseHandle( mMappingHandle );
+			::CloseHandle( mFileHandle );
+			throw StreamExc( "(MappedFile) couldn't map: " + path.string() );
+		}
+	}
+#elif defined( CINDER_POSIX )
+	int fd = ::open( expandPath( path ).string().c_str(), O_RDONLY );
+	if( fd < 0 )
+		throw StreamExc( "(MappedFile) couldn't open: " + path.string() );
+
+	struct stat fileStat;
+	if( ::fstat( fd, &fileStat ) != 0 ) {
+		::close( fd );
+		throw StreamExc( "(MappedFile) couldn't determine the size of: " + path.string() );
+	}
+	mSize = static_cast<size_t>( fileStat.st_size );
+
+	// an empty file can't be mapped; it's left with no data. The mapping remains valid after closing the descriptor.
+	if( mSize > 0 ) {
+		void *data = ::mmap( nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+		if( data == MAP_FAILED ) {
+			::close( fd );
+			throw StreamExc( "(MappedFile) couldn't map: " + path.string() );
+		}
+		mData = static_cast<uint8_t*>( data );
+	}
+	::close( fd );
+
+	if( access != Access::NORMAL )
+		advise( access );
+#else
+	throw StreamExc( "(MappedFile) memory mapped files are unsupported on this platform: " + path.string() );
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined( CINDER_MSW_DESKTOP )
+	if( mData )
+		::UnmapViewOfFile( mData );
+	if( mMappingHandle )
+		::CloseHandle( mMappingHandle );
+	::CloseHandle( mFileHandle );
+#elif defined( CINDER_POSIX )
+	if( mData )
+		::munmap( mData, mSize );
+#endif
+}
+
+void MappedFile::advise( Access access, size_t offset, size_t length )
+{
+#if defined( CINDER_POSIX )
+	if( ! mData || offset >= mSize )
+		return;
+	if( length == 0 || offset + length > mSize )
+		length = mSize - offset;
+
+	// madvise() requires a page aligned address
+	const size_t pageSize = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+	const size_t alignedOffset = offset - offset % pageSize;
+	::madvise( mData + alignedOffset, length + offset - alignedOffset, accessToAdvice( access ) );
+#endif
+}
+
+BufferRef MappedFile::createBuffer( size_t offset, size_t size )
+{
+	if( offset > mSize || size > mSize - offset )
+		throw StreamExc( "(MappedFile) buffer out of range: " + mFilePath.string() );
+	if( size == 0 )
+		size = mSize - offset;
+
+	// the Buffer doesn't own the data, so its deleter keeps the mapping alive instead
+	MappedFileRef mappedFile = shared_from_this();
+	return BufferRef( new Buffer( mData + offset, size ), [mappedFile]( Buffer *buffer ) { delete buffer; } );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// IStreamMapped
+IStreamMappedRef IStreamMapped::create( const MappedFileRef &mappedFile )
+{
+	return IStreamMappedRef( new IStreamMapped( mappedFile ) );
+}
+
+IStreamMapped::IStreamMapped( const MappedFileRef &mappedFile )
+	: IStreamMem( mappedFile->getData(), mappedFile->getSize() ), mMappedFile( mappedFile )
+{
+	setFileName( mappedFile->getFilePath() );
+}
+
+BufferRef IStreamMapped::readBuffer( size_t size )
+{
+	if( size > mDataSize - mOffset )
+		throw StreamExc();
+	if( size == 0 )
+		return Buffer::create( 0 );
+
+	BufferRef result = mMappedFile->createBuffer( mOffset, size );
+	mOffset += size;
+	return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // OStreamMem
 OStreamMem::OStreamMem( size_t bufferSizeHint )
@@ -681,6 +862,11 @@ IStreamFileRef loadFileStream( const fs::path &path )
 		return IStreamFileRef();
 }
 
+IStreamMappedRef loadFileStreamMapped( const fs::path &path, MappedFile::Access access )
+{
+	return IStreamMapped::create( MappedFile::create( path, access ) );
+}
+
 std::shared_ptr<OStreamFile> writeFileStream( const fs::path &path, bool createParents )
 {
 	if( createParents && path.has_parent_path() ) {
@@ -0,0 +1,364 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/TaskScheduler.h"
+
+#include "cinder/app/AppBase.h"
+#include "cinder/Utilities.h"
+
+namespace cinder {
+
+namespace {
+
+// ranges are split into more tasks than there are threads, so that threads which finish early can steal the remainder
+const size_t sTasksPerThread = 4;
+
+thread_local const TaskScheduler	*sCurrentScheduler = nullptr;
+thread_local size_t					sCurrentWorkerIndex = 0;
+
+} // anonymous namespace
+
+struct TaskScheduler::Worker {
+	size_t				mIndex;
+	std::mutex			mMutex;
+	std::deque<TaskRef>	mTasks; // the back is run by this Worker, the front is stolen by others
+	std::thread			mThread;
+};
+
+// -------------------------------------------------------------------------------------------------
+// Task
+// -------------------------------------------------------------------------------------------------
+Task::Task( TaskScheduler *scheduler, const std::function<void ()> &fn, const char *name )
+	: mScheduler( scheduler ), mFn( fn ), mName( name ), mNumDependencies( 1 ), mComplete( false )
+{
+}
+
+void Task::wait() const
+{
+	TaskScheduler *scheduler = mScheduler;
+	while( ! mComplete ) {
+		if( TaskRef task = scheduler->findTask() ) {
+			scheduler->execute( task );
+			continue;
+		}
+
+		// sleep until this task completes, or there's another one to run in the meantime
+		std::unique_lock<std::mutex> lock( scheduler->mSleepMutex );
+		++scheduler->mNumWaiting;
+		scheduler->mSleepCondition.wait( lock, [this, scheduler] { return mComplete || ( scheduler->mNumQueued > 0 ); } );
+		--scheduler->mNumWaiting;
+	}
+
+	if( mException )
+		std::rethrow_exception( mException );
+}
+
+// -------------------------------------------------------------------------------------------------
+// TaskScheduler
+// -------------------------------------------------------------------------------------------------
+TaskScheduler::TaskScheduler( const Options &options )
+	: mNumQueued( 0 ), mNumWaiting( 0 ), mQuit( false )
+{
+	// the thread waiting for tasks runs them too, so it's counted in Options::getNumThreads()
+	for( size_t w = 0; w + 1 < options.getNumThreads(); ++w ) {
+		mWorkers.emplace_back( new Worker );
+		mWorkers.back()->mIndex = w;
+	}
+
+	for( auto &worker : mWorkers )
+		worker->mThread = std::thread( &TaskScheduler::workerEntry, this, worker.get() );
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock( mSleepMutex );
+		mQuit = true;
+	}
+	mSleepCondition.notify_all();
+
+	for( auto &worker : mWorkers )
+		worker->mThread.join();
+}
+
+TaskScheduler& TaskScheduler::instance()
+{
+	static TaskScheduler sInstance;
+	return sInstance;
+}
+
+TaskRef TaskScheduler::run( const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies, const char *name )
+{
+	TaskRef task( new Task( this, fn, name ) );
+	submit( task, dependencies );
+	return task;
+}
+
+TaskRef TaskScheduler::dispatch( const DispatchFn &dispatchFn, const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies, const char *name )
+{
+	TaskRef task( new Task( this, fn, name ) );
+	task->mDispatchFn = dispatchFn;
+	submit( task, dependencies );
+	return task;
+}
+
+TaskRef TaskScheduler::runOnMainThread( const std::function<void ()> &fn, const std::vector<TaskRef> &dependencies, const char *name )
+{
+	if( ! app::AppBase::get() )
+		throw TaskSchedulerExc( "runOnMainThread() requires an App" );
+
+	return dispatch( []( const std::function<void ()> &mainThreadFn ) {
+		if( app::AppBase::get() )
+			app::AppBase::get()->dispatchAsync( mainThreadFn );
+	}, fn, dependencies, name );
+}
+
+void TaskScheduler::wait( const TaskRef &task )
+{
+	task->wait();
+}
+
+void TaskScheduler::wait( const std::vector<TaskRef> &tasks )
+{
+	std::exception_ptr firstException;
+	for( const TaskRef &task : tasks ) {
+		try {
+			task->wait();
+		}
+		catch( ... ) {
+			if( ! firstException )
+				firstException = std::current_exception();
+		}
+	}
+
+	if( firstException )
+		std::rethrow_exception( firstException );
+}
+
+void TaskScheduler::setTraceFns( const TraceFn &beginFn, const TraceFn &endFn )
+{
+	std::shared_ptr<const TraceFns> traceFns;
+	if( beginFn || endFn )
+		traceFns.reset( new TraceFns{ beginFn, endFn } );
+
+	std::atomic_store( &mTraceFns, traceFns );
+}
+
+void TaskScheduler::submit( const TaskRef &task, const std::vector<TaskRef> &dependencies )
+{
+	for( const TaskRef &dependency : dependencies ) {
+		std::lock_guard<std::mutex> lock( dependency->mSuccessorsMutex );
+		if( ! dependency->mComplete ) {
+			++task->mNumDependencies;
+			dependency->mSuccessors.push_back( task );
+		}
+	}
+
+	// releases the reference held while the dependencies were added
+	if( --task->mNumDependencies == 0 )
+		schedule( task );
+}
+
+void TaskScheduler::schedule( const TaskRef &task )
+{
+	if( task->mDispatchFn ) {
+		task->mDispatchFn( [this, task] { execute( task ); } );
+		return;
+	}
+
+	if( mWorkers.empty() ) {
+		execute( task );
+		return;
+	}
+
+	Worker *currentWorker = getCurrentWorker();
+	if( currentWorker ) {
+		std::lock_guard<std::mutex> lock( currentWorker->mMutex );
+		currentWorker->mTasks.push_back( task );
+	}
+	else {
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		mQueue.push_back( task );
+	}
+
+	// counted once it's queued, so that a thread woken by the count always finds it
+	++mNumQueued;
+	{
+		std::lock_guard<std::mutex> lock( mSleepMutex );
+	}
+	mSleepCondition.notify_one();
+}
+
+void TaskScheduler::execute( const TaskRef &task )
+{
+	const Worker *currentWorker = getCurrentWorker();
+	const size_t threadIndex = currentWorker ? currentWorker->mIndex + 1 : 0;
+	std::shared_ptr<const TraceFns> traceFns = std::atomic_load( &mTraceFns );
+
+	if( traceFns && traceFns->mBeginFn )
+		traceFns->mBeginFn( task->mName, threadIndex );
+
+	try {
+		task->mFn();
+	}
+	catch( ... ) {
+		task->mException = std::current_exception();
+	}
+
+	if( traceFns && traceFns->mEndFn )
+		traceFns->mEndFn( task->mName, threadIndex );
+
+	// release anything captured by the task
+	task->mFn = std::function<void ()>();
+	complete( task.get() );
+}
+
+void TaskScheduler::complete( Task *task )
+{
+	std::vector<TaskRef> successors;
+	{
+		std::lock_guard<std::mutex> lock( task->mSuccessorsMutex );
+		task->mComplete = true;
+		successors.swap( task->mSuccessors );
+	}
+
+	if( mNumWaiting > 0 ) {
+		{
+			std::lock_guard<std::mutex> lock( mSleepMutex );
+		}
+		mSleepCondition.notify_all();
+	}
+
+	for( const TaskRef &successor : successors ) {
+		if( --successor->mNumDependencies == 0 )
+			successor->mScheduler->schedule( successor );
+	}
+}
+
+TaskRef TaskScheduler::findTask()
+{
+	if( mNumQueued <= 0 )
+		return nullptr;
+
+	TaskRef result;
+	Worker *currentWorker = getCurrentWorker();
+	if( currentWorker ) {
+		std::lock_guard<std::mutex> lock( currentWorker->mMutex );
+		if( ! currentWorker->mTasks.empty() ) {
+			result = std::move( currentWorker->mTasks.back() );
+			currentWorker->mTasks.pop_back();
+		}
+	}
+
+	if( ! result ) {
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		if( ! mQueue.empty() ) {
+			result = std::move( mQueue.front() );
+			mQueue.pop_front();
+		}
+	}
+
+	// steal the oldest task of another Worker, starting with the next one along so that thieves spread out
+	const size_t firstVictim = currentWorker ? currentWorker->mIndex + 1 : 0;
+	for( size_t w = 0; ( ! result ) && ( w < mWorkers.size() ); ++w ) {
+		Worker *victim = mWorkers[( firstVictim + w ) % mWorkers.size()].get();
+		if( victim == currentWorker )
+			continue;
+
+		std::lock_guard<std::mutex> lock( victim->mMutex );
+		if( ! victim->mTasks.empty() ) {
+			result = std::move( victim->mTasks.front() );
+			victim->mTasks.pop_front();
+		}
+	}
+
+	if( result )
+		--mNumQueued;
+
+	return result;
+}
+
+void TaskScheduler::workerEntry( Worker *worker )
+{
+	sCurrentScheduler = this;
+	sCurrentWorkerIndex = worker->mIndex;
+	setThreadName( "TaskScheduler" );
+
+	while( true ) {
+		if( TaskRef task = findTask() ) {
+			execute( task );
+			continue;
+		}
+
+		// queued tasks are run before quitting
+		std::unique_lock<std::mutex> lock( mSleepMutex );
+		if( mQuit && ( mNumQueued <= 0 ) )
+			return;
+		mSleepCondition.wait( lock, [this] { return mQuit || ( mNumQueued > 0 ); } );
+	}
+}
+
+TaskScheduler::Worker* TaskScheduler::getCurrentWorker() const
+{
+	return ( sCurrentScheduler == this ) ? mWorkers[sCurrentWorkerIndex].get() : nullptr;
+}
+
+size_t TaskScheduler::calcNumTasks( size_t count, size_t minItemsPerTask ) const
+{
+	if( mWorkers.empty() )
+		return 1;
+
+	return std::min( count / std::max<size_t>( minItemsPerTask, 1 ), getNumThreads() * sTasksPerThread );
+}
+
+void TaskScheduler::runRanges( size_t count, size_t numTasks, const std::function<void ( size_t task, size_t begin, size_t end )> &fn )
+{
+	const size_t itemsPerTask = ( count + numTasks - 1 ) / numTasks;
+	std::vector<TaskRef> tasks;
+	for( size_t task = 1; task * itemsPerTask < count; ++task ) {
+		const size_t begin = task * itemsPerTask, end = std::min( begin + itemsPerTask, count );
+		tasks.push_back( run( [&fn, task, begin, end] { fn( task, begin, end ); }, std::vector<TaskRef>(), "parallelFor" ) );
+	}
+
+	// the calling thread takes the first range, and then helps with the rest
+	std::exception_ptr firstException;
+	try {
+		fn( 0, 0, std::min( itemsPerTask, count ) );
+	}
+	catch( ... ) {
+		firstException = std::current_exception();
+	}
+
+	try {
+		wait( tasks );
+	}
+	catch( ... ) {
+		if( ! firstException )
+			firstException = std::current_exception();
+	}
+
+	if( firstException )
+		std::rethrow_exception( firstException );
+}
+
+} // namespace cinder
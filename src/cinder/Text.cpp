@@ -392,18 +392,17 @@ void Line::render( Surface &surface, float currentY, float xBorder, float maxWid
 
 		std::u32string strU32 = ci::toUtf32( runIt->mText );
 		for( const auto& ch : strU32 ) {
-			FT_Set_Transform( face, nullptr, &pen );
-
 			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
+			ci::linux::ftutil::CachedGlyphRef glyph = ci::linux::ftutil::GlyphCache::instance().getGlyph( face, glyphIndex, pen );
+			if( ! glyph )
+				continue;
 
-			FT_GlyphSlot slot = face->glyph;
-			ivec2 offset = ivec2( slot->bitmap_left, surfaceSize.y - slot->bitmap_top );
+			ivec2 offset = ivec2( ( pen.x >> 6 ) + glyph->mBitmapLeft, surfaceSize.y - ( ( pen.y >> 6 ) + glyph->mBitmapTop ) );
 
-			draw_bitmap( offset.x, offset.y, &(slot->bitmap), color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
+			draw_bitmap( offset.x, offset.y, const_cast<FT_Bitmap*>( glyph->getBitmap() ), color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
 
-			pen.x += slot->advance.x;
-			pen.y += slot->advance.y;
+			pen.x += glyph->mAdvance.x;
+			pen.y += glyph->mAdvance.y;
 		}
 
 		currentX = (pen.x / 64.0f) + 0.5f;
@@ -1087,10 +1086,9 @@ vector<string> TextBox::calculateLineBreaks( const std::map<Font::Glyph, Font::G
 					auto iter = mCachedGlyphMerics->find( glyphIndex );
 					advance = iter->second.advance;		
 				}
-				else  {
-					FT_Load_Glyph( mFont, glyphIndex, FT_LOAD_DEFAULT );
-					const FT_GlyphSlot& slot = mFont->glyph;
-					advance = ivec2( slot->advance.x, slot->advance.y );
+				else {
+					FT_Vector glyphAdvance = ci::linux::ftutil::GlyphCache::instance().getAdvance( mFont, glyphIndex );
+					advance = ivec2( glyphAdvance.x, glyphAdvance.y );
 				}
 
 				pen.x += advance.x;
@@ -1137,9 +1135,8 @@ vector<pair<uint32_t,vec2>> TextBox::measureGlyphs( const std::map<Font::Glyph,
 				advance = iter->second.advance;
 			}
 			else {
-				FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT );
-				const FT_GlyphSlot& slot = face->glyph;
-				advance = ivec2( slot->advance.x, slot->advance.y );
+				FT_Vector glyphAdvance = ci::linux::ftutil::GlyphCache::instance().getAdvance( face, glyphIndex );
+				advance = ivec2( glyphAdvance.x, glyphAdvance.y );
 			}
 
 			float xPos = (pen.x / 64.0f) + 0.5f;
@@ -1211,19 +1208,18 @@ Surface TextBox::render( vec2 offset )
 
 		std::u32string utf32Chars = ci::toUtf32( text );		
 		for( const auto& ch : utf32Chars ) {
-			FT_Set_Transform( face, nullptr, &pen );
-
 			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
-			const FT_GlyphSlot& slot = face->glyph;
+			ci::linux::ftutil::CachedGlyphRef glyph = ci::linux::ftutil::GlyphCache::instance().getGlyph( face, glyphIndex, pen );
+			if( ! glyph )
+				continue;
 
 			if( '\n' != (char)ch ) {
-				ivec2 drawOffset = ivec2( slot->bitmap_left, dstSize.y - slot->bitmap_top );
-				ci::linux::ftutil::DrawBitmap( drawOffset, &(slot->bitmap), mColor, dstData, dstPixelInc, dstRowBytes, dstSize );
+				ivec2 drawOffset = ivec2( ( pen.x >> 6 ) + glyph->mBitmapLeft, dstSize.y - ( ( pen.y >> 6 ) + glyph->mBitmapTop ) );
+				ci::linux::ftutil::DrawBitmap( drawOffset, const_cast<FT_Bitmap*>( glyph->getBitmap() ), mColor, dstData, dstPixelInc, dstRowBytes, dstSize );
 			}
 
-			pen.x += slot->advance.x;
-			pen.y += slot->advance.y;	
+			pen.x += glyph->mAdvance.x;
+			pen.y += glyph->mAdvance.y;	
 		}
 
 		curY += measure.getHeight();
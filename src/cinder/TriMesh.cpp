@@ -44,6 +44,7 @@ class TriMeshGeomTarget : public geom::Target {
 	uint8_t	getAttribDims( geom::Attrib attr ) const override;
 	void copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float* getAttribStorage( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
   protected:
 	TriMesh		*mMesh;
@@ -60,6 +61,34 @@ void TriMeshGeomTarget::copyAttrib( geom::Attrib attr, uint8_t dims, size_t stri
 	mMesh->copyAttrib( attr, dims, strideBytes, srcData, count );
 }
 
+float* TriMeshGeomTarget::getAttribStorage( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	// only attributes 'mMesh' stores with the same dimensions can be written directly
+	if( mMesh->getAttribDims( attr ) != dims )
+		return nullptr;
+
+	*resultStrideBytes = dims * sizeof(float);
+	switch( attr ) {
+		case geom::Attrib::POSITION:
+			mMesh->getBufferPositions().resize( dims * count );
+			return mMesh->getBufferPositions().data();
+		case geom::Attrib::COLOR:
+			mMesh->getBufferColors().resize( dims * count );
+			return mMesh->getBufferColors().data();
+		case geom::Attrib::TEX_COORD_0:
+			mMesh->getBufferTexCoords0().resize( dims * count );
+			return mMesh->getBufferTexCoords0().data();
+		case geom::Attrib::NORMAL:
+			mMesh->getNormals().resize( count );
+			return (float*)mMesh->getNormals().data();
+		case geom::Attrib::TANGENT:
+			mMesh->getTangents().resize( count );
+			return (float*)mMesh->getTangents().data();
+		default:
+			return nullptr;
+	}
+}
+
 void TriMeshGeomTarget::copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t /*requiredBytesPerIndex*/ )
 {
 	size_t targetNumIndices = numIndices;
@@ -632,85 +661,25 @@ void TriMesh::readImplV1( const IStreamRef &in )
 }
 
 bool TriMesh::recalculateNormals( bool smooth, bool weighted )
+{
+	return recalculateNormals( smooth, weighted ? geom::NormalWeighting::AREA : geom::NormalWeighting::UNIFORM );
+}
+
+bool TriMesh::recalculateNormals( bool smooth, geom::NormalWeighting weighting, float weldEpsilon )
 {
 	// requires valid indices and 3D vertices
 	if( mIndices.empty() || mPositions.empty() || mPositionsDims != 3 )
 		return false;
 
 	size_t numPositions = mPositions.size() / 3;
-	mNormals.assign( numPositions, vec3() );
-
-	// for smooth renormalization, we first find all unique vertices and keep track of them
-	std::vector<uint32_t> uniquePositions;
-	if( smooth ) {
-		uniquePositions.assign( numPositions, 0 );
-
-		for( uint32_t i = 0; i < numPositions; ++i ) {
-			if( uniquePositions[i] == 0 ) {
-				uniquePositions[i] = i + 1;
-				const vec3 &v0 = *(const vec3*)(&mPositions[i * 3]);
-				for( size_t j = i + 1; j < numPositions; ++j ) {
-					const vec3 &v1 = *(const vec3*)(&mPositions[j * 3]);
-					if( length2( v1 - v0 ) < FLT_EPSILON )
-						uniquePositions[j] = uniquePositions[i];
-				}
-			}
-		}
-	}
-
-	// perform surface normalization
-	uint32_t index0, index1, index2;
-	size_t numTriangles = getNumTriangles();
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		if( smooth ) {
-			index0 = uniquePositions[mIndices[i * 3 + 0]] - 1;
-			index1 = uniquePositions[mIndices[i * 3 + 1]] - 1;
-			index2 = uniquePositions[mIndices[i * 3 + 2]] - 1;
-		}
-		else {
-			index0 = mIndices[i*3+0];
-			index1 = mIndices[i*3+1];
-			index2 = mIndices[i*3+2];
-		}
-
-		const vec3 &v0 = *(const vec3*)(&mPositions[index0 * 3]);
-		const vec3 &v1 = *(const vec3*)(&mPositions[index1 * 3]);
-		const vec3 &v2 = *(const vec3*)(&mPositions[index2 * 3]);
-
-		vec3 e0 = v1 - v0;
-		vec3 e1 = v2 - v0;
-		vec3 e2 = v2 - v1;
-
-		if( length2( e0 ) < FLT_EPSILON )
-			continue;
-		if( length2( e1 ) < FLT_EPSILON )
-			continue;
-		if( length2( e2 ) < FLT_EPSILON )
-			continue;
-
-		vec3 normal = cross( e0, e1 );
-
-		// if not weighted, every normal has an equal contribution
-		if( ! weighted )
-			normal = normalize( normal );
-
-		mNormals[ index0 ] += normal;
-		mNormals[ index1 ] += normal;
-		mNormals[ index2 ] += normal;
-	}
-
-	// now normalize the summed normals
-	for( auto &normal : mNormals ) {
-		normal = normalize( normal );
-	}
+	const vec3 *positions = reinterpret_cast<const vec3*>( mPositions.data() );
 
-	// copy normals to corresponding non-unique vertices
-	if( smooth ) {
-		for( size_t i = 0; i < numPositions; ++i ) {
-			mNormals[i] = mNormals[uniquePositions[i]-1];
-		}
-	}
+	// for smooth renormalization, coincident vertices are welded so that they share a normal
+	std::vector<uint32_t> remap;
+	if( smooth )
+		geom::weldVertices( numPositions, positions, weldEpsilon, &remap );
 
+	geom::calculateNormals( mIndices.size(), mIndices.data(), numPositions, positions, smooth ? remap.data() : nullptr, weighting, &mNormals );
 	mNormalsDims = 3;
 
 	return true;
@@ -999,6 +968,69 @@ void TriMesh::subdivide( int division, bool normalize )
 	}
 }
 
+void TriMesh::optimizeVertexCache( geom::VertexCacheMethod method, size_t cacheSize )
+{
+	geom::optimizeVertexCache( mIndices.size(), mIndices.data(), getNumVertices(), &mIndices, method, cacheSize );
+}
+
+bool TriMesh::optimizeOverdraw( float threshold, size_t cacheSize )
+{
+	if( mPositionsDims != 3 )
+		return false;
+
+	geom::optimizeOverdraw( mIndices.size(), mIndices.data(), getNumVertices(), reinterpret_cast<const vec3*>( mPositions.data() ), &mIndices, threshold, cacheSize );
+	return true;
+}
+
+void TriMesh::optimizeVertexFetch()
+{
+	const size_t numVertices = getNumVertices();
+	std::vector<uint32_t> remap;
+	geom::optimizeVertexFetch( mIndices.size(), mIndices.data(), numVertices, &remap );
+
+	// attributes that don't have a value for every vertex are left alone
+	auto remapBuffer = [&]( float *data, size_t size, uint8_t dims ) {
+		if( dims && size == numVertices * dims )
+			geom::remapVertexData( numVertices, dims, remap.data(), data );
+	};
+	remapBuffer( mPositions.data(), mPositions.size(), mPositionsDims );
+	remapBuffer( mColors.data(), mColors.size(), mColorsDims );
+	remapBuffer( (float*)mNormals.data(), mNormals.size() * 3, 3 );
+	remapBuffer( (float*)mTangents.data(), mTangents.size() * 3, 3 );
+	remapBuffer( (float*)mBitangents.data(), mBitangents.size() * 3, 3 );
+	remapBuffer( mTexCoords0.data(), mTexCoords0.size(), mTexCoords0Dims );
+	remapBuffer( mTexCoords1.data(), mTexCoords1.size(), mTexCoords1Dims );
+	remapBuffer( mTexCoords2.data(), mTexCoords2.size(), mTexCoords2Dims );
+	remapBuffer( mTexCoords3.data(), mTexCoords3.size(), mTexCoords3Dims );
+}
+
+bool TriMesh::simplify( float ratio, const geom::SimplifyOptions &options, float *resultError )
+{
+	if( mPositionsDims != 3 )
+		return false;
+
+	const size_t targetNumIndices = size_t( getNumTriangles() * glm::clamp( ratio, 0.0f, 1.0f ) ) * 3;
+	float error = geom::simplify( mIndices.size(), mIndices.data(), getNumVertices(), reinterpret_cast<const vec3*>( mPositions.data() ), targetNumIndices, &mIndices, options );
+	if( resultError )
+		*resultError = error;
+
+	return true;
+}
+
+std::vector<geom::SimplifiedLod> TriMesh::calcLods( const std::vector<float> &ratios, const geom::SimplifyOptions &options ) const
+{
+	std::vector<geom::SimplifiedLod> result;
+	if( mPositionsDims == 3 )
+		geom::simplifyLods( mIndices.size(), mIndices.data(), getNumVertices(), reinterpret_cast<const vec3*>( mPositions.data() ), ratios, &result, options );
+
+	return result;
+}
+
+geom::VertexCacheStats TriMesh::calcVertexCacheStats( size_t cacheSize ) const
+{
+	return geom::simulateVertexCache( mIndices.size(), mIndices.data(), getNumVertices(), cacheSize );
+}
+
 uint8_t TriMesh::getAttribDims( geom::Attrib attr ) const
 {
 	switch( attr ) {
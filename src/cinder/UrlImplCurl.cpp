@@ -21,143 +21,89 @@
 */
 
 #include "cinder/UrlImplCurl.h"
-#include <curl/curl.h>
 
+#include <algorithm>
 #include <cstring>
 
 namespace cinder {
 
-// -------------------------------------------------------------------------------------------------
-// CurlLib
-// -------------------------------------------------------------------------------------------------
-class CurlLib {
-  public:
-	CurlLib();
-	~CurlLib();
+const size_t IStreamUrlImplCurl::MAX_BUFFERED_SIZE;
 
-	static CurlLib*		instance();
-
-  private:
-	CurlLib( const CurlLib& );
-	CurlLib& operator=( const CurlLib& );
-
-	static std::unique_ptr<CurlLib> sInstance;
-};
-
-std::unique_ptr<CurlLib> CurlLib::sInstance;
-
-CurlLib::CurlLib()
+IStreamUrlImplCurl::IStreamUrlImplCurl( const std::string &url, const std::string &user, const std::string &password, const UrlOptions &options )
+	: IStreamUrlImpl( user, password, options ), mComplete( false ), mBufferOffset( 0 ), mBufferFileOffset( 0 ), mWantBytes( 0 )
 {
-	curl_global_init( CURL_GLOBAL_NOTHING );
+	mBuffer.reserve( DEFAULT_BUFFER_SIZE );
+
+	// the transfer starts straight away, so the body may have arrived by the time it's first read. receive() waits for mTransfer to be assigned.
+	std::lock_guard<std::mutex> lock( mMutex );
+	mTransfer = HttpClient::instance().fetch( Url( url, true ), mUser, mPassword, mOptions,
+		[this]( const void *data, size_t size ) { return receive( data, size ); },
+		[this]( const HttpTransfer & ) {
+			std::lock_guard<std::mutex> lock( mMutex );
+			mComplete = true;
+			mDataCondition.notify_all();
+		} );
 }
 
-CurlLib::~CurlLib()
+IStreamUrlImplCurl::~IStreamUrlImplCurl()
 {
-	curl_global_cleanup();	
+	// the callbacks refer to this stream, so wait for the transfer to release them
+	mTransfer->cancel();
+	mTransfer->wait();
 }
 
-CurlLib* CurlLib::instance()
+bool IStreamUrlImplCurl::receive( const void *data, size_t size )
 {
-	if( ! sInstance ) {
-		sInstance.reset( new CurlLib() );
-	}
+	std::lock_guard<std::mutex> lock( mMutex );
 
-	return sInstance.get();
-}
-
-
-// -------------------------------------------------------------------------------------------------
-// IStreamUrlImplCurl
-// -------------------------------------------------------------------------------------------------
-IStreamUrlImplCurl::IStreamUrlImplCurl( const std::string &url, const std::string &user, const std::string &password, const UrlOptions &options )
-	: IStreamUrlImpl( user, password, options ), still_running( 1 ), mSizeCached( false ), mBufferFileOffset( 0 ), mStartedRead( false ),
-	mEffectiveUrl( 0 ), mResponseCode( 0 )
-{	
-	if( ! CurlLib::instance() ) {
-		throw StreamExc(); // for some reason the CurlLib isn't initialized
+	// discard what's been read once it makes up most of the buffer, keeping the rest available to seekRelative()
+	if( ( mBufferOffset >= DEFAULT_BUFFER_SIZE ) && ( mBufferOffset >= mBuffer.size() / 2 ) ) {
+		mBuffer.erase( mBuffer.begin(), mBuffer.begin() + mBufferOffset );
+		mBufferFileOffset += mBufferOffset;
+		mBufferOffset = 0;
 	}
-	
-	mMulti = curl_multi_init();
-
-	mCurl = curl_easy_init();
-	curl_easy_setopt( mCurl, CURLOPT_URL, url.c_str() );
-	curl_easy_setopt( mCurl, CURLOPT_WRITEDATA, this );
-	curl_easy_setopt( mCurl, CURLOPT_VERBOSE, 0L );
-	curl_easy_setopt( mCurl, CURLOPT_FOLLOWLOCATION, 1L );
-	curl_easy_setopt( mCurl, CURLOPT_WRITEFUNCTION, IStreamUrlImplCurl::writeCallback );
 
-	if( ( ! mUser.empty() ) || ( ! mPassword.empty() ) ) {
-		mUserColonPassword = mUser + ":" + mPassword;
-		curl_easy_setopt( mCurl, CURLOPT_USERPWD, mUserColonPassword.c_str() );
-		curl_easy_setopt( mCurl, CURLOPT_HTTPAUTH, CURLAUTH_ANY );
-	}
-		
-	curl_multi_add_handle( mMulti, mCurl );
+	mBuffer.insert( mBuffer.end(), static_cast<const uint8_t*>( data ), static_cast<const uint8_t*>( data ) + size );
+	mDataCondition.notify_all();
 
-	// we fill the buffer just to get things rolling
-	mBufferSize = DEFAULT_BUFFER_SIZE;
-	mBuffer = (uint8_t*)malloc( mBufferSize );
-	mBufferOffset = 0;
-	mBufferedBytes = 0;
-	mBufferFileOffset = 0;
-//	fillBuffer( Stream::MINIMUM_BUFFER_SIZE );
+	// leave the rest of the body with the server until the reader catches up
+	if( bufferRemaining() >= std::max( MAX_BUFFERED_SIZE, mWantBytes ) )
+		mTransfer->pause();
+	return true;
 }
 
-extern "C" {
-
-size_t IStreamUrlImplCurl::writeCallback( char *buffer, size_t size, size_t nitems, void *userp )
+void IStreamUrlImplCurl::resumeIfDrained( size_t wantBytes ) const
 {
-	cinder::IStreamUrlImplCurl *stream = (cinder::IStreamUrlImplCurl*)userp;
-	size *= nitems;
-
-	int roomInBuffer = stream->mBufferSize - stream->mBufferedBytes;
-
-	if( (off_t)size > roomInBuffer ) {
-		// not enough space in buffer
-		int oldBufferSize = stream->mBufferSize;
-		while( stream->mBufferSize - stream->mBufferedBytes <= (off_t)size )
-			stream->mBufferSize *= 2;
-		uint8_t *newBuff = reinterpret_cast<uint8_t*>( realloc( stream->mBuffer, stream->mBufferSize ) );
-		if( ! newBuff ) { // allocation failed - just copy the bytes we can fit
-			size = stream->bufferRemaining();
-			stream->mBufferSize = oldBufferSize;
-		}
-		else {
-			// realloc suceeded increase buffer size
-			stream->mBuffer = newBuff;
-		}
-	}
-
-	memcpy( &stream->mBuffer[stream->mBufferedBytes], buffer, size );
-	stream->mBufferedBytes += size;
-
-	return size;
+	if( bufferRemaining() < std::max( MAX_BUFFERED_SIZE, wantBytes ) )
+		mTransfer->resume();
 }
 
-} // extern "C"
-
-IStreamUrlImplCurl::~IStreamUrlImplCurl()
+void IStreamUrlImplCurl::waitForData( std::unique_lock<std::mutex> &lock, size_t wantBytes ) const
 {
-	if( mBuffer )
-		free( mBuffer );
-
-	curl_multi_remove_handle( mMulti, mCurl );
-	curl_easy_cleanup( mCurl );
-
-	if( mMulti ) {
-		curl_multi_cleanup( mMulti );
-	}
+	mWantBytes = wantBytes;
+	resumeIfDrained( wantBytes );
+	mDataCondition.wait( lock, [this, wantBytes] { return mComplete || ( bufferRemaining() >= wantBytes ); } );
+	mWantBytes = 0;
+
+	// a transfer that failed before delivering anything has nothing to read
+	if( mComplete && ( bufferRemaining() == 0 ) && mTransfer->hasError() )
+		throw StreamExc( mTransfer->getError() );
 }
 
 bool IStreamUrlImplCurl::isEof() const
 {
-	return ( mBufferedBytes - mBufferOffset == 0 ) && ( ! still_running );
+	// with the buffer drained, the end is only known once the transfer completes
+	std::unique_lock<std::mutex> lock( mMutex );
+	resumeIfDrained( 1 );
+	mDataCondition.wait( lock, [this] { return mComplete || ( bufferRemaining() > 0 ); } );
+	return ( bufferRemaining() == 0 ) && mComplete;
 }
 
 void IStreamUrlImplCurl::seekRelative( off_t relativeOffset )
 {
+	std::lock_guard<std::mutex> lock( mMutex );
 	// if this move stays inside the current buffer, we're good
-	if( ( mBufferOffset + relativeOffset >= 0 ) && ( mBufferOffset + relativeOffset < mBufferedBytes ) ) {
+	if( ( (off_t)mBufferOffset + relativeOffset >= 0 ) && ( (off_t)mBufferOffset + relativeOffset < (off_t)mBuffer.size() ) ) {
 		mBufferOffset += relativeOffset;
 		return;
 	}
@@ -171,182 +117,54 @@ void IStreamUrlImplCurl::seekRelative( off_t relativeOffset )
 
 void IStreamUrlImplCurl::seekAbsolute( off_t absoluteOffset )
 {
-	seekRelative( absoluteOffset - ( mBufferFileOffset + mBufferOffset ) );
+	seekRelative( absoluteOffset - tell() );
 }
 
 off_t IStreamUrlImplCurl::tell() const
 {
+	std::lock_guard<std::mutex> lock( mMutex );
 	return mBufferFileOffset + mBufferOffset;
 }
 
 off_t IStreamUrlImplCurl::size() const
 {
-	if( ! mStartedRead )
-		fillBuffer( 1 );
-
-	if( mSizeCached )
-		return mSize;
-	else {
-		if( still_running ) {			
-			double tempSize = 0;
-			CURLcode result = curl_easy_getinfo( mCurl, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &tempSize );
-			if( ( result == CURLE_OK ) && ( tempSize > 0 ) ) {
-				mSize = (off_t)tempSize;
-				mSizeCached = true;
-			}
-			else
-				mSize = 0;
-		}
-		else { // transfer is done, so use CURLINFO_SIZE_DOWNLOAD 
-			double tempSize = 0;
-			CURLcode result = curl_easy_getinfo( mCurl, CURLINFO_SIZE_DOWNLOAD, &tempSize );
-			if( ( result == CURLE_OK ) && ( tempSize > 0 ) ) {
-				mSize = (off_t)tempSize;
-				mSizeCached = true;
-			}
-			else
-				mSize = 0;			
-		}
-		return mSize;
-	}
-}
-
-void IStreamUrlImplCurl::fillBuffer( int wantBytes ) const
-{
-	// first make sure we've started reading, and do so if not
-	if( ! mStartedRead ) {
-		while( curl_multi_perform( mMulti, &still_running ) == CURLM_CALL_MULTI_PERFORM );
-		if( ( bufferRemaining() == 0 ) && ( ! still_running ) ) {			
-			throw StreamExc();
-		}
-		
-		mStartedRead = true;
-	}
-	
-    // only attempt to fill buffer if transactions still running and buffer
-    // doesnt exceed required size already
-    if( ( ! still_running ) || ( bufferRemaining() >= wantBytes ) )
-        return;
-
-	// if we want more bytes than will fit in the rest of the buffer, let's make some room
-	if( ( mBufferSize - mBufferedBytes ) < wantBytes ) {
-		int bytesCulled = mBufferOffset;
-		std::memmove( mBuffer, &mBuffer[mBufferOffset], mBufferedBytes - bytesCulled );
-		mBufferedBytes -= bytesCulled;
-		mBufferOffset = 0;
-		mBufferFileOffset += bytesCulled;
-	}
-
-    // attempt to fill buffer
-    do {
-		fd_set fdread;
-		fd_set fdwrite;
-		fd_set fdexcep;
-		FD_ZERO( &fdread );
-		FD_ZERO( &fdwrite );
-		FD_ZERO( &fdexcep );
-
-		struct timeval timeout;
-		// set a suitable timeout to fail on
-		timeout.tv_sec  = 60; // 1 minute
-		timeout.tv_usec = 0;
-
-		long curl_timeout = -1;
-		curl_multi_timeout( mMulti, &curl_timeout );
-		if( curl_timeout >= 0 ) {
-			timeout.tv_sec = curl_timeout / 1000;
-			if( timeout.tv_sec > 1 ) {
-				timeout.tv_sec = 1;
-			}
-			else {
-				timeout.tv_usec = ( curl_timeout % 1000 ) * 1000;
-			}
-		}
-
-		// get file descriptors from the transfers
-		int maxfd = -1;
-		CURLMcode error = curl_multi_fdset( mMulti, &fdread, &fdwrite, &fdexcep, &maxfd );
-		if( CURLM_OK != error ) {
-			const char* errorStr = curl_multi_strerror( error );
-			throw StreamExc( std::string( errorStr ) );
-		}
-
-		int rc; 
-		if( -1 == maxfd ) {
-			struct timeval wait = { 0, 100 * 1000 };
-			rc = select( 0, nullptr, nullptr, nullptr, &wait );
-		}
-		else {
-			rc = select( maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout );
-		}
-		
-		switch( rc ) {
-			// error
-			case -1:
-				throw StreamExc();
-			break;
-
-			// timeout
-			case 0:
-			// action
-			default:
-				// timeout or readable/writable sockets
-				// note we *could* be more efficient and not wait for
-				// CURLM_CALL_MULTI_PERFORM to clear here and check it on re-entry
-				// but that gets messy
-				while( CURLM_CALL_MULTI_PERFORM == curl_multi_perform( mMulti, &still_running ) );
-			break;
-		}
-    } while( still_running && ( bufferRemaining() < wantBytes ) );
+	std::unique_lock<std::mutex> lock( mMutex );
+	waitForData( lock, 1 );
+
+	// once the transfer is done its size is known, otherwise rely on the server having announced it
+	if( mComplete )
+		return (off_t)mTransfer->getBytesReceived();
+	else
+		return (off_t)std::max<int64_t>( mTransfer->getContentLength(), 0 );
 }
 
 void IStreamUrlImplCurl::IORead( void *dest, size_t size )
 {
-	fillBuffer( size );
+	std::unique_lock<std::mutex> lock( mMutex );
+	waitForData( lock, size );
 	
-	// check if theres data in the buffer - if not fillBuffer() either errored or EOF
-	if( bufferRemaining() < (off_t)size )
+	// check if theres data in the buffer - if not the transfer either errored or reached EOF
+	if( bufferRemaining() < size )
 		throw StreamExc();
 
-	memcpy( dest, mBuffer + mBufferOffset, size );
+	memcpy( dest, mBuffer.data() + mBufferOffset, size );
 	mBufferOffset += size;
+	resumeIfDrained( 0 );
 }
 
 size_t IStreamUrlImplCurl::readDataAvailable( void *dest, size_t maxSize )
 {
-	fillBuffer( maxSize );
+	std::unique_lock<std::mutex> lock( mMutex );
+	waitForData( lock, maxSize );
 	
-	if( bufferRemaining() < (off_t)maxSize )
+	if( bufferRemaining() < maxSize )
 		maxSize = bufferRemaining();
 		
-	memcpy( dest, mBuffer + mBufferOffset, maxSize );
+	memcpy( dest, mBuffer.data() + mBufferOffset, maxSize );
 	
 	mBufferOffset += maxSize;
+	resumeIfDrained( 0 );
 	return maxSize;
 }
 
-/*long IStreamUrlImplCurl::getResponseCode() const
-{
-	if( ! mStartedRead )
-		fillBuffer( 1 );
-
-	if( ! mResponseCode ) {
-		curl_easy_getinfo( mCurl, CURLINFO_RESPONSE_CODE, &mResponseCode );
-	}
-	
-	return mResponseCode;
-}
-
-std::string	IStreamUrlImplCurl::getEffectiveUrl() const
-{
-	if( ! mStartedRead )
-		fillBuffer( 1 );
-
-	if( ! mEffectiveUrl ) {
-		curl_easy_getinfo( mCurl, CURLINFO_EFFECTIVE_URL, &mEffectiveUrl ); 
-	}
-	
-	return std::string( mEffectiveUrl );
-}*/
-
 } // namespace cinder
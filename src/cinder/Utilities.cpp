@@ -25,6 +25,7 @@
 #include "cinder/Cinder.h"
 #include "cinder/Utilities.h"
 #include "cinder/Unicode.h"
+#include "cinder/Profiler.h"
 #include "cinder/app/Platform.h"
 
 #if defined( CINDER_COCOA )
@@ -169,6 +170,7 @@ vector<string> stackTrace()
 void setThreadName( const std::string &name )
 {
 	app::Platform::get()->setThreadName( name );
+	profile::Profiler::instance().setThreadName( name );
 }
 
 int16_t swapEndian( int16_t val )
@@ -0,0 +1,706 @@
+/*
+ Copyright (c) 2018, The Cinder Project
+ All rights reserved.
+
+ This code is designed for use with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+	* Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+	* Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/XmlDocument.h"
+#include "cinder/Unicode.h"
+#include "cinder/Utilities.h"
+
+#include "rapidxml/rapidxml.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+//! Elements with more children than this get a tag index, smaller ones are searched linearly.
+const size_t TAG_INDEX_THRESHOLD = 8;
+
+//! FNV-1a of the lowercased tag, so that the same index serves case sensitive and insensitive lookups.
+uint32_t hashTag( const char *tag, size_t length )
+{
+	uint32_t hash = 2166136261u;
+	for( size_t i = 0; i < length; ++i ) {
+		char c = tag[i];
+		if( c >= 'A' && c <= 'Z' )
+			c += 'a' - 'A';
+		hash = ( hash ^ (uint8_t)c ) * 16777619u;
+	}
+
+	return hash;
+}
+
+//! Returns whether a RapidXML node becomes a child Node, and if so, of which type.
+bool getChildType( const rapidxml::xml_node<> &xmlNode, const XmlTree::ParseOptions &options, XmlTree::NodeType *type )
+{
+	switch( xmlNode.type() ) {
+		case rapidxml::node_element:
+			*type = XmlTree::NODE_ELEMENT;
+			return true;
+		case rapidxml::node_cdata:
+			*type = XmlTree::NODE_CDATA;
+			return ! options.getCollapseCData();
+		case rapidxml::node_comment:
+			*type = XmlTree::NODE_COMMENT;
+			return true;
+		case rapidxml::node_data:
+			*type = XmlTree::NODE_DATA;
+			return ! options.getIgnoreDataChildren();
+		default:
+			return false;
+	}
+}
+
+void countNodes( const rapidxml::xml_node<> &xmlNode, const XmlTree::ParseOptions &options, size_t *numNodes, size_t *numAttributes, size_t *numTagIndexEntries )
+{
+	for( const rapidxml::xml_attribute<> *attr = xmlNode.first_attribute(); attr; attr = attr->next_attribute() )
+		++*numAttributes;
+
+	size_t numChildren = 0;
+	XmlTree::NodeType type;
+	for( const rapidxml::xml_node<> *child = xmlNode.first_node(); child; child = child->next_sibling() ) {
+		if( getChildType( *child, options, &type ) ) {
+			++numChildren;
+			countNodes( *child, options, numNodes, numAttributes, numTagIndexEntries );
+		}
+	}
+
+	*numNodes += numChildren;
+	if( numChildren > TAG_INDEX_THRESHOLD )
+		*numTagIndexEntries += numChildren;
+}
+
+//! Decodes the predefined and numeric character references in \a text, in place.
+void decodeEntities( string *text )
+{
+	size_t amp = text->find( '&' );
+	if( amp == string::npos )
+		return;
+
+	size_t write = amp;
+	for( size_t read = amp; read < text->size(); ) {
+		const char c = (*text)[read];
+		if( c == '&' ) {
+			const size_t semicolon = text->find( ';', read );
+			if( semicolon != string::npos && semicolon - read <= 10 ) {
+				const string entity = text->substr( read + 1, semicolon - read - 1 );
+				string replacement;
+				if( entity == "lt" )			replacement = "<";
+				else if( entity == "gt" )		replacement = ">";
+				else if( entity == "amp" )		replacement = "&";
+				else if( entity == "quot" )		replacement = "\"";
+				else if( entity == "apos" )		replacement = "'";
+				else if( entity.size() > 1 && entity[0] == '#' ) {
+					const bool hex = entity[1] == 'x' || entity[1] == 'X';
+					const char *digits = entity.c_str() + ( hex ? 2 : 1 );
+					char *digitsEnd;
+					const unsigned long code = strtoul( digits, &digitsEnd, hex ? 16 : 10 );
+					if( *digits && ! *digitsEnd && code > 0 && code <= 0x10FFFF )
+						replacement = toUtf8( u32string( 1, (char32_t)code ) );
+				}
+
+				// unknown entities are left untouched, as RapidXML does
+				if( ! replacement.empty() ) {
+					for( char r : replacement )
+						(*text)[write++] = r;
+					read = semicolon + 1;
+					continue;
+				}
+			}
+		}
+
+		(*text)[write++] = c;
+		++read;
+	}
+
+	text->resize( write );
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// XmlDocument::Node
+
+bool XmlDocument::Node::isTag( const char *tag, bool caseSensitive ) const
+{
+	if( strlen( tag ) != mTagLength )
+		return false;
+
+	return caseSensitive ? memcmp( mTag, tag, mTagLength ) == 0 : asciiCaseEqual( mTag, tag );
+}
+
+const XmlDocument::Node* XmlDocument::Node::findChild( const char *tag, bool caseSensitive ) const
+{
+	if( mTagIndex ) {
+		const uint32_t hash = hashTag( tag, strlen( tag ) );
+		const TagIndexEntry *end = mTagIndex + mNumTagIndexEntries;
+		const TagIndexEntry *entry = lower_bound( mTagIndex, end, hash, []( const TagIndexEntry &e, uint32_t h ) { return e.mHash < h; } );
+
+		// entries point at the first child of each distinct tag; case insensitive lookups may match several of them
+		const Node *result = nullptr;
+		for( ; entry != end && entry->mHash == hash; ++entry ) {
+			if( entry->mNode->isTag( tag, caseSensitive ) && ( ! result || entry->mNode < result ) )
+				result = entry->mNode;
+		}
+
+		return result;
+	}
+
+	for( const Node *child = begin(); child != end(); ++child ) {
+		if( child->isElement() && child->isTag( tag, caseSensitive ) )
+			return child;
+	}
+
+	return nullptr;
+}
+
+bool XmlDocument::Node::hasChild( const string &relativePath, bool caseSensitive, char separator ) const
+{
+	const Node *node = this;
+	for( const auto &component : split( relativePath, separator ) ) {
+		if( component.empty() )
+			continue;
+		node = node->findChild( component.c_str(), caseSensitive );
+		if( ! node )
+			return false;
+	}
+
+	return true;
+}
+
+const XmlDocument::Node& XmlDocument::Node::getChild( const string &relativePath, bool caseSensitive, char separator ) const
+{
+	const Node *node = this;
+	for( const auto &component : split( relativePath, separator ) ) {
+		if( component.empty() )
+			continue;
+		node = node->findChild( component.c_str(), caseSensitive );
+		if( ! node )
+			throw ExcChildNotFound( *this, relativePath );
+	}
+
+	return *node;
+}
+
+const XmlDocument::Attr* XmlDocument::Node::findAttribute( const char *attrName ) const
+{
+	const size_t length = strlen( attrName );
+	for( const Attr *attr = beginAttributes(); attr != endAttributes(); ++attr ) {
+		if( attr->mNameLength == length && memcmp( attr->mName, attrName, length ) == 0 )
+			return attr;
+	}
+
+	return nullptr;
+}
+
+const XmlDocument::Attr& XmlDocument::Node::getAttribute( const char *attrName ) const
+{
+	const Attr *attr = findAttribute( attrName );
+	if( ! attr )
+		throw ExcAttrNotFound( getPath(), attrName );
+
+	return *attr;
+}
+
+string XmlDocument::Node::getPath( char separator ) const
+{
+	string result;
+	for( const Node *node = this; node; node = node->mParent ) {
+		string nodeName = node->getTag();
+		if( node != this )
+			nodeName += separator;
+		result = nodeName + result;
+	}
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// XmlDocument
+
+XmlDocument::XmlDocument( const DataSourceRef &dataSource, const XmlTree::ParseOptions &parseOptions )
+{
+	BufferRef buffer = dataSource->getBuffer();
+	mSource = make_shared<Buffer>( buffer->getSize() + 1 );
+	memcpy( mSource->getData(), buffer->getData(), buffer->getSize() );
+	static_cast<char *>( mSource->getData() )[buffer->getSize()] = 0;
+
+	parse( static_cast<char *>( mSource->getData() ), parseOptions );
+}
+
+XmlDocument::XmlDocument( const string &xmlString, const XmlTree::ParseOptions &parseOptions )
+{
+	mSource = make_shared<Buffer>( xmlString.size() + 1 );
+	memcpy( mSource->getData(), xmlString.c_str(), xmlString.size() + 1 );
+
+	parse( static_cast<char *>( mSource->getData() ), parseOptions );
+}
+
+XmlDocument::XmlDocument( const BufferRef &buffer, const XmlTree::ParseOptions &parseOptions )
+	: mSource( buffer )
+{
+	// RapidXML requires a null-terminated input; only grow the buffer when it isn't already
+	const size_t size = mSource->getSize();
+	if( size == 0 || static_cast<const char *>( mSource->getData() )[size - 1] != 0 ) {
+		mSource->resize( size + 1 );
+		static_cast<char *>( mSource->getData() )[size] = 0;
+	}
+
+	parse( static_cast<char *>( mSource->getData() ), parseOptions );
+}
+
+void XmlDocument::parse( char *text, const XmlTree::ParseOptions &parseOptions )
+{
+	rapidxml::xml_document<> doc;
+	try {
+		if( parseOptions.getParseComments() )
+			doc.parse<rapidxml::parse_comment_nodes | rapidxml::parse_doctype_node>( text );
+		else
+			doc.parse<rapidxml::parse_doctype_node>( text );
+	}
+	catch( const rapidxml::parse_error &exc ) {
+		throw ExcParseError( exc.what(), exc.where<char>() - text );
+	}
+
+	// size the arrays exactly up front, so that the pointers between nodes remain valid while they are filled in
+	size_t numNodes = 1, numAttributes = 0, numTagIndexEntries = 0;
+	countNodes( doc, parseOptions, &numNodes, &numAttributes, &numTagIndexEntries );
+	mNodes.reserve( numNodes );
+	mAttributes.reserve( numAttributes );
+	mTagIndex.reserve( numTagIndexEntries );
+
+	mNodes.emplace_back();
+	mNodes.back().mNodeType = XmlTree::NODE_DOCUMENT;
+
+	vector<Node*> scratch;
+	buildChildren( doc, &mNodes.back(), parseOptions, &scratch );
+}
+
+void XmlDocument::buildChildren( const rapidxml::xml_node<> &xmlNode, Node *node, const XmlTree::ParseOptions &parseOptions, vector<Node*> *scratch )
+{
+	node->mAttributes = mAttributes.data() + mAttributes.size();
+	for( const rapidxml::xml_attribute<> *xmlAttr = xmlNode.first_attribute(); xmlAttr; xmlAttr = xmlAttr->next_attribute() ) {
+		mAttributes.emplace_back();
+		Attr &attr = mAttributes.back();
+		attr.mName = xmlAttr->name();
+		attr.mNameLength = (uint32_t)xmlAttr->name_size();
+		attr.mValue = xmlAttr->value();
+		attr.mValueLength = (uint32_t)xmlAttr->value_size();
+	}
+	node->mNumAttributes = uint32_t( mAttributes.data() + mAttributes.size() - node->mAttributes );
+
+	// the children of a node are allocated as one contiguous block
+	const size_t firstChild = mNodes.size();
+	string collapsedValue;
+	bool hasCollapsedCData = false;
+	XmlTree::NodeType type;
+	for( const rapidxml::xml_node<> *xmlChild = xmlNode.first_node(); xmlChild; xmlChild = xmlChild->next_sibling() ) {
+		if( ! getChildType( *xmlChild, parseOptions, &type ) ) {
+			if( xmlChild->type() == rapidxml::node_doctype )
+				mDocType = xmlChild->value();
+			else if( xmlChild->type() == rapidxml::node_cdata && parseOptions.getCollapseCData() ) {
+				if( ! hasCollapsedCData )
+					collapsedValue = node->mValue;
+				collapsedValue += xmlChild->value();
+				hasCollapsedCData = true;
+			}
+			continue;
+		}
+
+		mNodes.emplace_back();
+		Node &child = mNodes.back();
+		child.mNodeType = type;
+		child.mTag = xmlChild->name();
+		child.mTagLength = (uint32_t)xmlChild->name_size();
+		child.mTagHash = hashTag( child.mTag, child.mTagLength );
+		child.mValue = xmlChild->value();
+		child.mValueLength = (uint32_t)xmlChild->value_size();
+		child.mParent = node;
+	}
+
+	if( hasCollapsedCData ) {
+		mCollapsedValues.push_back( collapsedValue );
+		node->mValue = mCollapsedValues.back().c_str();
+		node->mValueLength = (uint32_t)mCollapsedValues.back().size();
+	}
+
+	node->mChildren = mNodes.data() + firstChild;
+	node->mNumChildren = uint32_t( mNodes.size() - firstChild );
+
+	// sorting the child elements by tag groups equal tags together, which is then used to link each to the next with the same tag
+	scratch->clear();
+	for( size_t i = firstChild; i < mNodes.size(); ++i ) {
+		if( mNodes[i].isElement() )
+			scratch->push_back( &mNodes[i] );
+	}
+
+	sort( scratch->begin(), scratch->end(), []( const Node *a, const Node *b ) {
+		if( a->mTagHash != b->mTagHash )
+			return a->mTagHash < b->mTagHash;
+		const int cmp = strcmp( a->mTag, b->mTag );
+		return cmp != 0 ? cmp < 0 : a < b;
+	} );
+
+	const bool buildIndex = node->mNumChildren > TAG_INDEX_THRESHOLD;
+	if( buildIndex )
+		node->mTagIndex = mTagIndex.data() + mTagIndex.size();
+
+	for( size_t i = 0; i < scratch->size(); ++i ) {
+		Node *child = (*scratch)[i];
+		Node *previous = i > 0 ? (*scratch)[i - 1] : nullptr;
+		if( previous && previous->mTagHash == child->mTagHash && strcmp( previous->mTag, child->mTag ) == 0 )
+			previous->mNextSameTag = child;
+		else if( buildIndex )
+			mTagIndex.push_back( TagIndexEntry{ child->mTagHash, child } );
+	}
+
+	if( buildIndex )
+		node->mNumTagIndexEntries = uint32_t( mTagIndex.data() + mTagIndex.size() - node->mTagIndex );
+
+	Node *child = mNodes.data() + firstChild;
+	for( const rapidxml::xml_node<> *xmlChild = xmlNode.first_node(); xmlChild; xmlChild = xmlChild->next_sibling() ) {
+		if( getChildType( *xmlChild, parseOptions, &type ) )
+			buildChildren( *xmlChild, child++, parseOptions, scratch );
+	}
+}
+
+size_t XmlDocument::getMemoryUsage() const
+{
+	size_t result = sizeof( XmlDocument ) + mSource->getAllocatedSize();
+	result += mNodes.capacity() * sizeof( Node ) + mAttributes.capacity() * sizeof( Attr ) + mTagIndex.capacity() * sizeof( TagIndexEntry );
+	for( const auto &value : mCollapsedValues )
+		result += value.capacity();
+
+	return result;
+}
+
+XmlDocument::ExcParseError::ExcParseError( const string &message, size_t offset )
+	: XmlDocument::Exception( "XML parse error at offset " + to_string( offset ) + ": " + message ), mOffset( offset )
+{
+}
+
+XmlDocument::ExcChildNotFound::ExcChildNotFound( const Node &node, const string &childPath )
+	: XmlDocument::Exception( "Could not find child: " + childPath + " for node: " + node.getPath() )
+{
+}
+
+XmlDocument::ExcAttrNotFound::ExcAttrNotFound( const string &nodePath, const string &attrName )
+	: XmlDocument::Exception( "Could not find attribute: " + attrName + " for node: " + nodePath )
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// XmlPullParser
+
+XmlPullParser::XmlPullParser( const IStreamRef &stream, const Options &options )
+	: mStream( stream ), mOptions( options ), mPos( 0 ), mEnd( 0 ), mConsumed( 0 ),
+		mEvent( START_ELEMENT ), mPendingEnd( false ), mDepth( 0 ), mNumAttributes( 0 )
+{
+	mBuffer.resize( std::max<size_t>( mOptions.getChunkSize(), 1 ) );
+
+	// skip a UTF-8 byte order mark
+	if( peek() == 0xEF ) {
+		if( ! skipString( "\xEF\xBB\xBF" ) )
+			throwParseError( "Invalid byte order mark" );
+	}
+}
+
+XmlPullParser::XmlPullParser( const DataSourceRef &dataSource, const Options &options )
+	: XmlPullParser( dataSource->createStream(), options )
+{
+}
+
+bool XmlPullParser::fill()
+{
+	if( mStream->isEof() )
+		return false;
+
+	// only called once the buffer has been fully consumed
+	mConsumed += mPos;
+	mPos = 0;
+	mEnd = mStream->readDataAvailable( mBuffer.data(), mBuffer.size() );
+	return mEnd > 0;
+}
+
+XmlPullParser::Event XmlPullParser::next()
+{
+	if( mEvent == END_DOCUMENT )
+		return mEvent;
+
+	if( mPendingEnd ) {
+		mPendingEnd = false;
+		mNumAttributes = 0;
+		return mEvent = END_ELEMENT;
+	}
+
+	if( mEvent == END_ELEMENT )
+		--mDepth;
+	mNumAttributes = 0;
+
+	while( true ) {
+		const int c = peek();
+		if( c < 0 ) {
+			if( mDepth > 0 )
+				throwParseError( "Unexpected end of input, expected </" + mOpenTags[mDepth - 1] + ">" );
+			return mEvent = END_DOCUMENT;
+		}
+
+		if( c != '<' ) {
+			readText();
+			if( mOptions.getIgnoreWhitespace() && all_of( mText.begin(), mText.end(), []( char t ) { return t == ' ' || t == '\t' || t == '\r' || t == '\n'; } ) )
+				continue;
+			return mEvent = TEXT;
+		}
+
+		get();
+		switch( peek() ) {
+			case '/':
+				get();
+				readEndTag();
+				return mEvent = END_ELEMENT;
+			case '?':
+				readUntil( "?>", &mText );
+			break;
+			case '!':
+				get();
+				if( skipString( "--" ) ) {
+					readUntil( "-->", &mText );
+					if( mOptions.getParseComments() )
+						return mEvent = COMMENT;
+				}
+				else if( skipString( "[CDATA[" ) ) {
+					readUntil( "]]>", &mText );
+					return mEvent = CDATA;
+				}
+				else
+					skipDocType();
+			break;
+			default:
+				readStartTag();
+				return mEvent = START_ELEMENT;
+		}
+	}
+}
+
+void XmlPullParser::skipElement()
+{
+	if( mEvent != START_ELEMENT || mDepth == 0 )
+		return;
+
+	const size_t depth = mDepth;
+	while( next() != END_ELEMENT || mDepth != depth ) {
+		if( mEvent == END_DOCUMENT )
+			throwParseError( "Unexpected end of input" );
+	}
+}
+
+bool XmlPullParser::hasAttribute( const string &attrName ) const
+{
+	for( size_t i = 0; i < mNumAttributes; ++i ) {
+		if( mAttributes[i].first == attrName )
+			return true;
+	}
+
+	return false;
+}
+
+const string& XmlPullParser::getTag() const
+{
+	static const string sEmpty;
+	return mDepth ? mOpenTags[mDepth - 1] : sEmpty;
+}
+
+const string& XmlPullParser::getAttributeValue( const string &attrName ) const
+{
+	for( size_t i = 0; i < mNumAttributes; ++i ) {
+		if( mAttributes[i].first == attrName )
+			return mAttributes[i].second;
+	}
+
+	throw XmlDocument::ExcAttrNotFound( mDepth ? mOpenTags[mDepth - 1] : string(), attrName );
+}
+
+void XmlPullParser::expect( char c )
+{
+	if( get() != (unsigned char)c )
+		throwParseError( string( "Expected '" ) + c + "'" );
+}
+
+//! Consumes \a str if the input continues with it. Only the first character is peeked, so \a str must not share a prefix with other valid input.
+bool XmlPullParser::skipString( const char *str )
+{
+	if( peek() != (unsigned char)str[0] )
+		return false;
+
+	for( ; *str; ++str ) {
+		if( get() != (unsigned char)*str )
+			throwParseError( "Unexpected character" );
+	}
+
+	return true;
+}
+
+void XmlPullParser::skipWhitespace()
+{
+	int c = peek();
+	while( c == ' ' || c == '\t' || c == '\r' || c == '\n' ) {
+		++mPos;
+		c = peek();
+	}
+}
+
+void XmlPullParser::readName( string *result )
+{
+	result->clear();
+	while( true ) {
+		const int c = peek();
+		if( c < 0 || c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>' || c == '=' || c == '<' )
+			break;
+		result->push_back( (char)c );
+		++mPos;
+	}
+
+	if( result->empty() )
+		throwParseError( "Expected a name" );
+}
+
+void XmlPullParser::readUntil( const char *terminator, string *result )
+{
+	const size_t length = strlen( terminator );
+	result->clear();
+	while( true ) {
+		const int c = get();
+		if( c < 0 )
+			throwParseError( string( "Unexpected end of input, expected " ) + terminator );
+		result->push_back( (char)c );
+		if( result->size() >= length && result->compare( result->size() - length, length, terminator ) == 0 ) {
+			result->resize( result->size() - length );
+			return;
+		}
+	}
+}
+
+void XmlPullParser::readText()
+{
+	mText.clear();
+	while( true ) {
+		// copy directly from the buffer up to the next tag
+		const char *begin = mBuffer.data() + mPos;
+		const char *end = mBuffer.data() + mEnd;
+		const char *tag = static_cast<const char *>( memchr( begin, '<', end - begin ) );
+		mText.append( begin, tag ? tag : end );
+		mPos = ( tag ? tag : end ) - mBuffer.data();
+		if( tag || ! fill() )
+			break;
+	}
+
+	decodeEntities( &mText );
+}
+
+void XmlPullParser::readStartTag()
+{
+	if( mOpenTags.size() <= mDepth )
+		mOpenTags.resize( mDepth + 1 );
+	readName( &mOpenTags[mDepth] );
+	++mDepth;
+
+	while( true ) {
+		skipWhitespace();
+		const int c = peek();
+		if( c == '>' ) {
+			get();
+			return;
+		}
+		if( c == '/' ) {
+			get();
+			expect( '>' );
+			mPendingEnd = true;
+			return;
+		}
+
+		if( mAttributes.size() <= mNumAttributes )
+			mAttributes.resize( mNumAttributes + 1 );
+		auto &attr = mAttributes[mNumAttributes++];
+		readName( &attr.first );
+		skipWhitespace();
+		expect( '=' );
+		skipWhitespace();
+
+		const int quote = get();
+		if( quote != '"' && quote != '\'' )
+			throwParseError( "Expected a quoted attribute value" );
+		attr.second.clear();
+		for( int v = get(); v != quote; v = get() ) {
+			if( v < 0 || v == '<' )
+				throwParseError( "Unterminated attribute value" );
+			attr.second.push_back( (char)v );
+		}
+		decodeEntities( &attr.second );
+	}
+}
+
+void XmlPullParser::readEndTag()
+{
+	readName( &mText );
+	skipWhitespace();
+	expect( '>' );
+
+	if( mDepth == 0 || mText != mOpenTags[mDepth - 1] )
+		throwParseError( "Unexpected closing tag </" + mText + ">" );
+	mText.clear();
+}
+
+void XmlPullParser::skipDocType()
+{
+	// skips the rest of a <!DOCTYPE ...>, including an internal subset in square brackets
+	int bracketDepth = 0;
+	int quote = 0;
+	while( true ) {
+		const int c = get();
+		if( c < 0 )
+			throwParseError( "Unexpected end of input within DOCTYPE" );
+		if( quote ) {
+			if( c == quote )
+				quote = 0;
+		}
+		else if( c == '"' || c == '\'' )
+			quote = c;
+		else if( c == '[' )
+			++bracketDepth;
+		else if( c == ']' )
+			--bracketDepth;
+		else if( c == '>' && bracketDepth <= 0 )
+			return;
+	}
+}
+
+void XmlPullParser::throwParseError( const string &message ) const
+{
+	throw XmlDocument::ExcParseError( message, getOffset() );
+}
+
+} // namespace cinder
@@ -75,6 +75,7 @@
 #include "cinder/Timeline.h"
 #include "cinder/Thread.h"
 #include "cinder/Log.h"
+#include "cinder/Profiler.h"
 
 using namespace std;
 
@@ -233,6 +234,8 @@ void AppBase::privateSetup__()
 
 void AppBase::privateUpdate__()
 {
+	CI_PROFILE_FRAME( "Frame" );
+	CI_PROFILE_ZONE( "App::update" );
 	mFrameCount++;
 
 	// service asio::io_context
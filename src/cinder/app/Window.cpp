@@ -25,6 +25,7 @@
 #include "cinder/Cinder.h"
 #include "cinder/app/Window.h"
 #include "cinder/app/AppBase.h"
+#include "cinder/Profiler.h"
 
 #if defined( CINDER_MSW_DESKTOP )
 	#include "cinder/app/msw/AppImplMsw.h"
@@ -435,6 +436,7 @@ void Window::emitKeyUp( KeyEvent *event )
 
 void Window::emitDraw()
 {
+	CI_PROFILE_ZONE( "App::draw" );
 	applyCurrentContext();
 	
 	mSignalDraw.emit();
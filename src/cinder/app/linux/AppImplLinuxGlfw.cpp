@@ -28,7 +28,6 @@
 #include "cinder/Log.h"
 
 #include <iostream>
-#include <unistd.h>
 
 namespace cinder { namespace app {
 
@@ -374,28 +373,10 @@ AppLinux *AppImplLinux::getApp()
 
 void AppImplLinux::sleepUntilNextFrame()
 {
-	// get current time in seconds
-	double currentSeconds = getElapsedSeconds();
-
-	// calculate time per frame in seconds
-	double secondsPerFrame = 1.0 / mFrameRate;
-
-	// determine if application was frozen for a while and adjust next frame time
-	double elapsedSeconds = currentSeconds - mNextFrameTime;
-	if( elapsedSeconds > 1.0 ) {
-		int numSkipFrames = (int)(elapsedSeconds / secondsPerFrame);
-		mNextFrameTime += (numSkipFrames * secondsPerFrame);
-	}
-
-	// determine when next frame should be drawn
-	mNextFrameTime += secondsPerFrame;
-
-	// sleep and process messages until next frame
-	if( ( mFrameRateEnabled ) && ( mNextFrameTime > currentSeconds ) ) {
-		double sleepTime = std::max( mNextFrameTime - currentSeconds, 0.0 );
-		unsigned long sleepMicroSecs = sleepTime*1000000L;
-		usleep(sleepMicroSecs);
-	}
+	if( mFrameRateEnabled )
+		mFramePacer.waitForNextFrame();
+	else
+		mFramePacer.markFrame();
 }
 
 void AppImplLinux::run()
@@ -415,8 +396,8 @@ void AppImplLinux::run()
 		window->resize();
 	}
 
-	// initialize our next frame time
-	mNextFrameTime = getElapsedSeconds();	
+	// start pacing frames from now
+	mFramePacer.setFrameRate( mFrameRate );	
 
 	while( ! mShouldQuit ) {
 		// update and draw
@@ -505,7 +486,7 @@ void AppImplLinux::setFrameRate( float frameRate )
 {
 	mFrameRate = frameRate;
 	mFrameRateEnabled = true;
-	mNextFrameTime = mApp->getElapsedSeconds();
+	mFramePacer.setFrameRate( frameRate );
 }
 
 void AppImplLinux::disableFrameRate()
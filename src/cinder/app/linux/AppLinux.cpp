@@ -82,6 +82,11 @@ bool AppLinux::isFrameRateEnabled() const
 	return mImpl->isFrameRateEnabled();
 }
 
+FramePacer& AppLinux::getFramePacer()
+{
+	return mImpl->mFramePacer;
+}
+
 WindowRef AppLinux::getWindow() const
 {
 	return mImpl->getWindow();
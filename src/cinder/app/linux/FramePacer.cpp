@@ -0,0 +1,188 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/app/linux/FramePacer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <ctime>
+
+namespace cinder { namespace app {
+
+////////////////////////////////////////////////////////////////////////////////
+// FrameTimeHistogram
+////////////////////////////////////////////////////////////////////////////////
+FrameTimeHistogram::FrameTimeHistogram( double binSeconds, size_t numBins )
+	: mBinSeconds( binSeconds ), mBinCounts( std::max<size_t>( numBins, 1 ), 0 )
+{
+	clear();
+}
+
+void FrameTimeHistogram::addSample( double seconds )
+{
+	const double bin = std::max( seconds, 0.0 ) / mBinSeconds;
+	mBinCounts[std::min<size_t>( (size_t)bin, mBinCounts.size() - 1 )]++;
+
+	mMin = mNumSamples ? std::min( mMin, seconds ) : seconds;
+	mMax = mNumSamples ? std::max( mMax, seconds ) : seconds;
+	mSum += seconds;
+	mSumSquares += seconds * seconds;
+	mNumSamples++;
+}
+
+void FrameTimeHistogram::clear()
+{
+	std::fill( mBinCounts.begin(), mBinCounts.end(), 0 );
+	mNumSamples = 0;
+	mSum = mSumSquares = mMin = mMax = 0;
+}
+
+double FrameTimeHistogram::getStdDev() const
+{
+	if( mNumSamples < 2 )
+		return 0;
+
+	const double mean = getMean();
+	return std::sqrt( std::max( mSumSquares / mNumSamples - mean * mean, 0.0 ) );
+}
+
+double FrameTimeHistogram::getPercentile( double percentile ) const
+{
+	if( ! mNumSamples )
+		return 0;
+
+	const double target = std::min( std::max( percentile, 0.0 ), 100.0 ) / 100 * mNumSamples;
+	size_t count = 0;
+	for( size_t bin = 0; bin < mBinCounts.size(); ++bin ) {
+		count += mBinCounts[bin];
+		if( count >= target && count > 0 && bin + 1 < mBinCounts.size() )
+			return std::min( ( bin + 1 ) * mBinSeconds, mMax );
+	}
+
+	// the last bin also holds every longer sample
+	return mMax;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// FramePacer
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+const int64_t NS_PER_SECOND = 1000000000;
+
+void sleepUntil( int64_t deadlineNs )
+{
+	timespec deadline;
+	deadline.tv_sec = deadlineNs / NS_PER_SECOND;
+	deadline.tv_nsec = deadlineNs % NS_PER_SECOND;
+	while( ::clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr ) == EINTR )
+		;
+}
+
+} // anonymous namespace
+
+FramePacer::FramePacer( double frameRate, const Options &options )
+	: mFrameRate( frameRate ), mNextDeadlineNs( 0 ), mLastFrameNs( 0 ), mNumMissedDeadlines( 0 ),
+		mFrameTimes( 0.0001, 1000 ), mOversleepTimes( 0.00001, 1000 )
+{
+	setOptions( options );
+}
+
+int64_t FramePacer::now()
+{
+	timespec time;
+	::clock_gettime( CLOCK_MONOTONIC, &time );
+	return (int64_t)time.tv_sec * NS_PER_SECOND + time.tv_nsec;
+}
+
+void FramePacer::setFrameRate( double frameRate )
+{
+	mFrameRate = frameRate;
+	mNextDeadlineNs = now();
+}
+
+void FramePacer::setOptions( const Options &options )
+{
+	mOptions = options;
+	mSpinNs = options.getMode() == Mode::SLEEP ? 0 : (int64_t)( options.getSpinSeconds() * NS_PER_SECOND );
+}
+
+bool FramePacer::waitForNextFrame()
+{
+	int64_t currentNs = now();
+	const int64_t periodNs = std::max<int64_t>( (int64_t)( NS_PER_SECOND / mFrameRate ), 1 );
+	if( ! mNextDeadlineNs )
+		mNextDeadlineNs = currentNs;
+
+	// determine if application was frozen for a while and skip the missed frames
+	const int64_t lateNs = currentNs - mNextDeadlineNs;
+	if( lateNs > NS_PER_SECOND )
+		mNextDeadlineNs += ( lateNs / periodNs ) * periodNs;
+
+	mNextDeadlineNs += periodNs;
+	const bool onTime = mNextDeadlineNs > currentNs;
+	if( onTime ) {
+		const int64_t wakeNs = mNextDeadlineNs - mSpinNs;
+		if( wakeNs > currentNs ) {
+			sleepUntil( wakeNs );
+			currentNs = now();
+
+			const int64_t oversleepNs = std::max<int64_t>( currentNs - wakeNs, 0 );
+			mOversleepTimes.addSample( oversleepNs / double( NS_PER_SECOND ) );
+			if( mOptions.getMode() == Mode::ADAPTIVE ) {
+				// follow increases in wake-up latency immediately, and decreases gradually
+				const int64_t targetNs = oversleepNs + oversleepNs / 4;
+				mSpinNs = targetNs > mSpinNs ? targetNs : mSpinNs - ( mSpinNs - targetNs ) / 16;
+				mSpinNs = std::min<int64_t>( mSpinNs, (int64_t)( mOptions.getMaxSpinSeconds() * NS_PER_SECOND ) );
+			}
+		}
+
+		while( currentNs < mNextDeadlineNs )
+			currentNs = now();
+	}
+	else
+		mNumMissedDeadlines++;
+
+	markFrame();
+	return onTime;
+}
+
+void FramePacer::markFrame()
+{
+	const int64_t currentNs = now();
+	if( mLastFrameNs )
+		mFrameTimes.addSample( ( currentNs - mLastFrameNs ) / double( NS_PER_SECOND ) );
+	mLastFrameNs = currentNs;
+}
+
+void FramePacer::clearStats()
+{
+	mFrameTimes.clear();
+	mOversleepTimes.clear();
+	mNumMissedDeadlines = 0;
+	mLastFrameNs = 0;
+}
+
+} } // namespace cinder::app
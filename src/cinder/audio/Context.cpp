@@ -28,6 +28,7 @@
 
 #include "cinder/Cinder.h"
 #include "cinder/app/AppBase.h"
+#include "cinder/Profiler.h"
 
 #include <sstream>
 
@@ -132,7 +133,7 @@ void Context::setMaster( Context *masterContext, DeviceManager *deviceManager )
 }
 
 Context::Context()
-	: mEnabled( false ), mAutoPullRequired( false ), mAutoPullCacheDirty( false ), mNumProcessedFrames( 0 ), mTimeDuringLastProcessLoop( -1.0 )
+	: mEnabled( false ), mAutoPullRequired( false ), mAutoPullCacheDirty( false ), mNumProcessedFrames( 0 ), mTimeDuringLastProcessLoop( -1.0 ), mProcessBeginNs( 0 )
 {
 	if( ! sIsRegisteredForCleanup )
 		registerClearStatics();
@@ -295,6 +296,9 @@ void Context::preProcess()
 {
 	mProcessTimer.start();
 	mAudioThreadId = std::this_thread::get_id();
+#if CI_PROFILER_ENABLED
+	mProcessBeginNs = profile::Profiler::isEnabled() ? profile::now() : 0;
+#endif
 
 	preProcessScheduledEvents();
 }
@@ -307,6 +311,10 @@ void Context::postProcess()
 
 	mProcessTimer.stop();
 	mTimeDuringLastProcessLoop = mProcessTimer.getSeconds();
+#if CI_PROFILER_ENABLED
+	if( mProcessBeginNs )
+		profile::Profiler::instance().recordZone( "audio::Context::process", mProcessBeginNs, profile::now() );
+#endif
 }
 
 void Context::incrementFrameCount()
@@ -87,6 +87,7 @@ class VboMeshGeomTarget : public geom::Target {
 	uint8_t	getAttribDims( geom::Attrib attr ) const override;
 	void	copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void	copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float*	getAttribStorage( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
 	//! Must be called in order to upload temporary 'mBufferData' to VBOs
 	void	copyBuffers();
@@ -146,6 +147,28 @@ void VboMeshGeomTarget::copyAttrib( geom::Attrib attr, uint8_t dims, size_t /*st
 		geom::copyData( dims, srcData, count, dstDims, dstStride, reinterpret_cast<float*>( dstData ) );
 }
 
+float* VboMeshGeomTarget::getAttribStorage( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	if( count != mVboMesh->mNumVertices )
+		return nullptr;
+
+	// a Source can write directly into the interleaved data of the buffer containing 'attr' when it's laid out as floats of the same dimensions
+	for( const auto &bufferData : mBufferData ) {
+		if( bufferData.mLayout.hasAttrib( attr ) ) {
+			auto attrInfo = bufferData.mLayout.getAttribInfo( attr );
+			if( attrInfo.getDataType() != geom::DataType::FLOAT || attrInfo.getDims() != dims || attrInfo.getInstanceDivisor() != 0 )
+				return nullptr;
+
+			*resultStrideBytes = attrInfo.getStride() ? attrInfo.getStride() : ( dims * sizeof(float) );
+			if( bufferData.mDataSize < attrInfo.getOffset() + ( count - 1 ) * *resultStrideBytes + dims * sizeof(float) )
+				return nullptr;
+			return reinterpret_cast<float*>( bufferData.mData.get() + attrInfo.getOffset() );
+		}
+	}
+
+	return nullptr;
+}
+
 void VboMeshGeomTarget::copyIndices( geom::Primitive /*primitive*/, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex )
 {
 // @TODO: Find a better way to handle this
@@ -0,0 +1,468 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/ColorSpace.h"
+#include "cinder/ChanTraits.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define CI_COLORSPACE_SSE2
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	#include <arm_neon.h>
+	#define CI_COLORSPACE_NEON
+#endif
+
+namespace cinder { namespace ip {
+
+namespace {
+
+// Pixels are converted in spans of this many, deinterleaved into planar floats so that the kernels below work on 4 pixels at a time
+const int32_t	sSpanSize = 256;
+// Minimum number of pixels converted by each task of parallelFor()
+const size_t	sMinPixelsPerTask = 32768;
+// Intervals of the float transfer function tables. Interpolating 8192 keeps the error below half a step of 16-bit
+const int		sTransferLutSize = 8192;
+
+struct Span {
+	alignas(16) float	r[sSpanSize];
+	alignas(16) float	g[sSpanSize];
+	alignas(16) float	b[sSpanSize];
+};
+
+// The layout of the pixels being converted, with \c mData pointing at the top left pixel
+template<typename T>
+struct PixelLayout {
+	template<typename SurfT>
+	PixelLayout( SurfT *surface, const ivec2 &offset )
+		: mData( (uint8_t*)surface->getData( offset ) ), mRowBytes( surface->getRowBytes() ), mPixelInc( surface->getPixelInc() ),
+		mRed( surface->getRedOffset() ), mGreen( surface->getGreenOffset() ), mBlue( surface->getBlueOffset() ),
+		mAlpha( surface->hasAlpha() ? surface->getAlphaOffset() : -1 )
+	{}
+
+	T*	getRow( int32_t y ) const		{ return reinterpret_cast<T*>( mData + y * mRowBytes ); }
+
+	uint8_t		*mData;
+	ptrdiff_t	mRowBytes;
+	uint8_t		mPixelInc, mRed, mGreen, mBlue;
+	int8_t		mAlpha;
+};
+
+double srgbToLinearExact( double v )
+{
+	return v <= 0.04045 ? v / 12.92 : std::pow( ( v + 0.055 ) / 1.055, 2.4 );
+}
+
+double linearToSrgbExact( double v )
+{
+	return v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow( v, 1 / 2.4 ) - 0.055;
+}
+
+class TransferLut {
+  public:
+	TransferLut( double (*fn)( double ) )
+		: mFn( fn ), mValues( sTransferLutSize + 1 )
+	{
+		for( int i = 0; i <= sTransferLutSize; ++i )
+			mValues[i] = (float)fn( i / (double)sTransferLutSize );
+	}
+
+	float lookup( float v ) const
+	{
+		// values outside the table, including NaN, are calculated exactly
+		if( ! ( v >= 0 && v <= 1 ) )
+			return (float)mFn( v );
+
+		const float x = v * sTransferLutSize;
+		const int i = std::min( (int)x, sTransferLutSize - 1 );
+		return mValues[i] + ( mValues[i + 1] - mValues[i] ) * ( x - i );
+	}
+
+	void lookup( float *values, int32_t count ) const
+	{
+		for( int32_t i = 0; i < count; ++i )
+			values[i] = lookup( values[i] );
+	}
+
+  private:
+	double				(*mFn)( double );
+	std::vector<float>	mValues;
+};
+
+const TransferLut& getToLinearLut()
+{
+	static const TransferLut lut( srgbToLinearExact );
+	return lut;
+}
+
+const TransferLut& getToSrgbLut()
+{
+	static const TransferLut lut( linearToSrgbExact );
+	return lut;
+}
+
+// Tables mapping every value of an integer channel type between sRGB and linear directly
+template<typename T>
+std::vector<T> makeTransferTable( double (*fn)( double ) )
+{
+	const double maxValue = CHANTRAIT<T>::max();
+	std::vector<T> result( (size_t)maxValue + 1 );
+	for( size_t i = 0; i < result.size(); ++i )
+		result[i] = (T)std::lround( fn( i / maxValue ) * maxValue );
+	return result;
+}
+
+template<typename T>
+const T* getTransferTable( bool toLinear )
+{
+	static const std::vector<T> toLinearTable = makeTransferTable<T>( srgbToLinearExact );
+	static const std::vector<T> toSrgbTable = makeTransferTable<T>( linearToSrgbExact );
+	return toLinear ? toLinearTable.data() : toSrgbTable.data();
+}
+
+template<>
+const float* getTransferTable<float>( bool toLinear )
+{
+	return nullptr;
+}
+
+// 3x4 matrices applied to planar red, green and blue, with the translation in the last column
+typedef float Matrix34[3][4];
+
+const Matrix34 sRgbToYcbcr = {
+	{ 0.299f, 0.587f, 0.114f, 0 },
+	{ -0.168736f, -0.331264f, 0.5f, 0.5f },
+	{ 0.5f, -0.418688f, -0.081312f, 0.5f } };
+const Matrix34 sYcbcrToRgb = {
+	{ 1, 0, 1.402f, -0.701f },
+	{ 1, -0.344136f, -0.714136f, 0.529136f },
+	{ 1, 1.772f, 0, -0.886f } };
+
+// Linear sRGB to CIE XYZ, divided by the D65 white point (0.95047, 1, 1.08883)
+const Matrix34 sLinearToXyzWhite = {
+	{ 0.4124564f / 0.95047f, 0.3575761f / 0.95047f, 0.1804375f / 0.95047f, 0 },
+	{ 0.2126729f, 0.7151522f, 0.0721750f, 0 },
+	{ 0.0193339f / 1.08883f, 0.1191920f / 1.08883f, 0.9503041f / 1.08883f, 0 } };
+const Matrix34 sXyzWhiteToLinear = {
+	{ 3.2404542f * 0.95047f, -1.5371385f, -0.4985314f * 1.08883f, 0 },
+	{ -0.9692660f * 0.95047f, 1.8760108f, 0.0415560f * 1.08883f, 0 },
+	{ 0.0556434f * 0.95047f, -0.2040259f, 1.0572252f * 1.08883f, 0 } };
+// f(X), f(Y) and f(Z) to L / 100, ( a + 128 ) / 255 and ( b + 128 ) / 255
+const Matrix34 sLabFToLab = {
+	{ 0, 1.16f, 0, -0.16f },
+	{ 500 / 255.0f, -500 / 255.0f, 0, 128 / 255.0f },
+	{ 0, 200 / 255.0f, -200 / 255.0f, 128 / 255.0f } };
+const Matrix34 sLabToLabF = {
+	{ 100 / 116.0f, 255 / 500.0f, 0, 16 / 116.0f - 128 / 500.0f },
+	{ 100 / 116.0f, 0, 0, 16 / 116.0f },
+	{ 100 / 116.0f, 0, -255 / 200.0f, 16 / 116.0f + 128 / 200.0f } };
+
+void transform( const Matrix34 &m, Span *span, int32_t count )
+{
+	int32_t i = 0;
+#if defined( CI_COLORSPACE_SSE2 )
+	const __m128 m00 = _mm_set1_ps( m[0][0] ), m01 = _mm_set1_ps( m[0][1] ), m02 = _mm_set1_ps( m[0][2] ), m03 = _mm_set1_ps( m[0][3] );
+	const __m128 m10 = _mm_set1_ps( m[1][0] ), m11 = _mm_set1_ps( m[1][1] ), m12 = _mm_set1_ps( m[1][2] ), m13 = _mm_set1_ps( m[1][3] );
+	const __m128 m20 = _mm_set1_ps( m[2][0] ), m21 = _mm_set1_ps( m[2][1] ), m22 = _mm_set1_ps( m[2][2] ), m23 = _mm_set1_ps( m[2][3] );
+	for( ; i + 4 <= count; i += 4 ) {
+		const __m128 r = _mm_load_ps( span->r + i ), g = _mm_load_ps( span->g + i ), b = _mm_load_ps( span->b + i );
+		_mm_store_ps( span->r + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( m00, r ), _mm_mul_ps( m01, g ) ), _mm_add_ps( _mm_mul_ps( m02, b ), m03 ) ) );
+		_mm_store_ps( span->g + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( m10, r ), _mm_mul_ps( m11, g ) ), _mm_add_ps( _mm_mul_ps( m12, b ), m13 ) ) );
+		_mm_store_ps( span->b + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( m20, r ), _mm_mul_ps( m21, g ) ), _mm_add_ps( _mm_mul_ps( m22, b ), m23 ) ) );
+	}
+#elif defined( CI_COLORSPACE_NEON )
+	for( ; i + 4 <= count; i += 4 ) {
+		const float32x4_t r = vld1q_f32( span->r + i ), g = vld1q_f32( span->g + i ), b = vld1q_f32( span->b + i );
+		vst1q_f32( span->r + i, vmlaq_n_f32( vmlaq_n_f32( vmlaq_n_f32( vdupq_n_f32( m[0][3] ), r, m[0][0] ), g, m[0][1] ), b, m[0][2] ) );
+		vst1q_f32( span->g + i, vmlaq_n_f32( vmlaq_n_f32( vmlaq_n_f32( vdupq_n_f32( m[1][3] ), r, m[1][0] ), g, m[1][1] ), b, m[1][2] ) );
+		vst1q_f32( span->b + i, vmlaq_n_f32( vmlaq_n_f32( vmlaq_n_f32( vdupq_n_f32( m[2][3] ), r, m[2][0] ), g, m[2][1] ), b, m[2][2] ) );
+	}
+#endif
+	for( ; i < count; ++i ) {
+		const float r = span->r[i], g = span->g[i], b = span->b[i];
+		span->r[i] = m[0][0] * r + m[0][1] * g + m[0][2] * b + m[0][3];
+		span->g[i] = m[1][0] * r + m[1][1] * g + m[1][2] * b + m[1][3];
+		span->b[i] = m[2][0] * r + m[2][1] * g + m[2][2] * b + m[2][3];
+	}
+}
+
+// The nonlinearity of CIE L*a*b*, applied to each channel of XYZ divided by the white point, and its inverse
+void labF( float *values, int32_t count )
+{
+	const float epsilon = 216 / 24389.0f, kappa = 24389 / 27.0f;
+	for( int32_t i = 0; i < count; ++i )
+		values[i] = values[i] > epsilon ? std::cbrt( values[i] ) : ( kappa * values[i] + 16 ) / 116;
+}
+
+void labFInverse( float *values, int32_t count )
+{
+	const float delta = 6 / 29.0f, kappa = 24389 / 27.0f;
+	for( int32_t i = 0; i < count; ++i )
+		values[i] = values[i] > delta ? values[i] * values[i] * values[i] : ( 116 * values[i] - 16 ) / kappa;
+}
+
+// Matches rgbToHsv() and hsvToRgb()
+void rgbToHsv( Span *span, int32_t count )
+{
+	for( int32_t i = 0; i < count; ++i ) {
+		const float r = span->r[i], g = span->g[i], b = span->b[i];
+		const float max = std::max( r, std::max( g, b ) );
+		const float range = max - std::min( r, std::min( g, b ) );
+		const float sat = max != 0 ? range / max : 0;
+		float hue = 0;
+		if( sat != 0 ) {
+			if( r == max )
+				hue = ( g - b ) / range;
+			else if( g == max )
+				hue = 2 + ( b - r ) / range;
+			else
+				hue = 4 + ( r - g ) / range;
+			hue /= 6.0f;
+			if( hue < 0 )
+				hue += 1;
+		}
+		span->r[i] = hue;
+		span->g[i] = sat;
+		span->b[i] = max;
+	}
+}
+
+void hsvToRgb( Span *span, int32_t count )
+{
+	for( int32_t i = 0; i < count; ++i ) {
+		const float hue = span->r[i] == 1 ? 0 : span->r[i] * 6, sat = span->g[i], val = span->b[i];
+		const int sector = std::min( std::max( (int)std::floor( hue ), 0 ), 5 );
+		const float f = hue - sector;
+		const float p = val * ( 1 - sat ), q = val * ( 1 - sat * f ), t = val * ( 1 - sat * ( 1 - f ) );
+		float r, g, b;
+		switch( sector ) {
+			case 0: r = val; g = t; b = p; break;
+			case 1: r = q; g = val; b = p; break;
+			case 2: r = p; g = val; b = t; break;
+			case 3: r = p; g = q; b = val; break;
+			case 4: r = t; g = p; b = val; break;
+			default: r = val; g = p; b = q; break;
+		}
+		span->r[i] = r;
+		span->g[i] = g;
+		span->b[i] = b;
+	}
+}
+
+// Each color space is converted via either encoded or linear sRGB
+bool isLinearBased( ColorSpace space )
+{
+	return space == ColorSpace::LINEAR_RGB || space == ColorSpace::LAB;
+}
+
+void toRgb( ColorSpace space, Span *span, int32_t count )
+{
+	switch( space ) {
+		case ColorSpace::HSV:
+			hsvToRgb( span, count );
+		break;
+		case ColorSpace::YCBCR:
+			transform( sYcbcrToRgb, span, count );
+		break;
+		case ColorSpace::LAB:
+			transform( sLabToLabF, span, count );
+			labFInverse( span->r, count );
+			labFInverse( span->g, count );
+			labFInverse( span->b, count );
+			transform( sXyzWhiteToLinear, span, count );
+		break;
+		default:
+		break;
+	}
+}
+
+void fromRgb( ColorSpace space, Span *span, int32_t count )
+{
+	switch( space ) {
+		case ColorSpace::HSV:
+			rgbToHsv( span, count );
+		break;
+		case ColorSpace::YCBCR:
+			transform( sRgbToYcbcr, span, count );
+		break;
+		case ColorSpace::LAB:
+			transform( sLinearToXyzWhite, span, count );
+			labF( span->r, count );
+			labF( span->g, count );
+			labF( span->b, count );
+			transform( sLabFToLab, span, count );
+		break;
+		default:
+		break;
+	}
+}
+
+template<typename T>
+T fromFloat( float v )
+{
+	return (T)( std::min( std::max( v, 0.0f ), 1.0f ) * CHANTRAIT<T>::max() + 0.5f );
+}
+
+template<>
+float fromFloat<float>( float v )
+{
+	return v;
+}
+
+template<typename T>
+void convertRow( const T *src, const PixelLayout<T> &srcLayout, T *dst, const PixelLayout<T> &dstLayout, int32_t width, ColorSpace from, ColorSpace to, Span *span )
+{
+	const float scale = 1.0f / CHANTRAIT<T>::max();
+	const bool copyAlpha = src != dst && dstLayout.mAlpha >= 0;
+	const T opaque = CHANTRAIT<T>::max();
+	const TransferLut *transfer = nullptr;
+	if( isLinearBased( from ) != isLinearBased( to ) )
+		transfer = isLinearBased( from ) ? &getToSrgbLut() : &getToLinearLut();
+
+	for( int32_t x = 0; x < width; x += sSpanSize ) {
+		const int32_t count = std::min( width - x, sSpanSize );
+		const T *srcPtr = src;
+		for( int32_t i = 0; i < count; ++i, srcPtr += srcLayout.mPixelInc ) {
+			span->r[i] = srcPtr[srcLayout.mRed] * scale;
+			span->g[i] = srcPtr[srcLayout.mGreen] * scale;
+			span->b[i] = srcPtr[srcLayout.mBlue] * scale;
+		}
+
+		toRgb( from, span, count );
+		if( transfer ) {
+			transfer->lookup( span->r, count );
+			transfer->lookup( span->g, count );
+			transfer->lookup( span->b, count );
+		}
+		fromRgb( to, span, count );
+
+		for( int32_t i = 0; i < count; ++i, src += srcLayout.mPixelInc, dst += dstLayout.mPixelInc ) {
+			dst[dstLayout.mRed] = fromFloat<T>( span->r[i] );
+			dst[dstLayout.mGreen] = fromFloat<T>( span->g[i] );
+			dst[dstLayout.mBlue] = fromFloat<T>( span->b[i] );
+			if( copyAlpha )
+				dst[dstLayout.mAlpha] = srcLayout.mAlpha >= 0 ? src[srcLayout.mAlpha] : opaque;
+		}
+	}
+}
+
+// Converts between sRGB and linear with a table covering every value of an integer type
+template<typename T>
+void transferRow( const T *table, const T *src, const PixelLayout<T> &srcLayout, T *dst, const PixelLayout<T> &dstLayout, int32_t width )
+{
+	const bool copyAlpha = src != dst && dstLayout.mAlpha >= 0;
+	const T opaque = CHANTRAIT<T>::max();
+	for( int32_t x = 0; x < width; ++x, src += srcLayout.mPixelInc, dst += dstLayout.mPixelInc ) {
+		dst[dstLayout.mRed] = table[src[srcLayout.mRed]];
+		dst[dstLayout.mGreen] = table[src[srcLayout.mGreen]];
+		dst[dstLayout.mBlue] = table[src[srcLayout.mBlue]];
+		if( copyAlpha )
+			dst[dstLayout.mAlpha] = srcLayout.mAlpha >= 0 ? src[srcLayout.mAlpha] : opaque;
+	}
+}
+
+// float has no table, see getTransferTable()
+void transferRow( const float *table, const float *src, const PixelLayout<float> &srcLayout, float *dst, const PixelLayout<float> &dstLayout, int32_t width )
+{
+}
+
+template<typename T>
+void convertPixels( const PixelLayout<T> &src, const PixelLayout<T> &dst, const ivec2 &size, ColorSpace from, ColorSpace to, bool parallel )
+{
+	if( size.x <= 0 || size.y <= 0 )
+		return;
+
+	const T *table = nullptr;
+	if( from == ColorSpace::SRGB && to == ColorSpace::LINEAR_RGB )
+		table = getTransferTable<T>( true );
+	else if( from == ColorSpace::LINEAR_RGB && to == ColorSpace::SRGB )
+		table = getTransferTable<T>( false );
+
+	auto convertRows = [&]( size_t begin, size_t end ) {
+		Span span;
+		for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+			if( table )
+				transferRow( table, src.getRow( y ), src, dst.getRow( y ), dst, size.x );
+			else
+				convertRow( src.getRow( y ), src, dst.getRow( y ), dst, size.x, from, to, &span );
+		}
+	};
+
+	if( parallel )
+		parallelFor( size.y, std::max<size_t>( sMinPixelsPerTask / size.x, 1 ), convertRows );
+	else
+		convertRows( 0, size.y );
+}
+
+} // anonymous namespace
+
+template<typename T>
+void convertColorSpace( const SurfaceT<T> &srcSurface, ColorSpace from, ColorSpace to, SurfaceT<T> *dstSurface, bool parallel )
+{
+	const Area area = srcSurface.getBounds().getClipBy( dstSurface->getBounds() );
+	const PixelLayout<T> src( &srcSurface, area.getUL() ), dst( dstSurface, area.getUL() );
+	convertPixels( src, dst, area.getSize(), from, to, parallel );
+}
+
+template<typename T>
+void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, bool parallel )
+{
+	convertColorSpace( surface, from, to, surface->getBounds(), parallel );
+}
+
+template<typename T>
+void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, const Area &area, bool parallel )
+{
+	if( from == to )
+		return;
+
+	const Area clippedArea = area.getClipBy( surface->getBounds() );
+	const PixelLayout<T> layout( surface, clippedArea.getUL() );
+	convertPixels( layout, layout, clippedArea.getSize(), from, to, parallel );
+}
+
+float srgbToLinear( float v )
+{
+	return getToLinearLut().lookup( v );
+}
+
+float linearToSrgb( float v )
+{
+	return getToSrgbLut().lookup( v );
+}
+
+#define convertColorSpace_PROTOTYPES(T)\
+	template CI_API void convertColorSpace( const SurfaceT<T> &srcSurface, ColorSpace from, ColorSpace to, SurfaceT<T> *dstSurface, bool parallel );\
+	template CI_API void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, bool parallel );\
+	template CI_API void convertColorSpace( SurfaceT<T> *surface, ColorSpace from, ColorSpace to, const Area &area, bool parallel );
+
+// These should match CHANNEL_TYPES
+convertColorSpace_PROTOTYPES(uint8_t)
+convertColorSpace_PROTOTYPES(uint16_t)
+convertColorSpace_PROTOTYPES(float)
+
+} } // namespace cinder::ip
@@ -0,0 +1,211 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/ConnectedComponents.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+
+namespace cinder { namespace ip {
+
+namespace {
+
+// Minimum number of pixels labeled by each task of parallelFor()
+const size_t sMinPixelsPerTask = 65536;
+
+// A union-find forest of provisional labels. Each label is 1 plus the index of the pixel which started it, so that bands of rows labeled
+// in parallel never share a label. Roots are always linked to the smaller root, so every label's parent is less than or equal to it.
+class LabelForest {
+  public:
+	LabelForest( size_t numPixels )
+		: mParents( numPixels + 1, 0 )
+	{}
+
+	uint32_t create( uint32_t label )
+	{
+		mParents[label] = label;
+		return label;
+	}
+
+	uint32_t find( uint32_t label )
+	{
+		uint32_t root = label;
+		while( mParents[root] != root )
+			root = mParents[root];
+		while( mParents[label] != root ) {
+			const uint32_t parent = mParents[label];
+			mParents[label] = root;
+			label = parent;
+		}
+		return root;
+	}
+
+	uint32_t unite( uint32_t a, uint32_t b )
+	{
+		a = find( a );
+		b = find( b );
+		if( a < b )
+			std::swap( a, b );
+		mParents[a] = b;
+		return b;
+	}
+
+	//! Replaces every label with the final label of its tree, numbered from 1 in order of the roots, and returns the number of trees
+	uint32_t resolve()
+	{
+		// parents are less than their children, so each parent has already been replaced by its final label
+		uint32_t numRoots = 0;
+		for( size_t label = 1; label < mParents.size(); ++label ) {
+			if( mParents[label] == label )
+				mParents[label] = ++numRoots;
+			else if( mParents[label] != 0 )
+				mParents[label] = mParents[mParents[label]];
+		}
+		return numRoots;
+	}
+
+	uint32_t operator[]( uint32_t label ) const		{ return mParents[label]; }
+
+  private:
+	std::vector<uint32_t>	mParents;
+};
+
+// Labels rows [begin, end) of the foreground, connecting only to pixels inside those rows
+void labelRows( const Channel8u &channel, uint8_t threshold, bool eight, size_t begin, size_t end, uint32_t *labels, LabelForest *forest )
+{
+	const int32_t width = channel.getWidth();
+	const uint8_t inc = channel.getIncrement();
+	for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+		const uint8_t *src = channel.getData( ivec2( 0, y ) );
+		uint32_t *row = labels + (size_t)y * width;
+		const uint32_t *above = y > (int32_t)begin ? row - width : nullptr;
+		for( int32_t x = 0; x < width; ++x, src += inc ) {
+			if( *src <= threshold ) {
+				row[x] = 0;
+				continue;
+			}
+
+			const uint32_t left = x > 0 ? row[x - 1] : 0;
+			const uint32_t up = above ? above[x] : 0;
+			if( eight ) {
+				// the pixel above is adjacent to all the other labeled neighbors, so they're already connected to it
+				if( up ) {
+					row[x] = up;
+					continue;
+				}
+				// the left and upper left pixels are adjacent, so only one of them and the upper right need connecting
+				const uint32_t upLeft = ( above && x > 0 ) ? above[x - 1] : 0;
+				const uint32_t upRight = ( above && x + 1 < width ) ? above[x + 1] : 0;
+				const uint32_t first = left ? left : upLeft;
+				if( first && upRight )
+					row[x] = first == upRight ? first : forest->unite( first, upRight );
+				else if( first || upRight )
+					row[x] = first ? first : upRight;
+				else
+					row[x] = forest->create( (uint32_t)( (size_t)y * width + x + 1 ) );
+			}
+			else {
+				if( left && up )
+					row[x] = left == up ? left : forest->unite( left, up );
+				else if( left || up )
+					row[x] = left ? left : up;
+				else
+					row[x] = forest->create( (uint32_t)( (size_t)y * width + x + 1 ) );
+			}
+		}
+	}
+}
+
+// Connects the first row of a band, \a y, to the last row of the band above it
+void mergeRows( int32_t width, int32_t y, bool eight, const uint32_t *labels, LabelForest *forest )
+{
+	const uint32_t *row = labels + (size_t)y * width, *above = row - width;
+	for( int32_t x = 0; x < width; ++x ) {
+		if( ! row[x] )
+			continue;
+		if( above[x] )
+			forest->unite( row[x], above[x] );
+		else if( eight ) {
+			if( x > 0 && above[x - 1] )
+				forest->unite( row[x], above[x - 1] );
+			if( x + 1 < width && above[x + 1] )
+				forest->unite( row[x], above[x + 1] );
+		}
+	}
+}
+
+} // anonymous namespace
+
+std::vector<ConnectedComponent> findConnectedComponents( const Channel8u &channel, std::vector<uint32_t> *labels, const ConnectedComponentsOptions &options )
+{
+	const int32_t width = channel.getWidth(), height = channel.getHeight();
+	std::vector<uint32_t> localLabels;
+	if( ! labels )
+		labels = &localLabels;
+	labels->resize( (size_t)std::max( width, 0 ) * std::max( height, 0 ) );
+	if( labels->empty() )
+		return std::vector<ConnectedComponent>();
+
+	// label bands of rows independently, then connect each band to the one above it
+	LabelForest forest( labels->size() );
+	const bool eight = options.getConnectivity() == Connectivity::EIGHT;
+	const size_t rowsPerBand = options.isParallel() ? std::max<size_t>( sMinPixelsPerTask / width, 1 ) : height;
+	const size_t numBands = ( height + rowsPerBand - 1 ) / rowsPerBand;
+	parallelFor( numBands, 1, [&]( size_t begin, size_t end ) {
+		for( size_t band = begin; band < end; ++band )
+			labelRows( channel, options.getThreshold(), eight, band * rowsPerBand, std::min( ( band + 1 ) * rowsPerBand, (size_t)height ), labels->data(), &forest );
+	} );
+	for( size_t band = 1; band < numBands; ++band )
+		mergeRows( width, (int32_t)( band * rowsPerBand ), eight, labels->data(), &forest );
+
+	// the background label 0 has no parent, so it resolves to itself
+	const uint32_t numComponents = forest.resolve();
+	parallelFor( height, std::max<size_t>( sMinPixelsPerTask / width, 1 ), [&]( size_t begin, size_t end ) {
+		for( uint32_t *label = labels->data() + begin * width; label < labels->data() + end * width; ++label )
+			*label = forest[*label];
+	} );
+
+	std::vector<uint32_t> areas( numComponents, 0 );
+	std::vector<ivec2> mins( numComponents, ivec2( width, height ) ), maxs( numComponents, ivec2( 0 ) );
+	std::vector<dvec2> sums( numComponents );
+	for( int32_t y = 0; y < height; ++y ) {
+		const uint32_t *row = labels->data() + (size_t)y * width;
+		for( int32_t x = 0; x < width; ++x ) {
+			if( ! row[x] )
+				continue;
+			const uint32_t index = row[x] - 1;
+			++areas[index];
+			mins[index] = glm::min( mins[index], ivec2( x, y ) );
+			maxs[index] = glm::max( maxs[index], ivec2( x + 1, y + 1 ) );
+			sums[index] += dvec2( x, y );
+		}
+	}
+
+	std::vector<ConnectedComponent> result;
+	result.reserve( numComponents );
+	for( uint32_t i = 0; i < numComponents; ++i )
+		result.emplace_back( i + 1, areas[i], Area( mins[i], maxs[i] ), vec2( sums[i] / (double)areas[i] ) );
+	return result;
+}
+
+} } // namespace cinder::ip
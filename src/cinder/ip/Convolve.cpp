@@ -0,0 +1,600 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/Convolve.h"
+#include "cinder/ChanTraits.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define CI_CONVOLVE_SSE2
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	#include <arm_neon.h>
+	#define CI_CONVOLVE_NEON
+#endif
+
+namespace cinder { namespace ip {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Kernel
+Kernel::Kernel( int32_t width, int32_t height, const std::vector<float> &weights )
+	: mWidth( width ), mHeight( height ), mSeparable( false ), mWeights( weights )
+{
+	if( width <= 0 || height <= 0 || weights.size() != (size_t)width * height )
+		throw ConvolveExc( "Kernel requires width * height weights" );
+}
+
+Kernel Kernel::separable( const std::vector<float> &horizontal, const std::vector<float> &vertical )
+{
+	if( horizontal.empty() || vertical.empty() )
+		throw ConvolveExc( "Separable Kernel requires horizontal and vertical weights" );
+
+	Kernel result;
+	result.mWidth = (int32_t)horizontal.size();
+	result.mHeight = (int32_t)vertical.size();
+	result.mSeparable = true;
+	result.mHorizontal = horizontal;
+	result.mVertical = vertical;
+	result.mWeights.reserve( horizontal.size() * vertical.size() );
+	for( float v : vertical ) {
+		for( float h : horizontal )
+			result.mWeights.push_back( h * v );
+	}
+	return result;
+}
+
+Kernel Kernel::gaussian( float sigma, int32_t radius )
+{
+	if( radius < 0 )
+		radius = (int32_t)std::ceil( 3 * sigma );
+
+	std::vector<float> weights( 2 * radius + 1 );
+	double sum = 0;
+	for( int32_t i = -radius; i <= radius; ++i ) {
+		weights[i + radius] = sigma > 0 ? (float)std::exp( -0.5 * i * i / ( sigma * sigma ) ) : ( i == 0 ? 1.0f : 0.0f );
+		sum += weights[i + radius];
+	}
+	for( float &weight : weights )
+		weight = (float)( weight / sum );
+
+	return separable( weights, weights );
+}
+
+Kernel Kernel::box( int32_t radius )
+{
+	const std::vector<float> weights( 2 * std::max( radius, 0 ) + 1, 1.0f / ( 2 * std::max( radius, 0 ) + 1 ) );
+	return separable( weights, weights );
+}
+
+Kernel Kernel::sobelX()
+{
+	return separable( { -1, 0, 1 }, { 1, 2, 1 } );
+}
+
+Kernel Kernel::sobelY()
+{
+	return separable( { 1, 2, 1 }, { -1, 0, 1 } );
+}
+
+Kernel Kernel::scharrX()
+{
+	return separable( { -1, 0, 1 }, { 3, 10, 3 } );
+}
+
+Kernel Kernel::scharrY()
+{
+	return separable( { 3, 10, 3 }, { -1, 0, 1 } );
+}
+
+Kernel Kernel::laplacian()
+{
+	return Kernel( 3, 3, { 0, 1, 0, 1, -4, 1, 0, 1, 0 } );
+}
+
+Kernel Kernel::sharpen( float amount )
+{
+	return Kernel( 3, 3, { 0, -amount, 0, -amount, 1 + 4 * amount, -amount, 0, -amount, 0 } );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// convolve()
+namespace {
+
+// Images are split into tiles of at most this many columns, so that the rows of a tile stay in cache
+const int32_t	sMaxTileWidth = 1024;
+// Minimum number of pixels in each tile convolved by parallelFor()
+const int32_t	sMinPixelsPerTile = 32768;
+// Fixed point weights are limited to 14 fractional bits so that the intermediate sums fit in 32-bits
+const int32_t	sMaxWeightBits = 14;
+// Below this many bits the weights are too imprecise, and float is used instead
+const int32_t	sMinWeightBits = 6;
+
+// A channel read or written by convolve()
+template<typename T>
+struct Plane {
+	template<typename ChannelType>
+	Plane( ChannelType *channel )
+		: mData( (uint8_t*)channel->getData() ), mRowBytes( channel->getRowBytes() ), mIncrement( channel->getIncrement() ),
+		mWidth( channel->getWidth() ), mHeight( channel->getHeight() )
+	{}
+
+	T*		getPixel( int32_t x, int32_t y ) const	{ return reinterpret_cast<T*>( mData + y * mRowBytes ) + x * mIncrement; }
+
+	uint8_t		*mData;
+	ptrdiff_t	mRowBytes;
+	uint8_t		mIncrement;
+	int32_t		mWidth, mHeight;
+};
+
+// A rectangle of the source area convolved as a unit, and where its results are stored
+struct Tile {
+	int32_t		mX1, mY1, mX2, mY2;
+	ivec2		mDstOffset;
+};
+
+// The kernel and options in the form used by the tiles, including 16-bit fixed point weights for uint8_t
+struct PreparedKernel {
+	PreparedKernel( const Kernel &kernel, const ConvolveOptions &options, bool fixedPoint );
+
+	int32_t				mWidth, mHeight;
+	ivec2				mAnchor;
+	bool				mSeparable;
+	BorderMode			mBorderMode;
+	float				mBorderValue, mOffset;
+	// weights multiplied by the scale
+	std::vector<float>	mHorizontal, mVertical, mWeights;
+
+	bool					mFixedPoint;
+	std::vector<int16_t>	mFixedHorizontal, mFixedVertical, mFixedWeights;
+	int32_t					mHorizontalShift, mOutputShift;
+	int64_t					mFixedOffset; // includes rounding
+};
+
+// Quantizes \a weights to \a bits fractional bits, carrying the rounding error so that their sum is preserved
+std::vector<int16_t> quantize( const std::vector<float> &weights, int32_t bits )
+{
+	std::vector<int16_t> result( weights.size() );
+	double sum = 0;
+	int64_t previous = 0;
+	for( size_t i = 0; i < weights.size(); ++i ) {
+		sum += weights[i];
+		const int64_t current = std::llround( sum * ( int64_t( 1 ) << bits ) );
+		result[i] = (int16_t)( current - previous );
+		previous = current;
+	}
+	return result;
+}
+
+int64_t sumAbs( const std::vector<int16_t> &weights )
+{
+	int64_t result = 0;
+	for( int16_t weight : weights )
+		result += std::abs( weight );
+	return result;
+}
+
+// Returns the most fractional bits, no more than sMaxWeightBits, for which \a weights fit in int16_t and \a maxInput times their absolute sum fits in int32_t. Returns -1 if there's no such precision.
+int32_t quantize( const std::vector<float> &weights, int64_t maxInput, std::vector<int16_t> *result )
+{
+	float maxWeight = 0;
+	for( float weight : weights )
+		maxWeight = std::max( maxWeight, std::abs( weight ) );
+	int32_t bits = sMaxWeightBits;
+	while( bits >= sMinWeightBits && maxWeight * ( 1 << bits ) > 16384 )
+		--bits;
+
+	for( ; bits >= sMinWeightBits; --bits ) {
+		*result = quantize( weights, bits );
+		if( maxInput * sumAbs( *result ) <= INT32_MAX )
+			return bits;
+	}
+	return -1;
+}
+
+PreparedKernel::PreparedKernel( const Kernel &kernel, const ConvolveOptions &options, bool fixedPoint )
+	: mWidth( kernel.getWidth() ), mHeight( kernel.getHeight() ), mAnchor( kernel.getAnchor() ), mSeparable( kernel.isSeparable() ),
+	mBorderMode( options.getBorderMode() ), mBorderValue( options.getBorderValue() ), mOffset( options.getOffset() ),
+	mFixedPoint( false ), mHorizontalShift( 0 ), mOutputShift( 0 ), mFixedOffset( 0 )
+{
+	const float scale = options.getScale();
+	if( mSeparable ) {
+		mHorizontal = kernel.getHorizontal();
+		mVertical = kernel.getVertical();
+		for( float &weight : mHorizontal )
+			weight *= scale;
+	}
+	else {
+		mWeights = kernel.getWeights();
+		for( float &weight : mWeights )
+			weight *= scale;
+	}
+
+	if( ! fixedPoint )
+		return;
+
+	// uint8_t values are 16-bit fixed point, with the constant border clamped to the same range
+	mBorderValue = std::min( std::max( std::round( mBorderValue ), 0.0f ), 255.0f );
+	if( mSeparable ) {
+		// the horizontal pass narrows its results to 16-bit with as many fractional bits as fit, which the vertical pass sums
+		const int32_t horizontalBits = quantize( mHorizontal, 255, &mFixedHorizontal );
+		if( horizontalBits < 0 )
+			return;
+		const int64_t maxIntermediate = 255 * sumAbs( mFixedHorizontal );
+		int32_t intermediateBits = horizontalBits;
+		while( intermediateBits >= 0 && ( maxIntermediate >> ( horizontalBits - intermediateBits ) ) >= 32767 )
+			--intermediateBits;
+		const int32_t verticalBits = quantize( mVertical, 32767, &mFixedVertical );
+		if( intermediateBits < 0 || verticalBits < 0 )
+			return;
+		mHorizontalShift = horizontalBits - intermediateBits;
+		mOutputShift = intermediateBits + verticalBits;
+	}
+	else {
+		mOutputShift = quantize( mWeights, 255, &mFixedWeights );
+		if( mOutputShift < 0 )
+			return;
+	}
+
+	const double offset = std::min( std::max( (double)mOffset, -65536.0 ), 65536.0 );
+	mFixedOffset = std::llround( offset * ( int64_t( 1 ) << mOutputShift ) ) + ( mOutputShift > 0 ? int64_t( 1 ) << ( mOutputShift - 1 ) : 0 );
+	mFixedPoint = true;
+}
+
+// Returns the index of the pixel read for \a i in a row or column of \a size pixels, or -1 for the constant border
+int32_t borderIndex( int32_t i, int32_t size, BorderMode mode )
+{
+	if( i >= 0 && i < size )
+		return i;
+
+	switch( mode ) {
+		case BorderMode::CLAMP:
+			return i < 0 ? 0 : size - 1;
+		case BorderMode::MIRROR: {
+			if( size == 1 )
+				return 0;
+			const int32_t period = 2 * ( size - 1 );
+			i %= period;
+			if( i < 0 )
+				i += period;
+			return i < size ? i : period - i;
+		}
+		case BorderMode::WRAP:
+			i %= size;
+			return i < 0 ? i + size : i;
+		default:
+			return -1;
+	}
+}
+
+// Reads \a count pixels of row \a y starting at column \a x into \a result, applying the border mode outside of \a src
+template<typename T, typename BufT>
+void loadRow( const Plane<T> &src, int32_t x, int32_t y, int32_t count, BorderMode mode, BufT borderValue, BufT *result )
+{
+	y = borderIndex( y, src.mHeight, mode );
+	if( y < 0 ) {
+		std::fill( result, result + count, borderValue );
+		return;
+	}
+
+	const T *row = src.getPixel( 0, y );
+	auto readBorder = [&]( int32_t i ) {
+		const int32_t index = borderIndex( x + i, src.mWidth, mode );
+		result[i] = index < 0 ? borderValue : (BufT)row[index * src.mIncrement];
+	};
+
+	const int32_t begin = std::min( std::max( -x, 0 ), count );
+	const int32_t end = std::max( std::min( src.mWidth - x, count ), begin );
+	for( int32_t i = 0; i < begin; ++i )
+		readBorder( i );
+	const T *srcPtr = row + ( x + begin ) * src.mIncrement;
+	for( int32_t i = begin; i < end; ++i, srcPtr += src.mIncrement )
+		result[i] = (BufT)*srcPtr;
+	for( int32_t i = end; i < count; ++i )
+		readBorder( i );
+}
+
+// result[i] += values[i] * weight
+void multiplyAdd( float *result, const float *values, float weight, int32_t count )
+{
+	int32_t i = 0;
+#if defined( CI_CONVOLVE_SSE2 )
+	const __m128 w = _mm_set1_ps( weight );
+	for( ; i + 4 <= count; i += 4 )
+		_mm_storeu_ps( result + i, _mm_add_ps( _mm_loadu_ps( result + i ), _mm_mul_ps( _mm_loadu_ps( values + i ), w ) ) );
+#elif defined( CI_CONVOLVE_NEON )
+	for( ; i + 4 <= count; i += 4 )
+		vst1q_f32( result + i, vmlaq_n_f32( vld1q_f32( result + i ), vld1q_f32( values + i ), weight ) );
+#endif
+	for( ; i < count; ++i )
+		result[i] += values[i] * weight;
+}
+
+// result[i] += a[i] * weightA + b[i] * weightB, which pairs the taps for _mm_madd_epi16()
+void multiplyAddPairs( int32_t *result, const int16_t *a, const int16_t *b, int16_t weightA, int16_t weightB, int32_t count )
+{
+	int32_t i = 0;
+#if defined( CI_CONVOLVE_SSE2 )
+	const __m128i w = _mm_set1_epi32( (int32_t)( (uint32_t)(uint16_t)weightA | ( (uint32_t)(uint16_t)weightB << 16 ) ) );
+	for( ; i + 8 <= count; i += 8 ) {
+		const __m128i va = _mm_loadu_si128( (const __m128i*)( a + i ) ), vb = _mm_loadu_si128( (const __m128i*)( b + i ) );
+		__m128i *r = (__m128i*)( result + i );
+		_mm_storeu_si128( r, _mm_add_epi32( _mm_loadu_si128( r ), _mm_madd_epi16( _mm_unpacklo_epi16( va, vb ), w ) ) );
+		_mm_storeu_si128( r + 1, _mm_add_epi32( _mm_loadu_si128( r + 1 ), _mm_madd_epi16( _mm_unpackhi_epi16( va, vb ), w ) ) );
+	}
+#elif defined( CI_CONVOLVE_NEON )
+	for( ; i + 4 <= count; i += 4 )
+		vst1q_s32( result + i, vmlal_n_s16( vmlal_n_s16( vld1q_s32( result + i ), vld1_s16( a + i ), weightA ), vld1_s16( b + i ), weightB ) );
+#endif
+	for( ; i < count; ++i )
+		result[i] += a[i] * weightA + b[i] * weightB;
+}
+
+// Rounds \a values to 16-bit after shifting right by \a shift
+void narrow( const int32_t *values, int32_t shift, int16_t *result, int32_t count )
+{
+	const int32_t half = shift > 0 ? 1 << ( shift - 1 ) : 0;
+	int32_t i = 0;
+#if defined( CI_CONVOLVE_SSE2 )
+	const __m128i h = _mm_set1_epi32( half ), s = _mm_cvtsi32_si128( shift );
+	for( ; i + 8 <= count; i += 8 ) {
+		const __m128i lo = _mm_sra_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i*)( values + i ) ), h ), s );
+		const __m128i hi = _mm_sra_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i*)( values + i + 4 ) ), h ), s );
+		_mm_storeu_si128( (__m128i*)( result + i ), _mm_packs_epi32( lo, hi ) );
+	}
+#endif
+	for( ; i < count; ++i )
+		result[i] = (int16_t)std::min( std::max( ( values[i] + half ) >> shift, -32768 ), 32767 );
+}
+
+template<typename T>
+T fromFloat( float value )
+{
+	return (T)std::min( std::max( value + 0.5f, 0.0f ), (float)CHANTRAIT<T>::max() );
+}
+
+template<>
+float fromFloat<float>( float value )
+{
+	return value;
+}
+
+// Horizontal and vertical kernels run over rows of the tile, keeping the last mHeight results in a ring buffer. 2D kernels keep the last mHeight source rows.
+template<typename SrcT, typename DstT>
+void convolveTileFloat( const Plane<SrcT> &src, const Plane<DstT> &dst, const PreparedKernel &kernel, const Tile &tile )
+{
+	const int32_t width = tile.mX2 - tile.mX1, paddedWidth = width + kernel.mWidth - 1;
+	const int32_t firstRow = tile.mY1 - kernel.mAnchor.y, lastRow = tile.mY2 - 1 + kernel.mHeight - 1 - kernel.mAnchor.y;
+	const int32_t ringStride = kernel.mSeparable ? width : paddedWidth;
+	std::vector<float> padded( paddedWidth ), ring( ringStride * kernel.mHeight ), sums( width );
+	auto getRingRow = [&]( int32_t y ) { return &ring[( ( y - firstRow ) % kernel.mHeight ) * ringStride]; };
+
+	for( int32_t y = firstRow; y <= lastRow; ++y ) {
+		if( kernel.mSeparable ) {
+			loadRow( src, tile.mX1 - kernel.mAnchor.x, y, paddedWidth, kernel.mBorderMode, kernel.mBorderValue, padded.data() );
+			float *row = getRingRow( y );
+			std::fill( row, row + width, 0.0f );
+			for( int32_t k = 0; k < kernel.mWidth; ++k ) {
+				if( kernel.mHorizontal[k] != 0 )
+					multiplyAdd( row, padded.data() + k, kernel.mHorizontal[k], width );
+			}
+		}
+		else
+			loadRow( src, tile.mX1 - kernel.mAnchor.x, y, paddedWidth, kernel.mBorderMode, kernel.mBorderValue, getRingRow( y ) );
+
+		// the first output row needs mHeight rows
+		const int32_t outputRow = y - ( kernel.mHeight - 1 - kernel.mAnchor.y );
+		if( outputRow < tile.mY1 )
+			continue;
+
+		std::fill( sums.begin(), sums.end(), kernel.mOffset );
+		for( int32_t ky = 0; ky < kernel.mHeight; ++ky ) {
+			const float *row = getRingRow( outputRow - kernel.mAnchor.y + ky );
+			if( kernel.mSeparable ) {
+				if( kernel.mVertical[ky] != 0 )
+					multiplyAdd( sums.data(), row, kernel.mVertical[ky], width );
+			}
+			else {
+				for( int32_t kx = 0; kx < kernel.mWidth; ++kx ) {
+					if( kernel.mWeights[ky * kernel.mWidth + kx] != 0 )
+						multiplyAdd( sums.data(), row + kx, kernel.mWeights[ky * kernel.mWidth + kx], width );
+				}
+			}
+		}
+
+		DstT *dstPtr = dst.getPixel( tile.mDstOffset.x, tile.mDstOffset.y + outputRow - tile.mY1 );
+		for( int32_t x = 0; x < width; ++x, dstPtr += dst.mIncrement )
+			*dstPtr = fromFloat<DstT>( sums[x] );
+	}
+}
+
+// The same as convolveTileFloat(), with 16-bit values and weights summed in 32-bit
+void convolveTileFixed( const Plane<uint8_t> &src, const Plane<uint8_t> &dst, const PreparedKernel &kernel, const Tile &tile )
+{
+	// rows are padded so that an odd final tap can be paired with a zero weight
+	const int32_t width = tile.mX2 - tile.mX1, paddedWidth = width + kernel.mWidth - 1;
+	const int32_t firstRow = tile.mY1 - kernel.mAnchor.y, lastRow = tile.mY2 - 1 + kernel.mHeight - 1 - kernel.mAnchor.y;
+	const int32_t ringStride = ( kernel.mSeparable ? width : paddedWidth ) + 1;
+	std::vector<int16_t> padded( paddedWidth + 1 ), ring( ringStride * kernel.mHeight );
+	std::vector<int32_t> sums( width );
+	auto getRingRow = [&]( int32_t y ) { return &ring[( ( y - firstRow ) % kernel.mHeight ) * ringStride]; };
+	auto getWeight = []( const std::vector<int16_t> &weights, int32_t i ) { return i < (int32_t)weights.size() ? weights[i] : int16_t( 0 ); };
+
+	for( int32_t y = firstRow; y <= lastRow; ++y ) {
+		if( kernel.mSeparable ) {
+			loadRow( src, tile.mX1 - kernel.mAnchor.x, y, paddedWidth, kernel.mBorderMode, (int16_t)kernel.mBorderValue, padded.data() );
+			std::fill( sums.begin(), sums.end(), 0 );
+			for( int32_t k = 0; k < kernel.mWidth; k += 2 ) {
+				if( kernel.mFixedHorizontal[k] != 0 || getWeight( kernel.mFixedHorizontal, k + 1 ) != 0 )
+					multiplyAddPairs( sums.data(), padded.data() + k, padded.data() + k + 1, kernel.mFixedHorizontal[k], getWeight( kernel.mFixedHorizontal, k + 1 ), width );
+			}
+			narrow( sums.data(), kernel.mHorizontalShift, getRingRow( y ), width );
+		}
+		else
+			loadRow( src, tile.mX1 - kernel.mAnchor.x, y, paddedWidth, kernel.mBorderMode, (int16_t)kernel.mBorderValue, getRingRow( y ) );
+
+		const int32_t outputRow = y - ( kernel.mHeight - 1 - kernel.mAnchor.y );
+		if( outputRow < tile.mY1 )
+			continue;
+
+		std::fill( sums.begin(), sums.end(), 0 );
+		if( kernel.mSeparable ) {
+			for( int32_t ky = 0; ky < kernel.mHeight; ky += 2 ) {
+				const int16_t *a = getRingRow( outputRow - kernel.mAnchor.y + ky );
+				const int16_t *b = ky + 1 < kernel.mHeight ? getRingRow( outputRow - kernel.mAnchor.y + ky + 1 ) : a;
+				if( kernel.mFixedVertical[ky] != 0 || getWeight( kernel.mFixedVertical, ky + 1 ) != 0 )
+					multiplyAddPairs( sums.data(), a, b, kernel.mFixedVertical[ky], getWeight( kernel.mFixedVertical, ky + 1 ), width );
+			}
+		}
+		else {
+			for( int32_t ky = 0; ky < kernel.mHeight; ++ky ) {
+				const int16_t *row = getRingRow( outputRow - kernel.mAnchor.y + ky );
+				for( int32_t kx = 0; kx < kernel.mWidth; kx += 2 ) {
+					const int16_t weightA = kernel.mFixedWeights[ky * kernel.mWidth + kx];
+					const int16_t weightB = kx + 1 < kernel.mWidth ? kernel.mFixedWeights[ky * kernel.mWidth + kx + 1] : int16_t( 0 );
+					if( weightA != 0 || weightB != 0 )
+						multiplyAddPairs( sums.data(), row + kx, row + kx + 1, weightA, weightB, width );
+				}
+			}
+		}
+
+		uint8_t *dstPtr = dst.getPixel( tile.mDstOffset.x, tile.mDstOffset.y + outputRow - tile.mY1 );
+		for( int32_t x = 0; x < width; ++x, dstPtr += dst.mIncrement )
+			*dstPtr = (uint8_t)std::min<int64_t>( std::max<int64_t>( ( sums[x] + kernel.mFixedOffset ) >> kernel.mOutputShift, 0 ), 255 );
+	}
+}
+
+template<typename SrcT, typename DstT>
+void convolveTile( const Plane<SrcT> &src, const Plane<DstT> &dst, const PreparedKernel &kernel, const Tile &tile )
+{
+	convolveTileFloat( src, dst, kernel, tile );
+}
+
+void convolveTile( const Plane<uint8_t> &src, const Plane<uint8_t> &dst, const PreparedKernel &kernel, const Tile &tile )
+{
+	if( kernel.mFixedPoint )
+		convolveTileFixed( src, dst, kernel, tile );
+	else
+		convolveTileFloat( src, dst, kernel, tile );
+}
+
+template<typename SrcT, typename DstT>
+void convolvePlanes( const ChannelT<SrcT> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<DstT> *dstChannel, const Kernel &kernel, const ConvolveOptions &options )
+{
+	if( kernel.getWidth() <= 0 || kernel.getHeight() <= 0 )
+		throw ConvolveExc( "convolve() requires a Kernel with weights" );
+
+	const std::pair<Area,ivec2> srcDst = clippedSrcDst( srcChannel.getBounds(), srcArea, dstChannel->getBounds(), dstLT );
+	Area area = srcDst.first;
+	const ivec2 &dstOffset = srcDst.second;
+	if( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return;
+
+	// convolving in place would overwrite pixels which are still to be read as neighbors
+	ChannelT<SrcT> copy;
+	const ChannelT<SrcT> *source = &srcChannel;
+	if( (const void*)srcChannel.getData() == (const void*)dstChannel->getData() ) {
+		copy = srcChannel.clone();
+		source = &copy;
+	}
+
+	const bool fixedPoint = std::is_same<SrcT, uint8_t>::value && std::is_same<DstT, uint8_t>::value;
+	const PreparedKernel prepared( kernel, options, fixedPoint );
+	const Plane<SrcT> src( source );
+	const Plane<DstT> dst( dstChannel );
+
+	const int32_t numColumns = ( area.getWidth() + sMaxTileWidth - 1 ) / sMaxTileWidth;
+	const int32_t tileWidth = ( area.getWidth() + numColumns - 1 ) / numColumns;
+	// each tile also reads the rows around it, so they're kept tall compared to the kernel
+	const int32_t tileHeight = options.isParallel() ? std::max( sMinPixelsPerTile / tileWidth, 4 * kernel.getHeight() ) : area.getHeight();
+	const int32_t numRows = ( area.getHeight() + tileHeight - 1 ) / tileHeight;
+
+	auto convolveTiles = [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			Tile tile;
+			tile.mX1 = area.getX1() + (int32_t)( i % numColumns ) * tileWidth;
+			tile.mY1 = area.getY1() + (int32_t)( i / numColumns ) * tileHeight;
+			tile.mX2 = std::min( tile.mX1 + tileWidth, area.getX2() );
+			tile.mY2 = std::min( tile.mY1 + tileHeight, area.getY2() );
+			tile.mDstOffset = dstOffset + ivec2( tile.mX1, tile.mY1 ) - area.getUL();
+			convolveTile( src, dst, prepared, tile );
+		}
+	};
+
+	if( options.isParallel() )
+		parallelFor( numColumns * numRows, 1, convolveTiles );
+	else
+		convolveTiles( 0, numColumns * numRows );
+}
+
+} // anonymous namespace
+
+template<typename T>
+void convolve( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options )
+{
+	convolvePlanes( srcChannel, srcArea, dstLT, dstChannel, kernel, options );
+}
+
+template<typename T>
+void convolve( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options )
+{
+	convolvePlanes( srcChannel, srcChannel.getBounds(), ivec2(), dstChannel, kernel, options );
+}
+
+template<typename T>
+void convolve( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options )
+{
+	convolvePlanes( srcSurface.getChannelRed(), srcArea, dstLT, &dstSurface->getChannelRed(), kernel, options );
+	convolvePlanes( srcSurface.getChannelGreen(), srcArea, dstLT, &dstSurface->getChannelGreen(), kernel, options );
+	convolvePlanes( srcSurface.getChannelBlue(), srcArea, dstLT, &dstSurface->getChannelBlue(), kernel, options );
+	if( srcSurface.hasAlpha() && dstSurface->hasAlpha() )
+		convolvePlanes( srcSurface.getChannelAlpha(), srcArea, dstLT, &dstSurface->getChannelAlpha(), kernel, options );
+}
+
+template<typename T>
+void convolve( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options )
+{
+	convolve( srcSurface, srcSurface.getBounds(), ivec2(), dstSurface, kernel, options );
+}
+
+template<typename T>
+void convolveSigned( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, Channel32f *dstChannel, const Kernel &kernel, const ConvolveOptions &options )
+{
+	convolvePlanes( srcChannel, srcArea, dstLT, dstChannel, kernel, options );
+}
+
+#define convolve_PROTOTYPES(T)\
+	template CI_API void convolve( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options );\
+	template CI_API void convolve( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const Kernel &kernel, const ConvolveOptions &options );\
+	template CI_API void convolve( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options );\
+	template CI_API void convolve( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Kernel &kernel, const ConvolveOptions &options );\
+	template CI_API void convolveSigned( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, Channel32f *dstChannel, const Kernel &kernel, const ConvolveOptions &options );
+
+// These should match CHANNEL_TYPES
+convolve_PROTOTYPES(uint8_t)
+convolve_PROTOTYPES(uint16_t)
+convolve_PROTOTYPES(float)
+
+} } // namespace cinder::ip
@@ -21,55 +21,90 @@
 */
 
 #include "cinder/ip/EdgeDetect.h"
-#include "cinder/Surface.h"
+#include "cinder/ip/Convolve.h"
+#include "cinder/ChanTraits.h"
 #include "cinder/CinderMath.h"
 
 namespace cinder { namespace ip {
 
-//     X           Y
-// -1  0  1     1  2  1
-// -2  0  2     0  0  0
-// -1  0  1    -1 -2 -1
-// NOTE: this leaves garbage in the top and bottom rows, as well as the left and right columns
+namespace {
 
+// Stores the magnitude of the gradient found by convolving with \a kernelX and \a kernelY
 template<typename T>
-void edgeDetectSobel( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel )
+void gradientMagnitude( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel, const Kernel &kernelX, const Kernel &kernelY )
 {
 	std::pair<Area,ivec2> srcDst = clippedSrcDst( srcChannel.getBounds(), srcArea, dstChannel->getBounds(), dstLT );
 	const Area &area( srcDst.first );
 	const ivec2 &dstOffset( srcDst.second );
-	typename CHANTRAIT<T>::SignedSum sumX, sumY;
+	if( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return;
 
-	ptrdiff_t srcRowInc = srcChannel.getRowBytes() / sizeof(T);
-	uint8_t srcPixelInc = srcChannel.getIncrement();
+	Channel32f gradientX( area.getWidth(), area.getHeight() ), gradientY( area.getWidth(), area.getHeight() );
+	convolveSigned( srcChannel, area, ivec2(), &gradientX, kernelX );
+	convolveSigned( srcChannel, area, ivec2(), &gradientY, kernelY );
+
+	const float maxValue = CHANTRAIT<T>::max();
 	uint8_t dstPixelInc = dstChannel->getIncrement();
-	const T maxValue = CHANTRAIT<T>::max();
-	for( int32_t y = 1; y < area.getHeight() - 1; ++y ) {
-		const T *srcLine = srcChannel.getData( area.getX1() + 1, area.getY1() + y );
-		T *dstLine = dstChannel->getData( dstOffset.x + area.getX1() + 1, dstOffset.y + y );
-		for( int32_t x = area.getX1() + 1; x < area.getX2() - 1; ++x ) {
-			sumX = -*(srcLine-srcRowInc-srcPixelInc) + *(srcLine-srcRowInc+srcPixelInc) - 2 * *(srcLine-srcPixelInc)
-							+ 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc-srcPixelInc) + *(srcLine+srcRowInc+srcPixelInc);
-			sumY = *(srcLine-srcRowInc-srcPixelInc) + 2 * *(srcLine-srcRowInc) + *(srcLine-srcRowInc+srcPixelInc)
-							- *(srcLine+srcRowInc-srcPixelInc) - 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc+srcPixelInc);
-			sumX = (typename CHANTRAIT<T>::SignedSum)math<float>::sqrt( (float)sumX * sumX + (float)sumY * sumY );
-			if( sumX > maxValue )
-				sumX = maxValue;
-			*dstLine = static_cast<T>( sumX );
+	for( int32_t y = 0; y < area.getHeight(); ++y ) {
+		const float *xLine = gradientX.getData( 0, y ), *yLine = gradientY.getData( 0, y );
+		T *dstLine = dstChannel->getData( dstOffset.x, dstOffset.y + y );
+		for( int32_t x = 0; x < area.getWidth(); ++x ) {
+			*dstLine = static_cast<T>( std::min( math<float>::sqrt( xLine[x] * xLine[x] + yLine[x] * yLine[x] ), maxValue ) );
 			dstLine += dstPixelInc;
-			srcLine += srcPixelInc;
 		}
 	}
 }
 
 template<typename T>
-void edgeDetectSobel( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface )
+void laplacianMagnitude( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel )
+{
+	std::pair<Area,ivec2> srcDst = clippedSrcDst( srcChannel.getBounds(), srcArea, dstChannel->getBounds(), dstLT );
+	const Area &area( srcDst.first );
+	const ivec2 &dstOffset( srcDst.second );
+	if( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return;
+
+	Channel32f laplacian( area.getWidth(), area.getHeight() );
+	convolveSigned( srcChannel, area, ivec2(), &laplacian, Kernel::laplacian() );
+
+	const float maxValue = CHANTRAIT<T>::max();
+	uint8_t dstPixelInc = dstChannel->getIncrement();
+	for( int32_t y = 0; y < area.getHeight(); ++y ) {
+		const float *srcLine = laplacian.getData( 0, y );
+		T *dstLine = dstChannel->getData( dstOffset.x, dstOffset.y + y );
+		for( int32_t x = 0; x < area.getWidth(); ++x ) {
+			*dstLine = static_cast<T>( std::min( math<float>::abs( srcLine[x] ), maxValue ) );
+			dstLine += dstPixelInc;
+		}
+	}
+}
+
+template<typename T, typename FnT>
+void forEachChannel( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const FnT &fn )
 {
-	edgeDetectSobel( srcSurface.getChannelRed(), srcArea, dstLT, &dstSurface->getChannelRed() );
-	edgeDetectSobel( srcSurface.getChannelGreen(), srcArea, dstLT, &dstSurface->getChannelGreen() );
-	edgeDetectSobel( srcSurface.getChannelBlue(), srcArea, dstLT, &dstSurface->getChannelBlue() );
+	fn( srcSurface.getChannelRed(), &dstSurface->getChannelRed() );
+	fn( srcSurface.getChannelGreen(), &dstSurface->getChannelGreen() );
+	fn( srcSurface.getChannelBlue(), &dstSurface->getChannelBlue() );
 	if( srcSurface.hasAlpha() && dstSurface->hasAlpha() )
-		edgeDetectSobel( srcSurface.getChannelAlpha(), srcArea, dstLT, &dstSurface->getChannelAlpha() );
+		fn( srcSurface.getChannelAlpha(), &dstSurface->getChannelAlpha() );
+}
+
+} // anonymous namespace
+
+//     X           Y
+// -1  0  1    -1 -2 -1
+// -2  0  2     0  0  0
+// -1  0  1     1  2  1
+template<typename T>
+void edgeDetectSobel( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel )
+{
+	gradientMagnitude( srcChannel, srcArea, dstLT, dstChannel, Kernel::sobelX(), Kernel::sobelY() );
+}
+
+template<typename T>
+void edgeDetectSobel( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface )
+{
+	forEachChannel( srcSurface, dstSurface, [&]( const ChannelT<T> &src, ChannelT<T> *dst ) { edgeDetectSobel( src, srcArea, dstLT, dst ); } );
 }
 
 template<typename T>
@@ -84,12 +119,91 @@ void edgeDetectSobel( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface )
 	edgeDetectSobel( srcSurface, srcSurface.getBounds(), ivec2(), dstSuface );
 }
 
+//     X           Y
+// -3  0  3    -3 -10 -3
+//-10  0 10     0   0  0
+// -3  0  3     3  10  3
+template<typename T>
+void edgeDetectScharr( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel )
+{
+	gradientMagnitude( srcChannel, srcArea, dstLT, dstChannel, Kernel::scharrX(), Kernel::scharrY() );
+}
+
+template<typename T>
+void edgeDetectScharr( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface )
+{
+	forEachChannel( srcSurface, dstSurface, [&]( const ChannelT<T> &src, ChannelT<T> *dst ) { edgeDetectScharr( src, srcArea, dstLT, dst ); } );
+}
+
+template<typename T>
+void edgeDetectScharr( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel )
+{
+	edgeDetectScharr( srcChannel, srcChannel.getBounds(), ivec2(), dstChannel );
+}
+
+template<typename T>
+void edgeDetectScharr( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface )
+{
+	edgeDetectScharr( srcSurface, srcSurface.getBounds(), ivec2(), dstSuface );
+}
+
+template<typename T>
+void edgeDetectLaplacian( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel )
+{
+	laplacianMagnitude( srcChannel, srcArea, dstLT, dstChannel );
+}
+
+template<typename T>
+void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface )
+{
+	forEachChannel( srcSurface, dstSurface, [&]( const ChannelT<T> &src, ChannelT<T> *dst ) { laplacianMagnitude( src, srcArea, dstLT, dst ); } );
+}
+
+template<typename T>
+void edgeDetectLaplacian( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel )
+{
+	edgeDetectLaplacian( srcChannel, srcChannel.getBounds(), ivec2(), dstChannel );
+}
+
+template<typename T>
+void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSuface )
+{
+	edgeDetectLaplacian( srcSurface, srcSurface.getBounds(), ivec2(), dstSuface );
+}
+
+template<typename T>
+void sharpen( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, float amount )
+{
+	convolve( srcChannel, dstChannel, Kernel::sharpen( amount ) );
+}
+
+template<typename T>
+void sharpen( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, float amount )
+{
+	const Kernel kernel = Kernel::sharpen( amount );
+	convolve( srcSurface.getChannelRed(), &dstSurface->getChannelRed(), kernel );
+	convolve( srcSurface.getChannelGreen(), &dstSurface->getChannelGreen(), kernel );
+	convolve( srcSurface.getChannelBlue(), &dstSurface->getChannelBlue(), kernel );
+	// alpha isn't sharpened, but a separate destination still needs it
+	if( dstSurface != &srcSurface && srcSurface.hasAlpha() && dstSurface->hasAlpha() )
+		dstSurface->getChannelAlpha().copyFrom( srcSurface.getChannelAlpha(), srcSurface.getBounds() );
+}
 
 #define edgeDetect_PROTOTYPES(T)\
 	template CI_API void edgeDetectSobel( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel ); \
 	template CI_API void edgeDetectSobel( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface ); \
 	template CI_API void edgeDetectSobel( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );	\
-	template CI_API void edgeDetectSobel( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface );	
+	template CI_API void edgeDetectSobel( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface );	\
+	template CI_API void edgeDetectScharr( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel ); \
+	template CI_API void edgeDetectScharr( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface ); \
+	template CI_API void edgeDetectScharr( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );	\
+	template CI_API void edgeDetectScharr( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface );	\
+	template CI_API void edgeDetectLaplacian( const ChannelT<T> &srcChannel, const Area &srcArea, const ivec2 &dstLT, ChannelT<T> *dstChannel ); \
+	template CI_API void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstLT, SurfaceT<T> *dstSurface ); \
+	template CI_API void edgeDetectLaplacian( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );	\
+	template CI_API void edgeDetectLaplacian( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface );	\
+	template CI_API void sharpen( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, float amount );	\
+	template CI_API void sharpen( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, float amount );
 
 edgeDetect_PROTOTYPES(uint8_t)
 edgeDetect_PROTOTYPES(uint16_t)
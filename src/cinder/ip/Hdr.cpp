@@ -24,31 +24,19 @@
 #include "cinder/ip/Grayscale.h"
 #include "cinder/ChanTraits.h"
 #include "cinder/ip/Fill.h"
+#include "cinder/ip/Statistics.h"
+#include "cinder/Thread.h"
 #include <algorithm>
 
 namespace cinder { namespace ip {
 
 void hdrNormalize( Surface32f *surface )
 {
-	// first take histogram to find the minimum and maximum values present
-	float minVal = *(surface->getDataRed( ivec2() )), maxVal = *(surface->getDataRed( ivec2() ));
+	// first find the minimum and maximum values present
+	const std::vector<Statistics> statistics = calcStatistics( *surface );
+	float minVal = std::min( { statistics[0].getMin(), statistics[1].getMin(), statistics[2].getMin() } );
+	float maxVal = std::max( { statistics[0].getMax(), statistics[1].getMax(), statistics[2].getMax() } );
 
-	const int8_t pixelInc = surface->getPixelInc();
-	const uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
-	for( int32_t y = 0; y < surface->getHeight(); ++y ) {
-		const float *srcPtr = surface->getData( ivec2( 0, y ) );
-		for( int32_t x = 0; x < surface->getWidth(); ++x ) {
-			minVal = std::min( minVal, srcPtr[redOffset] );
-			maxVal = std::max( maxVal, srcPtr[redOffset] );
-			minVal = std::min( minVal, srcPtr[greenOffset] );
-			maxVal = std::max( maxVal, srcPtr[greenOffset] );
-			minVal = std::min( minVal, srcPtr[blueOffset] );
-			maxVal = std::max( maxVal, srcPtr[blueOffset] );
-
-			srcPtr += pixelInc;
-		}
-	}
-	
 	// if min==max then we should just fill with black
 	if( minVal == maxVal ) {
 		fill( surface, Color( 0, 0, 0 ) );
@@ -56,21 +44,25 @@ void hdrNormalize( Surface32f *surface )
 	}
 	
 	float scale = 1.0f / ( maxVal - minVal );
-	for( int32_t y = 0; y < surface->getHeight(); ++y ) {
-		float *dstPtr = surface->getData( ivec2( 0, y ) );
-		for( int32_t x = 0; x < surface->getWidth(); ++x ) {
-			dstPtr[redOffset] = ( dstPtr[redOffset] - minVal ) * scale;
-			dstPtr[greenOffset] = ( dstPtr[greenOffset] - minVal ) * scale;
-			dstPtr[blueOffset] = ( dstPtr[blueOffset] - minVal ) * scale;
+	const int8_t pixelInc = surface->getPixelInc();
+	const uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
+	parallelFor( surface->getHeight(), std::max<size_t>( 65536 / surface->getWidth(), 1 ), [&]( size_t begin, size_t end ) {
+		for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+			float *dstPtr = surface->getData( ivec2( 0, y ) );
+			for( int32_t x = 0; x < surface->getWidth(); ++x ) {
+				dstPtr[redOffset] = ( dstPtr[redOffset] - minVal ) * scale;
+				dstPtr[greenOffset] = ( dstPtr[greenOffset] - minVal ) * scale;
+				dstPtr[blueOffset] = ( dstPtr[blueOffset] - minVal ) * scale;
 
-			dstPtr += pixelInc;
+				dstPtr += pixelInc;
+			}
 		}
-	}	
+	} );
 }
 
 void hdrNormalize( Channel32f *channel )
 {
-	// first take histogram to find the minimum and maximum values present
+	// first find the minimum and maximum values present
 	float minVal, maxVal;
 	getMinMax( *channel, &minVal, &maxVal );
 
@@ -81,26 +73,21 @@ void hdrNormalize( Channel32f *channel )
 	}
 	
 	float scale = 1.0f / ( maxVal - minVal );
-	Channel32f::Iter iter = channel->getIter();
-	while( iter.line() ) {
-		while( iter.pixel() ) {
-			iter.v() = ( iter.v() - minVal ) * scale;
+	const uint8_t inc = channel->getIncrement();
+	parallelFor( channel->getHeight(), std::max<size_t>( 65536 / channel->getWidth(), 1 ), [&]( size_t begin, size_t end ) {
+		for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+			float *dstPtr = channel->getData( ivec2( 0, y ) );
+			for( int32_t x = 0; x < channel->getWidth(); ++x, dstPtr += inc )
+				*dstPtr = ( *dstPtr - minVal ) * scale;
 		}
-	}
+	} );
 }
 
 void getMinMax( const Channel32f &channel, float *resultMin, float *resultMax )
 {
-	float minVal = *(channel.getData( ivec2() )), maxVal = *(channel.getData( ivec2() ));
-	Channel32f::ConstIter iter = channel.getIter();
-	while( iter.line() ) {
-		while( iter.pixel() ) {
-			minVal = std::min( minVal, iter.v() );
-			maxVal = std::max( maxVal, iter.v() );
-		}
-	}
-	*resultMin = minVal;
-	*resultMax = maxVal;
+	const Statistics statistics = calcStatistics( channel );
+	*resultMin = statistics.getMin();
+	*resultMax = statistics.getMax();
 }
 
 } } // namespace cinder::ip
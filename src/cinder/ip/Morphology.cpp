@@ -0,0 +1,233 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/Morphology.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define CI_MORPHOLOGY_SSE2
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	#include <arm_neon.h>
+	#define CI_MORPHOLOGY_NEON
+#endif
+
+namespace cinder { namespace ip {
+
+namespace {
+
+// Minimum number of pixels filtered by each task of parallelFor()
+const size_t	sMinPixelsPerTask = 65536;
+// Columns are filtered in strips of this many pixels, so that each strip's buffers stay in cache
+const int32_t	sStripWidth = 256;
+
+struct MinOp {
+	static uint8_t	identity()						{ return 255; }
+	static uint8_t	apply( uint8_t a, uint8_t b )	{ return std::min( a, b ); }
+#if defined( CI_MORPHOLOGY_SSE2 )
+	static __m128i	apply( __m128i a, __m128i b )	{ return _mm_min_epu8( a, b ); }
+#elif defined( CI_MORPHOLOGY_NEON )
+	static uint8x16_t	apply( uint8x16_t a, uint8x16_t b )	{ return vminq_u8( a, b ); }
+#endif
+};
+
+struct MaxOp {
+	static uint8_t	identity()						{ return 0; }
+	static uint8_t	apply( uint8_t a, uint8_t b )	{ return std::max( a, b ); }
+#if defined( CI_MORPHOLOGY_SSE2 )
+	static __m128i	apply( __m128i a, __m128i b )	{ return _mm_max_epu8( a, b ); }
+#elif defined( CI_MORPHOLOGY_NEON )
+	static uint8x16_t	apply( uint8x16_t a, uint8x16_t b )	{ return vmaxq_u8( a, b ); }
+#endif
+};
+
+// Sets \a result to OpT applied to each pair of \a a and \a b, any of which may alias
+template<typename OpT>
+void applyRow( const uint8_t *a, const uint8_t *b, uint8_t *result, int32_t count )
+{
+	int32_t i = 0;
+#if defined( CI_MORPHOLOGY_SSE2 )
+	for( ; i + 16 <= count; i += 16 ) {
+		const __m128i values = OpT::apply( _mm_loadu_si128( reinterpret_cast<const __m128i*>( a + i ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>( b + i ) ) );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( result + i ), values );
+	}
+#elif defined( CI_MORPHOLOGY_NEON )
+	for( ; i + 16 <= count; i += 16 )
+		vst1q_u8( result + i, OpT::apply( vld1q_u8( a + i ), vld1q_u8( b + i ) ) );
+#endif
+	for( ; i < count; ++i )
+		result[i] = OpT::apply( a[i], b[i] );
+}
+
+// The van Herk / Gil-Werman algorithm: the padded line is split into blocks of the element's size, and each window of that size
+// spans the end of one block and the start of the next. So each output is OpT of a running suffix within one block and a running prefix
+// within the next, which costs 3 operations per pixel regardless of the element's size.
+
+// Filters rows [begin, end) of \a src horizontally into \a dst, which has the same size and an increment of 1. The element covers \a anchor pixels before each one.
+template<typename OpT>
+void filterRows( const Channel8u &src, Channel8u *dst, int32_t size, int32_t anchor, size_t begin, size_t end )
+{
+	const int32_t width = src.getWidth(), padded = width + size - 1;
+	const uint8_t inc = src.getIncrement();
+	std::vector<uint8_t> line( padded, OpT::identity() ), prefix( padded );
+	for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+		const uint8_t *srcPtr = src.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < width; ++x, srcPtr += inc )
+			line[x + anchor] = *srcPtr;
+
+		for( int32_t i = 0, blockPos = 0; i < padded; ++i ) {
+			prefix[i] = blockPos == 0 ? line[i] : OpT::apply( prefix[i - 1], line[i] );
+			if( ++blockPos == size )
+				blockPos = 0;
+		}
+
+		uint8_t *dstPtr = dst->getData( ivec2( 0, y ) );
+		uint8_t suffix = OpT::identity();
+		for( int32_t i = padded - 1; i >= 0; --i ) {
+			suffix = ( i % size == size - 1 || i == padded - 1 ) ? line[i] : OpT::apply( line[i], suffix );
+			if( i < width )
+				dstPtr[i] = OpT::apply( suffix, prefix[i + size - 1] );
+		}
+	}
+}
+
+// Filters columns [x0, x1) of \a src, which has an increment of 1, vertically into \a dst, a whole row of the strip at a time
+template<typename OpT>
+void filterColumns( const Channel8u &src, Channel8u *dst, int32_t size, int32_t anchor, int32_t x0, int32_t x1 )
+{
+	const int32_t height = src.getHeight(), padded = height + size - 1, stripWidth = x1 - x0;
+	const std::vector<uint8_t> identityRow( stripWidth, OpT::identity() );
+	auto srcRow = [&]( int32_t i ) {
+		const int32_t y = i - anchor;
+		return ( y < 0 || y >= height ) ? identityRow.data() : src.getData( ivec2( x0, y ) );
+	};
+
+	std::vector<uint8_t> prefix( (size_t)padded * stripWidth );
+	for( int32_t i = 0; i < padded; ++i ) {
+		uint8_t *prefixRow = &prefix[(size_t)i * stripWidth];
+		if( i % size == 0 )
+			std::memcpy( prefixRow, srcRow( i ), stripWidth );
+		else
+			applyRow<OpT>( prefixRow - stripWidth, srcRow( i ), prefixRow, stripWidth );
+	}
+
+	const uint8_t dstInc = dst->getIncrement();
+	std::vector<uint8_t> suffix( stripWidth ), result( stripWidth );
+	for( int32_t i = padded - 1; i >= 0; --i ) {
+		if( i % size == size - 1 || i == padded - 1 )
+			std::memcpy( suffix.data(), srcRow( i ), stripWidth );
+		else
+			applyRow<OpT>( srcRow( i ), suffix.data(), suffix.data(), stripWidth );
+
+		if( i < height ) {
+			uint8_t *dstPtr = dst->getData( ivec2( x0, i ) );
+			if( dstInc == 1 )
+				applyRow<OpT>( suffix.data(), &prefix[(size_t)( i + size - 1 ) * stripWidth], dstPtr, stripWidth );
+			else {
+				applyRow<OpT>( suffix.data(), &prefix[(size_t)( i + size - 1 ) * stripWidth], result.data(), stripWidth );
+				for( int32_t x = 0; x < stripWidth; ++x, dstPtr += dstInc )
+					*dstPtr = result[x];
+			}
+		}
+	}
+}
+
+// Applies the element's rows to \a srcChannel and then its columns, storing into the overlap of \a srcChannel and \a dstChannel.
+// The element is centered on each pixel, rounding down for even sizes, or the other way when \a reflect is true, as the second pass of open() and close() needs.
+template<typename OpT>
+void morphology( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel, bool reflect = false )
+{
+	const int32_t width = std::min( srcChannel.getWidth(), dstChannel->getWidth() ), height = std::min( srcChannel.getHeight(), dstChannel->getHeight() );
+	if( width <= 0 || height <= 0 )
+		return;
+
+	const ivec2 size = glm::max( elementSize, ivec2( 1 ) );
+	const ivec2 anchor = reflect ? size - ivec2( 1 ) - size / 2 : size / 2;
+	Channel8u rows( srcChannel.getWidth(), srcChannel.getHeight() );
+	auto rowsFn = [&]( size_t begin, size_t end ) { filterRows<OpT>( srcChannel, &rows, size.x, anchor.x, begin, end ); };
+	if( parallel )
+		parallelFor( rows.getHeight(), std::max<size_t>( sMinPixelsPerTask / rows.getWidth(), 1 ), rowsFn );
+	else
+		rowsFn( 0, rows.getHeight() );
+
+	// the row pass has already copied the source, so filtering in place is safe
+	const int32_t numStrips = ( width + sStripWidth - 1 ) / sStripWidth;
+	auto columnsFn = [&]( size_t begin, size_t end ) {
+		for( size_t strip = begin; strip < end; ++strip )
+			filterColumns<OpT>( rows, dstChannel, size.y, anchor.y, (int32_t)strip * sStripWidth, std::min( (int32_t)( strip + 1 ) * sStripWidth, width ) );
+	};
+	if( parallel )
+		parallelFor( numStrips, std::max<size_t>( sMinPixelsPerTask / ( (size_t)sStripWidth * height ), 1 ), columnsFn );
+	else
+		columnsFn( 0, numStrips );
+}
+
+} // anonymous namespace
+
+void erode( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MinOp>( srcChannel, dstChannel, elementSize, parallel );
+}
+
+void erode( Channel8u *channel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MinOp>( *channel, channel, elementSize, parallel );
+}
+
+void dilate( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MaxOp>( srcChannel, dstChannel, elementSize, parallel );
+}
+
+void dilate( Channel8u *channel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MaxOp>( *channel, channel, elementSize, parallel );
+}
+
+void open( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MinOp>( srcChannel, dstChannel, elementSize, parallel );
+	morphology<MaxOp>( *dstChannel, dstChannel, elementSize, parallel, true );
+}
+
+void open( Channel8u *channel, const ivec2 &elementSize, bool parallel )
+{
+	open( *channel, channel, elementSize, parallel );
+}
+
+void close( const Channel8u &srcChannel, Channel8u *dstChannel, const ivec2 &elementSize, bool parallel )
+{
+	morphology<MaxOp>( srcChannel, dstChannel, elementSize, parallel );
+	morphology<MinOp>( *dstChannel, dstChannel, elementSize, parallel, true );
+}
+
+void close( Channel8u *channel, const ivec2 &elementSize, bool parallel )
+{
+	close( *channel, channel, elementSize, parallel );
+}
+
+} } // namespace cinder::ip
@@ -0,0 +1,644 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/Statistics.h"
+#include "cinder/ChanTraits.h"
+#include "cinder/CinderAssert.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define CI_STATISTICS_SSE2
+#endif
+
+namespace cinder { namespace ip {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Histogram
+Histogram::Histogram( size_t numBins, float minValue, float maxValue )
+	: mMinValue( minValue ), mMaxValue( maxValue ), mBins( std::max<size_t>( numBins, 1 ), 0 ), mTotal( 0 )
+{
+}
+
+size_t Histogram::getBinIndex( float value ) const
+{
+	const float bin = ( value - mMinValue ) * mBins.size() / ( mMaxValue - mMinValue );
+	if( ! ( bin >= 0 ) )
+		return 0;
+	return bin < mBins.size() ? (size_t)bin : mBins.size() - 1;
+}
+
+float Histogram::getBinValue( size_t bin ) const
+{
+	return mMinValue + ( mMaxValue - mMinValue ) * bin / mBins.size();
+}
+
+void Histogram::add( size_t bin, uint32_t count )
+{
+	mBins.at( bin ) += count;
+	mTotal += count;
+}
+
+void Histogram::merge( const Histogram &other )
+{
+	CI_ASSERT( other.mBins.size() == mBins.size() );
+	for( size_t i = 0; i < mBins.size(); ++i )
+		mBins[i] += other.mBins[i];
+	mTotal += other.mTotal;
+}
+
+float Histogram::calcMean() const
+{
+	if( mTotal == 0 )
+		return 0;
+
+	double sum = 0;
+	for( size_t i = 0; i < mBins.size(); ++i )
+		sum += mBins[i] * ( i + 0.5 );
+	return mMinValue + (float)( sum / mTotal ) * ( mMaxValue - mMinValue ) / mBins.size();
+}
+
+float Histogram::calcPercentile( float fraction ) const
+{
+	if( mTotal == 0 )
+		return mMinValue;
+
+	const double target = std::min( std::max( fraction, 0.0f ), 1.0f ) * (double)mTotal;
+	double below = 0;
+	for( size_t i = 0; i < mBins.size(); ++i ) {
+		if( mBins[i] > 0 && below + mBins[i] >= target ) {
+			const double within = ( target - below ) / mBins[i];
+			return mMinValue + (float)( ( i + within ) * ( mMaxValue - mMinValue ) / mBins.size() );
+		}
+		below += mBins[i];
+	}
+	return mMaxValue;
+}
+
+namespace {
+
+// Minimum number of pixels counted by each task of parallelReduce()
+const size_t sMinPixelsPerTask = 65536;
+
+// The rows inside an Area of a Channel, or of the red, green, blue and alpha channels of a Surface
+template<typename T>
+struct Region {
+	Region( const ChannelT<T> &channel, const Area &area )
+		: mArea( area.getClipBy( channel.getBounds() ) ), mRowBytes( channel.getRowBytes() ), mPixelInc( channel.getIncrement() ), mNumChannels( 1 )
+	{
+		mData = (const uint8_t*)channel.getData( mArea.getUL() );
+		mOffsets[0] = 0;
+	}
+
+	Region( const SurfaceT<T> &surface, const Area &area )
+		: mArea( area.getClipBy( surface.getBounds() ) ), mRowBytes( surface.getRowBytes() ), mPixelInc( surface.getPixelInc() ), mNumChannels( surface.hasAlpha() ? 4 : 3 )
+	{
+		mData = (const uint8_t*)surface.getData( mArea.getUL() );
+		mOffsets[0] = surface.getRedOffset();
+		mOffsets[1] = surface.getGreenOffset();
+		mOffsets[2] = surface.getBlueOffset();
+		mOffsets[3] = surface.hasAlpha() ? surface.getAlphaOffset() : 0;
+	}
+
+	const T*	getRow( int32_t y ) const		{ return reinterpret_cast<const T*>( mData + y * mRowBytes ); }
+	int32_t		getWidth() const				{ return mArea.getWidth(); }
+	int32_t		getHeight() const				{ return mArea.getHeight(); }
+
+	Area			mArea;
+	const uint8_t	*mData;
+	ptrdiff_t		mRowBytes;
+	int32_t			mPixelInc;
+	int32_t			mNumChannels;
+	uint8_t			mOffsets[4];
+};
+
+template<typename T>
+Histogram makeHistogram( const HistogramOptions &options )
+{
+	if( options.hasRange() )
+		return Histogram( options.getNumBins(), options.getMinValue(), options.getMaxValue() );
+	else
+		return Histogram( options.getNumBins(), 0, std::is_floating_point<T>::value ? 1.0f : (float)CHANTRAIT<T>::max() + 1 );
+}
+
+// Maps integer values to bins through a table of every value
+template<typename T>
+struct BinIndex {
+	BinIndex( const Histogram &histogram )
+		: mTable( (size_t)CHANTRAIT<T>::max() + 1 )
+	{
+		for( size_t v = 0; v < mTable.size(); ++v )
+			mTable[v] = (uint32_t)histogram.getBinIndex( (float)v );
+	}
+
+	uint32_t	operator()( T value ) const		{ return mTable[value]; }
+
+	std::vector<uint32_t>	mTable;
+};
+
+template<>
+struct BinIndex<float> {
+	BinIndex( const Histogram &histogram )
+		: mMinValue( histogram.getMinValue() ), mScale( histogram.getNumBins() / ( histogram.getMaxValue() - histogram.getMinValue() ) ),
+		mNumBins( (float)histogram.getNumBins() ), mLastBin( (uint32_t)histogram.getNumBins() - 1 )
+	{}
+
+	uint32_t	operator()( float value ) const
+	{
+		const float bin = ( value - mMinValue ) * mScale;
+		if( ! ( bin >= 0 ) )
+			return 0;
+		return bin < mNumBins ? (uint32_t)bin : mLastBin;
+	}
+
+	float		mMinValue, mScale, mNumBins;
+	uint32_t	mLastBin;
+};
+
+// Returns the bins of every channel of rows [begin, end), one histogram after another
+template<typename T>
+std::vector<uint32_t> countRows( const Region<T> &region, const BinIndex<T> &binIndex, size_t numBins, size_t begin, size_t end )
+{
+	// a single channel is counted into 4 histograms, so that runs of equal values don't wait on the previous increment
+	const bool split = region.mNumChannels == 1;
+	std::vector<uint32_t> bins( numBins * ( split ? 4 : region.mNumChannels ), 0 );
+	const int32_t width = region.getWidth(), inc = region.mPixelInc;
+	for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+		const T *src = region.getRow( y );
+		if( split ) {
+			uint32_t *bins0 = bins.data(), *bins1 = bins0 + numBins, *bins2 = bins1 + numBins, *bins3 = bins2 + numBins;
+			int32_t x = 0;
+			for( ; x + 4 <= width; x += 4, src += 4 * inc ) {
+				++bins0[binIndex( src[0] )];
+				++bins1[binIndex( src[inc] )];
+				++bins2[binIndex( src[2 * inc] )];
+				++bins3[binIndex( src[3 * inc] )];
+			}
+			for( ; x < width; ++x, src += inc )
+				++bins0[binIndex( src[0] )];
+		}
+		else {
+			for( int32_t x = 0; x < width; ++x, src += inc ) {
+				for( int32_t c = 0; c < region.mNumChannels; ++c )
+					++bins[c * numBins + binIndex( src[region.mOffsets[c]] )];
+			}
+		}
+	}
+
+	if( split ) {
+		for( size_t i = 0; i < numBins; ++i )
+			bins[i] += bins[i + numBins] + bins[i + 2 * numBins] + bins[i + 3 * numBins];
+		bins.resize( numBins );
+	}
+	return bins;
+}
+
+template<typename T>
+std::vector<Histogram> calcHistogramsImpl( const Region<T> &region, const HistogramOptions &options )
+{
+	std::vector<Histogram> result( region.mNumChannels, makeHistogram<T>( options ) );
+	const size_t numBins = result[0].getNumBins();
+	if( region.getWidth() <= 0 || region.getHeight() <= 0 )
+		return result;
+
+	const BinIndex<T> binIndex( result[0] );
+	auto countFn = [&]( size_t begin, size_t end ) { return countRows( region, binIndex, numBins, begin, end ); };
+	std::vector<uint32_t> bins;
+	if( options.isParallel() ) {
+		// each task counts into a private histogram, which are summed as the tasks complete
+		bins = parallelReduce( region.getHeight(), std::max<size_t>( sMinPixelsPerTask / region.getWidth(), 1 ), std::vector<uint32_t>(), countFn,
+			[]( std::vector<uint32_t> a, const std::vector<uint32_t> &b ) {
+				if( a.empty() )
+					return b;
+				for( size_t i = 0; i < a.size(); ++i )
+					a[i] += b[i];
+				return a;
+			} );
+	}
+	else
+		bins = countFn( 0, region.getHeight() );
+
+	for( int32_t c = 0; c < region.mNumChannels; ++c ) {
+		for( size_t i = 0; i < numBins; ++i )
+			result[c].add( i, bins[c * numBins + i] );
+	}
+	return result;
+}
+
+// The sums from which Statistics are calculated, for up to 4 channels
+struct Moments {
+	Moments()
+		: mCount( 0 )
+	{
+		std::fill( mMin, mMin + 4, std::numeric_limits<float>::max() );
+		std::fill( mMax, mMax + 4, std::numeric_limits<float>::lowest() );
+		std::fill( mSum, mSum + 4, 0.0 );
+		std::fill( mSumSquares, mSumSquares + 4, 0.0 );
+	}
+
+	void merge( const Moments &other )
+	{
+		for( int c = 0; c < 4; ++c ) {
+			mMin[c] = std::min( mMin[c], other.mMin[c] );
+			mMax[c] = std::max( mMax[c], other.mMax[c] );
+			mSum[c] += other.mSum[c];
+			mSumSquares[c] += other.mSumSquares[c];
+		}
+		mCount += other.mCount;
+	}
+
+	float		mMin[4], mMax[4];
+	double		mSum[4], mSumSquares[4];
+	uint64_t	mCount;
+};
+
+// Integer sums are exact within a row, and converted to double once per row
+template<typename T>
+struct RowSums {
+	typedef typename std::conditional<std::is_integral<T>::value, uint64_t, double>::type SumT;
+
+	RowSums()
+	{
+		std::fill( mMin, mMin + 4, std::numeric_limits<T>::max() );
+		std::fill( mMax, mMax + 4, std::numeric_limits<T>::lowest() );
+		std::fill( mSum, mSum + 4, SumT( 0 ) );
+		std::fill( mSumSquares, mSumSquares + 4, SumT( 0 ) );
+	}
+
+	void add( int32_t c, T value )
+	{
+		mMin[c] = std::min( mMin[c], value );
+		mMax[c] = std::max( mMax[c], value );
+		mSum[c] += value;
+		mSumSquares[c] += (SumT)value * value;
+	}
+
+	void addTo( Moments *moments, int32_t numChannels ) const
+	{
+		for( int32_t c = 0; c < numChannels; ++c ) {
+			moments->mMin[c] = std::min( moments->mMin[c], (float)mMin[c] );
+			moments->mMax[c] = std::max( moments->mMax[c], (float)mMax[c] );
+			moments->mSum[c] += (double)mSum[c];
+			moments->mSumSquares[c] += (double)mSumSquares[c];
+		}
+	}
+
+	T		mMin[4], mMax[4];
+	SumT	mSum[4], mSumSquares[4];
+};
+
+// Returns the channel of each value of a pixel from its lowest channel offset, or -1 for values which aren't sampled such as padding
+template<typename T>
+std::vector<int32_t> getChannelsByPosition( const Region<T> &region )
+{
+	std::vector<int32_t> result( region.mPixelInc, -1 );
+	const uint8_t firstOffset = *std::min_element( region.mOffsets, region.mOffsets + region.mNumChannels );
+	for( int32_t c = 0; c < region.mNumChannels; ++c )
+		result[region.mOffsets[c] - firstOffset] = c;
+	return result;
+}
+
+// Adds the values [begin, end) of a row starting at the lowest channel offset, with \a channels from getChannelsByPosition()
+template<typename T>
+void accumulateValues( const T *row, int32_t begin, int32_t end, const std::vector<int32_t> &channels, RowSums<T> *sums )
+{
+	const int32_t inc = (int32_t)channels.size();
+	for( int32_t i = begin; i < end; ++i ) {
+		const int32_t c = channels[i % inc];
+		if( c >= 0 )
+			sums->add( c, row[i] );
+	}
+}
+
+// Adds a row of values, returning how many were added by SIMD, which treats a row of pixels as one run of values so that
+// lane i of each vector always holds the same channel. This requires the pixel increment to divide the number of lanes.
+template<typename T>
+int32_t accumulateSimd( const T *row, int32_t count, const std::vector<int32_t> &channels, RowSums<T> *sums )
+{
+	return 0;
+}
+
+#if defined( CI_STATISTICS_SSE2 )
+int32_t accumulateSimd( const uint8_t *row, int32_t count, const std::vector<int32_t> &channels, RowSums<uint8_t> *sums )
+{
+	const int32_t inc = (int32_t)channels.size();
+	if( 16 % inc != 0 || count < 16 )
+		return 0;
+
+	const __m128i zero = _mm_setzero_si128();
+	__m128i minValues = _mm_set1_epi8( (char)0xFF ), maxValues = zero;
+	uint64_t laneSums[16] = {}, laneSquares[16] = {};
+	const int32_t numVectors = count / 16;
+	// 32-bit sums of squares are flushed before they can overflow
+	const int32_t maxVectorsPerBlock = 32768;
+	for( int32_t block = 0; block < numVectors; block += maxVectorsPerBlock ) {
+		__m128i sum[4] = { zero, zero, zero, zero }, squares[4] = { zero, zero, zero, zero };
+		const int32_t blockEnd = std::min( block + maxVectorsPerBlock, numVectors );
+		for( int32_t v = block; v < blockEnd; ++v ) {
+			const __m128i values = _mm_loadu_si128( reinterpret_cast<const __m128i*>( row + v * 16 ) );
+			minValues = _mm_min_epu8( minValues, values );
+			maxValues = _mm_max_epu8( maxValues, values );
+			const __m128i low = _mm_unpacklo_epi8( values, zero ), high = _mm_unpackhi_epi8( values, zero );
+			const __m128i lowSquares = _mm_mullo_epi16( low, low ), highSquares = _mm_mullo_epi16( high, high );
+			sum[0] = _mm_add_epi32( sum[0], _mm_unpacklo_epi16( low, zero ) );
+			sum[1] = _mm_add_epi32( sum[1], _mm_unpackhi_epi16( low, zero ) );
+			sum[2] = _mm_add_epi32( sum[2], _mm_unpacklo_epi16( high, zero ) );
+			sum[3] = _mm_add_epi32( sum[3], _mm_unpackhi_epi16( high, zero ) );
+			squares[0] = _mm_add_epi32( squares[0], _mm_unpacklo_epi16( lowSquares, zero ) );
+			squares[1] = _mm_add_epi32( squares[1], _mm_unpackhi_epi16( lowSquares, zero ) );
+			squares[2] = _mm_add_epi32( squares[2], _mm_unpacklo_epi16( highSquares, zero ) );
+			squares[3] = _mm_add_epi32( squares[3], _mm_unpackhi_epi16( highSquares, zero ) );
+		}
+
+		uint32_t blockSums[16], blockSquares[16];
+		for( int i = 0; i < 4; ++i ) {
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( blockSums + i * 4 ), sum[i] );
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( blockSquares + i * 4 ), squares[i] );
+		}
+		for( int i = 0; i < 16; ++i ) {
+			laneSums[i] += blockSums[i];
+			laneSquares[i] += blockSquares[i];
+		}
+	}
+
+	uint8_t laneMin[16], laneMax[16];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( laneMin ), minValues );
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( laneMax ), maxValues );
+	for( int32_t i = 0; i < 16; ++i ) {
+		const int32_t c = channels[i % inc];
+		if( c < 0 )
+			continue;
+		sums->mMin[c] = std::min( sums->mMin[c], laneMin[i] );
+		sums->mMax[c] = std::max( sums->mMax[c], laneMax[i] );
+		sums->mSum[c] += laneSums[i];
+		sums->mSumSquares[c] += laneSquares[i];
+	}
+	return numVectors * 16;
+}
+
+int32_t accumulateSimd( const uint16_t *row, int32_t count, const std::vector<int32_t> &channels, RowSums<uint16_t> *sums )
+{
+	const int32_t inc = (int32_t)channels.size();
+	if( 8 % inc != 0 || count < 8 )
+		return 0;
+
+	// SSE2 only compares signed 16-bit values, so values are compared offset by 0x8000
+	const __m128i zero = _mm_setzero_si128(), sign = _mm_set1_epi16( (short)0x8000 );
+	__m128i minValues = _mm_set1_epi16( 0x7FFF ), maxValues = sign;
+	uint64_t laneSums[8] = {}, laneSquares[8] = {};
+	const int32_t numVectors = count / 8;
+	// 32-bit sums are flushed before they can overflow, and squares are summed in 64-bit
+	const int32_t maxVectorsPerBlock = 32768;
+	for( int32_t block = 0; block < numVectors; block += maxVectorsPerBlock ) {
+		__m128i sum[2] = { zero, zero }, squares[4] = { zero, zero, zero, zero };
+		const int32_t blockEnd = std::min( block + maxVectorsPerBlock, numVectors );
+		for( int32_t v = block; v < blockEnd; ++v ) {
+			const __m128i values = _mm_loadu_si128( reinterpret_cast<const __m128i*>( row + v * 8 ) );
+			const __m128i offsetValues = _mm_xor_si128( values, sign );
+			minValues = _mm_min_epi16( minValues, offsetValues );
+			maxValues = _mm_max_epi16( maxValues, offsetValues );
+			sum[0] = _mm_add_epi32( sum[0], _mm_unpacklo_epi16( values, zero ) );
+			sum[1] = _mm_add_epi32( sum[1], _mm_unpackhi_epi16( values, zero ) );
+			const __m128i low = _mm_mullo_epi16( values, values ), high = _mm_mulhi_epu16( values, values );
+			const __m128i squaresLow = _mm_unpacklo_epi16( low, high ), squaresHigh = _mm_unpackhi_epi16( low, high );
+			squares[0] = _mm_add_epi64( squares[0], _mm_unpacklo_epi32( squaresLow, zero ) );
+			squares[1] = _mm_add_epi64( squares[1], _mm_unpackhi_epi32( squaresLow, zero ) );
+			squares[2] = _mm_add_epi64( squares[2], _mm_unpacklo_epi32( squaresHigh, zero ) );
+			squares[3] = _mm_add_epi64( squares[3], _mm_unpackhi_epi32( squaresHigh, zero ) );
+		}
+
+		uint32_t blockSums[8];
+		uint64_t blockSquares[8];
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( blockSums ), sum[0] );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( blockSums + 4 ), sum[1] );
+		for( int i = 0; i < 4; ++i )
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( blockSquares + i * 2 ), squares[i] );
+		for( int i = 0; i < 8; ++i ) {
+			laneSums[i] += blockSums[i];
+			laneSquares[i] += blockSquares[i];
+		}
+	}
+
+	uint16_t laneMin[8], laneMax[8];
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( laneMin ), _mm_xor_si128( minValues, sign ) );
+	_mm_storeu_si128( reinterpret_cast<__m128i*>( laneMax ), _mm_xor_si128( maxValues, sign ) );
+	for( int32_t i = 0; i < 8; ++i ) {
+		const int32_t c = channels[i % inc];
+		if( c < 0 )
+			continue;
+		sums->mMin[c] = std::min( sums->mMin[c], laneMin[i] );
+		sums->mMax[c] = std::max( sums->mMax[c], laneMax[i] );
+		sums->mSum[c] += laneSums[i];
+		sums->mSumSquares[c] += laneSquares[i];
+	}
+	return numVectors * 8;
+}
+
+int32_t accumulateSimd( const float *row, int32_t count, const std::vector<int32_t> &channels, RowSums<float> *sums )
+{
+	const int32_t inc = (int32_t)channels.size();
+	if( 4 % inc != 0 || count < 4 )
+		return 0;
+
+	__m128 minValues = _mm_set1_ps( std::numeric_limits<float>::max() ), maxValues = _mm_set1_ps( std::numeric_limits<float>::lowest() );
+	// lanes 0 and 1 are summed in double by the low accumulators, 2 and 3 by the high
+	__m128d sumLow = _mm_setzero_pd(), sumHigh = _mm_setzero_pd(), squaresLow = _mm_setzero_pd(), squaresHigh = _mm_setzero_pd();
+	const int32_t numVectors = count / 4;
+	for( int32_t v = 0; v < numVectors; ++v ) {
+		const __m128 values = _mm_loadu_ps( row + v * 4 );
+		minValues = _mm_min_ps( minValues, values );
+		maxValues = _mm_max_ps( maxValues, values );
+		const __m128d low = _mm_cvtps_pd( values ), high = _mm_cvtps_pd( _mm_movehl_ps( values, values ) );
+		sumLow = _mm_add_pd( sumLow, low );
+		sumHigh = _mm_add_pd( sumHigh, high );
+		squaresLow = _mm_add_pd( squaresLow, _mm_mul_pd( low, low ) );
+		squaresHigh = _mm_add_pd( squaresHigh, _mm_mul_pd( high, high ) );
+	}
+
+	float laneMin[4], laneMax[4];
+	double laneSums[4], laneSquares[4];
+	_mm_storeu_ps( laneMin, minValues );
+	_mm_storeu_ps( laneMax, maxValues );
+	_mm_storeu_pd( laneSums, sumLow );
+	_mm_storeu_pd( laneSums + 2, sumHigh );
+	_mm_storeu_pd( laneSquares, squaresLow );
+	_mm_storeu_pd( laneSquares + 2, squaresHigh );
+	for( int32_t i = 0; i < 4; ++i ) {
+		const int32_t c = channels[i % inc];
+		if( c < 0 )
+			continue;
+		sums->mMin[c] = std::min( sums->mMin[c], laneMin[i] );
+		sums->mMax[c] = std::max( sums->mMax[c], laneMax[i] );
+		sums->mSum[c] += laneSums[i];
+		sums->mSumSquares[c] += laneSquares[i];
+	}
+	return numVectors * 4;
+}
+#endif
+
+template<typename T>
+Moments accumulateRows( const Region<T> &region, const std::vector<int32_t> &channels, size_t begin, size_t end )
+{
+	Moments result;
+	const int32_t width = region.getWidth();
+	const uint8_t firstOffset = *std::min_element( region.mOffsets, region.mOffsets + region.mNumChannels );
+	// the run of values from the first sampled channel of the first pixel to the last of the last pixel, so that it never reads past the row
+	int32_t lastPosition = 0;
+	for( int32_t i = 0; i < (int32_t)channels.size(); ++i ) {
+		if( channels[i] >= 0 )
+			lastPosition = i;
+	}
+	const int32_t count = ( width - 1 ) * region.mPixelInc + lastPosition + 1;
+	for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+		const T *row = region.getRow( y ) + firstOffset;
+		RowSums<T> sums;
+		const int32_t numSimd = accumulateSimd( row, count, channels, &sums );
+		accumulateValues( row, numSimd, count, channels, &sums );
+		sums.addTo( &result, region.mNumChannels );
+	}
+	result.mCount = (uint64_t)width * ( end - begin );
+	return result;
+}
+
+template<typename T>
+std::vector<Statistics> calcStatisticsImpl( const Region<T> &region, bool parallel )
+{
+	std::vector<Statistics> result( region.mNumChannels );
+	if( region.getWidth() <= 0 || region.getHeight() <= 0 )
+		return result;
+
+	const std::vector<int32_t> channels = getChannelsByPosition( region );
+	auto accumulateFn = [&]( size_t begin, size_t end ) { return accumulateRows( region, channels, begin, end ); };
+	Moments moments;
+	if( parallel ) {
+		moments = parallelReduce( region.getHeight(), std::max<size_t>( sMinPixelsPerTask / region.getWidth(), 1 ), Moments(), accumulateFn,
+			[]( Moments a, const Moments &b ) { a.merge( b ); return a; } );
+	}
+	else
+		moments = accumulateFn( 0, region.getHeight() );
+
+	for( int32_t c = 0; c < region.mNumChannels; ++c ) {
+		const double mean = moments.mSum[c] / moments.mCount;
+		const double variance = std::max( moments.mSumSquares[c] / moments.mCount - mean * mean, 0.0 );
+		result[c] = Statistics( moments.mMin[c], moments.mMax[c], mean, variance, moments.mCount );
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+template<typename T>
+Histogram calcHistogram( const ChannelT<T> &channel, const Area &area, const HistogramOptions &options )
+{
+	return calcHistogramsImpl( Region<T>( channel, area ), options ).front();
+}
+
+template<typename T>
+Histogram calcHistogram( const ChannelT<T> &channel, const HistogramOptions &options )
+{
+	return calcHistogram( channel, channel.getBounds(), options );
+}
+
+template<typename T>
+std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const Area &area, const HistogramOptions &options )
+{
+	return calcHistogramsImpl( Region<T>( surface, area ), options );
+}
+
+template<typename T>
+std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const HistogramOptions &options )
+{
+	return calcHistograms( surface, surface.getBounds(), options );
+}
+
+template<typename T>
+Statistics calcStatistics( const ChannelT<T> &channel, const Area &area, bool parallel )
+{
+	return calcStatisticsImpl( Region<T>( channel, area ), parallel ).front();
+}
+
+template<typename T>
+Statistics calcStatistics( const ChannelT<T> &channel, bool parallel )
+{
+	return calcStatistics( channel, channel.getBounds(), parallel );
+}
+
+template<typename T>
+std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, const Area &area, bool parallel )
+{
+	return calcStatisticsImpl( Region<T>( surface, area ), parallel );
+}
+
+template<typename T>
+std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, bool parallel )
+{
+	return calcStatistics( surface, surface.getBounds(), parallel );
+}
+
+float calcOtsuThreshold( const Histogram &histogram )
+{
+	// maximizes the variance between the classes, w0 * w1 * ( mean0 - mean1 )^2, using bin indices as values
+	const std::vector<uint32_t> &bins = histogram.getBins();
+	const double total = (double)histogram.getTotal();
+	double sumAll = 0;
+	for( size_t i = 0; i < bins.size(); ++i )
+		sumAll += (double)i * bins[i];
+
+	double count0 = 0, sum0 = 0, bestVariance = -1;
+	size_t bestBin = 0;
+	for( size_t i = 0; i + 1 < bins.size(); ++i ) {
+		count0 += bins[i];
+		sum0 += (double)i * bins[i];
+		const double count1 = total - count0;
+		if( count0 == 0 || count1 == 0 )
+			continue;
+		const double meanDifference = sum0 / count0 - ( sumAll - sum0 ) / count1;
+		const double variance = count0 * count1 * meanDifference * meanDifference;
+		if( variance > bestVariance ) {
+			bestVariance = variance;
+			bestBin = i;
+		}
+	}
+
+	return histogram.getBinValue( bestBin + 1 );
+}
+
+#define statistics_PROTOTYPES(T)\
+	template CI_API Histogram calcHistogram( const ChannelT<T> &channel, const Area &area, const HistogramOptions &options );\
+	template CI_API Histogram calcHistogram( const ChannelT<T> &channel, const HistogramOptions &options );\
+	template CI_API std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const Area &area, const HistogramOptions &options );\
+	template CI_API std::vector<Histogram> calcHistograms( const SurfaceT<T> &surface, const HistogramOptions &options );\
+	template CI_API Statistics calcStatistics( const ChannelT<T> &channel, const Area &area, bool parallel );\
+	template CI_API Statistics calcStatistics( const ChannelT<T> &channel, bool parallel );\
+	template CI_API std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, const Area &area, bool parallel );\
+	template CI_API std::vector<Statistics> calcStatistics( const SurfaceT<T> &surface, bool parallel );
+
+// These should match CHANNEL_TYPES
+statistics_PROTOTYPES(uint8_t)
+statistics_PROTOTYPES(uint16_t)
+statistics_PROTOTYPES(float)
+
+} } // namespace cinder::ip
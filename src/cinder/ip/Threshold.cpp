@@ -21,8 +21,11 @@
 */
 
 #include "cinder/ip/Threshold.h"
+#include "cinder/ip/Statistics.h"
 #include "cinder/ChanTraits.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdlib.h>
 
 namespace cinder { namespace ip {
@@ -323,6 +326,16 @@ void adaptiveThresholdZero( const ChannelT<T> &srcChannel, int32_t windowSize, C
 	free( integralImage );	
 }
 
+template<typename T>
+T thresholdOtsu( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel )
+{
+	const float edge = calcOtsuThreshold( calcHistogram( srcChannel ) );
+	// the lower class is the values below edge, which for integers are those up to the integer below it
+	const T value = std::is_integral<T>::value ? (T)std::max( std::ceil( edge ) - 1, 0.0f ) : (T)edge;
+	threshold( srcChannel, value, dstChannel );
+	return value;
+}
+
 template<typename T>
 AdaptiveThresholdT<T>::AdaptiveThresholdT( const ChannelT<T> *channel )
 	: mChannel( channel )
@@ -357,8 +370,11 @@ template class CI_API AdaptiveThresholdT<float>;
 	template CI_API void adaptiveThreshold( const ChannelT<T> &srcChannel, int32_t windowSize, float percentageDelta, ChannelT<T> *dstChannel ); \
 	template CI_API void adaptiveThreshold( ChannelT<T> *channel, int32_t windowSize, float percentageDelta ); \
 	template CI_API void adaptiveThresholdZero( ChannelT<T> *channel, int32_t windowSize ); \
-	template CI_API void adaptiveThresholdZero( const ChannelT<T> &srcChannel, int32_t windowSize, ChannelT<T> *dstChannel );
+	template CI_API void adaptiveThresholdZero( const ChannelT<T> &srcChannel, int32_t windowSize, ChannelT<T> *dstChannel );\
+	template CI_API T thresholdOtsu( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel );
 
 threshold_PROTOTYPES(uint8_t)
+template CI_API uint16_t thresholdOtsu( const ChannelT<uint16_t> &srcChannel, ChannelT<uint16_t> *dstChannel );
+template CI_API float thresholdOtsu( const ChannelT<float> &srcChannel, ChannelT<float> *dstChannel );
 
 } } // namespace cinder::ip
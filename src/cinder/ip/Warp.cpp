@@ -0,0 +1,575 @@
+/*
+ Copyright (c) 2026, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ip/Warp.h"
+#include "cinder/ChanTraits.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#include <emmintrin.h>
+	#define CI_WARP_SSE2
+#endif
+
+namespace cinder { namespace ip {
+
+namespace {
+
+const int32_t	sFractionBits = 8;
+const int32_t	sFractionScale = 1 << sFractionBits;
+const int32_t	sFractionMask = sFractionScale - 1;
+// Positions further than this from the origin, and NaN, are outside of any source
+const double	sMaxPosition = 1 << 22;
+// Minimum number of destination pixels sampled by each task of parallelFor()
+const size_t	sMinPixelsPerTask = 16384;
+
+ivec2 toFixed( double x, double y )
+{
+	auto toFixed = []( double v ) {
+		if( ! ( v > -sMaxPosition && v < sMaxPosition ) )
+			v = -sMaxPosition;
+		return (int32_t)std::floor( v * sFractionScale + 0.5 );
+	};
+	return ivec2( toFixed( x ), toFixed( y ) );
+}
+
+// Returns the index of the pixel read for \a i in a row or column of \a size pixels, or -1 for the constant border. Matches convolve().
+int32_t borderIndex( int32_t i, int32_t size, BorderMode mode )
+{
+	if( i >= 0 && i < size )
+		return i;
+
+	switch( mode ) {
+		case BorderMode::CLAMP:
+			return i < 0 ? 0 : size - 1;
+		case BorderMode::MIRROR: {
+			if( size == 1 )
+				return 0;
+			const int32_t period = 2 * ( size - 1 );
+			i %= period;
+			if( i < 0 )
+				i += period;
+			return i < size ? i : period - i;
+		}
+		case BorderMode::WRAP:
+			i %= size;
+			return i < 0 ? i + size : i;
+		default:
+			return -1;
+	}
+}
+
+template<typename T>
+T fromFloat( float value )
+{
+	return (T)std::min( std::max( value + 0.5f, 0.0f ), (float)CHANTRAIT<T>::max() );
+}
+
+template<>
+float fromFloat<float>( float value )
+{
+	return value;
+}
+
+// The channels of a Surface or Channel which are sampled
+template<typename T>
+struct Image {
+	Image( const ChannelT<T> *channel )
+		: mData( (uint8_t*)channel->getData() ), mRowBytes( channel->getRowBytes() ), mPixelInc( channel->getIncrement() ),
+		mWidth( channel->getWidth() ), mHeight( channel->getHeight() ), mNumChannels( 1 )
+	{
+		mOffsets[0] = 0;
+	}
+
+	Image( const SurfaceT<T> *surface, bool alpha )
+		: mData( (uint8_t*)surface->getData() ), mRowBytes( surface->getRowBytes() ), mPixelInc( surface->getPixelInc() ),
+		mWidth( surface->getWidth() ), mHeight( surface->getHeight() ), mNumChannels( alpha ? 4 : 3 )
+	{
+		mOffsets[0] = surface->getRedOffset();
+		mOffsets[1] = surface->getGreenOffset();
+		mOffsets[2] = surface->getBlueOffset();
+		mOffsets[3] = alpha ? surface->getAlphaOffset() : 0;
+	}
+
+	T*		getPixel( int32_t x, int32_t y ) const		{ return reinterpret_cast<T*>( mData + y * mRowBytes ) + x * mPixelInc; }
+	//! Returns whether every pixel is 4 consecutive channels stored in the same order as \a other's
+	bool	isPacked( const Image &other ) const		{ return mNumChannels == 4 && mPixelInc == 4 && other.mPixelInc == 4 && std::equal( mOffsets, mOffsets + 4, other.mOffsets ); }
+
+	uint8_t		*mData;
+	ptrdiff_t	mRowBytes;
+	uint8_t		mPixelInc;
+	int32_t		mWidth, mHeight;
+	int32_t		mNumChannels;
+	uint8_t		mOffsets[4];
+};
+
+struct Sampler {
+	Sampler( const WarpOptions &options )
+		: mInterpolation( options.getInterpolation() ), mBorderMode( options.getBorderMode() ), mBorderValue( options.getBorderValue() )
+	{
+		if( mInterpolation != Interpolation::BICUBIC )
+			return;
+
+		// the weights of the pixels at offsets -1, 0, 1 and 2 for each fraction
+		const FilterBase &filter = *options.getCubicFilter();
+		mCubicWeights.resize( sFractionScale );
+		for( int32_t i = 0; i < sFractionScale; ++i ) {
+			const float t = i / (float)sFractionScale;
+			std::array<float, 4> &weights = mCubicWeights[i];
+			weights = { filter( 1 + t ), filter( t ), filter( 1 - t ), filter( 2 - t ) };
+			const float sum = weights[0] + weights[1] + weights[2] + weights[3];
+			for( float &weight : weights )
+				weight = sum != 0 ? weight / sum : 0.25f;
+		}
+	}
+
+	Interpolation						mInterpolation;
+	BorderMode							mBorderMode;
+	float								mBorderValue;
+	std::vector<std::array<float, 4>>	mCubicWeights;
+};
+
+// Fills \a taps with \a size x \a size pixels starting at ( \a x, \a y ), with nullptr for the constant border
+template<typename T, int32_t size>
+void fetchTaps( const Image<T> &src, int32_t x, int32_t y, BorderMode mode, const T *taps[size][size] )
+{
+	if( x >= 0 && y >= 0 && x + size <= src.mWidth && y + size <= src.mHeight ) {
+		for( int32_t j = 0; j < size; ++j ) {
+			const T *row = src.getPixel( x, y + j );
+			for( int32_t i = 0; i < size; ++i )
+				taps[j][i] = row + i * src.mPixelInc;
+		}
+	}
+	else {
+		for( int32_t j = 0; j < size; ++j ) {
+			const int32_t sy = borderIndex( y + j, src.mHeight, mode );
+			for( int32_t i = 0; i < size; ++i ) {
+				const int32_t sx = borderIndex( x + i, src.mWidth, mode );
+				taps[j][i] = ( sx < 0 || sy < 0 ) ? nullptr : src.getPixel( sx, sy );
+			}
+		}
+	}
+}
+
+// 8-bit interpolates with 7-bit fractions, so that the weights fit in 16-bit and sum to 1 << 14
+inline void calcBilinearWeights( int32_t fx, int32_t fy, int32_t weights[4] )
+{
+	fx >>= 1;
+	fy >>= 1;
+	weights[0] = ( 128 - fx ) * ( 128 - fy );
+	weights[1] = fx * ( 128 - fy );
+	weights[2] = ( 128 - fx ) * fy;
+	weights[3] = fx * fy;
+}
+
+inline uint8_t bilinear( uint8_t a, uint8_t b, uint8_t c, uint8_t d, int32_t fx, int32_t fy )
+{
+	int32_t weights[4];
+	calcBilinearWeights( fx, fy, weights );
+	return (uint8_t)( ( a * weights[0] + b * weights[1] + c * weights[2] + d * weights[3] + ( 1 << 13 ) ) >> 14 );
+}
+
+template<typename T>
+T bilinear( T a, T b, T c, T d, int32_t fx, int32_t fy )
+{
+	const float wx = fx / (float)sFractionScale, wy = fy / (float)sFractionScale;
+	const float top = a + ( (float)b - a ) * wx, bottom = c + ( (float)d - c ) * wx;
+	return fromFloat<T>( top + ( bottom - top ) * wy );
+}
+
+template<typename T>
+void sampleNearest( const Image<T> &src, const Image<T> &dst, T *dstPixel, const ivec2 &position, const Sampler &sampler )
+{
+	const T *taps[1][1];
+	fetchTaps<T, 1>( src, ( position.x + sFractionScale / 2 ) >> sFractionBits, ( position.y + sFractionScale / 2 ) >> sFractionBits, sampler.mBorderMode, taps );
+	const T border = fromFloat<T>( sampler.mBorderValue );
+	for( int32_t c = 0; c < dst.mNumChannels; ++c )
+		dstPixel[dst.mOffsets[c]] = taps[0][0] ? taps[0][0][src.mOffsets[c]] : border;
+}
+
+template<typename T>
+void sampleBilinear( const Image<T> &src, const Image<T> &dst, T *dstPixel, const ivec2 &position, const Sampler &sampler )
+{
+	const T *taps[2][2];
+	fetchTaps<T, 2>( src, position.x >> sFractionBits, position.y >> sFractionBits, sampler.mBorderMode, taps );
+	const T border = fromFloat<T>( sampler.mBorderValue );
+	const int32_t fx = position.x & sFractionMask, fy = position.y & sFractionMask;
+	for( int32_t c = 0; c < dst.mNumChannels; ++c ) {
+		const uint8_t offset = src.mOffsets[c];
+		dstPixel[dst.mOffsets[c]] = bilinear( taps[0][0] ? taps[0][0][offset] : border, taps[0][1] ? taps[0][1][offset] : border,
+											taps[1][0] ? taps[1][0][offset] : border, taps[1][1] ? taps[1][1][offset] : border, fx, fy );
+	}
+}
+
+template<typename T>
+void sampleBicubic( const Image<T> &src, const Image<T> &dst, T *dstPixel, const ivec2 &position, const Sampler &sampler )
+{
+	const int32_t x = ( position.x >> sFractionBits ) - 1, y = ( position.y >> sFractionBits ) - 1;
+	const float *wx = sampler.mCubicWeights[position.x & sFractionMask].data(), *wy = sampler.mCubicWeights[position.y & sFractionMask].data();
+	if( x >= 0 && y >= 0 && x + 4 <= src.mWidth && y + 4 <= src.mHeight ) {
+		const T *rows[4] = { src.getPixel( x, y ), src.getPixel( x, y + 1 ), src.getPixel( x, y + 2 ), src.getPixel( x, y + 3 ) };
+		const int32_t inc = src.mPixelInc;
+		for( int32_t c = 0; c < dst.mNumChannels; ++c ) {
+			const uint8_t offset = src.mOffsets[c];
+			float sum = 0;
+			for( int32_t j = 0; j < 4; ++j ) {
+				const T *row = rows[j] + offset;
+				sum += wy[j] * ( wx[0] * row[0] + wx[1] * row[inc] + wx[2] * row[2 * inc] + wx[3] * row[3 * inc] );
+			}
+			dstPixel[dst.mOffsets[c]] = fromFloat<T>( sum );
+		}
+		return;
+	}
+
+	const T *taps[4][4];
+	fetchTaps<T, 4>( src, x, y, sampler.mBorderMode, taps );
+	for( int32_t c = 0; c < dst.mNumChannels; ++c ) {
+		const uint8_t offset = src.mOffsets[c];
+		float sum = 0;
+		for( int32_t j = 0; j < 4; ++j ) {
+			float row = 0;
+			for( int32_t i = 0; i < 4; ++i )
+				row += wx[i] * ( taps[j][i] ? (float)taps[j][i][offset] : sampler.mBorderValue );
+			sum += wy[j] * row;
+		}
+		dstPixel[dst.mOffsets[c]] = fromFloat<T>( sum );
+	}
+}
+
+template<typename T>
+void sampleRow( const Image<T> &src, const Image<T> &dst, int32_t y, int32_t width, const ivec2 *positions, const Sampler &sampler )
+{
+	T *dstPixel = dst.getPixel( 0, y );
+	switch( sampler.mInterpolation ) {
+		case Interpolation::NEAREST:
+			for( int32_t x = 0; x < width; ++x, dstPixel += dst.mPixelInc )
+				sampleNearest( src, dst, dstPixel, positions[x], sampler );
+		break;
+		case Interpolation::BILINEAR:
+			for( int32_t x = 0; x < width; ++x, dstPixel += dst.mPixelInc )
+				sampleBilinear( src, dst, dstPixel, positions[x], sampler );
+		break;
+		case Interpolation::BICUBIC:
+			for( int32_t x = 0; x < width; ++x, dstPixel += dst.mPixelInc )
+				sampleBicubic( src, dst, dstPixel, positions[x], sampler );
+		break;
+	}
+}
+
+// Interpolates all 4 channels of 8-bit pixels at once, reading the 2x2 pixels with scalar loads rather than gathers
+void sampleRow( const Image<uint8_t> &src, const Image<uint8_t> &dst, int32_t y, int32_t width, const ivec2 *positions, const Sampler &sampler )
+{
+#if defined( CI_WARP_SSE2 )
+	if( sampler.mInterpolation == Interpolation::BILINEAR && src.isPacked( dst ) ) {
+		const __m128i zero = _mm_setzero_si128(), round = _mm_set1_epi32( 1 << 13 );
+		auto load = []( const uint8_t *pixel ) { int32_t result; std::memcpy( &result, pixel, 4 ); return _mm_cvtsi32_si128( result ); };
+		uint8_t *dstPixel = dst.getPixel( 0, y );
+		for( int32_t x = 0; x < width; ++x, dstPixel += 4 ) {
+			const int32_t sx = positions[x].x >> sFractionBits, sy = positions[x].y >> sFractionBits;
+			if( sx < 0 || sy < 0 || sx + 1 >= src.mWidth || sy + 1 >= src.mHeight ) {
+				sampleBilinear( src, dst, dstPixel, positions[x], sampler );
+				continue;
+			}
+
+			int32_t weights[4];
+			calcBilinearWeights( positions[x].x & sFractionMask, positions[x].y & sFractionMask, weights );
+			const uint8_t *top = src.getPixel( sx, sy ), *bottom = top + src.mRowBytes;
+			// each channel of the left and right pixels interleaved as 16-bit, so that _mm_madd_epi16() weights both
+			const __m128i topPair = _mm_unpacklo_epi8( _mm_unpacklo_epi8( load( top ), load( top + 4 ) ), zero );
+			const __m128i bottomPair = _mm_unpacklo_epi8( _mm_unpacklo_epi8( load( bottom ), load( bottom + 4 ) ), zero );
+			__m128i sum = _mm_add_epi32( _mm_madd_epi16( topPair, _mm_set1_epi32( weights[0] | ( weights[1] << 16 ) ) ),
+										_mm_madd_epi16( bottomPair, _mm_set1_epi32( weights[2] | ( weights[3] << 16 ) ) ) );
+			sum = _mm_srli_epi32( _mm_add_epi32( sum, round ), 14 );
+			sum = _mm_packus_epi16( _mm_packs_epi32( sum, sum ), zero );
+			const int32_t result = _mm_cvtsi128_si32( sum );
+			std::memcpy( dstPixel, &result, 4 );
+		}
+		return;
+	}
+#endif
+
+	sampleRow<uint8_t>( src, dst, y, width, positions, sampler );
+}
+
+// Returns the source positions of row \a y of the destination, either from a WarpMap or calculated into \a buffer
+typedef std::function<const ivec2* ( int32_t y, ivec2 *buffer )> PositionsFn;
+
+template<typename T>
+void warpImage( const Image<T> &src, const Image<T> &dst, const ivec2 &size, const WarpOptions &options, const PositionsFn &positionsFn )
+{
+	const int32_t width = std::min( size.x, dst.mWidth ), height = std::min( size.y, dst.mHeight );
+	if( width <= 0 || height <= 0 )
+		return;
+
+	const Sampler sampler( options );
+	auto sampleRows = [&]( size_t begin, size_t end ) {
+		std::vector<ivec2> buffer( width );
+		for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y )
+			sampleRow( src, dst, y, width, positionsFn( y, buffer.data() ), sampler );
+	};
+
+	if( options.isParallel() )
+		parallelFor( height, std::max<size_t>( sMinPixelsPerTask / width, 1 ), sampleRows );
+	else
+		sampleRows( 0, height );
+}
+
+PositionsFn makeMapPositionsFn( const WarpMap &map )
+{
+	return [&map]( int32_t y, ivec2 * ) { return map.getFixedPositions().data() + y * map.getSize().x; };
+}
+
+// Positions are calculated in double so that they don't drift across large destinations
+PositionsFn makeAffinePositionsFn( const mat3 &transform, int32_t width )
+{
+	glm::dmat3 affine( transform );
+	affine[0][2] = 0;
+	affine[1][2] = 0;
+	affine[2][2] = 1;
+	const glm::dmat3 inverse = glm::inverse( affine );
+	return [inverse, width]( int32_t y, ivec2 *buffer ) {
+		const glm::dvec3 start = inverse[1] * (double)y + inverse[2];
+		for( int32_t x = 0; x < width; ++x ) {
+			const glm::dvec3 position = start + inverse[0] * (double)x;
+			buffer[x] = toFixed( position.x, position.y );
+		}
+		return (const ivec2*)buffer;
+	};
+}
+
+PositionsFn makePerspectivePositionsFn( const mat3 &transform, int32_t width )
+{
+	const glm::dmat3 inverse = glm::inverse( glm::dmat3( transform ) );
+	return [inverse, width]( int32_t y, ivec2 *buffer ) {
+		const glm::dvec3 start = inverse[1] * (double)y + inverse[2];
+		for( int32_t x = 0; x < width; ++x ) {
+			const glm::dvec3 position = start + inverse[0] * (double)x;
+			// positions on the horizon are outside of the source
+			const double w = std::abs( position.z ) > 1e-12 ? 1 / position.z : 0;
+			buffer[x] = w != 0 ? toFixed( position.x * w, position.y * w ) : toFixed( NAN, NAN );
+		}
+		return (const ivec2*)buffer;
+	};
+}
+
+template<typename T>
+void warpSurface( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const ivec2 &size, const WarpOptions &options, const PositionsFn &positionsFn )
+{
+	const bool alpha = srcSurface.hasAlpha() && dstSurface->hasAlpha();
+	warpImage( Image<T>( &srcSurface, alpha ), Image<T>( dstSurface, alpha ), size, options, positionsFn );
+}
+
+template<typename T>
+void warpChannel( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const ivec2 &size, const WarpOptions &options, const PositionsFn &positionsFn )
+{
+	warpImage( Image<T>( &srcChannel ), Image<T>( dstChannel ), size, options, positionsFn );
+}
+
+} // anonymous namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// WarpMap
+WarpMap::WarpMap( const ivec2 &size )
+	: mSize( glm::max( size, ivec2( 0 ) ) ), mPositions( (size_t)mSize.x * mSize.y )
+{
+}
+
+WarpMap WarpMap::affine( const mat3 &transform, const ivec2 &dstSize )
+{
+	WarpMap result( dstSize );
+	const PositionsFn positionsFn = makeAffinePositionsFn( transform, result.mSize.x );
+	parallelFor( result.mSize.y, std::max<size_t>( sMinPixelsPerTask / std::max( result.mSize.x, 1 ), 1 ), [&]( size_t begin, size_t end ) {
+		for( size_t y = begin; y < end; ++y )
+			positionsFn( (int32_t)y, &result.mPositions[y * result.mSize.x] );
+	} );
+	return result;
+}
+
+WarpMap WarpMap::perspective( const mat3 &transform, const ivec2 &dstSize )
+{
+	WarpMap result( dstSize );
+	const PositionsFn positionsFn = makePerspectivePositionsFn( transform, result.mSize.x );
+	parallelFor( result.mSize.y, std::max<size_t>( sMinPixelsPerTask / std::max( result.mSize.x, 1 ), 1 ), [&]( size_t begin, size_t end ) {
+		for( size_t y = begin; y < end; ++y )
+			positionsFn( (int32_t)y, &result.mPositions[y * result.mSize.x] );
+	} );
+	return result;
+}
+
+WarpMap WarpMap::positions( const Channel32f &mapX, const Channel32f &mapY )
+{
+	if( mapX.getSize() != mapY.getSize() )
+		throw WarpExc( "WarpMap::positions() requires Channels of the same size" );
+
+	WarpMap result( mapX.getSize() );
+	for( int32_t y = 0; y < result.mSize.y; ++y ) {
+		const float *xLine = mapX.getData( 0, y ), *yLine = mapY.getData( 0, y );
+		ivec2 *positions = &result.mPositions[y * result.mSize.x];
+		for( int32_t x = 0; x < result.mSize.x; ++x )
+			positions[x] = toFixed( xLine[x * mapX.getIncrement()], yLine[x * mapY.getIncrement()] );
+	}
+	return result;
+}
+
+WarpMap WarpMap::function( const ivec2 &dstSize, const std::function<vec2 ( const ivec2 &dstPosition )> &fn )
+{
+	WarpMap result( dstSize );
+	parallelFor( result.mSize.y, std::max<size_t>( sMinPixelsPerTask / std::max( result.mSize.x, 1 ), 1 ), [&]( size_t begin, size_t end ) {
+		for( int32_t y = (int32_t)begin; y < (int32_t)end; ++y ) {
+			for( int32_t x = 0; x < result.mSize.x; ++x ) {
+				const vec2 position = fn( ivec2( x, y ) );
+				result.mPositions[y * result.mSize.x + x] = toFixed( position.x, position.y );
+			}
+		}
+	} );
+	return result;
+}
+
+vec2 WarpMap::getPosition( const ivec2 &dstPosition ) const
+{
+	return vec2( mPositions.at( dstPosition.y * mSize.x + dstPosition.x ) ) / (float)sFractionScale;
+}
+
+void WarpMap::setPosition( const ivec2 &dstPosition, const vec2 &srcPosition )
+{
+	mPositions.at( dstPosition.y * mSize.x + dstPosition.x ) = toFixed( srcPosition.x, srcPosition.y );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// remap(), warpAffine() and warpPerspective()
+template<typename T>
+void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const WarpMap &map, const WarpOptions &options )
+{
+	warpSurface( srcSurface, dstSurface, map.getSize(), options, makeMapPositionsFn( map ) );
+}
+
+template<typename T>
+void remap( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const WarpMap &map, const WarpOptions &options )
+{
+	warpChannel( srcChannel, dstChannel, map.getSize(), options, makeMapPositionsFn( map ) );
+}
+
+template<typename T>
+void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Channel32f &mapX, const Channel32f &mapY, const WarpOptions &options )
+{
+	remap( srcSurface, dstSurface, WarpMap::positions( mapX, mapY ), options );
+}
+
+template<typename T>
+void warpAffine( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options )
+{
+	warpSurface( srcSurface, dstSurface, dstSurface->getSize(), options, makeAffinePositionsFn( transform, dstSurface->getWidth() ) );
+}
+
+template<typename T>
+void warpAffine( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options )
+{
+	warpChannel( srcChannel, dstChannel, dstChannel->getSize(), options, makeAffinePositionsFn( transform, dstChannel->getWidth() ) );
+}
+
+template<typename T>
+void warpPerspective( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options )
+{
+	warpSurface( srcSurface, dstSurface, dstSurface->getSize(), options, makePerspectivePositionsFn( transform, dstSurface->getWidth() ) );
+}
+
+template<typename T>
+void warpPerspective( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options )
+{
+	warpChannel( srcChannel, dstChannel, dstChannel->getSize(), options, makePerspectivePositionsFn( transform, dstChannel->getWidth() ) );
+}
+
+namespace {
+
+bool hasCollinearCorners( const std::array<vec2, 4> &quad )
+{
+	double scale = 0;
+	for( const vec2 &corner : quad )
+		scale = std::max( scale, (double)glm::length( corner - quad[0] ) );
+	for( int i = 0; i < 4; ++i ) {
+		const dvec2 a( quad[i] ), b( quad[( i + 1 ) % 4] ), c( quad[( i + 2 ) % 4] );
+		const double cross = ( b.x - a.x ) * ( c.y - a.y ) - ( b.y - a.y ) * ( c.x - a.x );
+		if( std::abs( cross ) <= scale * scale * 1e-9 )
+			return true;
+	}
+	return false;
+}
+
+} // anonymous namespace
+
+mat3 calcPerspectiveTransform( const std::array<vec2, 4> &srcQuad, const std::array<vec2, 4> &dstQuad )
+{
+	if( hasCollinearCorners( srcQuad ) || hasCollinearCorners( dstQuad ) )
+		throw WarpExc( "calcPerspectiveTransform() requires quads without three collinear corners" );
+
+	// solves for the 8 unknowns of the transform, with the bottom right fixed at 1, by Gaussian elimination
+	double m[8][9];
+	for( int i = 0; i < 4; ++i ) {
+		const double x = srcQuad[i].x, y = srcQuad[i].y, u = dstQuad[i].x, v = dstQuad[i].y;
+		const double rowU[9] = { x, y, 1, 0, 0, 0, -x * u, -y * u, u };
+		const double rowV[9] = { 0, 0, 0, x, y, 1, -x * v, -y * v, v };
+		std::copy( rowU, rowU + 9, m[i * 2] );
+		std::copy( rowV, rowV + 9, m[i * 2 + 1] );
+	}
+
+	for( int col = 0; col < 8; ++col ) {
+		int pivot = col;
+		for( int row = col + 1; row < 8; ++row ) {
+			if( std::abs( m[row][col] ) > std::abs( m[pivot][col] ) )
+				pivot = row;
+		}
+		std::swap( m[col], m[pivot] );
+		for( int row = 0; row < 8; ++row ) {
+			if( row == col )
+				continue;
+			const double factor = m[row][col] / m[col][col];
+			for( int i = col; i < 9; ++i )
+				m[row][i] -= factor * m[col][i];
+		}
+	}
+
+	double h[8];
+	for( int i = 0; i < 8; ++i )
+		h[i] = m[i][8] / m[i][i];
+	// glm matrices are column major
+	return mat3( (float)h[0], (float)h[3], (float)h[6], (float)h[1], (float)h[4], (float)h[7], (float)h[2], (float)h[5], 1.0f );
+}
+
+#define warp_PROTOTYPES(T)\
+	template CI_API void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const WarpMap &map, const WarpOptions &options );\
+	template CI_API void remap( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const WarpMap &map, const WarpOptions &options );\
+	template CI_API void remap( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const Channel32f &mapX, const Channel32f &mapY, const WarpOptions &options );\
+	template CI_API void warpAffine( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options );\
+	template CI_API void warpAffine( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options );\
+	template CI_API void warpPerspective( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const mat3 &transform, const WarpOptions &options );\
+	template CI_API void warpPerspective( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const mat3 &transform, const WarpOptions &options );
+
+// These should match CHANNEL_TYPES
+warp_PROTOTYPES(uint8_t)
+warp_PROTOTYPES(uint16_t)
+warp_PROTOTYPES(float)
+
+} } // namespace cinder::ip
@@ -0,0 +1,292 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/linux/GlyphCache.h"
+
+#include <cstring>
+
+namespace cinder { namespace linux { namespace ftutil {
+
+namespace {
+
+const size_t kMaxAdvances = 65536;
+const size_t kMaxKerningPairs = 65536;
+
+inline void hashCombine( size_t &seed, size_t value )
+{
+	seed ^= value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+}
+
+} // anonymous namespace
+
+bool GlyphCache::GlyphKey::operator==( const GlyphKey &rhs ) const
+{
+	return mFace == rhs.mFace && mScaleX == rhs.mScaleX && mScaleY == rhs.mScaleY && mGlyphIndex == rhs.mGlyphIndex
+		&& mSubpixelX == rhs.mSubpixelX && mSubpixelY == rhs.mSubpixelY;
+}
+
+bool GlyphCache::KerningKey::operator==( const KerningKey &rhs ) const
+{
+	return mFace == rhs.mFace && mScaleX == rhs.mScaleX && mLeftGlyph == rhs.mLeftGlyph && mRightGlyph == rhs.mRightGlyph;
+}
+
+size_t GlyphCache::KeyHash::operator()( const GlyphKey &key ) const
+{
+	size_t result = std::hash<const void*>()( key.mFace );
+	hashCombine( result, std::hash<FT_Fixed>()( key.mScaleX ) );
+	hashCombine( result, std::hash<FT_Fixed>()( key.mScaleY ) );
+	hashCombine( result, key.mGlyphIndex );
+	hashCombine( result, ( key.mSubpixelX << 8 ) | key.mSubpixelY );
+	return result;
+}
+
+size_t GlyphCache::KeyHash::operator()( const KerningKey &key ) const
+{
+	size_t result = std::hash<const void*>()( key.mFace );
+	hashCombine( result, std::hash<FT_Fixed>()( key.mScaleX ) );
+	hashCombine( result, key.mLeftGlyph );
+	hashCombine( result, key.mRightGlyph );
+	return result;
+}
+
+GlyphCache& GlyphCache::instance()
+{
+	// Leaked, as Fonts held by other statics may be released after a static cache would've been destroyed.
+	static GlyphCache *sInstance = new GlyphCache;
+	return *sInstance;
+}
+
+GlyphCache::GlyphCache()
+	: mMaxBytes( 16 * 1024 * 1024 ), mNumBytes( 0 ), mNumHits( 0 ), mNumMisses( 0 )
+{
+}
+
+CachedGlyphRef GlyphCache::getGlyph( FT_Face face, FT_UInt glyphIndex, const FT_Vector &pen )
+{
+	if( ! face || ! face->size )
+		return nullptr;
+
+	// Only the fraction of the pen affects the rendered coverage, the integer part just offsets it.
+	const FT_Vector subpixel = { pen.x & 63, pen.y & 63 };
+	const GlyphKey key = { face, face->size->metrics.x_scale, face->size->metrics.y_scale, glyphIndex, (uint8_t)subpixel.x, (uint8_t)subpixel.y };
+
+	std::lock_guard<std::mutex> lock( mMutex );
+	auto glyphIt = mGlyphMap.find( key );
+	if( glyphIt != mGlyphMap.end() ) {
+		++mNumHits;
+		mGlyphs.splice( mGlyphs.begin(), mGlyphs, glyphIt->second );
+		return glyphIt->second->second;
+	}
+
+	// FreeType faces aren't thread-safe, so rendering stays under the lock
+	++mNumMisses;
+	CachedGlyphRef glyph = renderGlyph( face, glyphIndex, subpixel );
+	if( ! glyph || mMaxBytes == 0 )
+		return glyph;
+
+	mGlyphs.emplace_front( key, glyph );
+	mGlyphMap[key] = mGlyphs.begin();
+	mNumBytes += calcNumBytes( *glyph );
+	evict();
+
+	return glyph;
+}
+
+FT_Vector GlyphCache::getAdvance( FT_Face face, FT_UInt glyphIndex )
+{
+	FT_Vector result = { 0, 0 };
+	if( ! face || ! face->size )
+		return result;
+
+	const GlyphKey key = { face, face->size->metrics.x_scale, face->size->metrics.y_scale, glyphIndex, 0, 0 };
+
+	std::lock_guard<std::mutex> lock( mMutex );
+	auto advanceIt = mAdvances.find( key );
+	if( advanceIt != mAdvances.end() ) {
+		++mNumHits;
+		return advanceIt->second;
+	}
+
+	++mNumMisses;
+	if( FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT ) )
+		return result;
+	result = face->glyph->advance;
+
+	if( mMaxBytes > 0 ) {
+		if( mAdvances.size() >= kMaxAdvances )
+			mAdvances.clear();
+		mAdvances[key] = result;
+	}
+
+	return result;
+}
+
+FT_Vector GlyphCache::getKerning( FT_Face face, FT_UInt leftGlyph, FT_UInt rightGlyph )
+{
+	FT_Vector result = { 0, 0 };
+	if( ! face || ! face->size || ! FT_HAS_KERNING( face ) )
+		return result;
+
+	const KerningKey key = { face, face->size->metrics.x_scale, leftGlyph, rightGlyph };
+
+	std::lock_guard<std::mutex> lock( mMutex );
+	auto kerningIt = mKerning.find( key );
+	if( kerningIt != mKerning.end() )
+		return kerningIt->second;
+
+	if( FT_Get_Kerning( face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &result ) )
+		result.x = result.y = 0;
+
+	if( mMaxBytes > 0 ) {
+		if( mKerning.size() >= kMaxKerningPairs )
+			mKerning.clear();
+		mKerning[key] = result;
+	}
+
+	return result;
+}
+
+void GlyphCache::removeFace( FT_Face face )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	for( auto glyphIt = mGlyphs.begin(); glyphIt != mGlyphs.end(); ) {
+		if( glyphIt->first.mFace == face ) {
+			mNumBytes -= calcNumBytes( *glyphIt->second );
+			mGlyphMap.erase( glyphIt->first );
+			glyphIt = mGlyphs.erase( glyphIt );
+		}
+		else
+			++glyphIt;
+	}
+
+	for( auto advanceIt = mAdvances.begin(); advanceIt != mAdvances.end(); ) {
+		if( advanceIt->first.mFace == face )
+			advanceIt = mAdvances.erase( advanceIt );
+		else
+			++advanceIt;
+	}
+
+	for( auto kerningIt = mKerning.begin(); kerningIt != mKerning.end(); ) {
+		if( kerningIt->first.mFace == face )
+			kerningIt = mKerning.erase( kerningIt );
+		else
+			++kerningIt;
+	}
+}
+
+void GlyphCache::clear()
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	mGlyphs.clear();
+	mGlyphMap.clear();
+	mAdvances.clear();
+	mKerning.clear();
+	mNumBytes = 0;
+}
+
+void GlyphCache::setMaxBytes( size_t maxBytes )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	mMaxBytes = maxBytes;
+	evict();
+	if( mMaxBytes == 0 ) {
+		mAdvances.clear();
+		mKerning.clear();
+	}
+}
+
+size_t GlyphCache::getMaxBytes() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mMaxBytes;
+}
+
+size_t GlyphCache::getNumBytes() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mNumBytes + mAdvances.size() * ( sizeof( GlyphKey ) + sizeof( FT_Vector ) ) + mKerning.size() * ( sizeof( KerningKey ) + sizeof( FT_Vector ) );
+}
+
+size_t GlyphCache::getNumGlyphs() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mGlyphs.size();
+}
+
+size_t GlyphCache::getNumHits() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mNumHits;
+}
+
+size_t GlyphCache::getNumMisses() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mNumMisses;
+}
+
+CachedGlyphRef GlyphCache::renderGlyph( FT_Face face, FT_UInt glyphIndex, const FT_Vector &subpixel )
+{
+	FT_Vector delta = subpixel;
+	FT_Set_Transform( face, nullptr, &delta );
+	FT_Error error = FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
+	FT_Set_Transform( face, nullptr, nullptr );
+	if( error )
+		return nullptr;
+
+	const FT_GlyphSlot slot = face->glyph;
+	auto result = std::make_shared<CachedGlyph>();
+	result->mMetrics = slot->metrics;
+	result->mAdvance = slot->advance;
+	result->mBitmapLeft = slot->bitmap_left;
+	result->mBitmapTop = slot->bitmap_top;
+
+	// Rows are copied tightly packed, as the pitch FreeType renders with may be padded or negative.
+	const FT_Bitmap &bitmap = slot->bitmap;
+	result->mCoverage.resize( (size_t)bitmap.width * bitmap.rows );
+	for( unsigned int row = 0; row < bitmap.rows; ++row )
+		memcpy( &result->mCoverage[row * bitmap.width], bitmap.buffer + (ptrdiff_t)row * bitmap.pitch, bitmap.width );
+
+	result->mBitmap = bitmap;
+	result->mBitmap.pitch = (int)bitmap.width;
+	result->mBitmap.buffer = result->mCoverage.empty() ? nullptr : result->mCoverage.data();
+
+	return result;
+}
+
+size_t GlyphCache::calcNumBytes( const CachedGlyph &glyph )
+{
+	// roughly accounts for the list node and the map entry as well
+	return sizeof( CachedGlyph ) + glyph.mCoverage.size() + 64;
+}
+
+void GlyphCache::evict()
+{
+	while( mNumBytes > mMaxBytes && ! mGlyphs.empty() ) {
+		mNumBytes -= calcNumBytes( *mGlyphs.back().second );
+		mGlyphMap.erase( mGlyphs.back().first );
+		mGlyphs.pop_back();
+	}
+}
+
+}}} // namespace cinder::linux::ftutil
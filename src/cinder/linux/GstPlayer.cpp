@@ -5,6 +5,9 @@
 #endif
 
 #include "cinder/linux/GstPlayer.h"
+#if defined( CINDER_LINUX )
+	#include "cinder/linux/MovieManager.h"
+#endif
 
 #if defined( CINDER_GST_HAS_GL ) && defined( CINDER_LINUX )
 	#if ! defined( CINDER_LINUX_EGL_ONLY )
@@ -18,6 +21,7 @@
 #include "cinder/app/AppBase.h"
 #include "cinder/Log.h"
 #include "cinder/gl/Environment.h"
+#include <algorithm>
 #include <chrono>
 
 namespace gst { namespace video {
@@ -62,6 +66,8 @@ GstData::GstData()
 , fpsNom( -1 )
 , fpsDenom( -1 )
 , pixelAspectRatio( 0.0f )
+, sinkFramesDropped( 0 )
+, decoderFramesDropped( 0 )
 , player( nullptr )
 {
 }
@@ -102,6 +108,8 @@ void GstData::prepareForNewVideo()
 	pixelAspectRatio	= 0.0f;
 	loop				= false;
 	palindrome			= false;
+	sinkFramesDropped	= 0;
+	decoderFramesDropped = 0;
 }
 
 void GstData::updateState( const GstState& current )
@@ -258,6 +266,20 @@ gboolean checkBusMessagesAsync( GstBus* bus, GstMessage* message, gpointer userD
 			break;
 		}
 
+		case GST_MESSAGE_QOS: {
+			// The counts are totals for the element which dropped the frames.
+			GstFormat format = GST_FORMAT_UNDEFINED;
+			guint64 processed = 0, dropped = 0;
+			gst_message_parse_qos_stats( message, &format, &processed, &dropped );
+			if( format == GST_FORMAT_BUFFERS && dropped != (guint64)-1 ) {
+				if( GST_MESSAGE_SRC( message ) == GST_OBJECT( data.appSink ) )
+					data.sinkFramesDropped = dropped;
+				else
+					data.decoderFramesDropped = dropped;
+			}
+			break;
+		}
+
 		case GST_MESSAGE_STATE_CHANGED: {
 			if( GST_MESSAGE_SRC( message ) == GST_OBJECT( data.pipeline ) ) {
 
@@ -327,16 +349,35 @@ gboolean checkBusMessagesAsync( GstBus* bus, GstMessage* message, gpointer userD
 }
 
 GstPlayer::GstPlayer()
-: mGMainLoop( nullptr )
-, mGstBus( nullptr )
+: mGstBus( nullptr )
+, mRegistered( false )
+#if ! defined( CINDER_LINUX )
+, mGMainLoop( nullptr )
+#endif
 , mNewFrame( false )
 , mUsingCustomPipeline( false )
+, mSurfaceOutput( false )
+, mSurfaceRealtime( true )
+, mNumSurfaceBuffers( 1 )
+, mFrameBytes( 0 )
+, mMaxQueuedFrames( 1 )
+, mAppliedMaxQueuedFrames( 0 )
+, mNumFramesDecoded( 0 )
+, mDecodeLatency( 0 )
+, mMaxDecodeLatency( 0 )
 {
 	bool success = initializeGStreamer();
+	mUseGl = sUseGstGl;
 
 	if( success ) {
 		mGstData.player = this;
+#if defined( CINDER_LINUX )
+		// Also starts the thread which handles the bus messages of every player.
+		cinder::linux::MovieManager::instance().addPlayer( this );
+		mRegistered = true;
+#else
 		startGMainLoopThread();
+#endif
 	}
 }
 
@@ -355,6 +396,12 @@ void GstPlayer::cleanup()
 
 	resetVideoBuffers();
 
+#if defined( CINDER_LINUX )
+	if( mRegistered ) {
+		cinder::linux::MovieManager::instance().removePlayer( this );
+		mRegistered = false;
+	}
+#else
 	if( g_main_loop_is_running( mGMainLoop ) ) {
 		g_main_loop_quit( mGMainLoop );
 	}
@@ -363,8 +410,10 @@ void GstPlayer::cleanup()
 	if( mGMainLoopThread.joinable() ){
 		mGMainLoopThread.join();
 	}
+#endif
 }
 
+#if ! defined( CINDER_LINUX )
 void GstPlayer::startGMainLoopThread()
 {
 	mGMainLoop = g_main_loop_new( nullptr, false );
@@ -375,6 +424,7 @@ void GstPlayer::startGMainLoop( GMainLoop* loop )
 {
 	g_main_loop_run( loop );
 }
+#endif
 
 bool GstPlayer::initializeGStreamer()
 {
@@ -424,7 +474,7 @@ void GstPlayer::resetPipeline()
 	mGstData.pipeline = nullptr;
 
 	mGstData.videoBin = nullptr;
-	if( sUseGstGl ) {
+	if( mUseGl ) {
 #if defined( CINDER_GST_HAS_GL )
 		// Pipeline will unref and destroy its children..
 		mGstData.glupload = nullptr;
@@ -481,12 +531,19 @@ void GstPlayer::setCustomPipeline( const GstCustomPipelineData &customPipeline )
 		appSinkCallbacks.new_sample		= onGstSample;
 
 		gst_app_sink_set_callbacks( GST_APP_SINK( mGstData.appSink ), &appSinkCallbacks, this, 0 );
+
+		if( mSurfaceOutput ) {
+			configureSurfaceAppSink();
+		}
 	}
 
+	addStatsProbes();
+
 	mUsingCustomPipeline = true;
 
 	// Reset the buffers for the next pre-roll.
 	resetVideoBuffers();
+	resetStats();
 
 	// async pre-roll
 	gst_element_set_state( mGstData.pipeline, GST_STATE_PAUSED );
@@ -503,7 +560,7 @@ void GstPlayer::addBusWatch( GstElement* pipeline )
 bool GstPlayer::initialize()
 {
 #if defined( CINDER_GST_HAS_GL )
-	if( sUseGstGl ) {
+	if( mUseGl ) {
 		GstGLContext* sharedCtx = nullptr;
 		GError* err = nullptr;
 #if defined( CINDER_LINUX )
@@ -620,7 +677,7 @@ void GstPlayer::constructPipeline()
 		appSinkCallbacks.new_sample		= onGstSample;
 
 		std::string capsDescr = "video/x-raw(memory:GLMemory), format=RGBA";
-		if( ! sUseGstGl ) {
+		if( ! mUseGl ) {
 			capsDescr = "video/x-raw, format=RGBA";
 		}
 
@@ -632,7 +689,7 @@ void GstPlayer::constructPipeline()
 
 	GstPad *pad = nullptr;
 
-	if( sUseGstGl ) {
+	if( mUseGl ) {
 #if defined( CINDER_GST_HAS_GL )
 		mGstData.glupload			= gst_element_factory_make( "glupload", "upload" );
 		if( ! mGstData.glupload ) CI_LOG_E( "Failed to create GL upload element!" );
@@ -682,8 +739,22 @@ void GstPlayer::constructPipeline()
 		pad = nullptr;
 	}
 
+	if( mSurfaceOutput ) {
+		configureSurfaceAppSink();
+
+		// Audio would otherwise pace playback to the clock.
+		if( ! mSurfaceRealtime ) {
+			GstElement* audioSink = gst_element_factory_make( "fakesink", "audiosink" );
+			if( audioSink ) {
+				g_object_set( G_OBJECT( audioSink ), "sync", FALSE, nullptr );
+				g_object_set( G_OBJECT( mGstData.pipeline ), "audio-sink", audioSink, nullptr );
+			}
+		}
+	}
+
 	g_object_set( G_OBJECT( mGstData.pipeline ), "video-sink", mGstData.videoBin, nullptr );
 
+	addStatsProbes();
 	addBusWatch( mGstData.pipeline );
 }
 
@@ -704,6 +775,7 @@ void GstPlayer::load( const std::string& path )
 
 	// Reset the buffers after we have reached GST_STATE_READY.
 	resetVideoBuffers();
+	resetStats();
 
 	std::string uriPath;
 	if( path.find( "://", 0 ) == std::string::npos ) {
@@ -914,6 +986,9 @@ void GstPlayer::seekToTime( float seconds, bool forceSeek )
 
 	mGstData.isSeeking	= true;
 	mGstData.isDone		= false;
+	// So that waitForNewFrame() waits for the frame at the new position.
+	if( mSurfaceOutput )
+		mNewFrame = false;
 	// When doing flushing seeks the pipeline will pre-roll
 	// which means that we might be in a GST_STATE_CHANGE_ASYNC when we request the seek ( ..when fast-seeking ).
 	// If thats the case then we should wait for GST_MESSAGE_ASYNC_DONE before executing the
@@ -940,6 +1015,9 @@ void GstPlayer::seekToFrame( int frame )
 
 bool GstPlayer::stepForward()
 {
+	if( mSurfaceOutput )
+		mNewFrame = false;
+
 	bool handled = gst_element_send_event( mGstData.pipeline, gst_event_new_step ( GST_FORMAT_BUFFERS, 1, getRate(), TRUE, FALSE ) );
 	return handled;
 }
@@ -1131,7 +1209,7 @@ GLint GstPlayer::getTextureID( GstBuffer* newBuffer )
 ci::gl::Texture2dRef GstPlayer::getVideoTexture()
 {
 	if( mNewFrame ){
-		if( ! sUseGstGl ) {
+		if( ! mUseGl ) {
 			createTextureFromMemory();
 		}
 		else {
@@ -1144,7 +1222,7 @@ ci::gl::Texture2dRef GstPlayer::getVideoTexture()
 
 void GstPlayer::resetVideoBuffers()
 {
-	if( sUseGstGl ) {
+	if( mUseGl ) {
 		resetGLBuffers();
 	}
 	else {
@@ -1175,16 +1253,395 @@ void GstPlayer::resetSystemMemoryBuffers()
 	if( mBackVBuffer ) {
 		mBackVBuffer.reset();
 	}
+
+	// Surfaces already handed out keep their own reference to the sample.
+	mCurrentSample.reset();
 }
 
 void GstPlayer::onGstEos( GstAppSink* sink, gpointer userData )
 {
 }
 
+void GstPlayer::setSurfaceOutput( bool realtime, size_t numBuffers )
+{
+	mSurfaceOutput		= true;
+	mSurfaceRealtime	= realtime;
+	mNumSurfaceBuffers	= std::max<size_t>( numBuffers, 1 );
+	mUseGl				= false;
+}
+
+void GstPlayer::configureSurfaceAppSink()
+{
+	if( ! mGstData.appSink )
+		return;
+
+	GstAppSink* appSink = GST_APP_SINK( mGstData.appSink );
+
+	// In realtime only the latest frame matters, otherwise the queue holding up the decoder is what paces it.
+	mAppliedMaxQueuedFrames = getMaxQueuedFrames();
+	gst_app_sink_set_max_buffers( appSink, (guint)mAppliedMaxQueuedFrames );
+	gst_app_sink_set_drop( appSink, mSurfaceRealtime );
+	gst_base_sink_set_sync( GST_BASE_SINK( appSink ), mSurfaceRealtime );
+	gst_base_sink_set_qos_enabled( GST_BASE_SINK( appSink ), mSurfaceRealtime );
+
+	// Without a new_sample callback, samples stay queued in the appsink for pullVideoSurface().
+	GstAppSinkCallbacks appSinkCallbacks = {};
+	appSinkCallbacks.eos			= onGstEos;
+	appSinkCallbacks.new_preroll	= onGstPreroll;
+	appSinkCallbacks.new_sample		= mSurfaceRealtime ? onGstSample : nullptr;
+	gst_app_sink_set_callbacks( appSink, &appSinkCallbacks, this, 0 );
+
+	// Formats which map directly onto a Surface8u.
+	GstCaps* caps = gst_caps_from_string( "video/x-raw, format=(string){ RGBA, BGRA, RGBx, BGRx }" );
+	gst_app_sink_set_caps( appSink, caps );
+	gst_caps_unref( caps );
+
+	// Answer the allocation query with our own pool, large enough for the queued frames.
+	GstPad* pad = gst_element_get_static_pad( mGstData.appSink, "sink" );
+	if( pad ) {
+		gst_pad_add_probe( pad, GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM, onAppSinkQuery, this, nullptr );
+		gst_object_unref( pad );
+	}
+}
+
+GstPadProbeReturn GstPlayer::onAppSinkQuery( GstPad* pad, GstPadProbeInfo* info, gpointer userData )
+{
+	GstQuery* query = GST_PAD_PROBE_INFO_QUERY( info );
+	if( GST_QUERY_TYPE( query ) != GST_QUERY_ALLOCATION )
+		return GST_PAD_PROBE_OK;
+
+	GstCaps* caps = nullptr;
+	gboolean needPool = FALSE;
+	gst_query_parse_allocation( query, &caps, &needPool );
+
+	GstVideoInfo videoInfo;
+	if( ! caps || ! gst_video_info_from_caps( &videoInfo, caps ) )
+		return GST_PAD_PROBE_OK;
+
+	// The queued frames, the one returned by getVideoSurface() and the one being decoded. The pool grows past this
+	// rather than stalling the decoder while the application holds on to Surfaces.
+	GstPlayer* me = static_cast<GstPlayer*>( userData );
+	const guint minBuffers = (guint)me->mNumSurfaceBuffers + 2;
+
+	GstBufferPool* pool = gst_video_buffer_pool_new();
+	GstStructure* config = gst_buffer_pool_get_config( pool );
+	gst_buffer_pool_config_set_params( config, caps, (guint)videoInfo.size, minBuffers, 0 );
+	gst_buffer_pool_config_add_option( config, GST_BUFFER_POOL_OPTION_VIDEO_META );
+	gst_buffer_pool_set_config( pool, config );
+
+	gst_query_add_allocation_pool( query, pool, (guint)videoInfo.size, minBuffers, 0 );
+	gst_query_add_allocation_meta( query, GST_VIDEO_META_API_TYPE, nullptr );
+	gst_object_unref( pool );
+
+#if GST_CHECK_VERSION( 1, 6, 0 )
+	return GST_PAD_PROBE_HANDLED;
+#else
+	return GST_PAD_PROBE_OK;
+#endif
+}
+
+std::shared_ptr<GstSample> GstPlayer::setCurrentSample( GstSample* sample )
+{
+	std::lock_guard<std::mutex> guard( mMutex );
+
+	if( newVideo() ) {
+		GstCaps* currentCaps = gst_sample_get_caps( sample );
+		gboolean success = gst_video_info_from_caps( &mGstData.videoInfo, currentCaps );
+		if( success ) {
+			getVideoInfo( mGstData.videoInfo );
+		}
+		mGstData.videoHasChanged = false;
+	}
+
+	mCurrentSample = std::shared_ptr<GstSample>( sample, &gst_sample_unref );
+	mNewFrame = true;
+	mNewFrameCondition.notify_all();
+	return mCurrentSample;
+}
+
+// Wraps the frame of \a sample in a Surface8u which keeps the sample and its mapping alive for as long as it's referenced.
+static ci::Surface8uRef createSurfaceFromSample( const std::shared_ptr<GstSample>& sample, gint64* timeNanos )
+{
+	if( ! sample )
+		return nullptr;
+
+	GstVideoInfo videoInfo;
+	GstBuffer* buffer = gst_sample_get_buffer( sample.get() );
+	if( ! buffer || ! gst_video_info_from_caps( &videoInfo, gst_sample_get_caps( sample.get() ) ) )
+		return nullptr;
+
+	ci::SurfaceChannelOrder channelOrder;
+	switch( GST_VIDEO_INFO_FORMAT( &videoInfo ) ) {
+		case GST_VIDEO_FORMAT_RGBA: channelOrder = ci::SurfaceChannelOrder::RGBA; break;
+		case GST_VIDEO_FORMAT_BGRA: channelOrder = ci::SurfaceChannelOrder::BGRA; break;
+		case GST_VIDEO_FORMAT_RGBx: channelOrder = ci::SurfaceChannelOrder::RGBX; break;
+		case GST_VIDEO_FORMAT_BGRx: channelOrder = ci::SurfaceChannelOrder::BGRX; break;
+		default:
+			CI_LOG_E( "Unsupported video format for a Surface : " << gst_video_format_to_string( GST_VIDEO_INFO_FORMAT( &videoInfo ) ) );
+			return nullptr;
+	}
+
+	// Mapping as a video frame honours the strides and offsets of any GstVideoMeta.
+	GstVideoFrame* frame = new GstVideoFrame;
+	if( ! gst_video_frame_map( frame, &videoInfo, buffer, GST_MAP_READ ) ) {
+		delete frame;
+		CI_LOG_E( "Failed to map video frame." );
+		return nullptr;
+	}
+
+	if( timeNanos )
+		*timeNanos = GST_BUFFER_PTS_IS_VALID( buffer ) ? (gint64)GST_BUFFER_PTS( buffer ) : -1;
+
+	uint8_t* data = static_cast<uint8_t*>( GST_VIDEO_FRAME_PLANE_DATA( frame, 0 ) );
+	ci::Surface8u* surface = new ci::Surface8u( data, GST_VIDEO_FRAME_WIDTH( frame ), GST_VIDEO_FRAME_HEIGHT( frame ), GST_VIDEO_FRAME_PLANE_STRIDE( frame, 0 ), channelOrder );
+	return ci::Surface8uRef( surface, [frame, sample]( ci::Surface8u* s ) {
+		delete s;
+		gst_video_frame_unmap( frame );
+		delete frame;
+	} );
+}
+
+ci::Surface8uRef GstPlayer::getVideoSurface( gint64* timeNanos )
+{
+	std::shared_ptr<GstSample> sample;
+	{
+		std::lock_guard<std::mutex> guard( mMutex );
+		sample = mCurrentSample;
+		mNewFrame = false;
+	}
+
+	return createSurfaceFromSample( sample, timeNanos );
+}
+
+ci::Surface8uRef GstPlayer::pullVideoSurface( gint64 timeoutNanos, gint64* timeNanos )
+{
+	if( ! mGstData.appSink )
+		return nullptr;
+
+	applyMaxQueuedFrames();
+
+#if GST_CHECK_VERSION( 1, 10, 0 )
+	GstSample* sample = gst_app_sink_try_pull_sample( GST_APP_SINK( mGstData.appSink ), (GstClockTime)std::max<gint64>( timeoutNanos, 0 ) );
+#else
+	GstSample* sample = gst_app_sink_pull_sample( GST_APP_SINK( mGstData.appSink ) );
+#endif
+	if( ! sample )
+		return nullptr;
+
+	// The pulled frame is consumed here rather than reported as new.
+	std::shared_ptr<GstSample> current = setCurrentSample( sample );
+	mNewFrame = false;
+	return createSurfaceFromSample( current, timeNanos );
+}
+
+bool GstPlayer::waitForNewFrame( gint64 timeoutNanos )
+{
+	std::unique_lock<std::mutex> lock( mMutex );
+	return mNewFrameCondition.wait_for( lock, std::chrono::nanoseconds( timeoutNanos ), [this] { return mNewFrame.load(); } );
+}
+
+bool GstPlayer::isEos() const
+{
+	return mGstData.appSink && gst_app_sink_is_eos( GST_APP_SINK( mGstData.appSink ) );
+}
+
+size_t GstPlayer::getNumFramesDecoded() const
+{
+	return mNumFramesDecoded;
+}
+
+size_t GstPlayer::getNumFramesDropped() const
+{
+	return (size_t)( mGstData.sinkFramesDropped + mGstData.decoderFramesDropped );
+}
+
+double GstPlayer::getDecodeLatency() const
+{
+	std::lock_guard<std::mutex> guard( mStatsMutex );
+	return mDecodeLatency;
+}
+
+double GstPlayer::getMaxDecodeLatency() const
+{
+	std::lock_guard<std::mutex> guard( mStatsMutex );
+	return mMaxDecodeLatency;
+}
+
+size_t GstPlayer::getFrameBytes() const
+{
+	return mFrameBytes;
+}
+
+size_t GstPlayer::getMaxQueuedFrames() const
+{
+	// Otherwise the appsink holds on to the latest frame only.
+	if( mSurfaceOutput && ! mSurfaceRealtime )
+		return std::min<size_t>( mNumSurfaceBuffers, mMaxQueuedFrames );
+
+	return 1;
+}
+
+void GstPlayer::setMaxQueuedFrames( size_t maxFrames )
+{
+	// Applied by the thread pulling frames, which owns the appsink.
+	mMaxQueuedFrames = std::max<size_t>( maxFrames, 1 );
+}
+
+void GstPlayer::applyMaxQueuedFrames()
+{
+	if( ! mSurfaceOutput || mSurfaceRealtime || ! mGstData.appSink )
+		return;
+
+	const size_t maxFrames = getMaxQueuedFrames();
+	if( maxFrames != mAppliedMaxQueuedFrames ) {
+		gst_app_sink_set_max_buffers( GST_APP_SINK( mGstData.appSink ), (guint)maxFrames );
+		mAppliedMaxQueuedFrames = maxFrames;
+	}
+}
+
+void GstPlayer::addStatsProbes()
+{
+	if( mGstData.appSink ) {
+		GstPad* pad = gst_element_get_static_pad( mGstData.appSink, "sink" );
+		if( pad ) {
+			gst_pad_add_probe( pad, GST_PAD_PROBE_TYPE_BUFFER, onAppSinkBuffer, this, nullptr );
+			gst_object_unref( pad );
+		}
+	}
+
+	if( ! mGstData.pipeline )
+		return;
+
+	// playbin creates its decoders once the stream's type is known, while gst_parse_launch() already has.
+#if GST_CHECK_VERSION( 1, 10, 0 )
+	g_signal_connect( mGstData.pipeline, "deep-element-added", G_CALLBACK( onDeepElementAdded ), this );
+#endif
+	GstIterator* it = gst_bin_iterate_recurse( GST_BIN( mGstData.pipeline ) );
+	gst_iterator_foreach( it, []( const GValue* item, gpointer userData ) {
+		static_cast<GstPlayer*>( userData )->configureDecoder( GST_ELEMENT( g_value_get_object( item ) ) );
+	}, this );
+	gst_iterator_free( it );
+}
+
+void GstPlayer::resetStats()
+{
+	mNumFramesDecoded = 0;
+
+	std::lock_guard<std::mutex> guard( mStatsMutex );
+	mDecodeStartTimes.clear();
+	mDecodeLatency = 0;
+	mMaxDecodeLatency = 0;
+}
+
+void GstPlayer::onDeepElementAdded( GstBin* bin, GstBin* subBin, GstElement* element, gpointer userData )
+{
+	GstPlayer* me = static_cast<GstPlayer*>( userData );
+	me->configureDecoder( element );
+}
+
+void GstPlayer::configureDecoder( GstElement* element )
+{
+	const gchar* klass = gst_element_class_get_metadata( GST_ELEMENT_GET_CLASS( element ), GST_ELEMENT_METADATA_KLASS );
+	if( ! klass || ! strstr( klass, "Decoder" ) || ! ( strstr( klass, "Video" ) || strstr( klass, "Image" ) ) )
+		return;
+
+#if defined( CINDER_LINUX )
+	// Decoders default to a thread per core, which oversubscribes the CPU once several streams play at once.
+	const size_t numThreads = cinder::linux::MovieManager::instance().getNumDecodeThreadsPerStream();
+	for( const char* property : { "max-threads", "n-threads" } ) {
+		GParamSpec* spec = g_object_class_find_property( G_OBJECT_GET_CLASS( element ), property );
+		if( spec && spec->value_type == G_TYPE_INT )
+			g_object_set( G_OBJECT( element ), property, (gint)numThreads, nullptr );
+		else if( spec && spec->value_type == G_TYPE_UINT )
+			g_object_set( G_OBJECT( element ), property, (guint)numThreads, nullptr );
+	}
+#endif
+
+	GstPad* sinkPad = gst_element_get_static_pad( element, "sink" );
+	GstPad* srcPad = gst_element_get_static_pad( element, "src" );
+	if( sinkPad && srcPad ) {
+		gst_pad_add_probe( sinkPad, GstPadProbeType( GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_EVENT_FLUSH ), onDecoderInput, this, nullptr );
+		gst_pad_add_probe( srcPad, GST_PAD_PROBE_TYPE_BUFFER, onDecoderOutput, this, nullptr );
+	}
+	if( sinkPad )
+		gst_object_unref( sinkPad );
+	if( srcPad )
+		gst_object_unref( srcPad );
+}
+
+GstPadProbeReturn GstPlayer::onDecoderInput( GstPad* pad, GstPadProbeInfo* info, gpointer userData )
+{
+	GstPlayer* me = static_cast<GstPlayer*>( userData );
+
+	if( GST_PAD_PROBE_INFO_TYPE( info ) & GST_PAD_PROBE_TYPE_EVENT_FLUSH ) {
+		// Frames flushed by a seek never come out.
+		if( GST_EVENT_TYPE( GST_PAD_PROBE_INFO_EVENT( info ) ) == GST_EVENT_FLUSH_STOP ) {
+			std::lock_guard<std::mutex> guard( me->mStatsMutex );
+			me->mDecodeStartTimes.clear();
+		}
+		return GST_PAD_PROBE_OK;
+	}
+
+	GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER( info );
+	if( ! buffer || ! GST_BUFFER_PTS_IS_VALID( buffer ) )
+		return GST_PAD_PROBE_OK;
+
+	std::lock_guard<std::mutex> guard( me->mStatsMutex );
+	me->mDecodeStartTimes.emplace_back( GST_BUFFER_PTS( buffer ), g_get_monotonic_time() );
+	// Bounded in case the decoder drops frames or changes their timestamps.
+	if( me->mDecodeStartTimes.size() > 64 )
+		me->mDecodeStartTimes.pop_front();
+
+	return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn GstPlayer::onDecoderOutput( GstPad* pad, GstPadProbeInfo* info, gpointer userData )
+{
+	GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER( info );
+	if( ! buffer || ! GST_BUFFER_PTS_IS_VALID( buffer ) )
+		return GST_PAD_PROBE_OK;
+
+	const GstClockTime pts = GST_BUFFER_PTS( buffer );
+	const gint64 now = g_get_monotonic_time();
+	GstPlayer* me = static_cast<GstPlayer*>( userData );
+
+	std::lock_guard<std::mutex> guard( me->mStatsMutex );
+	auto& startTimes = me->mDecodeStartTimes;
+	auto startIt = std::find_if( startTimes.begin(), startTimes.end(), [pts]( const std::pair<GstClockTime, gint64>& start ) { return start.first == pts; } );
+	if( startIt == startTimes.end() )
+		return GST_PAD_PROBE_OK;
+
+	const double latency = double( now - startIt->second ) / G_USEC_PER_SEC;
+	me->mDecodeLatency = ( me->mDecodeLatency > 0 ) ? me->mDecodeLatency * 0.9 + latency * 0.1 : latency;
+	me->mMaxDecodeLatency = std::max( me->mMaxDecodeLatency, latency );
+
+	// Frames leave in presentation order, so none before this one will follow it.
+	startTimes.erase( std::remove_if( startTimes.begin(), startTimes.end(), [pts]( const std::pair<GstClockTime, gint64>& start ) { return start.first <= pts; } ), startTimes.end() );
+
+	return GST_PAD_PROBE_OK;
+}
+
+GstPadProbeReturn GstPlayer::onAppSinkBuffer( GstPad* pad, GstPadProbeInfo* info, gpointer userData )
+{
+	GstPlayer* me = static_cast<GstPlayer*>( userData );
+	++me->mNumFramesDecoded;
+	return GST_PAD_PROBE_OK;
+}
+
 GstFlowReturn GstPlayer::onGstPreroll( GstAppSink* sink, gpointer userData )
 {
 	GstPlayer* me = static_cast<GstPlayer*>( userData );
+	const size_t frameBytes = me->mFrameBytes;
 	me->processNewSample( gst_app_sink_pull_preroll( sink ) );
+
+#if defined( CINDER_LINUX )
+	// Each stream's share of the memory budget in frames depends on their size, known once the first one arrives.
+	if( me->mFrameBytes != frameBytes && me->mRegistered )
+		cinder::linux::MovieManager::instance().updateQueueLimits();
+#else
+	(void)frameBytes;
+#endif
+
 	return GST_FLOW_OK;
 }
 
@@ -1204,6 +1661,7 @@ void GstPlayer::getVideoInfo( const GstVideoInfo& videoInfo )
 	mGstData.pixelAspectRatio	= (float)videoInfo.par_n / (float)videoInfo.par_d ;
 	mGstData.fpsNom				= videoInfo.fps_n;
 	mGstData.fpsDenom			= videoInfo.fps_d;
+	mFrameBytes					= videoInfo.size;
 }
 
 void GstPlayer::processNewSample( GstSample* sample )
@@ -1212,7 +1670,11 @@ void GstPlayer::processNewSample( GstSample* sample )
 
 	mGstData.isPrerolled = true;
 
-	if( sUseGstGl ) {
+	if( mSurfaceOutput ) {
+		// Keep the sample itself, so the frame isn't copied and its buffer returns to the pool once released.
+		setCurrentSample( sample );
+	}
+	else if( mUseGl ) {
 #if defined( CINDER_GST_HAS_GL )
 		// Pull the memory buffer from the sample.
 		{
@@ -38,7 +38,6 @@ namespace cinder { namespace linux {
 MovieBase::MovieBase()
 {
     mGstPlayer.reset( new gst::video::GstPlayer() );
-    mGstPlayer->initialize();
 }
 
 MovieBase::~MovieBase()
@@ -228,18 +227,31 @@ void MovieBase::stop()
     mGstPlayer->stop();
 }
 
+MovieBase::Stats MovieBase::getStats() const
+{
+    Stats result;
+    result.mNumFramesDecoded = mGstPlayer->getNumFramesDecoded();
+    result.mNumFramesDropped = mGstPlayer->getNumFramesDropped();
+    result.mDecodeLatency = mGstPlayer->getDecodeLatency();
+    result.mMaxDecodeLatency = mGstPlayer->getMaxDecodeLatency();
+    result.mMaxQueuedFrames = mGstPlayer->getMaxQueuedFrames();
+    return result;
+}
+
 //! \class MovieGl
 //!
 //!
 MovieGl::MovieGl( const Url& url )
 	: MovieBase()
 {
+	mGstPlayer->initialize();
 	MovieBase::initFromUrl( url );
 }
 
 MovieGl::MovieGl( const fs::path& path )
 	: MovieBase()
 {
+	mGstPlayer->initialize();
 	MovieBase::initFromPath( path );
 }
 
@@ -252,6 +264,96 @@ gl::TextureRef MovieGl::getTexture()
 	return mGstPlayer->getVideoTexture();
 }
 
+//! \class MovieSurface
+//!
+//!
+MovieSurface::MovieSurface( const Url& url, const Options &options )
+	: MovieBase(), mSurfaceTime( -1 )
+{
+	mGstPlayer->setSurfaceOutput( options.isRealtime(), options.getNumBuffers() );
+	MovieBase::initFromUrl( url );
+}
+
+MovieSurface::MovieSurface( const fs::path& path, const Options &options )
+	: MovieBase(), mSurfaceTime( -1 )
+{
+	mGstPlayer->setSurfaceOutput( options.isRealtime(), options.getNumBuffers() );
+	MovieBase::initFromPath( path );
+}
+
+MovieSurface::MovieSurface( const Options &options )
+	: MovieBase(), mSurfaceTime( -1 )
+{
+	mGstPlayer->setSurfaceOutput( options.isRealtime(), options.getNumBuffers() );
+}
+
+MovieSurface::~MovieSurface()
+{
+}
+
+MovieSurfaceRef MovieSurface::createFromPipeline( const std::string &pipeline, const Options &options )
+{
+	MovieSurfaceRef result( new MovieSurface( options ) );
+
+	gst::video::GstCustomPipelineData customPipeline;
+	customPipeline.pipeline = pipeline + " ! videoconvert ! appsink name=videosink";
+	result->mGstPlayer->setCustomPipeline( customPipeline );
+	return result;
+}
+
+Surface8uRef MovieSurface::getSurface()
+{
+	gint64 timeNanos = -1;
+	return updateSurfaceTime( mGstPlayer->getVideoSurface( &timeNanos ), timeNanos );
+}
+
+Surface8uRef MovieSurface::pullSurface( double timeoutSeconds )
+{
+	const gint64 timeoutNanos = gint64( timeoutSeconds * GST_SECOND );
+	gint64 timeNanos = -1;
+	return updateSurfaceTime( mGstPlayer->pullVideoSurface( timeoutNanos, &timeNanos ), timeNanos );
+}
+
+Surface8uRef MovieSurface::stepToNextFrame( double timeoutSeconds )
+{
+	if( ! mGstPlayer->stepForward() || ! mGstPlayer->waitForNewFrame( gint64( timeoutSeconds * GST_SECOND ) ) )
+		return nullptr;
+
+	return getSurface();
+}
+
+Surface8uRef MovieSurface::seekToFrameAndWait( int frame, double timeoutSeconds )
+{
+	const float fps = getFramerate();
+	if( fps <= 0 )
+		return nullptr;
+
+	// Aim for the middle of the frame so that rounding can't land the accurate seek on the previous one.
+	seekToTime( float( ( frame + 0.5 ) / fps ) );
+	if( ! mGstPlayer->waitForNewFrame( gint64( timeoutSeconds * GST_SECOND ) ) )
+		return nullptr;
+
+	return getSurface();
+}
+
+bool MovieSurface::waitForNewFrame( double timeoutSeconds )
+{
+	return mGstPlayer->waitForNewFrame( gint64( timeoutSeconds * GST_SECOND ) );
+}
+
+bool MovieSurface::isEndOfStream() const
+{
+	return mGstPlayer->isEos();
+}
+
+Surface8uRef MovieSurface::updateSurfaceTime( const Surface8uRef &surface, int64_t timeNanos )
+{
+	if( surface )
+		mSurfaceTime = ( timeNanos >= 0 ) ? double( timeNanos ) / GST_SECOND : -1;
+
+	return surface;
+}
+
 }} // namespace cinder::linux
 
 #if defined( __CLANG__ )
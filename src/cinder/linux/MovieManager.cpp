@@ -0,0 +1,179 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/linux/MovieManager.h"
+#include "cinder/linux/GstPlayer.h"
+
+#include <future>
+
+namespace cinder { namespace linux {
+
+MovieManager& MovieManager::instance()
+{
+	// Leaked, as movies held by other statics may be destroyed after a static manager would've been, and destroying the
+	// manager itself at exit would mean stopping the main loop thread while players might still be using it.
+	static MovieManager *sInstance = new MovieManager;
+	return *sInstance;
+}
+
+MovieManager::MovieManager()
+	: mMainLoop( nullptr )
+{
+}
+
+void MovieManager::setOptions( const Options &options )
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	mOptions = options;
+	updateQueueLimitsLocked();
+}
+
+MovieManager::Options MovieManager::getOptions() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mOptions;
+}
+
+size_t MovieManager::getNumStreams() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return mPlayers.size();
+}
+
+size_t MovieManager::getNumDecodeThreadsPerStream() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	return std::max<size_t>( mOptions.getMaxDecodeThreads() / std::max<size_t>( mPlayers.size(), 1 ), 1 );
+}
+
+size_t MovieManager::getQueuedBytesLimit() const
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	size_t result = 0;
+	for( const auto &player : mPlayers )
+		result += player->getFrameBytes() * player->getMaxQueuedFrames();
+
+	return result;
+}
+
+void MovieManager::clearPrerolled()
+{
+	std::deque<std::pair<fs::path, std::shared_ptr<MovieBase>>> discarded;
+	{
+		std::lock_guard<std::mutex> lock( mPrerolledMutex );
+		discarded.swap( mPrerolled );
+	}
+}
+
+void MovieManager::addPlayer( gst::video::GstPlayer *player )
+{
+	std::lock_guard<std::mutex> mainLoopLock( mMainLoopMutex );
+	std::lock_guard<std::mutex> lock( mMutex );
+	mPlayers.push_back( player );
+
+	// A single thread runs the default main context, which dispatches every pipeline's bus watch.
+	if( ! mMainLoop ) {
+		mMainLoop = g_main_loop_new( nullptr, false );
+		mMainLoopThread = std::thread( g_main_loop_run, mMainLoop );
+	}
+
+	updateQueueLimitsLocked();
+}
+
+void MovieManager::removePlayer( gst::video::GstPlayer *player )
+{
+	// Held until the main loop has stopped or caught up, so that it isn't stopped while being waited for.
+	std::lock_guard<std::mutex> mainLoopLock( mMainLoopMutex );
+
+	GMainLoop* stoppedLoop = nullptr;
+	std::thread stoppedThread;
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		mPlayers.erase( std::remove( mPlayers.begin(), mPlayers.end(), player ), mPlayers.end() );
+		updateQueueLimitsLocked();
+
+		if( mPlayers.empty() ) {
+			stoppedLoop = mMainLoop;
+			stoppedThread = std::move( mMainLoopThread );
+			mMainLoop = nullptr;
+		}
+	}
+
+	if( stoppedLoop ) {
+		g_main_loop_quit( stoppedLoop );
+		if( stoppedThread.joinable() && stoppedThread.get_id() != std::this_thread::get_id() )
+			stoppedThread.join();
+		else if( stoppedThread.joinable() )
+			stoppedThread.detach();
+		g_main_loop_unref( stoppedLoop );
+	}
+	else {
+		// The player's bus watch has been removed, but its last message may still be being handled.
+		waitForMainLoop();
+	}
+}
+
+void MovieManager::updateQueueLimits()
+{
+	std::lock_guard<std::mutex> lock( mMutex );
+	updateQueueLimitsLocked();
+}
+
+void MovieManager::updateQueueLimitsLocked()
+{
+	if( mPlayers.empty() )
+		return;
+
+	// Each stream gets an equal share of the budget, in whole frames of its own size.
+	const size_t bytesPerStream = mOptions.getMaxQueuedBytes() / mPlayers.size();
+	for( auto &player : mPlayers ) {
+		const size_t frameBytes = player->getFrameBytes();
+		size_t maxFrames = mOptions.getMaxQueuedFrames();
+		if( frameBytes > 0 )
+			maxFrames = std::min( std::max<size_t>( bytesPerStream / frameBytes, 1 ), maxFrames );
+
+		player->setMaxQueuedFrames( maxFrames );
+	}
+}
+
+void MovieManager::waitForMainLoop()
+{
+	GMainContext* context = g_main_context_default();
+	if( g_main_context_is_owner( context ) )
+		return;
+
+	// Sources are dispatched one at a time, so once this one runs any earlier dispatch has returned.
+	std::promise<void> dispatched;
+	GSource* source = g_idle_source_new();
+	g_source_set_priority( source, G_PRIORITY_HIGH );
+	g_source_set_callback( source, []( gpointer userData ) -> gboolean {
+		static_cast<std::promise<void>*>( userData )->set_value();
+		return G_SOURCE_REMOVE;
+	}, &dispatched, nullptr );
+	g_source_attach( source, context );
+	g_source_unref( source );
+
+	dispatched.get_future().wait();
+}
+
+}} // namespace cinder::linux
@@ -0,0 +1,384 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/linux/TextBlock.h"
+#include "cinder/linux/GlyphCache.h"
+#include "cinder/ip/Fill.h"
+#include "cinder/ip/Premultiply.h"
+#include "cinder/Unicode.h"
+
+#include <algorithm>
+
+namespace cinder { namespace linux {
+
+namespace {
+
+// Blends \a glyph's coverage in \a color over \a surface with the bitmap's upper-left at \a pos, within \a clip. Matches ftutil::DrawBitmap().
+void drawGlyph( const ftutil::CachedGlyph &glyph, const ivec2 &pos, const ColorA8u &color, Surface *surface, const Area &clip )
+{
+	const FT_Bitmap *bitmap = glyph.getBitmap();
+	const int x1 = std::max( pos.x, clip.x1 ), x2 = std::min<int>( pos.x + bitmap->width, clip.x2 );
+	const int y1 = std::max( pos.y, clip.y1 ), y2 = std::min<int>( pos.y + bitmap->rows, clip.y2 );
+	if( x1 >= x2 || y1 >= y2 )
+		return;
+
+	const uint8_t pixelInc = surface->getPixelInc();
+	const uint8_t red = surface->getRedOffset(), green = surface->getGreenOffset(), blue = surface->getBlueOffset();
+	const int8_t alphaOffset = surface->getAlphaOffset();
+	for( int y = y1; y < y2; ++y ) {
+		const uint8_t *src = bitmap->buffer + ( y - pos.y ) * bitmap->width + ( x1 - pos.x );
+		uint8_t *dst = surface->getData( ivec2( x1, y ) );
+		for( int x = x1; x < x2; ++x, ++src, dst += pixelInc ) {
+			const int val = *src;
+			if( val == 0 )
+				continue;
+			const int alpha = val + 1;
+			const int invAlpha = 256 - val;
+			dst[red] = ( color.r * alpha + dst[red] * invAlpha ) >> 8;
+			dst[green] = ( color.g * alpha + dst[green] * invAlpha ) >> 8;
+			dst[blue] = ( color.b * alpha + dst[blue] * invAlpha ) >> 8;
+			if( alphaOffset >= 0 )
+				dst[alphaOffset] = ( color.a * alpha + dst[alphaOffset] * invAlpha ) >> 8;
+		}
+	}
+}
+
+} // anonymous namespace
+
+TextBlock::TextBlock()
+	: mWidth( TextBox::GROW ), mAlign( TextBox::LEFT ), mColor( 1, 1, 1, 1 ), mInvalid( true ), mNumParagraphsShaped( 0 ), mLineHeight( 0 ), mAscent( 0 )
+{
+	setText( "" );
+}
+
+TextBlock::TextBlock( const TextBlock &other )
+{
+	*this = other;
+}
+
+TextBlock& TextBlock::operator=( const TextBlock &other )
+{
+	if( this == &other )
+		return *this;
+
+	mText = other.mText;
+	mFont = other.mFont;
+	mWidth = other.mWidth;
+	mAlign = other.mAlign;
+	mColor = other.mColor;
+	mInvalid = other.mInvalid;
+	mNumParagraphsShaped = other.mNumParagraphsShaped;
+	mSize = other.mSize;
+	mLineHeight = other.mLineHeight;
+	mAscent = other.mAscent;
+
+	// paragraphs are laid out in place, so they can't be shared with the other block
+	mParagraphs.clear();
+	mParagraphs.reserve( other.mParagraphs.size() );
+	for( const auto &paragraph : other.mParagraphs )
+		mParagraphs.push_back( std::make_shared<Paragraph>( *paragraph ) );
+	return *this;
+}
+
+void TextBlock::setText( const std::string &text )
+{
+	std::vector<std::string> texts;
+	size_t begin = 0, end;
+	while( ( end = text.find( '\n', begin ) ) != std::string::npos ) {
+		texts.push_back( text.substr( begin, end - begin ) );
+		begin = end + 1;
+	}
+	texts.push_back( text.substr( begin ) );
+
+	// keep the paragraphs at the start and end which didn't change, which covers editing, inserting or removing a run of paragraphs
+	size_t numPrefix = 0, numSuffix = 0;
+	while( numPrefix < mParagraphs.size() && numPrefix < texts.size() && mParagraphs[numPrefix]->mText == texts[numPrefix] )
+		++numPrefix;
+	while( numSuffix < mParagraphs.size() - numPrefix && numSuffix < texts.size() - numPrefix
+			&& mParagraphs[mParagraphs.size() - 1 - numSuffix]->mText == texts[texts.size() - 1 - numSuffix] )
+		++numSuffix;
+
+	std::vector<std::shared_ptr<Paragraph>> paragraphs( mParagraphs.begin(), mParagraphs.begin() + numPrefix );
+	for( size_t i = numPrefix; i < texts.size() - numSuffix; ++i )
+		paragraphs.push_back( std::make_shared<Paragraph>( texts[i] ) );
+	paragraphs.insert( paragraphs.end(), mParagraphs.end() - numSuffix, mParagraphs.end() );
+
+	mParagraphs.swap( paragraphs );
+	mText = text;
+	mInvalid = true;
+}
+
+void TextBlock::setFont( const Font &font )
+{
+	mFont = font;
+	for( auto &paragraph : mParagraphs )
+		paragraph->mShaped = paragraph->mBroken = false;
+	mInvalid = true;
+}
+
+void TextBlock::setWidth( int width )
+{
+	if( width == mWidth )
+		return;
+
+	mWidth = width;
+	for( auto &paragraph : mParagraphs )
+		paragraph->mBroken = false;
+	mInvalid = true;
+}
+
+ivec2 TextBlock::getSize() const
+{
+	layout();
+	return mSize;
+}
+
+size_t TextBlock::getNumLines() const
+{
+	layout();
+	size_t result = 0;
+	for( const auto &paragraph : mParagraphs )
+		result += paragraph->mLines.size();
+	return result;
+}
+
+size_t TextBlock::getNumParagraphs() const
+{
+	return mParagraphs.size();
+}
+
+void TextBlock::layout() const
+{
+	if( ! mInvalid )
+		return;
+
+	mInvalid = false;
+	mSize = ivec2( 0 );
+	if( ! mFont )
+		return;
+
+	const FT_Size_Metrics &metrics = mFont.getFreetypeFace()->size->metrics;
+	mAscent = (int)( ( std::abs( metrics.ascender ) + 32 ) >> 6 );
+	mLineHeight = (int)( ( metrics.height + 32 ) >> 6 );
+
+	int32_t maxLineWidth = 0;
+	size_t numLines = 0;
+	for( auto &paragraph : mParagraphs ) {
+		if( ! paragraph->mShaped )
+			shapeParagraph( paragraph.get() );
+		if( ! paragraph->mBroken )
+			breakParagraph( paragraph.get() );
+
+		for( const auto &line : paragraph->mLines )
+			maxLineWidth = std::max( maxLineWidth, line.mWidth );
+		numLines += paragraph->mLines.size();
+	}
+
+	mSize.x = ( mWidth > 0 ) ? mWidth : (int)( ( maxLineWidth + 63 ) >> 6 );
+	mSize.y = (int)numLines * mLineHeight;
+}
+
+void TextBlock::shapeParagraph( Paragraph *paragraph ) const
+{
+	FT_Face face = mFont.getFreetypeFace();
+	auto &cache = ftutil::GlyphCache::instance();
+
+	paragraph->mByteOffsets.clear();
+	paragraph->mGlyphs.clear();
+	paragraph->mPenX.clear();
+
+	const std::string &text = paragraph->mText;
+	FT_Vector pen = { 0, 0 };
+	size_t byte = 0;
+	while( byte < text.size() ) {
+		paragraph->mByteOffsets.push_back( byte );
+		paragraph->mPenX.push_back( (int32_t)pen.x );
+
+		const uint32_t ch = nextCharUtf8( text.c_str(), &byte, text.size() );
+		auto glyph = cache.getGlyph( face, FT_Get_Char_Index( face, ch ), pen );
+		if( glyph )
+			pen.x += glyph->mAdvance.x;
+		paragraph->mGlyphs.push_back( glyph );
+	}
+	paragraph->mByteOffsets.push_back( text.size() );
+	paragraph->mPenX.push_back( (int32_t)pen.x );
+
+	paragraph->mShaped = true;
+	paragraph->mBroken = false;
+	++mNumParagraphsShaped;
+}
+
+void TextBlock::breakParagraph( Paragraph *paragraph ) const
+{
+	const std::string &text = paragraph->mText;
+	const auto &byteOffsets = paragraph->mByteOffsets;
+	const auto &penX = paragraph->mPenX;
+	auto glyphAt = [&]( size_t byte ) {
+		return (size_t)( std::lower_bound( byteOffsets.begin(), byteOffsets.end(), byte ) - byteOffsets.begin() );
+	};
+	auto addLine = [&]( size_t beginGlyph, size_t endGlyph ) {
+		Line line;
+		line.mBeginGlyph = beginGlyph;
+		line.mEndGlyph = endGlyph;
+		while( endGlyph > beginGlyph && text[byteOffsets[endGlyph - 1]] == ' ' )
+			--endGlyph;
+		line.mWidth = penX[endGlyph] - penX[beginGlyph];
+		paragraph->mLines.push_back( std::move( line ) );
+	};
+
+	paragraph->mLines.clear();
+	const size_t numGlyphs = paragraph->mGlyphs.size();
+	if( mWidth > 0 && numGlyphs > 0 ) {
+		// the pen positions of the whole paragraph make measuring any candidate line a subtraction
+		const char *base = text.c_str();
+		auto measureFn = [&]( const char *line, size_t length ) {
+			const size_t begin = line - base;
+			return ( ( penX[glyphAt( begin + length )] - penX[glyphAt( begin )] ) >> 6 ) <= mWidth;
+		};
+		auto lineFn = [&]( const char *line, size_t length ) {
+			const size_t begin = line - base;
+			addLine( glyphAt( begin ), glyphAt( begin + length ) );
+		};
+		lineBreakUtf8( base, measureFn, lineFn );
+	}
+	if( paragraph->mLines.empty() )
+		addLine( 0, numGlyphs );
+
+	// lines which don't start on a whole pixel need their glyphs at different subpixel offsets
+	FT_Face face = mFont.getFreetypeFace();
+	for( auto &line : paragraph->mLines ) {
+		const int32_t lineStart = penX[line.mBeginGlyph];
+		if( ( lineStart & 63 ) == 0 )
+			continue;
+
+		for( size_t i = line.mBeginGlyph; i < line.mEndGlyph; ++i ) {
+			const FT_Vector pen = { penX[i] - lineStart, 0 };
+			size_t byte = byteOffsets[i];
+			const uint32_t ch = nextCharUtf8( text.c_str(), &byte, text.size() );
+			line.mGlyphs.push_back( ftutil::GlyphCache::instance().getGlyph( face, FT_Get_Char_Index( face, ch ), pen ) );
+		}
+	}
+
+	paragraph->mBroken = true;
+}
+
+void TextBlock::render( Surface *surface, const ivec2 &offset, const Area &clip ) const
+{
+	layout();
+	if( ! mFont || ! surface )
+		return;
+
+	Area clipArea = ( clip == Area::zero() ) ? surface->getBounds() : clip;
+	clipArea.clipBy( surface->getBounds() );
+	const ColorA8u color( mColor );
+
+	int lineTop = offset.y;
+	for( const auto &paragraph : mParagraphs ) {
+		for( const auto &line : paragraph->mLines ) {
+			int lineLeft = offset.x;
+			if( mAlign == TextBox::CENTER )
+				lineLeft += ( mSize.x - (int)( ( line.mWidth + 63 ) >> 6 ) ) / 2;
+			else if( mAlign == TextBox::RIGHT )
+				lineLeft += mSize.x - (int)( ( line.mWidth + 63 ) >> 6 );
+
+			const int baseline = lineTop + mAscent;
+			if( baseline - mLineHeight < clipArea.y2 && baseline + mLineHeight > clipArea.y1 ) {
+				const int32_t lineStart = paragraph->mPenX[line.mBeginGlyph];
+				for( size_t i = line.mBeginGlyph; i < line.mEndGlyph; ++i ) {
+					const auto &glyph = line.mGlyphs.empty() ? paragraph->mGlyphs[i] : line.mGlyphs[i - line.mBeginGlyph];
+					if( ! glyph )
+						continue;
+
+					const int32_t penX = paragraph->mPenX[i] - lineStart;
+					const ivec2 pos( lineLeft + ( penX >> 6 ) + glyph->mBitmapLeft, baseline - glyph->mBitmapTop );
+					drawGlyph( *glyph, pos, color, surface, clipArea );
+				}
+			}
+
+			lineTop += mLineHeight;
+		}
+	}
+}
+
+Surface TextBlock::render( bool premultiplied ) const
+{
+	const ivec2 size = getSize();
+	Surface result( std::max( size.x, 1 ), std::max( size.y, 1 ), true );
+	ip::fill( &result, ColorA( 0, 0, 0, 0 ) );
+	render( &result, ivec2( 0 ) );
+
+	if( ! premultiplied )
+		ip::unpremultiply( &result );
+	else
+		result.setPremultiplied( true );
+
+	return result;
+}
+
+Surface renderTextBlocks( const std::vector<const TextBlock*> &blocks, int width, std::vector<Area> *areas, bool premultiplied, int padding )
+{
+	// lay out every block first, so that the Surface can be allocated once
+	std::vector<Area> packed;
+	packed.reserve( blocks.size() );
+	ivec2 pos( 0 );
+	int rowHeight = 0;
+	for( const TextBlock *block : blocks ) {
+		const ivec2 size = block ? block->getSize() : ivec2( 0 );
+		if( pos.x > 0 && pos.x + size.x > width ) {
+			pos = ivec2( 0, pos.y + rowHeight + padding );
+			rowHeight = 0;
+		}
+		packed.push_back( Area( pos, pos + size ) );
+		pos.x += size.x + padding;
+		rowHeight = std::max( rowHeight, size.y );
+	}
+
+	Surface result( std::max( width, 1 ), std::max( pos.y + rowHeight, 1 ), true );
+	ip::fill( &result, ColorA( 0, 0, 0, 0 ) );
+	for( size_t i = 0; i < blocks.size(); ++i ) {
+		if( blocks[i] && packed[i].calcArea() > 0 )
+			blocks[i]->render( &result, packed[i].getUL(), packed[i] );
+	}
+
+	if( ! premultiplied )
+		ip::unpremultiply( &result );
+	else
+		result.setPremultiplied( true );
+
+	if( areas )
+		areas->swap( packed );
+
+	return result;
+}
+
+Surface renderTextBlocks( const std::vector<TextBlock> &blocks, int width, std::vector<Area> *areas, bool premultiplied, int padding )
+{
+	std::vector<const TextBlock*> pointers;
+	pointers.reserve( blocks.size() );
+	for( const auto &block : blocks )
+		pointers.push_back( &block );
+
+	return renderTextBlocks( pointers, width, areas, premultiplied, padding );
+}
+
+}} // namespace cinder::linux
@@ -130,11 +130,6 @@ vector<Value> parseValueList( const char **c, bool requireParens = true )
 	return result;
 }
 
-vector<Value> readValueList( const std::string &s, bool requireParens = true ) {
-	const char *temp = s.c_str();
-	return parseValueList( &temp, requireParens );
-}
-
 vector<Value> readValueList( const char *c, bool requireParens = true ) {
 	const char *temp = c;
 	return parseValueList( &temp, requireParens );
@@ -281,12 +276,12 @@ Style::Style()
 	clear();
 }
 
-Style::Style( const XmlTree &xml, const Node *parent )
+Style::Style( const XmlDocument::Node &xml, const Node *parent )
 {
 	clear();
 
-	for( list<XmlTree::Attr>::const_iterator attIt = xml.getAttributes().begin(); attIt != xml.getAttributes().end(); ++attIt ) {
-		if( attIt->getName() == "style" )
+	for( const XmlDocument::Attr *attIt = xml.beginAttributes(); attIt != xml.endAttributes(); ++attIt ) {
+		if( strcmp( attIt->getName(), "style" ) == 0 )
 			parseStyleAttribute( attIt->getValue(), parent );
 		else
 			parseProperty( attIt->getName(), attIt->getValue(), parent );
@@ -615,8 +610,8 @@ Value Value::parse( const std::string &s )
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Node
-Node::Node( Node *parent, const XmlTree &xml )
-	: mParent( parent ), mStyle( xml, this ), mBoundingBoxCached( false )
+Node::Node( Node *parent, const XmlDocument::Node &xml )
+	: mParent( parent ), mStyle( xml, this ), mBoundingBoxCached( false ), mWorldBoundsCached( false ), mWorldBoundsKnown( false )
 {
 	mSpecifiesTransform = false;
 	mId = xml["id"];
@@ -1007,15 +1002,72 @@ mat3 Node::getTransformAbsolute() const
 	return result;
 }
 
+void Node::setTransform( const mat3 &transform )
+{
+	mTransform = transform;
+	mSpecifiesTransform = true;
+	transformChanged();
+}
+
+void Node::unspecifyTransform()
+{
+	mSpecifiesTransform = false;
+	transformChanged();
+}
+
+void Node::transformChanged()
+{
+	invalidateWorldBounds();
+	// the bounding boxes of groups are calculated from the absolute bounds of their children
+	for( const Node *parent = mParent; parent; parent = parent->mParent ) {
+		parent->mWorldBoundsCached = false;
+		parent->mBoundingBoxCached = false;
+	}
+
+	Doc *doc = getDoc();
+	if( doc )
+		doc->nodeTransformChanged( this );
+}
+
+const Rectf& Node::getWorldBounds() const
+{
+	if( ! mWorldBoundsCached ) {
+		mWorldBounds = Rectf( 0, 0, 0, 0 );
+		mWorldBoundsKnown = calcWorldBounds( &mWorldBounds );
+		if( ! mWorldBoundsKnown )
+			mWorldBounds = Rectf( 0, 0, 0, 0 );
+		mWorldBoundsCached = true;
+	}
+
+	return mWorldBounds;
+}
+
+bool Node::calcWorldBounds( Rectf *result ) const
+{
+	Rectf bounds = getBoundingBox();
+	// nodes without a bounding box (text) return [0,0,0,0]
+	if( bounds.x1 == 0 && bounds.y1 == 0 && bounds.x2 == 0 && bounds.y2 == 0 )
+		return false;
+
+	mat3 transform = getTransformAbsolute();
+	*result = bounds.transformed( transform );
+	if( ! getStroke().isNone() ) {
+		float scale = std::max( length( vec2( transform[0] ) ), length( vec2( transform[1] ) ) );
+		result->inflate( vec2( getStrokeWidth() * scale / 2 ) );
+	}
+
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Gradient
-Gradient::Gradient( Node *parent, const XmlTree &xml )
+Gradient::Gradient( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml ), mUseObjectBoundingBox( true ), mSpecifiesTransform( false )
 {
 	parse( parent, xml );
 }
 
-void Gradient::parse( const Node *parent, const XmlTree &xml )
+void Gradient::parse( const Node *parent, const XmlDocument::Node &xml )
 {
 	if( xml.hasAttribute( "xlink:href" ) ) {
 		string ref = xml.getAttributeValue<string>( "xlink:href" );
@@ -1029,8 +1081,8 @@ void Gradient::parse( const Node *parent, const XmlTree &xml )
 			}
 		}
 	}
-	for( XmlTree::ConstIter stopsIt = xml.begin( "stop" ); stopsIt != xml.end(); ++stopsIt ) {
-		mStops.push_back( Stop( parent, *stopsIt ) );
+	for( const XmlDocument::Node *stop = xml.findChild( "stop", true ); stop; stop = stop->getNextSameTag() ) {
+		mStops.push_back( Stop( parent, *stop ) );
 	}
 	if( xml.hasAttribute( "gradientUnits" ) )
 		mUseObjectBoundingBox = xml.getAttributeValue<string>( "gradientUnits" ) != string("userSpaceOnUse");
@@ -1052,7 +1104,7 @@ void Gradient::copyAttributesFrom( const Gradient &rhs )
 	}
 }
 
-Gradient::Stop::Stop( const Node *parent, const XmlTree &xml )
+Gradient::Stop::Stop( const Node *parent, const XmlDocument::Node &xml )
 	: mOffset( 0 ), mSpecifiesColor( false ), mSpecifiesOpacity( false )
 {
 	if( xml.hasAttribute( "offset" ) )
@@ -1095,13 +1147,13 @@ Paint Gradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // LinearGradient
-LinearGradient::LinearGradient( Node *parent, const XmlTree &xml )
+LinearGradient::LinearGradient( Node *parent, const XmlDocument::Node &xml )
 	: Gradient( parent, xml )
 {
 	parse( xml );
 }
 
-void LinearGradient::parse( const XmlTree &xml )
+void LinearGradient::parse( const XmlDocument::Node &xml )
 {
 	mCoords0.x = xml.getAttributeValue( "x1", 0.0f );
 	mCoords0.y = xml.getAttributeValue( "y1", 0.0f );
@@ -1118,13 +1170,13 @@ Paint LinearGradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // RadialGradient
-RadialGradient::RadialGradient( Node *parent, const XmlTree &xml )
+RadialGradient::RadialGradient( Node *parent, const XmlDocument::Node &xml )
 	: Gradient( parent, xml )
 {
 	parse( xml );
 }
 
-void RadialGradient::parse( const XmlTree &xml )
+void RadialGradient::parse( const XmlDocument::Node &xml )
 {
 	mCoords0.x = xml.getAttributeValue( "cx", 0.5f );
 	mCoords0.y = xml.getAttributeValue( "cy", 0.5f );
@@ -1143,7 +1195,7 @@ Paint RadialGradient::asPaint() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Circle
-Circle::Circle( Node *parent, const XmlTree &xml )
+Circle::Circle( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mCenter.x = xml.getAttributeValue( "cx", 0.0f );
@@ -1165,7 +1217,7 @@ Shape2d Circle::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Ellipse
-Ellipse::Ellipse( Node *parent, const XmlTree &xml )
+Ellipse::Ellipse( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mCenter.x = xml.getAttributeValue( "cx", 0.0f );
@@ -1490,7 +1542,7 @@ Shape2d parsePath( const std::string &p )
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Path
-Path::Path( Node *parent, const XmlTree &xml )
+Path::Path( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	std::string p = xml.getAttributeValue<string>( "d", "" );
@@ -1513,7 +1565,7 @@ void Path::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Line
-Line::Line( Node *parent, const XmlTree &xml )
+Line::Line( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mPoint1.x = xml.getAttributeValue<float>( "x1", 0 );
@@ -1537,7 +1589,7 @@ Shape2d	Line::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Rect
-Rect::Rect( Node *parent, const XmlTree &xml )
+Rect::Rect( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	float width = 0, height = 0;
@@ -1599,7 +1651,7 @@ vector<vec2> parsePointList( const std::string &p )
 	return result;
 }
 
-Polygon::Polygon( Node *parent, const XmlTree &xml )
+Polygon::Polygon( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mPolyLine = PolyLine2f( parsePointList( xml.getAttributeValue<string>( "points", "" ) ) );
@@ -1629,7 +1681,7 @@ Shape2d	Polygon::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Polyline
-Polyline::Polyline( Node *parent, const XmlTree &xml )
+Polyline::Polyline( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mPolyLine = PolyLine2f( parsePointList( xml.getAttributeValue<string>( "points", "" ) ) );
@@ -1657,7 +1709,7 @@ Shape2d	Polyline::getShape() const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Group
-Group::Group( Node *parent, const XmlTree &xml )
+Group::Group( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	parse( xml );
@@ -1669,36 +1721,36 @@ Group::~Group()
 		delete *childIt;
 }
 
-void Group::parse( const XmlTree &xml )
+void Group::parse( const XmlDocument::Node &xml )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
-		if( treeIt->getTag() == "g" )
+	for( const XmlDocument::Node *treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+		if( treeIt->isTag( "g" ) )
 			mChildren.push_back( new Group( this, *treeIt ) );
-		else if( treeIt->getTag() == "path" )
+		else if( treeIt->isTag( "path" ) )
 			mChildren.push_back( new Path( this, *treeIt ) );
-		else if( treeIt->getTag() == "polygon" )
+		else if( treeIt->isTag( "polygon" ) )
 			mChildren.push_back( new Polygon( this, *treeIt ) );
-		else if( treeIt->getTag() == "polyline" )
+		else if( treeIt->isTag( "polyline" ) )
 			mChildren.push_back( new Polyline( this, *treeIt ) );
-		else if( treeIt->getTag() == "line" )
+		else if( treeIt->isTag( "line" ) )
 			mChildren.push_back( new Line( this, *treeIt ) );
-		else if( treeIt->getTag() == "rect" )
+		else if( treeIt->isTag( "rect" ) )
 			mChildren.push_back( new Rect( this, *treeIt ) );
-		else if( treeIt->getTag() == "circle" )
+		else if( treeIt->isTag( "circle" ) )
 			mChildren.push_back( new Circle( this, *treeIt ) );
-		else if( treeIt->getTag() == "ellipse" )
+		else if( treeIt->isTag( "ellipse" ) )
 			mChildren.push_back( new Ellipse( this, *treeIt ) );
-		else if( treeIt->getTag() == "use" )
+		else if( treeIt->isTag( "use" ) )
 			mChildren.push_back( new Use( this, *treeIt ) );
-		else if( treeIt->getTag() == "defs" )
+		else if( treeIt->isTag( "defs" ) )
 			mDefs = shared_ptr<Group>( new Group( this, *treeIt ) );
-		else if( treeIt->getTag() == "image" )
+		else if( treeIt->isTag( "image" ) )
 			mChildren.push_back( new Image( this, *treeIt ) );
-		else if( treeIt->getTag() == "linearGradient" )
+		else if( treeIt->isTag( "linearGradient" ) )
 			mChildren.push_back( new LinearGradient( this, *treeIt ) );
-		else if( treeIt->getTag() == "radialGradient" )
+		else if( treeIt->isTag( "radialGradient" ) )
 			mChildren.push_back( new RadialGradient( this, *treeIt ) );
-		else if( treeIt->getTag() == "text" )
+		else if( treeIt->isTag( "text" ) )
 			mChildren.push_back( new Text( this, *treeIt ) );
 	}
 }
@@ -1858,6 +1910,8 @@ void Group::renderSelf( Renderer &renderer ) const
 		auto childItPtr = *childIt;
 		if( (! childItPtr->isVisible()) && ( typeid(svg::Group) != typeid(*childItPtr) ) ) // if this isn't visible and isn't a group, just move along
 			continue;
+		if( renderer.hasCullRect() && childItPtr->hasWorldBounds() && ! childItPtr->getWorldBounds().intersects( renderer.getCullRect() ) )
+			continue;
 		(*childIt)->startRender( renderer, style );
 		(*childIt)->renderSelf( renderer );
 		(*childIt)->finishRender( renderer, style );
@@ -1885,6 +1939,33 @@ Rectf Group::calcBoundingBox() const
 	return result;
 }
 
+bool Group::calcWorldBounds( Rectf *result ) const
+{
+	bool empty = true;
+	for( list<Node*>::const_iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt ) {
+		// a single child without known bounds makes the group's unknown
+		if( ! (*childIt)->hasWorldBounds() )
+			return false;
+		if( empty ) {
+			*result = (*childIt)->getWorldBounds();
+			empty = false;
+		}
+		else
+			result->include( (*childIt)->getWorldBounds() );
+	}
+
+	return true;
+}
+
+void Group::invalidateWorldBounds() const
+{
+	Node::invalidateWorldBounds();
+	// the bounding box depends on the absolute transform of the children as well
+	mBoundingBoxCached = false;
+	for( list<Node*>::const_iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt )
+		(*childIt)->invalidateWorldBounds();
+}
+
 void Group::iterate( const std::function<void(Node*)> &fn )
 {
 	for( list<Node*>::iterator childIt = mChildren.begin(); childIt != mChildren.end(); ++childIt ) {
@@ -1896,13 +1977,13 @@ void Group::iterate( const std::function<void(Node*)> &fn )
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Use
-Use::Use( Node *parent, const XmlTree &xml )
+Use::Use( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml ), mReferenced( 0 )
 {
 	parse( xml );
 }
 
-void Use::parse( const XmlTree &xml )
+void Use::parse( const XmlDocument::Node &xml )
 {
 	if( xml.hasAttribute( "xlink:href" ) ) {
 		string ref = xml.getAttributeValue<string>( "xlink:href" );
@@ -1929,7 +2010,7 @@ void Use::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Image
-Image::Image( Node *parent, const XmlTree &xml )
+Image::Image( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml )
 {
 	mRect.x1 = xml.getAttributeValue<float>( "x", 0 );
@@ -1981,14 +2062,14 @@ void Image::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // Text
-Text::Text( Node *parent, const XmlTree &xml )
+Text::Text( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml ), mAttributes( xml )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
-		if( treeIt->getTag() == "" ) { // data!
+	for( const XmlDocument::Node *treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+		if( treeIt->isData() ) { // data!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue() ) ) );
 		}
-		else if( treeIt->getTag() == "tspan" ) { // tspan!
+		else if( treeIt->isTag( "tspan" ) ) { // tspan!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, *treeIt ) ) );
 		}
 	}
@@ -2045,14 +2126,14 @@ void Text::renderSelf( Renderer &renderer ) const
 
 ////////////////////////////////////////////////////////////////////////////////////
 // TextSpan
-TextSpan::TextSpan( Node *parent, const XmlTree &xml )
+TextSpan::TextSpan( Node *parent, const XmlDocument::Node &xml )
 	: Node( parent, xml ), mAttributes( xml ), mIgnoreAttributes( false )
 {
-	for( XmlTree::ConstIter treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
-		if( treeIt->getTag() == "" ) { // data!
+	for( const XmlDocument::Node *treeIt = xml.begin(); treeIt != xml.end(); ++treeIt ) {
+		if( treeIt->isData() ) { // data!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, treeIt->getValue() ) ) );
 		}
-		else if( treeIt->getTag() == "tspan" ) { // tspan!
+		else if( treeIt->isTag( "tspan" ) ) { // tspan!
 			mSpans.push_back( TextSpanRef( new TextSpan( this, *treeIt ) ) );
 		}
 	}
@@ -2150,7 +2231,7 @@ Shape2d TextSpan::getShape() const
 #endif
 
 // TextSpan::Atributes
-TextSpan::Attributes::Attributes( const XmlTree &xml )
+TextSpan::Attributes::Attributes( const XmlDocument::Node &xml )
 {
 	if( xml.hasAttribute( "x" ) )
 		mX = readValueList( xml["x"], false );
@@ -2258,16 +2339,263 @@ void TextSpan::Attributes::setTextPen( const vec2 &textPen )
 		mY[0] = Value( textPen.y );
 }
 
+// Bounding volume hierarchy over the drawable Nodes of a Doc, used for hit-testing and rectangle queries. Items are
+// stored in document order, so the descendants of a Group occupy a contiguous range which can be refit after its transform changes.
+class Doc::SpatialIndex {
+  public:
+	SpatialIndex( const Doc *doc );
+
+	Node*	nodeUnderPoint( const vec2 &pt );
+	void	findNodesInRect( const Rectf &rect, vector<Node*> *result );
+	void	nodeTransformChanged( const Node *node );
+
+  private:
+	struct Item {
+		Node		*mNode;
+		Rectf		mBounds;
+		mat3		mInverseTransform;
+		uint32_t	mBvhNode;
+	};
+
+	// the first child of an interior node immediately follows it and mFirst is the index of the second; leaves reference mItemOrder[mFirst, mFirst + mCount)
+	struct BvhNode {
+		Rectf		mBounds;
+		uint32_t	mFirst, mCount, mParent;
+	};
+
+	void		collect( const Group *group );
+	uint32_t	build( uint32_t begin, uint32_t end, uint32_t parent );
+	bool		refitNode( uint32_t nodeIndex );
+	void		refit();
+	template<typename OverlapsFn>
+	void		gatherItems( const OverlapsFn &overlaps, vector<uint32_t> *result ) const;
+
+	static void	updateItem( Item *item );
+
+	static const uint32_t	sMaxItemsPerLeaf = 4;
+	static const uint32_t	sNoParent = 0xFFFFFFFF;
+
+	vector<Item>			mItems;
+	vector<uint32_t>		mItemOrder;
+	vector<BvhNode>			mNodes;
+	// the range of items [first, last) occupied by each indexed Node, including Groups
+	unordered_map<const Node*, pair<uint32_t, uint32_t>>	mItemRanges;
+	vector<pair<uint32_t, uint32_t>>						mDirtyRanges;
+};
+
+Doc::SpatialIndex::SpatialIndex( const Doc *doc )
+{
+	collect( doc );
+	mItemRanges[doc] = make_pair( 0, (uint32_t)mItems.size() );
+
+	mItemOrder.resize( mItems.size() );
+	for( uint32_t i = 0; i < (uint32_t)mItems.size(); ++i )
+		mItemOrder[i] = i;
+
+	if( ! mItems.empty() ) {
+		mNodes.reserve( 2 * mItems.size() / sMaxItemsPerLeaf + 1 );
+		build( 0, (uint32_t)mItems.size(), sNoParent );
+	}
+}
+
+void Doc::SpatialIndex::collect( const Group *group )
+{
+	// mirrors Group::nodeUnderPoint(), which descends into plain Groups and tests everything else
+	for( list<Node*>::const_iterator childIt = group->getChildren().begin(); childIt != group->getChildren().end(); ++childIt ) {
+		const Node *child = *childIt;
+		uint32_t first = (uint32_t)mItems.size();
+		if( typeid(*child) == typeid(svg::Group) )
+			collect( static_cast<const Group*>( child ) );
+		else if( child->hasWorldBounds() ) {
+			Item item;
+			item.mNode = *childIt;
+			updateItem( &item );
+			mItems.push_back( item );
+		}
+
+		if( mItems.size() > first )
+			mItemRanges[child] = make_pair( first, (uint32_t)mItems.size() );
+	}
+}
+
+uint32_t Doc::SpatialIndex::build( uint32_t begin, uint32_t end, uint32_t parent )
+{
+	const uint32_t nodeIndex = (uint32_t)mNodes.size();
+	mNodes.push_back( BvhNode() );
+	mNodes[nodeIndex].mParent = parent;
+
+	Rectf bounds = mItems[mItemOrder[begin]].mBounds;
+	Rectf centers( bounds.getCenter(), bounds.getCenter() );
+	for( uint32_t i = begin + 1; i < end; ++i ) {
+		bounds.include( mItems[mItemOrder[i]].mBounds );
+		centers.include( mItems[mItemOrder[i]].mBounds.getCenter() );
+	}
+	mNodes[nodeIndex].mBounds = bounds;
+
+	if( end - begin <= sMaxItemsPerLeaf ) {
+		mNodes[nodeIndex].mFirst = begin;
+		mNodes[nodeIndex].mCount = end - begin;
+		for( uint32_t i = begin; i < end; ++i )
+			mItems[mItemOrder[i]].mBvhNode = nodeIndex;
+	}
+	else {
+		// median split along the longest axis of the item centers
+		const int axis = ( centers.getWidth() >= centers.getHeight() ) ? 0 : 1;
+		const uint32_t middle = begin + ( end - begin ) / 2;
+		nth_element( mItemOrder.begin() + begin, mItemOrder.begin() + middle, mItemOrder.begin() + end, [this, axis]( uint32_t a, uint32_t b ) {
+			return mItems[a].mBounds.getCenter()[axis] < mItems[b].mBounds.getCenter()[axis];
+		} );
+
+		build( begin, middle, nodeIndex );
+		const uint32_t second = build( middle, end, nodeIndex );
+		mNodes[nodeIndex].mFirst = second;
+		mNodes[nodeIndex].mCount = 0;
+	}
+
+	return nodeIndex;
+}
+
+void Doc::SpatialIndex::updateItem( Item *item )
+{
+	item->mBounds = item->mNode->getWorldBounds();
+	item->mInverseTransform = item->mNode->getTransformAbsoluteInverse();
+}
+
+bool Doc::SpatialIndex::refitNode( uint32_t nodeIndex )
+{
+	BvhNode &node = mNodes[nodeIndex];
+	Rectf bounds;
+	if( node.mCount ) {
+		bounds = mItems[mItemOrder[node.mFirst]].mBounds;
+		for( uint32_t i = node.mFirst + 1; i < node.mFirst + node.mCount; ++i )
+			bounds.include( mItems[mItemOrder[i]].mBounds );
+	}
+	else {
+		bounds = mNodes[nodeIndex + 1].mBounds;
+		bounds.include( mNodes[node.mFirst].mBounds );
+	}
+
+	bool changed = bounds.x1 != node.mBounds.x1 || bounds.y1 != node.mBounds.y1 || bounds.x2 != node.mBounds.x2 || bounds.y2 != node.mBounds.y2;
+	node.mBounds = bounds;
+	return changed;
+}
+
+void Doc::SpatialIndex::refit()
+{
+	if( mDirtyRanges.empty() )
+		return;
+
+	size_t numDirty = 0;
+	for( const auto &range : mDirtyRanges ) {
+		for( uint32_t i = range.first; i < range.second; ++i )
+			updateItem( &mItems[i] );
+		numDirty += range.second - range.first;
+	}
+
+	if( numDirty * 4 > mItems.size() ) {
+		// children are stored after their parents, so a reverse pass refits bottom-up
+		for( size_t nodeIndex = mNodes.size(); nodeIndex-- > 0; )
+			refitNode( (uint32_t)nodeIndex );
+	}
+	else {
+		for( const auto &range : mDirtyRanges ) {
+			for( uint32_t i = range.first; i < range.second; ++i ) {
+				for( uint32_t nodeIndex = mItems[i].mBvhNode; nodeIndex != sNoParent; nodeIndex = mNodes[nodeIndex].mParent ) {
+					if( ! refitNode( nodeIndex ) )
+						break;
+				}
+			}
+		}
+	}
+
+	mDirtyRanges.clear();
+}
+
+template<typename OverlapsFn>
+void Doc::SpatialIndex::gatherItems( const OverlapsFn &overlaps, vector<uint32_t> *result ) const
+{
+	if( mNodes.empty() )
+		return;
+
+	// the tree is balanced, so its depth is bounded by the number of bits in an index
+	uint32_t stack[64];
+	size_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while( stackSize ) {
+		const BvhNode &node = mNodes[stack[--stackSize]];
+		if( ! overlaps( node.mBounds ) )
+			continue;
+
+		if( node.mCount ) {
+			for( uint32_t i = node.mFirst; i < node.mFirst + node.mCount; ++i ) {
+				if( overlaps( mItems[mItemOrder[i]].mBounds ) )
+					result->push_back( mItemOrder[i] );
+			}
+		}
+		else {
+			stack[stackSize++] = node.mFirst;
+			stack[stackSize++] = (uint32_t)( &node - mNodes.data() ) + 1;
+		}
+	}
+}
+
+Node* Doc::SpatialIndex::nodeUnderPoint( const vec2 &pt )
+{
+	refit();
+
+	vector<uint32_t> candidates;
+	gatherItems( [&pt]( const Rectf &bounds ) { return bounds.contains( pt ); }, &candidates );
+
+	// later items are drawn on top, so test them first
+	sort( candidates.begin(), candidates.end(), greater<uint32_t>() );
+	for( uint32_t itemIndex : candidates ) {
+		const Item &item = mItems[itemIndex];
+		if( item.mNode->containsPoint( vec2( item.mInverseTransform * vec3( pt, 1 ) ) ) )
+			return item.mNode;
+	}
+
+	return nullptr;
+}
+
+void Doc::SpatialIndex::findNodesInRect( const Rectf &rect, vector<Node*> *result )
+{
+	refit();
+
+	vector<uint32_t> candidates;
+	gatherItems( [&rect]( const Rectf &bounds ) { return bounds.intersects( rect ); }, &candidates );
+
+	sort( candidates.begin(), candidates.end() );
+	result->reserve( result->size() + candidates.size() );
+	for( uint32_t itemIndex : candidates )
+		result->push_back( mItems[itemIndex].mNode );
+}
+
+void Doc::SpatialIndex::nodeTransformChanged( const Node *node )
+{
+	auto rangeIt = mItemRanges.find( node );
+	if( rangeIt != mItemRanges.end() )
+		mDirtyRanges.push_back( rangeIt->second );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Doc
+Doc::Doc()
+	: Group( 0 ), mIdIndexBuilt( false ), mWidth( 0 ), mHeight( 0 )
+{
+}
+
+Doc::~Doc()
+{
+}
+
 Doc::Doc( const fs::path &filePath )
-	: Group( 0 )
+	: Group( 0 ), mIdIndexBuilt( false )
 {
 	loadDoc( loadFile( filePath ), filePath );
 }
 
 Doc::Doc( DataSourceRef dataSource, const fs::path &filePath )
-	: Group( 0 )
+	: Group( 0 ), mIdIndexBuilt( false )
 {
 	fs::path relativePath = filePath;
 	if( filePath.empty() )
@@ -2301,9 +2629,9 @@ void Doc::loadDoc( DataSourceRef source, fs::path filePath )
 {
 	if( ! filePath.empty() )
 		mFilePath = filePath.parent_path();
-	mXmlTree = shared_ptr<XmlTree>( new XmlTree( source, XmlTree::ParseOptions().ignoreDataChildren( false ) ) );
-
-	const XmlTree &xml( mXmlTree->getChild( "svg" ) );
+	// the XmlDocument is only needed while the svg::Nodes are built, which copy everything they use
+	const XmlDocument xmlDoc( source, XmlTree::ParseOptions().ignoreDataChildren( false ) );
+	const XmlDocument::Node &xml( xmlDoc.getChild( "svg" ) );
 
 	if( xml.hasAttribute( "viewBox" ) ) {
 		string vbox = xml.getAttributeValue<string>( "viewBox" );
@@ -2378,7 +2706,63 @@ shared_ptr<Surface8u> Doc::loadImage( fs::path relativePath )
 
 Node* Doc::nodeUnderPoint( const vec2 &pt )
 {
-	return Group::nodeUnderPoint( pt, mat3() );
+	if( ! mSpatialIndex )
+		mSpatialIndex.reset( new SpatialIndex( this ) );
+
+	return mSpatialIndex->nodeUnderPoint( pt );
+}
+
+vector<Node*> Doc::findNodesInRect( const Rectf &rect )
+{
+	if( ! mSpatialIndex )
+		mSpatialIndex.reset( new SpatialIndex( this ) );
+
+	vector<Node*> result;
+	mSpatialIndex->findNodesInRect( rect.canonicalized(), &result );
+	return result;
+}
+
+void Doc::invalidateIndices()
+{
+	mSpatialIndex.reset();
+	mIdIndex.clear();
+	mIdIndexBuilt = false;
+	invalidateWorldBounds();
+}
+
+void Doc::nodeTransformChanged( const Node *node )
+{
+	if( mSpatialIndex )
+		mSpatialIndex->nodeTransformChanged( node );
+}
+
+const Node* Doc::findNode( const std::string &id, bool recurse ) const
+{
+	if( ! recurse )
+		return Group::findNode( id, false );
+
+	if( ! mIdIndexBuilt ) {
+		buildIdIndex( this );
+		mIdIndexBuilt = true;
+	}
+
+	auto nodeIt = mIdIndex.find( id );
+	return ( nodeIt != mIdIndex.end() ) ? nodeIt->second : nullptr;
+}
+
+void Doc::buildIdIndex( const Group *group ) const
+{
+	// follows the search order of Group::findNode() so that duplicate IDs resolve to the same Node; emplace() keeps the first
+	for( list<Node*>::const_iterator childIt = group->mChildren.begin(); childIt != group->mChildren.end(); ++childIt )
+		mIdIndex.emplace( (*childIt)->getId(), *childIt );
+
+	if( group->mDefs )
+		buildIdIndex( group->mDefs.get() );
+
+	for( list<Node*>::const_iterator childIt = group->mChildren.begin(); childIt != group->mChildren.end(); ++childIt ) {
+		if( typeid(**childIt) == typeid(Group) )
+			buildIdIndex( static_cast<const Group*>( *childIt ) );
+	}
 }
 
 void Doc::renderSelf( Renderer &renderer ) const
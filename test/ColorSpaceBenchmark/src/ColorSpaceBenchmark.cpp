@@ -0,0 +1,156 @@
+#include "cinder/Cinder.h"
+#include "cinder/Color.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/ColorSpace.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+using namespace std;
+using namespace cinder;
+
+// Converts a 1080p frame between color spaces one pixel at a time with the per-value functions (rgbToHsv(), std::pow() and so on)
+// and with ip::convertColorSpace(), serially and in parallel, for each Surface type. Pass the number of iterations as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static double measure( int numIterations, const Fn &fn )
+{
+	fn(); // warm up, which also builds the lookup tables
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	return secondsSince( start ) * 1000 / numIterations;
+}
+
+static float toLinear( float v )	{ return v <= 0.04045f ? v / 12.92f : std::pow( ( v + 0.055f ) / 1.055f, 2.4f ); }
+static float toSrgb( float v )		{ return v <= 0.0031308f ? v * 12.92f : 1.055f * std::pow( v, 1 / 2.4f ) - 0.055f; }
+static float labF( float t )		{ return t > 216 / 24389.0f ? std::cbrt( t ) : ( 24389 / 27.0f * t + 16 ) / 116; }
+static float labFInverse( float f )	{ return f > 6 / 29.0f ? f * f * f : ( 116 * f - 16 ) * 27 / 24389.0f; }
+
+// Per pixel conversions of encoded sRGB, the way they're written without ip::convertColorSpace()
+static vec3 referenceConvert( ip::ColorSpace to, const vec3 &c )
+{
+	switch( to ) {
+		case ip::ColorSpace::LINEAR_RGB:
+			return vec3( toLinear( c.r ), toLinear( c.g ), toLinear( c.b ) );
+		case ip::ColorSpace::HSV:
+			return rgbToHsv( Colorf( c.r, c.g, c.b ) );
+		case ip::ColorSpace::YCBCR:
+			return vec3( 0.299f * c.r + 0.587f * c.g + 0.114f * c.b, -0.168736f * c.r - 0.331264f * c.g + 0.5f * c.b + 0.5f, 0.5f * c.r - 0.418688f * c.g - 0.081312f * c.b + 0.5f );
+		case ip::ColorSpace::LAB: {
+			const vec3 lin( toLinear( c.r ), toLinear( c.g ), toLinear( c.b ) );
+			const float fx = labF( ( 0.4124564f * lin.r + 0.3575761f * lin.g + 0.1804375f * lin.b ) / 0.95047f );
+			const float fy = labF( 0.2126729f * lin.r + 0.7151522f * lin.g + 0.0721750f * lin.b );
+			const float fz = labF( ( 0.0193339f * lin.r + 0.1191920f * lin.g + 0.9503041f * lin.b ) / 1.08883f );
+			return vec3( ( 116 * fy - 16 ) / 100, ( 500 * ( fx - fy ) + 128 ) / 255, ( 200 * ( fy - fz ) + 128 ) / 255 );
+		}
+		default:
+			return c;
+	}
+}
+
+static vec3 referenceConvertBack( ip::ColorSpace from, const vec3 &c )
+{
+	switch( from ) {
+		case ip::ColorSpace::LINEAR_RGB:
+			return vec3( toSrgb( c.r ), toSrgb( c.g ), toSrgb( c.b ) );
+		case ip::ColorSpace::HSV: {
+			const Colorf rgb = hsvToRgb( c );
+			return vec3( rgb.r, rgb.g, rgb.b );
+		}
+		case ip::ColorSpace::YCBCR:
+			return vec3( c.x + 1.402f * ( c.z - 0.5f ), c.x - 0.344136f * ( c.y - 0.5f ) - 0.714136f * ( c.z - 0.5f ), c.x + 1.772f * ( c.y - 0.5f ) );
+		case ip::ColorSpace::LAB: {
+			const float fy = ( c.x * 100 + 16 ) / 116, fx = fy + ( c.y * 255 - 128 ) / 500, fz = fy - ( c.z * 255 - 128 ) / 200;
+			const float x = labFInverse( fx ) * 0.95047f, y = labFInverse( fy ), z = labFInverse( fz ) * 1.08883f;
+			return vec3( toSrgb( 3.2404542f * x - 1.5371385f * y - 0.4985314f * z ), toSrgb( -0.9692660f * x + 1.8760108f * y + 0.0415560f * z ), toSrgb( 0.0556434f * x - 0.2040259f * y + 1.0572252f * z ) );
+		}
+		default:
+			return c;
+	}
+}
+
+template<typename T>
+static float clampIfInteger( float v )
+{
+	return std::is_floating_point<T>::value ? v : glm::clamp( v, 0.0f, 1.0f );
+}
+
+template<typename T>
+static void referenceSurface( SurfaceT<T> *surface, const function<vec3 ( const vec3 & )> &fn )
+{
+	auto iter = surface->getIter();
+	while( iter.line() ) {
+		while( iter.pixel() ) {
+			const vec3 result = fn( vec3( CHANTRAIT<float>::convert( iter.r() ), CHANTRAIT<float>::convert( iter.g() ), CHANTRAIT<float>::convert( iter.b() ) ) );
+			iter.r() = CHANTRAIT<T>::convert( clampIfInteger<T>( result.x ) );
+			iter.g() = CHANTRAIT<T>::convert( clampIfInteger<T>( result.y ) );
+			iter.b() = CHANTRAIT<T>::convert( clampIfInteger<T>( result.z ) );
+		}
+	}
+}
+
+template<typename T>
+static void benchmarkType( const string &typeName, const Surface32f &source, int numIterations )
+{
+	const pair<ip::ColorSpace, const char*> spaces[] = { { ip::ColorSpace::LINEAR_RGB, "linear" }, { ip::ColorSpace::HSV, "HSV" }, { ip::ColorSpace::YCBCR, "YCbCr" }, { ip::ColorSpace::LAB, "Lab" } };
+	cout << typeName << endl;
+	for( const auto &space : spaces ) {
+		const SurfaceT<T> srgb( source );
+		SurfaceT<T> converted( srgb.getWidth(), srgb.getHeight(), false ), work( srgb.getWidth(), srgb.getHeight(), false );
+		ip::convertColorSpace( srgb, ip::ColorSpace::SRGB, space.first, &converted );
+
+		for( int direction = 0; direction < 2; ++direction ) {
+			const ip::ColorSpace from = direction ? space.first : ip::ColorSpace::SRGB, to = direction ? ip::ColorSpace::SRGB : space.first;
+			const SurfaceT<T> &input = direction ? converted : srgb;
+			const double perValue = measure( numIterations, [&] {
+				work.copyFrom( input, input.getBounds() );
+				if( direction )
+					referenceSurface( &work, [&]( const vec3 &c ) { return referenceConvertBack( from, c ); } );
+				else
+					referenceSurface( &work, [&]( const vec3 &c ) { return referenceConvert( to, c ); } );
+			} );
+			const double serial = measure( numIterations, [&] { ip::convertColorSpace( input, from, to, &work, false ); } );
+			const double parallel = measure( numIterations, [&] { ip::convertColorSpace( input, from, to, &work, true ); } );
+
+			const string label = string( "  " ) + ( direction ? space.second : "sRGB" ) + " -> " + ( direction ? "sRGB" : space.second );
+			cout << left << setw( 20 ) << label << fixed << setprecision( 2 ) << "per value " << setw( 8 ) << perValue << " ms   serial " << setw( 8 ) << serial
+				<< " ms   parallel " << setw( 8 ) << parallel << " ms" << endl;
+		}
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numIterations = argc > 1 ? atoi( argv[1] ) : 5;
+
+	Rand rand( 1234 );
+	Surface32f source( 1920, 1080, false );
+	auto iter = source.getIter();
+	while( iter.line() ) {
+		while( iter.pixel() ) {
+			// a gradient with noise, so that the branches of HSV aren't predictable
+			iter.r() = iter.x() / 1920.0f;
+			iter.g() = iter.y() / 1080.0f;
+			iter.b() = rand.nextFloat();
+		}
+	}
+
+	cout << "1920x1080, " << numIterations << " iterations" << endl;
+	benchmarkType<uint8_t>( "Surface8u", source, numIterations );
+	benchmarkType<uint16_t>( "Surface16u", source, numIterations );
+	benchmarkType<float>( "Surface32f", source, numIterations );
+	return 0;
+}
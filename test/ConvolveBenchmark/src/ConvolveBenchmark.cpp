@@ -0,0 +1,95 @@
+#include "cinder/Cinder.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/Convolve.h"
+#include "cinder/ip/EdgeDetect.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+
+// Convolves a 1080p channel with separable Gaussians and 2D kernels of increasing size, comparing a per-pixel loop
+// with ip::convolve() serially and in parallel, for uint8_t (fixed point) and float. Pass the number of iterations as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static double measure( int numIterations, const Fn &fn )
+{
+	fn(); // warm up
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	return secondsSince( start ) * 1000 / numIterations;
+}
+
+// The kind of loop written without ip::convolve(), clamping at the borders
+template<typename T>
+static void perPixelConvolve( const ChannelT<T> &src, const ip::Kernel &kernel, ChannelT<T> *dst )
+{
+	const ivec2 anchor = kernel.getAnchor();
+	const vector<float> &weights = kernel.getWeights();
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x ) {
+			float sum = 0;
+			for( int32_t ky = 0; ky < kernel.getHeight(); ++ky ) {
+				for( int32_t kx = 0; kx < kernel.getWidth(); ++kx )
+					sum += weights[ky * kernel.getWidth() + kx] * src.getValue( ivec2( x + kx - anchor.x, y + ky - anchor.y ) );
+			}
+			dst->setValue( ivec2( x, y ), CHANTRAIT<T>::convert( std::min( std::max( sum, 0.0f ), (float)CHANTRAIT<T>::max() ) ) );
+		}
+	}
+}
+
+template<typename T>
+static void benchmarkType( const string &typeName, int numIterations )
+{
+	Rand rand( 1234 );
+	ChannelT<T> src( 1920, 1080 ), dst( 1920, 1080 );
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x )
+			src.setValue( ivec2( x, y ), CHANTRAIT<T>::convert( rand.nextFloat() ) );
+	}
+
+	vector<pair<string, ip::Kernel>> kernels;
+	for( int32_t radius : { 1, 2, 4, 8, 16 } )
+		kernels.emplace_back( "gaussian " + to_string( 2 * radius + 1 ), ip::Kernel::gaussian( radius / 3.0f, radius ) );
+	for( int32_t size : { 3, 5, 7, 9 } )
+		kernels.emplace_back( "2D " + to_string( size ) + "x" + to_string( size ), ip::Kernel( size, size, vector<float>( size * size, 1.0f / ( size * size ) ) ) );
+
+	cout << typeName << endl;
+	for( const auto &kernel : kernels ) {
+		// the per-pixel loop is too slow to be worth waiting for with large kernels
+		const bool runPerPixel = kernel.second.getWidth() <= 9;
+		const double perPixel = runPerPixel ? measure( 1, [&] { perPixelConvolve( src, kernel.second, &dst ); } ) : 0;
+		const double serial = measure( numIterations, [&] { ip::convolve( src, &dst, kernel.second, ip::ConvolveOptions().parallel( false ) ); } );
+		const double parallel = measure( numIterations, [&] { ip::convolve( src, &dst, kernel.second ); } );
+
+		ostringstream perPixelText;
+		if( runPerPixel )
+			perPixelText << fixed << setprecision( 2 ) << perPixel << " ms";
+		cout << "  " << left << setw( 14 ) << kernel.first << fixed << setprecision( 2 ) << "per pixel " << setw( 12 ) << perPixelText.str()
+			<< "serial " << setw( 8 ) << serial << " ms   parallel " << setw( 8 ) << parallel << " ms" << endl;
+	}
+
+	const double sobel = measure( numIterations, [&] { ip::edgeDetectSobel( src, &dst ); } );
+	cout << "  " << left << setw( 14 ) << "edgeDetectSobel" << " " << fixed << setprecision( 2 ) << sobel << " ms" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numIterations = argc > 1 ? atoi( argv[1] ) : 5;
+	cout << "1920x1080, " << numIterations << " iterations" << endl;
+	benchmarkType<uint8_t>( "Channel8u", numIterations );
+	benchmarkType<float>( "Channel32f", numIterations );
+	return 0;
+}
@@ -0,0 +1,72 @@
+#include "cinder/Cinder.h"
+#include "cinder/app/linux/FramePacer.h"
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace cinder;
+using namespace cinder::app;
+
+// Measures frame time jitter of FramePacer's modes compared to computing the remaining time and calling usleep(), as AppImplLinux used to.
+// Pass the number of frames to run at each frame rate as the first argument (240 by default).
+
+static void print( const string &label, const FrameTimeHistogram &frameTimes, size_t numMissed )
+{
+	cout << left << setw( 14 ) << label << fixed << setprecision( 3 )
+		<< "mean " << frameTimes.getMean() * 1000 << " ms, "
+		<< "stddev " << frameTimes.getStdDev() * 1000 << " ms, "
+		<< "p99 " << frameTimes.getPercentile( 99 ) * 1000 << " ms, "
+		<< "max " << frameTimes.getMax() * 1000 << " ms, "
+		<< numMissed << " missed" << endl;
+}
+
+// The previous AppImplLinux::sleepUntilNextFrame()
+static void measureUsleep( double frameRate, int numFrames )
+{
+	FramePacer frameTimes; // only used to measure with markFrame()
+	const double secondsPerFrame = 1.0 / frameRate;
+	double nextFrameTime = FramePacer::now() / 1e9;
+	size_t numMissed = 0;
+	for( int frame = 0; frame < numFrames; ++frame ) {
+		const double currentSeconds = FramePacer::now() / 1e9;
+		nextFrameTime += secondsPerFrame;
+		if( nextFrameTime > currentSeconds )
+			usleep( (unsigned long)( ( nextFrameTime - currentSeconds ) * 1000000L ) );
+		else
+			numMissed++;
+		frameTimes.markFrame();
+	}
+
+	print( "usleep", frameTimes.getFrameTimes(), numMissed );
+}
+
+static void measure( const string &label, double frameRate, int numFrames, const FramePacer::Options &options )
+{
+	FramePacer pacer( frameRate, options );
+	for( int frame = 0; frame < numFrames; ++frame )
+		pacer.waitForNextFrame();
+
+	print( label, pacer.getFrameTimes(), pacer.getNumMissedDeadlines() );
+	if( options.getMode() == FramePacer::Mode::ADAPTIVE )
+		cout << "              mean oversleep " << pacer.getOversleepTimes().getMean() * 1e6 << " us, spinning " << pacer.getSpinSeconds() * 1e6 << " us" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numFrames = argc > 1 ? atoi( argv[1] ) : 240;
+
+	for( double frameRate : { 60.0, 120.0, 240.0 } ) {
+		cout << frameRate << " Hz (" << 1000 / frameRate << " ms)" << endl;
+		measureUsleep( frameRate, numFrames );
+		measure( "SLEEP", frameRate, numFrames, FramePacer::Options().mode( FramePacer::Mode::SLEEP ) );
+		measure( "SLEEP_SPIN", frameRate, numFrames, FramePacer::Options().mode( FramePacer::Mode::SLEEP_SPIN ) );
+		measure( "ADAPTIVE", frameRate, numFrames, FramePacer::Options().mode( FramePacer::Mode::ADAPTIVE ) );
+		cout << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "cinder/Cinder.h"
+#include "cinder/GeomIo.h"
+#include "cinder/TriMesh.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace std;
+using namespace cinder;
+
+// Measures generating each of the parametric primitives, both captured by a geom::SourceModsContext and loaded into a TriMesh, followed by
+// loading a geom::Source through a chain of 5 modifiers into a TriMesh, compared to loading the Source alone.
+// Pass the number of vertices per side of the source plane as the first argument (1000 by default, for 1M vertices); the other primitives
+// are subdivided to a similar number of vertices.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+// Calls \a load \a numIterations times, printing the first and the average of the remaining calls. \a load returns the number of vertices loaded.
+template<typename LoadFn>
+static void measure( const string &label, int numIterations, const LoadFn &load )
+{
+	double first = 0, rest = 0;
+	size_t numVertices = 0;
+	for( int i = 0; i < numIterations; ++i ) {
+		auto start = Clock::now();
+		numVertices = load();
+		double seconds = secondsSince( start );
+		if( i == 0 )
+			first = seconds;
+		else
+			rest += seconds;
+	}
+
+	cout << left << setw( 28 ) << label << fixed << setprecision( 1 ) << "first " << first * 1000 << " ms, then "
+		<< rest * 1000 / std::max( numIterations - 1, 1 ) << " ms\t(" << numVertices << " vertices)" << endl;
+}
+
+// Loads \a source into a TriMesh
+static void measure( const string &label, const geom::Source &source, int numIterations )
+{
+	const TriMesh::Format format = TriMesh::Format().positions().normals().texCoords().colors( 3 );
+	measure( label, numIterations, [&] { return TriMesh( source, format ).getNumVertices(); } );
+}
+
+// Loads \a source into a SourceModsContext, and then into a TriMesh
+static void measureGeneration( const string &label, const geom::Source &source, int numIterations )
+{
+	measure( label, numIterations, [&] {
+		geom::SourceModsContext context;
+		source.loadInto( &context, { geom::POSITION, geom::NORMAL, geom::TEX_COORD_0, geom::COLOR } );
+		return context.getNumVertices();
+	} );
+	measure( "  into TriMesh", source, numIterations );
+}
+
+int main( int argc, char *argv[] )
+{
+	const int side = argc > 1 ? atoi( argv[1] ) : 1000;
+	const int numIterations = 6;
+
+	const auto plane = geom::Plane().subdivisions( ivec2( side - 1 ) ).size( vec2( 4 ) );
+	measureGeneration( "geom::Plane", plane, numIterations );
+	measureGeneration( "geom::Sphere", geom::Sphere().subdivisions( side * 2 ), numIterations );
+	measureGeneration( "geom::Torus", geom::Torus().subdivisionsAxis( side ).subdivisionsHeight( side ), numIterations );
+	measureGeneration( "geom::Cylinder", geom::Cylinder().subdivisionsAxis( side ).subdivisionsHeight( side ), numIterations );
+	measureGeneration( "geom::Icosphere", geom::Icosphere().subdivisions( 5 ), numIterations );
+	cout << endl;
+
+	auto chain = plane
+		>> geom::Rotate( 0.5f, vec3( 1, 0, 0 ) )
+		>> geom::Twist().axis( vec3( 0, 0, -2 ), vec3( 0, 0, 2 ) ).startAngle( 0 ).endAngle( 1 )
+		>> geom::Translate( 0, 1, 0 )
+		>> geom::Constant( geom::COLOR, vec3( 1, 0.5f, 0.25f ) )
+		>> geom::AttribFn<vec2, vec2>( geom::TEX_COORD_0, []( vec2 t ) { return t * 2.0f; } );
+	measure( "with 5 modifiers", chain, numIterations );
+
+	return 0;
+}
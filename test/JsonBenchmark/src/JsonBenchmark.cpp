@@ -0,0 +1,131 @@
+#include "cinder/Cinder.h"
+#include "cinder/Json.h"
+#include "cinder/JsonDocument.h"
+#include "cinder/Rand.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+using namespace cinder;
+
+// Compares parsing a large JSON document with JsonTree (jsoncpp) against json::Reader (SAX) and json::Document,
+// as well as key lookups within the resulting trees. Pass the approximate document size in megabytes as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+//! Generates a scene description like document of about \a targetSize bytes.
+static string generateScene( size_t targetSize )
+{
+	Rand rand( 1234 );
+	ostringstream ss;
+	ss << "{ \"version\": 3, \"name\": \"benchmark scene\", \"nodes\": [\n";
+
+	size_t index = 0;
+	while( (size_t)ss.tellp() < targetSize ) {
+		if( index > 0 )
+			ss << ",\n";
+		ss << "{ \"id\": " << index << ", \"name\": \"node_" << index << "\", \"visible\": " << ( index % 3 ? "true" : "false" )
+			<< ", \"transform\": { \"position\": [" << rand.nextFloat( -100, 100 ) << ", " << rand.nextFloat( -100, 100 ) << ", " << rand.nextFloat( -100, 100 ) << "]"
+			<< ", \"rotation\": [" << rand.nextFloat() << ", " << rand.nextFloat() << ", " << rand.nextFloat() << ", " << rand.nextFloat() << "]"
+			<< ", \"scale\": 1.0 }"
+			<< ", \"material\": { \"shader\": \"pbr\", \"albedo\": \"textures/albedo_" << index % 64 << ".png\", \"roughness\": " << rand.nextFloat()
+			<< ", \"tags\": [\"static\", \"shadow\\tcaster\", \"lod\"] } }";
+		index++;
+	}
+
+	ss << "\n] }";
+	return ss.str();
+}
+
+class CountingHandler : public json::Handler {
+  public:
+	bool onNull() override										{ mNumValues++; return true; }
+	bool onBool( bool ) override								{ mNumValues++; return true; }
+	bool onInt( int64_t ) override								{ mNumValues++; return true; }
+	bool onUint( uint64_t ) override							{ mNumValues++; return true; }
+	bool onDouble( double ) override							{ mNumValues++; return true; }
+	bool onString( const char *, size_t length ) override		{ mNumValues++; mNumStringBytes += length; return true; }
+	bool onEndObject( size_t ) override							{ mNumValues++; return true; }
+	bool onEndArray( size_t ) override							{ mNumValues++; return true; }
+
+	size_t mNumValues = 0, mNumStringBytes = 0;
+};
+
+static void printResult( const string &label, double seconds, size_t numBytes )
+{
+	cout << left << setw( 40 ) << label << fixed << setprecision( 1 ) << seconds * 1000 << " ms"
+		<< "\t(" << ( numBytes / ( 1024.0 * 1024.0 ) ) / seconds << " MB/s)" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t sizeMb = argc > 1 ? atoi( argv[1] ) : 20;
+	const string jsonString = generateScene( sizeMb * 1024 * 1024 );
+	cout << "document size: " << jsonString.size() / ( 1024.0 * 1024.0 ) << " MB" << endl << endl;
+
+	// parsing
+	auto start = Clock::now();
+	JsonTree tree( jsonString );
+	printResult( "JsonTree( string )", secondsSince( start ), jsonString.size() );
+
+	start = Clock::now();
+	CountingHandler handler;
+	json::Reader().parse( jsonString, &handler );
+	printResult( "json::Reader (SAX, const input)", secondsSince( start ), jsonString.size() );
+
+	start = Clock::now();
+	string inSituCopy = jsonString;
+	json::Reader().parseInSitu( &inSituCopy[0], inSituCopy.size(), &handler );
+	printResult( "json::Reader (SAX, in situ, incl. copy)", secondsSince( start ), jsonString.size() );
+
+	start = Clock::now();
+	json::Reader().parse( DataSourceBuffer::create( Buffer::create( (void *)jsonString.data(), jsonString.size() ) ), &handler );
+	printResult( "json::Reader (SAX, streamed)", secondsSince( start ), jsonString.size() );
+
+	start = Clock::now();
+	json::Document document( jsonString );
+	printResult( "json::Document( string )", secondsSince( start ), jsonString.size() );
+	cout << "\tDocument memory usage: " << document.getMemoryUsage() / ( 1024.0 * 1024.0 ) << " MB" << endl;
+
+	start = Clock::now();
+	JsonTree treeFromDocument( document );
+	printResult( "JsonTree( json::Document )", secondsSince( start ), jsonString.size() );
+
+	// lookups
+	const auto &nodes = document.getRoot()["nodes"];
+	const size_t numNodes = nodes.getSize();
+	const size_t numLookups = 100000;
+	cout << endl << "lookups (" << numLookups << " random nodes of " << numNodes << "):" << endl;
+
+	Rand rand( 4321 );
+	vector<string> paths;
+	for( size_t i = 0; i < numLookups; i++ )
+		paths.push_back( "nodes." + to_string( rand.nextUint( (uint32_t)numNodes ) ) + ".material.roughness" );
+
+	double sum = 0;
+	start = Clock::now();
+	for( size_t i = 0; i < numLookups / 100; i++ )
+		sum += tree.getValueForKey<double>( paths[i] );
+	cout << left << setw( 40 ) << "JsonTree::getValueForKey()" << secondsSince( start ) * 1e9 / ( numLookups / 100 ) << " ns per lookup" << endl;
+
+	start = Clock::now();
+	for( const auto &path : paths )
+		sum += document.getChild( path ).getDouble();
+	cout << left << setw( 40 ) << "json::Document::getChild()" << secondsSince( start ) * 1e9 / numLookups << " ns per lookup" << endl;
+
+	start = Clock::now();
+	for( size_t i = 0; i < numLookups; i++ )
+		sum += nodes[i % numNodes]["transform"]["scale"].getDouble();
+	cout << left << setw( 40 ) << "json::Value::operator[]( key )" << secondsSince( start ) * 1e9 / numLookups << " ns per lookup" << endl;
+
+	cout << "(checksum: " << sum << ")" << endl;
+	return 0;
+}
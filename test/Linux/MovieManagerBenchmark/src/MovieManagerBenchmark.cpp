@@ -0,0 +1,143 @@
+#include "cinder/Cinder.h"
+#include "cinder/linux/MovieManager.h"
+
+#include <sys/resource.h>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cinder;
+
+// Plays N test-source streams at once through MovieManager, as a video wall would. Each stream encodes and decodes JPEG so that
+// it has a decoder to measure. Reports per-stream decode latency and dropped frames, the process's CPU time and thread count,
+// throughput when decoding as fast as possible within a memory budget, and the time to the first frame with and without pre-rolling.
+// Pass the number of streams and the seconds to play for as arguments (16 and 5 by default).
+
+typedef chrono::steady_clock Clock;
+
+static const string sPipeline = "videotestsrc pattern=ball ! video/x-raw,width=640,height=360,framerate=30/1 ! jpegenc ! jpegdec";
+static const size_t sFrameBytes = 640 * 360 * 4;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+static double cpuSeconds()
+{
+	rusage usage;
+	::getrusage( RUSAGE_SELF, &usage );
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) * 1e-6;
+}
+
+static string numThreads()
+{
+	ifstream status( "/proc/self/status" );
+	string line;
+	while( getline( status, line ) ) {
+		if( line.compare( 0, 8, "Threads:" ) == 0 )
+			return line.substr( 8 );
+	}
+	return " ?";
+}
+
+static void printStats( const vector<qtime::MovieSurfaceRef> &movies )
+{
+	size_t decoded = 0, dropped = 0;
+	double latency = 0, maxLatency = 0;
+	for( size_t i = 0; i < movies.size(); ++i ) {
+		const auto stats = movies[i]->getStats();
+		cout << "  stream " << setw( 2 ) << i << ": " << setw( 5 ) << stats.mNumFramesDecoded << " decoded, " << setw( 4 ) << stats.mNumFramesDropped << " dropped, "
+			 << fixed << setprecision( 2 ) << stats.mDecodeLatency * 1000 << " ms latency (max " << stats.mMaxDecodeLatency * 1000 << " ms), "
+			 << stats.mMaxQueuedFrames << " queued frames" << endl;
+		decoded += stats.mNumFramesDecoded;
+		dropped += stats.mNumFramesDropped;
+		latency += stats.mDecodeLatency / movies.size();
+		maxLatency = std::max( maxLatency, stats.mMaxDecodeLatency );
+	}
+	cout << "  total: " << decoded << " decoded, " << dropped << " dropped, " << latency * 1000 << " ms mean latency (max " << maxLatency * 1000 << " ms)" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t numStreams = argc > 1 ? atoi( argv[1] ) : 16;
+	const double seconds = argc > 2 ? atof( argv[2] ) : 5.0;
+	auto &manager = qtime::MovieManager::instance();
+	cout << numStreams << " streams, " << manager.getOptions().getMaxDecodeThreads() << " decode threads" << endl;
+
+	// a video wall, reading each stream's latest frame at 60Hz
+	{
+		vector<qtime::MovieSurfaceRef> movies;
+		for( size_t i = 0; i < numStreams; ++i )
+			movies.push_back( qtime::MovieSurface::createFromPipeline( sPipeline ) );
+		for( auto &movie : movies )
+			movie->play();
+
+		const double startCpu = cpuSeconds();
+		const auto start = Clock::now();
+		size_t numSurfaces = 0;
+		while( secondsSince( start ) < seconds ) {
+			for( auto &movie : movies )
+				numSurfaces += movie->getSurface() ? 1 : 0;
+			this_thread::sleep_for( chrono::milliseconds( 16 ) );
+		}
+
+		cout << endl << "realtime playback:" << endl;
+		printStats( movies );
+		cout << "  " << fixed << setprecision( 2 ) << ( cpuSeconds() - startCpu ) / seconds * 100 << "% CPU," << numThreads() << " threads, "
+			 << manager.getNumDecodeThreadsPerStream() << " decode threads per stream (" << numSurfaces << " surfaces read)" << endl;
+	}
+
+	// decoding as fast as possible, with a budget of two frames per stream
+	{
+		manager.setOptions( qtime::MovieManager::Options().maxQueuedBytes( numStreams * sFrameBytes * 2 ) );
+		vector<qtime::MovieSurfaceRef> movies;
+		for( size_t i = 0; i < numStreams; ++i )
+			movies.push_back( qtime::MovieSurface::createFromPipeline( sPipeline, qtime::MovieSurface::Options().realtime( false ).numBuffers( 8 ) ) );
+		for( auto &movie : movies )
+			movie->play();
+
+		const auto start = Clock::now();
+		size_t numFrames = 0;
+		while( secondsSince( start ) < seconds ) {
+			for( auto &movie : movies )
+				numFrames += movie->pullSurface( 0.1 ) ? 1 : 0;
+		}
+
+		cout << endl << "as fast as possible:" << endl;
+		printStats( movies );
+		cout << "  " << fixed << setprecision( 1 ) << numFrames / seconds << " frames/s, queued frames limited to "
+			 << manager.getQueuedBytesLimit() / ( 1024.0 * 1024.0 ) << " MB of a " << manager.getOptions().getMaxQueuedBytes() / ( 1024.0 * 1024.0 ) << " MB budget" << endl;
+		manager.setOptions( qtime::MovieManager::Options() );
+	}
+
+	// time to the first frame, loading on demand and pre-rolled
+	{
+		cout << endl << "first frame:" << endl;
+		const fs::path path = fs::path( argc > 3 ? argv[3] : "" );
+		if( path.empty() ) {
+			cout << "  pass a movie file as the third argument to measure pre-rolling" << endl;
+			return 0;
+		}
+
+		auto start = Clock::now();
+		auto cold = manager.take<qtime::MovieSurface>( path );
+		cold->waitForNewFrame( 5.0 );
+		cout << "  loaded on demand: " << fixed << setprecision( 2 ) << secondsSince( start ) * 1000 << " ms" << endl;
+
+		manager.preroll<qtime::MovieSurface>( path );
+		this_thread::sleep_for( chrono::seconds( 1 ) );
+		start = Clock::now();
+		auto warm = manager.take<qtime::MovieSurface>( path );
+		warm->waitForNewFrame( 5.0 );
+		cout << "  pre-rolled: " << secondsSince( start ) * 1000 << " ms" << endl;
+	}
+
+	return 0;
+}
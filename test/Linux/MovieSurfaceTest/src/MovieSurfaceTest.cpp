@@ -0,0 +1,105 @@
+#include "cinder/Cinder.h"
+#include "cinder/qtime/QuickTimeGl.h"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <set>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+
+// Exercises MovieSurface without a GPU on videotestsrc pipelines: decoding as fast as possible, holding on to
+// frames while decoding continues, stepping frame by frame and seeking to a frame. Pass a pipeline description
+// as the first argument to use another source, which should produce 60 frames at 30fps.
+
+typedef chrono::steady_clock Clock;
+
+static const string sDefaultPipeline = "videotestsrc num-buffers=60 pattern=ball ! video/x-raw,width=320,height=240,framerate=30/1";
+static int sNumFailures = 0;
+
+static void check( bool condition, const string &description )
+{
+	cout << ( condition ? "  ok    " : "  FAIL  " ) << description << endl;
+	if( ! condition )
+		++sNumFailures;
+}
+
+static bool isFrameTime( double seconds, int frame )
+{
+	return std::abs( seconds - frame / 30.0 ) < 0.001;
+}
+
+static void testDecodeAsFastAsPossible( const string &pipeline )
+{
+	cout << "decode as fast as possible" << endl;
+	auto movie = qtime::MovieSurface::createFromPipeline( pipeline, qtime::MovieSurface::Options().realtime( false ).numBuffers( 4 ) );
+	movie->play();
+
+	// hold on to more frames than the pool starts with, which it grows to accommodate
+	deque<Surface8uRef> held;
+	set<const uint8_t*> heldData;
+	int numFrames = 0;
+	bool timesIncrease = true, sizesMatch = true;
+	double lastTime = -1;
+	const auto start = Clock::now();
+	while( Surface8uRef surface = movie->pullSurface( 2.0 ) ) {
+		sizesMatch = sizesMatch && surface->getWidth() == 320 && surface->getHeight() == 240;
+		timesIncrease = timesIncrease && movie->getSurfaceTime() > lastTime;
+		lastTime = movie->getSurfaceTime();
+		++numFrames;
+
+		held.push_back( surface );
+		if( held.size() > 10 )
+			held.pop_front();
+		if( held.size() == 10 ) {
+			heldData.clear();
+			for( const auto &heldSurface : held )
+				heldData.insert( heldSurface->getData() );
+		}
+	}
+	const double seconds = chrono::duration<double>( Clock::now() - start ).count();
+
+	cout << "  " << numFrames << " frames in " << seconds << " s" << endl;
+	check( numFrames == 60, "every frame was pulled" );
+	check( sizesMatch, "frames are 320x240" );
+	check( timesIncrease, "timestamps increase" );
+	check( heldData.size() == 10, "held frames don't share memory" );
+	check( seconds < 1.0, "decoding isn't paced by the clock" );
+	check( movie->isEndOfStream(), "reached the end of the stream" );
+}
+
+static void testStepAndSeek( const string &pipeline )
+{
+	cout << "stepping and seeking" << endl;
+	auto movie = qtime::MovieSurface::createFromPipeline( pipeline );
+
+	// the pipeline prerolls its first frame while paused
+	check( movie->waitForNewFrame( 2.0 ), "prerolled" );
+	Surface8uRef first = movie->getSurface();
+	check( first && isFrameTime( movie->getSurfaceTime(), 0 ), "prerolled frame 0" );
+
+	bool steppedInOrder = true;
+	for( int frame = 1; frame <= 5; ++frame ) {
+		Surface8uRef surface = movie->stepToNextFrame( 2.0 );
+		steppedInOrder = steppedInOrder && surface && isFrameTime( movie->getSurfaceTime(), frame );
+	}
+	check( steppedInOrder, "stepped through frames 1 to 5" );
+
+	for( int frame : { 20, 7, 41 } ) {
+		Surface8uRef surface = movie->seekToFrameAndWait( frame, 2.0 );
+		check( surface && isFrameTime( movie->getSurfaceTime(), frame ), "seeked to frame " + to_string( frame ) );
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	const string pipeline = argc > 1 ? argv[1] : sDefaultPipeline;
+	testDecodeAsFastAsPossible( pipeline );
+	testStepAndSeek( pipeline );
+
+	cout << ( sNumFailures ? "FAILED" : "passed" ) << endl;
+	return sNumFailures ? 1 : 0;
+}
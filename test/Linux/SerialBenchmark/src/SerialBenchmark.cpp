@@ -0,0 +1,152 @@
+#include "cinder/Cinder.h"
+#include "cinder/Serial.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace cinder;
+
+// Simulates sensor boards on pseudo-terminals, each sending a timestamped line every millisecond, and reads them with a thread per port
+// calling Serial::readStringUntil(), which polls the device, and with Serial::startAsync() and a SerialDelimiterFramer.
+// Reports the CPU time used and the latency from writing a line to receiving it.
+// Pass the number of boards and the seconds to run for as arguments (20 and 3 by default).
+
+typedef chrono::steady_clock Clock;
+
+static double cpuSeconds()
+{
+	rusage usage;
+	::getrusage( RUSAGE_SELF, &usage );
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + ( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) * 1e-6;
+}
+
+static int64_t nowMicroseconds()
+{
+	return chrono::duration_cast<chrono::microseconds>( Clock::now().time_since_epoch() ).count();
+}
+
+struct Board {
+	Board()
+	{
+		mMaster = ::posix_openpt( O_RDWR | O_NOCTTY );
+		::grantpt( mMaster );
+		::unlockpt( mMaster );
+		mSerial = Serial::create( Serial::Device( string( ::ptsname( mMaster ) ).substr( 5 ) ), 115200 );
+	}
+	~Board()
+	{
+		mSerial.reset();
+		::close( mMaster );
+	}
+
+	int			mMaster;
+	SerialRef	mSerial;
+};
+
+struct Latency {
+	Latency() : mNumLines( 0 ), mTotal( 0 ), mMax( 0 ) {}
+
+	void add( const uint8_t *data, size_t size )
+	{
+		const int64_t latency = nowMicroseconds() - atoll( string( data, data + size ).c_str() );
+		lock_guard<mutex> lock( mMutex );
+		++mNumLines;
+		mTotal += latency;
+		mMax = std::max( mMax, latency );
+	}
+
+	mutex	mMutex;
+	int64_t	mNumLines, mTotal, mMax;
+};
+
+static void run( const string &label, vector<unique_ptr<Board>> &boards, double seconds, const function<void ( Latency * )> &startFn, const function<void ()> &stopFn )
+{
+	Latency latency;
+	startFn( &latency );
+
+	atomic<bool> quit( false );
+	vector<thread> senders;
+	for( auto &board : boards ) {
+		int master = board->mMaster;
+		senders.emplace_back( [master, &quit] {
+			while( ! quit ) {
+				const string line = to_string( nowMicroseconds() ) + "\n";
+				ssize_t result = ::write( master, line.data(), line.size() );
+				(void)result;
+				this_thread::sleep_for( chrono::milliseconds( 1 ) );
+			}
+		} );
+	}
+
+	const double cpuStart = cpuSeconds();
+	this_thread::sleep_for( chrono::duration<double>( seconds ) );
+	const double cpu = cpuSeconds() - cpuStart;
+	// stopped while the boards are still sending, as readStringUntil() only times out between bytes
+	stopFn();
+	quit = true;
+	for( auto &sender : senders )
+		sender.join();
+
+	cout << left << setw( 24 ) << label << fixed << setprecision( 2 ) << cpu / seconds << " CPU cores, " << latency.mNumLines << " lines, "
+		 << ( latency.mNumLines ? latency.mTotal / double( latency.mNumLines ) : 0.0 ) << " us mean latency (max " << latency.mMax << " us)" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t numBoards = argc > 1 ? atoi( argv[1] ) : 20;
+	const double seconds = argc > 2 ? atof( argv[2] ) : 3;
+
+	vector<unique_ptr<Board>> boards;
+	for( size_t i = 0; i < numBoards; ++i )
+		boards.emplace_back( new Board );
+	cout << numBoards << " boards sending a line every millisecond" << endl;
+
+	atomic<bool> quitReaders( false );
+	vector<thread> readers;
+	run( "readStringUntil()", boards, seconds, [&]( Latency *latency ) {
+		for( auto &board : boards ) {
+			SerialRef serial = board->mSerial;
+			readers.emplace_back( [serial, latency, &quitReaders] {
+				while( ! quitReaders ) {
+					try {
+						const string line = serial->readStringUntil( '\n', 0, 0.1 );
+						latency->add( (const uint8_t*)line.data(), line.size() );
+					}
+					catch( SerialTimeoutExc & ) {
+					}
+				}
+			} );
+		}
+	}, [&] {
+		quitReaders = true;
+		for( auto &reader : readers )
+			reader.join();
+	} );
+
+	for( auto &board : boards )
+		board->mSerial->flush();
+
+	run( "startAsync()", boards, seconds, [&]( Latency *latency ) {
+		for( auto &board : boards ) {
+			auto options = Serial::AsyncOptions().framer( make_shared<SerialDelimiterFramer>() ).packetFn( [latency]( const uint8_t *data, size_t size ) { latency->add( data, size ); } );
+			board->mSerial->startAsync( options );
+		}
+	}, [&] {
+		for( auto &board : boards )
+			board->mSerial->stopAsync();
+	} );
+
+	return 0;
+}
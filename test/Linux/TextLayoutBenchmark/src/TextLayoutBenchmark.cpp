@@ -0,0 +1,130 @@
+#include "cinder/Cinder.h"
+#include "cinder/Text.h"
+#include "cinder/linux/GlyphCache.h"
+#include "cinder/linux/TextBlock.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+using ci::linux::ftutil::GlyphCache;
+
+// Measures laying out and rasterizing text with TextBox and TextLayout, as a HUD redrawing its labels every frame would, with the
+// glyph cache disabled (every glyph loaded and rendered by FreeType, as before the cache) and with a warm cache.
+// Also compares redrawing a dashboard of 2000 two-line items, a few of which change every frame, with a TextBox per item and
+// with retained TextBlocks drawn into a single Surface.
+// Pass the path of a font as the first argument (the Asap font from the Kaleidoscope sample by default).
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static void measure( const string &label, int numIterations, const Fn &fn )
+{
+	// the warm-up also fills the cache, when it's enabled
+	fn( 0 );
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn( i );
+	cout << left << setw( 36 ) << label << fixed << setprecision( 2 ) << secondsSince( start ) * 1e6 / numIterations << " us per frame" << endl;
+}
+
+static void run( const Font &smallFont, const Font &largeFont )
+{
+	size_t checksum = 0;
+
+	measure( "  20 labels, TextBox", 200, [&]( int frame ) {
+		for( int i = 0; i < 20; ++i ) {
+			Surface label = TextBox().font( smallFont ).text( "Particles: " + to_string( frame * 20 + i ) + "  fps: 59.9" ).size( TextBox::GROW, TextBox::GROW ).render();
+			checksum += label.getWidth();
+		}
+	} );
+
+	measure( "  paragraph, TextBox", 100, [&]( int frame ) {
+		Surface paragraph = TextBox().font( smallFont ).size( 400, TextBox::GROW )
+			.text( "The quick brown fox jumps over the lazy dog " + to_string( frame ) + " times, while the five boxing wizards jump quickly "
+				   "and a wizard's job is to vex chumps quickly in fog. Pack my box with five dozen liquor jugs." ).render();
+		checksum += paragraph.getHeight();
+	} );
+
+	measure( "  3 lines, TextLayout", 100, [&]( int frame ) {
+		TextLayout layout;
+		layout.setFont( largeFont );
+		layout.setColor( Color::white() );
+		layout.addLine( "Level " + to_string( frame % 10 ) );
+		layout.setFont( smallFont );
+		layout.addLine( "Score " + to_string( frame * 1250 ) );
+		layout.addRightLine( "Time 00:" + to_string( 10 + frame % 50 ) );
+		checksum += layout.render( true ).getWidth();
+	} );
+
+	auto &cache = GlyphCache::instance();
+	cout << "  (" << cache.getNumGlyphs() << " cached glyphs, " << cache.getNumBytes() / 1024 << " KB, " << cache.getNumHits() << " hits, "
+		 << cache.getNumMisses() << " misses, checksum " << checksum << ")" << endl;
+}
+
+static string itemText( int item, int frame )
+{
+	return "Sensor " + to_string( item ) + "\n" + to_string( ( item * 7919 + frame * 31 ) % 100000 ) + " readings";
+}
+
+static void runDashboard( const Font &font )
+{
+	const int numItems = 2000, numChangedPerFrame = 50;
+	size_t checksum = 0;
+
+	measure( "  TextBox per item", 5, [&]( int frame ) {
+		for( int i = 0; i < numItems; ++i ) {
+			Surface item = TextBox().font( font ).text( itemText( i, frame ) ).size( 120, TextBox::GROW ).render();
+			checksum += item.getHeight();
+		}
+	} );
+
+	vector<ci::linux::TextBlock> blocks( numItems );
+	for( int i = 0; i < numItems; ++i )
+		blocks[i].font( font ).width( 120 ).text( itemText( i, 0 ) );
+
+	vector<Area> areas;
+	measure( "  TextBlocks into one Surface", 20, [&]( int frame ) {
+		for( int i = 0; i < numChangedPerFrame; ++i ) {
+			const int item = ( frame * numChangedPerFrame + i ) % numItems;
+			blocks[item].setText( itemText( item, frame ) );
+		}
+		Surface atlas = ci::linux::renderTextBlocks( blocks, 2048, &areas );
+		checksum += atlas.getHeight();
+	} );
+
+	size_t numShaped = 0;
+	for( const auto &block : blocks )
+		numShaped += block.getNumParagraphsShaped();
+	cout << "  (" << numShaped << " paragraphs shaped, checksum " << checksum << ")" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const fs::path fontPath = argc > 1 ? fs::path( argv[1] ) : fs::path( __FILE__ ).parent_path() / "../../../../samples/Kaleidoscope/resources/Asap-Regular.ttf";
+	const Font smallFont( loadFile( fontPath ), 14 ), largeFont( loadFile( fontPath ), 32 );
+
+	auto &cache = GlyphCache::instance();
+	const size_t maxBytes = cache.getMaxBytes();
+
+	cout << "glyph cache disabled" << endl;
+	cache.setMaxBytes( 0 );
+	run( smallFont, largeFont );
+
+	cout << endl << "glyph cache enabled" << endl;
+	cache.setMaxBytes( maxBytes );
+	run( smallFont, largeFont );
+
+	cout << endl << "dashboard" << endl;
+	runDashboard( smallFont );
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+#include "cinder/Cinder.h"
+#include "cinder/Log.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+using namespace cinder;
+
+// Measures throughput and per-call latency of ci::log, comparing synchronous logging with the asynchronous backend.
+// Run with a Release build; CI_LOG_V is compiled out there (CI_MIN_LOG_LEVEL defaults to 2) which is also measured.
+
+typedef chrono::steady_clock Clock;
+
+static const int NUM_ENTRIES_PER_THREAD = 100000;
+
+//! Counts entries but otherwise discards them, measuring the cost of the logging infrastructure itself
+class LoggerNull : public log::Logger {
+  public:
+	void write( const log::Metadata &meta, const std::string &text ) override
+	{
+		mCount++;
+	}
+
+	atomic<size_t> mCount { 0 };
+};
+
+struct Result {
+	double			mEntriesPerSecond;
+	double			mLatencyMedian, mLatency99, mLatencyMax; // nanoseconds
+};
+
+static Result runThreads( int numThreads )
+{
+	vector<vector<double>> latencies( numThreads, vector<double>( NUM_ENTRIES_PER_THREAD ) );
+	vector<thread> threads;
+
+	auto start = Clock::now();
+	for( int t = 0; t < numThreads; t++ ) {
+		threads.emplace_back( [t, &latencies] {
+			auto &threadLatencies = latencies[t];
+			for( int i = 0; i < NUM_ENTRIES_PER_THREAD; i++ ) {
+				auto callStart = Clock::now();
+				CI_LOG_I( "frame " << i << " of thread " << t << ", value: " << i * 0.5f );
+				threadLatencies[i] = (double)chrono::duration_cast<chrono::nanoseconds>( Clock::now() - callStart ).count();
+			}
+		} );
+	}
+
+	for( auto &t : threads )
+		t.join();
+
+	log::manager()->flush();
+	double seconds = chrono::duration<double>( Clock::now() - start ).count();
+
+	vector<double> all;
+	for( const auto &l : latencies )
+		all.insert( all.end(), l.begin(), l.end() );
+	sort( all.begin(), all.end() );
+
+	Result result;
+	result.mEntriesPerSecond = all.size() / seconds;
+	result.mLatencyMedian = all[all.size() / 2];
+	result.mLatency99 = all[all.size() * 99 / 100];
+	result.mLatencyMax = all.back();
+	return result;
+}
+
+static void printResult( const string &label, int numThreads, const Result &result )
+{
+	cout << left << setw( 34 ) << label << " threads: " << numThreads
+		<< fixed << setprecision( 0 )
+		<< "\tentries/s: " << setw( 10 ) << result.mEntriesPerSecond
+		<< "\tlatency median: " << result.mLatencyMedian << "ns, 99%: " << result.mLatency99 << "ns, max: " << result.mLatencyMax << "ns"
+		<< " (dropped: " << log::manager()->getNumDroppedEntries() << ")" << endl;
+}
+
+static void benchConfigurations( const string &loggerLabel )
+{
+	for( int numThreads : { 1, 4 } ) {
+		log::manager()->disableAsync();
+		printResult( loggerLabel + ", sync", numThreads, runThreads( numThreads ) );
+
+		log::manager()->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::DROP ) );
+		printResult( loggerLabel + ", async (drop)", numThreads, runThreads( numThreads ) );
+
+		log::manager()->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::BLOCK ) );
+		printResult( loggerLabel + ", async (block)", numThreads, runThreads( numThreads ) );
+
+		log::manager()->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::BLOCK ).queueSize( 1024 * 1024 ) );
+		printResult( loggerLabel + ", async (block, 1mb queue)", numThreads, runThreads( numThreads ) );
+	}
+
+	log::manager()->disableAsync();
+}
+
+static void benchCompiledOut()
+{
+	auto start = Clock::now();
+	for( int i = 0; i < NUM_ENTRIES_PER_THREAD; i++ ) {
+		CI_LOG_V( "compiled out when CI_MIN_LOG_LEVEL > 0: " << i );
+	}
+	double ns = (double)chrono::duration_cast<chrono::nanoseconds>( Clock::now() - start ).count();
+
+	cout << "CI_LOG_V (CI_MIN_LOG_LEVEL: " << CI_MIN_LOG_LEVEL << ") per call: " << setprecision( 2 ) << ns / NUM_ENTRIES_PER_THREAD << "ns" << endl;
+}
+
+int main()
+{
+	auto nullLogger = make_shared<LoggerNull>();
+	log::manager()->resetLogger( nullLogger );
+	benchConfigurations( "null logger" );
+
+	auto filePath = fs::temp_directory_path() / "cinder_log_benchmark.log";
+	log::manager()->resetLogger( make_shared<log::LoggerFile>( filePath, false ) );
+	benchConfigurations( "file logger" );
+
+	log::manager()->resetLogger( nullLogger );
+	benchCompiledOut();
+
+	log::manager()->restoreToDefault();
+	fs::remove( filePath );
+
+	return 0;
+}
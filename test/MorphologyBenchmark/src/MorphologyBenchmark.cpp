@@ -0,0 +1,89 @@
+#include "cinder/Cinder.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/ConnectedComponents.h"
+#include "cinder/ip/Morphology.h"
+#include "cinder/ip/Threshold.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+
+// Erodes a 1080p Channel8u with square elements of increasing size, comparing a per-pixel loop over the element with ip::erode()
+// serially and in parallel, whose cost doesn't depend on the element's size. Then labels the blobs of a thresholded and opened
+// noise image with ip::findConnectedComponents(). Pass the number of iterations as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static double measure( int numIterations, const Fn &fn )
+{
+	fn(); // warm up
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	return secondsSince( start ) * 1000 / numIterations;
+}
+
+// The kind of loop written without ip::erode()
+static void perPixelErode( const Channel8u &src, int32_t size, Channel8u *dst )
+{
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x ) {
+			uint8_t value = 255;
+			for( int32_t ky = -size / 2; ky < size - size / 2; ++ky ) {
+				for( int32_t kx = -size / 2; kx < size - size / 2; ++kx )
+					value = std::min( value, src.getValue( ivec2( x + kx, y + ky ) ) );
+			}
+			dst->setValue( ivec2( x, y ), value );
+		}
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numIterations = argc > 1 ? atoi( argv[1] ) : 5;
+	cout << "1920x1080, " << numIterations << " iterations" << endl;
+
+	Rand rand( 1234 );
+	Channel8u src( 1920, 1080 ), dst( 1920, 1080 );
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x )
+			src.setValue( ivec2( x, y ), (uint8_t)rand.nextInt( 256 ) );
+	}
+
+	for( int32_t size : { 3, 7, 15, 31, 63 } ) {
+		// the per-pixel loop is too slow to be worth waiting for with large elements
+		const bool runPerPixel = size <= 7;
+		const double perPixel = runPerPixel ? measure( 1, [&] { perPixelErode( src, size, &dst ); } ) : 0;
+		const double serial = measure( numIterations, [&] { ip::erode( src, &dst, ivec2( size ), false ); } );
+		const double parallel = measure( numIterations, [&] { ip::erode( src, &dst, ivec2( size ) ); } );
+
+		ostringstream perPixelText;
+		if( runPerPixel )
+			perPixelText << fixed << setprecision( 2 ) << perPixel << " ms";
+		cout << "  " << left << setw( 14 ) << ( "erode " + to_string( size ) + "x" + to_string( size ) ) << fixed << setprecision( 2 ) << "per pixel "
+			<< setw( 12 ) << perPixelText.str() << "serial " << setw( 8 ) << serial << " ms   parallel " << setw( 8 ) << parallel << " ms" << endl;
+	}
+
+	// blobs of roughly 7 pixels across, grown from 1 in 256 pixels
+	Channel8u blobs( 1920, 1080 );
+	ip::threshold( src, (uint8_t)254, &blobs );
+	ip::dilate( &blobs, ivec2( 7 ) );
+	size_t numBlobs = 0;
+	vector<uint32_t> labels;
+	const double serial = measure( numIterations, [&] { numBlobs = ip::findConnectedComponents( blobs, &labels, ip::ConnectedComponentsOptions().parallel( false ) ).size(); } );
+	const double parallel = measure( numIterations, [&] { ip::findConnectedComponents( blobs, &labels ); } );
+	cout << endl << "  " << left << setw( 14 ) << "components" << fixed << setprecision( 2 ) << "serial " << setw( 8 ) << serial << " ms   parallel "
+		<< setw( 8 ) << parallel << " ms   (" << numBlobs << " blobs)" << endl;
+	return 0;
+}
@@ -0,0 +1,120 @@
+#include "cinder/Cinder.h"
+#include "cinder/Path2d.h"
+#include "cinder/Rand.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+
+using namespace std;
+using namespace cinder;
+
+// Compares point queries against many paths using Path2d directly and through Path2dCalcCache, one point at a time and in batches.
+// Pass the number of paths as the first argument and the number of points per path as the second.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+static Path2d generatePath( Rand &rand )
+{
+	const vec2 center( rand.nextFloat( 1000 ), rand.nextFloat( 1000 ) );
+	const float radius = rand.nextFloat( 10, 60 );
+	Path2d result;
+	result.moveTo( center + vec2( radius, 0 ) );
+	const int numSegments = 16;
+	for( int i = 1; i <= numSegments; ++i ) {
+		float angle = i * 2 * (float)M_PI / numSegments;
+		vec2 pt = center + radius * rand.nextFloat( 0.7f, 1.0f ) * vec2( cos( angle ), sin( angle ) );
+		vec2 control = center + radius * 1.2f * vec2( cos( angle - 0.2f ), sin( angle - 0.2f ) );
+		if( i % 2 )
+			result.quadTo( control, pt );
+		else
+			result.curveTo( control, center + radius * vec2( cos( angle - 0.1f ), sin( angle - 0.1f ) ), pt );
+	}
+	result.close();
+	return result;
+}
+
+static void printResult( const string &label, double seconds, size_t numQueries )
+{
+	cout << left << setw( 44 ) << label << fixed << setprecision( 1 ) << setw( 10 ) << seconds * 1000 << " ms"
+		<< "\t(" << setprecision( 3 ) << seconds * 1e9 / numQueries << " ns per query)" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t numPaths = argc > 1 ? atoi( argv[1] ) : 2000;
+	const size_t numPoints = argc > 2 ? atoi( argv[2] ) : 200;
+
+	Rand rand( 1234 );
+	vector<Path2d> paths;
+	for( size_t i = 0; i < numPaths; ++i )
+		paths.push_back( generatePath( rand ) );
+
+	vector<vec2> points;
+	for( size_t i = 0; i < numPoints; ++i )
+		points.push_back( vec2( rand.nextFloat( 1000 ), rand.nextFloat( 1000 ) ) );
+
+	const size_t numQueries = numPaths * numPoints;
+	cout << numPaths << " paths, " << numPoints << " points" << endl << endl;
+
+	auto start = Clock::now();
+	vector<Path2dCalcCache> caches;
+	for( const auto &path : paths )
+		caches.emplace_back( path );
+	cout << left << setw( 44 ) << "building caches" << secondsSince( start ) * 1000 << " ms" << endl;
+
+	size_t numInside = 0;
+	start = Clock::now();
+	for( const auto &path : paths ) {
+		for( const auto &pt : points )
+			numInside += path.contains( pt );
+	}
+	printResult( "Path2d::contains()", secondsSince( start ), numQueries );
+
+	size_t numInsideCached = 0;
+	start = Clock::now();
+	for( const auto &cache : caches ) {
+		for( const auto &pt : points )
+			numInsideCached += cache.contains( pt );
+	}
+	printResult( "Path2dCalcCache::contains()", secondsSince( start ), numQueries );
+
+	unique_ptr<bool[]> inside( new bool[numPoints] );
+	start = Clock::now();
+	for( const auto &cache : caches )
+		cache.contains( points.data(), points.size(), inside.get() );
+	printResult( "Path2dCalcCache::contains( points[] )", secondsSince( start ), numQueries );
+
+	// the exact distance is expensive, so only a subset of the paths is queried directly
+	const size_t numDistancePaths = std::max<size_t>( numPaths / 20, 1 );
+	double distanceSum = 0;
+	start = Clock::now();
+	for( size_t p = 0; p < numDistancePaths; ++p ) {
+		for( const auto &pt : points )
+			distanceSum += paths[p].calcDistance( pt );
+	}
+	printResult( "Path2d::calcDistance()", secondsSince( start ), numDistancePaths * numPoints );
+
+	double distanceSumCached = 0;
+	start = Clock::now();
+	for( size_t p = 0; p < numDistancePaths; ++p ) {
+		for( const auto &pt : points )
+			distanceSumCached += caches[p].calcDistance( pt );
+	}
+	printResult( "Path2dCalcCache::calcDistance()", secondsSince( start ), numDistancePaths * numPoints );
+
+	vector<float> distances( numPoints );
+	start = Clock::now();
+	for( const auto &cache : caches )
+		cache.calcDistances( points.data(), points.size(), distances.data() );
+	printResult( "Path2dCalcCache::calcDistances( points[] )", secondsSince( start ), numQueries );
+
+	cout << "(checksums: " << numInside << " / " << numInsideCached << ", " << distanceSum << " / " << distanceSumCached << ")" << endl;
+	return 0;
+}
@@ -0,0 +1,111 @@
+#include "cinder/Cinder.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/Statistics.h"
+#include "cinder/ip/Threshold.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+
+// Calculates histograms and statistics of a 1080p RGBA Surface and one of its Channels, comparing per-pixel loops over
+// getPixel() with ip::calcHistograms() and ip::calcStatistics() serially and in parallel, for uint8_t, uint16_t and float.
+// Pass the number of iterations as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static double measure( int numIterations, const Fn &fn )
+{
+	fn(); // warm up
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	return secondsSince( start ) * 1000 / numIterations;
+}
+
+// perPixel is negative for rows without a per-pixel loop
+static void printRow( const string &label, double perPixel, double serial, double parallel )
+{
+	ostringstream perPixelText;
+	if( perPixel >= 0 )
+		perPixelText << fixed << setprecision( 2 ) << perPixel << " ms";
+	cout << "  " << left << setw( 20 ) << label << fixed << setprecision( 2 ) << "per pixel " << setw( 12 ) << perPixelText.str() << "serial "
+		<< setw( 8 ) << serial << " ms   parallel " << setw( 8 ) << parallel << " ms" << endl;
+}
+
+template<typename T>
+static void benchmarkType( const string &typeName, int numIterations )
+{
+	Rand rand( 1234 );
+	SurfaceT<T> surface( 1920, 1080, true );
+	for( int32_t y = 0; y < surface.getHeight(); ++y ) {
+		for( int32_t x = 0; x < surface.getWidth(); ++x )
+			surface.setPixel( ivec2( x, y ), ColorAf( rand.nextFloat(), rand.nextFloat(), rand.nextFloat(), rand.nextFloat() ) );
+	}
+	const ChannelT<T> channel = surface.getChannelGreen().clone();
+
+	// the kind of loops written without ip::calcHistograms() and ip::calcStatistics()
+	vector<uint32_t> bins( 4 * 256 );
+	const float scale = 256.0f / ( std::is_floating_point<T>::value ? 1.0f : CHANTRAIT<T>::max() + 1.0f );
+	auto perPixelHistograms = [&] {
+		std::fill( bins.begin(), bins.end(), 0 );
+		for( int32_t y = 0; y < surface.getHeight(); ++y ) {
+			for( int32_t x = 0; x < surface.getWidth(); ++x ) {
+				const ColorAT<T> pixel = surface.getPixel( ivec2( x, y ) );
+				for( int c = 0; c < 4; ++c )
+					++bins[c * 256 + std::min( (int)( pixel[c] * scale ), 255 )];
+			}
+		}
+	};
+	double sums[8];
+	auto perPixelStatistics = [&] {
+		std::fill( sums, sums + 8, 0.0 );
+		for( int32_t y = 0; y < surface.getHeight(); ++y ) {
+			for( int32_t x = 0; x < surface.getWidth(); ++x ) {
+				const ColorAT<T> pixel = surface.getPixel( ivec2( x, y ) );
+				for( int c = 0; c < 4; ++c ) {
+					sums[c] += pixel[c];
+					sums[c + 4] += (double)pixel[c] * pixel[c];
+				}
+			}
+		}
+	};
+
+	cout << typeName << endl;
+	printRow( "Surface histograms", measure( 1, perPixelHistograms ),
+		measure( numIterations, [&] { ip::calcHistograms( surface, ip::HistogramOptions().parallel( false ) ); } ),
+		measure( numIterations, [&] { ip::calcHistograms( surface ); } ) );
+	printRow( "Surface statistics", measure( 1, perPixelStatistics ),
+		measure( numIterations, [&] { ip::calcStatistics( surface, false ); } ),
+		measure( numIterations, [&] { ip::calcStatistics( surface ); } ) );
+	printRow( "Channel histogram", -1,
+		measure( numIterations, [&] { ip::calcHistogram( channel, ip::HistogramOptions().parallel( false ) ); } ),
+		measure( numIterations, [&] { ip::calcHistogram( channel ); } ) );
+	printRow( "Channel statistics", -1,
+		measure( numIterations, [&] { ip::calcStatistics( channel, false ); } ),
+		measure( numIterations, [&] { ip::calcStatistics( channel ); } ) );
+
+	ChannelT<T> binary( channel.getWidth(), channel.getHeight() );
+	const double otsu = measure( numIterations, [&] { ip::thresholdOtsu( channel, &binary ); } );
+	cout << "  " << left << setw( 20 ) << "thresholdOtsu" << fixed << setprecision( 2 ) << otsu << " ms" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numIterations = argc > 1 ? atoi( argv[1] ) : 10;
+	cout << "1920x1080 RGBA, " << numIterations << " iterations" << endl;
+	benchmarkType<uint8_t>( "uint8_t", numIterations );
+	benchmarkType<uint16_t>( "uint16_t", numIterations );
+	benchmarkType<float>( "float", numIterations );
+	return 0;
+}
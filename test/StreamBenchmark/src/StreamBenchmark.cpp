@@ -0,0 +1,121 @@
+#include "cinder/Cinder.h"
+#include "cinder/DataSource.h"
+#include "cinder/Stream.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using namespace cinder;
+
+// Compares reading a file through the existing file streams and DataSourcePath with reading it through a memory mapping: the whole file as a Buffer,
+// in fixed size reads, and a line at a time. The file is read once beforehand so that all of the measurements hit the OS file cache.
+// Pass the size of the file in megabytes as the first argument (256 by default).
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+// Sums every 64th byte, so that the data is touched without the sum dominating the measurement
+static uint64_t checksum( const void *data, size_t size )
+{
+	uint64_t result = 0;
+	for( size_t i = 0; i < size; i += 64 )
+		result += static_cast<const uint8_t*>( data )[i];
+	return result;
+}
+
+// Calls \a read \a numIterations times, printing the average throughput. \a read returns a checksum of the data, which is printed to verify the variants agree.
+template<typename ReadFn>
+static void measure( const string &label, size_t fileSize, int numIterations, const ReadFn &read )
+{
+	uint64_t sum = 0;
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		sum = read();
+	double seconds = secondsSince( start ) / numIterations;
+
+	cout << left << setw( 36 ) << label << fixed << setprecision( 1 ) << seconds * 1000 << " ms\t" << fileSize / seconds / ( 1024 * 1024 ) << " MB/s\t(checksum " << sum << ")" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t fileSize = size_t( argc > 1 ? atoi( argv[1] ) : 256 ) * 1024 * 1024;
+	const int numIterations = 5;
+	const size_t readSize = 16 * 1024;
+
+	// lines of 0 to 99 printable characters
+	const fs::path path = fs::temp_directory_path() / "StreamBenchmark.txt";
+	{
+		string contents( fileSize, ' ' );
+		for( size_t i = 0, lineLength = 0; i < fileSize; ++i, ++lineLength ) {
+			if( lineLength >= ( i * 7919 ) % 100 ) {
+				contents[i] = '\n';
+				lineLength = 0;
+			}
+			else
+				contents[i] = char( 'a' + i % 26 );
+		}
+		writeFileStream( path )->writeData( contents.data(), contents.size() );
+		loadFile( path )->getBuffer();
+	}
+
+	measure( "DataSourcePath::getBuffer()", fileSize, numIterations, [&] {
+		BufferRef buffer = DataSourcePath::create( path )->getBuffer();
+		return checksum( buffer->getData(), buffer->getSize() );
+	} );
+	measure( "DataSourceMapped::getBuffer()", fileSize, numIterations, [&] {
+		BufferRef buffer = DataSourceMapped::create( path )->getBuffer();
+		return checksum( buffer->getData(), buffer->getSize() );
+	} );
+	cout << endl;
+
+	vector<uint8_t> chunk( readSize );
+	measure( "IStreamFile 16k reads", fileSize, numIterations, [&] {
+		IStreamFileRef stream = loadFileStream( path );
+		uint64_t sum = 0;
+		while( size_t size = stream->readDataAvailable( chunk.data(), chunk.size() ) )
+			sum += checksum( chunk.data(), size );
+		return sum;
+	} );
+	measure( "IStreamMapped 16k reads", fileSize, numIterations, [&] {
+		IStreamMappedRef stream = loadFileStreamMapped( path );
+		uint64_t sum = 0;
+		while( size_t size = stream->readDataAvailable( chunk.data(), chunk.size() ) )
+			sum += checksum( chunk.data(), size );
+		return sum;
+	} );
+	measure( "IStreamMapped 16k views", fileSize, numIterations, [&] {
+		IStreamMappedRef stream = loadFileStreamMapped( path );
+		uint64_t sum = 0;
+		while( ! stream->isEof() ) {
+			BufferRef view = stream->readBuffer( std::min<size_t>( readSize, stream->size() - stream->tell() ) );
+			sum += checksum( view->getData(), view->getSize() );
+		}
+		return sum;
+	} );
+	cout << endl;
+
+	measure( "IStreamFile readLine()", fileSize, 1, [&] {
+		IStreamFileRef stream = loadFileStream( path );
+		uint64_t sum = 0;
+		while( ! stream->isEof() )
+			sum += stream->readLine().size();
+		return sum;
+	} );
+	measure( "IStreamMapped readLine()", fileSize, numIterations, [&] {
+		IStreamMappedRef stream = loadFileStreamMapped( path );
+		uint64_t sum = 0;
+		while( ! stream->isEof() )
+			sum += stream->readLine().size();
+		return sum;
+	} );
+
+	fs::remove( path );
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include "cinder/Cinder.h"
+#include "cinder/TaskScheduler.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace cinder;
+
+// Measures the overhead of TaskScheduler: running independent tasks, a dependency graph, and a per-frame sized parallelFor compared to
+// starting a std::thread per range as ci::parallelFor() used to. Also measures the cost of the tracing hooks.
+// Pass the number of threads as the first argument (std::thread::hardware_concurrency() by default).
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static void measure( const string &label, int numIterations, const string &unit, const Fn &fn )
+{
+	fn(); // warm up
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	cout << left << setw( 36 ) << label << fixed << setprecision( 2 ) << secondsSince( start ) * 1e6 / numIterations << " us " << unit << endl;
+}
+
+// The previous implementation of ci::parallelFor(), which started a thread for every range
+template<typename FnT>
+static void threadPerRangeFor( size_t numThreads, size_t count, size_t minItemsPerThread, const FnT &fn )
+{
+	numThreads = std::min<size_t>( numThreads, count / std::max<size_t>( minItemsPerThread, 1 ) );
+	if( numThreads <= 1 ) {
+		fn( size_t( 0 ), count );
+		return;
+	}
+
+	const size_t itemsPerThread = ( count + numThreads - 1 ) / numThreads;
+	std::vector<std::thread> threads;
+	for( size_t begin = itemsPerThread; begin < count; begin += itemsPerThread )
+		threads.emplace_back( [&fn, begin, count, itemsPerThread] { fn( begin, std::min( begin + itemsPerThread, count ) ); } );
+
+	fn( size_t( 0 ), itemsPerThread );
+	for( auto &thread : threads )
+		thread.join();
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t numThreads = argc > 1 ? atoi( argv[1] ) : std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+	TaskScheduler scheduler( TaskScheduler::Options().numThreads( numThreads ) );
+	cout << scheduler.getNumThreads() << " threads" << endl;
+
+	const int numTasks = 10000;
+	measure( "independent tasks", 20, "per 10k tasks", [&] {
+		vector<TaskRef> tasks;
+		tasks.reserve( numTasks );
+		for( int i = 0; i < numTasks; ++i )
+			tasks.push_back( scheduler.run( [] {} ) );
+		scheduler.wait( tasks );
+	} );
+
+	// layers of 100 tasks, each depending on two tasks of the previous layer
+	measure( "dependency graph", 20, "per 10k tasks", [&] {
+		vector<TaskRef> previous, current;
+		for( int layer = 0; layer < numTasks / 100; ++layer ) {
+			for( int i = 0; i < 100; ++i ) {
+				if( previous.empty() )
+					current.push_back( scheduler.run( [] {} ) );
+				else
+					current.push_back( scheduler.run( [] {}, { previous[i], previous[( i + 1 ) % 100] } ) );
+			}
+			previous.swap( current );
+			current.clear();
+		}
+		scheduler.wait( previous );
+	} );
+
+	// roughly the per-frame work of updating 64k particles
+	vector<float> values( 65536, 1.0f );
+	auto update = [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i )
+			values[i] = std::sqrt( values[i] * 1.0001f + 0.5f );
+	};
+
+	cout << endl;
+	measure( "sequential", 200, "per frame", [&] { update( 0, values.size() ); } );
+	measure( "std::thread per range", 200, "per frame", [&] { threadPerRangeFor( scheduler.getNumThreads(), values.size(), 4096, update ); } );
+	measure( "TaskScheduler::parallelFor", 200, "per frame", [&] { scheduler.parallelFor( values.size(), 4096, update ); } );
+
+	double sum = 0;
+	measure( "TaskScheduler::parallelReduce", 200, "per frame", [&] {
+		sum = scheduler.parallelReduce( values.size(), 4096, 0.0, [&]( size_t begin, size_t end ) {
+			double result = 0;
+			for( size_t i = begin; i < end; ++i )
+				result += values[i];
+			return result;
+		}, []( double a, double b ) { return a + b; } );
+	} );
+
+	atomic<size_t> numTraced( 0 );
+	scheduler.setTraceFns( [&]( const char *, size_t ) { ++numTraced; }, TaskScheduler::TraceFn() );
+	measure( "  with tracing", 200, "per frame", [&] { scheduler.parallelFor( values.size(), 4096, update ); } );
+	scheduler.setTraceFns( TaskScheduler::TraceFn(), TaskScheduler::TraceFn() );
+
+	cout << endl << "(checksum " << sum << ", " << numTraced << " traced tasks)" << endl;
+	return 0;
+}
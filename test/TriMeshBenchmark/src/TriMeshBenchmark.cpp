@@ -0,0 +1,143 @@
+#include "cinder/Cinder.h"
+#include "cinder/TriMesh.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <random>
+
+using namespace std;
+using namespace cinder;
+
+// Measures welding and smooth normal and tangent generation for TriMesh on large spheres, and compares welding with the
+// quadratic search recalculateNormals() used previously on a small one. Also measures mesh optimization and the simulated
+// vertex cache miss ratios it achieves on a shuffled mesh, and LOD chain generation with and without parallel clusters.
+// Pass the sphere subdivisions as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+static void printResult( const string &label, double seconds )
+{
+	cout << left << setw( 44 ) << label << fixed << setprecision( 1 ) << seconds * 1000 << " ms" << endl;
+}
+
+//! The previous implementation of vertex grouping in TriMesh::recalculateNormals()
+static size_t weldQuadratic( const vector<vec3> &positions )
+{
+	vector<uint32_t> uniquePositions( positions.size(), 0 );
+	size_t numUnique = 0;
+	for( uint32_t i = 0; i < positions.size(); ++i ) {
+		if( uniquePositions[i] == 0 ) {
+			uniquePositions[i] = i + 1;
+			numUnique++;
+			for( size_t j = i + 1; j < positions.size(); ++j ) {
+				if( length2( positions[j] - positions[i] ) < FLT_EPSILON )
+					uniquePositions[j] = uniquePositions[i];
+			}
+		}
+	}
+	return numUnique;
+}
+
+int main( int argc, char *argv[] )
+{
+	const int subdivisions = argc > 1 ? atoi( argv[1] ) : 2000;
+
+	{
+		TriMesh small( geom::Sphere().subdivisions( 100 ), TriMesh::Format().positions() );
+		const vector<vec3> positions( small.getPositions<3>(), small.getPositions<3>() + small.getNumVertices() );
+		cout << "small sphere: " << small.getNumVertices() << " vertices" << endl;
+
+		auto start = Clock::now();
+		size_t numUnique = weldQuadratic( positions );
+		printResult( "quadratic search", secondsSince( start ) );
+
+		vector<uint32_t> remap;
+		start = Clock::now();
+		size_t numUniqueHashed = geom::weldVertices( positions.size(), positions.data(), sqrt( FLT_EPSILON ), &remap );
+		printResult( "geom::weldVertices()", secondsSince( start ) );
+		cout << "\tunique vertices: " << numUnique << " / " << numUniqueHashed << endl << endl;
+	}
+
+	auto start = Clock::now();
+	TriMesh mesh( geom::Sphere().subdivisions( subdivisions ), TriMesh::Format().positions().normals().texCoords() );
+	cout << "large sphere: " << mesh.getNumVertices() << " vertices, " << mesh.getNumTriangles() << " triangles (generated in "
+		<< secondsSince( start ) * 1000 << " ms)" << endl;
+
+	vector<uint32_t> remap;
+	start = Clock::now();
+	size_t numUnique = geom::weldVertices( mesh.getNumVertices(), mesh.getPositions<3>(), sqrt( FLT_EPSILON ), &remap );
+	printResult( "geom::weldVertices()", secondsSince( start ) );
+	cout << "\tunique vertices: " << numUnique << endl;
+
+	start = Clock::now();
+	mesh.recalculateNormals( false );
+	printResult( "recalculateNormals( flat )", secondsSince( start ) );
+
+	for( auto weighting : { geom::NormalWeighting::UNIFORM, geom::NormalWeighting::AREA, geom::NormalWeighting::ANGLE } ) {
+		const char *names[] = { "UNIFORM", "AREA", "ANGLE" };
+		start = Clock::now();
+		mesh.recalculateNormals( true, weighting );
+		printResult( string( "recalculateNormals( smooth, " ) + names[(int)weighting] + " )", secondsSince( start ) );
+	}
+
+	start = Clock::now();
+	mesh.recalculateTangents();
+	printResult( "recalculateTangents()", secondsSince( start ) );
+
+	// shuffle the triangles so that the optimizations start from a poor ordering
+	vector<uint32_t> &indices = mesh.getIndices();
+	vector<uint32_t> order( mesh.getNumTriangles() );
+	for( size_t t = 0; t < order.size(); ++t )
+		order[t] = (uint32_t)t;
+	shuffle( order.begin(), order.end(), mt19937( 1 ) );
+	const vector<uint32_t> original = indices;
+	for( size_t t = 0; t < order.size(); ++t )
+		copy_n( &original[order[t] * 3], 3, &indices[t * 3] );
+	const TriMesh shuffled = mesh;
+
+	auto printStats = [&mesh]( const string &label ) {
+		for( size_t cacheSize : { 16, 32 } ) {
+			geom::VertexCacheStats stats = mesh.calcVertexCacheStats( cacheSize );
+			cout << "\t" << label << " (cache size " << cacheSize << "): ACMR " << setprecision( 3 ) << stats.getAcmr() << ", ATVR " << stats.getAtvr() << endl;
+		}
+	};
+	cout << endl;
+	printStats( "shuffled" );
+
+	for( auto method : { geom::VertexCacheMethod::TIPSIFY, geom::VertexCacheMethod::FORSYTH } ) {
+		mesh = shuffled;
+		const string name = ( method == geom::VertexCacheMethod::TIPSIFY ) ? "TIPSIFY" : "FORSYTH";
+		start = Clock::now();
+		mesh.optimizeVertexCache( method );
+		printResult( "optimizeVertexCache( " + name + " )", secondsSince( start ) );
+		printStats( name );
+
+		start = Clock::now();
+		mesh.optimizeOverdraw();
+		printResult( "optimizeOverdraw()", secondsSince( start ) );
+		printStats( name + " + overdraw" );
+
+		start = Clock::now();
+		mesh.optimizeVertexFetch();
+		printResult( "optimizeVertexFetch()", secondsSince( start ) );
+	}
+
+	cout << endl;
+	const vector<float> ratios = { 0.5f, 0.1f, 0.02f };
+	for( size_t clusterSize : { 0, 16384 } ) {
+		start = Clock::now();
+		vector<geom::SimplifiedLod> lods = shuffled.calcLods( ratios, geom::SimplifyOptions().parallelClusters( clusterSize ) );
+		printResult( "calcLods( parallelClusters " + to_string( clusterSize ) + " )", secondsSince( start ) );
+		for( const auto &lod : lods )
+			cout << "	" << lod.getIndices().size() / 3 << " triangles, error " << setprecision( 5 ) << lod.getError() << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include "cinder/Cinder.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/Warp.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+using namespace std;
+using namespace cinder;
+
+// Rotates and scales a 1080p RGBA Surface, comparing a per-pixel bilinear loop with ip::warpAffine() serially and in parallel,
+// and with ip::remap() from a precomputed WarpMap, for each interpolation and for uint8_t and float. Pass the number of iterations as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+template<typename Fn>
+static double measure( int numIterations, const Fn &fn )
+{
+	fn(); // warm up
+	auto start = Clock::now();
+	for( int i = 0; i < numIterations; ++i )
+		fn();
+	return secondsSince( start ) * 1000 / numIterations;
+}
+
+// The kind of loop written without ip::warpAffine(), sampling with getPixel() and clamping at the borders
+template<typename T>
+static void perPixelWarp( const SurfaceT<T> &src, const mat3 &transform, SurfaceT<T> *dst )
+{
+	const mat3 inverse = glm::inverse( transform );
+	for( int32_t y = 0; y < dst->getHeight(); ++y ) {
+		for( int32_t x = 0; x < dst->getWidth(); ++x ) {
+			const vec3 position = inverse * vec3( x, y, 1 );
+			const ivec2 p( glm::floor( vec2( position ) ) );
+			const vec2 f = vec2( position ) - vec2( p );
+			const ColorAf top = lerp( ColorAf( src.getPixel( p ) ), ColorAf( src.getPixel( p + ivec2( 1, 0 ) ) ), f.x );
+			const ColorAf bottom = lerp( ColorAf( src.getPixel( p + ivec2( 0, 1 ) ) ), ColorAf( src.getPixel( p + ivec2( 1, 1 ) ) ), f.x );
+			dst->setPixel( ivec2( x, y ), ColorAT<T>( lerp( top, bottom, f.y ) ) );
+		}
+	}
+}
+
+template<typename T>
+static void benchmarkType( const string &typeName, int numIterations )
+{
+	Rand rand( 1234 );
+	SurfaceT<T> src( 1920, 1080, true ), dst( 1920, 1080, true );
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x )
+			src.setPixel( ivec2( x, y ), ColorAf( rand.nextFloat(), rand.nextFloat(), rand.nextFloat(), rand.nextFloat() ) );
+	}
+
+	// a 10 degree rotation about the center, scaled by 1.1
+	const float c = std::cos( 0.1745f ) * 1.1f, s = std::sin( 0.1745f ) * 1.1f;
+	const vec2 center( 960, 540 );
+	const mat3 transform( c, s, 0, -s, c, 0, center.x - c * center.x + s * center.y, center.y - s * center.x - c * center.y, 1 );
+	const ip::WarpMap map = ip::WarpMap::affine( transform, dst.getSize() );
+
+	cout << typeName << endl;
+	const double perPixel = measure( 1, [&] { perPixelWarp( src, transform, &dst ); } );
+	cout << "  " << left << setw( 10 ) << "per pixel" << fixed << setprecision( 2 ) << perPixel << " ms" << endl;
+	const pair<string, ip::Interpolation> interpolations[] = { { "nearest", ip::Interpolation::NEAREST }, { "bilinear", ip::Interpolation::BILINEAR }, { "bicubic", ip::Interpolation::BICUBIC } };
+	for( const auto &interpolation : interpolations ) {
+		const auto options = ip::WarpOptions().interpolation( interpolation.second );
+		const double serial = measure( numIterations, [&] { ip::warpAffine( src, &dst, transform, ip::WarpOptions( options ).parallel( false ) ); } );
+		const double parallel = measure( numIterations, [&] { ip::warpAffine( src, &dst, transform, options ); } );
+		const double remap = measure( numIterations, [&] { ip::remap( src, &dst, map, options ); } );
+		cout << "  " << left << setw( 10 ) << interpolation.first << fixed << setprecision( 2 ) << "serial " << setw( 8 ) << serial << " ms   parallel "
+			<< setw( 8 ) << parallel << " ms   remap " << setw( 8 ) << remap << " ms" << endl;
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	const int numIterations = argc > 1 ? atoi( argv[1] ) : 5;
+	cout << "1920x1080 RGBA, " << numIterations << " iterations" << endl;
+	benchmarkType<uint8_t>( "Surface8u", numIterations );
+	benchmarkType<float>( "Surface32f", numIterations );
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include "cinder/Cinder.h"
+#include "cinder/Xml.h"
+#include "cinder/XmlDocument.h"
+#include "cinder/svg/Svg.h"
+#include "cinder/Rand.h"
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+using namespace cinder;
+
+// Compares parse time and memory of XmlTree, XmlDocument and XmlPullParser on a large generated SVG, as well as loading it as an svg::Doc
+// and querying its spatial index.
+// Pass the approximate document size in megabytes as the first argument.
+
+typedef chrono::steady_clock Clock;
+
+// Tracks the bytes currently allocated through operator new, to measure the memory held by each representation.
+static atomic<size_t> sAllocatedBytes( 0 );
+
+void* operator new( size_t size )
+{
+	size_t *p = static_cast<size_t *>( malloc( size + sizeof( max_align_t ) ) );
+	if( ! p )
+		throw bad_alloc();
+	*p = size;
+	sAllocatedBytes += size;
+	return reinterpret_cast<char *>( p ) + sizeof( max_align_t );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+	if( ! ptr )
+		return;
+	size_t *p = reinterpret_cast<size_t *>( static_cast<char *>( ptr ) - sizeof( max_align_t ) );
+	sAllocatedBytes -= *p;
+	free( p );
+}
+
+void operator delete( void *ptr, size_t ) noexcept
+{
+	operator delete( ptr );
+}
+
+void* operator new[]( size_t size )						{ return operator new( size ); }
+void operator delete[]( void *ptr ) noexcept			{ operator delete( ptr ); }
+void operator delete[]( void *ptr, size_t ) noexcept	{ operator delete( ptr ); }
+
+static double secondsSince( const Clock::time_point &start )
+{
+	return chrono::duration<double>( Clock::now() - start ).count();
+}
+
+static string generateSvg( size_t targetSize )
+{
+	Rand rand( 1234 );
+	ostringstream ss;
+	ss << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1000\" height=\"1000\" viewBox=\"0 0 1000 1000\">\n";
+
+	size_t index = 0;
+	while( (size_t)ss.tellp() < targetSize ) {
+		ss << "<g id=\"group" << index << "\" transform=\"translate(" << rand.nextFloat( 1000 ) << " " << rand.nextFloat( 1000 ) << ")\">\n";
+		for( int i = 0; i < 8; ++i ) {
+			ss << "\t<path fill=\"#" << hex << rand.nextUint( 0xffffff ) << dec << "\" stroke-width=\"" << rand.nextFloat( 4 ) << "\" d=\"M 0 0";
+			for( int p = 0; p < 6; ++p )
+				ss << " L " << rand.nextFloat( 100 ) << " " << rand.nextFloat( 100 );
+			ss << " Z\"/>\n";
+		}
+		ss << "\t<circle cx=\"" << rand.nextFloat( 100 ) << "\" cy=\"" << rand.nextFloat( 100 ) << "\" r=\"" << rand.nextFloat( 10 ) << "\"/>\n";
+		ss << "\t<text x=\"0\" y=\"0\">label &amp; " << index << "</text>\n</g>\n";
+		index++;
+	}
+
+	ss << "</svg>\n";
+	return ss.str();
+}
+
+static void printResult( const string &label, double seconds, size_t numBytes, size_t memoryBytes )
+{
+	cout << left << setw( 36 ) << label << fixed << setprecision( 1 ) << setw( 10 ) << seconds * 1000 << " ms"
+		<< "\t(" << ( numBytes / ( 1024.0 * 1024.0 ) ) / seconds << " MB/s)"
+		<< "\tmemory: " << memoryBytes / ( 1024.0 * 1024.0 ) << " MB" << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t sizeMb = argc > 1 ? atoi( argv[1] ) : 20;
+	const string svgString = generateSvg( sizeMb * 1024 * 1024 );
+	const auto source = DataSourceBuffer::create( Buffer::create( (void *)svgString.data(), svgString.size() ) );
+	cout << "document size: " << svgString.size() / ( 1024.0 * 1024.0 ) << " MB" << endl << endl;
+
+	{
+		size_t allocatedBefore = sAllocatedBytes;
+		auto start = Clock::now();
+		XmlTree tree( source, XmlTree::ParseOptions().ignoreDataChildren( false ) );
+		printResult( "XmlTree", secondsSince( start ), svgString.size(), sAllocatedBytes - allocatedBefore );
+	}
+
+	{
+		size_t allocatedBefore = sAllocatedBytes;
+		auto start = Clock::now();
+		XmlDocument doc( source, XmlTree::ParseOptions().ignoreDataChildren( false ) );
+		printResult( "XmlDocument", secondsSince( start ), svgString.size(), sAllocatedBytes - allocatedBefore );
+		cout << "\tnodes: " << doc.getNumNodes() << ", getMemoryUsage(): " << doc.getMemoryUsage() / ( 1024.0 * 1024.0 ) << " MB" << endl;
+
+		size_t numPaths = 0;
+		start = Clock::now();
+		const XmlDocument::Node &svg = doc.getChild( "svg" );
+		for( const XmlDocument::Node *group = svg.findChild( "g" ); group; group = group->getNextSameTag() ) {
+			for( const XmlDocument::Node *path = group->findChild( "path" ); path; path = path->getNextSameTag() )
+				numPaths += path->hasAttribute( "d" );
+		}
+		cout << "\titerating " << numPaths << " paths: " << secondsSince( start ) * 1000 << " ms" << endl;
+	}
+
+	{
+		size_t allocatedBefore = sAllocatedBytes;
+		size_t peakAllocated = 0;
+		size_t numElements = 0;
+		auto start = Clock::now();
+		XmlPullParser parser( source );
+		while( parser.next() != XmlPullParser::END_DOCUMENT ) {
+			if( parser.getEvent() == XmlPullParser::START_ELEMENT )
+				++numElements;
+			peakAllocated = std::max<size_t>( peakAllocated, sAllocatedBytes - allocatedBefore );
+		}
+		printResult( "XmlPullParser", secondsSince( start ), svgString.size(), peakAllocated );
+		cout << "\telements: " << numElements << endl;
+	}
+
+	{
+		size_t allocatedBefore = sAllocatedBytes;
+		auto start = Clock::now();
+		svg::Doc doc( source );
+		printResult( "svg::Doc", secondsSince( start ), svgString.size(), sAllocatedBytes - allocatedBefore );
+		cout << "\tchildren: " << doc.getChildren().size() << endl;
+
+		// the first query builds the spatial index
+		start = Clock::now();
+		doc.nodeUnderPoint( vec2( 0 ) );
+		cout << "\tspatial index build: " << secondsSince( start ) * 1000 << " ms" << endl;
+
+		Rand rand( 4321 );
+		const size_t numQueries = 10000;
+		size_t numHits = 0;
+		start = Clock::now();
+		for( size_t i = 0; i < numQueries; ++i )
+			numHits += doc.nodeUnderPoint( vec2( rand.nextFloat( 1100 ), rand.nextFloat( 1100 ) ) ) != nullptr;
+		cout << "\tnodeUnderPoint(): " << secondsSince( start ) * 1e6 / numQueries << " us per query (" << numHits << " hits)" << endl;
+
+		size_t numFound = 0;
+		start = Clock::now();
+		for( size_t i = 0; i < numQueries; ++i ) {
+			vec2 corner( rand.nextFloat( 1000 ), rand.nextFloat( 1000 ) );
+			numFound += doc.findNodesInRect( Rectf( corner, corner + vec2( 20 ) ) ).size();
+		}
+		cout << "\tfindNodesInRect(): " << secondsSince( start ) * 1e6 / numQueries << " us per query (" << numFound << " nodes)" << endl;
+	}
+
+	return 0;
+}
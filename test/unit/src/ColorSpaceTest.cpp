@@ -0,0 +1,168 @@
+#include "catch.hpp"
+#include "cinder/ip/ColorSpace.h"
+#include "cinder/Color.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+Surface32f makeRandomSurface( int32_t width, int32_t height, bool alpha )
+{
+	Rand rand( 1234 );
+	Surface32f result( width, height, alpha );
+	auto iter = result.getIter();
+	while( iter.line() ) {
+		while( iter.pixel() ) {
+			iter.r() = rand.nextFloat();
+			iter.g() = rand.nextFloat();
+			iter.b() = rand.nextFloat();
+			if( alpha )
+				iter.a() = rand.nextFloat();
+		}
+	}
+	return result;
+}
+
+template<typename T>
+float maxDifference( const SurfaceT<T> &a, const SurfaceT<T> &b )
+{
+	float result = 0;
+	for( int32_t y = 0; y < a.getHeight(); ++y ) {
+		for( int32_t x = 0; x < a.getWidth(); ++x ) {
+			const ColorAT<T> ca = a.getPixel( ivec2( x, y ) ), cb = b.getPixel( ivec2( x, y ) );
+			result = std::max( { result, std::abs( (float)ca.r - cb.r ), std::abs( (float)ca.g - cb.g ), std::abs( (float)ca.b - cb.b ), std::abs( (float)ca.a - cb.a ) } );
+		}
+	}
+	return result;
+}
+
+double srgbToLinearExact( double v )
+{
+	return v <= 0.04045 ? v / 12.92 : pow( ( v + 0.055 ) / 1.055, 2.4 );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ColorSpace" )
+{
+	SECTION( "Transfer functions" )
+	{
+		for( int i = 0; i <= 10000; ++i ) {
+			const float v = i / 10000.0f;
+			REQUIRE( std::abs( ip::srgbToLinear( v ) - srgbToLinearExact( v ) ) < 2e-5 );
+			REQUIRE( std::abs( ip::linearToSrgb( ip::srgbToLinear( v ) ) - v ) < 2e-5 );
+		}
+		// outside of the table
+		REQUIRE( ip::srgbToLinear( 2.0f ) == Approx( srgbToLinearExact( 2.0 ) ) );
+		REQUIRE( ip::srgbToLinear( -0.01f ) == Approx( -0.01 / 12.92 ) );
+
+		Surface8u surface( 256, 1, false );
+		for( int i = 0; i < 256; ++i )
+			surface.setPixel( ivec2( i, 0 ), Color8u( i, i, i ) );
+		ip::convertColorSpace( &surface, ip::ColorSpace::SRGB, ip::ColorSpace::LINEAR_RGB );
+		for( int i = 0; i < 256; ++i )
+			REQUIRE( surface.getPixel( ivec2( i, 0 ) ).r == lround( srgbToLinearExact( i / 255.0 ) * 255 ) );
+	}
+
+	SECTION( "HSV matches rgbToHsv()" )
+	{
+		const Surface32f rgb = makeRandomSurface( 37, 11, false );
+		Surface32f hsv( rgb.getWidth(), rgb.getHeight(), false );
+		ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, ip::ColorSpace::HSV, &hsv );
+		for( int32_t y = 0; y < rgb.getHeight(); ++y ) {
+			for( int32_t x = 0; x < rgb.getWidth(); ++x ) {
+				const vec3 expected = rgbToHsv( rgb.getPixel( ivec2( x, y ) ) );
+				const ColorA actual = hsv.getPixel( ivec2( x, y ) );
+				REQUIRE( actual.r == Approx( expected.x ) );
+				REQUIRE( actual.g == Approx( expected.y ) );
+				REQUIRE( actual.b == Approx( expected.z ) );
+			}
+		}
+
+		ip::convertColorSpace( &hsv, ip::ColorSpace::HSV, ip::ColorSpace::SRGB );
+		REQUIRE( maxDifference( rgb, hsv ) < 1e-5f );
+	}
+
+	SECTION( "YCbCr" )
+	{
+		Surface32f surface( 2, 1, false );
+		surface.setPixel( ivec2( 0, 0 ), Colorf( 1, 1, 1 ) );
+		surface.setPixel( ivec2( 1, 0 ), Colorf( 1, 0, 0 ) );
+		ip::convertColorSpace( &surface, ip::ColorSpace::SRGB, ip::ColorSpace::YCBCR );
+		REQUIRE( surface.getPixel( ivec2( 0, 0 ) ).r == Approx( 1 ) );
+		REQUIRE( surface.getPixel( ivec2( 0, 0 ) ).g == Approx( 0.5f ) );
+		REQUIRE( surface.getPixel( ivec2( 0, 0 ) ).b == Approx( 0.5f ) );
+		REQUIRE( surface.getPixel( ivec2( 1, 0 ) ).r == Approx( 0.299f ) );
+		REQUIRE( surface.getPixel( ivec2( 1, 0 ) ).b == Approx( 1 ) );
+
+		const Surface32f rgb = makeRandomSurface( 101, 7, false );
+		Surface32f roundTrip = rgb.clone();
+		ip::convertColorSpace( &roundTrip, ip::ColorSpace::SRGB, ip::ColorSpace::YCBCR );
+		ip::convertColorSpace( &roundTrip, ip::ColorSpace::YCBCR, ip::ColorSpace::SRGB );
+		REQUIRE( maxDifference( rgb, roundTrip ) < 1e-4f );
+	}
+
+	SECTION( "CIE L*a*b*" )
+	{
+		Surface32f surface( 2, 1, false );
+		surface.setPixel( ivec2( 0, 0 ), Colorf( 1, 1, 1 ) );
+		surface.setPixel( ivec2( 1, 0 ), Colorf( 1, 0, 0 ) );
+		ip::convertColorSpace( &surface, ip::ColorSpace::SRGB, ip::ColorSpace::LAB );
+		const Colorf white = surface.getPixel( ivec2( 0, 0 ) ), red = surface.getPixel( ivec2( 1, 0 ) );
+		REQUIRE( white.r * 100 == Approx( 100 ).margin( 0.01 ) );
+		REQUIRE( white.g * 255 - 128 == Approx( 0 ).margin( 0.01 ) );
+		REQUIRE( white.b * 255 - 128 == Approx( 0 ).margin( 0.01 ) );
+		REQUIRE( red.r * 100 == Approx( 53.24 ).margin( 0.01 ) );
+		REQUIRE( red.g * 255 - 128 == Approx( 80.09 ).margin( 0.01 ) );
+		REQUIRE( red.b * 255 - 128 == Approx( 67.20 ).margin( 0.01 ) );
+
+		const Surface32f rgb = makeRandomSurface( 300, 5, true );
+		Surface32f lab( rgb.getWidth(), rgb.getHeight(), true );
+		ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, ip::ColorSpace::LAB, &lab );
+		ip::convertColorSpace( &lab, ip::ColorSpace::LAB, ip::ColorSpace::SRGB );
+		REQUIRE( maxDifference( rgb, lab ) < 1e-4f );
+
+		// 16-bit round trips to within a couple of steps
+		Surface16u rgb16( rgb );
+		Surface16u roundTrip16 = rgb16.clone();
+		ip::convertColorSpace( &roundTrip16, ip::ColorSpace::SRGB, ip::ColorSpace::LAB );
+		ip::convertColorSpace( &roundTrip16, ip::ColorSpace::LAB, ip::ColorSpace::LINEAR_RGB );
+		ip::convertColorSpace( &roundTrip16, ip::ColorSpace::LINEAR_RGB, ip::ColorSpace::SRGB );
+		REQUIRE( maxDifference( rgb16, roundTrip16 ) <= 64 );
+	}
+
+	SECTION( "Parallel, in place and areas" )
+	{
+		const Surface8u rgb( makeRandomSurface( 640, 480, true ) );
+		for( ip::ColorSpace to : { ip::ColorSpace::LINEAR_RGB, ip::ColorSpace::HSV, ip::ColorSpace::YCBCR, ip::ColorSpace::LAB } ) {
+			Surface8u serial( rgb.getWidth(), rgb.getHeight(), true ), parallel( rgb.getWidth(), rgb.getHeight(), true );
+			ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, to, &serial, false );
+			ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, to, &parallel, true );
+			REQUIRE( maxDifference( serial, parallel ) == 0 );
+
+			Surface8u inPlace = rgb.clone();
+			ip::convertColorSpace( &inPlace, ip::ColorSpace::SRGB, to );
+			REQUIRE( maxDifference( serial, inPlace ) == 0 );
+		}
+
+		// alpha is copied, or opaque when the source has none
+		Surface8u opaque( rgb.getWidth(), rgb.getHeight(), false );
+		ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, ip::ColorSpace::SRGB, &opaque );
+		Surface8u withAlpha( rgb.getWidth(), rgb.getHeight(), true );
+		ip::convertColorSpace( opaque, ip::ColorSpace::SRGB, ip::ColorSpace::SRGB, &withAlpha );
+		REQUIRE( withAlpha.getPixel( ivec2( 10, 10 ) ).a == 255 );
+		Surface8u copy( rgb.getWidth(), rgb.getHeight(), true );
+		ip::convertColorSpace( rgb, ip::ColorSpace::SRGB, ip::ColorSpace::SRGB, &copy );
+		REQUIRE( maxDifference( rgb, copy ) == 0 );
+
+		Surface8u partial = rgb.clone();
+		ip::convertColorSpace( &partial, ip::ColorSpace::SRGB, ip::ColorSpace::YCBCR, Area( 10, 20, 30, 40 ) );
+		REQUIRE( partial.getPixel( ivec2( 9, 20 ) ) == rgb.getPixel( ivec2( 9, 20 ) ) );
+		REQUIRE( partial.getPixel( ivec2( 30, 39 ) ) == rgb.getPixel( ivec2( 30, 39 ) ) );
+		REQUIRE( partial.getPixel( ivec2( 29, 39 ) ) != rgb.getPixel( ivec2( 29, 39 ) ) );
+	}
+}
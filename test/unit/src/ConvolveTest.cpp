@@ -0,0 +1,202 @@
+#include "catch.hpp"
+#include "cinder/ip/Convolve.h"
+#include "cinder/ip/EdgeDetect.h"
+#include "cinder/ip/Fill.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+template<typename T>
+ChannelT<T> makeRandomChannel( int32_t width, int32_t height, uint32_t seed = 1234 )
+{
+	Rand rand( seed );
+	ChannelT<T> result( width, height );
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x )
+			result.setValue( ivec2( x, y ), CHANTRAIT<T>::convert( rand.nextFloat() ) );
+	}
+	return result;
+}
+
+int32_t referenceBorder( int32_t i, int32_t size, ip::BorderMode mode )
+{
+	if( i >= 0 && i < size )
+		return i;
+	switch( mode ) {
+		case ip::BorderMode::CLAMP: return std::min( std::max( i, 0 ), size - 1 );
+		case ip::BorderMode::MIRROR: while( i < 0 || i >= size ) i = i < 0 ? -i : 2 * ( size - 1 ) - i; return i;
+		case ip::BorderMode::WRAP: return ( i % size + size ) % size;
+		default: return -1;
+	}
+}
+
+// Straightforward 2D convolution in double precision
+template<typename T>
+vector<double> referenceConvolve( const ChannelT<T> &src, const ip::Kernel &kernel, const ip::ConvolveOptions &options )
+{
+	vector<double> result( src.getWidth() * src.getHeight() );
+	const ivec2 anchor = kernel.getAnchor();
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x ) {
+			double sum = 0;
+			for( int32_t ky = 0; ky < kernel.getHeight(); ++ky ) {
+				for( int32_t kx = 0; kx < kernel.getWidth(); ++kx ) {
+					const int32_t sx = referenceBorder( x + kx - anchor.x, src.getWidth(), options.getBorderMode() );
+					const int32_t sy = referenceBorder( y + ky - anchor.y, src.getHeight(), options.getBorderMode() );
+					const double value = ( sx < 0 || sy < 0 ) ? options.getBorderValue() : (double)src.getValue( ivec2( sx, sy ) );
+					sum += value * kernel.getWeights()[ky * kernel.getWidth() + kx];
+				}
+			}
+			result[y * src.getWidth() + x] = sum * options.getScale() + options.getOffset();
+		}
+	}
+	return result;
+}
+
+template<typename T>
+double maxError( const ChannelT<T> &actual, const vector<double> &expected )
+{
+	const bool isFloat = std::is_floating_point<T>::value;
+	double result = 0;
+	for( int32_t y = 0; y < actual.getHeight(); ++y ) {
+		for( int32_t x = 0; x < actual.getWidth(); ++x ) {
+			double value = expected[y * actual.getWidth() + x];
+			if( ! isFloat )
+				value = std::min<double>( std::max( value, 0.0 ), CHANTRAIT<T>::max() );
+			result = std::max( result, std::abs( actual.getValue( ivec2( x, y ) ) - value ) );
+		}
+	}
+	return result;
+}
+
+template<typename T>
+void requireMatchesReference( double tolerance )
+{
+	// wide enough for several tiles
+	const ChannelT<T> src = makeRandomChannel<T>( 1500, 23 );
+	const vector<ip::Kernel> kernels = { ip::Kernel::gaussian( 1.5f ), ip::Kernel::box( 2 ), ip::Kernel::sobelX(), ip::Kernel::scharrY(), ip::Kernel::laplacian(), ip::Kernel::sharpen( 0.5f ),
+		ip::Kernel::separable( { 0.1f, -0.3f, 0.7f, 0.5f }, { 0.25f, 0.5f } ), ip::Kernel( 5, 3, { 0.1f, 0, 0.2f, -0.1f, 0.05f, 0, 0.3f, 0.1f, 0, 0.1f, -0.2f, 0.1f, 0.2f, 0.1f, 0.05f } ) };
+	const ip::BorderMode modes[] = { ip::BorderMode::CLAMP, ip::BorderMode::MIRROR, ip::BorderMode::WRAP, ip::BorderMode::CONSTANT };
+	for( const auto &kernel : kernels ) {
+		for( auto mode : modes ) {
+			const ip::ConvolveOptions options = ip::ConvolveOptions().borderMode( mode ).borderValue( CHANTRAIT<T>::max() / 2 ).offset( kernel.getWeights()[0] < 0 ? CHANTRAIT<T>::max() / 2 : 0 );
+			ChannelT<T> dst( src.getWidth(), src.getHeight() );
+			ip::convolve( src, &dst, kernel, options );
+			INFO( "kernel " << kernel.getWidth() << "x" << kernel.getHeight() << " border mode " << (int)mode );
+			REQUIRE( maxError( dst, referenceConvolve( src, kernel, options ) ) <= tolerance );
+		}
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Convolve" )
+{
+	SECTION( "Kernels" )
+	{
+		const ip::Kernel gaussian = ip::Kernel::gaussian( 2 );
+		REQUIRE( gaussian.isSeparable() );
+		REQUIRE( gaussian.getWidth() == 13 );
+		REQUIRE( gaussian.getAnchor() == ivec2( 6, 6 ) );
+		double sum = 0;
+		for( float weight : gaussian.getWeights() )
+			sum += weight;
+		REQUIRE( sum == Approx( 1 ) );
+
+		REQUIRE( ip::Kernel::sobelX().getWeights() == vector<float>( { -1, 0, 1, -2, 0, 2, -1, 0, 1 } ) );
+		REQUIRE_THROWS_AS( ip::Kernel( 3, 3, { 1, 2, 3 } ), ip::ConvolveExc );
+		Channel8u channel( 4, 4 );
+		REQUIRE_THROWS_AS( ip::convolve( channel, &channel, ip::Kernel() ), ip::ConvolveExc );
+	}
+
+	SECTION( "Matches a reference convolution" )
+	{
+		requireMatchesReference<uint8_t>( 1 );
+		requireMatchesReference<uint16_t>( 1 );
+		requireMatchesReference<float>( 1e-5 );
+	}
+
+	SECTION( "8-bit fixed point preserves flat areas" )
+	{
+		Channel8u flat( 64, 64 );
+		for( uint8_t value : { 0, 1, 77, 254, 255 } ) {
+			ip::fill( &flat, value );
+			for( const auto &kernel : { ip::Kernel::gaussian( 3.3f ), ip::Kernel::box( 4 ), ip::Kernel::sharpen( 2 ) } ) {
+				Channel8u dst( flat.getWidth(), flat.getHeight() );
+				ip::convolve( flat, &dst, kernel );
+				for( int32_t y = 0; y < dst.getHeight(); ++y ) {
+					for( int32_t x = 0; x < dst.getWidth(); ++x )
+						REQUIRE( dst.getValue( ivec2( x, y ) ) == value );
+				}
+			}
+		}
+	}
+
+	SECTION( "Parallel, in place and areas" )
+	{
+		const Surface8u src( makeRandomChannel<uint8_t>( 700, 300 ) );
+		const ip::Kernel kernel = ip::Kernel::gaussian( 2.5f );
+		Surface8u serial( src.getWidth(), src.getHeight(), false ), parallel( src.getWidth(), src.getHeight(), false );
+		ip::convolve( src, &serial, kernel, ip::ConvolveOptions().parallel( false ) );
+		ip::convolve( src, &parallel, kernel );
+		Surface8u inPlace = src.clone();
+		ip::convolve( inPlace, &inPlace, kernel );
+		for( int32_t y = 0; y < src.getHeight(); ++y ) {
+			for( int32_t x = 0; x < src.getWidth(); ++x ) {
+				REQUIRE( serial.getPixel( ivec2( x, y ) ) == parallel.getPixel( ivec2( x, y ) ) );
+				REQUIRE( serial.getPixel( ivec2( x, y ) ) == inPlace.getPixel( ivec2( x, y ) ) );
+			}
+		}
+
+		// neighbors are read from outside of the area
+		Channel8u area( 50, 40 );
+		ip::convolve( src.getChannelGreen(), Area( 100, 100, 150, 140 ), ivec2( 0, 0 ), &area, kernel );
+		for( int32_t y = 0; y < area.getHeight(); ++y ) {
+			for( int32_t x = 0; x < area.getWidth(); ++x )
+				REQUIRE( area.getValue( ivec2( x, y ) ) == serial.getChannelGreen().getValue( ivec2( x + 100, y + 100 ) ) );
+		}
+	}
+
+	SECTION( "Edge detection" )
+	{
+		// a vertical edge between columns 4 and 5
+		Channel8u step( 10, 6 );
+		for( int32_t y = 0; y < step.getHeight(); ++y ) {
+			for( int32_t x = 0; x < step.getWidth(); ++x )
+				step.setValue( ivec2( x, y ), x < 5 ? 10 : 50 );
+		}
+
+		Channel8u sobel( step.getWidth(), step.getHeight() ), scharr( step.getWidth(), step.getHeight() ), laplacian( step.getWidth(), step.getHeight() );
+		ip::edgeDetectSobel( step, &sobel );
+		ip::edgeDetectScharr( step, &scharr );
+		ip::edgeDetectLaplacian( step, &laplacian );
+		for( int32_t y = 0; y < step.getHeight(); ++y ) {
+			for( int32_t x = 0; x < step.getWidth(); ++x ) {
+				const bool onEdge = x == 4 || x == 5;
+				REQUIRE( sobel.getValue( ivec2( x, y ) ) == ( onEdge ? 160 : 0 ) );
+				REQUIRE( scharr.getValue( ivec2( x, y ) ) == ( onEdge ? 255 : 0 ) );
+				REQUIRE( laplacian.getValue( ivec2( x, y ) ) == ( onEdge ? 40 : 0 ) );
+			}
+		}
+
+		Surface32f surface = Surface32f( Surface8u( step ) );
+		ip::sharpen( surface, &surface );
+		REQUIRE( surface.getPixel( ivec2( 4, 3 ) ).g == Approx( 10 / 255.0f - 40 / 255.0f ) );
+		REQUIRE( surface.getPixel( ivec2( 5, 3 ) ).g == Approx( 90 / 255.0f ) );
+		REQUIRE( surface.getPixel( ivec2( 0, 0 ) ).g == Approx( 10 / 255.0f ) );
+
+		// alpha is copied unsharpened into a separate destination
+		Surface8u withAlpha( step.getWidth(), step.getHeight(), true ), sharpened( step.getWidth(), step.getHeight(), true );
+		ip::fill( &withAlpha, ColorA8u( 20, 20, 20, 128 ) );
+		withAlpha.getChannelAlpha().copyFrom( step, step.getBounds() );
+		ip::fill( &sharpened, ColorA8u( 0, 0, 0, 0 ) );
+		ip::sharpen( withAlpha, &sharpened );
+		for( int32_t x = 0; x < step.getWidth(); ++x )
+			REQUIRE( sharpened.getPixel( ivec2( x, 3 ) ).a == step.getValue( ivec2( x, 3 ) ) );
+	}
+}
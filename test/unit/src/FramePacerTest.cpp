@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "cinder/Cinder.h"
+
+#if defined( CINDER_LINUX )
+
+#include "cinder/app/linux/FramePacer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+TEST_CASE( "FrameTimeHistogram" )
+{
+	FrameTimeHistogram histogram( 0.001, 10 );
+	REQUIRE( histogram.getMean() == 0 );
+	REQUIRE( histogram.getPercentile( 50 ) == 0 );
+
+	for( double seconds : { 0.0015, 0.0025, 0.0035, 0.0045, 0.5 } )
+		histogram.addSample( seconds );
+	REQUIRE( histogram.getNumSamples() == 5 );
+	REQUIRE( histogram.getMin() == Approx( 0.0015 ) );
+	REQUIRE( histogram.getMax() == Approx( 0.5 ) );
+	REQUIRE( histogram.getMean() == Approx( 0.1024 ) );
+	REQUIRE( histogram.getStdDev() == Approx( 0.19880 ).epsilon( 0.001 ) );
+
+	// percentiles resolve to the upper edge of a bin, and the last bin holds any longer samples
+	REQUIRE( histogram.getPercentile( 40 ) == Approx( 0.003 ) );
+	REQUIRE( histogram.getPercentile( 100 ) == Approx( 0.5 ) );
+	REQUIRE( histogram.getBinCounts()[1] == 1 );
+	REQUIRE( histogram.getBinCounts()[9] == 1 );
+
+	histogram.clear();
+	REQUIRE( histogram.getNumSamples() == 0 );
+	REQUIRE( histogram.getBinCounts()[1] == 0 );
+}
+
+TEST_CASE( "FramePacer" )
+{
+	const double frameSeconds = 0.005;
+
+	SECTION( "Frames are paced to their deadlines" )
+	{
+		for( auto mode : { FramePacer::Mode::SLEEP, FramePacer::Mode::SLEEP_SPIN, FramePacer::Mode::ADAPTIVE } ) {
+			FramePacer pacer( 1 / frameSeconds, FramePacer::Options().mode( mode ) );
+			const int64_t start = FramePacer::now();
+			for( int frame = 0; frame < 40; ++frame )
+				pacer.waitForNextFrame();
+			const double elapsed = ( FramePacer::now() - start ) / 1e9;
+
+			// deadlines are never early, and don't drift
+			REQUIRE( elapsed >= 40 * frameSeconds );
+			REQUIRE( pacer.getFrameTimes().getNumSamples() == 39 );
+			REQUIRE( pacer.getFrameTimes().getMean() == Approx( frameSeconds ).epsilon( 0.2 ) );
+			REQUIRE( pacer.getSpinSeconds() <= pacer.getOptions().getMaxSpinSeconds() );
+			if( mode == FramePacer::Mode::SLEEP )
+				REQUIRE( pacer.getSpinSeconds() == 0 );
+		}
+	}
+
+	SECTION( "Missed deadlines" )
+	{
+		FramePacer pacer( 1 / frameSeconds );
+		REQUIRE( pacer.waitForNextFrame() );
+		this_thread::sleep_for( chrono::milliseconds( 20 ) );
+		REQUIRE( ! pacer.waitForNextFrame() );
+		REQUIRE( pacer.getNumMissedDeadlines() == 1 );
+
+		// the pacer catches up with the missed frames rather than dropping them
+		const int64_t start = FramePacer::now();
+		pacer.waitForNextFrame();
+		pacer.waitForNextFrame();
+		REQUIRE( ( FramePacer::now() - start ) / 1e9 < frameSeconds );
+
+		pacer.clearStats();
+		REQUIRE( pacer.getNumMissedDeadlines() == 0 );
+		REQUIRE( pacer.getFrameTimes().getNumSamples() == 0 );
+	}
+
+	SECTION( "Unpaced frames are still measured" )
+	{
+		FramePacer pacer;
+		for( int frame = 0; frame < 3; ++frame ) {
+			pacer.markFrame();
+			this_thread::sleep_for( chrono::milliseconds( 2 ) );
+		}
+		REQUIRE( pacer.getFrameTimes().getNumSamples() == 2 );
+		REQUIRE( pacer.getFrameTimes().getMin() >= 0.002 );
+	}
+}
+
+#endif // defined( CINDER_LINUX )
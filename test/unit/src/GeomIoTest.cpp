@@ -0,0 +1,137 @@
+#include "catch.hpp"
+#include "cinder/GeomIo.h"
+#include "cinder/TriMesh.h"
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+const TriMesh::Format sFormat = TriMesh::Format().positions().normals().texCoords().colors( 4 );
+
+void requireApproxEqual( const vector<float> &a, const vector<float> &b )
+{
+	REQUIRE( a.size() == b.size() );
+	for( size_t i = 0; i < a.size(); ++i )
+		REQUIRE( a[i] == Approx( b[i] ).margin( 1e-5 ) );
+}
+
+void requireEqualMeshes( const TriMesh &a, const TriMesh &b )
+{
+	REQUIRE( a.getNumVertices() == b.getNumVertices() );
+	REQUIRE( a.getIndices() == b.getIndices() );
+	requireApproxEqual( a.getBufferPositions(), b.getBufferPositions() );
+	requireApproxEqual( a.getBufferTexCoords0(), b.getBufferTexCoords0() );
+	requireApproxEqual( a.getBufferColors(), b.getBufferColors() );
+	REQUIRE( a.getNormals().size() == b.getNormals().size() );
+	for( size_t v = 0; v < a.getNormals().size(); ++v )
+		REQUIRE( distance( a.getNormals()[v], b.getNormals()[v] ) < 1e-5f );
+}
+
+//! Returns the positions of \a source, which may be 2D, captured without a TriMesh
+vector<float> loadPositions( const geom::Source &source )
+{
+	geom::SourceModsContext context;
+	source.loadInto( &context, { geom::POSITION } );
+	const float *positions = context.getAttribData( geom::POSITION );
+	return vector<float>( positions, positions + context.getNumVertices() * context.getAttribDims( geom::POSITION ) );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "GeomIo" )
+{
+	// geom::Bounds isn't per-vertex, so placing it between Modifiers prevents them from being fused
+	AxisAlignedBox bounds;
+
+	SECTION( "Fused per-vertex modifiers" )
+	{
+		const auto sphere = geom::Sphere().subdivisions( 40 );
+		const auto twist = geom::Twist().axis( vec3( 0, -1, 0 ), vec3( 0, 1, 0 ) ).startAngle( 0 ).endAngle( 1 );
+		const auto texCoordFn = geom::AttribFn<vec2, vec2>( geom::TEX_COORD_0, []( vec2 t ) { return t * 2.0f; } );
+		const auto colorFn = geom::ColorFromAttrib( geom::NORMAL, []( vec3 n ) { return Colorf( n.x, n.y, n.z ); } );
+
+		TriMesh fused( sphere >> geom::Rotate( 0.5f, vec3( 1, 0, 0 ) ) >> twist >> geom::Translate( 0, 1, 0 ) >> colorFn >> texCoordFn >> geom::Invert( geom::NORMAL ), sFormat );
+		TriMesh separate( sphere >> geom::Rotate( 0.5f, vec3( 1, 0, 0 ) ) >> geom::Bounds( &bounds ) >> twist >> geom::Bounds( &bounds ) >> geom::Translate( 0, 1, 0 )
+			>> geom::Bounds( &bounds ) >> colorFn >> geom::Bounds( &bounds ) >> texCoordFn >> geom::Bounds( &bounds ) >> geom::Invert( geom::NORMAL ), sFormat );
+		requireEqualMeshes( fused, separate );
+		REQUIRE( fused.getNormals()[0] != TriMesh( sphere, sFormat ).getNormals()[0] );
+
+		// loading again reuses the storage of the first load
+		requireEqualMeshes( fused, TriMesh( sphere >> geom::Rotate( 0.5f, vec3( 1, 0, 0 ) ) >> twist >> geom::Translate( 0, 1, 0 ) >> colorFn >> texCoordFn >> geom::Invert( geom::NORMAL ), sFormat ) );
+	}
+
+	SECTION( "Layout changes within fused modifiers" )
+	{
+		// geom::Translate promotes the 2D positions after they're offset
+		const auto offset = geom::AttribFn<vec2, vec2>( geom::POSITION, []( vec2 p ) { return p + vec2( 1, 0 ); } );
+		const vector<float> rect = loadPositions( geom::Rect() );
+		const vector<float> promoted = loadPositions( geom::Rect() >> offset >> geom::Translate( 0, 0, 1 ) );
+		requireApproxEqual( promoted, loadPositions( geom::Rect() >> offset >> geom::Bounds( &bounds ) >> geom::Translate( 0, 0, 1 ) ) );
+		REQUIRE( promoted.size() == rect.size() / 2 * 3 );
+		REQUIRE( vec3( promoted[0], promoted[1], promoted[2] ) == vec3( rect[0] + 1, rect[1], 1 ) );
+
+		// COLOR written as vec3, then replaced by a vec4 Constant and transformed in place
+		const auto colorFromPosition = geom::AttribFn<vec3, vec3>( geom::POSITION, geom::COLOR, []( vec3 p ) { return p; } );
+		const auto halveColor = geom::AttribFn<vec4, vec4>( geom::COLOR, []( vec4 c ) { return c * 0.5f; } );
+		TriMesh replaced( geom::Cube() >> colorFromPosition >> geom::Constant( geom::COLOR, vec4( 1, 0.5f, 0.25f, 1 ) ) >> halveColor, sFormat );
+		requireEqualMeshes( replaced, TriMesh( geom::Cube() >> colorFromPosition >> geom::Bounds( &bounds ) >> geom::Constant( geom::COLOR, vec4( 1, 0.5f, 0.25f, 1 ) )
+			>> geom::Bounds( &bounds ) >> halveColor, sFormat ) );
+		REQUIRE( replaced.getColors<4>()[0] == ColorAf( 0.5f, 0.25f, 0.125f, 0.5f ) );
+
+		// a source attribute of the wrong dimension is converted
+		TriMesh converted( geom::Cube() >> geom::Translate( 1, 0, 0 ) >> geom::AttribFn<vec4, vec4>( geom::POSITION, geom::COLOR, []( vec4 p ) { return p; } ), sFormat );
+		REQUIRE( converted.getColors<4>()[0] == ColorAf( converted.getPositions<3>()[0].x, converted.getPositions<3>()[0].y, converted.getPositions<3>()[0].z, 1 ) );
+	}
+
+	SECTION( "Subdivide and combine" )
+	{
+		const auto cube = geom::Cube();
+		TriMesh subdivided( cube >> geom::Subdivide() >> geom::Subdivide(), sFormat );
+		REQUIRE( subdivided.getNumTriangles() == cube.getNumIndices() / 3 * 9 );
+		REQUIRE( subdivided.getNumVertices() == cube.getNumVertices() + cube.getNumIndices() / 3 * 4 );
+		for( const vec3 &normal : subdivided.getNormals() )
+			REQUIRE( length( normal ) == Approx( 1 ) );
+		// the centroid of the first triangle
+		const TriMesh original( cube, sFormat );
+		const uint32_t *indices = original.getIndices().data();
+		const vec3 *positions = original.getPositions<3>();
+		REQUIRE( distance( subdivided.getPositions<3>()[cube.getNumVertices()], ( positions[indices[0]] + positions[indices[1]] + positions[indices[2]] ) / 3.0f ) < 1e-5f );
+
+		TriMesh combined( ( cube >> geom::Translate( 2, 0, 0 ) ) & ( geom::Sphere() >> geom::Scale( 0.5f ) ), sFormat );
+		const TriMesh sphere( geom::Sphere() >> geom::Scale( 0.5f ), sFormat );
+		REQUIRE( combined.getNumVertices() == original.getNumVertices() + sphere.getNumVertices() );
+		REQUIRE( combined.getNumIndices() == original.getNumIndices() + sphere.getNumIndices() );
+		REQUIRE( combined.getPositions<3>()[0] == original.getPositions<3>()[0] + vec3( 2, 0, 0 ) );
+		REQUIRE( combined.getPositions<3>()[original.getNumVertices()] == sphere.getPositions<3>()[0] );
+		REQUIRE( combined.getIndices()[original.getNumIndices()] == sphere.getIndices()[0] + original.getNumVertices() );
+	}
+
+	SECTION( "Primitives written directly into the Target" )
+	{
+		// requesting tangents makes the primitives generate into temporary storage that's copied into the Target instead
+		const TriMesh::Format tangentsFormat = TriMesh::Format( sFormat ).tangents();
+		const auto sphere = geom::Sphere().subdivisions( 40 ).radius( 2 ).center( vec3( 1, 0, 0 ) );
+		const auto torus = geom::Torus().twist( 2, 0.5f );
+		const auto cylinder = geom::Cylinder().subdivisionsHeight( 4 ).subdivisionsCap( 3 ).direction( vec3( 1, 1, 0 ) );
+		const auto plane = geom::Plane().subdivisions( ivec2( 30, 20 ) );
+		const auto icosphere = geom::Icosphere().subdivisions( 3 );
+		const auto helix = geom::Helix();
+		const auto cone = geom::Cone();
+		const geom::Source *sources[] = { &sphere, &torus, &helix, &cylinder, &cone, &plane, &icosphere };
+		for( const geom::Source *source : sources ) {
+			const TriMesh direct( *source, sFormat );
+			const TriMesh copied( *source, tangentsFormat );
+			REQUIRE( direct.getNumVertices() == source->getNumVertices() );
+			requireEqualMeshes( direct, copied );
+			REQUIRE( copied.getTangents().size() == copied.getNumVertices() );
+			requireApproxEqual( loadPositions( *source ), direct.getBufferPositions() );
+		}
+
+		const TriMesh sphereMesh( sphere, sFormat );
+		for( size_t v = 0; v < sphereMesh.getNumVertices(); ++v ) {
+			REQUIRE( distance( sphereMesh.getPositions<3>()[v], vec3( 1, 0, 0 ) ) == Approx( 2 ) );
+			REQUIRE( dot( sphereMesh.getNormals()[v], sphereMesh.getPositions<3>()[v] - vec3( 1, 0, 0 ) ) == Approx( 2 ) );
+		}
+	}
+}
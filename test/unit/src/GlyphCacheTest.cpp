@@ -0,0 +1,119 @@
+#include "catch.hpp"
+#include "cinder/Cinder.h"
+
+#if defined( CINDER_LINUX )
+
+#include "cinder/Text.h"
+#include "cinder/app/App.h"
+#include "cinder/linux/GlyphCache.h"
+
+#include <cstring>
+
+using namespace ci;
+using namespace std;
+using ci::linux::ftutil::GlyphCache;
+
+namespace {
+
+bool surfacesEqual( const Surface &a, const Surface &b )
+{
+	if( a.getSize() != b.getSize() || a.getRowBytes() != b.getRowBytes() )
+		return false;
+	return memcmp( a.getData(), b.getData(), a.getRowBytes() * a.getHeight() ) == 0;
+}
+
+Surface renderText( const Font &font, const string &text )
+{
+	return TextBox().font( font ).text( text ).color( Color::white() ).backgroundColor( ColorA( 0, 0, 0, 0 ) ).size( 200, TextBox::GROW ).render();
+}
+
+} // anonymous namespace
+
+TEST_CASE( "GlyphCache" )
+{
+	GlyphCache &cache = GlyphCache::instance();
+	const size_t maxBytes = cache.getMaxBytes();
+	cache.clear();
+
+	Font font( app::loadAsset( "Asap-Regular.ttf" ), 23.5f );
+	const string text = "The quick brown fox jumps over the lazy dog, 0123456789 times.";
+
+	SECTION( "Cached glyphs render exactly like uncached ones" )
+	{
+		cache.setMaxBytes( 0 );
+		Surface uncached = renderText( font, text );
+		REQUIRE( cache.getNumGlyphs() == 0 );
+
+		cache.setMaxBytes( maxBytes );
+		Surface first = renderText( font, text );
+		const size_t numMisses = cache.getNumMisses(), numHits = cache.getNumHits();
+		REQUIRE( cache.getNumGlyphs() > 0 );
+
+		Surface second = renderText( font, text );
+		REQUIRE( cache.getNumMisses() == numMisses );
+		REQUIRE( cache.getNumHits() > numHits );
+
+		REQUIRE( surfacesEqual( uncached, first ) );
+		REQUIRE( surfacesEqual( uncached, second ) );
+	}
+
+	SECTION( "Glyphs are keyed by size and subpixel offset" )
+	{
+		FT_Face face = font.getFreetypeFace();
+		const FT_UInt glyphIndex = FT_Get_Char_Index( face, 'a' );
+		auto glyph = cache.getGlyph( face, glyphIndex, { 0, 0 } );
+		REQUIRE( glyph );
+		REQUIRE( glyph->getBitmap()->pitch == (int)glyph->getBitmap()->width );
+		REQUIRE( cache.getGlyph( face, glyphIndex, { 10 * 64, 3 * 64 } ) == glyph );
+		REQUIRE( cache.getGlyph( face, glyphIndex, { 32, 0 } ) != glyph );
+
+		Font larger( app::loadAsset( "Asap-Regular.ttf" ), 40 );
+		auto largerGlyph = cache.getGlyph( larger.getFreetypeFace(), glyphIndex, { 0, 0 } );
+		REQUIRE( largerGlyph->mAdvance.x > glyph->mAdvance.x );
+
+		cache.removeFace( face );
+		REQUIRE( cache.getNumGlyphs() == 1 );
+		REQUIRE( cache.getGlyph( face, glyphIndex, { 0, 0 } ) != glyph );
+	}
+
+	SECTION( "Advances are cached without rendering glyphs" )
+	{
+		FT_Face face = font.getFreetypeFace();
+		const FT_UInt glyphIndex = FT_Get_Char_Index( face, 'w' );
+		const FT_Vector advance = cache.getAdvance( face, glyphIndex );
+		REQUIRE( cache.getNumGlyphs() == 0 );
+		REQUIRE( advance.x == cache.getGlyph( face, glyphIndex, { 0, 0 } )->mAdvance.x );
+
+		TextBox().font( font ).text( text ).size( 100, TextBox::GROW ).measureGlyphs();
+		REQUIRE( cache.getNumGlyphs() == 1 );
+
+		const size_t numMisses = cache.getNumMisses();
+		REQUIRE( cache.getAdvance( face, glyphIndex ).x == advance.x );
+		REQUIRE( cache.getNumMisses() == numMisses );
+	}
+
+	SECTION( "The least recently used glyphs are evicted" )
+	{
+		FT_Face face = font.getFreetypeFace();
+		const FT_UInt first = FT_Get_Char_Index( face, 'A' );
+		cache.getGlyph( face, first, { 0, 0 } );
+		cache.setMaxBytes( cache.getNumBytes() * 8 );
+
+		for( char ch = 'B'; ch <= 'Z'; ++ch ) {
+			cache.getGlyph( face, first, { 0, 0 } );
+			cache.getGlyph( face, FT_Get_Char_Index( face, ch ), { 0, 0 } );
+			REQUIRE( cache.getNumBytes() <= cache.getMaxBytes() );
+		}
+		REQUIRE( cache.getNumGlyphs() < 26 );
+
+		// the glyph used throughout is still cached
+		const size_t numMisses = cache.getNumMisses();
+		cache.getGlyph( face, first, { 0, 0 } );
+		REQUIRE( cache.getNumMisses() == numMisses );
+	}
+
+	cache.setMaxBytes( maxBytes );
+	cache.clear();
+}
+
+#endif // defined( CINDER_LINUX )
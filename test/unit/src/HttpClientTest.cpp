@@ -0,0 +1,354 @@
+#include "catch.hpp"
+#include "cinder/Cinder.h"
+
+#if defined( CINDER_LINUX )
+
+#include "cinder/HttpClient.h"
+#include "cinder/DataSource.h"
+#include "cinder/Utilities.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+string bigBody()
+{
+	string result( 1024 * 1024, 0 );
+	for( size_t i = 0; i < result.size(); ++i )
+		result[i] = char( i % 251 );
+	return result;
+}
+
+//! Minimal HTTP/1.1 stand-in server on 127.0.0.1, which keeps connections alive and serves a fixed set of paths
+class LocalHttpServer {
+  public:
+	LocalHttpServer()
+		: mNumConnections( 0 ), mNumRequests( 0 ), mNumInFlight( 0 ), mMaxInFlight( 0 ), mQuit( false )
+	{
+		mListenSocket = ::socket( AF_INET, SOCK_STREAM, 0 );
+		int reuse = 1;
+		::setsockopt( mListenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+		sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+		address.sin_port = 0;
+		::bind( mListenSocket, (sockaddr*)&address, sizeof( address ) );
+		::listen( mListenSocket, 16 );
+		socklen_t length = sizeof( address );
+		::getsockname( mListenSocket, (sockaddr*)&address, &length );
+		mPort = ntohs( address.sin_port );
+
+		mAcceptThread = thread( [this] { acceptConnections(); } );
+	}
+
+	~LocalHttpServer()
+	{
+		mQuit = true;
+		::shutdown( mListenSocket, SHUT_RDWR );
+		mAcceptThread.join();
+		::close( mListenSocket );
+
+		{
+			lock_guard<mutex> lock( mMutex );
+			for( int connection : mConnections )
+				::shutdown( connection, SHUT_RDWR );
+		}
+		for( auto &thread : mConnectionThreads )
+			thread.join();
+		for( int connection : mConnections )
+			::close( connection );
+	}
+
+	string url( const string &path ) const	{ return "http://127.0.0.1:" + to_string( mPort ) + path; }
+
+	atomic<int>		mNumConnections, mNumRequests, mNumInFlight, mMaxInFlight;
+
+  private:
+	void acceptConnections()
+	{
+		while( ! mQuit ) {
+			int connection = ::accept( mListenSocket, nullptr, nullptr );
+			if( connection < 0 )
+				break;
+
+			++mNumConnections;
+			lock_guard<mutex> lock( mMutex );
+			mConnections.push_back( connection );
+			mConnectionThreads.emplace_back( [this, connection] { serve( connection ); } );
+		}
+	}
+
+	void serve( int connection )
+	{
+		string received;
+		char buffer[4096];
+		while( true ) {
+			size_t headerEnd;
+			while( ( headerEnd = received.find( "\r\n\r\n" ) ) == string::npos ) {
+				ssize_t bytesRead = ::recv( connection, buffer, sizeof( buffer ), 0 );
+				if( bytesRead <= 0 )
+					return;
+				received.append( buffer, bytesRead );
+			}
+
+			const size_t pathStart = received.find( ' ' ) + 1;
+			const string path = received.substr( pathStart, received.find( ' ', pathStart ) - pathStart );
+			received.erase( 0, headerEnd + 4 );
+
+			++mNumRequests;
+			int inFlight = ++mNumInFlight;
+			int maxInFlight = mMaxInFlight;
+			while( inFlight > maxInFlight && ! mMaxInFlight.compare_exchange_weak( maxInFlight, inFlight ) )
+				;
+			respond( connection, path );
+			--mNumInFlight;
+		}
+	}
+
+	void respond( int connection, const string &path )
+	{
+		string status = "200 OK", body;
+		if( path == "/hello" )
+			body = "hello world";
+		else if( path == "/lines" )
+			body = "first\nsecond\nthird";
+		else if( path == "/big" )
+			body = bigBody();
+		else if( path == "/slow" ) {
+			this_thread::sleep_for( chrono::milliseconds( 200 ) );
+			body = "slow";
+		}
+		else if( path == "/stall" ) {
+			// announces a body it never sends
+			const string header = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n";
+			::send( connection, header.data(), header.size(), MSG_NOSIGNAL );
+			for( int i = 0; i < 100 && ! mQuit; ++i )
+				this_thread::sleep_for( chrono::milliseconds( 50 ) );
+			return;
+		}
+		else {
+			status = "404 Not Found";
+			body = "not found";
+		}
+
+		const string response = "HTTP/1.1 " + status + "\r\nContent-Length: " + to_string( body.size() ) + "\r\n\r\n" + body;
+		::send( connection, response.data(), response.size(), MSG_NOSIGNAL );
+	}
+
+	int				mListenSocket;
+	int				mPort;
+	atomic<bool>	mQuit;
+	thread			mAcceptThread;
+	mutex			mMutex;
+	vector<int>		mConnections;
+	vector<thread>	mConnectionThreads;
+};
+
+string bodyString( const HttpTransferRef &transfer )
+{
+	BufferRef body = transfer->getBody();
+	return string( static_cast<const char*>( body->getData() ), body->getSize() );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "HttpClient" )
+{
+	LocalHttpServer server;
+
+	SECTION( "Fetch and reuse connections" )
+	{
+		HttpClient client;
+		atomic<long> completedStatus( 0 );
+		HttpTransferRef hello = client.fetch( Url( server.url( "/hello" ) ), [&]( const HttpTransfer &transfer ) { completedStatus = transfer.getStatusCode(); } );
+		hello->wait();
+		REQUIRE( hello->isComplete() );
+		REQUIRE( completedStatus == 200 );
+		REQUIRE( ! hello->hasError() );
+		REQUIRE( hello->getContentLength() == 11 );
+		REQUIRE( bodyString( hello ) == "hello world" );
+
+		// an HTTP error status isn't a failed transfer
+		HttpTransferRef missing = client.fetch( Url( server.url( "/missing" ) ) );
+		missing->wait();
+		REQUIRE( missing->getStatusCode() == 404 );
+		REQUIRE( ! missing->hasError() );
+		REQUIRE( bodyString( missing ) == "not found" );
+
+		for( int i = 0; i < 3; ++i )
+			client.fetch( Url( server.url( "/hello" ) ) )->wait();
+		REQUIRE( server.mNumRequests == 5 );
+		REQUIRE( server.mNumConnections == 1 );
+	}
+
+	SECTION( "Concurrent transfers are capped" )
+	{
+		HttpClient client( HttpClient::Options().maxTransfers( 2 ) );
+		atomic<int> numCompleted( 0 );
+		vector<HttpTransferRef> transfers;
+		for( int i = 0; i < 6; ++i )
+			transfers.push_back( client.fetch( Url( server.url( "/slow" ) ), [&]( const HttpTransfer & ) { ++numCompleted; } ) );
+		REQUIRE( client.getNumQueuedTransfers() > 0 );
+
+		for( const auto &transfer : transfers ) {
+			transfer->wait();
+			REQUIRE( bodyString( transfer ) == "slow" );
+		}
+		REQUIRE( numCompleted == 6 );
+		REQUIRE( server.mMaxInFlight == 2 );
+		REQUIRE( client.getNumActiveTransfers() + client.getNumQueuedTransfers() == 0 );
+	}
+
+	SECTION( "Streaming and cancellation" )
+	{
+		HttpClient client;
+		string streamed;
+		HttpTransferRef big = client.fetch( Url( server.url( "/big" ) ), "", "", UrlOptions(),
+			[&]( const void *data, size_t size ) { streamed.append( static_cast<const char*>( data ), size ); return true; } );
+		big->wait();
+		REQUIRE( streamed == bigBody() );
+		REQUIRE( big->getBytesReceived() == streamed.size() );
+		REQUIRE( big->getBody() == nullptr );
+
+		// pausing leaves the rest of the body with the server until resume()
+		mutex pausedMutex;
+		HttpTransferRef paused;
+		string pausedStreamed;
+		{
+			lock_guard<mutex> lock( pausedMutex );
+			paused = client.fetch( Url( server.url( "/big" ) ), "", "", UrlOptions(), [&]( const void *data, size_t size ) {
+				lock_guard<mutex> lock( pausedMutex );
+				pausedStreamed.append( static_cast<const char*>( data ), size );
+				paused->pause();
+				return true;
+			} );
+		}
+		REQUIRE( ! paused->wait( 0.2 ) );
+		REQUIRE( paused->getBytesReceived() < bigBody().size() );
+		while( ! paused->wait( 0.001 ) )
+			paused->resume();
+		REQUIRE( ! paused->hasError() );
+		REQUIRE( pausedStreamed == bigBody() );
+
+		// returning false from the DataFn cancels the transfer
+		HttpTransferRef aborted = client.fetch( Url( server.url( "/big" ) ), "", "", UrlOptions(), []( const void *, size_t ) { return false; } );
+		aborted->wait();
+		REQUIRE( aborted->isCancelled() );
+		REQUIRE( aborted->hasError() );
+
+		bool completionCalled = false;
+		HttpTransferRef stalled = client.fetch( Url( server.url( "/stall" ) ), [&]( const HttpTransfer & ) { completionCalled = true; } );
+		REQUIRE( ! stalled->wait( 0.1 ) );
+		stalled->cancel();
+		stalled->wait();
+		REQUIRE( completionCalled );
+		REQUIRE( stalled->isCancelled() );
+		REQUIRE( stalled->hasError() );
+	}
+
+	SECTION( "Disk cache" )
+	{
+		const fs::path cacheDirectory = fs::temp_directory_path() / "cinder_http_client_cache";
+		fs::remove_all( cacheDirectory );
+		HttpClient client( HttpClient::Options().cacheDirectory( cacheDirectory ) );
+		const Url helloUrl( server.url( "/hello" ) );
+
+		HttpTransferRef first = client.fetch( helloUrl );
+		first->wait();
+		REQUIRE( ! first->isFromCache() );
+		REQUIRE( fs::exists( client.getCachePath( helloUrl ) ) );
+
+		HttpTransferRef cached = client.fetch( helloUrl );
+		cached->wait();
+		REQUIRE( cached->isFromCache() );
+		REQUIRE( bodyString( cached ) == "hello world" );
+		REQUIRE( server.mNumRequests == 1 );
+
+		string streamed;
+		client.fetch( helloUrl, "", "", UrlOptions(), [&]( const void *data, size_t size ) { streamed.append( static_cast<const char*>( data ), size ); return true; } )->wait();
+		REQUIRE( streamed == "hello world" );
+		REQUIRE( server.mNumRequests == 1 );
+
+		HttpTransferRef ignored = client.fetch( helloUrl, HttpTransfer::CompletionFn(), UrlOptions().ignoreCache() );
+		ignored->wait();
+		REQUIRE( ! ignored->isFromCache() );
+		REQUIRE( server.mNumRequests == 2 );
+
+		// only successful responses are cached
+		client.fetch( Url( server.url( "/missing" ) ) )->wait();
+		REQUIRE( ! fs::exists( client.getCachePath( Url( server.url( "/missing" ) ) ) ) );
+
+		// responses to different credentials are cached apart
+		REQUIRE( client.getCachePath( helloUrl, "user", "first" ) != client.getCachePath( helloUrl, "user", "second" ) );
+		REQUIRE( client.getCachePath( helloUrl, "user", "first" ) != client.getCachePath( helloUrl ) );
+
+		// concurrent fetches of a response that isn't cached yet write it to separate files
+		fs::remove( client.getCachePath( helloUrl ) );
+		vector<HttpTransferRef> concurrent;
+		for( int i = 0; i < 4; ++i )
+			concurrent.push_back( client.fetch( helloUrl ) );
+		for( const auto &transfer : concurrent ) {
+			transfer->wait();
+			REQUIRE( bodyString( transfer ) == "hello world" );
+		}
+		REQUIRE( loadString( loadFile( client.getCachePath( helloUrl ) ) ) == "hello world" );
+		size_t numCacheFiles = 0;
+		for( fs::directory_iterator fileIt( cacheDirectory ), end; fileIt != end; ++fileIt )
+			++numCacheFiles;
+		REQUIRE( numCacheFiles == 1 );
+
+		client.setOptions( HttpClient::Options() );
+		REQUIRE( client.getCachePath( helloUrl ).empty() );
+		fs::remove_all( cacheDirectory );
+	}
+
+	SECTION( "loadUrl streams through the shared client" )
+	{
+		REQUIRE( loadString( loadUrl( Url( server.url( "/big" ) ) ) ) == bigBody() );
+
+		IStreamUrlRef stream = loadUrlStream( server.url( "/lines" ) );
+		REQUIRE( stream->size() == 18 );
+		REQUIRE( stream->readLine() == "first" );
+		REQUIRE( stream->readLine() == "second" );
+		REQUIRE( stream->readLine() == "third" );
+		REQUIRE( stream->isEof() );
+
+		// destroying a stream that's still receiving cancels its transfer
+		loadUrlStream( server.url( "/stall" ) );
+	}
+}
+
+TEST_CASE( "HttpClient connection failure" )
+{
+	// claim a port, and release it so nothing is listening there
+	int unusedSocket = ::socket( AF_INET, SOCK_STREAM, 0 );
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	::bind( unusedSocket, (sockaddr*)&address, sizeof( address ) );
+	socklen_t length = sizeof( address );
+	::getsockname( unusedSocket, (sockaddr*)&address, &length );
+	::close( unusedSocket );
+	const string url = "http://127.0.0.1:" + to_string( ntohs( address.sin_port ) ) + "/hello";
+
+	HttpTransferRef transfer = HttpClient::instance().fetch( Url( url ) );
+	transfer->wait();
+	REQUIRE( transfer->hasError() );
+	REQUIRE( transfer->getStatusCode() == 0 );
+
+	REQUIRE_THROWS_AS( loadUrlStream( url )->size(), StreamExc );
+}
+
+#endif // defined( CINDER_LINUX )
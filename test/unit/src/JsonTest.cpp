@@ -1,6 +1,7 @@
 #include "cinder/app/App.h"
 #include "cinder/app/Platform.h"
 #include "cinder/Json.h"
+#include "cinder/JsonDocument.h"
 
 #include "jsoncpp/json.h"
 #include "catch.hpp"
@@ -201,3 +202,121 @@ TEST_CASE("Json", "[noisy]")
 	}
 	
 } // json
+
+namespace {
+
+//! Records SAX events as a flat string, for comparing parses of the same input.
+class RecordingHandler : public json::Handler {
+  public:
+	bool onNull() override								{ mEvents += "null,"; return true; }
+	bool onBool( bool value ) override					{ mEvents += value ? "true," : "false,"; return true; }
+	bool onInt( int64_t value ) override				{ mEvents += "i" + to_string( value ) + ","; return true; }
+	bool onUint( uint64_t value ) override				{ mEvents += "u" + to_string( value ) + ","; return true; }
+	bool onDouble( double value ) override				{ mEvents += "d" + toString( value ) + ","; return true; }
+	bool onString( const char *str, size_t length ) override	{ mEvents += "'" + string( str, length ) + "',"; return true; }
+	bool onKey( const char *str, size_t length ) override		{ mEvents += string( str, length ) + ":"; return true; }
+	bool onStartObject() override						{ mEvents += "{"; return true; }
+	bool onEndObject( size_t numMembers ) override		{ mEvents += "}" + to_string( numMembers ) + ","; return true; }
+	bool onStartArray() override						{ mEvents += "["; return true; }
+	bool onEndArray( size_t numElements ) override		{ mEvents += "]" + to_string( numElements ) + ","; return true; }
+
+	string mEvents;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "JsonDocument" )
+{
+	const string source = "{ \"name\": \"caf\\u00e9 \\\"quoted\\\"\", \"count\": 3, \"negative\": -12, \"big\": 18446744073709551615,\n"
+		" \"pi\": 3.14159, \"exp\": 1.5e3, \"flags\": [true, false, null], // comment\n"
+		" \"nested\": { \"items\": [ { \"id\": 0 }, { \"id\": 1 }, { \"id\": 2 } ], \"emoji\": \"\\ud83d\\ude00\" } }";
+
+	SECTION( "Reader produces the same events for string, in situ and streamed input" )
+	{
+		RecordingHandler fromString, inSitu, streamed;
+		REQUIRE( json::Reader().parse( source, &fromString ) );
+
+		string copy = source;
+		REQUIRE( json::Reader().parseInSitu( &copy[0], copy.size(), &inSitu ) );
+
+		// a tiny chunk size forces tokens to straddle chunk boundaries
+		auto stream = DataSourceBuffer::create( Buffer::create( (void *)source.data(), source.size() ) )->createStream();
+		REQUIRE( json::Reader( json::Reader::Options().chunkSize( 7 ) ).parse( stream, &streamed ) );
+
+		REQUIRE( fromString.mEvents == inSitu.mEvents );
+		REQUIRE( fromString.mEvents == streamed.mEvents );
+		REQUIRE( fromString.mEvents.find( "name:'caf\xc3\xa9 \"quoted\"'," ) != string::npos );
+		REQUIRE( fromString.mEvents.find( "negative:i-12," ) != string::npos );
+		REQUIRE( fromString.mEvents.find( "big:u18446744073709551615," ) != string::npos );
+		REQUIRE( fromString.mEvents.find( "flags:[true,false,null,]3," ) != string::npos );
+	}
+
+	SECTION( "Document lookups" )
+	{
+		json::Document doc( source );
+		const json::Value &root = doc.getRoot();
+
+		REQUIRE( root.isObject() );
+		REQUIRE( root.getSize() == 8 );
+		REQUIRE( string( root["name"].getString() ) == "caf\xc3\xa9 \"quoted\"" );
+		REQUIRE( root["count"].getInt() == 3 );
+		REQUIRE( root["negative"].getInt() == -12 );
+		REQUIRE( root["big"].getUint() == 18446744073709551615ULL );
+		REQUIRE( root["pi"].getDouble() == 3.14159 );
+		REQUIRE( root["exp"].getDouble() == 1500.0 );
+		REQUIRE( root["flags"][0].getBool() );
+		REQUIRE( root["flags"][2].isNull() );
+		REQUIRE( doc.getChild( "nested.items.2.id" ).getInt() == 2 );
+		REQUIRE( string( doc.getChild( "nested.emoji" ).getString() ) == "\xf0\x9f\x98\x80" );
+		REQUIRE( root.find( "missing" ) == nullptr );
+		REQUIRE_THROWS_AS( root["missing"], json::ExcChildNotFound );
+		REQUIRE_THROWS_AS( root["name"].getInt(), json::ExcTypeMismatch );
+
+		// members are kept in document order
+		REQUIRE( string( root.beginMembers()->getKey() ) == "name" );
+		REQUIRE( string( ( root.endMembers() - 1 )->getKey() ) == "nested" );
+	}
+
+	SECTION( "Objects large enough to be hashed" )
+	{
+		string large = "{";
+		for( int i = 0; i < 100; i++ )
+			large += ( i ? ",\"key" : "\"key" ) + to_string( i ) + "\":" + to_string( i );
+		large += "}";
+
+		json::Document doc( large );
+		for( int i = 0; i < 100; i++ )
+			REQUIRE( doc["key" + to_string( i )].getInt() == i );
+		REQUIRE( ! doc.getRoot().hasChild( "key100" ) );
+	}
+
+	SECTION( "Parse errors report line and column" )
+	{
+		try {
+			json::Document doc( string( "{\n  \"a\": 1,\n  \"b\": tru }" ) );
+			FAIL( "expected ExcParseError" );
+		}
+		catch( const json::ExcParseError &exc ) {
+			REQUIRE( exc.getLine() == 3 );
+		}
+
+		REQUIRE_THROWS_AS( json::Document( string( "[1, 2" ) ), json::ExcParseError );
+		REQUIRE_THROWS_AS( json::Document( string( "[01]" ) ), json::ExcParseError );
+		REQUIRE_THROWS_AS( json::Document( string( "{} extra" ) ), json::ExcParseError );
+	}
+
+	SECTION( "JsonTree from Document matches JsonTree from string" )
+	{
+		json::Document doc( source );
+		JsonTree fromDoc( doc );
+		JsonTree fromString( source );
+
+		REQUIRE( fromDoc.getNodeType() == JsonTree::NODE_OBJECT );
+		REQUIRE( fromDoc.getNumChildren() == fromString.getNumChildren() );
+		for( const char *key : { "name", "count", "negative", "big", "pi", "exp", "flags.0", "flags.1", "flags.2", "nested.items.1.id", "nested.emoji" } )
+			REQUIRE( fromDoc.getValueForKey( key ) == fromString.getValueForKey( key ) );
+
+		REQUIRE( fromDoc.getChild( "nested.items" ).getNodeType() == JsonTree::NODE_ARRAY );
+		REQUIRE( &fromDoc.getChild( "nested.items.1" ).getParent() == &fromDoc.getChild( "nested.items" ) );
+	}
+}
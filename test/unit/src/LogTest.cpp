@@ -0,0 +1,129 @@
+#include "catch.hpp"
+#include "cinder/Log.h"
+
+#include <thread>
+
+using namespace cinder;
+using namespace std;
+
+namespace {
+
+class LoggerCollect : public log::Logger {
+  public:
+	void write( const log::Metadata &meta, const std::string &text ) override
+	{
+		mLevels.push_back( meta.mLevel );
+		mTexts.push_back( text );
+		mThreadIds.push_back( this_thread::get_id() );
+	}
+
+	vector<log::Level>		mLevels;
+	vector<string>			mTexts;
+	vector<thread::id>		mThreadIds;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "Log" )
+{
+	auto manager = log::manager();
+	auto previousLoggers = manager->getAllLoggers();
+
+	auto collector = make_shared<LoggerCollect>();
+	manager->resetLogger( collector );
+
+	SECTION( "Synchronous logging runs Loggers on the calling thread" )
+	{
+		REQUIRE( ! manager->isAsyncEnabled() );
+		manager->write( log::Metadata{ log::LEVEL_INFO, log::Location( "func", "file", 1 ) }, "sync" );
+
+		REQUIRE( collector->mTexts.size() == 1 );
+		REQUIRE( collector->mTexts[0] == "sync" );
+		REQUIRE( collector->mThreadIds[0] == this_thread::get_id() );
+	}
+
+	SECTION( "Asynchronous logging preserves entries and their order" )
+	{
+		manager->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::BLOCK ).queueSize( 512 ) );
+		REQUIRE( manager->isAsyncEnabled() );
+
+		const int numEntries = 1000;
+		for( int i = 0; i < numEntries; i++ )
+			manager->write( log::Metadata{ log::LEVEL_WARNING, log::Location( "func", "file", i ) }, to_string( i ) );
+
+		manager->flush();
+
+		REQUIRE( collector->mTexts.size() == numEntries );
+		for( int i = 0; i < numEntries; i++ )
+			REQUIRE( collector->mTexts[i] == to_string( i ) );
+		REQUIRE( collector->mLevels.back() == log::LEVEL_WARNING );
+		// the queue only holds a few entries, so the first ones must have been delivered by the background thread
+		REQUIRE( collector->mThreadIds.front() != this_thread::get_id() );
+		REQUIRE( manager->getNumDroppedEntries() == 0 );
+
+		manager->disableAsync();
+		REQUIRE( ! manager->isAsyncEnabled() );
+	}
+
+	SECTION( "Asynchronous logging from many threads" )
+	{
+		manager->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::BLOCK ).queueSize( 1024 ) );
+
+		const int numThreads = 4;
+		const int numEntriesPerThread = 500;
+		vector<thread> threads;
+		for( int t = 0; t < numThreads; t++ ) {
+			threads.emplace_back( [manager, t] {
+				for( int i = 0; i < numEntriesPerThread; i++ )
+					manager->write( log::Metadata{ log::LEVEL_INFO, log::Location( "func", "file", i ) }, to_string( t ) );
+			} );
+		}
+
+		for( auto &t : threads )
+			t.join();
+
+		// disabling flushes all entries, including those of threads that have already exited
+		manager->disableAsync();
+
+		REQUIRE( collector->mTexts.size() == numThreads * numEntriesPerThread );
+		for( int t = 0; t < numThreads; t++ )
+			REQUIRE( count( collector->mTexts.begin(), collector->mTexts.end(), to_string( t ) ) == numEntriesPerThread );
+	}
+
+	SECTION( "Entries larger than a tiny queue are truncated rather than blocking forever" )
+	{
+		manager->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::BLOCK ).queueSize( 8 ) );
+
+		const string longName( 300, 'f' );
+		manager->write( log::Metadata{ log::LEVEL_INFO, log::Location( longName, longName, 1 ) }, "text" );
+		manager->write( log::Metadata{ log::LEVEL_INFO, log::Location( "func", "file", 2 ) }, string( 1000, 't' ) );
+		manager->disableAsync();
+
+		REQUIRE( collector->mTexts.size() == 2 );
+		REQUIRE( manager->getNumDroppedEntries() == 0 );
+	}
+
+	SECTION( "OverflowPolicy::DROP discards and counts entries when the queue is full" )
+	{
+		manager->enableAsync( log::AsyncOptions().overflowPolicy( log::OverflowPolicy::DROP ).queueSize( 256 ) );
+
+		const int numEntries = 100;
+		{
+			// holding the logger mutex keeps the background thread from draining while the queue is being filled
+			lock_guard<mutex> lock( manager->getMutex() );
+			for( int i = 0; i < numEntries; i++ )
+				manager->write( log::Metadata{ log::LEVEL_INFO, log::Location( "func", "file", i ) }, "dropped?" );
+		}
+
+		manager->flush();
+
+		REQUIRE( manager->getNumDroppedEntries() > 0 );
+		REQUIRE( collector->mTexts.size() + manager->getNumDroppedEntries() == numEntries );
+
+		manager->disableAsync();
+	}
+
+	manager->clearLoggers();
+	for( const auto &logger : previousLoggers )
+		manager->addLogger( logger );
+}
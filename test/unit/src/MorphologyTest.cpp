@@ -0,0 +1,219 @@
+#include "catch.hpp"
+#include "cinder/ip/ConnectedComponents.h"
+#include "cinder/ip/Fill.h"
+#include "cinder/ip/Morphology.h"
+#include "cinder/Rand.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+Channel8u makeRandomChannel( int32_t width, int32_t height, float density = 1, uint32_t seed = 1234 )
+{
+	Rand rand( seed );
+	Channel8u result( width, height );
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x )
+			result.setValue( ivec2( x, y ), rand.nextFloat() < density ? (uint8_t)rand.nextInt( 256 ) : 0 );
+	}
+	return result;
+}
+
+// Pixels outside of the channel are ignored
+Channel8u referenceMorphology( const Channel8u &src, const ivec2 &size, bool erode )
+{
+	Channel8u result( src.getWidth(), src.getHeight() );
+	const ivec2 anchor = size / 2;
+	for( int32_t y = 0; y < src.getHeight(); ++y ) {
+		for( int32_t x = 0; x < src.getWidth(); ++x ) {
+			uint8_t value = erode ? 255 : 0;
+			for( int32_t ky = 0; ky < size.y; ++ky ) {
+				for( int32_t kx = 0; kx < size.x; ++kx ) {
+					const ivec2 p( x + kx - anchor.x, y + ky - anchor.y );
+					if( src.getBounds().contains( p ) )
+						value = erode ? std::min( value, src.getValue( p ) ) : std::max( value, src.getValue( p ) );
+				}
+			}
+			result.setValue( ivec2( x, y ), value );
+		}
+	}
+	return result;
+}
+
+bool channelsEqual( const Channel8u &a, const Channel8u &b )
+{
+	for( int32_t y = 0; y < a.getHeight(); ++y ) {
+		for( int32_t x = 0; x < a.getWidth(); ++x ) {
+			if( a.getValue( ivec2( x, y ) ) != b.getValue( ivec2( x, y ) ) )
+				return false;
+		}
+	}
+	return true;
+}
+
+// Labels by flood filling from each unlabeled pixel in raster order, which matches the order of findConnectedComponents()
+vector<uint32_t> referenceLabels( const Channel8u &channel, bool eight )
+{
+	const int32_t width = channel.getWidth(), height = channel.getHeight();
+	vector<uint32_t> labels( width * height, 0 );
+	uint32_t next = 0;
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x ) {
+			if( ! channel.getValue( ivec2( x, y ) ) || labels[y * width + x] )
+				continue;
+			labels[y * width + x] = ++next;
+			vector<ivec2> stack( 1, ivec2( x, y ) );
+			while( ! stack.empty() ) {
+				const ivec2 p = stack.back();
+				stack.pop_back();
+				for( int32_t dy = -1; dy <= 1; ++dy ) {
+					for( int32_t dx = -1; dx <= 1; ++dx ) {
+						const ivec2 q = p + ivec2( dx, dy );
+						if( ( ! eight && dx && dy ) || ! channel.getBounds().contains( q ) || ! channel.getValue( q ) || labels[q.y * width + q.x] )
+							continue;
+						labels[q.y * width + q.x] = next;
+						stack.push_back( q );
+					}
+				}
+			}
+		}
+	}
+	return labels;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip::Morphology" )
+{
+	SECTION( "Erode and dilate match a per-pixel reference" )
+	{
+		const Channel8u src = makeRandomChannel( 300, 71 );
+		for( ivec2 size : { ivec2( 1, 1 ), ivec2( 3, 3 ), ivec2( 4, 2 ), ivec2( 1, 7 ), ivec2( 9, 1 ), ivec2( 17, 5 ), ivec2( 400, 100 ) } ) {
+			Channel8u eroded( 300, 71 ), dilated( 300, 71 ), serial( 300, 71 );
+			ip::erode( src, &eroded, size );
+			ip::dilate( src, &dilated, size );
+			REQUIRE( channelsEqual( eroded, referenceMorphology( src, size, true ) ) );
+			REQUIRE( channelsEqual( dilated, referenceMorphology( src, size, false ) ) );
+			ip::dilate( src, &serial, size, false );
+			REQUIRE( channelsEqual( dilated, serial ) );
+		}
+
+		// in place, and between the channels of Surfaces
+		Channel8u inPlace = src.clone();
+		ip::erode( &inPlace, ivec2( 5, 3 ) );
+		REQUIRE( channelsEqual( inPlace, referenceMorphology( src, ivec2( 5, 3 ), true ) ) );
+
+		Surface8u surface( 300, 71, true );
+		surface.getChannelGreen().copyFrom( src, src.getBounds() );
+		ip::dilate( surface.getChannelGreen(), &surface.getChannelBlue(), ivec2( 6, 6 ) );
+		REQUIRE( channelsEqual( surface.getChannelBlue(), referenceMorphology( src, ivec2( 6, 6 ), false ) ) );
+	}
+
+	SECTION( "Open removes specks and close fills holes" )
+	{
+		Channel8u channel( 40, 30 );
+		ip::fill<uint8_t>( &channel, 0 );
+		ip::fill<uint8_t>( &channel, 255, Area( 5, 5, 25, 20 ) );
+		channel.setValue( ivec2( 35, 3 ), 255 );
+		channel.setValue( ivec2( 10, 10 ), 0 );
+
+		Channel8u opened( 40, 30 ), closed( 40, 30 );
+		ip::open( channel, &opened, ivec2( 3, 3 ) );
+		REQUIRE( opened.getValue( ivec2( 35, 3 ) ) == 0 );
+		REQUIRE( opened.getValue( ivec2( 5, 5 ) ) == 255 );
+		REQUIRE( opened.getValue( ivec2( 24, 19 ) ) == 255 );
+
+		ip::close( channel, &closed, ivec2( 3, 3 ) );
+		REQUIRE( closed.getValue( ivec2( 10, 10 ) ) == 255 );
+		REQUIRE( closed.getValue( ivec2( 35, 3 ) ) == 255 );
+		REQUIRE( closed.getValue( ivec2( 4, 5 ) ) == 0 );
+	}
+
+	SECTION( "Open never brightens and close never darkens, for even sizes too" )
+	{
+		Channel8u row( 3, 1 );
+		row.setValue( ivec2( 0, 0 ), 255 );
+		row.setValue( ivec2( 1, 0 ), 255 );
+		row.setValue( ivec2( 2, 0 ), 0 );
+		Channel8u openedRow( 3, 1 ), closedRow( 3, 1 );
+		ip::open( row, &openedRow, ivec2( 2, 1 ) );
+		REQUIRE( openedRow.getValue( ivec2( 2, 0 ) ) == 0 );
+		ip::close( row, &closedRow, ivec2( 2, 1 ) );
+		REQUIRE( closedRow.getValue( ivec2( 0, 0 ) ) == 255 );
+
+		const Channel8u src = makeRandomChannel( 120, 50, 0.5f );
+		for( ivec2 size : { ivec2( 2, 2 ), ivec2( 4, 1 ), ivec2( 1, 6 ), ivec2( 3, 3 ), ivec2( 8, 5 ) } ) {
+			Channel8u opened( 120, 50 ), closed( 120, 50 );
+			ip::open( src, &opened, size );
+			ip::close( src, &closed, size );
+			bool antiExtensive = true, extensive = true;
+			for( int32_t y = 0; y < src.getHeight(); ++y ) {
+				for( int32_t x = 0; x < src.getWidth(); ++x ) {
+					antiExtensive = antiExtensive && opened.getValue( ivec2( x, y ) ) <= src.getValue( ivec2( x, y ) );
+					extensive = extensive && closed.getValue( ivec2( x, y ) ) >= src.getValue( ivec2( x, y ) );
+				}
+			}
+			REQUIRE( antiExtensive );
+			REQUIRE( extensive );
+		}
+	}
+}
+
+TEST_CASE( "ip::ConnectedComponents" )
+{
+	SECTION( "Connectivity and statistics" )
+	{
+		// a 2x2 square, a diagonal line of 3 pixels and a single pixel touching the square diagonally
+		Channel8u channel( 10, 8 );
+		ip::fill<uint8_t>( &channel, 0 );
+		ip::fill<uint8_t>( &channel, 200, Area( 1, 1, 3, 3 ) );
+		for( int32_t i = 0; i < 3; ++i )
+			channel.setValue( ivec2( 6 + i, 2 + i ), 255 );
+		channel.setValue( ivec2( 3, 3 ), 10 );
+
+		vector<uint32_t> labels;
+		const vector<ip::ConnectedComponent> eight = ip::findConnectedComponents( channel, &labels );
+		REQUIRE( eight.size() == 2 );
+		REQUIRE( eight[0].getLabel() == 1 );
+		REQUIRE( eight[0].getArea() == 5 );
+		REQUIRE( eight[0].getBounds() == Area( 1, 1, 4, 4 ) );
+		REQUIRE( eight[0].getCentroid().x == Approx( 1.8f ) );
+		REQUIRE( eight[1].getArea() == 3 );
+		REQUIRE( eight[1].getCentroid() == vec2( 7, 3 ) );
+		REQUIRE( labels[3 * 10 + 3] == 1 );
+		REQUIRE( labels[4 * 10 + 8] == 2 );
+		REQUIRE( labels[0] == 0 );
+
+		const vector<ip::ConnectedComponent> four = ip::findConnectedComponents( channel, nullptr, ip::ConnectedComponentsOptions().connectivity( ip::Connectivity::FOUR ) );
+		REQUIRE( four.size() == 5 );
+
+		const vector<ip::ConnectedComponent> thresholded = ip::findConnectedComponents( channel, nullptr, ip::ConnectedComponentsOptions().threshold( 10 ) );
+		REQUIRE( thresholded.size() == 2 );
+		REQUIRE( thresholded[0].getArea() == 4 );
+	}
+
+	SECTION( "Bands labeled in parallel match a flood fill" )
+	{
+		// tall enough to be split into several bands, with components spanning them
+		const Channel8u channel = makeRandomChannel( 64, 4000, 0.55f, 77 );
+		for( auto connectivity : { ip::Connectivity::FOUR, ip::Connectivity::EIGHT } ) {
+			const bool eight = connectivity == ip::Connectivity::EIGHT;
+			const vector<uint32_t> expected = referenceLabels( channel, eight );
+			vector<uint32_t> parallel, serial;
+			const auto components = ip::findConnectedComponents( channel, &parallel, ip::ConnectedComponentsOptions().connectivity( connectivity ) );
+			ip::findConnectedComponents( channel, &serial, ip::ConnectedComponentsOptions().connectivity( connectivity ).parallel( false ) );
+			REQUIRE( parallel == expected );
+			REQUIRE( serial == expected );
+
+			uint32_t totalArea = 0;
+			for( const auto &component : components )
+				totalArea += component.getArea();
+			REQUIRE( totalArea == (uint32_t)count_if( expected.begin(), expected.end(), []( uint32_t label ) { return label != 0; } ) );
+			REQUIRE( components.size() == *max_element( expected.begin(), expected.end() ) );
+		}
+	}
+}
@@ -179,4 +179,41 @@ TEST_CASE("Path2d")
 		REQUIRE( glm::distance( p.getPosition( 0 ), vec2( 1, 2 ) ) == Approx( 0 ).epsilon( 0.001 ) );
 		REQUIRE( glm::distance( p.getPosition( 1.0 ), vec2( 11, 12 ) ) == Approx( 0 ).epsilon( 0.001 ) );
 	}
+
+	SECTION("Path2dCalcCache: point queries match Path2d")
+	{
+		Rand r( 17 );
+		for( int p = 0; p < 20; ++p ) {
+			Path2d path;
+			path.moveTo( r.nextFloat( 500 ), r.nextFloat( 500 ) );
+			for( int i = 0; i < 12; ++i ) {
+				switch( r.nextInt( 3 ) ) {
+					case 0: path.lineTo( r.nextFloat( 500 ), r.nextFloat( 500 ) ); break;
+					case 1: path.quadTo( r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ) ); break;
+					default: path.curveTo( r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ), r.nextFloat( 500 ) ); break;
+				}
+			}
+			if( p % 2 )
+				path.close();
+
+			Path2dCalcCache cache( path );
+			for( const vec2 &pos : cache.getPositions() )
+				REQUIRE( path.calcDistance( pos ) < 0.5f );
+
+			// enough points to be split across threads
+			vector<vec2> points;
+			for( int i = 0; i < 4000; ++i )
+				points.push_back( vec2( r.nextFloat( -50, 550 ), r.nextFloat( -50, 550 ) ) );
+
+			unique_ptr<bool[]> inside( new bool[points.size()] );
+			cache.contains( points.data(), points.size(), inside.get(), p % 3 == 0 );
+			vector<float> distances = cache.calcDistances( points );
+			vector<vec2> closestPoints = cache.calcClosestPoints( points );
+			for( size_t i = 0; i < points.size(); i += 7 ) {
+				REQUIRE( inside[i] == path.contains( points[i], p % 3 == 0 ) );
+				REQUIRE( distances[i] == Approx( path.calcDistance( points[i] ) ) );
+				REQUIRE( glm::distance( points[i], closestPoints[i] ) == Approx( distances[i] ) );
+			}
+		}
+	}
 }
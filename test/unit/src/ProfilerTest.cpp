@@ -0,0 +1,123 @@
+#include "catch.hpp"
+#include "cinder/Profiler.h"
+#include "cinder/Json.h"
+#include "cinder/Utilities.h"
+
+#include <map>
+#include <thread>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Returns the events of \a trace grouped by name
+map<string, vector<JsonTree>> parseTrace( const string &trace )
+{
+	const JsonTree json( trace );
+	map<string, vector<JsonTree>> result;
+	for( const auto &event : json.getChild( "traceEvents" ).getChildren() )
+		result[event.getValueForKey( "name" )].push_back( event );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Profiler" )
+{
+	profile::Profiler &profiler = profile::Profiler::instance();
+	profiler.clear();
+	profile::Profiler::setEnabled( true );
+
+	SECTION( "Zones, counters and frames" )
+	{
+		{
+			CI_PROFILE_ZONE( "outer" );
+			CI_PROFILE_ZONE( "inner \"quoted\"" );
+			CI_PROFILE_COUNTER( "particles", 1024 );
+			this_thread::sleep_for( chrono::milliseconds( 2 ) );
+		}
+		CI_PROFILE_FRAME( "Frame" );
+
+		thread worker( [] {
+			setThreadName( "worker" );
+			CI_PROFILE_ZONE( "work" );
+		} );
+		worker.join();
+
+		auto events = parseTrace( profiler.getChromeTrace() );
+		REQUIRE( events["outer"].size() == 1 );
+		REQUIRE( events["inner \"quoted\""].size() == 1 );
+		const JsonTree &outer = events["outer"].front();
+		const JsonTree &inner = events["inner \"quoted\""].front();
+		REQUIRE( outer.getValueForKey( "ph" ) == "X" );
+		REQUIRE( inner.getValueForKey<double>( "dur" ) >= 2000 );
+		REQUIRE( outer.getValueForKey<double>( "dur" ) >= inner.getValueForKey<double>( "dur" ) );
+		REQUIRE( outer.getValueForKey<double>( "ts" ) <= inner.getValueForKey<double>( "ts" ) );
+
+		REQUIRE( events["particles"].size() == 1 );
+		REQUIRE( events["particles"].front().getValueForKey( "ph" ) == "C" );
+		REQUIRE( events["particles"].front().getValueForKey<double>( "args.value" ) == 1024 );
+		REQUIRE( events["Frame"].size() == 1 );
+		REQUIRE( events["Frame"].front().getValueForKey( "ph" ) == "i" );
+
+		// the worker's events are on its own named thread
+		REQUIRE( events["work"].size() == 1 );
+		const int workerId = events["work"].front().getValueForKey<int>( "tid" );
+		REQUIRE( workerId != outer.getValueForKey<int>( "tid" ) );
+		bool named = false;
+		for( const auto &metadata : events["thread_name"] )
+			named |= metadata.getValueForKey<int>( "tid" ) == workerId && metadata.getValueForKey( "args.name" ) == "worker";
+		REQUIRE( named );
+
+		profiler.clear();
+		REQUIRE( parseTrace( profiler.getChromeTrace() ).count( "outer" ) == 0 );
+	}
+
+	SECTION( "Nothing is recorded while disabled" )
+	{
+		profile::Profiler::setEnabled( false );
+		{
+			CI_PROFILE_ZONE( "disabled" );
+			CI_PROFILE_FRAME( "Frame" );
+		}
+		REQUIRE( parseTrace( profiler.getChromeTrace() ).count( "disabled" ) == 0 );
+	}
+
+	SECTION( "Each thread keeps its most recent events" )
+	{
+		profiler.setEventsPerThread( 10 );
+		thread worker( [&] {
+			for( int i = 0; i < 100; ++i )
+				profiler.recordCounter( "count", i );
+		} );
+		worker.join();
+		profiler.setEventsPerThread( 1 << 15 );
+
+		auto counts = parseTrace( profiler.getChromeTrace() )["count"];
+		REQUIRE( counts.size() == 16 );
+		REQUIRE( counts.front().getValueForKey<int>( "args.value" ) == 84 );
+		REQUIRE( counts.back().getValueForKey<int>( "args.value" ) == 99 );
+	}
+
+	SECTION( "Frame spikes" )
+	{
+		// frame times are measured per thread, so use one which hasn't recorded any frames yet
+		vector<double> spikes;
+		profiler.setFrameSpikeFn( 0.02, [&]( const char *name, double frameSeconds ) { spikes.push_back( frameSeconds ); } );
+		thread frames( [&] {
+			profiler.recordFrame( "spikes" );
+			profiler.recordFrame( "spikes" );
+			this_thread::sleep_for( chrono::milliseconds( 30 ) );
+			profiler.recordFrame( "spikes" );
+		} );
+		frames.join();
+		profiler.setFrameSpikeFn( 0, profile::Profiler::FrameSpikeFn() );
+
+		REQUIRE( spikes.size() == 1 );
+		REQUIRE( spikes.front() >= 0.03 );
+	}
+
+	profile::Profiler::setEnabled( false );
+	profiler.clear();
+}
@@ -0,0 +1,335 @@
+#include "catch.hpp"
+#include "cinder/Serial.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined( CINDER_LINUX )
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <stdlib.h>
+	#include <unistd.h>
+#endif
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+vector<uint8_t> bytes( const string &str )
+{
+	return vector<uint8_t>( str.begin(), str.end() );
+}
+
+// Feeds \a framer the frames of \a packets in pieces of \a pieceSize bytes, returning the packets it parses
+vector<vector<uint8_t>> roundTrip( SerialFramer &framer, const vector<vector<uint8_t>> &packets, size_t pieceSize )
+{
+	vector<uint8_t> stream;
+	for( const auto &packet : packets ) {
+		auto framed = framer.frame( packet.data(), packet.size() );
+		stream.insert( stream.end(), framed.begin(), framed.end() );
+	}
+
+	vector<vector<uint8_t>> result;
+	for( size_t i = 0; i < stream.size(); i += pieceSize )
+		framer.process( stream.data() + i, std::min( pieceSize, stream.size() - i ), [&]( const uint8_t *data, size_t size ) { result.emplace_back( data, data + size ); } );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "SerialFramer" )
+{
+	vector<uint8_t> everyByte( 600 );
+	for( size_t i = 0; i < everyByte.size(); ++i )
+		everyByte[i] = uint8_t( i * 7 );
+
+	SECTION( "COBS" )
+	{
+		SerialCobsFramer framer;
+		const uint8_t payload[] = { 0x11, 0x22, 0x00, 0x33 };
+		REQUIRE( framer.frame( payload, sizeof( payload ) ) == vector<uint8_t>( { 0x03, 0x11, 0x22, 0x02, 0x33, 0x00 } ) );
+		const uint8_t zero = 0;
+		REQUIRE( framer.frame( &zero, 1 ) == vector<uint8_t>( { 0x01, 0x01, 0x00 } ) );
+
+		const vector<vector<uint8_t>> packets = { { 0 }, bytes( "abc" ), everyByte, vector<uint8_t>( 254, 0x42 ), vector<uint8_t>( 300, 0 ) };
+		for( size_t pieceSize : { 1, 7, 4096 } )
+			REQUIRE( roundTrip( framer, packets, pieceSize ) == packets );
+
+		// a corrupt frame is dropped without losing the next one
+		vector<uint8_t> packet;
+		const uint8_t corrupt[] = { 0x05, 0x11, 0x00, 0x02, 0x33, 0x00 };
+		framer.process( corrupt, sizeof( corrupt ), [&]( const uint8_t *data, size_t size ) { packet.assign( data, data + size ); } );
+		REQUIRE( framer.getNumErrors() == 1 );
+		REQUIRE( packet == vector<uint8_t>( { 0x33 } ) );
+	}
+
+	SECTION( "SLIP" )
+	{
+		SerialSlipFramer framer;
+		const uint8_t payload[] = { 0x01, 0xC0, 0xDB, 0x02 };
+		REQUIRE( framer.frame( payload, sizeof( payload ) ) == vector<uint8_t>( { 0xC0, 0x01, 0xDB, 0xDC, 0xDB, 0xDD, 0x02, 0xC0 } ) );
+
+		const vector<vector<uint8_t>> packets = { bytes( "abc" ), everyByte, vector<uint8_t>( 50, 0xC0 ) };
+		for( size_t pieceSize : { 1, 5, 4096 } )
+			REQUIRE( roundTrip( framer, packets, pieceSize ) == packets );
+	}
+
+	SECTION( "Length prefix" )
+	{
+		SerialLengthPrefixFramer bigEndian( 2, true );
+		const uint8_t payload[] = { 'h', 'i' };
+		REQUIRE( bigEndian.frame( payload, 2 ) == vector<uint8_t>( { 0x00, 0x02, 'h', 'i' } ) );
+		SerialLengthPrefixFramer littleEndian( 4, false );
+		REQUIRE( littleEndian.frame( payload, 2 ) == vector<uint8_t>( { 0x02, 0x00, 0x00, 0x00, 'h', 'i' } ) );
+
+		const vector<vector<uint8_t>> packets = { bytes( "abc" ), {}, everyByte };
+		for( size_t pieceSize : { 1, 3, 4096 } ) {
+			REQUIRE( roundTrip( bigEndian, packets, pieceSize ) == packets );
+			REQUIRE( roundTrip( littleEndian, packets, pieceSize ) == packets );
+		}
+
+		SerialLengthPrefixFramer oneByte( 1 );
+		REQUIRE_THROWS_AS( oneByte.frame( everyByte.data(), everyByte.size() ), SerialExc );
+		REQUIRE_THROWS_AS( SerialLengthPrefixFramer( 3 ), SerialExc );
+	}
+
+	SECTION( "Delimiter" )
+	{
+		SerialDelimiterFramer framer( '\n', 8 );
+		const vector<vector<uint8_t>> packets = { bytes( "one" ), bytes( "" ), bytes( "three" ) };
+		for( size_t pieceSize : { 1, 2, 4096 } )
+			REQUIRE( roundTrip( framer, packets, pieceSize ) == packets );
+
+		// oversized lines are dropped
+		const string lines = "much too long\nok\n";
+		vector<vector<uint8_t>> parsed;
+		framer.process( (const uint8_t*)lines.data(), lines.size(), [&]( const uint8_t *data, size_t size ) { parsed.emplace_back( data, data + size ); } );
+		REQUIRE( parsed == vector<vector<uint8_t>>( { bytes( "ok" ) } ) );
+		REQUIRE( framer.getNumErrors() == 1 );
+	}
+}
+
+#if defined( CINDER_LINUX )
+
+namespace {
+
+//! The master side of a pseudo-terminal, standing in for a device on the other end of a serial port
+class PseudoTerminal {
+  public:
+	PseudoTerminal()
+	{
+		mMaster = ::posix_openpt( O_RDWR | O_NOCTTY );
+		::grantpt( mMaster );
+		::unlockpt( mMaster );
+		::fcntl( mMaster, F_SETFL, ::fcntl( mMaster, F_GETFL ) | O_NONBLOCK );
+		// Serial opens devices relative to /dev
+		mDeviceName = string( ::ptsname( mMaster ) ).substr( 5 );
+	}
+
+	~PseudoTerminal()
+	{
+		close();
+	}
+
+	void close()
+	{
+		if( mMaster != -1 )
+			::close( mMaster );
+		mMaster = -1;
+	}
+
+	void write( const void *data, size_t size )
+	{
+		const uint8_t *bytes = static_cast<const uint8_t*>( data );
+		while( size > 0 ) {
+			ssize_t written = ::write( mMaster, bytes, size );
+			if( written > 0 ) {
+				bytes += written;
+				size -= written;
+			}
+			else
+				this_thread::sleep_for( chrono::milliseconds( 1 ) );
+		}
+	}
+	void write( const vector<uint8_t> &data )	{ write( data.data(), data.size() ); }
+	void write( const string &str )				{ write( str.data(), str.size() ); }
+
+	//! Reads until \a size bytes have arrived or a second passes without any
+	vector<uint8_t> read( size_t size )
+	{
+		vector<uint8_t> result;
+		uint8_t buffer[4096];
+		while( result.size() < size ) {
+			pollfd fd = { mMaster, POLLIN, 0 };
+			if( ::poll( &fd, 1, 1000 ) <= 0 )
+				break;
+			ssize_t bytesRead = ::read( mMaster, buffer, std::min( sizeof( buffer ), size - result.size() ) );
+			if( bytesRead > 0 )
+				result.insert( result.end(), buffer, buffer + bytesRead );
+		}
+		return result;
+	}
+
+	const string&	getDeviceName() const	{ return mDeviceName; }
+
+  private:
+	int		mMaster;
+	string	mDeviceName;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "Serial over a pseudo-terminal" )
+{
+	PseudoTerminal terminal;
+	SerialRef serial = Serial::create( Serial::Device( terminal.getDeviceName() ), 115200 );
+
+	SECTION( "Blocking reads and writes" )
+	{
+		// the port is in raw mode, so binary data isn't translated
+		const string binary( "\x03\x04\r\x7f" "abc\n", 8 );
+		terminal.write( binary );
+		REQUIRE( serial->readStringUntil( '\n', 0, 2.0 ) == binary );
+
+		serial->writeString( "ping" );
+		REQUIRE( terminal.read( 4 ) == bytes( "ping" ) );
+	}
+
+	SECTION( "Asynchronous reads and batched writes" )
+	{
+		serial->startAsync();
+		REQUIRE( serial->isAsync() );
+		REQUIRE_THROWS_AS( serial->readStringUntil( '\n', 0, 0.05 ), SerialTimeoutExc );
+
+		thread device( [&] {
+			this_thread::sleep_for( chrono::milliseconds( 20 ) );
+			terminal.write( string( "first line\nsecond" ) );
+			this_thread::sleep_for( chrono::milliseconds( 20 ) );
+			terminal.write( string( " line\n" ) );
+		} );
+		REQUIRE( serial->readStringUntil( '\n', 0, 2.0 ) == "first line\n" );
+		REQUIRE( serial->readStringUntil( '\n', 0, 2.0 ) == "second line\n" );
+		device.join();
+
+		vector<uint8_t> large( 100000 );
+		for( size_t i = 0; i < large.size(); ++i )
+			large[i] = uint8_t( i % 253 );
+		thread writer( [&] { terminal.write( large ); } );
+		vector<uint8_t> received( large.size() );
+		serial->readBytes( received.data(), received.size() );
+		writer.join();
+		REQUIRE( received == large );
+		REQUIRE( serial->getNumBytesDropped() == 0 );
+
+		// writes return straight away and arrive in order
+		string sent;
+		for( int i = 0; i < 1000; ++i ) {
+			const string message = to_string( i ) + ",";
+			serial->writeString( message );
+			sent += message;
+		}
+		REQUIRE( terminal.read( sent.size() ) == bytes( sent ) );
+		REQUIRE( serial->getNumBytesQueuedForWrite() == 0 );
+
+		// the other end hanging up fails reads rather than blocking them forever
+		terminal.close();
+		uint8_t byte;
+		REQUIRE_THROWS_AS( serial->readBytes( &byte, 1 ), SerialExcReadFailure );
+	}
+
+	SECTION( "Stopping asynchronous reads" )
+	{
+		serial->startAsync();
+		terminal.write( string( "left unread\n" ) );
+		for( int i = 0; i < 200 && serial->getNumBytesAvailable() < 12; ++i )
+			this_thread::sleep_for( chrono::milliseconds( 5 ) );
+
+		// more than the pseudo-terminal buffers, so stopping has to wait for the other end to read
+		vector<uint8_t> large( 200000 );
+		for( size_t i = 0; i < large.size(); ++i )
+			large[i] = uint8_t( i % 251 );
+		serial->writeBytes( large.data(), large.size() );
+		vector<uint8_t> received;
+		thread reader( [&] { received = terminal.read( large.size() ); } );
+		serial->stopAsync();
+		reader.join();
+		REQUIRE( received == large );
+
+		// bytes the background thread received are still read afterwards
+		REQUIRE( ! serial->isAsync() );
+		REQUIRE( serial->getNumBytesAvailable() == 12 );
+		REQUIRE( serial->readStringUntil( '\n', 0, 2.0 ) == "left unread\n" );
+	}
+
+	SECTION( "Packets" )
+	{
+		auto framer = make_shared<SerialCobsFramer>();
+		serial->startAsync( Serial::AsyncOptions().framer( framer ) );
+
+		vector<vector<uint8_t>> packets;
+		for( int i = 0; i < 200; ++i ) {
+			vector<uint8_t> packet( i % 37 );
+			for( size_t j = 0; j < packet.size(); ++j )
+				packet[j] = uint8_t( i + j * 3 );
+			packets.push_back( packet );
+		}
+		thread device( [&] {
+			for( const auto &packet : packets )
+				terminal.write( framer->frame( packet.data(), packet.size() ) );
+		} );
+
+		vector<vector<uint8_t>> received;
+		vector<uint8_t> packet;
+		while( received.size() < packets.size() && serial->readPacket( &packet, 2.0 ) )
+			received.push_back( packet );
+		device.join();
+		REQUIRE( received == packets );
+		REQUIRE( ! serial->readPacket( &packet ) );
+
+		// a negative timeout waits for as long as it takes
+		thread late( [&] {
+			this_thread::sleep_for( chrono::milliseconds( 50 ) );
+			terminal.write( framer->frame( packets[7].data(), packets[7].size() ) );
+		} );
+		REQUIRE( serial->readPacket( &packet, -1 ) );
+		late.join();
+		REQUIRE( packet == packets[7] );
+
+		serial->writePacket( packets[5].data(), packets[5].size() );
+		const auto framed = framer->frame( packets[5].data(), packets[5].size() );
+		REQUIRE( terminal.read( framed.size() ) == framed );
+	}
+
+	SECTION( "Packet callbacks" )
+	{
+		mutex packetsMutex;
+		vector<string> lines;
+		serial->startAsync( Serial::AsyncOptions().framer( make_shared<SerialDelimiterFramer>( '\n' ) ).packetFn( [&]( const uint8_t *data, size_t size ) {
+			lock_guard<mutex> lock( packetsMutex );
+			lines.push_back( string( data, data + size ) );
+		} ) );
+
+		terminal.write( string( "temperature 21.5\nhumidity" ) );
+		terminal.write( string( " 40\n" ) );
+		for( int i = 0; i < 200; ++i ) {
+			{
+				lock_guard<mutex> lock( packetsMutex );
+				if( lines.size() == 2 )
+					break;
+			}
+			this_thread::sleep_for( chrono::milliseconds( 5 ) );
+		}
+
+		serial->stopAsync();
+		REQUIRE( lines == vector<string>( { "temperature 21.5", "humidity 40" } ) );
+		REQUIRE( serial->getNumQueuedPackets() == 0 );
+	}
+}
+
+#endif // defined( CINDER_LINUX )
@@ -0,0 +1,163 @@
+#include "catch.hpp"
+#include "cinder/ip/Hdr.h"
+#include "cinder/ip/Statistics.h"
+#include "cinder/ip/Threshold.h"
+#include "cinder/Rand.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+template<typename T>
+SurfaceT<T> makeRandomSurface( int32_t width, int32_t height, bool alpha, SurfaceChannelOrder order = SurfaceChannelOrder::UNSPECIFIED )
+{
+	Rand rand( 4321 );
+	SurfaceT<T> result( width, height, alpha, order );
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x )
+			result.setPixel( ivec2( x, y ), ColorAf( rand.nextFloat(), rand.nextFloat(), rand.nextFloat(), rand.nextFloat() ) );
+	}
+	return result;
+}
+
+template<typename T>
+void requireStatistics( const ChannelT<T> &channel, const Area &area, const ip::Statistics &statistics )
+{
+	double sum = 0, sumSquares = 0;
+	float minValue = numeric_limits<float>::max(), maxValue = numeric_limits<float>::lowest();
+	for( int32_t y = area.y1; y < area.y2; ++y ) {
+		for( int32_t x = area.x1; x < area.x2; ++x ) {
+			const float value = channel.getValue( ivec2( x, y ) );
+			minValue = std::min( minValue, value );
+			maxValue = std::max( maxValue, value );
+			sum += value;
+			sumSquares += (double)value * value;
+		}
+	}
+	const double count = area.calcArea(), mean = sum / count;
+	REQUIRE( statistics.getCount() == (uint64_t)count );
+	REQUIRE( statistics.getMin() == minValue );
+	REQUIRE( statistics.getMax() == maxValue );
+	REQUIRE( statistics.getMean() == Approx( mean ) );
+	REQUIRE( statistics.getVariance() == Approx( sumSquares / count - mean * mean ) );
+}
+
+template<typename T>
+void requireSurfaceStatistics( const SurfaceT<T> &surface, const Area &area )
+{
+	const vector<ip::Statistics> statistics = ip::calcStatistics( surface, area );
+	REQUIRE( statistics.size() == ( surface.hasAlpha() ? 4 : 3 ) );
+	for( size_t c = 0; c < statistics.size(); ++c ) {
+		const ChannelT<T> &channel = c == 0 ? surface.getChannelRed() : c == 1 ? surface.getChannelGreen() : c == 2 ? surface.getChannelBlue() : surface.getChannelAlpha();
+		requireStatistics( channel, area, statistics[c] );
+		requireStatistics( channel, area, ip::calcStatistics( channel, area, false ) );
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip::Statistics" )
+{
+	SECTION( "Statistics match a per-pixel reference" )
+	{
+		const Area area( 3, 5, 190, 101 );
+		for( auto order : { SurfaceChannelOrder::RGBA, SurfaceChannelOrder::BGRA, SurfaceChannelOrder::ARGB } ) {
+			requireSurfaceStatistics( makeRandomSurface<uint8_t>( 200, 120, true, order ), area );
+			requireSurfaceStatistics( makeRandomSurface<uint16_t>( 200, 120, true, order ), area );
+			requireSurfaceStatistics( makeRandomSurface<float>( 200, 120, true, order ), area );
+		}
+		for( auto order : { SurfaceChannelOrder::RGB, SurfaceChannelOrder::BGR, SurfaceChannelOrder::BGRX, SurfaceChannelOrder::XRGB } ) {
+			requireSurfaceStatistics( makeRandomSurface<uint8_t>( 200, 120, false, order ), area );
+			requireSurfaceStatistics( makeRandomSurface<float>( 200, 120, false, order ), area );
+		}
+
+		Channel8u channel = makeRandomSurface<uint8_t>( 333, 77, false ).getChannelGreen().clone();
+		requireStatistics( channel, channel.getBounds(), ip::calcStatistics( channel ) );
+		requireStatistics( channel, Area( 1, 1, 2, 2 ), ip::calcStatistics( channel, Area( 1, 1, 2, 2 ) ) );
+
+		const ip::Statistics empty = ip::calcStatistics( channel, Area( 10, 10, 10, 20 ) );
+		REQUIRE( empty.getCount() == 0 );
+
+		Channel32f hdr = makeRandomSurface<float>( 40, 30, false ).getChannelBlue().clone();
+		hdr.setValue( ivec2( 7, 9 ), -3.0f );
+		hdr.setValue( ivec2( 31, 2 ), 12.5f );
+		float minValue, maxValue;
+		ip::getMinMax( hdr, &minValue, &maxValue );
+		REQUIRE( minValue == -3.0f );
+		REQUIRE( maxValue == 12.5f );
+	}
+
+	SECTION( "Histograms" )
+	{
+		const Surface8u surface = makeRandomSurface<uint8_t>( 301, 211, true, SurfaceChannelOrder::BGRA );
+		const Area area( 10, 20, 300, 200 );
+		const vector<ip::Histogram> histograms = ip::calcHistograms( surface, area );
+		REQUIRE( histograms.size() == 4 );
+		for( size_t c = 0; c < 4; ++c ) {
+			const Channel8u &channel = c == 0 ? surface.getChannelRed() : c == 1 ? surface.getChannelGreen() : c == 2 ? surface.getChannelBlue() : surface.getChannelAlpha();
+			vector<uint32_t> expected( 256, 0 );
+			for( int32_t y = area.y1; y < area.y2; ++y ) {
+				for( int32_t x = area.x1; x < area.x2; ++x )
+					++expected[channel.getValue( ivec2( x, y ) )];
+			}
+			REQUIRE( histograms[c].getBins() == expected );
+			REQUIRE( histograms[c].getTotal() == (uint64_t)area.calcArea() );
+			REQUIRE( ip::calcHistogram( channel, area ).getBins() == expected );
+			REQUIRE( ip::calcHistogram( channel, area, ip::HistogramOptions().parallel( false ) ).getBins() == expected );
+		}
+
+		// 16 bins over [0, 1), with values outside of the range counted by the first and last bins
+		Channel32f values( 20, 1 );
+		for( int32_t x = 0; x < 20; ++x )
+			values.setValue( ivec2( x, 0 ), x / 16.0f - 0.125f );
+		const ip::Histogram histogram = ip::calcHistogram( values, ip::HistogramOptions().numBins( 16 ) );
+		REQUIRE( histogram.getNumBins() == 16 );
+		REQUIRE( histogram.getBin( 0 ) == 3 );
+		REQUIRE( histogram.getBin( 1 ) == 1 );
+		REQUIRE( histogram.getBin( 15 ) == 3 );
+		REQUIRE( histogram.getBinValue( 4 ) == 0.25f );
+
+		Channel16u wide( 4, 1 );
+		wide.setValue( ivec2( 0, 0 ), 0 );
+		wide.setValue( ivec2( 1, 0 ), 1000 );
+		wide.setValue( ivec2( 2, 0 ), 1999 );
+		wide.setValue( ivec2( 3, 0 ), 65535 );
+		const ip::Histogram wideHistogram = ip::calcHistogram( wide, ip::HistogramOptions().numBins( 2 ).range( 0, 2000 ) );
+		REQUIRE( wideHistogram.getBin( 0 ) == 1 );
+		REQUIRE( wideHistogram.getBin( 1 ) == 3 );
+	}
+
+	SECTION( "Percentiles, means and Otsu thresholds" )
+	{
+		ip::Histogram histogram( 100, 0, 100 );
+		for( size_t i = 0; i < 100; ++i )
+			histogram.add( i );
+		REQUIRE( histogram.calcPercentile( 0.5f ) == Approx( 50 ) );
+		REQUIRE( histogram.calcPercentile( 0.9f ) == Approx( 90 ) );
+		REQUIRE( histogram.calcPercentile( 1 ) == Approx( 100 ) );
+		REQUIRE( histogram.calcMean() == Approx( 50 ) );
+
+		// dark text on a light background
+		Rand rand( 5 );
+		Channel8u channel( 64, 48 );
+		for( int32_t y = 0; y < 48; ++y ) {
+			for( int32_t x = 0; x < 64; ++x )
+				channel.setValue( ivec2( x, y ), (uint8_t)( ( ( x / 8 + y / 8 ) % 3 == 0 ? 60 : 190 ) + rand.nextInt( -20, 20 ) ) );
+		}
+		const float edge = ip::calcOtsuThreshold( ip::calcHistogram( channel ) );
+		REQUIRE( edge >= 80 );
+		REQUIRE( edge <= 170 );
+
+		Channel8u binary( 64, 48 );
+		const uint8_t value = ip::thresholdOtsu( channel, &binary );
+		REQUIRE( value == (uint8_t)std::ceil( edge ) - 1 );
+		for( int32_t y = 0; y < 48; ++y ) {
+			for( int32_t x = 0; x < 64; ++x )
+				REQUIRE( binary.getValue( ivec2( x, y ) ) == ( ( x / 8 + y / 8 ) % 3 == 0 ? 0 : 255 ) );
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "cinder/DataSource.h"
+#include "cinder/Stream.h"
+#include "cinder/DataTarget.h"
+#include "cinder/Utilities.h"
+#include "cinder/TriMesh.h"
+#include "cinder/GeomIo.h"
+
+#include <cstring>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+fs::path writeTestFile( const string &name, const string &contents )
+{
+	const fs::path path = fs::temp_directory_path() / name;
+	OStreamFileRef stream = writeFileStream( path );
+	if( ! contents.empty() )
+		stream->writeData( contents.data(), contents.size() );
+	return path;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Stream" )
+{
+	const string contents = "first line\nsecond line\r\nthird\rlast";
+	const fs::path path = writeTestFile( "cinder_stream_test.txt", contents );
+
+	SECTION( "MappedFile" )
+	{
+		MappedFileRef mappedFile = MappedFile::create( path, MappedFile::Access::RANDOM );
+		REQUIRE( mappedFile->getSize() == contents.size() );
+		REQUIRE( memcmp( mappedFile->getData(), contents.data(), contents.size() ) == 0 );
+		mappedFile->advise( MappedFile::Access::WILL_NEED, 3, 4 );
+
+		// the Buffer views the mapping, and keeps it alive
+		BufferRef buffer = mappedFile->createBuffer( 6, 4 );
+		REQUIRE( buffer->getData() == static_cast<const uint8_t*>( mappedFile->getData() ) + 6 );
+		mappedFile.reset();
+		REQUIRE( string( static_cast<const char*>( buffer->getData() ), buffer->getSize() ) == "line" );
+
+		// writes are private to the mapping
+		static_cast<char*>( buffer->getData() )[0] = 'L';
+		REQUIRE( loadString( loadFile( path ) ) == contents );
+
+		REQUIRE_THROWS_AS( MappedFile::create( fs::temp_directory_path() / "cinder_stream_test_missing.txt" ), StreamExc );
+		MappedFileRef empty = MappedFile::create( writeTestFile( "cinder_stream_test_empty.txt", "" ) );
+		REQUIRE( empty->getSize() == 0 );
+		REQUIRE( empty->createBuffer()->getSize() == 0 );
+	}
+
+	SECTION( "IStreamMapped" )
+	{
+		IStreamMappedRef stream = loadFileStreamMapped( path );
+		REQUIRE( stream->size() == (off_t)contents.size() );
+		REQUIRE( stream->readLine() == "first line" );
+		REQUIRE( stream->readLine() == "second line" );
+		REQUIRE( stream->getCurrentData() == static_cast<const uint8_t*>( stream->getMappedFile()->getData() ) + 24 );
+		BufferRef third = stream->readBuffer( 5 );
+		REQUIRE( string( static_cast<const char*>( third->getData() ), third->getSize() ) == "third" );
+		REQUIRE( stream->readLine() == "" );
+		REQUIRE( stream->readLine() == "last" );
+		REQUIRE( stream->isEof() );
+		REQUIRE_THROWS_AS( stream->readBuffer( 1 ), StreamExc );
+
+		// IStreamMem::readLine() matches the byte at a time implementation of the file stream
+		IStreamFileRef fileStream = loadFileStream( path );
+		IStreamRef memStream = IStreamMem::create( contents.data(), contents.size() );
+		for( int line = 0; line < 3; ++line )
+			REQUIRE( memStream->readLine() == fileStream->readLine() );
+	}
+
+	SECTION( "DataSourceMapped" )
+	{
+		DataSourceRef dataSource = loadFileMapped( path );
+		REQUIRE( ! dataSource->isFilePath() );
+		REQUIRE( dataSource->getFilePath() == path );
+		REQUIRE( dataSource->getFilePathHint().extension() == ".txt" );
+		REQUIRE( string( static_cast<const char*>( dataSource->getBuffer()->getData() ), dataSource->getBuffer()->getSize() ) == contents );
+		REQUIRE( loadString( dataSource ) == contents );
+
+		// a mesh loads from the mapping as it does from the file
+		const TriMesh mesh( geom::Sphere(), TriMesh::Format().positions().normals() );
+		const fs::path meshPath = fs::temp_directory_path() / "cinder_stream_test.msh";
+		mesh.write( writeFile( meshPath ) );
+		TriMesh mapped;
+		mapped.read( loadFileMapped( meshPath ) );
+		REQUIRE( mapped.getBufferPositions() == mesh.getBufferPositions() );
+		REQUIRE( mapped.getIndices() == mesh.getIndices() );
+	}
+}
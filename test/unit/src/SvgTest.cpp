@@ -0,0 +1,153 @@
+#include "catch.hpp"
+#include "cinder/svg/Svg.h"
+#include "cinder/Rand.h"
+
+#include <sstream>
+#include <typeinfo>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+//! Generates a document of translated and rotated groups of overlapping rects and circles.
+svg::DocRef generateDoc( int numGroups )
+{
+	Rand rand( 4321 );
+	ostringstream ss;
+	ss << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"1000\" height=\"1000\">\n";
+	ss << "<defs><rect id=\"hidden\" x=\"0\" y=\"0\" width=\"1000\" height=\"1000\"/></defs>\n";
+	for( int g = 0; g < numGroups; ++g ) {
+		ss << "<g id=\"group" << g << "\" transform=\"translate(" << rand.nextFloat( 900 ) << " " << rand.nextFloat( 900 ) << ") rotate(" << rand.nextFloat( 90 ) << ")\">";
+		for( int i = 0; i < 10; ++i ) {
+			if( i % 2 )
+				ss << "<rect id=\"item" << g << "_" << i << "\" x=\"" << rand.nextFloat( 80 ) << "\" y=\"" << rand.nextFloat( 80 ) << "\" width=\"" << rand.nextFloat( 5, 30 ) << "\" height=\"" << rand.nextFloat( 5, 30 ) << "\"/>";
+			else
+				ss << "<circle id=\"item" << g << "_" << i << "\" cx=\"" << rand.nextFloat( 80 ) << "\" cy=\"" << rand.nextFloat( 80 ) << "\" r=\"" << rand.nextFloat( 2, 15 ) << "\" stroke=\"black\" stroke-width=\"4\"/>";
+		}
+		ss << "<text x=\"0\" y=\"0\">label</text></g>\n";
+	}
+	ss << "</svg>";
+
+	string source = ss.str();
+	return svg::Doc::create( DataSourceBuffer::create( Buffer::create( &source[0], source.size() ) ) );
+}
+
+//! Returns the drawable nodes of \a doc in document order
+vector<svg::Node*> collectLeaves( svg::Doc &doc )
+{
+	vector<svg::Node*> result;
+	doc.iterate( [&result]( svg::Node *node ) {
+		if( typeid(*node) != typeid(svg::Group) )
+			result.push_back( node );
+	} );
+	return result;
+}
+
+//! Finds the top-most node under \a pt by testing every node
+svg::Node* bruteForceNodeUnderPoint( const vector<svg::Node*> &leaves, const vec2 &pt )
+{
+	for( auto leafIt = leaves.rbegin(); leafIt != leaves.rend(); ++leafIt ) {
+		if( (*leafIt)->containsPoint( vec2( (*leafIt)->getTransformAbsoluteInverse() * vec3( pt, 1 ) ) ) )
+			return *leafIt;
+	}
+	return nullptr;
+}
+
+class CountingRenderer : public svg::Renderer {
+  public:
+	void	drawRect( const svg::Rect & ) override		{ ++mNumDrawn; }
+	void	drawCircle( const svg::Circle & ) override	{ ++mNumDrawn; }
+
+	size_t	mNumDrawn = 0;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "SvgSpatialIndex" )
+{
+	svg::DocRef doc = generateDoc( 200 );
+	const vector<svg::Node*> leaves = collectLeaves( *doc );
+	REQUIRE( leaves.size() == 200 * 11 );
+
+	SECTION( "nodeUnderPoint matches an exhaustive search" )
+	{
+		Rand rand( 1 );
+		size_t numHits = 0;
+		for( int i = 0; i < 2000; ++i ) {
+			vec2 pt( rand.nextFloat( -50, 1050 ), rand.nextFloat( -50, 1050 ) );
+			svg::Node *expected = bruteForceNodeUnderPoint( leaves, pt );
+			REQUIRE( doc->nodeUnderPoint( pt ) == expected );
+			numHits += expected != nullptr;
+		}
+		REQUIRE( numHits > 100 );
+	}
+
+	SECTION( "Transform changes update the index" )
+	{
+		doc->nodeUnderPoint( vec2( 0 ) );
+		svg::Node &group = doc->getChild( "group7" );
+		const svg::Node *child = doc->findNode( "item7_0" );
+		const vec2 centerBefore = child->getWorldBounds().getCenter();
+		group.setTransform( translate( group.getTransform(), vec2( 300, -200 ) ) );
+		REQUIRE( distance( child->getWorldBounds().getCenter(), centerBefore ) > 100 );
+
+		svg::Node &item = static_cast<svg::Group &>( doc->getChild( "group3" ) ).getChild( "item3_4" );
+		item.setTransform( scale( mat3(), vec2( 3 ) ) );
+
+		Rand rand( 2 );
+		for( int i = 0; i < 2000; ++i ) {
+			vec2 pt( rand.nextFloat( -50, 1050 ), rand.nextFloat( -50, 1050 ) );
+			REQUIRE( doc->nodeUnderPoint( pt ) == bruteForceNodeUnderPoint( leaves, pt ) );
+		}
+	}
+
+	SECTION( "findNodesInRect returns intersecting nodes in document order" )
+	{
+		const Rectf rect( 600, 250, 200, 100 ); // non-canonical on purpose
+		vector<svg::Node*> expected;
+		for( svg::Node *leaf : leaves ) {
+			if( leaf->hasWorldBounds() && leaf->getWorldBounds().intersects( rect.canonicalized() ) )
+				expected.push_back( leaf );
+		}
+
+		REQUIRE( ! expected.empty() );
+		REQUIRE( doc->findNodesInRect( rect ) == expected );
+	}
+
+	SECTION( "World bounds include strokes" )
+	{
+		const svg::Circle *circle = doc->find<svg::Circle>( "item0_0" );
+		REQUIRE( circle );
+		const float worldRadius = circle->getRadius() + 2; // stroke-width is 4
+		REQUIRE( circle->getWorldBounds().getWidth() >= worldRadius * 2 - 0.001f );
+		REQUIRE( ! doc->getChild( "group0" ).hasWorldBounds() ); // contains text
+	}
+
+	SECTION( "findNode matches Group::findNode" )
+	{
+		for( const string &id : { "group0", "item5_3", "item199_9", "hidden", "missing" } )
+			REQUIRE( doc->findNode( id ) == doc->svg::Group::findNode( id ) );
+		REQUIRE( doc->find<svg::Rect>( "item5_3" ) );
+	}
+
+	SECTION( "Rendering is culled to the cull rect" )
+	{
+		const Rectf cullRect( 100, 100, 300, 300 );
+		size_t expected = 0;
+		for( svg::Node *leaf : leaves ) {
+			if( leaf->hasWorldBounds() && leaf->getWorldBounds().intersects( cullRect ) )
+				++expected;
+		}
+
+		CountingRenderer renderer;
+		doc->render( renderer );
+		REQUIRE( renderer.mNumDrawn == 200 * 10 );
+
+		renderer.mNumDrawn = 0;
+		renderer.setCullRect( cullRect );
+		doc->render( renderer );
+		REQUIRE( renderer.mNumDrawn == expected );
+		REQUIRE( expected < 200 * 10 );
+	}
+}
@@ -0,0 +1,157 @@
+#include "catch.hpp"
+#include "cinder/TaskScheduler.h"
+#include "cinder/Thread.h"
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+using namespace ci;
+using namespace std;
+
+TEST_CASE( "TaskScheduler" )
+{
+	TaskScheduler scheduler( TaskScheduler::Options().numThreads( 4 ) );
+	REQUIRE( scheduler.getNumThreads() == 4 );
+
+	SECTION( "Task graphs" )
+	{
+		// a diamond: b and c depend on a, and d depends on both
+		mutex orderMutex;
+		vector<char> order;
+		auto record = [&]( char name ) { return [&, name] { lock_guard<mutex> lock( orderMutex ); order.push_back( name ); }; };
+		TaskRef a = scheduler.run( [&] { this_thread::sleep_for( chrono::milliseconds( 20 ) ); record( 'a' )(); } );
+		TaskRef b = scheduler.run( record( 'b' ), { a } );
+		TaskRef c = scheduler.run( record( 'c' ), { a } );
+		TaskRef d = scheduler.run( record( 'd' ), { b, c } );
+		d->wait();
+		REQUIRE( a->isComplete() );
+		REQUIRE( order.size() == 4 );
+		REQUIRE( order.front() == 'a' );
+		REQUIRE( order.back() == 'd' );
+
+		// depending on a completed task runs straight away
+		scheduler.run( record( 'e' ), { d } )->wait();
+		REQUIRE( order.back() == 'e' );
+	}
+
+	SECTION( "Exceptions are rethrown by wait()" )
+	{
+		TaskRef failing = scheduler.run( [] { throw runtime_error( "task failed" ); } );
+		REQUIRE_THROWS_AS( failing->wait(), runtime_error );
+		REQUIRE( failing->isComplete() );
+
+		// successors still run, as they may not depend on the result
+		atomic<bool> ran( false );
+		scheduler.run( [&] { ran = true; }, { failing } )->wait();
+		REQUIRE( ran );
+
+		REQUIRE_THROWS_AS( scheduler.parallelFor( 1000, 1, []( size_t begin, size_t ) { if( begin > 0 ) throw runtime_error( "range failed" ); } ), runtime_error );
+	}
+
+	SECTION( "parallelFor and parallelReduce" )
+	{
+		vector<atomic<int>> visits( 100000 );
+		for( auto &visit : visits )
+			visit = 0;
+		scheduler.parallelFor( visits.size(), 1000, [&]( size_t begin, size_t end ) {
+			for( size_t i = begin; i < end; ++i )
+				++visits[i];
+		} );
+		for( const auto &visit : visits )
+			REQUIRE( visit == 1 );
+
+		// nested inside tasks, the waiting threads help with the inner ranges
+		atomic<size_t> nestedItems( 0 );
+		scheduler.parallelFor( 8, 1, [&]( size_t begin, size_t end ) {
+			for( size_t i = begin; i < end; ++i )
+				scheduler.parallelFor( 1000, 10, [&]( size_t innerBegin, size_t innerEnd ) { nestedItems += innerEnd - innerBegin; } );
+		} );
+		REQUIRE( nestedItems == 8000 );
+
+		vector<uint64_t> values( 50000 );
+		iota( values.begin(), values.end(), 1 );
+		const uint64_t sum = scheduler.parallelReduce( values.size(), 100, uint64_t( 0 ),
+			[&]( size_t begin, size_t end ) { return accumulate( values.begin() + begin, values.begin() + end, uint64_t( 0 ) ); },
+			[]( uint64_t a, uint64_t b ) { return a + b; } );
+		REQUIRE( sum == uint64_t( 50000 ) * 50001 / 2 );
+
+		// ranges are reduced in order
+		const string letters = scheduler.parallelReduce( 26, 1, string(),
+			[]( size_t begin, size_t end ) { string result; for( size_t i = begin; i < end; ++i ) result += char( 'a' + i ); return result; },
+			[]( const string &a, const string &b ) { return a + b; } );
+		REQUIRE( letters == "abcdefghijklmnopqrstuvwxyz" );
+	}
+
+	SECTION( "Dispatched continuations" )
+	{
+		// stands in for AppBase::dispatchAsync(), which needs an App
+		mutex dispatchedMutex;
+		vector<function<void ()>> dispatched;
+		auto dispatchFn = [&]( const function<void ()> &fn ) { lock_guard<mutex> lock( dispatchedMutex ); dispatched.push_back( fn ); };
+
+		atomic<int> value( 0 );
+		TaskRef work = scheduler.run( [&] { value = 1; } );
+		TaskRef continuation = scheduler.dispatch( dispatchFn, [&] { value = value * 10; }, { work } );
+		TaskRef after = scheduler.run( [&] { value = value + 2; }, { continuation } );
+		work->wait();
+
+		// the continuation is dispatched by the thread which completed its dependency
+		auto dispatchedCount = [&] { lock_guard<mutex> lock( dispatchedMutex ); return dispatched.size(); };
+		for( int i = 0; i < 1000 && dispatchedCount() == 0; ++i )
+			this_thread::sleep_for( chrono::milliseconds( 1 ) );
+		REQUIRE( dispatchedCount() == 1 );
+		REQUIRE( ! continuation->isComplete() );
+		REQUIRE( ! after->isComplete() );
+
+		dispatched.front()();
+		REQUIRE( continuation->isComplete() );
+		after->wait();
+		REQUIRE( value == 12 );
+	}
+
+	SECTION( "Tracing" )
+	{
+		mutex traceMutex;
+		set<size_t> threadIndices;
+		atomic<int> numBegun( 0 ), numEnded( 0 );
+		scheduler.setTraceFns(
+			[&]( const char *name, size_t threadIndex ) { ++numBegun; lock_guard<mutex> lock( traceMutex ); threadIndices.insert( threadIndex ); },
+			[&]( const char *name, size_t threadIndex ) { ++numEnded; } );
+
+		vector<TaskRef> tasks;
+		for( int i = 0; i < 16; ++i )
+			tasks.push_back( scheduler.run( [] { this_thread::sleep_for( chrono::milliseconds( 5 ) ); }, {}, "sleep" ) );
+		scheduler.wait( tasks );
+		REQUIRE( numBegun == 16 );
+		REQUIRE( numEnded == 16 );
+		REQUIRE( threadIndices.size() > 1 );
+		REQUIRE( *threadIndices.rbegin() < scheduler.getNumThreads() );
+
+		scheduler.setTraceFns( TaskScheduler::TraceFn(), TaskScheduler::TraceFn() );
+		scheduler.run( [] {} )->wait();
+		REQUIRE( numBegun == 16 );
+	}
+}
+
+TEST_CASE( "TaskScheduler with a single thread" )
+{
+	// without worker threads tasks run as soon as they're ready, on the thread which made them ready
+	TaskScheduler scheduler( TaskScheduler::Options().numThreads( 1 ) );
+	const thread::id caller = this_thread::get_id();
+	thread::id ranOn;
+	TaskRef task = scheduler.run( [&] { ranOn = this_thread::get_id(); } );
+	REQUIRE( task->isComplete() );
+	REQUIRE( ranOn == caller );
+
+	size_t numRanges = 0;
+	scheduler.parallelFor( 100000, 1, [&]( size_t begin, size_t end ) { ++numRanges; } );
+	REQUIRE( numRanges == 1 );
+
+	// ci::parallelFor() runs on the shared instance
+	atomic<size_t> numItems( 0 );
+	parallelFor( 100000, 100, [&]( size_t begin, size_t end ) { numItems += end - begin; } );
+	REQUIRE( numItems == 100000 );
+}
@@ -0,0 +1,140 @@
+#include "catch.hpp"
+#include "cinder/Cinder.h"
+
+#if defined( CINDER_LINUX )
+
+#include "cinder/linux/TextBlock.h"
+#include "cinder/app/App.h"
+
+#include <set>
+
+using namespace ci;
+using namespace std;
+using ci::linux::TextBlock;
+
+namespace {
+
+// Returns whether the pixels of \a a within \a area match all of \a b
+bool pixelsEqual( const Surface &a, const Area &area, const Surface &b )
+{
+	if( area.getSize() != b.getSize() )
+		return false;
+	for( int y = 0; y < b.getHeight(); ++y ) {
+		for( int x = 0; x < b.getWidth(); ++x ) {
+			if( a.getPixel( area.getUL() + ivec2( x, y ) ) != b.getPixel( ivec2( x, y ) ) )
+				return false;
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "TextBlock" )
+{
+	const Font font( app::loadAsset( "Asap-Regular.ttf" ), 18 );
+	const string paragraphs[] = { "Revenue by region, updated every second.", "North 1,204", "South 987", "East and West combined 2,311 across all of the stores" };
+	auto join = []( const vector<string> &lines ) {
+		string result;
+		for( size_t i = 0; i < lines.size(); ++i )
+			result += ( i > 0 ? "\n" : "" ) + lines[i];
+		return result;
+	};
+
+	SECTION( "Only edited paragraphs are laid out again" )
+	{
+		TextBlock block;
+		block.font( font ).text( join( { paragraphs[0], paragraphs[1], paragraphs[2] } ) );
+		REQUIRE( block.getNumParagraphs() == 3 );
+		REQUIRE( block.getNumLines() == 3 );
+		REQUIRE( block.getNumParagraphsShaped() == 3 );
+
+		block.setText( join( { paragraphs[0], "North 1,205", paragraphs[2] } ) );
+		block.getSize();
+		REQUIRE( block.getNumParagraphsShaped() == 4 );
+
+		block.setText( join( { paragraphs[0], "North 1,205", paragraphs[2], paragraphs[3] } ) );
+		block.getSize();
+		REQUIRE( block.getNumParagraphsShaped() == 5 );
+
+		block.setText( join( { "North 1,205", paragraphs[2], paragraphs[3] } ) );
+		block.alignment( TextBox::RIGHT ).color( ColorA( 1, 0, 0, 1 ) );
+		block.getSize();
+		REQUIRE( block.getNumParagraphsShaped() == 5 );
+
+		// breaking lines at a new width doesn't look up glyphs again
+		block.setWidth( 120 );
+		REQUIRE( block.getNumLines() > 3 );
+		REQUIRE( block.getSize().x == 120 );
+		REQUIRE( block.getNumParagraphsShaped() == 5 );
+
+		// the result matches laying out the final text from scratch
+		TextBlock fresh;
+		fresh.font( font ).text( block.getText() ).width( 120 ).alignment( TextBox::RIGHT ).color( ColorA( 1, 0, 0, 1 ) );
+		REQUIRE( fresh.getSize() == block.getSize() );
+		Surface rendered = block.render( true );
+		REQUIRE( pixelsEqual( rendered, rendered.getBounds(), fresh.render( true ) ) );
+
+		// changing the font lays everything out again
+		block.setFont( Font( app::loadAsset( "Asap-Regular.ttf" ), 24 ) );
+		REQUIRE( block.getSize().y > fresh.getSize().y );
+		REQUIRE( block.getNumParagraphsShaped() == 8 );
+	}
+
+	SECTION( "Copies are laid out independently" )
+	{
+		TextBlock original;
+		original.font( font ).text( join( { paragraphs[0], paragraphs[3] } ) );
+		const ivec2 size = original.getSize();
+		const size_t numLines = original.getNumLines();
+		const Surface rendered = original.render( true );
+
+		TextBlock copy( original );
+		copy.setWidth( 100 );
+		REQUIRE( copy.getNumLines() > numLines );
+		REQUIRE( original.getSize() == size );
+		REQUIRE( original.getNumLines() == numLines );
+		REQUIRE( pixelsEqual( rendered, rendered.getBounds(), original.render( true ) ) );
+
+		TextBlock assigned;
+		assigned = original;
+		assigned.setFont( Font( app::loadAsset( "Asap-Regular.ttf" ), 24 ) );
+		REQUIRE( assigned.getSize().y > size.y );
+		REQUIRE( original.getSize() == size );
+		REQUIRE( original.getNumLines() == numLines );
+	}
+
+	SECTION( "Lines break like TextBox" )
+	{
+		for( int width : { 60, 100, 150, 400 } ) {
+			TextBlock block;
+			block.font( font ).text( paragraphs[3] ).width( width );
+
+			set<float> lineOffsets;
+			for( const auto &glyph : TextBox().font( font ).text( paragraphs[3] ).size( width, TextBox::GROW ).measureGlyphs() )
+				lineOffsets.insert( glyph.second.y );
+			REQUIRE( block.getNumLines() == lineOffsets.size() );
+		}
+	}
+
+	SECTION( "Batches render like single blocks" )
+	{
+		vector<TextBlock> blocks( 4 );
+		for( size_t i = 0; i < blocks.size(); ++i )
+			blocks[i].font( font ).text( paragraphs[i] ).width( i == 3 ? 150 : TextBox::GROW ).alignment( TextBox::CENTER );
+
+		vector<Area> areas;
+		Surface atlas = ci::linux::renderTextBlocks( blocks, 512, &areas, true );
+		REQUIRE( atlas.getWidth() == 512 );
+		REQUIRE( areas.size() == blocks.size() );
+		for( size_t i = 0; i < blocks.size(); ++i ) {
+			REQUIRE( areas[i].x2 <= atlas.getWidth() );
+			REQUIRE( areas[i].y2 <= atlas.getHeight() );
+			for( size_t j = 0; j < i; ++j )
+				REQUIRE( ! areas[i].intersects( areas[j] ) );
+			REQUIRE( pixelsEqual( atlas, areas[i], blocks[i].render( true ) ) );
+		}
+	}
+}
+
+#endif // defined( CINDER_LINUX )
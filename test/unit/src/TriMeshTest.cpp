@@ -0,0 +1,273 @@
+#include "catch.hpp"
+#include "cinder/TriMesh.h"
+#include "cinder/Rand.h"
+
+#include <array>
+#include <tuple>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+//! The quadratic search TriMesh::recalculateNormals() used to group vertices with
+vector<uint32_t> bruteForceWeld( const vector<vec3> &positions, float epsilon )
+{
+	vector<uint32_t> result( positions.size() );
+	for( size_t i = 0; i < positions.size(); ++i ) {
+		result[i] = (uint32_t)i;
+		for( size_t j = 0; j < i; ++j ) {
+			if( result[j] == j && length2( positions[j] - positions[i] ) < epsilon * epsilon ) {
+				result[i] = (uint32_t)j;
+				break;
+			}
+		}
+	}
+	return result;
+}
+
+//! Returns the triangles of \a mesh as sorted tuples of positions, which is invariant to triangle and vertex reordering
+vector<array<vec3, 3>> sortedTriangles( const TriMesh &mesh )
+{
+	auto lessVec3 = []( const vec3 &a, const vec3 &b ) { return std::tie( a.x, a.y, a.z ) < std::tie( b.x, b.y, b.z ); };
+	vector<array<vec3, 3>> result;
+	for( size_t t = 0; t < mesh.getNumTriangles(); ++t ) {
+		array<vec3, 3> tri;
+		mesh.getTriangleVertices( t, &tri[0], &tri[1], &tri[2] );
+		// rotate the smallest vertex first, which preserves winding
+		size_t first = std::min_element( tri.begin(), tri.end(), lessVec3 ) - tri.begin();
+		std::rotate( tri.begin(), tri.begin() + first, tri.end() );
+		result.push_back( tri );
+	}
+	std::sort( result.begin(), result.end(), [&]( const array<vec3, 3> &a, const array<vec3, 3> &b ) {
+		return std::lexicographical_compare( a.begin(), a.end(), b.begin(), b.end(), lessVec3 );
+	} );
+	return result;
+}
+
+//! Shuffles the triangles of \a mesh, to give the optimizations something to do
+void shuffleTriangles( TriMesh *mesh )
+{
+	Rand rand( 3 );
+	vector<uint32_t> &indices = mesh->getIndices();
+	for( size_t t = mesh->getNumTriangles() - 1; t > 0; --t ) {
+		size_t other = rand.nextUint( (uint32_t)t + 1 );
+		for( int i = 0; i < 3; ++i )
+			std::swap( indices[t * 3 + i], indices[other * 3 + i] );
+	}
+}
+
+float calcArea( const TriMesh &mesh )
+{
+	float result = 0;
+	for( size_t t = 0; t < mesh.getNumTriangles(); ++t ) {
+		vec3 a, b, c;
+		mesh.getTriangleVertices( t, &a, &b, &c );
+		result += length( cross( b - a, c - a ) ) / 2;
+	}
+	return result;
+}
+
+//! Returns whether any triangle of \a mesh spans the texture seam of a geom::Sphere, which simplification must not create
+bool spansSeam( const TriMesh &mesh )
+{
+	const vector<uint32_t> &indices = mesh.getIndices();
+	const vec2 *texCoords = mesh.getTexCoords0<2>();
+	for( size_t i = 0; i < indices.size(); i += 3 ) {
+		float minU = std::min( { texCoords[indices[i]].x, texCoords[indices[i + 1]].x, texCoords[indices[i + 2]].x } );
+		float maxU = std::max( { texCoords[indices[i]].x, texCoords[indices[i + 1]].x, texCoords[indices[i + 2]].x } );
+		if( maxU - minU > 0.5f )
+			return true;
+	}
+	return false;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "TriMesh" )
+{
+	SECTION( "weldVertices matches an exhaustive search" )
+	{
+		Rand rand( 5 );
+		vector<vec3> positions;
+		for( int i = 0; i < 2000; ++i ) {
+			// snap to a coarse grid and jitter, so that many vertices are within epsilon of each other
+			vec3 p = glm::floor( rand.nextVec3() * 4.0f ) / 4.0f;
+			positions.push_back( p + rand.nextVec3() * rand.nextFloat( 0.02f ) );
+		}
+
+		for( float epsilon : { 0.01f, 0.1f } ) {
+			vector<uint32_t> remap;
+			size_t numUnique = geom::weldVertices( positions.size(), positions.data(), epsilon, &remap );
+			vector<uint32_t> expected = bruteForceWeld( positions, epsilon );
+			REQUIRE( remap == expected );
+			size_t expectedUnique = 0;
+			for( size_t i = 0; i < expected.size(); ++i )
+				expectedUnique += expected[i] == i;
+			REQUIRE( numUnique == expectedUnique );
+		}
+
+		// exact welding
+		vector<vec3> duplicated = { vec3( 1, 2, 3 ), vec3( 1, 2, 3.0001f ), vec3( 1, 2, 3 ) };
+		vector<uint32_t> remap;
+		REQUIRE( geom::weldVertices( duplicated.size(), duplicated.data(), 0, &remap ) == 2 );
+		REQUIRE( remap == vector<uint32_t>( { 0, 1, 0 } ) );
+	}
+
+	SECTION( "Smooth normals" )
+	{
+		// a sphere duplicates the vertices along its seam and at its poles
+		TriMesh sphere( geom::Sphere().subdivisions( 40 ), TriMesh::Format().positions() );
+		for( auto weighting : { geom::NormalWeighting::UNIFORM, geom::NormalWeighting::AREA, geom::NormalWeighting::ANGLE } ) {
+			REQUIRE( sphere.recalculateNormals( true, weighting ) );
+			const vec3 *positions = sphere.getPositions<3>();
+			for( size_t i = 0; i < sphere.getNumVertices(); ++i )
+				REQUIRE( dot( sphere.getNormals()[i], normalize( positions[i] ) ) > 0.99f );
+		}
+
+		// welded cube corners average the three faces meeting there, or weight them by the angle at the corner
+		TriMesh cube( geom::Cube(), TriMesh::Format().positions() );
+		REQUIRE( cube.recalculateNormals( true, geom::NormalWeighting::ANGLE ) );
+		const vec3 *positions = cube.getPositions<3>();
+		for( size_t i = 0; i < cube.getNumVertices(); ++i )
+			REQUIRE( dot( cube.getNormals()[i], normalize( positions[i] ) ) == Approx( 1 ) );
+
+		// flat normals follow the faces
+		REQUIRE( cube.recalculateNormals( false ) );
+		for( size_t i = 0; i < cube.getNumVertices(); ++i )
+			REQUIRE( length( cube.getNormals()[i] ) == Approx( 1 ) );
+		REQUIRE( cube.getNormals()[0] == cube.getNormals()[1] );
+	}
+
+	SECTION( "Tangents are orthonormal to normals" )
+	{
+		// large enough to be processed by several threads
+		TriMesh sphere( geom::Sphere().subdivisions( 200 ), TriMesh::Format().positions().normals().texCoords() );
+		REQUIRE( sphere.getNumVertices() > 16384 );
+		REQUIRE( sphere.recalculateTangents() );
+		REQUIRE( sphere.recalculateBitangents() );
+
+		size_t numZero = 0;
+		for( size_t i = 0; i < sphere.getNumVertices(); ++i ) {
+			const vec3 &tangent = sphere.getTangents()[i];
+			if( length2( tangent ) == 0 ) {
+				numZero++;
+				continue;
+			}
+			REQUIRE( length( tangent ) == Approx( 1 ) );
+			REQUIRE( dot( tangent, sphere.getNormals()[i] ) == Approx( 0 ).margin( 1e-4 ) );
+			REQUIRE( dot( tangent, sphere.getBitangents()[i] ) == Approx( 0 ).margin( 1e-4 ) );
+		}
+		REQUIRE( numZero < sphere.getNumVertices() / 100 );
+	}
+
+	SECTION( "Mesh optimization preserves geometry and reduces cache misses" )
+	{
+		TriMesh mesh( geom::Torus().subdivisionsAxis( 120 ).subdivisionsHeight( 60 ), TriMesh::Format().positions().normals().texCoords() );
+		shuffleTriangles( &mesh );
+		const auto triangles = sortedTriangles( mesh );
+		const float shuffledAcmr = mesh.calcVertexCacheStats().getAcmr();
+		REQUIRE( shuffledAcmr > 2 );
+
+		for( auto method : { geom::VertexCacheMethod::TIPSIFY, geom::VertexCacheMethod::FORSYTH } ) {
+			TriMesh optimized = mesh;
+			optimized.optimizeVertexCache( method );
+			const geom::VertexCacheStats stats = optimized.calcVertexCacheStats();
+			REQUIRE( stats.getAcmr() < 0.8f );
+			REQUIRE( stats.getAtvr() < 1.6f );
+			REQUIRE( stats.getAtvr() >= 1 );
+			REQUIRE( sortedTriangles( optimized ) == triangles );
+
+			REQUIRE( optimized.optimizeOverdraw( 1.05f ) );
+			REQUIRE( optimized.calcVertexCacheStats().getAcmr() <= stats.getAcmr() * 1.05f + 0.05f );
+			REQUIRE( sortedTriangles( optimized ) == triangles );
+
+			// vertices are renumbered in first use order and their attributes move with them
+			vector<vec2> texCoords;
+			for( uint32_t index : optimized.getIndices() )
+				texCoords.push_back( optimized.getTexCoords0<2>()[index] );
+			const float acmr = optimized.calcVertexCacheStats().getAcmr();
+			optimized.optimizeVertexFetch();
+			uint32_t maxIndex = 0;
+			for( size_t i = 0; i < optimized.getNumIndices(); ++i ) {
+				const uint32_t index = optimized.getIndices()[i];
+				REQUIRE( index <= maxIndex + 1 );
+				maxIndex = std::max( maxIndex, index );
+				REQUIRE( optimized.getTexCoords0<2>()[index] == texCoords[i] );
+			}
+			REQUIRE( sortedTriangles( optimized ) == triangles );
+			REQUIRE( optimized.calcVertexCacheStats().getAcmr() == acmr );
+		}
+
+		// the modifier applies the same steps
+		TriMesh viaModifier( geom::Torus().subdivisionsAxis( 120 ).subdivisionsHeight( 60 ) >> geom::Optimize().vertexCacheMethod( geom::VertexCacheMethod::FORSYTH ) );
+		REQUIRE( viaModifier.getNumTriangles() == mesh.getNumTriangles() );
+		REQUIRE( viaModifier.calcVertexCacheStats().getAcmr() < 0.8f );
+		REQUIRE( sortedTriangles( viaModifier ) == sortedTriangles( TriMesh( geom::Torus().subdivisionsAxis( 120 ).subdivisionsHeight( 60 ) ) ) );
+	}
+
+	SECTION( "Simplification" )
+	{
+		// a unit sphere, with a texture seam and vertices duplicated at the poles
+		TriMesh sphere( geom::Sphere().subdivisions( 60 ), TriMesh::Format().positions().normals().texCoords() );
+		TriMesh simplified = sphere;
+		float error = -1;
+		REQUIRE( simplified.simplify( 0.25f, geom::SimplifyOptions(), &error ) );
+		REQUIRE( simplified.getNumTriangles() <= sphere.getNumTriangles() / 4 );
+		REQUIRE( simplified.getNumTriangles() > sphere.getNumTriangles() / 8 );
+		REQUIRE( error > 0 );
+		REQUIRE( error < 0.05f );
+		REQUIRE( calcArea( simplified ) == Approx( calcArea( sphere ) ).epsilon( 0.05 ) );
+		REQUIRE( ! spansSeam( simplified ) );
+
+		// the error limit is respected
+		simplified = sphere;
+		REQUIRE( simplified.simplify( 0.01f, geom::SimplifyOptions().maxError( 0.01f ), &error ) );
+		REQUIRE( error <= 0.01f );
+		REQUIRE( simplified.getNumTriangles() > sphere.getNumTriangles() / 100 );
+
+		// a flat plane collapses without error, and keeps its border
+		TriMesh plane( geom::Plane().subdivisions( ivec2( 30 ) ), TriMesh::Format().positions().texCoords() );
+		for( bool lockBorders : { false, true } ) {
+			simplified = plane;
+			REQUIRE( simplified.simplify( 0, geom::SimplifyOptions().lockBorders( lockBorders ).maxError( 1e-4f ), &error ) );
+			REQUIRE( error <= 1e-4f );
+			REQUIRE( calcArea( simplified ) == Approx( calcArea( plane ) ) );
+			if( lockBorders )
+				REQUIRE( simplified.getNumTriangles() < plane.getNumTriangles() / 4 );
+			else
+				REQUIRE( simplified.getNumTriangles() < 20 );
+		}
+	}
+
+	SECTION( "Levels of detail" )
+	{
+		TriMesh sphere( geom::Sphere().subdivisions( 100 ), TriMesh::Format().positions().normals().texCoords() );
+		const vector<float> ratios = { 0.5f, 0.2f, 0.05f };
+
+		for( size_t clusterSize : { 0, 1000 } ) {
+			const vector<geom::SimplifiedLod> lods = sphere.calcLods( ratios, geom::SimplifyOptions().parallelClusters( clusterSize ) );
+			REQUIRE( lods.size() == ratios.size() );
+			for( size_t level = 0; level < lods.size(); ++level ) {
+				TriMesh lod = sphere;
+				lod.getIndices() = lods[level].getIndices();
+				REQUIRE( lod.getNumTriangles() <= size_t( sphere.getNumTriangles() * ratios[level] ) );
+				REQUIRE( lod.getNumTriangles() > size_t( sphere.getNumTriangles() * ratios[level] * 0.5f ) );
+				REQUIRE( ! spansSeam( lod ) );
+				REQUIRE( lods[level].getError() < 0.2f );
+				if( level > 0 )
+					REQUIRE( lods[level].getError() >= lods[level - 1].getError() );
+			}
+		}
+
+		// an error of 0.01 viewed from a distance of 10 with a 90 degree field of view spans 0.5 pixels of 1000
+		REQUIRE( geom::SimplifiedLod( {}, 0.01f ).calcScreenSpaceError( 10, toRadians( 90.0f ), 1000 ) == Approx( 0.5f ) );
+
+		// as a modifier
+		float error = -1;
+		TriMesh simplified( geom::Sphere().subdivisions( 100 ) >> geom::Simplify( 0.2f ).errorResult( &error ) );
+		REQUIRE( simplified.getNumTriangles() <= sphere.getNumTriangles() / 5 );
+		REQUIRE( simplified.getNumVertices() == sphere.getNumVertices() );
+		REQUIRE( error == Approx( sphere.calcLods( { 0.2f } )[0].getError() ) );
+	}
+}
@@ -0,0 +1,188 @@
+#include "catch.hpp"
+#include "cinder/ip/Warp.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+template<typename T>
+ChannelT<T> makeRandomChannel( int32_t width, int32_t height, uint32_t seed = 1234 )
+{
+	Rand rand( seed );
+	ChannelT<T> result( width, height );
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x )
+			result.setValue( ivec2( x, y ), CHANTRAIT<T>::convert( rand.nextFloat() ) );
+	}
+	return result;
+}
+
+Surface8u makeRandomSurface( int32_t width, int32_t height, bool alpha )
+{
+	Rand rand( 99 );
+	Surface8u result( width, height, alpha );
+	for( int32_t y = 0; y < height; ++y ) {
+		for( int32_t x = 0; x < width; ++x )
+			result.setPixel( ivec2( x, y ), ColorA8u( rand.nextUint() & 255, rand.nextUint() & 255, rand.nextUint() & 255, alpha ? rand.nextUint() & 255 : 255 ) );
+	}
+	return result;
+}
+
+mat3 translation( const vec2 &offset )
+{
+	mat3 result;
+	result[2] = vec3( offset, 1 );
+	return result;
+}
+
+template<typename T>
+bool channelsEqual( const ChannelT<T> &a, const ChannelT<T> &b, float tolerance = 0 )
+{
+	for( int32_t y = 0; y < a.getHeight(); ++y ) {
+		for( int32_t x = 0; x < a.getWidth(); ++x ) {
+			if( std::abs( (float)a.getValue( ivec2( x, y ) ) - (float)b.getValue( ivec2( x, y ) ) ) > tolerance )
+				return false;
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip::Warp" )
+{
+	SECTION( "Identity and integer translations copy pixels exactly" )
+	{
+		Channel8u src = makeRandomChannel<uint8_t>( 37, 23 );
+		for( auto interpolation : { ip::Interpolation::NEAREST, ip::Interpolation::BILINEAR, ip::Interpolation::BICUBIC } ) {
+			Channel8u dst( 37, 23 );
+			ip::warpAffine( src, &dst, mat3(), ip::WarpOptions().interpolation( interpolation ) );
+			REQUIRE( channelsEqual( src, dst ) );
+
+			ip::warpAffine( src, &dst, translation( vec2( 3, -2 ) ), ip::WarpOptions().interpolation( interpolation ).borderValue( 7 ) );
+			for( int32_t y = 0; y < 23; ++y ) {
+				for( int32_t x = 0; x < 37; ++x ) {
+					const ivec2 from( x - 3, y + 2 );
+					const uint8_t expected = src.getBounds().contains( from ) ? src.getValue( from ) : 7;
+					REQUIRE( dst.getValue( ivec2( x, y ) ) == expected );
+				}
+			}
+		}
+
+		Channel32f src32f = makeRandomChannel<float>( 16, 16 );
+		Channel32f dst32f( 16, 16 );
+		ip::warpAffine( src32f, &dst32f, translation( vec2( -1, 0 ) ), ip::WarpOptions().interpolation( ip::Interpolation::BICUBIC ).borderMode( ip::BorderMode::CLAMP ) );
+		REQUIRE( dst32f.getValue( ivec2( 4, 5 ) ) == Approx( src32f.getValue( ivec2( 5, 5 ) ) ) );
+		REQUIRE( dst32f.getValue( ivec2( 15, 5 ) ) == Approx( src32f.getValue( ivec2( 15, 5 ) ) ) );
+	}
+
+	SECTION( "Rotation by 90 degrees" )
+	{
+		Channel16u src = makeRandomChannel<uint16_t>( 8, 5 );
+		Channel16u dst( 5, 8 );
+		// ( x, y ) -> ( 4 - y, x )
+		const mat3 rotation( 0, 1, 0, -1, 0, 0, 4, 0, 1 );
+		ip::warpAffine( src, &dst, rotation, ip::WarpOptions().interpolation( ip::Interpolation::NEAREST ) );
+		for( int32_t y = 0; y < 5; ++y ) {
+			for( int32_t x = 0; x < 8; ++x )
+				REQUIRE( dst.getValue( ivec2( 4 - y, x ) ) == src.getValue( ivec2( x, y ) ) );
+		}
+	}
+
+	SECTION( "Bilinear sampling between pixels averages them" )
+	{
+		Channel8u src( 2, 2 );
+		src.setValue( ivec2( 0, 0 ), 0 );
+		src.setValue( ivec2( 1, 0 ), 100 );
+		src.setValue( ivec2( 0, 1 ), 200 );
+		src.setValue( ivec2( 1, 1 ), 50 );
+		ip::WarpMap map( ivec2( 1, 1 ) );
+		map.setPosition( ivec2( 0, 0 ), vec2( 0.5f, 0.5f ) );
+		REQUIRE( map.getPosition( ivec2( 0, 0 ) ) == vec2( 0.5f, 0.5f ) );
+
+		Channel8u dst( 1, 1 );
+		ip::remap( src, &dst, map );
+		REQUIRE( dst.getValue( ivec2( 0, 0 ) ) == 88 );
+
+		Channel32f src32f = Channel32f( src );
+		Channel32f dst32f( 1, 1 );
+		ip::remap( src32f, &dst32f, map );
+		REQUIRE( dst32f.getValue( ivec2( 0, 0 ) ) == Approx( 350 / 4.0f / 255 ) );
+	}
+
+	SECTION( "Border modes" )
+	{
+		Channel8u src = makeRandomChannel<uint8_t>( 6, 4 );
+		Channel8u dst( 6, 4 );
+		const auto options = ip::WarpOptions().interpolation( ip::Interpolation::NEAREST );
+		ip::warpAffine( src, &dst, translation( vec2( 2, 0 ) ), ip::WarpOptions( options ).borderMode( ip::BorderMode::WRAP ) );
+		REQUIRE( dst.getValue( ivec2( 0, 1 ) ) == src.getValue( ivec2( 4, 1 ) ) );
+		ip::warpAffine( src, &dst, translation( vec2( 2, 0 ) ), ip::WarpOptions( options ).borderMode( ip::BorderMode::MIRROR ) );
+		REQUIRE( dst.getValue( ivec2( 0, 1 ) ) == src.getValue( ivec2( 2, 1 ) ) );
+		ip::warpAffine( src, &dst, translation( vec2( 2, 0 ) ), ip::WarpOptions( options ).borderMode( ip::BorderMode::CLAMP ) );
+		REQUIRE( dst.getValue( ivec2( 0, 1 ) ) == src.getValue( ivec2( 0, 1 ) ) );
+	}
+
+	SECTION( "Perspective transforms map the corners of quads" )
+	{
+		const array<vec2, 4> srcQuad = { vec2( 0, 0 ), vec2( 100, 0 ), vec2( 100, 80 ), vec2( 0, 80 ) };
+		const array<vec2, 4> dstQuad = { vec2( 10, 5 ), vec2( 90, 20 ), vec2( 95, 70 ), vec2( 3, 60 ) };
+		const mat3 transform = ip::calcPerspectiveTransform( srcQuad, dstQuad );
+		for( size_t i = 0; i < 4; ++i ) {
+			const vec3 p = transform * vec3( srcQuad[i], 1 );
+			REQUIRE( p.x / p.z == Approx( dstQuad[i].x ).margin( 1e-3 ) );
+			REQUIRE( p.y / p.z == Approx( dstQuad[i].y ).margin( 1e-3 ) );
+		}
+
+		const ip::WarpMap map = ip::WarpMap::perspective( transform, ivec2( 100, 80 ) );
+		for( size_t i = 0; i < 4; ++i ) {
+			const vec2 position = map.getPosition( ivec2( dstQuad[i] ) );
+			REQUIRE( position.x == Approx( srcQuad[i].x ).margin( 0.05f ) );
+			REQUIRE( position.y == Approx( srcQuad[i].y ).margin( 0.05f ) );
+		}
+
+		const array<vec2, 4> collinear = { vec2( 0, 0 ), vec2( 1, 1 ), vec2( 2, 2 ), vec2( 0, 5 ) };
+		REQUIRE_THROWS_AS( ip::calcPerspectiveTransform( srcQuad, collinear ), ip::WarpExc );
+	}
+
+	SECTION( "Maps, parallelism and SIMD match" )
+	{
+		const mat3 transform = glm::mat3( 0.8f, 0.3f, 0, -0.25f, 0.9f, 0, 12.3f, -4.6f, 1 );
+		const Surface8u rgba = makeRandomSurface( 301, 203, true );
+		Surface8u rgb( 301, 203, false );
+		rgb.copyFrom( rgba, rgba.getBounds() );
+
+		for( auto interpolation : { ip::Interpolation::NEAREST, ip::Interpolation::BILINEAR, ip::Interpolation::BICUBIC } ) {
+			const auto options = ip::WarpOptions().interpolation( interpolation ).borderMode( ip::BorderMode::MIRROR );
+			Surface8u parallel( 280, 220, true ), serial( 280, 220, true ), mapped( 280, 220, true ), rgbDst( 280, 220, false );
+			ip::warpAffine( rgba, &parallel, transform, options );
+			ip::warpAffine( rgba, &serial, transform, ip::WarpOptions( options ).parallel( false ) );
+			ip::remap( rgba, &mapped, ip::WarpMap::affine( transform, ivec2( 280, 220 ) ), options );
+			ip::warpAffine( rgb, &rgbDst, transform, options );
+			for( int c = 0; c < 4; ++c ) {
+				REQUIRE( channelsEqual( parallel.getChannel( c ), serial.getChannel( c ) ) );
+				REQUIRE( channelsEqual( parallel.getChannel( c ), mapped.getChannel( c ) ) );
+				if( c < 3 )
+					REQUIRE( channelsEqual( parallel.getChannel( c ), rgbDst.getChannel( c ) ) );
+			}
+		}
+
+		// a map from Channels and from a function
+		Channel32f mapX( 50, 40 ), mapY( 50, 40 );
+		for( int32_t y = 0; y < 40; ++y ) {
+			for( int32_t x = 0; x < 50; ++x ) {
+				mapX.setValue( ivec2( x, y ), x * 1.5f + 0.25f );
+				mapY.setValue( ivec2( x, y ), y * 0.75f );
+			}
+		}
+		Surface8u fromChannels( 50, 40, true ), fromFunction( 50, 40, true );
+		ip::remap( rgba, &fromChannels, mapX, mapY );
+		ip::remap( rgba, &fromFunction, ip::WarpMap::function( ivec2( 50, 40 ), []( const ivec2 &p ) { return vec2( p.x * 1.5f + 0.25f, p.y * 0.75f ); } ) );
+		for( int c = 0; c < 4; ++c )
+			REQUIRE( channelsEqual( fromChannels.getChannel( c ), fromFunction.getChannel( c ) ) );
+	}
+}
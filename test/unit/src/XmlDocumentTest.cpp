@@ -0,0 +1,170 @@
+#include "catch.hpp"
+#include "cinder/XmlDocument.h"
+
+#include <cstring>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+const char *sSource =
+	"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+	"<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\" [ <!ENTITY ns \"x\"> ]>\n"
+	"<svg width=\"100\" height=\"50\">\n"
+	"  <!-- a comment -->\n"
+	"  <g id=\"first\"><rect x=\"1\"/><circle r=\"2\"/><rect x=\"3\"/></g>\n"
+	"  <text x=\"5\">fish &amp; chips<tspan>&#x263A;</tspan></text>\n"
+	"  <desc><![CDATA[<raw>]]></desc>\n"
+	"</svg>";
+
+} // anonymous namespace
+
+TEST_CASE( "XmlDocument" )
+{
+	SECTION( "Structure and values match XmlTree" )
+	{
+		XmlDocument doc( string( sSource ), XmlTree::ParseOptions().ignoreDataChildren( false ) );
+		XmlTree tree( string( sSource ), XmlTree::ParseOptions().ignoreDataChildren( false ) );
+
+		REQUIRE( doc.getRoot().isDocument() );
+		REQUIRE( doc.getDocType() == tree.getDocType() );
+
+		const XmlDocument::Node &svg = doc.getChild( "svg" );
+		REQUIRE( svg.getAttributeValue<int>( "width" ) == 100 );
+		REQUIRE( svg.getAttributeValue<float>( "missing", 2.5f ) == 2.5f );
+		REQUIRE( string( svg["height"] ) == "50" );
+		REQUIRE( string( svg["missing"] ).empty() );
+		REQUIRE( svg.getNumChildren() == tree.getChild( "svg" ).getChildren().size() );
+
+		const XmlDocument::Node &text = doc.getChild( "svg/text" );
+		REQUIRE( string( text.getValue() ) == tree.getChild( "svg/text" ).getValue() );
+		REQUIRE( string( text.getValue() ) == "fish & chips" );
+		REQUIRE( text.getChild( 0 ).isData() );
+		REQUIRE( string( doc.getChild( "svg/text/tspan" ).getValue() ) == "\xe2\x98\xba" );
+
+		// CDATA is collapsed into the value of its parent by default
+		REQUIRE( string( doc.getChild( "svg/desc" ).getValue() ) == "<raw>" );
+
+		REQUIRE( doc.getChild( "svg/g" ).getPath() == "/svg/g" );
+		REQUIRE( doc.hasChild( "SVG/G" ) );
+		REQUIRE( ! doc.hasChild( "SVG/G", true ) );
+		REQUIRE_THROWS_AS( doc.getChild( "svg/missing" ), XmlDocument::ExcChildNotFound );
+		REQUIRE_THROWS_AS( svg.getAttribute( "missing" ), XmlDocument::ExcAttrNotFound );
+	}
+
+	SECTION( "Children with the same tag are linked" )
+	{
+		XmlDocument doc{ string( sSource ) };
+		const XmlDocument::Node &g = doc.getChild( "svg/g" );
+
+		vector<string> xs;
+		for( const XmlDocument::Node *rect = g.findChild( "rect" ); rect; rect = rect->getNextSameTag() )
+			xs.push_back( (*rect)["x"] );
+
+		REQUIRE( xs == vector<string>( { "1", "3" } ) );
+		REQUIRE( g.findChild( "circle" )->getNextSameTag() == nullptr );
+	}
+
+	SECTION( "Lookups in elements large enough to be indexed" )
+	{
+		string source = "<root>";
+		for( int i = 0; i < 200; ++i )
+			source += "<item" + to_string( i % 50 ) + " index=\"" + to_string( i ) + "\"/>";
+		source += "<Mixed index=\"upper\"/><mixed index=\"lower\"/></root>";
+
+		XmlDocument doc( source );
+		const XmlDocument::Node &root = doc.getChild( "root" );
+		REQUIRE( root.getNumChildren() == 202 );
+
+		for( int tag = 0; tag < 50; ++tag ) {
+			int count = 0;
+			for( const XmlDocument::Node *item = root.findChild( ( "item" + to_string( tag ) ).c_str() ); item; item = item->getNextSameTag() ) {
+				REQUIRE( item->getAttributeValue<int>( "index" ) == tag + count * 50 );
+				++count;
+			}
+			REQUIRE( count == 4 );
+		}
+
+		REQUIRE( root.findChild( "item50" ) == nullptr );
+		REQUIRE( string( root.findChild( "mixed" )->getAttribute( "index" ).getValue() ) == "upper" );
+		REQUIRE( string( root.findChild( "mixed", true )->getAttribute( "index" ).getValue() ) == "lower" );
+	}
+
+	SECTION( "Parsing a Buffer in place" )
+	{
+		const size_t length = strlen( sSource );
+		BufferRef buffer = make_shared<Buffer>( length );
+		memcpy( buffer->getData(), sSource, length );
+
+		XmlDocument doc( buffer );
+		const char *data = static_cast<const char *>( buffer->getData() );
+		const char *tag = doc.getChild( "svg" ).getTag();
+		REQUIRE( tag >= data );
+		REQUIRE( tag < data + buffer->getSize() );
+	}
+
+	SECTION( "Malformed input" )
+	{
+		REQUIRE_THROWS_AS( XmlDocument( string( "<a><b></a>" ) ), XmlDocument::ExcParseError );
+	}
+}
+
+TEST_CASE( "XmlPullParser" )
+{
+	SECTION( "Events" )
+	{
+		auto stream = DataSourceBuffer::create( Buffer::create( (void *)sSource, strlen( sSource ) ) )->createStream();
+		// a tiny chunk size makes tokens straddle chunk boundaries
+		XmlPullParser parser( stream, XmlPullParser::Options().chunkSize( 5 ).parseComments() );
+
+		string events;
+		while( parser.next() != XmlPullParser::END_DOCUMENT ) {
+			switch( parser.getEvent() ) {
+				case XmlPullParser::START_ELEMENT:
+					events += "<" + parser.getTag();
+					for( size_t i = 0; i < parser.getNumAttributes(); ++i )
+						events += " " + parser.getAttributeName( i ) + "=" + parser.getAttributeValue( i );
+					events += ">";
+				break;
+				case XmlPullParser::END_ELEMENT:	events += "</" + parser.getTag() + ">";	break;
+				case XmlPullParser::TEXT:			events += parser.getText();				break;
+				case XmlPullParser::CDATA:			events += "[" + parser.getText() + "]";	break;
+				case XmlPullParser::COMMENT:		events += "#" + parser.getText() + "#";	break;
+				default:	break;
+			}
+		}
+
+		REQUIRE( events == "<svg width=100 height=50># a comment #<g id=first><rect x=1></rect><circle r=2></circle><rect x=3></rect></g>"
+			"<text x=5>fish & chips<tspan>\xe2\x98\xba</tspan></text><desc>[<raw>]</desc></svg>" );
+	}
+
+	SECTION( "Skipping elements" )
+	{
+		XmlPullParser parser( DataSourceBuffer::create( Buffer::create( (void *)sSource, strlen( sSource ) ) ) );
+
+		vector<string> tags;
+		while( parser.next() != XmlPullParser::END_DOCUMENT ) {
+			if( parser.getEvent() == XmlPullParser::START_ELEMENT ) {
+				tags.push_back( parser.getTag() );
+				REQUIRE( parser.getDepth() <= 2 );
+				if( parser.getDepth() == 2 )
+					parser.skipElement();
+			}
+		}
+
+		REQUIRE( tags == vector<string>( { "svg", "g", "text", "desc" } ) );
+		// outside of any element there is no tag
+		REQUIRE( parser.getDepth() == 0 );
+		REQUIRE( parser.getTag().empty() );
+	}
+
+	SECTION( "Malformed input" )
+	{
+		const string source = "<a><b></a>";
+		XmlPullParser parser( DataSourceBuffer::create( Buffer::create( (void *)source.data(), source.size() ) ) );
+		REQUIRE( parser.next() == XmlPullParser::START_ELEMENT );
+		REQUIRE( parser.next() == XmlPullParser::START_ELEMENT );
+		REQUIRE_THROWS_AS( parser.next(), XmlDocument::ExcParseError );
+	}
+}